@@ -0,0 +1,265 @@
+import argparse
+import json
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+import threading
+
+DEFAULT_TIMEOUT = 600
+BENCHMARKS_DIR = os.path.dirname(os.path.abspath(__file__))
+DEFAULT_BENCHMARKS_FILE = os.path.join(BENCHMARKS_DIR, 'benchmarks.json')
+DEFAULT_BASELINE_FILE = os.path.join(BENCHMARKS_DIR, 'baseline.json')
+RESOURCES_DIR = os.path.join(os.path.dirname(BENCHMARKS_DIR), 'resources')
+
+
+def run_process(args, cwd, timeout):
+    """Runs a process with a timeout `timeout` in seconds. Returns the output,
+    the error output and the exit code of the process. If the process times
+    out, the exit code is 124."""
+
+    proc = subprocess.Popen(
+        args,
+        cwd=cwd,
+        stdout=subprocess.PIPE,
+        stderr=subprocess.PIPE)
+
+    out = ''
+    err = ''
+    exit_status = 124
+    timed_out = []
+    try:
+        if timeout:
+            timer = threading.Timer(timeout, lambda p: (timed_out.append(True), p.kill()), [proc])
+            timer.start()
+        out, err = proc.communicate()
+        exit_status = 124 if timed_out else proc.returncode
+    finally:
+        if timeout:
+            timer.cancel()
+
+    if isinstance(out, bytes):
+        out = out.decode()
+    if isinstance(err, bytes):
+        err = err.decode()
+    return (out.strip(), err.strip(), exit_status)
+
+
+def onnx_to_query(benchmark, query_path):
+    '''
+    Build the query of an ONNX benchmark with maraboupy, and store it in
+    query_path, so that it can be solved by the Marabou binary.
+    :param benchmark: the benchmark entry. The input bounds are given as a
+        pair that applies to all inputs, and output bounds as a map from
+        output index to a [lower, upper] pair, either of which can be null
+    :return: an error message, or None if the query was stored
+    '''
+    try:
+        sys.path.insert(0, os.path.dirname(BENCHMARKS_DIR))
+        from maraboupy import Marabou
+    except ImportError as e:
+        return 'maraboupy is not available ({})'.format(e)
+
+    network = Marabou.read_onnx(os.path.join(RESOURCES_DIR, benchmark['network']))
+    lower, upper = benchmark['inputBounds']
+    for var in network.inputVars[0].flatten():
+        network.setLowerBound(var, lower)
+        network.setUpperBound(var, upper)
+
+    output_vars = network.outputVars.flatten()
+    for index, (lower, upper) in benchmark.get('outputBounds', {}).items():
+        if lower is not None:
+            network.setLowerBound(output_vars[int(index)], lower)
+        if upper is not None:
+            network.setUpperBound(output_vars[int(index)], upper)
+
+    network.saveQuery(query_path)
+    return None
+
+
+def run_benchmark(marabou_binary, benchmark, timeout, work_dir):
+    '''
+    Run Marabou on a benchmark and collect its statistics
+    :param marabou_binary: path to marabou executable
+    :param benchmark: the benchmark entry, whose network, property and
+        query paths are relative to the resources directory
+    :param timeout: timeout in seconds
+    :param work_dir: directory for temporary files
+    :return: a dictionary with the result, the elapsed time and the
+        statistics, or with an error message
+    '''
+    statistics_path = os.path.join(work_dir, benchmark['name'] + '.json')
+    args = [marabou_binary]
+
+    if 'query' in benchmark:
+        args += ['--input-query', os.path.join(RESOURCES_DIR, benchmark['query'])]
+    elif benchmark['network'].endswith('.onnx'):
+        query_path = os.path.join(work_dir, benchmark['name'] + '.ipq')
+        error = onnx_to_query(benchmark, query_path)
+        if error:
+            return {'skipped': error}
+        args += ['--input-query', query_path]
+    else:
+        args += [os.path.join(RESOURCES_DIR, benchmark['network']),
+                 os.path.join(RESOURCES_DIR, benchmark['property'])]
+
+    args += benchmark.get('arguments', [])
+    args += ['--statistics-file', statistics_path]
+
+    out, err, exit_status = run_process(args, os.curdir, timeout)
+    if exit_status != 0:
+        return {'error': 'exit status {}'.format(exit_status)}
+    if not os.path.isfile(statistics_path):
+        return {'error': 'no statistics were written'}
+
+    with open(statistics_path) as f:
+        return json.load(f)
+
+
+def get_metric(run, metric):
+    if metric == 'elapsedTime':
+        return run.get('elapsedTime')
+    return run.get('statistics', {}).get(metric)
+
+
+def compare_to_baseline(name, run, baseline, thresholds):
+    '''
+    Compare the gated metrics of a run to those of the baseline. A metric
+    regresses if it grows by more than both the relative and the absolute
+    slack of its threshold, and fails if it is missing from either side.
+    :return: a list of regression messages
+    '''
+    regressions = []
+    for metric, threshold in sorted(thresholds.items()):
+        old = get_metric(baseline, metric)
+        new = get_metric(run, metric)
+        if old is None or new is None:
+            regressions.append('{}: {} is missing from the {}'.format(
+                name, metric, 'baseline' if old is None else 'run'))
+            continue
+
+        slack = max(old * threshold.get('relative', 0), threshold.get('absolute', 0))
+        if new > old + slack:
+            regressions.append('{}: {} regressed from {} to {}'.format(name, metric, old, new))
+    return regressions
+
+
+def report_metrics(run, baseline, metrics):
+    '''
+    Format the reported (not gated) metrics of a run, next to their
+    baseline values when there are any. Timings vary between machines and
+    runs, so they are only shown.
+    '''
+    fields = []
+    for metric in metrics:
+        new = get_metric(run, metric)
+        old = get_metric(baseline, metric) if baseline else None
+        if old is None:
+            fields.append('{}={}'.format(metric, new))
+        else:
+            fields.append('{}={} (baseline {})'.format(metric, new, old))
+    return ', '.join(fields)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Runs the benchmark suite and compares the solver statistics against a baseline')
+
+    parser.add_argument('marabou_binary')
+    parser.add_argument('--benchmarks', default=DEFAULT_BENCHMARKS_FILE,
+                        help='the benchmark list and the regression thresholds')
+    parser.add_argument('--baseline', default=DEFAULT_BASELINE_FILE,
+                        help='the statistics to compare against')
+    parser.add_argument('--output', help='write the collected statistics to this file')
+    parser.add_argument('--update-baseline', action='store_true',
+                        help='store the collected statistics as the new baseline')
+    parser.add_argument('--filter', help='only run the benchmarks whose names match this regex')
+    parser.add_argument('--timeout', type=int, default=DEFAULT_TIMEOUT)
+    parser.add_argument('--allow-skipped', action='store_true',
+                        help='report skipped benchmarks as warnings rather than failures')
+
+    args = parser.parse_args()
+
+    if not os.access(args.marabou_binary, os.X_OK):
+        sys.exit('"{}" does not exist or is not executable'.format(args.marabou_binary))
+
+    with open(args.benchmarks) as f:
+        suite = json.load(f)
+
+    baseline = {}
+    if os.path.isfile(args.baseline):
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+
+    results = {}
+    failures = []
+    warnings = []
+    regressions = []
+    work_dir = tempfile.mkdtemp(prefix='marabou_bench_')
+
+    for benchmark in suite['benchmarks']:
+        name = benchmark['name']
+        if args.filter and not re.search(args.filter, name):
+            continue
+
+        run = run_benchmark(os.path.abspath(args.marabou_binary), benchmark, args.timeout, work_dir)
+        if 'skipped' in run:
+            print('{:<40} skipped: {}'.format(name, run['skipped']))
+            message = '{}: skipped, {}'.format(name, run['skipped'])
+            if args.allow_skipped:
+                warnings.append(message)
+            else:
+                failures.append(message)
+            continue
+        if 'error' in run:
+            print('{:<40} error: {}'.format(name, run['error']))
+            failures.append('{}: {}'.format(name, run['error']))
+            continue
+
+        results[name] = run
+        expected = benchmark.get('expected')
+        if expected and run['result'] != expected:
+            print('{:<40} wrong result: expected {}, got {}'.format(name, expected, run['result']))
+            failures.append('{}: expected {}, got {}'.format(name, expected, run['result']))
+            continue
+
+        print('{:<40} {:<8} {:>10} pivots {:>8} splits'.format(
+            name, run['result'], get_metric(run, 'numTableauPivots'), get_metric(run, 'numSplits')))
+        print('{:<40} {}'.format('', report_metrics(run, baseline.get(name), suite['reported'])))
+
+        if args.update_baseline:
+            continue
+        if name not in baseline:
+            failures.append('{}: no baseline entry'.format(name))
+            continue
+        regressions += compare_to_baseline(name, run, baseline[name], suite['thresholds'])
+
+    shutil.rmtree(work_dir)
+
+    if args.output:
+        with open(args.output, 'w') as f:
+            json.dump(results, f, indent=4, sort_keys=True)
+
+    if args.update_baseline:
+        baseline.update(results)
+        with open(args.baseline, 'w') as f:
+            json.dump(baseline, f, indent=4, sort_keys=True)
+        print('Baseline updated: {}'.format(args.baseline))
+
+    for warning in warnings:
+        print('WARNING: ' + warning)
+    for failure in failures:
+        print('FAILURE: ' + failure)
+    for regression in regressions:
+        print('REGRESSION: ' + regression)
+
+    return not failures and not regressions
+
+
+if __name__ == "__main__":
+    if main():
+        sys.exit(0)
+    else:
+        sys.exit(1)
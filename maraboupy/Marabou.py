@@ -122,8 +122,8 @@ def createOptions(numWorkers=1, initialTimeout=5, initialSplits=0, onlineSplits=
                   splittingStrategy="auto", sncSplittingStrategy="auto",
                   restoreTreeStates=False, splitThreshold=20, solveWithMILP=False,
                   preprocessorBoundTolerance=0.0000000001, dumpBounds=False,
-                  tighteningStrategy="deeppoly", milpTightening="lp", milpSolverTimeout=0,
-                  numSimulations=10):
+                  tighteningStrategy="deeppoly", milpTightening="", milpSolverTimeout=0,
+                  numSimulations=10, lpSolver=""):
     """Create an options object for how Marabou should solve the query
 
     Args:
@@ -140,13 +140,14 @@ def createOptions(numWorkers=1, initialTimeout=5, initialSplits=0, onlineSplits=
         splittingStrategy (string, optional): Specifies which partitioning strategy to use (auto/largest-interval/relu-violation/polarity/earliest-relu)
         sncSplittingStrategy (string, optional): Specifies which partitioning strategy to use in the SnC mode (auto/largest-interval/polarity).
         restoreTreeStates (bool, optional): Whether to restore tree states in dnc mode, defaults to False
-        solveWithMILP ( bool, optional): Whther to solve the input query with a MILP encoding. Currently only works when Gurobi is installed. Defaults to False.
+        solveWithMILP ( bool, optional): Whther to solve the input query with a MILP encoding. Defaults to False.
         preprocessorBoundTolerance ( float, optional): epsilon value for preprocess bound tightening . Defaults to 10^-10.
         dumpBounds (bool, optional): Print out the bounds of each neuron after preprocessing. defaults to False
         tighteningStrategy (string, optional): The abstract-interpretation-based bound tightening techniques used during the search (deeppoly/sbt/none). default to deeppoly.
-        milpTightening (string, optional): The (mi)lp-based bound tightening techniques used to preprocess the query (milp-inc/lp-inc/milp/lp/none). default to lp.
+        milpTightening (string, optional): The (mi)lp-based bound tightening techniques used to preprocess the query (milp-inc/lp-inc/milp/lp/none). default to lp when Gurobi is installed, and to none otherwise.
         milpSolverTimeout (float, optional): Timeout duration for MILP
         numSimulations (int, optional): Number of simulations generated per neuron, defaults to 10
+        lpSolver (string, optional): The (mi)lp solver used for solveWithMILP and milpTightening (native/gurobi). default to gurobi when installed, and to native otherwise.
     Returns:
         :class:`~maraboupy.MarabouCore.Options`
     """
@@ -170,4 +171,5 @@ def createOptions(numWorkers=1, initialTimeout=5, initialSplits=0, onlineSplits=
     options._milpTightening = milpTightening
     options._milpSolverTimeout = milpSolverTimeout
     options._numSimulations = numSimulations
+    options._lpSolver = lpSolver
     return options
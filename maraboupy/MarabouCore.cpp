@@ -14,9 +14,11 @@
  ** [[ Add lengthier description here ]]
  **/
 
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <map>
+#include <mutex>
 #include <vector>
 #include <set>
 #include <string>
@@ -34,7 +36,9 @@
 #include "MarabouError.h"
 #include "InputParserError.h"
 #include "MString.h"
+#include "MStringf.h"
 #include "MaxConstraint.h"
+#include "NetworkLevelReasoner.h"
 #include "Options.h"
 #include "PiecewiseLinearConstraint.h"
 #include "PropertyParser.h"
@@ -43,6 +47,7 @@
 #include "Set.h"
 #include "SnCDivideStrategy.h"
 #include "SignConstraint.h"
+#include "SolverSession.h"
 
 #ifdef _WIN32
 #define STDOUT_FILENO 1
@@ -198,6 +203,7 @@ struct MarabouOptions {
         , _sncSplittingStrategyString( Options::get()->getString( Options::SNC_SPLITTING_STRATEGY ).ascii() )
         , _tighteningStrategyString( Options::get()->getString( Options::SYMBOLIC_BOUND_TIGHTENING_TYPE ).ascii() )
         , _milpTighteningString( Options::get()->getString( Options::MILP_SOLVER_BOUND_TIGHTENING_TYPE ).ascii() )
+        , _lpSolverString( Options::get()->getString( Options::LP_SOLVER ).ascii() )
     {};
 
   void setOptions()
@@ -228,6 +234,7 @@ struct MarabouOptions {
     Options::get()->setString( Options::SNC_SPLITTING_STRATEGY, _sncSplittingStrategyString );
     Options::get()->setString( Options::SYMBOLIC_BOUND_TIGHTENING_TYPE, _tighteningStrategyString );
     Options::get()->setString( Options::MILP_SOLVER_BOUND_TIGHTENING_TYPE, _milpTighteningString );
+    Options::get()->setString( Options::LP_SOLVER, _lpSolverString );
   }
 
     bool _snc;
@@ -249,6 +256,7 @@ struct MarabouOptions {
     std::string _sncSplittingStrategyString;
     std::string _tighteningStrategyString;
     std::string _milpTighteningString;
+    std::string _lpSolverString;
 };
 
 
@@ -342,14 +350,118 @@ std::pair<std::map<int, double>, Statistics> solve(InputQuery &inputQuery, Marab
     return std::make_pair(ret, retStats);
 }
 
-void saveQuery(InputQuery& inputQuery, std::string filename){
-    inputQuery.saveQuery(String(filename));
+void saveQuery(InputQuery& inputQuery, std::string filename, bool binary){
+    inputQuery.saveQuery(String(filename), binary ? QueryFileFormat::BINARY : QueryFileFormat::TEXT);
 }
 
 InputQuery loadQuery(std::string filename){
     return QueryLoader::loadQuery(String(filename));
 }
 
+typedef py::array_t<double, py::array::c_style | py::array::forcecast> DoubleArray;
+
+/* Evaluations run without the GIL, but write to the layers' batch
+ * buffers and share the matrix multiplication thread pool, so only one
+ * of them may run at a time. */
+static std::mutex evaluationMutex;
+
+/* Evaluate the network of an input query directly through its network
+ * level reasoner, without invoking the engine or the preprocessor. The
+ * inputs are a (batchSize, numInputs) array ordered by input index, and
+ * the result holds the values of the output variables, ordered by output
+ * index. See InputQuery::evaluateNetwork. */
+DoubleArray evaluateNetworkBatch(InputQuery &inputQuery, DoubleArray inputs){
+    unsigned numInputs = inputQuery.getNumInputVariables();
+    unsigned numOutputs = inputQuery.getNumOutputVariables();
+
+    if(inputs.ndim() != 2 || (unsigned)inputs.shape(1) != numInputs)
+        throw py::value_error(Stringf("Expected an array of shape (batchSize, %u)", numInputs).ascii());
+
+    unsigned batchSize = inputs.shape(0);
+    DoubleArray outputs({(size_t)batchSize, (size_t)numOutputs});
+
+    const double *inputData = inputs.data();
+    double *outputData = outputs.mutable_data();
+    try{
+        // The evaluation touches no Python objects. The GIL is released
+        // before taking the lock, so that a thread waiting for the lock
+        // never holds the GIL.
+        py::gil_scoped_release release;
+        std::lock_guard<std::mutex> lock(evaluationMutex);
+        inputQuery.evaluateNetwork(inputData, outputData, batchSize);
+    }
+    catch(const MarabouError &e){
+        throw py::value_error(e.getUserMessage());
+    }
+
+    return outputs;
+}
+
+DoubleArray evaluateNetwork(InputQuery &inputQuery, DoubleArray inputs){
+    // A single input is evaluated as a batch of one
+    unsigned numInputs = inputQuery.getNumInputVariables();
+    if(inputs.ndim() != 1 || (unsigned)inputs.shape(0) != numInputs)
+        throw py::value_error(Stringf("Expected an array of shape (%u,)", numInputs).ascii());
+
+    DoubleArray batch({(size_t)1, (size_t)numInputs}, inputs.data(), inputs);
+    DoubleArray outputs = evaluateNetworkBatch(inputQuery, batch);
+    return DoubleArray((ssize_t)inputQuery.getNumOutputVariables(), outputs.data(), outputs);
+}
+
+/* Sessions are created with the given options, since the engine reads
+ * them when it is constructed */
+SolverSession *createSolverSession(InputQuery &inputQuery, MarabouOptions &options,
+                                   std::string redirect=""){
+    int output=-1;
+    if(redirect.length()>0)
+        output=redirectOutputToFile(redirect);
+    options.setOptions();
+    SolverSession *session = new SolverSession(inputQuery);
+    if(output != -1)
+        restoreOutputStream(output);
+    return session;
+}
+
+std::pair<std::map<int, double>, Statistics> solveInSession(SolverSession &session,
+                                                            std::map<int, double> lowerBounds,
+                                                            std::map<int, double> upperBounds,
+                                                            std::list<Equation> equations,
+                                                            unsigned timeoutInSeconds,
+                                                            std::string redirect=""){
+    // Arguments: bounds and equations that are conjoined with the base query
+    // Returns: map from variable number to value, empty unless SAT
+    std::map<int, double> ret;
+    Statistics retStats;
+    int output=-1;
+    if(redirect.length()>0)
+        output=redirectOutputToFile(redirect);
+    try{
+        Map<unsigned, double> lower;
+        for(const auto &bound : lowerBounds)
+            lower[bound.first] = bound.second;
+        Map<unsigned, double> upper;
+        for(const auto &bound : upperBounds)
+            upper[bound.first] = bound.second;
+        List<Equation> propertyEquations;
+        for(const auto &equation : equations)
+            propertyEquations.append(equation);
+
+        if(session.solve(lower, upper, propertyEquations, timeoutInSeconds) == IEngine::SAT){
+            Map<unsigned, double> values;
+            session.extractSolution(values);
+            for(const auto &value : values)
+                ret[value.first] = value.second;
+        }
+        retStats = *(session.getStatistics());
+    }
+    catch(const MarabouError &e){
+        printf( "Caught a MarabouError. Code: %u. Message: %s\n", e.getCode(), e.getUserMessage() );
+    }
+    if(output != -1)
+        restoreOutputStream(output);
+    return std::make_pair(ret, retStats);
+}
+
 // Code necessary to generate Python library
 // Describes which classes and functions are exposed to API
 PYBIND11_MODULE(MarabouCore, m) {
@@ -387,8 +499,9 @@ PYBIND11_MODULE(MarabouCore, m) {
         Args:
             inputQuery (:class:`~maraboupy.MarabouCore.InputQuery`): Marabou input query to be saved
             filename (str): Name of file to save query
+            binary (bool): Use the binary format, which loads faster than the text format, defaults to False
         )pbdoc",
-        py::arg("inputQuery"), py::arg("filename"));
+        py::arg("inputQuery"), py::arg("filename"), py::arg("binary") = false);
     m.def("loadQuery", &loadQuery, R"pbdoc(
         Loads and returns a serialized InputQuery from the given filename
 
@@ -399,6 +512,31 @@ PYBIND11_MODULE(MarabouCore, m) {
             :class:`~maraboupy.MarabouCore.InputQuery`
         )pbdoc",
         py::arg("filename"));
+    m.def("evaluateNetwork", &evaluateNetwork, R"pbdoc(
+        Evaluates the network of an input query at a single point, by propagating the inputs through its
+        network level reasoner. Neither the engine nor the preprocessor is invoked, and the query's bounds
+        and any constraints outside the network are ignored.
+
+        Args:
+            inputQuery (:class:`~maraboupy.MarabouCore.InputQuery`): Marabou input query whose constraints form a network
+            inputs (np array): Values of the input variables, ordered by input index
+
+        Returns:
+            (np array): Values of the output variables, ordered by output index
+        )pbdoc",
+        py::arg("inputQuery"), py::arg("inputs"));
+    m.def("evaluateNetworkBatch", &evaluateNetworkBatch, R"pbdoc(
+        Evaluates the network of an input query at a batch of points, like evaluateNetwork. The batch is
+        evaluated layer by layer, and C-contiguous float64 arrays are not copied.
+
+        Args:
+            inputQuery (:class:`~maraboupy.MarabouCore.InputQuery`): Marabou input query whose constraints form a network
+            inputs (np array): Array of shape (batchSize, numInputs), one point per row
+
+        Returns:
+            (np array): Array of shape (batchSize, numOutputs)
+        )pbdoc",
+        py::arg("inputQuery"), py::arg("inputs"));
     m.def("addReluConstraint", &addReluConstraint, R"pbdoc(
         Add a Relu constraint to the InputQuery
 
@@ -443,6 +581,37 @@ PYBIND11_MODULE(MarabouCore, m) {
             disjuncts (list of pairs): A list of disjuncts. Each disjunct is represented by a pair: a list of bounds, and a list of (in)equalities.
         )pbdoc",
           py::arg("inputQuery"), py::arg("disjuncts"));
+    py::class_<SolverSession>(m, "SolverSession", R"pbdoc(
+        Solves many queries that share a network and differ only in some bounds
+        and equations. The base query is preprocessed once; each call to solve
+        conjoins it with the given bounds and equations, which can only tighten
+        the bounds of the base query.
+        )pbdoc")
+        .def(py::init(&createSolverSession), R"pbdoc(
+        Args:
+            inputQuery (:class:`~maraboupy.MarabouCore.InputQuery`): The base query shared by all queries
+            options (class:`~maraboupy.MarabouCore.Options`): Object defining the options used for Marabou
+            redirect (str, optional): Filepath to direct standard output, defaults to ""
+        )pbdoc",
+             py::arg("inputQuery"), py::arg("options"), py::arg("redirect") = "")
+        .def("solve", &solveInSession, R"pbdoc(
+        Solve the base query, conjoined with the given bounds and equations
+
+        Args:
+            lowerBounds (Dict[int, float]): Lower bounds of variables of the base query
+            upperBounds (Dict[int, float]): Upper bounds of variables of the base query
+            equations (list of :class:`~maraboupy.MarabouCore.Equation`, optional): (In)equalities over variables of the base query
+            timeoutInSeconds (int, optional): Timeout for this query, 0 for none
+            redirect (str, optional): Filepath to direct standard output, defaults to ""
+
+        Returns:
+            (tuple): tuple containing:
+                - vals (Dict[int, float]): Empty dictionary unless SAT, otherwise a dictionary of SATisfying values for variables
+                - stats (:class:`~maraboupy.MarabouCore.Statistics`): A Statistics object for this query
+        )pbdoc",
+             py::arg("lowerBounds"), py::arg("upperBounds"), py::arg("equations") = std::list<Equation>(),
+             py::arg("timeoutInSeconds") = 0, py::arg("redirect") = "")
+        .def("getNumSolvedQueries", &SolverSession::getNumSolvedQueries);
     py::class_<InputQuery>(m, "InputQuery")
         .def(py::init())
         .def("setUpperBound", &InputQuery::setUpperBound)
@@ -480,6 +649,7 @@ PYBIND11_MODULE(MarabouCore, m) {
         .def_readwrite("_sncSplittingStrategy", &MarabouOptions::_sncSplittingStrategyString)
         .def_readwrite("_tighteningStrategy", &MarabouOptions::_tighteningStrategyString)
         .def_readwrite("_milpTightening", &MarabouOptions::_milpTighteningString)
+        .def_readwrite("_lpSolver", &MarabouOptions::_lpSolverString)
         .def_readwrite("_numSimulations", &MarabouOptions::_numSimulations);
     py::enum_<PiecewiseLinearFunctionType>(m, "PiecewiseLinearFunctionType")
         .value("ReLU", PiecewiseLinearFunctionType::RELU)
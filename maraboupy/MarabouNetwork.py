@@ -53,6 +53,8 @@ class MarabouNetwork:
         self.upperBounds = dict()
         self.inputVars = []
         self.outputVars = np.array([])
+        self.evaluationQuery = None
+        self.evaluationQueryKey = None
 
     def getNewVariable(self):
         """Function to create a new variable
@@ -277,14 +279,15 @@ class MarabouNetwork:
 
         return [vals, stats]
 
-    def saveQuery(self, filename=""):
+    def saveQuery(self, filename="", binary=False):
         """Serializes the inputQuery in the given filename
 
         Args:
             filename: (string) file to write serialized inputQuery
+            binary: (bool) use the binary format, which loads faster than the text format
         """
         ipq = self.getMarabouQuery()
-        MarabouCore.saveQuery(ipq, filename)
+        MarabouCore.saveQuery(ipq, filename, binary)
 
     def evaluateWithMarabou(self, inputValues, filename="evaluateWithMarabou.log", options=None):
         """Function to evaluate network at a given point using Marabou as solver
@@ -329,6 +332,68 @@ class MarabouNetwork:
         outputValues = outputValues.reshape(outputVars.shape)
         return outputValues
 
+    def getEvaluationQuery(self):
+        """Function to get the InputQuery used to evaluate the network without the solver
+
+        The query is built on the first call and reused as long as the input and output variables
+        and the number of variables and constraints stay the same, so that the network level reasoner
+        constructed in it is only built once. After modifying existing equations or constraints in
+        place, set evaluationQuery to None.
+
+        Returns:
+            :class:`~maraboupy.MarabouCore.InputQuery`
+
+        :meta private:
+        """
+        key = (self.numVars, len(self.equList), len(self.reluList), len(self.maxList),
+               len(self.absList), len(self.signList), len(self.disjunctionList),
+               tuple(np.asarray(inVar).tobytes() for inVar in self.inputVars), np.asarray(self.outputVars).tobytes())
+        if self.evaluationQuery is None or self.evaluationQueryKey != key:
+            self.evaluationQuery = self.getMarabouQuery()
+            self.evaluationQueryKey = key
+        return self.evaluationQuery
+
+    def evaluateWithNetworkLevelReasoner(self, inputValues):
+        """Function to evaluate network at a given point without the Marabou solver
+
+        The inputs are propagated through the network's equations and piecewise-linear constraints
+        in C++, skipping the engine, the preprocessor and any file I/O. Unlike evaluateWithMarabou,
+        bounds and constraints that are not part of the network are ignored.
+
+        Args:
+            inputValues (list of np arrays): Inputs to evaluate
+
+        Returns:
+            (np array): Values representing the output of the network
+
+        Raises:
+            ValueError: If the network's constraints cannot be arranged into layers
+        """
+        inputValList = np.concatenate([np.array(inVal, dtype=np.float64).flatten() for inVal in inputValues])
+        outputValues = MarabouCore.evaluateNetwork(self.getEvaluationQuery(), inputValList)
+        return outputValues.reshape(self.outputVars.shape)
+
+    def evaluateBatchWithNetworkLevelReasoner(self, inputBatch):
+        """Function to evaluate network at many points at once without the Marabou solver
+
+        Like evaluateWithNetworkLevelReasoner, but the whole batch is propagated through each layer
+        at once. A C-contiguous float64 batch is passed to C++ without being copied.
+
+        Args:
+            inputBatch (np array): Array with one row per point, holding the flattened values of all
+                input variables (in the order of inputVars)
+
+        Returns:
+            (np array): Array with one entry per point, each shaped like outputVars
+
+        Raises:
+            ValueError: If the network's constraints cannot be arranged into layers
+        """
+        inputBatch = np.asarray(inputBatch, dtype=np.float64)
+        inputBatch = inputBatch.reshape(inputBatch.shape[0], -1)
+        outputBatch = MarabouCore.evaluateNetworkBatch(self.getEvaluationQuery(), inputBatch)
+        return outputBatch.reshape((inputBatch.shape[0],) + self.outputVars.shape)
+
     def evaluate(self, inputValues, useMarabou=True, options=None, filename="evaluateWithMarabou.log"):
         """Function to evaluate network at a given point
 
@@ -347,7 +412,10 @@ class MarabouNetwork:
             return self.evaluateWithoutMarabou(inputValues)
 
     def findError(self, inputValues, options=None, filename="evaluateWithMarabou.log"):
-        """Function to find error between Marabou solver and TF/Nnet at a given point
+        """Function to find error between Marabou and TF/Nnet at a given point
+
+        The network is evaluated on Marabou's encoding of it, without the solver when the encoding can
+        be arranged into layers, and with the solver otherwise.
 
         Args:
             inputValues (list of np arrays): Input values to evaluate
@@ -357,7 +425,10 @@ class MarabouNetwork:
         Returns:
             (np array): Values representing the error in each output variable
         """
-        outMar = self.evaluate(inputValues, useMarabou=True, options=options, filename=filename)
+        try:
+            outMar = self.evaluateWithNetworkLevelReasoner(inputValues)
+        except ValueError:
+            outMar = self.evaluate(inputValues, useMarabou=True, options=options, filename=filename)
         outNotMar = self.evaluate(inputValues, useMarabou=False, options=options, filename=filename)
         err = np.abs(outMar - outNotMar)
         return err
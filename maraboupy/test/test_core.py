@@ -55,6 +55,37 @@ def test_dump_query():
     assert ipq.getLowerBound(2) > -LARGE
     assert ipq.getUpperBound(2) < LARGE
 
+def test_solver_session():
+    """
+    This function tests that queries solved in a MarabouCore.SolverSession only
+    see their own bounds and equations, on top of those of the base query.
+    """
+    ipq = define_ipq(3.0)
+    session = MarabouCore.SolverSession(ipq, OPT)
+
+    # x >= 0.5
+    vals, stats = session.solve({0: 0.5}, {})
+    assert not stats.hasTimedOut()
+    assert len(vals) > 0
+    assert vals[0] >= 0.5
+    assert vals[2] == pytest.approx(vals[0])
+
+    # x + y <= -2 cannot hold, since x >= -1 and y >= 0
+    property_eq = MarabouCore.Equation(MarabouCore.Equation.LE)
+    property_eq.addAddend(1, 0)
+    property_eq.addAddend(1, 2)
+    property_eq.setScalar(-2)
+    vals, stats = session.solve({}, {}, [property_eq])
+    assert len(vals) == 0
+
+    # x <= -0.5, without the equation of the previous query
+    vals, stats = session.solve({}, {0: -0.5})
+    assert len(vals) > 0
+    assert vals[0] <= -0.5
+    assert vals[2] == pytest.approx(0)
+
+    assert session.getNumSolvedQueries() == 3
+
 def define_ipq(property_bound):
     """
     This function defines a simple input query directly through MarabouCore
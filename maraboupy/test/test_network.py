@@ -78,6 +78,44 @@ def test_disjunction_constraint():
     for var in network.inputVars[0]:
         assert(abs(vals1[var] - 1) < 0.0000001 or abs(vals1[var]) < 0.0000001)
 
+def test_evaluate_with_network_level_reasoner():
+    """
+    Tests evaluating a network without the solver, one point at a time and as a batch.
+    Based on the acas_1_1 test, with the absolute value of an input added to the outputs,
+    so that not all outputs belong to the last layer.
+    """
+    filename =  "acasxu/ACASXU_experimental_v2a_1_1.nnet"
+    testInputs = [
+        [-0.31182839647533234, 0.0, -0.2387324146378273, -0.5, -0.4166666666666667],
+        [-0.16247807039378703, -0.4774648292756546, -0.2387324146378273, -0.3181818181818182, -0.25],
+        [-0.2454504737724233, -0.4774648292756546, 0.0, -0.3181818181818182, 0.0]
+    ]
+    testOutputs = [
+        [0.45556007, 0.44454904, 0.49616356, 0.38924966, 0.50136678, abs(testInputs[0][0])],
+        [-0.02158248, -0.01885345, -0.01892334, -0.01892597, -0.01893113, abs(testInputs[1][0])],
+        [0.05990158, 0.05273383, 0.10029709, 0.01883183, 0.10521622, abs(testInputs[2][0])]
+    ]
+
+    network = loadNetwork(filename)
+    abs_inp = network.getNewVariable()
+    network.outputVars = np.array([list(network.outputVars[0])+[abs_inp]])
+    network.addAbsConstraint(network.inputVars[0][0], abs_inp)
+
+    for testInput, testOutput in zip(testInputs, testOutputs):
+        nlrEval = network.evaluateWithNetworkLevelReasoner([testInput])
+        assert nlrEval.shape == network.outputVars.shape
+        assert max(abs(nlrEval.flatten() - testOutput)) < TOL
+
+    batchEval = network.evaluateBatchWithNetworkLevelReasoner(np.array(testInputs))
+    assert batchEval.shape == (len(testInputs),) + network.outputVars.shape
+    assert np.max(abs(batchEval.reshape(len(testInputs), -1) - np.array(testOutputs))) < TOL
+
+    # The same query is reused until the network changes
+    query = network.getEvaluationQuery()
+    assert network.getEvaluationQuery() is query
+    network.getNewVariable()
+    assert network.getEvaluationQuery() is not query
+
 def loadNetwork(filename):
     # Load network relative to this file's location
     filename = os.path.join(os.path.dirname(__file__), NETWORK_FOLDER, filename)
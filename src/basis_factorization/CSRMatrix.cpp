@@ -18,7 +18,9 @@
 #include "Debug.h"
 #include "FloatUtils.h"
 #include "MString.h"
+#include "Pair.h"
 #include "SparseUnsortedList.h"
+#include "Vector.h"
 
 CSRMatrix::CSRMatrix()
     : _m( 0 )
@@ -76,6 +78,60 @@ void CSRMatrix::initialize( const double *M, unsigned m, unsigned n )
     }
 }
 
+void CSRMatrix::initialize( const SparseUnsortedList **V, unsigned m, unsigned n )
+{
+    _m = m;
+    _n = n;
+
+    // Allocate exactly as many entries as the rows have, instead
+    // of the dense-based estimate
+    _estimatedNnz = 0;
+    for ( unsigned i = 0; i < _m; ++i )
+        _estimatedNnz += V[i]->getNnz();
+    _estimatedNnz = std::max( 2U, _estimatedNnz );
+
+    freeMemoryIfNeeded();
+
+    _A = new double[_estimatedNnz];
+    if ( !_A )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "CSRMatrix::A" );
+
+    _IA = new unsigned[_m + 1];
+    if ( !_IA )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "CSRMatrix::IA" );
+
+    _JA = new unsigned[_estimatedNnz];
+    if ( !_JA )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "CSRMatrix::JA" );
+
+    // The rows are unsorted, whereas the entries of each CSR row
+    // are kept in increasing column order
+    Vector<Pair<unsigned, double>> row;
+
+    _nnz = 0;
+    _IA[0] = 0;
+    for ( unsigned i = 0; i < _m; ++i )
+    {
+        row.clear();
+        for ( const auto &entry : *V[i] )
+        {
+            // Ignore zero entries
+            if ( !FloatUtils::isZero( entry._value ) )
+                row.append( Pair<unsigned, double>( entry._index, entry._value ) );
+        }
+        row.sort();
+
+        for ( const auto &entry : row )
+        {
+            _A[_nnz] = entry.second();
+            _JA[_nnz] = entry.first();
+            ++_nnz;
+        }
+
+        _IA[i + 1] = _nnz;
+    }
+}
+
 void CSRMatrix::initializeToEmpty( unsigned m, unsigned n )
 {
     _m = m;
@@ -104,8 +160,10 @@ void CSRMatrix::initializeToEmpty( unsigned m, unsigned n )
 
 void CSRMatrix::increaseCapacity()
 {
+    // Grow geometrically, so that a matrix initialized with its exact
+    // number of entries does not jump to the dense-based estimate
     unsigned estimatedNumRowEntries = std::max( 2U, _n / ROW_DENSITY_ESTIMATE );
-    unsigned newEstimatedNnz = _estimatedNnz + ( estimatedNumRowEntries * _m );
+    unsigned newEstimatedNnz = _estimatedNnz + std::max( estimatedNumRowEntries, _estimatedNnz );
 
     double *newA = new double[newEstimatedNnz];
     if ( !newA )
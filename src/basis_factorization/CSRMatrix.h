@@ -52,6 +52,7 @@ public:
     CSRMatrix();
     ~CSRMatrix();
     void initialize( const double *M, unsigned m, unsigned n );
+    void initialize( const SparseUnsortedList **V, unsigned m, unsigned n );
     void initializeToEmpty( unsigned m, unsigned n );
 
     /*
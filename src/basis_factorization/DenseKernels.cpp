@@ -0,0 +1,420 @@
+/*********************                                                        */
+/*! \file DenseKernels.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** Implementation of the dense vector kernels. The scalar, AVX2 and
+ ** AVX-512 variants of every kernel are collected in tables, and the table
+ ** for the widest instruction set the CPU supports is selected on first
+ ** use (or by setInstructionSet(), for testing). Floating point
+ ** contraction is disabled in this file, so that the vector kernels do not
+ ** fuse multiplications and additions the scalar ones perform separately.
+
+**/
+
+#include "Debug.h"
+#include "DenseKernels.h"
+#include "FloatUtils.h"
+#include "GlobalConfiguration.h"
+
+#if defined( __GNUC__ ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+#define DENSE_KERNELS_X86
+#include <immintrin.h>
+#endif
+
+/*
+  AVX-512 implies FMA, and the compiler would otherwise fuse the
+  multiplications and additions of the kernels, changing their results.
+*/
+#if defined( __clang__ )
+#pragma clang fp contract( off )
+#elif defined( __GNUC__ )
+#pragma GCC optimize ( "fp-contract=off" )
+#endif
+
+struct KernelTable
+{
+    void ( *addMultiple )( double *, const double *, double, unsigned );
+    void ( *addMultipleAndRoundToZero )( double *, const double *, double, unsigned );
+    double ( *dotProduct )( const double *, const double *, unsigned );
+    double ( *gatheredDotProduct )( const double *, const double *, const unsigned *, unsigned );
+};
+
+/*
+  Scalar kernels
+*/
+
+static void addMultipleScalar( double *y, const double *x, double multiplier, unsigned size )
+{
+    for ( unsigned i = 0; i < size; ++i )
+        y[i] += multiplier * x[i];
+}
+
+static void addMultipleAndRoundToZeroScalar( double *y, const double *x, double multiplier,
+                                             unsigned size )
+{
+    for ( unsigned i = 0; i < size; ++i )
+    {
+        y[i] += multiplier * x[i];
+        if ( FloatUtils::isZero( y[i] ) )
+            y[i] = 0.0;
+    }
+}
+
+static double dotProductScalar( const double *x, const double *y, unsigned size )
+{
+    double result = 0;
+    for ( unsigned i = 0; i < size; ++i )
+        result += x[i] * y[i];
+    return result;
+}
+
+static double gatheredDotProductScalar( const double *x, const double *y,
+                                        const unsigned *indices, unsigned size )
+{
+    double result = 0;
+    for ( unsigned i = 0; i < size; ++i )
+        result += x[indices[i]] * y[indices[i]];
+    return result;
+}
+
+static const KernelTable SCALAR_KERNELS = {
+    addMultipleScalar,
+    addMultipleAndRoundToZeroScalar,
+    dotProductScalar,
+    gatheredDotProductScalar,
+};
+
+#ifdef DENSE_KERNELS_X86
+
+/*
+  AVX2 kernels. Rounding to zero replicates FloatUtils::isZero(): x is
+  zero if ( x - epsilon ) * ( x + epsilon ) <= 0.
+*/
+
+__attribute__(( target( "avx2" ) ))
+static void addMultipleAvx2( double *y, const double *x, double multiplier, unsigned size )
+{
+    __m256d multipliers = _mm256_set1_pd( multiplier );
+
+    unsigned i = 0;
+    for ( ; i + 4 <= size; i += 4 )
+    {
+        __m256d product = _mm256_mul_pd( multipliers, _mm256_loadu_pd( x + i ) );
+        _mm256_storeu_pd( y + i, _mm256_add_pd( _mm256_loadu_pd( y + i ), product ) );
+    }
+
+    for ( ; i < size; ++i )
+        y[i] += multiplier * x[i];
+}
+
+__attribute__(( target( "avx2" ) ))
+static void addMultipleAndRoundToZeroAvx2( double *y, const double *x, double multiplier,
+                                           unsigned size )
+{
+    double epsilon = GlobalConfiguration::DEFAULT_EPSILON_FOR_COMPARISONS;
+    __m256d multipliers = _mm256_set1_pd( multiplier );
+    __m256d epsilons = _mm256_set1_pd( epsilon );
+    __m256d zeros = _mm256_setzero_pd();
+
+    unsigned i = 0;
+    for ( ; i + 4 <= size; i += 4 )
+    {
+        __m256d product = _mm256_mul_pd( multipliers, _mm256_loadu_pd( x + i ) );
+        __m256d sum = _mm256_add_pd( _mm256_loadu_pd( y + i ), product );
+        __m256d test = _mm256_mul_pd( _mm256_sub_pd( sum, epsilons ),
+                                      _mm256_add_pd( sum, epsilons ) );
+        __m256d isZero = _mm256_cmp_pd( test, zeros, _CMP_LE_OQ );
+        _mm256_storeu_pd( y + i, _mm256_blendv_pd( sum, zeros, isZero ) );
+    }
+
+    for ( ; i < size; ++i )
+    {
+        y[i] += multiplier * x[i];
+        if ( FloatUtils::isZero( y[i] ) )
+            y[i] = 0.0;
+    }
+}
+
+__attribute__(( target( "avx2" ) ))
+static double horizontalSumAvx2( __m256d values )
+{
+    __m128d sum = _mm_add_pd( _mm256_castpd256_pd128( values ),
+                              _mm256_extractf128_pd( values, 1 ) );
+    return _mm_cvtsd_f64( _mm_add_sd( sum, _mm_unpackhi_pd( sum, sum ) ) );
+}
+
+__attribute__(( target( "avx2" ) ))
+static double dotProductAvx2( const double *x, const double *y, unsigned size )
+{
+    __m256d sums = _mm256_setzero_pd();
+
+    unsigned i = 0;
+    for ( ; i + 4 <= size; i += 4 )
+        sums = _mm256_add_pd( sums, _mm256_mul_pd( _mm256_loadu_pd( x + i ),
+                                                   _mm256_loadu_pd( y + i ) ) );
+
+    double result = horizontalSumAvx2( sums );
+    for ( ; i < size; ++i )
+        result += x[i] * y[i];
+    return result;
+}
+
+__attribute__(( target( "avx2" ) ))
+static double gatheredDotProductAvx2( const double *x, const double *y,
+                                      const unsigned *indices, unsigned size )
+{
+    __m256d sums = _mm256_setzero_pd();
+
+    // The masked gathers, with an explicit source, avoid the undefined
+    // registers of the unmasked ones, which GCC warns about
+    __m256d zeros = _mm256_setzero_pd();
+    __m256d mask = _mm256_castsi256_pd( _mm256_set1_epi64x( -1 ) );
+
+    unsigned i = 0;
+    for ( ; i + 4 <= size; i += 4 )
+    {
+        __m128i offsets = _mm_loadu_si128( (const __m128i *)( indices + i ) );
+        sums = _mm256_add_pd( sums, _mm256_mul_pd
+                              ( _mm256_mask_i32gather_pd( zeros, x, offsets, mask, 8 ),
+                                _mm256_mask_i32gather_pd( zeros, y, offsets, mask, 8 ) ) );
+    }
+
+    double result = horizontalSumAvx2( sums );
+    for ( ; i < size; ++i )
+        result += x[indices[i]] * y[indices[i]];
+    return result;
+}
+
+static const KernelTable AVX2_KERNELS = {
+    addMultipleAvx2,
+    addMultipleAndRoundToZeroAvx2,
+    dotProductAvx2,
+    gatheredDotProductAvx2,
+};
+
+/*
+  AVX-512 kernels
+*/
+
+__attribute__(( target( "avx512f" ) ))
+static void addMultipleAvx512( double *y, const double *x, double multiplier, unsigned size )
+{
+    __m512d multipliers = _mm512_set1_pd( multiplier );
+
+    unsigned i = 0;
+    for ( ; i + 8 <= size; i += 8 )
+    {
+        __m512d product = _mm512_mul_pd( multipliers, _mm512_loadu_pd( x + i ) );
+        _mm512_storeu_pd( y + i, _mm512_add_pd( _mm512_loadu_pd( y + i ), product ) );
+    }
+
+    for ( ; i < size; ++i )
+        y[i] += multiplier * x[i];
+}
+
+__attribute__(( target( "avx512f" ) ))
+static void addMultipleAndRoundToZeroAvx512( double *y, const double *x, double multiplier,
+                                             unsigned size )
+{
+    double epsilon = GlobalConfiguration::DEFAULT_EPSILON_FOR_COMPARISONS;
+    __m512d multipliers = _mm512_set1_pd( multiplier );
+    __m512d epsilons = _mm512_set1_pd( epsilon );
+    __m512d zeros = _mm512_setzero_pd();
+
+    unsigned i = 0;
+    for ( ; i + 8 <= size; i += 8 )
+    {
+        __m512d product = _mm512_mul_pd( multipliers, _mm512_loadu_pd( x + i ) );
+        __m512d sum = _mm512_add_pd( _mm512_loadu_pd( y + i ), product );
+        __m512d test = _mm512_mul_pd( _mm512_sub_pd( sum, epsilons ),
+                                      _mm512_add_pd( sum, epsilons ) );
+        __mmask8 isZero = _mm512_cmp_pd_mask( test, zeros, _CMP_LE_OQ );
+        _mm512_storeu_pd( y + i, _mm512_mask_mov_pd( sum, isZero, zeros ) );
+    }
+
+    for ( ; i < size; ++i )
+    {
+        y[i] += multiplier * x[i];
+        if ( FloatUtils::isZero( y[i] ) )
+            y[i] = 0.0;
+    }
+}
+
+__attribute__(( target( "avx512f" ) ))
+static double horizontalSumAvx512( __m512d values )
+{
+    double lanes[8];
+    _mm512_storeu_pd( lanes, values );
+
+    double sum = 0;
+    for ( unsigned i = 0; i < 8; ++i )
+        sum += lanes[i];
+    return sum;
+}
+
+__attribute__(( target( "avx512f" ) ))
+static double dotProductAvx512( const double *x, const double *y, unsigned size )
+{
+    __m512d sums = _mm512_setzero_pd();
+
+    unsigned i = 0;
+    for ( ; i + 8 <= size; i += 8 )
+        sums = _mm512_add_pd( sums, _mm512_mul_pd( _mm512_loadu_pd( x + i ),
+                                                   _mm512_loadu_pd( y + i ) ) );
+
+    double result = horizontalSumAvx512( sums );
+    for ( ; i < size; ++i )
+        result += x[i] * y[i];
+    return result;
+}
+
+__attribute__(( target( "avx512f" ) ))
+static double gatheredDotProductAvx512( const double *x, const double *y,
+                                        const unsigned *indices, unsigned size )
+{
+    __m512d sums = _mm512_setzero_pd();
+    __m512d zeros = _mm512_setzero_pd();
+
+    unsigned i = 0;
+    for ( ; i + 8 <= size; i += 8 )
+    {
+        __m256i offsets = _mm256_loadu_si256( (const __m256i *)( indices + i ) );
+        sums = _mm512_add_pd( sums, _mm512_mul_pd
+                              ( _mm512_mask_i32gather_pd( zeros, 0xFF, offsets, x, 8 ),
+                                _mm512_mask_i32gather_pd( zeros, 0xFF, offsets, y, 8 ) ) );
+    }
+
+    double result = horizontalSumAvx512( sums );
+    for ( ; i < size; ++i )
+        result += x[indices[i]] * y[indices[i]];
+    return result;
+}
+
+static const KernelTable AVX512_KERNELS = {
+    addMultipleAvx512,
+    addMultipleAndRoundToZeroAvx512,
+    dotProductAvx512,
+    gatheredDotProductAvx512,
+};
+
+#endif // DENSE_KERNELS_X86
+
+static const KernelTable *getKernelTable( DenseKernels::InstructionSet instructionSet )
+{
+#ifdef DENSE_KERNELS_X86
+    if ( instructionSet == DenseKernels::AVX512 )
+        return &AVX512_KERNELS;
+    if ( instructionSet == DenseKernels::AVX2 )
+        return &AVX2_KERNELS;
+#endif
+    ASSERT( instructionSet == DenseKernels::SCALAR );
+    return &SCALAR_KERNELS;
+}
+
+static DenseKernels::InstructionSet detectInstructionSet()
+{
+    if ( DenseKernels::isSupported( DenseKernels::AVX512 ) )
+        return DenseKernels::AVX512;
+    if ( DenseKernels::isSupported( DenseKernels::AVX2 ) )
+        return DenseKernels::AVX2;
+    return DenseKernels::SCALAR;
+}
+
+static DenseKernels::InstructionSet &currentInstructionSet()
+{
+    static DenseKernels::InstructionSet instructionSet = detectInstructionSet();
+    return instructionSet;
+}
+
+static const KernelTable *&currentKernels()
+{
+    static const KernelTable *kernels = getKernelTable( currentInstructionSet() );
+    return kernels;
+}
+
+void DenseKernels::addMultiple( double *y, const double *x, double multiplier, unsigned size )
+{
+    currentKernels()->addMultiple( y, x, multiplier, size );
+}
+
+void DenseKernels::addMultipleAndRoundToZero( double *y, const double *x, double multiplier,
+                                              unsigned size )
+{
+    currentKernels()->addMultipleAndRoundToZero( y, x, multiplier, size );
+}
+
+double DenseKernels::dotProduct( const double *x, const double *y, unsigned size )
+{
+    return currentKernels()->dotProduct( x, y, size );
+}
+
+double DenseKernels::gatheredDotProduct( const double *x, const double *y,
+                                         const unsigned *indices, unsigned size )
+{
+    return currentKernels()->gatheredDotProduct( x, y, indices, size );
+}
+
+DenseKernels::InstructionSet DenseKernels::getInstructionSet()
+{
+    return currentInstructionSet();
+}
+
+bool DenseKernels::isSupported( InstructionSet instructionSet )
+{
+    switch ( instructionSet )
+    {
+    case SCALAR:
+        return true;
+
+#ifdef DENSE_KERNELS_X86
+    case AVX2:
+        return __builtin_cpu_supports( "avx2" );
+
+    case AVX512:
+        return __builtin_cpu_supports( "avx512f" );
+#endif
+
+    default:
+        return false;
+    }
+}
+
+void DenseKernels::setInstructionSet( InstructionSet instructionSet )
+{
+    ASSERT( isSupported( instructionSet ) );
+    currentInstructionSet() = instructionSet;
+    currentKernels() = getKernelTable( instructionSet );
+}
+
+const char *DenseKernels::instructionSetToString( InstructionSet instructionSet )
+{
+    switch ( instructionSet )
+    {
+    case SCALAR:
+        return "scalar";
+
+    case AVX2:
+        return "AVX2";
+
+    case AVX512:
+        return "AVX-512";
+
+    default:
+        return "unknown";
+    }
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,76 @@
+/*********************                                                        */
+/*! \file DenseKernels.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** Vector kernels for the dense basis factorizations. Each kernel has a
+ ** scalar implementation and, on x86, AVX2 and AVX-512 implementations;
+ ** the widest one the CPU supports is selected at runtime.
+ **
+ ** The element-wise kernels compute exactly what the scalar loops do,
+ ** so their results are bit-identical. The dot products sum in a
+ ** different order, and so may differ in the last bits.
+ **/
+
+#ifndef __DenseKernels_h__
+#define __DenseKernels_h__
+
+class DenseKernels
+{
+public:
+    enum InstructionSet {
+        SCALAR = 0,
+        AVX2 = 1,
+        AVX512 = 2,
+    };
+
+    /*
+      y += multiplier * x
+    */
+    static void addMultiple( double *y, const double *x, double multiplier, unsigned size );
+
+    /*
+      As above, and then set to 0 the entries of y that are zero up to
+      the default epsilon, as FloatUtils::isZero() does.
+    */
+    static void addMultipleAndRoundToZero( double *y, const double *x, double multiplier,
+                                           unsigned size );
+
+    /*
+      The sum of x[i] * y[i]
+    */
+    static double dotProduct( const double *x, const double *y, unsigned size );
+
+    /*
+      The sum of x[indices[i]] * y[indices[i]]
+    */
+    static double gatheredDotProduct( const double *x, const double *y,
+                                      const unsigned *indices, unsigned size );
+
+    /*
+      The instruction set of the kernels in use. By default, this is the
+      widest one supported by the CPU; it can be overridden, e.g. for
+      testing, with one that is supported.
+    */
+    static InstructionSet getInstructionSet();
+    static bool isSupported( InstructionSet instructionSet );
+    static void setInstructionSet( InstructionSet instructionSet );
+
+    static const char *instructionSetToString( InstructionSet instructionSet );
+};
+
+#endif // __DenseKernels_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -14,10 +14,14 @@
  **/
 
 #include "BasisFactorizationError.h"
+#include "DenseKernels.h"
 #include "EtaMatrix.h"
 #include "FloatUtils.h"
 #include "ForrestTomlinFactorization.h"
+#include "GlobalConfiguration.h"
 #include "MalformedBasisException.h"
+#include "Profiler.h"
+#include "SparseUnsortedList.h"
 #include <cstdlib>
 #include <cstring>
 
@@ -29,6 +33,8 @@ ForrestTomlinFactorization::ForrestTomlinFactorization( unsigned m, const BasisC
     , _invQ( m )
     , _U( NULL )
     , _explicitBasisAvailable( false )
+    , _transformationsCost( 0 )
+    , _statistics( NULL )
     , _workMatrix( NULL )
     , _workVector( NULL )
     , _workW( NULL )
@@ -175,8 +181,8 @@ void ForrestTomlinFactorization::updateToAdjacentBasis( unsigned columnIndex,
     {
         // Multiply _workVector by Ui
         ASSERT( _U[i]->_column[_U[i]->_columnIndex] == 1 );
-        for ( unsigned j = 0; j < _U[i]->_columnIndex; ++j )
-            _workVector[j] += ( _workVector[_U[i]->_columnIndex] * _U[i]->_column[j] );
+        DenseKernels::addMultiple( _workVector, _U[i]->_column,
+                                   _workVector[_U[i]->_columnIndex], _U[i]->_columnIndex );
     }
 
     memcpy( _U[indexOfChangedUColumn]->_column, _workVector, sizeof(double) * _m );
@@ -296,8 +302,11 @@ void ForrestTomlinFactorization::updateToAdjacentBasis( unsigned columnIndex,
     // Finally, append the new As to the list
     _A.append( newAs );
 
-    // If the number of A matrices is too great, condense them.
-    if ( _A.size() > GlobalConfiguration::REFACTORIZATION_THRESHOLD )
+    _refactorizationTrigger.basisUpdated( _transformationsCost );
+    _transformationsCost = 0;
+
+    // If the A matrices have become too costly, condense them.
+    if ( shouldRefactorize() )
         obtainFreshBasis();
 }
 
@@ -324,6 +333,7 @@ void ForrestTomlinFactorization::forwardTransformation( const double *y, double
     Step 1: Find w such that:  w = inv(Q) * Ak...A1 * LsPs...L1P1 * y
     ****/
 
+    _transformationsCost += computeTransformationCost();
     memcpy( _workVector, y, sizeof(double) * _m );
 
     // Multiply y by Ps and Ls
@@ -341,13 +351,9 @@ void ForrestTomlinFactorization::forwardTransformation( const double *y, double
             double diagonalEntry = _workVector[col];
 
             _workVector[col] *= (*lp)->_eta->_column[col];
-            for ( unsigned i = col + 1; i < _m; ++i )
-            {
-                _workVector[i] += diagonalEntry * (*lp)->_eta->_column[i];
-
-                if ( FloatUtils::isZero( _workVector[i] ) )
-                    _workVector[i] = 0.0;
-            }
+            DenseKernels::addMultipleAndRoundToZero( _workVector + col + 1,
+                                                     (*lp)->_eta->_column + col + 1,
+                                                     diagonalEntry, _m - col - 1 );
         }
     }
 
@@ -378,13 +384,8 @@ void ForrestTomlinFactorization::forwardTransformation( const double *y, double
     for ( int i = _m - 1; i >= 0; --i )
     {
         double diagonalEntry = _workW[_U[i]->_columnIndex];
-        for ( unsigned j = 0; j < _U[i]->_columnIndex; ++j )
-        {
-            _workW[j] -= _U[i]->_column[j] * diagonalEntry;
-
-            if ( FloatUtils::isZero( _workW[j] ) )
-                _workW[j] = 0.0;
-        }
+        DenseKernels::addMultipleAndRoundToZero( _workW, _U[i]->_column, -diagonalEntry,
+                                                 _U[i]->_columnIndex );
     }
 
     // We are now left with invQ x = w (for our modified w). Multiply by Q and be done.
@@ -413,6 +414,8 @@ void ForrestTomlinFactorization::backwardTransformation( const double *y, double
 
     unsigned columnIndex;
 
+    _transformationsCost += computeTransformationCost();
+
     /****
          Step 1: Find v such that:  v * Um...U1 = y * Q
     ****/
@@ -429,13 +432,11 @@ void ForrestTomlinFactorization::backwardTransformation( const double *y, double
         columnIndex = _U[i]->_columnIndex;
 
         // Only one entry of _workVector is changed by the undoing of each u
-        for ( unsigned j = 0; j < _m; ++j )
-        {
-            if ( j == columnIndex )
-                continue;
-
-            _workVector[columnIndex] -= ( _U[i]->_column[j] * _workVector[j] );
-        }
+        _workVector[columnIndex] -=
+            DenseKernels::dotProduct( _U[i]->_column, _workVector, columnIndex ) +
+            DenseKernels::dotProduct( _U[i]->_column + columnIndex + 1,
+                                      _workVector + columnIndex + 1,
+                                      _m - columnIndex - 1 );
 
         ASSERT( FloatUtils::areEqual( _U[i]->_column[columnIndex], 1.0 ) );
 
@@ -483,13 +484,10 @@ void ForrestTomlinFactorization::backwardTransformation( const double *y, double
             columnIndex = lp->_eta->_columnIndex;
 
             x[columnIndex] *= lp->_eta->_column[columnIndex];
-            for ( unsigned i = 0; i < _m; ++i )
-            {
-                if ( i == columnIndex )
-                    continue;
-
-                x[columnIndex] += ( lp->_eta->_column[i] * x[i] );
-            }
+            x[columnIndex] +=
+                DenseKernels::dotProduct( lp->_eta->_column, x, columnIndex ) +
+                DenseKernels::dotProduct( lp->_eta->_column + columnIndex + 1,
+                                          x + columnIndex + 1, _m - columnIndex - 1 );
 
             if ( FloatUtils::isZero( x[columnIndex] ) )
                 x[columnIndex] = 0.0;
@@ -497,6 +495,28 @@ void ForrestTomlinFactorization::backwardTransformation( const double *y, double
     }
 }
 
+void ForrestTomlinFactorization::forwardTransformation( const SparseUnsortedList *y, double *x ) const
+{
+    // The dense transformation copies y before writing x, so it can
+    // be applied in place
+    std::fill_n( x, _m, 0.0 );
+    for ( const auto &entry : *y )
+        x[entry._index] = entry._value;
+
+    forwardTransformation( x, x );
+}
+
+void ForrestTomlinFactorization::backwardTransformation( const SparseUnsortedList *y, double *x ) const
+{
+    // The dense transformation copies y before writing x, so it can
+    // be applied in place
+    std::fill_n( x, _m, 0.0 );
+    for ( const auto &entry : *y )
+        x[entry._index] = entry._value;
+
+    backwardTransformation( x, x );
+}
+
 void ForrestTomlinFactorization::storeFactorization( IBasisFactorization *other )
 {
     ForrestTomlinFactorization *otherFTFactorization = (ForrestTomlinFactorization *)other;
@@ -507,6 +527,7 @@ void ForrestTomlinFactorization::storeFactorization( IBasisFactorization *other
     otherFTFactorization->_Q = _Q;
     otherFTFactorization->_invQ = _invQ;
     otherFTFactorization->_explicitBasisAvailable = _explicitBasisAvailable;
+    otherFTFactorization->_refactorizationTrigger = _refactorizationTrigger;
 
     // Copy the basis matrix and its factorization
     memcpy( otherFTFactorization->_B, _B, sizeof(double) * _m * _m );
@@ -544,6 +565,7 @@ void ForrestTomlinFactorization::restoreFactorization( const IBasisFactorization
     _Q = otherFTFactorization->_Q;
     _invQ = otherFTFactorization->_invQ;
     _explicitBasisAvailable = otherFTFactorization->_explicitBasisAvailable;
+    _refactorizationTrigger = otherFTFactorization->_refactorizationTrigger;
 
     // Copy the basis matrix and its factorization
     memcpy( _B, otherFTFactorization->_B, sizeof(double) * _m * _m );
@@ -864,6 +886,8 @@ void ForrestTomlinFactorization::dump() const
 
 void ForrestTomlinFactorization::obtainFreshBasis()
 {
+    PROFILE_SCOPE( "BasisFactorization::refactorization" );
+
     for ( unsigned column = 0; column < _m; ++column )
     {
         _basisColumnOracle->getColumnOfBasis( column, _workVector );
@@ -874,6 +898,43 @@ void ForrestTomlinFactorization::obtainFreshBasis()
     clearFactorization();
     initialLUFactorization();
     _explicitBasisAvailable = true;
+
+    if ( _statistics )
+        _statistics->incNumBasisRefactorizations();
+
+    // Dense elimination, after copying the basis columns
+    double factorizationCost = ( (double)_m * _m * _m ) / 3 + (double)_m * _m;
+    _refactorizationTrigger.factorizationComputed( factorizationCost );
+    _transformationsCost = 0;
+}
+
+double ForrestTomlinFactorization::computeTransformationCost() const
+{
+    /*
+      A transformation goes over the dense LP and U factors, and the
+      A matrices. Every A matrix is a separate list element, applied to
+      the dense work vector, so count it as a row operation.
+    */
+    return (double)_m * _m + (double)_m * _A.size();
+}
+
+bool ForrestTomlinFactorization::shouldRefactorize() const
+{
+    if ( !GlobalConfiguration::USE_ADAPTIVE_REFACTORIZATION )
+        return _A.size() > GlobalConfiguration::REFACTORIZATION_THRESHOLD;
+
+    if ( !_refactorizationTrigger.shouldRefactorize() )
+        return false;
+
+    if ( _statistics )
+        _statistics->addAdaptiveRefactorization( _refactorizationTrigger.getNumUpdates() );
+
+    return true;
+}
+
+void ForrestTomlinFactorization::setStatistics( Statistics *statistics )
+{
+    _statistics = statistics;
 }
 
 //
@@ -21,6 +21,8 @@
 #include "LPElement.h"
 #include "List.h"
 #include "PermutationMatrix.h"
+#include "RefactorizationTrigger.h"
+#include "Statistics.h"
 
 /*
   Forrest-Tomlin factorization looks like this:
@@ -66,6 +68,14 @@ public:
     */
     void backwardTransformation( const double *y, double *x ) const;
 
+    /*
+      Transformations for a sparse right hand side. The dense basis
+      cannot exploit the sparsity of y, so y is scattered and the dense
+      transformations are used.
+    */
+    void forwardTransformation( const SparseUnsortedList *y, double *x ) const;
+    void backwardTransformation( const SparseUnsortedList *y, double *x ) const;
+
     /*
       Store/restore the basis factorization.
     */
@@ -99,6 +109,11 @@ public:
      */
     void invertBasis( double *result );
 
+    /*
+      Have the Basis Factoriaztion object start reporting statistics.
+    */
+    void setStatistics( Statistics *statistics );
+
 public:
     /*
       For testing purposes only
@@ -139,6 +154,19 @@ private:
     */
     bool _explicitBasisAvailable;
 
+    /*
+      Decides when to refactorize, based on the cost of the solves. The
+      cost of the transformations performed since the last basis update
+      is accumulated for it.
+    */
+    RefactorizationTrigger _refactorizationTrigger;
+    mutable double _transformationsCost;
+
+    /*
+      An object for reporting statistics
+    */
+    Statistics *_statistics;
+
     /*
       Work memory
     */
@@ -155,6 +183,13 @@ private:
     void clearFactorization();
     void initialLUFactorization();
 
+    /*
+      The cost of a single transformation with the current factorization,
+      and whether the basis should be refactorized now.
+    */
+    double computeTransformationCost() const;
+    bool shouldRefactorize() const;
+
 	/*
       Swap two rows of a matrix.
     */
@@ -15,6 +15,7 @@
 
 #include "BasisFactorizationError.h"
 #include "Debug.h"
+#include "DenseKernels.h"
 #include "EtaMatrix.h"
 #include "FloatUtils.h"
 #include "GaussianEliminator.h"
@@ -28,6 +29,8 @@ GaussianEliminator::GaussianEliminator( unsigned m )
     : _m( m )
     , _numURowElements( NULL )
     , _numUColumnElements( NULL )
+    , _pivotRowColumns( NULL )
+    , _wasZero( NULL )
 {
     _numURowElements = new unsigned[_m];
     if ( !_numURowElements )
@@ -38,6 +41,16 @@ GaussianEliminator::GaussianEliminator( unsigned m )
     if ( !_numUColumnElements )
         throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
                                        "GaussianEliminator::numUColumnElements" );
+
+    _pivotRowColumns = new unsigned[_m];
+    if ( !_pivotRowColumns )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "GaussianEliminator::pivotRowColumns" );
+
+    _wasZero = new bool[_m];
+    if ( !_wasZero )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "GaussianEliminator::wasZero" );
 }
 
 GaussianEliminator::~GaussianEliminator()
@@ -53,6 +66,18 @@ GaussianEliminator::~GaussianEliminator()
         delete[] _numUColumnElements;
         _numUColumnElements = NULL;
     }
+
+    if ( _pivotRowColumns )
+    {
+        delete[] _pivotRowColumns;
+        _pivotRowColumns = NULL;
+    }
+
+    if ( _wasZero )
+    {
+        delete[] _wasZero;
+        _wasZero = NULL;
+    }
 }
 
 void GaussianEliminator::initializeFactorization( const double *A, LUFactors *luFactors )
@@ -341,6 +366,20 @@ void GaussianEliminator::eliminate()
 
     GAUSSIAN_LOG( Stringf( "Eliminate called. Pivot element: %lf", pivotElement ).ascii() );
 
+    /*
+      Only the entries in columns where the pivot row is non-zero can
+      change in the rows below it. The entries of the pivot row in
+      previously eliminated columns are exactly zero, so the rows can be
+      updated in full.
+    */
+    const double *pivotRow = _luFactors->_V + _vPivotRow * _m;
+    unsigned numPivotRowColumns = 0;
+    for ( unsigned column = _eliminationStep + 1; column < _m; ++column )
+    {
+        if ( pivotRow[_luFactors->_Q._rowOrdering[column]] != 0 )
+            _pivotRowColumns[numPivotRowColumns++] = column;
+    }
+
     // Process all rows below the pivot row.
     for ( unsigned row = _eliminationStep + 1; row < _m; ++row )
     {
@@ -350,34 +389,36 @@ void GaussianEliminator::eliminate()
           We compute it in terms of V
         */
         unsigned vRowIndex = _luFactors->_P._columnOrdering[row];
-        double subDiagonalEntry = _luFactors->_V[vRowIndex*_m + _vPivotColumn];
+        double *vRow = _luFactors->_V + vRowIndex * _m;
+        double subDiagonalEntry = vRow[_vPivotColumn];
 
-        // Ignore zero entries
+        // Ignore zero entries, but keep the eliminated column exactly zero
         if ( FloatUtils::isZero( subDiagonalEntry ) )
+        {
+            vRow[_vPivotColumn] = 0;
             continue;
+        }
 
         double rowMultiplier = -subDiagonalEntry / pivotElement;
         GAUSSIAN_LOG( Stringf( "\tWorking on V row: %u. Multiplier: %lf", vRowIndex, rowMultiplier ).ascii() );
 
+        for ( unsigned i = 0; i < numPivotRowColumns; ++i )
+            _wasZero[i] = FloatUtils::isZero( vRow[_luFactors->_Q._rowOrdering[_pivotRowColumns[i]]] );
+
         // Eliminate the row
-        _luFactors->_V[vRowIndex*_m + _vPivotColumn] = 0;
+        DenseKernels::addMultipleAndRoundToZero( vRow, pivotRow, rowMultiplier, _m );
+        vRow[_vPivotColumn] = 0;
         --_numUColumnElements[_eliminationStep];
         --_numURowElements[row];
 
-        for ( unsigned column = _eliminationStep + 1; column < _m; ++column )
+        for ( unsigned i = 0; i < numPivotRowColumns; ++i )
         {
-            unsigned vColIndex = _luFactors->_Q._rowOrdering[column];
-
-            bool wasZero = FloatUtils::isZero( _luFactors->_V[vRowIndex*_m + vColIndex] );
-
-            _luFactors->_V[vRowIndex*_m + vColIndex] +=
-                rowMultiplier * _luFactors->_V[_vPivotRow*_m + vColIndex];
+            unsigned column = _pivotRowColumns[i];
+            bool isZero = ( vRow[_luFactors->_Q._rowOrdering[column]] == 0 );
 
-            bool isZero = FloatUtils::isZero( _luFactors->_V[vRowIndex*_m + vColIndex] );
-
-            if ( wasZero != isZero )
+            if ( _wasZero[i] != isZero )
             {
-                if ( wasZero )
+                if ( _wasZero[i] )
                 {
                     ++_numUColumnElements[column];
                     ++_numURowElements[row];
@@ -388,9 +429,6 @@ void GaussianEliminator::eliminate()
                     --_numURowElements[row];
                 }
             }
-
-            if ( isZero )
-                _luFactors->_V[vRowIndex*_m + vColIndex] = 0;
         }
 
         /*
@@ -59,6 +59,14 @@ private:
     unsigned *_numURowElements;
     unsigned *_numUColumnElements;
 
+    /*
+      Work space for the elimination step: the columns of the active
+      submatrix in which the pivot row is non-zero, and whether the
+      entries of the row being eliminated were zero in these columns
+    */
+    unsigned *_pivotRowColumns;
+    bool *_wasZero;
+
     void choosePivot();
     void initializeFactorization( const double *A, LUFactors *luFactors );
     void permute();
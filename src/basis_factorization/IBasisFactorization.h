@@ -73,6 +73,15 @@ public:
     */
     virtual void backwardTransformation( const double *y, double *x ) const = 0;
 
+    /*
+      Variants of the transformations for a sparse right hand side y,
+      e.g. a column of the constraint matrix or a unit vector.
+      Factorizations that can exploit the sparsity of y avoid sweeping
+      over all m entries. The result x is dense, of size m.
+    */
+    virtual void forwardTransformation( const SparseUnsortedList *y, double *x ) const = 0;
+    virtual void backwardTransformation( const SparseUnsortedList *y, double *x ) const = 0;
+
     /*
       Store/restore the basis factorization.
     */
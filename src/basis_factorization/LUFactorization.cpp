@@ -15,12 +15,15 @@
 
 #include "BasisFactorizationError.h"
 #include "Debug.h"
+#include "DenseKernels.h"
 #include "EtaMatrix.h"
 #include "FloatUtils.h"
 #include "GlobalConfiguration.h"
 #include "LPElement.h"
 #include "LUFactorization.h"
 #include "MalformedBasisException.h"
+#include "Profiler.h"
+#include "SparseUnsortedList.h"
 
 LUFactorization::LUFactorization( unsigned m, const BasisColumnOracle &basisColumnOracle )
     : IBasisFactorization( basisColumnOracle )
@@ -112,15 +115,11 @@ void LUFactorization::forwardTransformation( const double *y, double *x ) const
         double factor = x[eta->_columnIndex] * inverseDiagonal;
 
         // Solve all non-diagonal rows
-        for ( unsigned i = 0; i < _m; ++i )
-        {
-            if ( i == eta->_columnIndex )
-                continue;
-
-            x[i] -= ( factor * eta->_column[i] );
-            if ( FloatUtils::isZero( x[i] ) )
-                x[i] = 0.0;
-        }
+        DenseKernels::addMultipleAndRoundToZero( x, eta->_column, -factor,
+                                                 eta->_columnIndex );
+        DenseKernels::addMultipleAndRoundToZero( x + eta->_columnIndex + 1,
+                                                 eta->_column + eta->_columnIndex + 1,
+                                                 -factor, _m - eta->_columnIndex - 1 );
 
         // Handle the digonal element
         x[eta->_columnIndex] *= inverseDiagonal;
@@ -140,11 +139,10 @@ void LUFactorization::backwardTransformation( const double *y, double *x ) const
     {
         // The only entry in y that changes is columnIndex
         unsigned columnIndex = (*eta)->_columnIndex;
-        for ( unsigned i = 0; i < _m; ++i )
-        {
-            if ( i != columnIndex )
-                _z[columnIndex] -= (_z[i] * (*eta)->_column[i]);
-        }
+        _z[columnIndex] -=
+            DenseKernels::dotProduct( _z, (*eta)->_column, columnIndex ) +
+            DenseKernels::dotProduct( _z + columnIndex + 1, (*eta)->_column + columnIndex + 1,
+                                      _m - columnIndex - 1 );
 
         _z[columnIndex] = _z[columnIndex] / (*eta)->_column[columnIndex];
 
@@ -158,6 +156,28 @@ void LUFactorization::backwardTransformation( const double *y, double *x ) const
     _luFactors.backwardTransformation( _z, x );
 }
 
+void LUFactorization::forwardTransformation( const SparseUnsortedList *y, double *x ) const
+{
+    // The dense transformation copies y before writing x, so it can
+    // be applied in place
+    std::fill_n( x, _m, 0.0 );
+    for ( const auto &entry : *y )
+        x[entry._index] = entry._value;
+
+    forwardTransformation( x, x );
+}
+
+void LUFactorization::backwardTransformation( const SparseUnsortedList *y, double *x ) const
+{
+    // The dense transformation copies y before writing x, so it can
+    // be applied in place
+    std::fill_n( x, _m, 0.0 );
+    for ( const auto &entry : *y )
+        x[entry._index] = entry._value;
+
+    backwardTransformation( x, x );
+}
+
 void LUFactorization::clearFactorization()
 {
 	List<EtaMatrix *>::iterator it;
@@ -251,6 +271,8 @@ void LUFactorization::dump() const
 
 void LUFactorization::obtainFreshBasis()
 {
+    PROFILE_SCOPE( "BasisFactorization::refactorization" );
+
     for ( unsigned column = 0; column < _m; ++column )
     {
         _basisColumnOracle->getColumnOfBasis( column, _z );
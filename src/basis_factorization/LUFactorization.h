@@ -90,6 +90,14 @@ public:
     */
     void backwardTransformation( const double *y, double *x ) const;
 
+    /*
+      Transformations for a sparse right hand side. The dense basis
+      cannot exploit the sparsity of y, so y is scattered and the dense
+      transformations are used.
+    */
+    void forwardTransformation( const SparseUnsortedList *y, double *x ) const;
+    void backwardTransformation( const SparseUnsortedList *y, double *x ) const;
+
     /*
       Store and restore the basis factorization. Storing triggers
       condesning the etas.
@@ -15,6 +15,7 @@
 
 #include "BasisFactorizationError.h"
 #include "Debug.h"
+#include "DenseKernels.h"
 #include "FloatUtils.h"
 #include "LUFactors.h"
 #include "MString.h"
@@ -268,13 +269,11 @@ void LUFactors::vForwardTransformation( const double *y, double *x ) const
     {
         unsigned vRow = _P._columnOrdering[uRow];
         unsigned xBeingSolved = _Q._rowOrdering[uRow];
-        x[xBeingSolved] = y[vRow];
 
-        for ( unsigned uColumn = uRow + 1; uColumn < _m; ++uColumn )
-        {
-            unsigned vColumn = _Q._rowOrdering[uColumn];
-            x[xBeingSolved] -= ( _V[vRow*_m + vColumn] * x[vColumn] );
-        }
+        // The V columns of the U columns to the right of the diagonal
+        x[xBeingSolved] = y[vRow] -
+            DenseKernels::gatheredDotProduct( _V + vRow * _m, x, _Q._rowOrdering + uRow + 1,
+                                              _m - uRow - 1 );
 
         if ( FloatUtils::isZero( x[xBeingSolved] ) )
             x[xBeingSolved] = 0.0;
@@ -0,0 +1,75 @@
+/*********************                                                        */
+/*! \file RefactorizationTrigger.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** Implementation of the refactorization trigger: the bookkeeping of the
+ ** refactorization and solve costs, and the decision rule described in
+ ** RefactorizationTrigger.h.
+
+ **/
+
+#include "GlobalConfiguration.h"
+#include "RefactorizationTrigger.h"
+
+RefactorizationTrigger::RefactorizationTrigger()
+    : _factorizationCost( 0 )
+    , _solveCost( 0 )
+    , _totalSolveCost( 0 )
+    , _numUpdates( 0 )
+{
+}
+
+void RefactorizationTrigger::factorizationComputed( double factorizationCost )
+{
+    _factorizationCost = factorizationCost;
+    _solveCost = 0;
+    _totalSolveCost = 0;
+    _numUpdates = 0;
+}
+
+void RefactorizationTrigger::basisUpdated( double solveCost )
+{
+    _solveCost = solveCost;
+    _totalSolveCost += solveCost;
+    ++_numUpdates;
+}
+
+bool RefactorizationTrigger::shouldRefactorize() const
+{
+    if ( _numUpdates < GlobalConfiguration::ADAPTIVE_REFACTORIZATION_MIN_UPDATES )
+        return false;
+
+    if ( _numUpdates >= GlobalConfiguration::ADAPTIVE_REFACTORIZATION_MAX_UPDATES )
+        return true;
+
+    // Another update would increase the amortized cost
+    return _solveCost >= getAmortizedCost();
+}
+
+unsigned RefactorizationTrigger::getNumUpdates() const
+{
+    return _numUpdates;
+}
+
+double RefactorizationTrigger::getAmortizedCost() const
+{
+    if ( _numUpdates == 0 )
+        return _factorizationCost + _solveCost;
+
+    return ( _factorizationCost + _totalSolveCost ) / _numUpdates;
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,98 @@
+/*********************                                                        */
+/*! \file RefactorizationTrigger.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** Decides when a basis factorization that is updated in place should
+ ** be recomputed from scratch.
+ **
+ ** A refactorization costs R, after which every basis update is
+ ** followed by solves whose cost c_i grows with the update file.
+ ** After k updates, the amortized cost per update is
+ **
+ **     ( R + c_1 + ... + c_k ) / k
+ **
+ ** Because the c_i grow, this average is minimal at the first k for
+ ** which the next update would cost at least the average so far;
+ ** this is when we refactorize. The number of updates between
+ ** refactorizations is also bounded from below and from above, to
+ ** cover costs the model does not capture (e.g., the overhead of
+ ** obtaining a fresh basis, or the loss of precision).
+ **
+ ** Costs are measured in operations on the entries of the factors and
+ ** of the vectors being solved for. The factorizations count these
+ ** operations as they perform them: the refactorization cost is the work
+ ** of the last elimination, and the cost of an update is the work of
+ ** all the transformations performed since the previous one.
+
+ **/
+
+#ifndef __RefactorizationTrigger_h__
+#define __RefactorizationTrigger_h__
+
+class RefactorizationTrigger
+{
+public:
+    RefactorizationTrigger();
+
+    /*
+      A fresh factorization has been computed, at the given cost.
+    */
+    void factorizationComputed( double factorizationCost );
+
+    /*
+      The basis has been updated. The cost of the solves performed
+      since the previous update is given.
+    */
+    void basisUpdated( double solveCost );
+
+    /*
+      Return true iff the basis should be refactorized before the
+      next update.
+    */
+    bool shouldRefactorize() const;
+
+    /*
+      The number of basis updates since the last refactorization, and
+      the current amortized cost per update.
+    */
+    unsigned getNumUpdates() const;
+    double getAmortizedCost() const;
+
+private:
+    /*
+      The cost of the last refactorization
+    */
+    double _factorizationCost;
+
+    /*
+      The cost of the solves of the most recent basis update
+    */
+    double _solveCost;
+
+    /*
+      The total cost of the solves since the last refactorization
+    */
+    double _totalSolveCost;
+
+    /*
+      The number of basis updates since the last refactorization
+    */
+    unsigned _numUpdates;
+};
+
+#endif // __RefactorizationTrigger_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -18,7 +18,9 @@
 #include "FloatUtils.h"
 #include "GlobalConfiguration.h"
 #include "MalformedBasisException.h"
+#include "Profiler.h"
 #include "SparseFTFactorization.h"
+#include "SparseUnsortedList.h"
 
 SparseFTFactorization::SparseFTFactorization( unsigned m, const BasisColumnOracle &basisColumnOracle )
     : IBasisFactorization( basisColumnOracle )
@@ -31,6 +33,7 @@ SparseFTFactorization::SparseFTFactorization( unsigned m, const BasisColumnOracl
     , _z2( NULL )
     , _z3( NULL )
     , _z4( NULL )
+    , _inPattern( NULL )
 {
     _z1 = new double[m];
     if ( !_z1 )
@@ -47,6 +50,11 @@ SparseFTFactorization::SparseFTFactorization( unsigned m, const BasisColumnOracl
     _z4 = new double[m];
     if ( !_z4 )
         throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseFTFactorization::z4" );
+
+    _inPattern = new bool[m];
+    if ( !_inPattern )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseFTFactorization::inPattern" );
+    std::fill_n( _inPattern, m, false );
 }
 
 SparseFTFactorization::~SparseFTFactorization()
@@ -81,6 +89,12 @@ void SparseFTFactorization::freeIfNeeded()
         delete[] _z4;
         _z4 = NULL;
     }
+
+    if ( _inPattern )
+    {
+        delete[] _inPattern;
+        _inPattern = NULL;
+    }
 }
 
 const double *SparseFTFactorization::getBasis() const
@@ -104,7 +118,7 @@ void SparseFTFactorization::updateToAdjacentBasis( unsigned columnIndex,
     // p = vRowDiagonalIndex
     // t = lastNonZeroEntryInU
 
-    if ( _etas.size() > GlobalConfiguration::REFACTORIZATION_THRESHOLD )
+    if ( shouldRefactorize() )
     {
         obtainFreshBasis();
         return;
@@ -140,6 +154,7 @@ void SparseFTFactorization::updateToAdjacentBasis( unsigned columnIndex,
     DEBUG( bool foundNonZeroEntry = false );
 
     _sparseLUFactors._Vt->clear( columnIndex );
+    _sparseLUFactors._numOperations += _m;
     for ( unsigned i = 0; i < _m; ++i )
     {
         if ( !FloatUtils::isZero( _z4[i] ) )
@@ -170,6 +185,7 @@ void SparseFTFactorization::updateToAdjacentBasis( unsigned columnIndex,
     {
         _sparseLUFactors._vDiagonalElements[vRowDiagonalIndex] = pivotElement;
         ASSERT( uColumnIndex == lastNonZeroEntryInU ); // Otherwise, singular matrix
+        reportBasisUpdate();
         return;
     }
 
@@ -223,6 +239,7 @@ void SparseFTFactorization::updateToAdjacentBasis( unsigned columnIndex,
     if ( !haveSpike )
     {
         _sparseLUFactors._vDiagonalElements[vRowDiagonalIndex] = pivotElement;
+        reportBasisUpdate();
         return;
     }
 
@@ -237,6 +254,7 @@ void SparseFTFactorization::updateToAdjacentBasis( unsigned columnIndex,
 
     // Copy the spike row to work memory
     _sparseLUFactors._V->getRowDense( vRowDiagonalIndex, _z3 );
+    _sparseLUFactors._numOperations += _m;
 
     for ( unsigned i = uColumnIndex; i < lastNonZeroEntryInU; ++i )
     {
@@ -261,6 +279,7 @@ void SparseFTFactorization::updateToAdjacentBasis( unsigned columnIndex,
         sparseEtaMatrix->addEntry( vPivotRow, multiplier );
 
         // Adjust the spike row per the elimination step
+        _sparseLUFactors._numOperations += sparseRow->getNnz();
         for ( unsigned j = 0; j < sparseRow->getNnz(); ++j )
         {
             entry = sparseRow->getByArrayIndex( j );
@@ -303,8 +322,11 @@ void SparseFTFactorization::updateToAdjacentBasis( unsigned columnIndex,
     _sparseLUFactors._V->updateSingleRow( vRowDiagonalIndex, _z3 );
     for ( unsigned i = 0; i < _m; ++i )
         _sparseLUFactors._Vt->set( i, vRowDiagonalIndex, _z3[i] );
+    _sparseLUFactors._numOperations += 2 * _m;
 
     _sparseLUFactors._vDiagonalElements[vRowDiagonalIndex] = _z3[columnIndex];
+
+    reportBasisUpdate();
 }
 
 void SparseFTFactorization::forwardTransformation( const double *y, double *x ) const
@@ -343,6 +365,85 @@ void SparseFTFactorization::backwardTransformation( const double *y, double *x )
     _sparseLUFactors.fBackwardTransformation( _z2, x );
 }
 
+void SparseFTFactorization::forwardTransformation( const SparseUnsortedList *y, double *x ) const
+{
+    /*
+      We are solving Bx = y, and we have the factorization:
+
+        B = FHV
+
+      The intermediate results are kept sparse, using the work
+      memory of the LU factors.
+    */
+
+    double *values = _sparseLUFactors._sparseWork;
+    unsigned *pattern = _sparseLUFactors._sparsePattern;
+    unsigned patternSize = 0;
+
+    for ( const auto &entry : *y )
+    {
+        values[entry._index] = entry._value;
+        pattern[patternSize] = entry._index;
+        ++patternSize;
+    }
+
+    // Eliminate F
+    _sparseLUFactors.fForwardTransformation( values, pattern, patternSize );
+
+    // Eliminate H
+    hForwardTransformation( values, pattern, patternSize );
+
+    // Eliminate V
+    std::fill_n( x, _m, 0.0 );
+    unsigned xPatternSize;
+    _sparseLUFactors.vForwardTransformation( values, pattern, patternSize,
+                                             x, _sparseLUFactors._sparsePattern2, xPatternSize );
+}
+
+void SparseFTFactorization::backwardTransformation( const SparseUnsortedList *y, double *x ) const
+{
+    /*
+      We are solving xB = y, and we have the factorization:
+
+        B = FHV
+
+      The intermediate results are kept sparse, using the work
+      memory of the LU factors.
+    */
+
+    double *values = _sparseLUFactors._sparseWork;
+    unsigned *pattern = _sparseLUFactors._sparsePattern;
+    unsigned patternSize = 0;
+
+    for ( const auto &entry : *y )
+    {
+        values[entry._index] = entry._value;
+        pattern[patternSize] = entry._index;
+        ++patternSize;
+    }
+
+    // Eliminate V
+    double *zValues = _sparseLUFactors._sparseWork2;
+    unsigned *zPattern = _sparseLUFactors._sparsePattern2;
+    unsigned zPatternSize;
+    _sparseLUFactors.vBackwardTransformation( values, pattern, patternSize,
+                                              zValues, zPattern, zPatternSize );
+
+    // Eliminate H
+    hBackwardTransformation( zValues, zPattern, zPatternSize );
+
+    // Eliminate F
+    _sparseLUFactors.fBackwardTransformation( zValues, zPattern, zPatternSize );
+
+    std::fill_n( x, _m, 0.0 );
+    for ( unsigned i = 0; i < zPatternSize; ++i )
+    {
+        unsigned index = zPattern[i];
+        x[index] = zValues[index];
+        zValues[index] = 0.0;
+    }
+}
+
 void SparseFTFactorization::clearFactorization()
 {
     List<SparseEtaMatrix *>::iterator it;
@@ -354,6 +455,8 @@ void SparseFTFactorization::clearFactorization()
 
 void SparseFTFactorization::factorizeBasis()
 {
+    PROFILE_SCOPE( "BasisFactorization::refactorization" );
+
     clearFactorization();
 
     try
@@ -370,6 +473,35 @@ void SparseFTFactorization::factorizeBasis()
 
     if ( _statistics )
         _statistics->incNumBasisRefactorizations();
+
+    /*
+      The cost of a refactorization: obtaining the basis columns, and
+      the eliminator's work, which includes its pivot search and the
+      building of the factors. The transformations performed from here
+      on are charged to the next basis update.
+    */
+    _refactorizationTrigger.factorizationComputed( _m + _sparseGaussianEliminator.getNumOperations() );
+    _sparseLUFactors._numOperations = 0;
+}
+
+void SparseFTFactorization::reportBasisUpdate()
+{
+    _refactorizationTrigger.basisUpdated( _sparseLUFactors._numOperations );
+    _sparseLUFactors._numOperations = 0;
+}
+
+bool SparseFTFactorization::shouldRefactorize() const
+{
+    if ( !GlobalConfiguration::USE_ADAPTIVE_REFACTORIZATION )
+        return _etas.size() > GlobalConfiguration::REFACTORIZATION_THRESHOLD;
+
+    if ( !_refactorizationTrigger.shouldRefactorize() )
+        return false;
+
+    if ( _statistics )
+        _statistics->addAdaptiveRefactorization( _refactorizationTrigger.getNumUpdates() );
+
+    return true;
 }
 
 void SparseFTFactorization::storeFactorization( IBasisFactorization *other )
@@ -382,6 +514,7 @@ void SparseFTFactorization::storeFactorization( IBasisFactorization *other )
 
     // Store the new basis and factorization
     _sparseLUFactors.storeToOther( &otherSparseFTFactorization->_sparseLUFactors );
+    otherSparseFTFactorization->_refactorizationTrigger = _refactorizationTrigger;
 }
 
 void SparseFTFactorization::restoreFactorization( const IBasisFactorization *other )
@@ -396,6 +529,7 @@ void SparseFTFactorization::restoreFactorization( const IBasisFactorization *oth
 
     // Store the new basis and factorization
     otherSparseFTFactorization->_sparseLUFactors.storeToOther( &_sparseLUFactors );
+    _refactorizationTrigger = otherSparseFTFactorization->_refactorizationTrigger;
 }
 
 void SparseFTFactorization::invertBasis( double *result )
@@ -442,10 +576,12 @@ void SparseFTFactorization::hForwardTransformation( const double *y, double *x )
     */
 
     memcpy( x, y, sizeof(double) * _m );
+    _sparseLUFactors._numOperations += _m;
 
     for ( const auto &eta : _etas )
     {
         unsigned pivotIndex = eta->_columnIndex;
+        _sparseLUFactors._numOperations += eta->_sparseColumn.size() + 1;
 
         for ( const auto &entry : eta->_sparseColumn )
         {
@@ -464,11 +600,13 @@ void SparseFTFactorization::hBackwardTransformation( const double *y, double *x
     */
 
     memcpy( x, y, sizeof(double) * _m );
+    _sparseLUFactors._numOperations += _m;
 
     for ( auto eta = _etas.rbegin(); eta != _etas.rend(); ++eta )
     {
         unsigned pivotIndex = (*eta)->_columnIndex;
         double pivotValue = x[pivotIndex];
+        _sparseLUFactors._numOperations += (*eta)->_sparseColumn.size() + 1;
 
         for ( const auto &entry : (*eta)->_sparseColumn )
         {
@@ -479,6 +617,72 @@ void SparseFTFactorization::hBackwardTransformation( const double *y, double *x
     }
 }
 
+void SparseFTFactorization::hForwardTransformation( double *values, unsigned *pattern, unsigned &patternSize ) const
+{
+    for ( unsigned i = 0; i < patternSize; ++i )
+        _inPattern[pattern[i]] = true;
+
+    for ( const auto &eta : _etas )
+    {
+        unsigned pivotIndex = eta->_columnIndex;
+        bool changed = false;
+        _sparseLUFactors._numOperations += eta->_sparseColumn.size() + 1;
+
+        for ( const auto &entry : eta->_sparseColumn )
+        {
+            double entryValue = values[entry._index];
+            if ( entryValue != 0.0 )
+            {
+                values[pivotIndex] -= entry._value * entryValue;
+                changed = true;
+            }
+        }
+
+        if ( changed && !_inPattern[pivotIndex] )
+        {
+            _inPattern[pivotIndex] = true;
+            pattern[patternSize] = pivotIndex;
+            ++patternSize;
+        }
+    }
+
+    for ( unsigned i = 0; i < patternSize; ++i )
+        _inPattern[pattern[i]] = false;
+}
+
+void SparseFTFactorization::hBackwardTransformation( double *values, unsigned *pattern, unsigned &patternSize ) const
+{
+    for ( unsigned i = 0; i < patternSize; ++i )
+        _inPattern[pattern[i]] = true;
+
+    for ( auto eta = _etas.rbegin(); eta != _etas.rend(); ++eta )
+    {
+        unsigned pivotIndex = (*eta)->_columnIndex;
+        double pivotValue = values[pivotIndex];
+        ++_sparseLUFactors._numOperations;
+        if ( pivotValue == 0.0 )
+            continue;
+
+        _sparseLUFactors._numOperations += (*eta)->_sparseColumn.size();
+
+        for ( const auto &entry : (*eta)->_sparseColumn )
+        {
+            unsigned entryIndex = entry._index;
+            values[entryIndex] -= entry._value * pivotValue;
+
+            if ( !_inPattern[entryIndex] )
+            {
+                _inPattern[entryIndex] = true;
+                pattern[patternSize] = entryIndex;
+                ++patternSize;
+            }
+        }
+    }
+
+    for ( unsigned i = 0; i < patternSize; ++i )
+        _inPattern[pattern[i]] = false;
+}
+
 void SparseFTFactorization::fixPForL()
 {
     if ( !_sparseLUFactors._usePForF )
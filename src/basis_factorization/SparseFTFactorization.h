@@ -17,6 +17,7 @@
 #define __SparseFTFactorization_h__
 
 #include "IBasisFactorization.h"
+#include "RefactorizationTrigger.h"
 #include "SparseColumnsOfBasis.h"
 #include "SparseEtaMatrix.h"
 #include "SparseGaussianEliminator.h"
@@ -71,6 +72,14 @@ public:
     */
     void backwardTransformation( const double *y, double *x ) const;
 
+    /*
+      Transformations for a sparse right hand side. Only the entries
+      reachable from the non-zeros of y are visited in F and V, and only
+      the non-zeros are tracked through H.
+    */
+    void forwardTransformation( const SparseUnsortedList *y, double *x ) const;
+    void backwardTransformation( const SparseUnsortedList *y, double *x ) const;
+
     /*
       Store and restore the basis factorization.
     */
@@ -131,6 +140,11 @@ private:
     */
     SparseGaussianEliminator _sparseGaussianEliminator;
 
+    /*
+      Decides when to refactorize, based on the cost of the solves
+    */
+    RefactorizationTrigger _refactorizationTrigger;
+
     /*
       An object for reporting statistics
     */
@@ -144,12 +158,26 @@ private:
     double *_z3;
     double *_z4;
 
+    /*
+      Work memory for the sparse transformations: flags marking the
+      entries already in a sparse vector's pattern.
+    */
+    bool *_inPattern;
+
     /*
       Transformations on the H matrix (the list of etas)
     */
     void hForwardTransformation( const double *y, double *x ) const;
     void hBackwardTransformation( const double *y, double *x ) const;
 
+    /*
+      Sparse variants of the H transformations, done in place on a
+      vector given by its dense values and non-zero pattern
+      (see SparseLUFactors). New non-zeros are added to the pattern.
+    */
+    void hForwardTransformation( double *values, unsigned *pattern, unsigned &patternSize ) const;
+    void hBackwardTransformation( double *values, unsigned *pattern, unsigned &patternSize ) const;
+
     /*
       Free any allocated memory.
     */
@@ -176,6 +204,18 @@ private:
     */
 	void clearFactorization();
 
+    /*
+      Inform the refactorization trigger of a completed basis update,
+      and of the work done by the transformations since the previous
+      one.
+    */
+    void reportBasisUpdate();
+
+    /*
+      Return true iff the basis should be refactorized before the next update.
+    */
+    bool shouldRefactorize() const;
+
     /*
       Have the Basis Factoriaztion object start reporting statistics.
     */
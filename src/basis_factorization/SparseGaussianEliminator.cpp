@@ -22,6 +22,7 @@
 #include "MalformedBasisException.h"
 #include "SparseGaussianEliminator.h"
 
+#include <algorithm>
 #include <cstdio>
 
 SparseGaussianEliminator::SparseGaussianEliminator( unsigned m )
@@ -31,6 +32,19 @@ SparseGaussianEliminator::SparseGaussianEliminator( unsigned m )
     , _statistics( NULL )
     , _numURowElements( NULL )
     , _numUColumnElements( NULL )
+    , _pivotRowColumns( NULL )
+    , _eliminatedRowColumns( NULL )
+    , _rowsByCount( NULL )
+    , _rowNext( NULL )
+    , _rowPrevious( NULL )
+    , _columnsByCount( NULL )
+    , _columnNext( NULL )
+    , _columnPrevious( NULL )
+    , _bucketColumns( NULL )
+    , _basisNonZeros( 0 )
+    , _numOperations( 0 )
+    , _fNonZeros( 0 )
+    , _vNonZeros( 0 )
 {
     _work = new double[_m];
     if ( !_work )
@@ -42,6 +56,9 @@ SparseGaussianEliminator::SparseGaussianEliminator( unsigned m )
         throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
                                        "SparseGaussianEliminator::work2" );
 
+    // The elimination relies on _work2 being all zeros between rows
+    std::fill_n( _work2, _m, 0.0 );
+
     _numURowElements = new unsigned[_m];
     if ( !_numURowElements )
         throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
@@ -51,6 +68,51 @@ SparseGaussianEliminator::SparseGaussianEliminator( unsigned m )
     if ( !_numUColumnElements )
         throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
                                        "SparseGaussianEliminator::numUColumnElements" );
+
+    _pivotRowColumns = new unsigned[_m];
+    if ( !_pivotRowColumns )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseGaussianEliminator::pivotRowColumns" );
+
+    _eliminatedRowColumns = new unsigned[_m];
+    if ( !_eliminatedRowColumns )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseGaussianEliminator::eliminatedRowColumns" );
+
+    _rowsByCount = new unsigned[_m + 1];
+    if ( !_rowsByCount )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseGaussianEliminator::rowsByCount" );
+
+    _rowNext = new unsigned[_m];
+    if ( !_rowNext )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseGaussianEliminator::rowNext" );
+
+    _rowPrevious = new unsigned[_m];
+    if ( !_rowPrevious )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseGaussianEliminator::rowPrevious" );
+
+    _columnsByCount = new unsigned[_m + 1];
+    if ( !_columnsByCount )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseGaussianEliminator::columnsByCount" );
+
+    _columnNext = new unsigned[_m];
+    if ( !_columnNext )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseGaussianEliminator::columnNext" );
+
+    _columnPrevious = new unsigned[_m];
+    if ( !_columnPrevious )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseGaussianEliminator::columnPrevious" );
+
+    _bucketColumns = new unsigned[_m];
+    if ( !_bucketColumns )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseGaussianEliminator::bucketColumns" );
 }
 
 SparseGaussianEliminator::~SparseGaussianEliminator()
@@ -78,6 +140,60 @@ SparseGaussianEliminator::~SparseGaussianEliminator()
         delete[] _numUColumnElements;
         _numUColumnElements = NULL;
     }
+
+    if ( _pivotRowColumns )
+    {
+        delete[] _pivotRowColumns;
+        _pivotRowColumns = NULL;
+    }
+
+    if ( _eliminatedRowColumns )
+    {
+        delete[] _eliminatedRowColumns;
+        _eliminatedRowColumns = NULL;
+    }
+
+    if ( _rowsByCount )
+    {
+        delete[] _rowsByCount;
+        _rowsByCount = NULL;
+    }
+
+    if ( _rowNext )
+    {
+        delete[] _rowNext;
+        _rowNext = NULL;
+    }
+
+    if ( _rowPrevious )
+    {
+        delete[] _rowPrevious;
+        _rowPrevious = NULL;
+    }
+
+    if ( _columnsByCount )
+    {
+        delete[] _columnsByCount;
+        _columnsByCount = NULL;
+    }
+
+    if ( _columnNext )
+    {
+        delete[] _columnNext;
+        _columnNext = NULL;
+    }
+
+    if ( _columnPrevious )
+    {
+        delete[] _columnPrevious;
+        _columnPrevious = NULL;
+    }
+
+    if ( _bucketColumns )
+    {
+        delete[] _bucketColumns;
+        _bucketColumns = NULL;
+    }
 }
 
 void SparseGaussianEliminator::initializeFactorization( const SparseColumnsOfBasis *A, SparseLUFactors *sparseLUFactors )
@@ -107,6 +223,15 @@ void SparseGaussianEliminator::initializeFactorization( const SparseColumnsOfBas
     // Count number of non-zeros in U ( = V )
     _sparseLUFactors->_V->countElements( _numURowElements, _numUColumnElements );
 
+    _basisNonZeros = 0;
+    for ( unsigned i = 0; i < _m; ++i )
+        _basisNonZeros += _numURowElements[i];
+
+    initializeCountBuckets();
+
+    // Building V and Vt, and resetting F, Ft, P, Q and the count buckets
+    _numOperations = 2 * _basisNonZeros + 4 * _m;
+
     // Use same matrix P for L and V
     _sparseLUFactors->_usePForF = false;
 }
@@ -122,15 +247,31 @@ void SparseGaussianEliminator::permute()
     _sparseLUFactors->_P.swapColumns( _uPivotRow, _eliminationStep );
     _sparseLUFactors->_Q.swapRows( _uPivotColumn, _eliminationStep );
 
-    // Adjust the element counters
+    /*
+      Adjust the element counters. The pivot row and column leave the
+      active submatrix, and so their buckets; the row and column they
+      are swapped with keep their buckets, at their new positions.
+    */
     unsigned temp;
-    temp = _numURowElements[_uPivotRow];
-    _numURowElements[_uPivotRow] = _numURowElements[_eliminationStep];
-    _numURowElements[_eliminationStep] = temp;
+    removeRow( _uPivotRow );
+    if ( _uPivotRow != _eliminationStep )
+    {
+        removeRow( _eliminationStep );
+        temp = _numURowElements[_uPivotRow];
+        _numURowElements[_uPivotRow] = _numURowElements[_eliminationStep];
+        _numURowElements[_eliminationStep] = temp;
+        insertRow( _uPivotRow );
+    }
 
-    temp = _numUColumnElements[_uPivotColumn];
-    _numUColumnElements[_uPivotColumn] = _numUColumnElements[_eliminationStep];
-    _numUColumnElements[_eliminationStep] = temp;
+    removeColumn( _uPivotColumn );
+    if ( _uPivotColumn != _eliminationStep )
+    {
+        removeColumn( _eliminationStep );
+        temp = _numUColumnElements[_uPivotColumn];
+        _numUColumnElements[_uPivotColumn] = _numUColumnElements[_eliminationStep];
+        _numUColumnElements[_eliminationStep] = temp;
+        insertColumn( _uPivotColumn );
+    }
 }
 
 void SparseGaussianEliminator::run( const SparseColumnsOfBasis *A, SparseLUFactors *sparseLUFactors )
@@ -141,6 +282,10 @@ void SparseGaussianEliminator::run( const SparseColumnsOfBasis *A, SparseLUFacto
     // Do the work
     factorize();
 
+    countFactorNonZeros();
+    if ( _statistics )
+        _statistics->addSparseLUFactorization( _basisNonZeros, _fNonZeros + _vNonZeros );
+
     // DEBUG({
     //         // Check that the factorization is correct
     //         double *product = new double[_m * _m];
@@ -223,9 +368,9 @@ void SparseGaussianEliminator::choosePivot()
     unsigned nnz;
 
     // If there's a singleton row, use it as the pivot row
-    for ( unsigned i = _eliminationStep; i < _m; ++i )
     {
-        if ( _numURowElements[i] == 1 )
+        unsigned i = lowestIndexInBucket( _rowsByCount[1], _rowNext );
+        if ( i != _m )
         {
             _uPivotRow = i;
             _vPivotRow = _sparseLUFactors->_P._columnOrdering[i];
@@ -250,9 +395,9 @@ void SparseGaussianEliminator::choosePivot()
     }
 
     // If there's a singleton column, use it as the pivot column
-    for ( unsigned i = _eliminationStep; i < _m; ++i )
     {
-        if ( _numUColumnElements[i] == 1 )
+        unsigned i = lowestIndexInBucket( _columnsByCount[1], _columnNext );
+        if ( i != _m )
         {
             _uPivotColumn = i;
             _vPivotColumn = _sparseLUFactors->_Q._rowOrdering[i];
@@ -261,6 +406,7 @@ void SparseGaussianEliminator::choosePivot()
             sparseColumn = _sparseLUFactors->_Vt->getRow( _vPivotColumn );
             entry = sparseColumn->getArray();
             nnz = sparseColumn->getNnz();
+            _numOperations += nnz;
 
             // There may be some elements in higher rows - we need just the one
             // in the active submatrix.
@@ -294,86 +440,233 @@ void SparseGaussianEliminator::choosePivot()
         }
     }
 
-    // No singletons, apply the Markowitz rule. Find the element with acceptable
-    // magnitude that has the smallet Markowitz value.
-    // Fail if no elements exists that are within acceptable magnitude
+    /*
+      No singletons, apply the Markowitz rule with threshold partial
+      pivoting: among the elements of acceptable magnitude, find the one
+      with the smallest Markowitz cost. Fail if no such element exists.
+
+      The columns are searched by increasing number of non-zeros. A
+      column with q_j non-zeros cannot contain an element cheaper than
+      (q_j - 1)(p_min - 1), where p_min is the smallest row count, so the
+      search stops once that bound is reached, or once a limited number
+      of columns have been searched after a candidate was found. The
+      columns of a bucket are searched by increasing index, so that the
+      pivot does not depend on the order of the bucket updates.
+    */
+    unsigned minimalRowCount = 1;
+    for ( unsigned count = 0; count <= _m; ++count )
+    {
+        if ( _rowsByCount[count] != _m )
+        {
+            minimalRowCount = count;
+            break;
+        }
+    }
+    if ( minimalRowCount == 0 )
+        minimalRowCount = 1;
 
-    // Todo: more clever heuristics to reduce the search space
     unsigned minimalCost = _m * _m;
     _pivotElement = 0.0;
     double absPivotElement = 0.0;
 
     bool found = false;
-    for ( unsigned uColumn = _eliminationStep; uColumn < _m; ++uColumn )
+    bool searchDone = false;
+    unsigned numSearchedColumns = 0;
+    unsigned numVisitedColumns = 0;
+    unsigned numActiveColumns = _m - _eliminationStep;
+    for ( unsigned count = 0; !searchDone && count <= _m; ++count )
     {
-        unsigned vColumn = _sparseLUFactors->_Q._rowOrdering[uColumn];
-        sparseColumn = _sparseLUFactors->_Vt->getRow( vColumn );
-
-        double maxInColumn = 0;
-        nnz = sparseColumn->getNnz();
-        entry = sparseColumn->getArray();
+        unsigned bucketSize = 0;
+        for ( unsigned uColumn = _columnsByCount[count]; uColumn != _m; uColumn = _columnNext[uColumn] )
+            _bucketColumns[bucketSize++] = uColumn;
+        std::sort( _bucketColumns, _bucketColumns + bucketSize );
 
-        for ( unsigned i = 0; i < nnz; ++i )
+        for ( unsigned k = 0; k < bucketSize; ++k )
         {
-            // Ignore entries that are not in the active submatrix
-            unsigned vRow = entry[i]._index;
-            unsigned uRow = _sparseLUFactors->_P._rowOrdering[vRow];
-            if ( uRow < _eliminationStep )
-                continue;
-
-            double contender = FloatUtils::abs( entry[i]._value );
-            if ( FloatUtils::gt( contender, maxInColumn ) )
-                maxInColumn = contender;
-        }
+            unsigned uColumn = _bucketColumns[k];
+            if ( found &&
+                 ( ( numSearchedColumns >= GlobalConfiguration::GAUSSIAN_ELIMINATION_MARKOWITZ_SEARCH_LIMIT ) ||
+                   ( minimalCost <= ( count - 1 ) * ( minimalRowCount - 1 ) ) ) )
+            {
+                searchDone = true;
+                break;
+            }
 
-        if ( FloatUtils::isZero( maxInColumn ) )
-        {
-            throw BasisFactorizationError( BasisFactorizationError::GAUSSIAN_ELIMINATION_FAILED,
-                                           "Have a zero column" );
+            searchColumn( uColumn, minimalCost, absPivotElement, found );
+
+            ++numVisitedColumns;
+            if ( found )
+                ++numSearchedColumns;
         }
 
-        for ( unsigned i = 0; i < nnz; ++i )
-        {
-            unsigned vRow = entry[i]._index;
-            unsigned uRow = _sparseLUFactors->_P._rowOrdering[vRow];
+        // Stop once all the active columns have been searched
+        if ( numVisitedColumns == numActiveColumns )
+            searchDone = true;
+    }
 
-            // Ignore entries that are not in the active submatrix
-            if ( uRow < _eliminationStep )
-                continue;
+    if ( !found )
+        throw BasisFactorizationError( BasisFactorizationError::GAUSSIAN_ELIMINATION_FAILED,
+                                       "Couldn't find a pivot" );
 
-            double contender = entry[i]._value;
-            double absContender = FloatUtils::abs( contender );
+    SGAUSSIAN_LOG( Stringf( "Choose pivot selected a pivot: V[%u,%u] = %lf (cost %u)", _vPivotRow, _vPivotColumn, _pivotElement, minimalCost ).ascii() );
+}
 
-            // Only consider large-enough elements
-            if ( FloatUtils::gt( absContender,
-                                 maxInColumn * GlobalConfiguration::GAUSSIAN_ELIMINATION_PIVOT_SCALE_THRESHOLD ) )
-            {
-                unsigned cost = ( _numURowElements[uRow] - 1 ) * ( _numUColumnElements[uColumn] - 1 );
+void SparseGaussianEliminator::initializeCountBuckets()
+{
+    std::fill_n( _rowsByCount, _m + 1, _m );
+    std::fill_n( _columnsByCount, _m + 1, _m );
 
-                ASSERT( ( cost != minimalCost ) || found );
+    // Insert in reverse, so that each bucket is ordered by index
+    for ( unsigned i = _m; i > 0; --i )
+    {
+        insertRow( i - 1 );
+        insertColumn( i - 1 );
+    }
+}
 
-                if ( ( cost < minimalCost ) ||
-                     ( ( cost == minimalCost ) && FloatUtils::gt( absContender, absPivotElement ) ) )
-                {
-                    minimalCost = cost;
-                    _uPivotRow = uRow;
-                    _uPivotColumn = uColumn;
-                    _vPivotRow = vRow;
-                    _vPivotColumn = vColumn;
-                    _pivotElement = contender;
-                    absPivotElement = absContender;
+unsigned SparseGaussianEliminator::lowestIndexInBucket( unsigned first, const unsigned *next ) const
+{
+    unsigned lowest = _m;
+    for ( unsigned i = first; i != _m; i = next[i] )
+    {
+        if ( i < lowest )
+            lowest = i;
+    }
 
-                    found = true;
-                }
-            }
-        }
+    return lowest;
+}
+
+void SparseGaussianEliminator::insertRow( unsigned uRow )
+{
+    unsigned count = _numURowElements[uRow];
+    unsigned first = _rowsByCount[count];
+
+    _rowPrevious[uRow] = _m;
+    _rowNext[uRow] = first;
+    if ( first != _m )
+        _rowPrevious[first] = uRow;
+    _rowsByCount[count] = uRow;
+}
+
+void SparseGaussianEliminator::removeRow( unsigned uRow )
+{
+    unsigned previous = _rowPrevious[uRow];
+    unsigned next = _rowNext[uRow];
+
+    if ( previous != _m )
+        _rowNext[previous] = next;
+    else
+        _rowsByCount[_numURowElements[uRow]] = next;
+
+    if ( next != _m )
+        _rowPrevious[next] = previous;
+}
+
+void SparseGaussianEliminator::setRowCount( unsigned uRow, unsigned count )
+{
+    removeRow( uRow );
+    _numURowElements[uRow] = count;
+    insertRow( uRow );
+}
+
+void SparseGaussianEliminator::insertColumn( unsigned uColumn )
+{
+    unsigned count = _numUColumnElements[uColumn];
+    unsigned first = _columnsByCount[count];
+
+    _columnPrevious[uColumn] = _m;
+    _columnNext[uColumn] = first;
+    if ( first != _m )
+        _columnPrevious[first] = uColumn;
+    _columnsByCount[count] = uColumn;
+}
+
+void SparseGaussianEliminator::removeColumn( unsigned uColumn )
+{
+    unsigned previous = _columnPrevious[uColumn];
+    unsigned next = _columnNext[uColumn];
+
+    if ( previous != _m )
+        _columnNext[previous] = next;
+    else
+        _columnsByCount[_numUColumnElements[uColumn]] = next;
+
+    if ( next != _m )
+        _columnPrevious[next] = previous;
+}
+
+void SparseGaussianEliminator::setColumnCount( unsigned uColumn, unsigned count )
+{
+    removeColumn( uColumn );
+    _numUColumnElements[uColumn] = count;
+    insertColumn( uColumn );
+}
+
+void SparseGaussianEliminator::searchColumn( unsigned uColumn, unsigned &minimalCost,
+                                             double &absPivotElement, bool &found )
+{
+    unsigned vColumn = _sparseLUFactors->_Q._rowOrdering[uColumn];
+    const SparseUnsortedArray *sparseColumn = _sparseLUFactors->_Vt->getRow( vColumn );
+    const SparseUnsortedArray::Entry *entry = sparseColumn->getArray();
+    unsigned nnz = sparseColumn->getNnz();
+    _numOperations += 2 * nnz;
+
+    double maxInColumn = 0;
+
+    for ( unsigned i = 0; i < nnz; ++i )
+    {
+        // Ignore entries that are not in the active submatrix
+        unsigned vRow = entry[i]._index;
+        unsigned uRow = _sparseLUFactors->_P._rowOrdering[vRow];
+        if ( uRow < _eliminationStep )
+            continue;
+
+        double contender = FloatUtils::abs( entry[i]._value );
+        if ( FloatUtils::gt( contender, maxInColumn ) )
+            maxInColumn = contender;
     }
 
-    if ( !found )
+    if ( FloatUtils::isZero( maxInColumn ) )
+    {
         throw BasisFactorizationError( BasisFactorizationError::GAUSSIAN_ELIMINATION_FAILED,
-                                       "Couldn't find a pivot" );
+                                       "Have a zero column" );
+    }
 
-    SGAUSSIAN_LOG( Stringf( "Choose pivot selected a pivot: V[%u,%u] = %lf (cost %u)", _vPivotRow, _vPivotColumn, _pivotElement, minimalCost ).ascii() );
+    for ( unsigned i = 0; i < nnz; ++i )
+    {
+        unsigned vRow = entry[i]._index;
+        unsigned uRow = _sparseLUFactors->_P._rowOrdering[vRow];
+
+        // Ignore entries that are not in the active submatrix
+        if ( uRow < _eliminationStep )
+            continue;
+
+        double contender = entry[i]._value;
+        double absContender = FloatUtils::abs( contender );
+
+        // Only consider large-enough elements
+        if ( FloatUtils::gt( absContender,
+                             maxInColumn * GlobalConfiguration::GAUSSIAN_ELIMINATION_PIVOT_SCALE_THRESHOLD ) )
+        {
+            unsigned cost = ( _numURowElements[uRow] - 1 ) * ( _numUColumnElements[uColumn] - 1 );
+
+            ASSERT( ( cost != minimalCost ) || found );
+
+            if ( ( cost < minimalCost ) ||
+                 ( ( cost == minimalCost ) && FloatUtils::gt( absContender, absPivotElement ) ) )
+            {
+                minimalCost = cost;
+                _uPivotRow = uRow;
+                _uPivotColumn = uColumn;
+                _vPivotRow = vRow;
+                _vPivotColumn = vColumn;
+                _pivotElement = contender;
+                absPivotElement = absContender;
+
+                found = true;
+            }
+        }
+    }
 }
 
 void SparseGaussianEliminator::eliminate()
@@ -383,21 +676,40 @@ void SparseGaussianEliminator::eliminate()
     /*
       Eliminate all entries below the pivot element U[k,k]
       We know that V[_vPivotRow, _vPivotColumn] = U[k,k].
-    */
 
-    // Get the pivot row in dense format, due to repeated access
-    _sparseLUFactors->_V->getRowDense( _vPivotRow, _work );
+      Only the active non-zero entries of the pivot row affect the
+      rows being eliminated. Store them in dense format, due to
+      repeated access, and keep a list of their columns.
+    */
+    const SparseUnsortedArray *pivotRow = _sparseLUFactors->_V->getRow( _vPivotRow );
+    const SparseUnsortedArray::Entry *pivotRowEntry = pivotRow->getArray();
+    unsigned numPivotRowColumns = 0;
 
     /*
       The pivot row is not eliminated per se, but it is excluded
       from the active submatrix, so we adjust the element counters
     */
     _numURowElements[_eliminationStep] = 0;
-    for ( unsigned uColumn = _eliminationStep; uColumn < _m; ++uColumn )
+    _numOperations += pivotRow->getNnz();
+    for ( unsigned i = 0; i < pivotRow->getNnz(); ++i )
     {
-        unsigned vColumn = _sparseLUFactors->_Q._rowOrdering[uColumn];
-        if ( !FloatUtils::isZero( _work[vColumn] ) )
+        unsigned vColumn = pivotRowEntry[i]._index;
+        unsigned uColumn = _sparseLUFactors->_Q._columnOrdering[vColumn];
+
+        if ( uColumn < _eliminationStep )
+            continue;
+
+        if ( uColumn == _eliminationStep )
+        {
             --_numUColumnElements[uColumn];
+            continue;
+        }
+
+        setColumnCount( uColumn, _numUColumnElements[uColumn] - 1 );
+
+        _work[vColumn] = pivotRowEntry[i]._value;
+        _pivotRowColumns[numPivotRowColumns] = vColumn;
+        ++numPivotRowColumns;
     }
 
     // Process all rows below the pivot row
@@ -423,28 +735,29 @@ void SparseGaussianEliminator::eliminate()
         */
         double rowMultiplier = - entry[index]._value / _pivotElement;
 
-        // Get the row being eliminated in dense format
-        _sparseLUFactors->_V->getRowDense( vRow, _work2 );
+        // Scatter the row being eliminated into dense format
+        SparseUnsortedArray *eliminatedRow = _sparseLUFactors->_V->getRow( vRow );
+        const SparseUnsortedArray::Entry *eliminatedRowEntry = eliminatedRow->getArray();
+        unsigned numEliminatedRowColumns = eliminatedRow->getNnz();
+
+        for ( unsigned i = 0; i < numEliminatedRowColumns; ++i )
+        {
+            _eliminatedRowColumns[i] = eliminatedRowEntry[i]._index;
+            _work2[eliminatedRowEntry[i]._index] = eliminatedRowEntry[i]._value;
+        }
 
         // Eliminate the sub-diagonal entry
         --_numUColumnElements[_eliminationStep];
-        --_numURowElements[uRow];
+        setRowCount( uRow, _numURowElements[uRow] - 1 );
         sparseColumn->erase( index );
         _work2[_vPivotColumn] = 0;
 
         // Handle the rest of the row
-        for ( unsigned vColumnIndex = 0; vColumnIndex < _m; ++vColumnIndex )
+        for ( unsigned i = 0; i < numPivotRowColumns; ++i )
         {
+            unsigned vColumnIndex = _pivotRowColumns[i];
             unsigned uColumnIndex = _sparseLUFactors->_Q._columnOrdering[vColumnIndex];
 
-            // Only care about the active submatirx
-            if ( uColumnIndex <= _eliminationStep )
-                continue;
-
-            // If the value does not change, skip
-            if ( FloatUtils::isZero( _work[vColumnIndex] ) )
-                continue;
-
             // Value will change
             double oldValue = _work2[vColumnIndex];
             bool wasZero = FloatUtils::isZero( oldValue );
@@ -454,13 +767,16 @@ void SparseGaussianEliminator::eliminate()
             if ( !wasZero && isZero )
             {
                 newValue = 0;
-                --_numUColumnElements[uColumnIndex];
-                --_numURowElements[uRow];
+                setColumnCount( uColumnIndex, _numUColumnElements[uColumnIndex] - 1 );
+                setRowCount( uRow, _numURowElements[uRow] - 1 );
             }
             else if ( wasZero && !isZero )
             {
-                ++_numUColumnElements[uColumnIndex];
-                ++_numURowElements[uRow];
+                // Fill-in
+                setColumnCount( uColumnIndex, _numUColumnElements[uColumnIndex] + 1 );
+                setRowCount( uRow, _numURowElements[uRow] + 1 );
+                _eliminatedRowColumns[numEliminatedRowColumns] = vColumnIndex;
+                ++numEliminatedRowColumns;
             }
 
             _work2[vColumnIndex] = newValue;
@@ -471,7 +787,15 @@ void SparseGaussianEliminator::eliminate()
                 _sparseLUFactors->_Vt->set( vColumnIndex, vRow, newValue );
         }
 
-        _sparseLUFactors->_V->updateSingleRow( vRow, _work2 );
+        // Store the updated row, and reset the work memory to zero
+        eliminatedRow->clear();
+        for ( unsigned i = 0; i < numEliminatedRowColumns; ++i )
+        {
+            unsigned vColumnIndex = _eliminatedRowColumns[i];
+            if ( !FloatUtils::isZero( _work2[vColumnIndex] ) )
+                eliminatedRow->append( vColumnIndex, _work2[vColumnIndex] );
+            _work2[vColumnIndex] = 0;
+        }
 
         /*
           Store the row multiplier in matrix F, using F = PLP'.
@@ -479,12 +803,45 @@ void SparseGaussianEliminator::eliminate()
         */
         _sparseLUFactors->_F->set( vRow, fColumn, -rowMultiplier );
         _sparseLUFactors->_Ft->set( fColumn, vRow, -rowMultiplier );
+
+        /*
+          Scattering and gathering the row, updating V and Vt for
+          every active entry of the pivot row, and storing the
+          multiplier in F and Ft
+        */
+        _numOperations += 2 * numEliminatedRowColumns + 2 * numPivotRowColumns + 2;
     }
 
     // Store the pivot element
     _sparseLUFactors->_vDiagonalElements[_vPivotRow] = _pivotElement;
 }
 
+void SparseGaussianEliminator::countFactorNonZeros()
+{
+    _fNonZeros = 0;
+    _vNonZeros = 0;
+    for ( unsigned i = 0; i < _m; ++i )
+    {
+        _fNonZeros += _sparseLUFactors->_F->getRow( i )->getNnz();
+        _vNonZeros += _sparseLUFactors->_V->getRow( i )->getNnz();
+    }
+}
+
+unsigned long long SparseGaussianEliminator::getNumOperations() const
+{
+    return _numOperations;
+}
+
+unsigned long long SparseGaussianEliminator::getFNonZeros() const
+{
+    return _fNonZeros;
+}
+
+unsigned long long SparseGaussianEliminator::getVNonZeros() const
+{
+    return _vNonZeros;
+}
+
 void SparseGaussianEliminator::setStatistics( Statistics *statistics )
 {
     _statistics = statistics;
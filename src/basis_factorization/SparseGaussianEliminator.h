@@ -41,6 +41,16 @@ public:
     */
     void setStatistics( Statistics *statistics );
 
+    /*
+      Information on the most recent factorization: the number of
+      operations performed (building the working copies of the basis,
+      searching for pivots, eliminating, and storing the factors), and
+      the number of non-zero elements in the resulting F and V factors.
+    */
+    unsigned long long getNumOperations() const;
+    unsigned long long getFNonZeros() const;
+    unsigned long long getVNonZeros() const;
+
 private:
     /*
       The dimension of the (square) matrix being factorized
@@ -80,11 +90,76 @@ private:
     unsigned *_numURowElements;
     unsigned *_numUColumnElements;
 
+    /*
+      Work memory for the elimination step: the columns (in V) of
+      the active non-zero entries of the pivot row, and the columns
+      of the non-zero entries of the row being eliminated
+    */
+    unsigned *_pivotRowColumns;
+    unsigned *_eliminatedRowColumns;
+
+    /*
+      The active rows and columns of U, bucketed by their number of
+      non-zero elements (as in Suhl & Suhl). _rowsByCount[c] is the
+      first row with c elements, and _rowNext and _rowPrevious link the
+      rows of a bucket; a value of _m marks the end of a bucket. The
+      pivot row and column are removed from the buckets once chosen,
+      and the buckets are updated as the counts change, so that
+      finding singletons and searching columns by increasing count do
+      not require a pass over the active submatrix.
+    */
+    unsigned *_rowsByCount;
+    unsigned *_rowNext;
+    unsigned *_rowPrevious;
+    unsigned *_columnsByCount;
+    unsigned *_columnNext;
+    unsigned *_columnPrevious;
+
+    /*
+      Work memory for the pivot search: the columns of a bucket, sorted
+      by index so that ties are broken in favor of the lowest index
+    */
+    unsigned *_bucketColumns;
+
+    /*
+      The number of non-zero elements in the matrix being factorized,
+      used for reporting fill-in
+    */
+    unsigned long long _basisNonZeros;
+
+    /*
+      The work done by the most recent factorization, and the number
+      of non-zero elements in its factors
+    */
+    unsigned long long _numOperations;
+    unsigned long long _fNonZeros;
+    unsigned long long _vNonZeros;
+
     void choosePivot();
+
+    /*
+      Search a column of the active submatrix for a pivot of acceptable
+      magnitude and smaller Markowitz cost than the best found so far.
+    */
+    void searchColumn( unsigned uColumn, unsigned &minimalCost, double &absPivotElement, bool &found );
     void initializeFactorization( const SparseColumnsOfBasis *A, SparseLUFactors *sparseLUFactors );
     void factorize();
     void permute();
     void eliminate();
+    void initializeCountBuckets();
+    void insertRow( unsigned uRow );
+    void removeRow( unsigned uRow );
+    void setRowCount( unsigned uRow, unsigned count );
+    void insertColumn( unsigned uColumn );
+    void removeColumn( unsigned uColumn );
+    void setColumnCount( unsigned uColumn, unsigned count );
+
+    /*
+      The lowest index of a row or column in a bucket, or _m if the
+      bucket is empty
+    */
+    unsigned lowestIndexInBucket( unsigned first, const unsigned *next ) const;
+    void countFactorNonZeros();
 };
 
 #endif // __SparseGaussianEliminator_h__
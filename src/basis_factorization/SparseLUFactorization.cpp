@@ -20,7 +20,9 @@
 #include "GlobalConfiguration.h"
 #include "LPElement.h"
 #include "MalformedBasisException.h"
+#include "Profiler.h"
 #include "SparseLUFactorization.h"
+#include "SparseUnsortedList.h"
 
 SparseLUFactorization::SparseLUFactorization( unsigned m, const BasisColumnOracle &basisColumnOracle )
     : IBasisFactorization( basisColumnOracle )
@@ -96,6 +98,19 @@ void SparseLUFactorization::forwardTransformation( const double *y, double *x )
     */
     _sparseLUFactors.forwardTransformation( y, x );
 
+    etaForwardTransformation( x );
+}
+
+void SparseLUFactorization::forwardTransformation( const SparseUnsortedList *y, double *x ) const
+{
+    // As above, but with a hypersparse transformation for B0
+    _sparseLUFactors.forwardTransformation( y, x );
+
+    etaForwardTransformation( x );
+}
+
+void SparseLUFactorization::etaForwardTransformation( double *x ) const
+{
     /*
       Now we are left with E1 * ... * En * x = z (z is stored in x)
       Eliminate etas one by one.
@@ -152,6 +167,26 @@ void SparseLUFactorization::backwardTransformation( const double *y, double *x )
     _sparseLUFactors.backwardTransformation( _z, x );
 }
 
+void SparseLUFactorization::backwardTransformation( const SparseUnsortedList *y, double *x ) const
+{
+    if ( _etas.empty() )
+    {
+        _sparseLUFactors.backwardTransformation( y, x );
+        return;
+    }
+
+    /*
+      The eta matrices are dense, so scatter y and use the dense
+      transformation. It copies y before writing x, so it can be
+      applied in place.
+    */
+    std::fill_n( x, _m, 0.0 );
+    for ( const auto &entry : *y )
+        x[entry._index] = entry._value;
+
+    backwardTransformation( x, x );
+}
+
 void SparseLUFactorization::clearFactorization()
 {
 	List<EtaMatrix *>::iterator it;
@@ -243,6 +278,8 @@ void SparseLUFactorization::dump() const
 
 void SparseLUFactorization::obtainFreshBasis()
 {
+    PROFILE_SCOPE( "BasisFactorization::refactorization" );
+
     _basisColumnOracle->getSparseBasis( _B );
     factorizeBasis();
 }
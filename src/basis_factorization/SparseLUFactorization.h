@@ -85,6 +85,13 @@ public:
     */
     void backwardTransformation( const double *y, double *x ) const;
 
+    /*
+      Transformations for a sparse right hand side, using the
+      hypersparse transformations of the LU factors.
+    */
+    void forwardTransformation( const SparseUnsortedList *y, double *x ) const;
+    void backwardTransformation( const SparseUnsortedList *y, double *x ) const;
+
     /*
       Store and restore the basis factorization. Storing triggers
       condesning the etas.
@@ -181,6 +188,12 @@ private:
       Clear a previous factorization.
     */
 	void clearFactorization();
+
+    /*
+      Eliminate the eta matrices from the result of a forward
+      transformation of B0, in place.
+    */
+    void etaForwardTransformation( double *x ) const;
 };
 
 #endif // __SparseLUFactorization_h__
@@ -33,6 +33,15 @@ SparseLUFactors::SparseLUFactors( unsigned m )
     , _z( NULL )
     , _workMatrix( NULL )
     , _workVector( NULL )
+    , _sparseWork( NULL )
+    , _sparseWork2( NULL )
+    , _sparsePattern( NULL )
+    , _sparsePattern2( NULL )
+    , _numOperations( 0 )
+    , _reach( NULL )
+    , _dfsStack( NULL )
+    , _dfsPosition( NULL )
+    , _visited( NULL )
 {
     _F = new SparseUnsortedArrays();
     if ( !_F )
@@ -65,6 +74,41 @@ SparseLUFactors::SparseLUFactors( unsigned m )
     _workVector = new double[m];
     if ( !_workVector )
         throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseLUFactors::workVector" );
+
+    _sparseWork = new double[m];
+    if ( !_sparseWork )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseLUFactors::sparseWork" );
+    std::fill_n( _sparseWork, m, 0.0 );
+
+    _sparseWork2 = new double[m];
+    if ( !_sparseWork2 )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseLUFactors::sparseWork2" );
+    std::fill_n( _sparseWork2, m, 0.0 );
+
+    _sparsePattern = new unsigned[m];
+    if ( !_sparsePattern )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseLUFactors::sparsePattern" );
+
+    _sparsePattern2 = new unsigned[m];
+    if ( !_sparsePattern2 )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseLUFactors::sparsePattern2" );
+
+    _reach = new unsigned[m];
+    if ( !_reach )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseLUFactors::reach" );
+
+    _dfsStack = new unsigned[m];
+    if ( !_dfsStack )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseLUFactors::dfsStack" );
+
+    _dfsPosition = new unsigned[m];
+    if ( !_dfsPosition )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseLUFactors::dfsPosition" );
+
+    _visited = new bool[m];
+    if ( !_visited )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseLUFactors::visited" );
+    std::fill_n( _visited, m, false );
 }
 
 SparseLUFactors::~SparseLUFactors()
@@ -116,6 +160,54 @@ SparseLUFactors::~SparseLUFactors()
         delete[] _workVector;
         _workVector = NULL;
     }
+
+    if ( _sparseWork )
+    {
+        delete[] _sparseWork;
+        _sparseWork = NULL;
+    }
+
+    if ( _sparseWork2 )
+    {
+        delete[] _sparseWork2;
+        _sparseWork2 = NULL;
+    }
+
+    if ( _sparsePattern )
+    {
+        delete[] _sparsePattern;
+        _sparsePattern = NULL;
+    }
+
+    if ( _sparsePattern2 )
+    {
+        delete[] _sparsePattern2;
+        _sparsePattern2 = NULL;
+    }
+
+    if ( _reach )
+    {
+        delete[] _reach;
+        _reach = NULL;
+    }
+
+    if ( _dfsStack )
+    {
+        delete[] _dfsStack;
+        _dfsStack = NULL;
+    }
+
+    if ( _dfsPosition )
+    {
+        delete[] _dfsPosition;
+        _dfsPosition = NULL;
+    }
+
+    if ( _visited )
+    {
+        delete[] _visited;
+        _visited = NULL;
+    }
 }
 
 void SparseLUFactors::dump() const
@@ -217,6 +309,7 @@ void SparseLUFactors::fForwardTransformation( const double *y, double *x ) const
     */
 
     memcpy( x, y, sizeof(double) * _m );
+    _numOperations += _m;
 
     const PermutationMatrix *p = ( _usePForF ) ? &_PForF : &_P;
     double xElement;
@@ -234,6 +327,7 @@ void SparseLUFactors::fForwardTransformation( const double *y, double *x ) const
             sparseColumn = _Ft->getRow( fColumn );
             entry = sparseColumn->getArray();
             nnz = sparseColumn->getNnz();
+            _numOperations += nnz;
 
             for ( unsigned i = 0; i < nnz; ++i )
                 x[entry[i]._index] -= xElement * entry[i]._value;
@@ -265,6 +359,7 @@ void SparseLUFactors::fBackwardTransformation( const double *y, double *x ) cons
     */
 
     memcpy( x, y, sizeof(double) * _m );
+    _numOperations += _m;
 
     const PermutationMatrix *p = ( _usePForF ) ? &_PForF : &_P;
     double xElement;
@@ -282,6 +377,7 @@ void SparseLUFactors::fBackwardTransformation( const double *y, double *x ) cons
             sparseRow = _F->getRow( fColumn );
             entry = sparseRow->getArray();
             nnz = sparseRow->getNnz();
+            _numOperations += nnz;
 
             for ( unsigned i = 0; i < nnz; ++i )
                 x[entry[i]._index] -= xElement * entry[i]._value;
@@ -319,6 +415,7 @@ void SparseLUFactors::vForwardTransformation( const double *y, double *x ) const
     unsigned nnz;
 
     memcpy( _workVector, y, sizeof(double) * _m );
+    _numOperations += _m;
 
     for ( int uRow = _m - 1; uRow >= 0; --uRow )
     {
@@ -337,6 +434,7 @@ void SparseLUFactors::vForwardTransformation( const double *y, double *x ) const
             sparseColumn = _Vt->getRow( vColumn );
             entry = sparseColumn->getArray();
             nnz = sparseColumn->getNnz();
+            _numOperations += nnz;
 
             for ( unsigned i = 0; i < nnz; ++i )
                 _workVector[entry[i]._index] -= xElement * entry[i]._value;
@@ -377,6 +475,7 @@ void SparseLUFactors::vBackwardTransformation( const double *y, double *x ) cons
     unsigned nnz;
 
     memcpy( _workVector, y, sizeof(double) * _m );
+    _numOperations += _m;
 
     for ( unsigned utIndex = 0; utIndex < _m; ++utIndex )
     {
@@ -397,6 +496,7 @@ void SparseLUFactors::vBackwardTransformation( const double *y, double *x ) cons
             sparseRow = _V->getRow( vRow );
             entry = sparseRow->getArray();
             nnz = sparseRow->getNnz();
+            _numOperations += nnz;
 
             for ( unsigned i = 0; i < nnz; ++i )
                 _workVector[entry[i]._index] -= xElement * entry[i]._value;
@@ -430,6 +530,296 @@ void SparseLUFactors::backwardTransformation( const double *y, double *x ) const
     fBackwardTransformation( _z, x );
 }
 
+unsigned SparseLUFactors::computeReach( const SparseUnsortedArrays *factor,
+                                        const unsigned *first,
+                                        const unsigned *second,
+                                        const unsigned *pattern,
+                                        unsigned patternSize ) const
+{
+    unsigned top = _m;
+
+    for ( unsigned i = 0; i < patternSize; ++i )
+    {
+        if ( !_visited[pattern[i]] )
+            top = depthFirstSearch( pattern[i], top, factor, first, second );
+    }
+
+    // Reset the visited flags for the next search
+    for ( unsigned i = top; i < _m; ++i )
+        _visited[_reach[i]] = false;
+
+    return top;
+}
+
+unsigned SparseLUFactors::depthFirstSearch( unsigned node,
+                                            unsigned top,
+                                            const SparseUnsortedArrays *factor,
+                                            const unsigned *first,
+                                            const unsigned *second ) const
+{
+    /*
+      A non-recursive depth first search. Every node is pushed at most
+      once, so the stack never exceeds m entries. When all of a node's
+      successors have been visited, it is prepended to the reach list,
+      which yields a topological order.
+    */
+    int head = 0;
+    _dfsStack[0] = node;
+    _visited[node] = true;
+    _dfsPosition[0] = 0;
+
+    while ( head >= 0 )
+    {
+        unsigned current = _dfsStack[head];
+        unsigned row = current;
+        if ( first )
+            row = first[row];
+        if ( second )
+            row = second[row];
+
+        const SparseUnsortedArray *sparseRow = factor->getRow( row );
+        const SparseUnsortedArray::Entry *entry = sparseRow->getArray();
+        unsigned nnz = sparseRow->getNnz();
+
+        bool done = true;
+        for ( unsigned i = _dfsPosition[head]; i < nnz; ++i )
+        {
+            unsigned next = entry[i]._index;
+            if ( _visited[next] )
+                continue;
+
+            // Descend into the next node, and resume here afterwards
+            _dfsPosition[head] = i + 1;
+            ++head;
+            _dfsStack[head] = next;
+            _dfsPosition[head] = 0;
+            _visited[next] = true;
+
+            done = false;
+            break;
+        }
+
+        if ( done )
+        {
+            --head;
+            --top;
+            _reach[top] = current;
+        }
+    }
+
+    return top;
+}
+
+void SparseLUFactors::fForwardTransformation( double *values, unsigned *pattern, unsigned &patternSize ) const
+{
+    /*
+      Solve F*x = y. Entry j of x affects entry i iff F[i,j] is non-zero,
+      so the edges of node j are the j'th row of F'.
+    */
+    unsigned top = computeReach( _Ft, NULL, NULL, pattern, patternSize );
+    _numOperations += _m - top;
+
+    const SparseUnsortedArray *sparseColumn;
+    const SparseUnsortedArray::Entry *entry;
+    unsigned nnz;
+
+    patternSize = 0;
+    for ( unsigned k = top; k < _m; ++k )
+    {
+        unsigned fColumn = _reach[k];
+        pattern[patternSize] = fColumn;
+        ++patternSize;
+
+        double xElement = values[fColumn];
+        if ( xElement != 0.0 )
+        {
+            sparseColumn = _Ft->getRow( fColumn );
+            entry = sparseColumn->getArray();
+            nnz = sparseColumn->getNnz();
+            _numOperations += nnz;
+
+            for ( unsigned i = 0; i < nnz; ++i )
+                values[entry[i]._index] -= xElement * entry[i]._value;
+        }
+    }
+}
+
+void SparseLUFactors::fBackwardTransformation( double *values, unsigned *pattern, unsigned &patternSize ) const
+{
+    /*
+      Solve x*F = y. Entry j of x affects entry i iff F[j,i] is non-zero,
+      so the edges of node j are the j'th row of F.
+    */
+    unsigned top = computeReach( _F, NULL, NULL, pattern, patternSize );
+    _numOperations += _m - top;
+
+    const SparseUnsortedArray *sparseRow;
+    const SparseUnsortedArray::Entry *entry;
+    unsigned nnz;
+
+    patternSize = 0;
+    for ( unsigned k = top; k < _m; ++k )
+    {
+        unsigned fRow = _reach[k];
+        pattern[patternSize] = fRow;
+        ++patternSize;
+
+        double xElement = values[fRow];
+        if ( xElement != 0.0 )
+        {
+            sparseRow = _F->getRow( fRow );
+            entry = sparseRow->getArray();
+            nnz = sparseRow->getNnz();
+            _numOperations += nnz;
+
+            for ( unsigned i = 0; i < nnz; ++i )
+                values[entry[i]._index] -= xElement * entry[i]._value;
+        }
+    }
+}
+
+void SparseLUFactors::vForwardTransformation( double *y, const unsigned *yPattern, unsigned yPatternSize,
+                                              double *x, unsigned *xPattern, unsigned &xPatternSize ) const
+{
+    /*
+      Solve V*x = y. The nodes are rows of V: row vRow is solved for
+      x[vColumn], where V[vRow,vColumn] is the diagonal element in U,
+      and then affects the rows with non-zeros in column vColumn.
+    */
+    unsigned top = computeReach( _Vt, _P._rowOrdering, _Q._rowOrdering, yPattern, yPatternSize );
+    _numOperations += _m - top;
+
+    const SparseUnsortedArray *sparseColumn;
+    const SparseUnsortedArray::Entry *entry;
+    unsigned nnz;
+
+    xPatternSize = 0;
+    for ( unsigned k = top; k < _m; ++k )
+    {
+        unsigned vRow = _reach[k];
+        unsigned vColumn = _Q._rowOrdering[_P._rowOrdering[vRow]];
+
+        double xElement = y[vRow] / _vDiagonalElements[vRow];
+        y[vRow] = 0.0;
+
+        x[vColumn] = xElement;
+        xPattern[xPatternSize] = vColumn;
+        ++xPatternSize;
+
+        if ( xElement != 0.0 )
+        {
+            sparseColumn = _Vt->getRow( vColumn );
+            entry = sparseColumn->getArray();
+            nnz = sparseColumn->getNnz();
+            _numOperations += nnz;
+
+            for ( unsigned i = 0; i < nnz; ++i )
+            {
+                if ( entry[i]._index != vRow )
+                    y[entry[i]._index] -= xElement * entry[i]._value;
+            }
+        }
+    }
+}
+
+void SparseLUFactors::vBackwardTransformation( double *y, const unsigned *yPattern, unsigned yPatternSize,
+                                               double *x, unsigned *xPattern, unsigned &xPatternSize ) const
+{
+    /*
+      Solve x*V = y. The nodes are columns of V: column vColumn is solved
+      for x[vRow], where V[vRow,vColumn] is the diagonal element in U,
+      and then affects the columns with non-zeros in row vRow.
+    */
+    unsigned top = computeReach( _V, _Q._columnOrdering, _P._columnOrdering, yPattern, yPatternSize );
+    _numOperations += _m - top;
+
+    const SparseUnsortedArray *sparseRow;
+    const SparseUnsortedArray::Entry *entry;
+    unsigned nnz;
+
+    xPatternSize = 0;
+    for ( unsigned k = top; k < _m; ++k )
+    {
+        unsigned vColumn = _reach[k];
+        unsigned vRow = _P._columnOrdering[_Q._columnOrdering[vColumn]];
+
+        double xElement = y[vColumn] / _vDiagonalElements[vRow];
+        y[vColumn] = 0.0;
+
+        x[vRow] = xElement;
+        xPattern[xPatternSize] = vRow;
+        ++xPatternSize;
+
+        if ( xElement != 0.0 )
+        {
+            sparseRow = _V->getRow( vRow );
+            entry = sparseRow->getArray();
+            nnz = sparseRow->getNnz();
+            _numOperations += nnz;
+
+            for ( unsigned i = 0; i < nnz; ++i )
+            {
+                if ( entry[i]._index != vColumn )
+                    y[entry[i]._index] -= xElement * entry[i]._value;
+            }
+        }
+    }
+}
+
+void SparseLUFactors::forwardTransformation( const SparseUnsortedList *y, double *x ) const
+{
+    /*
+      Solve Ax = FV x = y for a sparse y.
+
+      First we find z such that Fz = y
+      And then we find x such that Vx = z
+    */
+
+    unsigned patternSize = 0;
+    for ( const auto &entry : *y )
+    {
+        _sparseWork[entry._index] = entry._value;
+        _sparsePattern[patternSize] = entry._index;
+        ++patternSize;
+    }
+
+    fForwardTransformation( _sparseWork, _sparsePattern, patternSize );
+
+    std::fill_n( x, _m, 0.0 );
+    unsigned xPatternSize;
+    vForwardTransformation( _sparseWork, _sparsePattern, patternSize, x, _sparsePattern2, xPatternSize );
+}
+
+void SparseLUFactors::backwardTransformation( const SparseUnsortedList *y, double *x ) const
+{
+    /*
+      Solve xA = x FV = y for a sparse y.
+
+      First we find z such that zV = y
+      And then we find x such that xF = z
+    */
+
+    unsigned patternSize = 0;
+    for ( const auto &entry : *y )
+    {
+        _sparseWork[entry._index] = entry._value;
+        _sparsePattern[patternSize] = entry._index;
+        ++patternSize;
+    }
+
+    unsigned zPatternSize;
+    vBackwardTransformation( _sparseWork, _sparsePattern, patternSize, _sparseWork2, _sparsePattern2, zPatternSize );
+    fBackwardTransformation( _sparseWork2, _sparsePattern2, zPatternSize );
+
+    std::fill_n( x, _m, 0.0 );
+    for ( unsigned i = 0; i < zPatternSize; ++i )
+    {
+        unsigned index = _sparsePattern2[i];
+        x[index] = _sparseWork2[index];
+        _sparseWork2[index] = 0.0;
+    }
+}
+
 void SparseLUFactors::invertBasis( double *result )
 {
     ASSERT( result );
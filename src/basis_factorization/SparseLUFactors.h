@@ -110,6 +110,38 @@ public:
     void vForwardTransformation( const double *y, double *x ) const;
     void vBackwardTransformation( const double *y, double *x ) const;
 
+    /*
+      Hypersparse variants of the above, for a right hand side y with
+      few non-zero entries. Instead of sweeping over all m columns of
+      the factor, only the entries reachable from the non-zeros of y in
+      the graph of the factor are visited (Gilbert-Peierls).
+
+      Here a sparse vector is given by its dense values and a pattern:
+      the list of indices of its possibly non-zero entries. All values
+      outside the pattern must be zero.
+
+      The F transformations work in place: on entry values and pattern
+      describe y, and on exit they describe x.
+
+      The V transformations read y and leave its values all zero. The
+      values of x must be zero on entry, and x's pattern is stored in
+      xPattern.
+    */
+    void fForwardTransformation( double *values, unsigned *pattern, unsigned &patternSize ) const;
+    void fBackwardTransformation( double *values, unsigned *pattern, unsigned &patternSize ) const;
+    void vForwardTransformation( double *y, const unsigned *yPattern, unsigned yPatternSize,
+                                 double *x, unsigned *xPattern, unsigned &xPatternSize ) const;
+    void vBackwardTransformation( double *y, const unsigned *yPattern, unsigned yPatternSize,
+                                  double *x, unsigned *xPattern, unsigned &xPatternSize ) const;
+
+    /*
+      FTRAN and BTRAN for a sparse right hand side y, using the
+      hypersparse transformations. The solution x is stored in
+      dense format.
+    */
+    void forwardTransformation( const SparseUnsortedList *y, double *x ) const;
+    void backwardTransformation( const SparseUnsortedList *y, double *x ) const;
+
     /*
       Compute the inverse of the factorized basis
     */
@@ -122,6 +154,22 @@ public:
     double *_workMatrix;
     double *_workVector;
 
+    /*
+      Work memory for the hypersparse transformations. The values
+      vectors are kept all-zero between transformations.
+    */
+    double *_sparseWork;
+    double *_sparseWork2;
+    unsigned *_sparsePattern;
+    unsigned *_sparsePattern2;
+
+    /*
+      The work done by the transformations: the number of entries of
+      the factors and of the vectors that they have gone over. The
+      counter is never reset here; its owner reads and resets it.
+    */
+    mutable unsigned long long _numOperations;
+
     /*
       Clone this SparseLUFactors object into another object
     */
@@ -131,6 +179,34 @@ public:
       For debugging purposes
     */
     void dump() const;
+
+private:
+    /*
+      Work memory for the depth-first searches
+    */
+    unsigned *_reach;
+    unsigned *_dfsStack;
+    unsigned *_dfsPosition;
+    bool *_visited;
+
+    /*
+      Compute the set of nodes reachable from the given pattern in the
+      graph whose edges are given by the rows of a factor. Node i's
+      edges are row j of the factor, where j = second[first[i]]; a NULL
+      permutation stands for the identity. The reachable nodes are
+      stored in _reach[top..m-1] in topological order, and top is
+      returned.
+    */
+    unsigned computeReach( const SparseUnsortedArrays *factor,
+                           const unsigned *first,
+                           const unsigned *second,
+                           const unsigned *pattern,
+                           unsigned patternSize ) const;
+    unsigned depthFirstSearch( unsigned node,
+                               unsigned top,
+                               const SparseUnsortedArrays *factor,
+                               const unsigned *first,
+                               const unsigned *second ) const;
 };
 
 #endif // __SparseLUFactors_h__
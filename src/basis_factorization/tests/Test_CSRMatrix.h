@@ -78,6 +78,60 @@ public:
                 TS_ASSERT_EQUALS( M2[i*4 + j], csr2.get( i, j ) );
     }
 
+    void test_initialize_from_sparse_rows()
+    {
+        double M1[] = {
+            0, 0, 0, 0,
+            5, 8, 0, 0,
+            0, 0, 3, 0,
+            0, 6, 0, 7,
+        };
+
+        // The row entries are out of order
+        SparseUnsortedList row1( 4 ), row2( 4 ), row3( 4 ), row4( 4 );
+        row2.append( 1, 8 );
+        row2.append( 0, 5 );
+        row3.append( 2, 3 );
+        row4.append( 3, 7 );
+        row4.append( 1, 6 );
+
+        const SparseUnsortedList *rows[] = { &row1, &row2, &row3, &row4 };
+
+        CSRMatrix csr1;
+        csr1.initialize( rows, 4, 4 );
+
+        TS_ASSERT_EQUALS( csr1.getNnz(), 5U );
+        for ( unsigned i = 0; i < 4; ++i )
+            for ( unsigned j = 0; j < 4; ++j )
+                TS_ASSERT_EQUALS( M1[i*4 + j], csr1.get( i, j ) );
+
+        const unsigned *JA = csr1.getJA();
+        TS_ASSERT_EQUALS( JA[0], 0U );
+        TS_ASSERT_EQUALS( JA[1], 1U );
+        TS_ASSERT_EQUALS( JA[2], 2U );
+        TS_ASSERT_EQUALS( JA[3], 1U );
+        TS_ASSERT_EQUALS( JA[4], 3U );
+
+        // The matrix is allocated tightly, and grows when rows are added
+        double row5[] = { 1, 2, 0, 0 };
+        double row6[] = { 0, 2, -3, 0 };
+        csr1.addLastRow( row5 );
+        csr1.addLastRow( row6 );
+
+        double expected[] = {
+            0, 0, 0, 0,
+            5, 8, 0, 0,
+            0, 0, 3, 0,
+            0, 6, 0, 7,
+            1, 2, 0, 0,
+            0, 2, -3, 0,
+        };
+
+        for ( unsigned i = 0; i < 6; ++i )
+            for ( unsigned j = 0; j < 4; ++j )
+                TS_ASSERT_EQUALS( csr1.get( i, j ), expected[i*4 + j] );
+    }
+
     void test_store_restore()
     {
         double M1[] = {
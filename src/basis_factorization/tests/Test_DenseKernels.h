@@ -0,0 +1,152 @@
+/*********************                                                        */
+/*! \file Test_DenseKernels.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "DenseKernels.h"
+#include "FloatUtils.h"
+#include "MString.h"
+
+#include <cstdlib>
+#include <cstring>
+
+class DenseKernelsTestSuite : public CxxTest::TestSuite
+{
+public:
+    enum {
+        // Not a multiple of any vector width, to exercise the tails
+        SIZE = 37,
+    };
+
+    double x[SIZE];
+    double y[SIZE];
+    unsigned indices[SIZE];
+    DenseKernels::InstructionSet defaultInstructionSet;
+
+    void setUp()
+    {
+        defaultInstructionSet = DenseKernels::getInstructionSet();
+
+        srand( 7 );
+        for ( unsigned i = 0; i < SIZE; ++i )
+        {
+            x[i] = ( rand() % 2000 - 1000 ) / 7.0;
+            y[i] = ( rand() % 2000 - 1000 ) / 3.0;
+            indices[i] = ( i * 5 ) % SIZE;
+        }
+
+        // Entries that the kernels turn into (near) zeros
+        x[3] = 1;
+        y[3] = 2;
+        x[10] = 1;
+        y[10] = 2 + 1e-12;
+    }
+
+    void tearDown()
+    {
+        DenseKernels::setInstructionSet( defaultInstructionSet );
+    }
+
+    void test_scalar_kernels()
+    {
+        DenseKernels::setInstructionSet( DenseKernels::SCALAR );
+        TS_ASSERT_EQUALS( DenseKernels::getInstructionSet(), DenseKernels::SCALAR );
+
+        double result[SIZE];
+        memcpy( result, y, sizeof(double) * SIZE );
+        DenseKernels::addMultiple( result, x, -2, SIZE );
+        for ( unsigned i = 0; i < SIZE; ++i )
+            TS_ASSERT_EQUALS( result[i], y[i] - 2 * x[i] );
+
+        memcpy( result, y, sizeof(double) * SIZE );
+        DenseKernels::addMultipleAndRoundToZero( result, x, -2, SIZE );
+        TS_ASSERT_EQUALS( result[3], 0.0 );
+        TS_ASSERT_EQUALS( result[10], 0.0 );
+        for ( unsigned i = 0; i < SIZE; ++i )
+            TS_ASSERT( FloatUtils::areEqual( result[i], y[i] - 2 * x[i] ) );
+
+        double expected = 0;
+        for ( unsigned i = 0; i < SIZE; ++i )
+            expected += x[i] * y[i];
+        TS_ASSERT_EQUALS( DenseKernels::dotProduct( x, y, SIZE ), expected );
+
+        expected = 0;
+        for ( unsigned i = 0; i < 4; ++i )
+            expected += x[indices[i]] * y[indices[i]];
+        TS_ASSERT_EQUALS( DenseKernels::gatheredDotProduct( x, y, indices, 4 ), expected );
+    }
+
+    void test_vector_kernels_match_scalar_kernels()
+    {
+        DenseKernels::InstructionSet instructionSets[] = { DenseKernels::AVX2,
+                                                           DenseKernels::AVX512 };
+
+        for ( const auto &instructionSet : instructionSets )
+        {
+            if ( !DenseKernels::isSupported( instructionSet ) )
+                continue;
+
+            for ( unsigned size = 0; size <= SIZE; ++size )
+            {
+                double expected[SIZE];
+                double result[SIZE];
+
+                DenseKernels::setInstructionSet( DenseKernels::SCALAR );
+                memcpy( expected, y, sizeof(double) * SIZE );
+                DenseKernels::addMultiple( expected, x, -2.5, size );
+                DenseKernels::setInstructionSet( instructionSet );
+                memcpy( result, y, sizeof(double) * SIZE );
+                DenseKernels::addMultiple( result, x, -2.5, size );
+                TS_ASSERT_SAME_DATA( result, expected, sizeof(double) * SIZE );
+
+                DenseKernels::setInstructionSet( DenseKernels::SCALAR );
+                memcpy( expected, y, sizeof(double) * SIZE );
+                DenseKernels::addMultipleAndRoundToZero( expected, x, -2, size );
+                DenseKernels::setInstructionSet( instructionSet );
+                memcpy( result, y, sizeof(double) * SIZE );
+                DenseKernels::addMultipleAndRoundToZero( result, x, -2, size );
+                TS_ASSERT_SAME_DATA( result, expected, sizeof(double) * SIZE );
+
+                DenseKernels::setInstructionSet( DenseKernels::SCALAR );
+                double expectedDot = DenseKernels::dotProduct( x, y, size );
+                double expectedGatheredDot =
+                    DenseKernels::gatheredDotProduct( x, y, indices, size );
+                DenseKernels::setInstructionSet( instructionSet );
+                // The order of summation differs
+                TS_ASSERT( FloatUtils::areEqual( DenseKernels::dotProduct( x, y, size ),
+                                                 expectedDot, 1e-6 ) );
+                TS_ASSERT( FloatUtils::areEqual( DenseKernels::gatheredDotProduct
+                                                 ( x, y, indices, size ),
+                                                 expectedGatheredDot, 1e-6 ) );
+            }
+        }
+    }
+
+    void test_instruction_set_to_string()
+    {
+        TS_ASSERT_EQUALS( String( DenseKernels::instructionSetToString( DenseKernels::SCALAR ) ),
+                          String( "scalar" ) );
+        TS_ASSERT_EQUALS( String( DenseKernels::instructionSetToString( DenseKernels::AVX512 ) ),
+                          String( "AVX-512" ) );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
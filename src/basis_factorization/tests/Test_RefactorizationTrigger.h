@@ -0,0 +1,102 @@
+/*********************                                                        */
+/*! \file Test_RefactorizationTrigger.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** Tests for the refactorization trigger: the bounds on the number of
+ ** updates between refactorizations, and the point at which the amortized
+ ** cost per update stops decreasing.
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "FloatUtils.h"
+#include "GlobalConfiguration.h"
+#include "RefactorizationTrigger.h"
+
+class RefactorizationTriggerTestSuite : public CxxTest::TestSuite
+{
+public:
+    void test_constant_solve_cost()
+    {
+        RefactorizationTrigger trigger;
+
+        // When the solves do not get costlier, only the bound applies
+        trigger.factorizationComputed( 100 );
+        TS_ASSERT( !trigger.shouldRefactorize() );
+
+        for ( unsigned i = 1; i < GlobalConfiguration::ADAPTIVE_REFACTORIZATION_MAX_UPDATES; ++i )
+        {
+            trigger.basisUpdated( 10 );
+            TS_ASSERT( !trigger.shouldRefactorize() );
+        }
+
+        trigger.basisUpdated( 10 );
+        TS_ASSERT( trigger.shouldRefactorize() );
+        TS_ASSERT_EQUALS( trigger.getNumUpdates(),
+                          GlobalConfiguration::ADAPTIVE_REFACTORIZATION_MAX_UPDATES );
+    }
+
+    void test_growing_solve_cost()
+    {
+        RefactorizationTrigger trigger;
+
+        /*
+          A factorization that costs 100, with the solves costing
+          10 + 2k after k updates. The amortized cost is
+          ( 100 + 10k + k(k+1) ) / k, and it stops decreasing once
+          k(k-1) >= 100, i.e. after 11 updates.
+        */
+        trigger.factorizationComputed( 100 );
+
+        for ( unsigned k = 1; k <= 10; ++k )
+        {
+            trigger.basisUpdated( 10 + 2 * k );
+            TS_ASSERT( !trigger.shouldRefactorize() );
+        }
+
+        TS_ASSERT( FloatUtils::areEqual( trigger.getAmortizedCost(), 31 ) );
+
+        trigger.basisUpdated( 32 );
+        TS_ASSERT( trigger.shouldRefactorize() );
+        TS_ASSERT_EQUALS( trigger.getNumUpdates(), 11U );
+
+        // A fresh factorization starts over
+        trigger.factorizationComputed( 100 );
+        TS_ASSERT_EQUALS( trigger.getNumUpdates(), 0U );
+        TS_ASSERT( !trigger.shouldRefactorize() );
+        TS_ASSERT( FloatUtils::areEqual( trigger.getAmortizedCost(), 100 ) );
+    }
+
+    void test_cheap_factorization_is_not_repeated_too_often()
+    {
+        RefactorizationTrigger trigger;
+
+        // Even if refactorizing is almost free, the minimal number of updates applies
+        trigger.factorizationComputed( 0 );
+
+        for ( unsigned k = 1; k < GlobalConfiguration::ADAPTIVE_REFACTORIZATION_MIN_UPDATES; ++k )
+        {
+            trigger.basisUpdated( 10 + k );
+            TS_ASSERT( !trigger.shouldRefactorize() );
+        }
+
+        trigger.basisUpdated( 10 + GlobalConfiguration::ADAPTIVE_REFACTORIZATION_MIN_UPDATES );
+        TS_ASSERT( trigger.shouldRefactorize() );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -20,6 +20,7 @@
 #include "FloatUtils.h"
 #include "GlobalConfiguration.h"
 #include "SparseFTFactorization.h"
+#include "SparseUnsortedList.h"
 #include "List.h"
 #include "MockColumnOracle.h"
 #include "MockErrno.h"
@@ -223,6 +224,63 @@ public:
         TS_ASSERT_SAME_DATA( x4, expected4, sizeof(double) * 3 );
     }
 
+    void compareSparseAndDenseTransformations( const SparseFTFactorization &basis,
+                                               const double *y,
+                                               unsigned m )
+    {
+        SparseUnsortedList sparseY( y, m );
+
+        double dense[4];
+        double sparse[4];
+
+        TS_ASSERT_THROWS_NOTHING( basis.forwardTransformation( y, dense ) );
+        TS_ASSERT_THROWS_NOTHING( basis.forwardTransformation( &sparseY, sparse ) );
+        for ( unsigned i = 0; i < m; ++i )
+            TS_ASSERT( FloatUtils::areEqual( dense[i], sparse[i] ) );
+
+        TS_ASSERT_THROWS_NOTHING( basis.backwardTransformation( y, dense ) );
+        TS_ASSERT_THROWS_NOTHING( basis.backwardTransformation( &sparseY, sparse ) );
+        for ( unsigned i = 0; i < m; ++i )
+            TS_ASSERT( FloatUtils::areEqual( dense[i], sparse[i] ) );
+    }
+
+    void test_sparse_transformations()
+    {
+        SparseFTFactorization basis( 4, *oracle );
+
+        double B[] = {
+            2, 0, 1, 0,
+            0, 1, 0, 0,
+            1, 0, 3, 1,
+            0, 2, 0, 1,
+        };
+        oracle->storeBasis( 4, B );
+        basis.obtainFreshBasis();
+
+        double y1[] = { 0, 0, 1, 0 };
+        double y2[] = { 1, 0, 0, -2 };
+        double y3[] = { 3, 1, 0, 5 };
+
+        compareSparseAndDenseTransformations( basis, y1, 4 );
+        compareSparseAndDenseTransformations( basis, y2, 4 );
+        compareSparseAndDenseTransformations( basis, y3, 4 );
+
+        // Replace columns, so that H is no longer empty
+        double a1[] = { 1, 1, 0, 3 };
+        basis.updateToAdjacentBasis( 2, NULL, a1 );
+
+        compareSparseAndDenseTransformations( basis, y1, 4 );
+        compareSparseAndDenseTransformations( basis, y2, 4 );
+        compareSparseAndDenseTransformations( basis, y3, 4 );
+
+        double a2[] = { 0, 2, 1, 1 };
+        basis.updateToAdjacentBasis( 0, NULL, a2 );
+
+        compareSparseAndDenseTransformations( basis, y1, 4 );
+        compareSparseAndDenseTransformations( basis, y2, 4 );
+        compareSparseAndDenseTransformations( basis, y3, 4 );
+    }
+
     void test_backward_transformation_2()
     {
         SparseFTFactorization basis( 3, *oracle );
@@ -334,6 +334,107 @@ public:
             TS_ASSERT_THROWS_NOTHING( delete ge );
         }
     }
+
+    void test_markowitz_ordering_avoids_fill_in()
+    {
+        /*
+          An arrowhead matrix: pivoting on the dense corner first would
+          fill in the entire matrix, whereas the Markowitz rule picks the
+          diagonal elements first and causes no fill-in at all.
+        */
+        double A[] =
+        {
+            10, 1, 1, 1, 1, 1,
+            1,  2, 0, 0, 0, 0,
+            1,  0, 2, 0, 0, 0,
+            1,  0, 0, 2, 0, 0,
+            1,  0, 0, 0, 2, 0,
+            1,  0, 0, 0, 0, 2,
+        };
+
+        SparseLUFactors lu6( 6 );
+        SparseColumnsOfBasis sparseCols( 6 );
+        basisIntoSparseColumns( A, 6, sparseCols );
+
+        SparseGaussianEliminator *ge = NULL;
+
+        TS_ASSERT( ge = new SparseGaussianEliminator( 6 ) );
+        TS_ASSERT_THROWS_NOTHING( ge->run( &sparseCols, &lu6 ) );
+
+        double result[36];
+        computeMatrixFromFactorization( &lu6, result );
+
+        for ( unsigned i = 0; i < 36; ++i )
+        {
+            TS_ASSERT( FloatUtils::areEqual( A[i], result[i] ) );
+        }
+
+        double At[36];
+        transposeMatrix( A, At, 6 );
+        computeTransposedMatrixFromFactorization( &lu6, result );
+
+        for ( unsigned i = 0; i < 36; ++i )
+        {
+            TS_ASSERT( FloatUtils::areEqual( At[i], result[i] ) );
+        }
+
+        unsigned factorNonZeros = 0;
+        for ( unsigned i = 0; i < 6; ++i )
+        {
+            factorNonZeros += lu6._F->getRow( i )->getNnz();
+            factorNonZeros += lu6._V->getRow( i )->getNnz();
+        }
+
+        TS_ASSERT_EQUALS( factorNonZeros, 16U );
+
+        TS_ASSERT_THROWS_NOTHING( delete ge );
+    }
+
+    void test_factorization_without_initial_singletons()
+    {
+        /*
+          A cyclic pattern with three elements in every row and column,
+          so that the count buckets are updated through several
+          Markowitz steps before singletons appear.
+        */
+        const unsigned m = 30;
+        double A[m * m];
+        std::fill_n( A, m * m, 0.0 );
+        for ( unsigned i = 0; i < m; ++i )
+        {
+            A[i * m + i] = 4;
+            A[i * m + ( i + 1 ) % m] = 1;
+            A[( ( i + 7 ) % m ) * m + i] = -1;
+        }
+
+        SparseLUFactors lu( m );
+        SparseColumnsOfBasis sparseCols( m );
+        basisIntoSparseColumns( A, m, sparseCols );
+
+        SparseGaussianEliminator *ge = NULL;
+
+        TS_ASSERT( ge = new SparseGaussianEliminator( m ) );
+        TS_ASSERT_THROWS_NOTHING( ge->run( &sparseCols, &lu ) );
+
+        double result[m * m];
+        computeMatrixFromFactorization( &lu, result );
+
+        for ( unsigned i = 0; i < m * m; ++i )
+        {
+            TS_ASSERT( FloatUtils::areEqual( A[i], result[i] ) );
+        }
+
+        double At[m * m];
+        transposeMatrix( A, At, m );
+        computeTransposedMatrixFromFactorization( &lu, result );
+
+        for ( unsigned i = 0; i < m * m; ++i )
+        {
+            TS_ASSERT( FloatUtils::areEqual( At[i], result[i] ) );
+        }
+
+        TS_ASSERT_THROWS_NOTHING( delete ge );
+    }
 };
 
 //
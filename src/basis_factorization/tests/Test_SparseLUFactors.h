@@ -184,6 +184,26 @@ public:
             TS_ASSERT( FloatUtils::areEqual( x2[i], expected2[i] ) );
     }
 
+    void test_transformations_count_operations()
+    {
+        TS_ASSERT_EQUALS( lu->_numOperations, 0U );
+
+        // All the entries of x are non-zero, so every column of F is used
+        double y1[] = { 1, 2, 3, 4 };
+        double x1[] = { 0, 0, 0, 0 };
+
+        TS_ASSERT_THROWS_NOTHING( lu->fForwardTransformation( y1, x1 ) );
+        TS_ASSERT_EQUALS( lu->_numOperations, 4U + 5U );
+
+        // Here x = ( 0, -5, 0, 1 ), and only the last column of F is non-empty
+        double y2[] = { 0, 0, 0, 1 };
+        double x2[] = { 0, 0, 0, 0 };
+
+        lu->_numOperations = 0;
+        TS_ASSERT_THROWS_NOTHING( lu->fForwardTransformation( y2, x2 ) );
+        TS_ASSERT_EQUALS( lu->_numOperations, 4U + 1U );
+    }
+
     void test_f_backward_transformation()
     {
         /*
@@ -354,6 +374,66 @@ public:
             TS_ASSERT( FloatUtils::areEqual( x2[i], expected2[i] ) );
     }
 
+    void test_sparse_forward_and_backward_transformations()
+    {
+        /*
+                        | 5/2      2 129/4  -59/4 |
+               inv(A) = | 2/7    1/7     1   -5/7 |
+                        | 2/7    1/7   5/2 -17/14 |
+                        | -5/14 -3/7 -31/4  95/28 |
+
+           For a unit vector e_i, FTRAN gives column i of inv(A)
+           and BTRAN gives row i of inv(A).
+        */
+
+        double invA[] =
+            {
+                5.0/2,   2,       129.0/4, -59.0/4,
+                2.0/7,   1.0/7,   1,       -5.0/7,
+                2.0/7,   1.0/7,   5.0/2,   -17.0/14,
+                -5.0/14, -3.0/7,  -31.0/4, 95.0/28,
+            };
+
+        double x[4];
+
+        for ( unsigned i = 0; i < 4; ++i )
+        {
+            SparseUnsortedList unitVector;
+            unitVector.append( i, 1 );
+
+            TS_ASSERT_THROWS_NOTHING( lu->forwardTransformation( &unitVector, x ) );
+            for ( unsigned j = 0; j < 4; ++j )
+                TS_ASSERT( FloatUtils::areEqual( x[j], invA[j*4 + i] ) );
+
+            TS_ASSERT_THROWS_NOTHING( lu->backwardTransformation( &unitVector, x ) );
+            for ( unsigned j = 0; j < 4; ++j )
+                TS_ASSERT( FloatUtils::areEqual( x[j], invA[i*4 + j] ) );
+        }
+
+        // Same as the dense y2 = { 2, 0, -3, 1 }
+        SparseUnsortedList y;
+        y.append( 2, -3 );
+        y.append( 0, 2 );
+        y.append( 3, 1 );
+
+        double expectedForward[] = { -213.0/2, -22.0/7, -57.0/7, 363.0/14 };
+        TS_ASSERT_THROWS_NOTHING( lu->forwardTransformation( &y, x ) );
+        for ( unsigned i = 0; i < 4; ++i )
+            TS_ASSERT( FloatUtils::areEqual( x[i], expectedForward[i] ) );
+
+        double expectedBackward[] = { 53.0/14, 22.0/7, 197.0/4, -629.0/28 };
+        TS_ASSERT_THROWS_NOTHING( lu->backwardTransformation( &y, x ) );
+        for ( unsigned i = 0; i < 4; ++i )
+            TS_ASSERT( FloatUtils::areEqual( x[i], expectedBackward[i] ) );
+
+        // The work memory is left zeroed
+        for ( unsigned i = 0; i < 4; ++i )
+        {
+            TS_ASSERT_EQUALS( lu->_sparseWork[i], 0.0 );
+            TS_ASSERT_EQUALS( lu->_sparseWork2[i], 0.0 );
+        }
+    }
+
     void test_invert_basis()
     {
         /*
@@ -38,6 +38,8 @@ public:
         KEY_DOESNT_EXIST_IN_HASHMAP = 13,
         GUROBI_EXCEPTION = 14,
         DIVISION_BY_ZERO = 15,
+        MMAP_FAILED = 16,
+        TOO_MANY_PROFILER_SCOPES = 17,
     };
 
     CommonError( CommonError::Code code ) : Error( "CommonError", (int)code )
@@ -18,40 +18,15 @@
 
 #ifdef ENABLE_GUROBI
 
+#include "ILPSolver.h"
 #include "MString.h"
 #include "Map.h"
 
 #include "gurobi_c++.h"
 
-class GurobiWrapper
+class GurobiWrapper : public ILPSolver
 {
 public:
-    enum VariableType {
-        CONTINUOUS = 0,
-        BINARY = 1,
-    };
-
-    /*
-      A term has the form: coefficient * variable
-    */
-    struct Term
-    {
-        Term( double coefficient, String variable )
-            : _coefficient( coefficient )
-            , _variable( variable )
-        {
-        }
-
-        Term()
-            : _coefficient( 0 )
-            , _variable( "" )
-        {
-        }
-
-        double _coefficient;
-        String _variable;
-    };
-
     GurobiWrapper();
     ~GurobiWrapper();
 
@@ -130,56 +105,6 @@ private:
     static void log( const String &message );
 };
 
-#else
-
-#include "MString.h"
-#include "Map.h"
-
-class GurobiWrapper
-{
-public:
-    /*
-      This is a DUMMY class, for compilation purposes when Gurobi is
-      disabled.
-    */
-    enum VariableType {
-        CONTINUOUS = 0,
-        BINARY = 1,
-    };
-
-    struct Term
-    {
-        Term( double, String ) {}
-        Term() {}
-    };
-
-    GurobiWrapper() {}
-    ~GurobiWrapper() {}
-
-    void addVariable( String, double, double, VariableType type = CONTINUOUS ) { (void)type; }
-    void setLowerBound( String, double ) {};
-    void setUpperBound( String, double ) {};
-    void addLeqConstraint( const List<Term> &, double ) {}
-    void addGeqConstraint( const List<Term> &, double ) {}
-    void addEqConstraint( const List<Term> &, double ) {}
-    void setCost( const List<Term> & ) {}
-    void setObjective( const List<Term> & ) {}
-    void setCutoff( double ) {};
-    void solve() {}
-    void extractSolution( Map<String, double> &, double & ) {}
-    void reset() {}
-    void resetModel() {}
-    bool optimal() { return true; }
-    bool cutoffOccurred() { return false; };
-    bool infeasbile() { return false; };
-    bool timeout() { return false; };
-    bool haveFeasibleSolution() { return true; };
-    void setTimeLimit( double ) {};
-    double getObjectiveBound() { return 0; };
-    void dump() {}
-    static void log( const String & );
-};
-
 #endif // ENABLE_GUROBI
 
 #endif // __GurobiWrapper_h__
@@ -0,0 +1,124 @@
+/*********************                                                        */
+/*! \file ILPSolver.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** The interface of an (MI)LP solver, as used by the LP/MILP-based bound
+ ** tightening procedures and by the MILP encoding of input queries.
+ ** Variables are referred to by name.
+
+ **/
+
+#ifndef __ILPSolver_h__
+#define __ILPSolver_h__
+
+#include "List.h"
+#include "MString.h"
+#include "Map.h"
+
+class ILPSolver
+{
+public:
+    enum VariableType {
+        CONTINUOUS = 0,
+        BINARY = 1,
+    };
+
+    /*
+      A term has the form: coefficient * variable
+    */
+    struct Term
+    {
+        Term( double coefficient, String variable )
+            : _coefficient( coefficient )
+            , _variable( variable )
+        {
+        }
+
+        Term()
+            : _coefficient( 0 )
+            , _variable( "" )
+        {
+        }
+
+        double _coefficient;
+        String _variable;
+    };
+
+    virtual ~ILPSolver() {}
+
+    // Add a new variabel to the model
+    virtual void addVariable( String name, double lb, double ub, VariableType type = CONTINUOUS ) = 0;
+
+    // Set the lower or upper bound for an existing variable
+    virtual void setLowerBound( String name, double lb ) = 0;
+    virtual void setUpperBound( String name, double ub ) = 0;
+
+    // Add a new LEQ constraint, e.g. 3x + 4y <= -5
+    virtual void addLeqConstraint( const List<Term> &terms, double scalar ) = 0;
+
+    // Add a new GEQ constraint, e.g. 3x + 4y >= -5
+    virtual void addGeqConstraint( const List<Term> &terms, double scalar ) = 0;
+
+    // Add a new EQ constraint, e.g. 3x + 4y = -5
+    virtual void addEqConstraint( const List<Term> &terms, double scalar ) = 0;
+
+    // A cost function to minimize, or an objective function to maximize
+    virtual void setCost( const List<Term> &terms ) = 0;
+    virtual void setObjective( const List<Term> &terms ) = 0;
+
+    // Set a cutoff value for the objective function. For example, if
+    // maximizing x with cutoff value 0, the solver will return the
+    // optimal value if greater than 0, and report a cutoff if the
+    // optimal value is less than 0.
+    virtual void setCutoff( double cutoff ) = 0;
+
+    // Returns true iff an optimal solution has been found
+    virtual bool optimal() = 0;
+
+    // Returns true iff the cutoff value was used
+    virtual bool cutoffOccurred() = 0;
+
+    // Returns true iff the instance is infeasible
+    virtual bool infeasbile() = 0;
+
+    // Returns true iff the instance timed out
+    virtual bool timeout() = 0;
+
+    // Returns true iff a feasible solution has been found
+    virtual bool haveFeasibleSolution() = 0;
+
+    // Specify a time limit, in seconds
+    virtual void setTimeLimit( double seconds ) = 0;
+
+    // Solve and extract the solution, or the best known bound on the
+    // objective function
+    virtual void solve() = 0;
+    virtual void extractSolution( Map<String, double> &values, double &costOrObjective ) = 0;
+    virtual double getObjectiveBound() = 0;
+
+    // Discard the result of the previous solve, keeping the model
+    virtual void reset() = 0;
+
+    // Clear the underlying model and create a fresh model
+    virtual void resetModel() = 0;
+
+    // Dump the model to a file
+    virtual void dumpModel( String name ) = 0;
+};
+
+#endif // __ILPSolver_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
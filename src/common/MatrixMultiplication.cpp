@@ -13,7 +13,9 @@
 
 **/
 
+#include "GlobalConfiguration.h"
 #include "MatrixMultiplication.h"
+#include "ThreadPool.h"
 
 #ifdef ENABLE_OPENBLAS
 #include "cblas.h"
@@ -48,3 +50,20 @@ void matrixMultiplication( const double *matA, const double *matB, double *matC,
     }
 }
 #endif
+
+void matrixMultiplication( const double *matA, const double *matB, double *matC,
+                           unsigned rowsA, unsigned columnsA,
+                           unsigned columnsB, ThreadPool *threadPool )
+{
+    unsigned numberOfBlocks =
+        ThreadPool::getNumberOfBlocks( threadPool, rowsA, (double)columnsA * columnsB,
+                                       GlobalConfiguration::PARALLEL_PROPAGATION_MIN_WORK_PER_BLOCK );
+
+    ThreadPool::runInBlocks( threadPool, rowsA, numberOfBlocks,
+                             [&]( unsigned, unsigned begin, unsigned end )
+                             {
+                                 matrixMultiplication( matA + begin * columnsA, matB,
+                                                       matC + begin * columnsB,
+                                                       end - begin, columnsA, columnsB );
+                             } );
+}
@@ -11,4 +11,16 @@ void matrixMultiplication( const double *matA, const double *matB, double *matC,
                            unsigned rowsA, unsigned columnsA,
                            unsigned columnsB );
 
+class ThreadPool;
+
+/*
+  As above, with the rows of matA (and of matC) split into blocks that
+  are multiplied concurrently on the given thread pool, if the product
+  is large enough. Every entry of matC is computed exactly as in the
+  sequential version. The pool may be NULL.
+*/
+void matrixMultiplication( const double *matA, const double *matB, double *matC,
+                           unsigned rowsA, unsigned columnsA,
+                           unsigned columnsB, ThreadPool *threadPool );
+
 #endif // __MatrixMultiplication_h__
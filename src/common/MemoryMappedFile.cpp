@@ -0,0 +1,135 @@
+/*********************                                                        */
+/*! \file MemoryMappedFile.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "CommonError.h"
+#include "MemoryMappedFile.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+MemoryMappedFile::MemoryMappedFile( const String &path )
+    : _path( path )
+    , _descriptor( NO_DESCRIPTOR )
+    , _data( NULL )
+    , _size( 0 )
+{
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+    close();
+}
+
+void MemoryMappedFile::open()
+{
+    int error = map();
+    if ( error != 0 )
+        throw CommonError( (CommonError::Code)error, _path.ascii() );
+}
+
+bool MemoryMappedFile::tryOpen()
+{
+    return map() == 0;
+}
+
+int MemoryMappedFile::map()
+{
+    close();
+
+    if ( ( _descriptor = ::open( _path.ascii(), O_RDONLY ) ) == NO_DESCRIPTOR )
+        return CommonError::OPEN_FAILED;
+
+    struct stat fileData;
+    if ( fstat( _descriptor, &fileData ) != 0 )
+    {
+        close();
+        return CommonError::STAT_FAILED;
+    }
+
+    _size = fileData.st_size;
+    if ( _size == 0 )
+        return 0;
+
+#ifdef _WIN32
+    _data = new char[_size];
+    uint64_t bytesRead = 0;
+    while ( bytesRead < _size )
+    {
+        int n = ::read( _descriptor, _data + bytesRead, (unsigned)( _size - bytesRead ) );
+        if ( n <= 0 )
+        {
+            close();
+            return CommonError::READ_FAILED;
+        }
+        bytesRead += n;
+    }
+#else
+    void *mapping = mmap( NULL, _size, PROT_READ, MAP_PRIVATE, _descriptor, 0 );
+    if ( mapping == MAP_FAILED )
+    {
+        close();
+        return CommonError::MMAP_FAILED;
+    }
+    _data = (char *)mapping;
+#endif
+
+    return 0;
+}
+
+void MemoryMappedFile::close()
+{
+    if ( _data )
+    {
+#ifdef _WIN32
+        delete[] _data;
+#else
+        munmap( _data, _size );
+#endif
+        _data = NULL;
+    }
+
+    _size = 0;
+
+    if ( _descriptor != NO_DESCRIPTOR )
+    {
+        ::close( _descriptor );
+        _descriptor = NO_DESCRIPTOR;
+    }
+}
+
+const char *MemoryMappedFile::data() const
+{
+    return _data;
+}
+
+uint64_t MemoryMappedFile::size() const
+{
+    return _size;
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,71 @@
+/*********************                                                        */
+/*! \file MemoryMappedFile.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** A read-only view of a file's contents. On POSIX systems the file is
+ ** memory-mapped, so its contents are paged in on demand and are not
+ ** copied; elsewhere, the file is read into memory.
+ **/
+
+#ifndef __MemoryMappedFile_h__
+#define __MemoryMappedFile_h__
+
+#include "MString.h"
+
+#include <cstdint>
+
+class MemoryMappedFile
+{
+public:
+    MemoryMappedFile( const String &path );
+    ~MemoryMappedFile();
+
+    /*
+      Map the file. Throws a CommonError if the file cannot be opened
+      or mapped.
+    */
+    void open();
+    void close();
+
+    /*
+      Like open(), but returns false instead of throwing if the file
+      cannot be opened or mapped.
+    */
+    bool tryOpen();
+
+    const char *data() const;
+    uint64_t size() const;
+
+private:
+    String _path;
+    int _descriptor;
+    char *_data;
+    uint64_t _size;
+
+    enum {
+        NO_DESCRIPTOR = -1,
+    };
+
+    /*
+      Open and map the file, returning a CommonError code on failure
+      (and 0 on success).
+    */
+    int map();
+};
+
+#endif // __MemoryMappedFile_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
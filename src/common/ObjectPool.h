@@ -0,0 +1,102 @@
+/*********************                                                        */
+/*! \file ObjectPool.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** A pool of default-constructed objects, allocated in blocks. Objects
+ ** that are released are kept for reuse rather than freed, and all
+ ** objects are freed together when the pool is destroyed. This suits
+ ** objects with a stack-like lifetime that are created and destroyed
+ ** at a high rate, such as the entries of the SMT stack. It is up to
+ ** the user to reset an object before (or after) releasing it.
+ **/
+
+#ifndef __ObjectPool_h__
+#define __ObjectPool_h__
+
+#include "Debug.h"
+#include "Vector.h"
+
+template<class T>
+class ObjectPool
+{
+public:
+    ObjectPool( unsigned blockSize = 64 )
+        : _blockSize( blockSize )
+        , _numAllocated( 0 )
+    {
+    }
+
+    ~ObjectPool()
+    {
+        for ( const auto &block : _blocks )
+            delete[] block;
+    }
+
+    ObjectPool( const ObjectPool & ) = delete;
+    ObjectPool &operator=( const ObjectPool & ) = delete;
+
+    T *allocate()
+    {
+        if ( _free.empty() )
+            allocateBlock();
+
+        ++_numAllocated;
+        return _free.pop();
+    }
+
+    void release( T *object )
+    {
+        ASSERT( _numAllocated > 0 );
+        --_numAllocated;
+        _free.append( object );
+    }
+
+    /*
+      The number of objects currently in use
+    */
+    unsigned getNumAllocated() const
+    {
+        return _numAllocated;
+    }
+
+    /*
+      The number of objects the pool holds, in use or not
+    */
+    unsigned getCapacity() const
+    {
+        return _blocks.size() * _blockSize;
+    }
+
+private:
+    unsigned _blockSize;
+    unsigned _numAllocated;
+    Vector<T *> _blocks;
+    Vector<T *> _free;
+
+    void allocateBlock()
+    {
+        T *block = new T[_blockSize]();
+        _blocks.append( block );
+
+        // Hand out the objects of the block in order
+        for ( unsigned i = _blockSize; i > 0; --i )
+            _free.append( block + i - 1 );
+    }
+};
+
+#endif // __ObjectPool_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,302 @@
+/*********************                                                        */
+/*! \file Profiler.cpp
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** The profiler's recording and export. Every thread that records
+ ** gets its own buffer on first use, registered under a lock; from
+ ** then on, recording touches only that buffer. The per-depth totals
+ ** of a thread are a flat array with one row of MAX_SCOPES bins per
+ ** stack depth, so a bin is found by indexing with the scope's
+ ** identifier and the depth, and the array only grows (by whole
+ ** rows) when a deeper stack is first seen.
+ **/
+
+#include "CommonError.h"
+#include "File.h"
+#include "MStringf.h"
+#include "Profiler.h"
+#include "Vector.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+    struct Event
+    {
+        unsigned _scopeId;
+        unsigned long long _start;
+        unsigned long long _duration;
+        unsigned _depth;
+        unsigned _nesting;
+    };
+
+    struct HistogramBin
+    {
+        HistogramBin()
+            : _count( 0 )
+            , _totalDuration( 0 )
+            , _maxDuration( 0 )
+        {
+        }
+
+        unsigned long long _count;
+        unsigned long long _totalDuration;
+        unsigned long long _maxDuration;
+    };
+
+    /*
+      The data recorded by a single thread. Only that thread accesses
+      it while recording.
+    */
+    struct ThreadBuffer
+    {
+        unsigned _threadIndex;
+        Vector<Event> _events;
+        unsigned long long _numRecorded;
+        unsigned _splitDepth;
+        unsigned _nesting;
+        std::vector<HistogramBin> _histogram;
+    };
+
+    std::mutex registryMutex;
+    std::vector<const char *> scopeNames;
+    std::vector<std::unique_ptr<ThreadBuffer>> threadBuffers;
+    unsigned bufferCapacity = 0;
+    struct timespec epoch;
+
+    thread_local ThreadBuffer *currentThreadBuffer = NULL;
+
+    ThreadBuffer *getThreadBuffer()
+    {
+        if ( !currentThreadBuffer )
+        {
+            std::lock_guard<std::mutex> lock( registryMutex );
+            ThreadBuffer *buffer = new ThreadBuffer;
+            buffer->_threadIndex = threadBuffers.size();
+            buffer->_numRecorded = 0;
+            buffer->_splitDepth = 0;
+            buffer->_nesting = 0;
+            threadBuffers.push_back( std::unique_ptr<ThreadBuffer>( buffer ) );
+            currentThreadBuffer = buffer;
+        }
+
+        return currentThreadBuffer;
+    }
+
+    void record( ThreadBuffer *buffer, const Event &event )
+    {
+        if ( buffer->_events.size() < bufferCapacity )
+            buffer->_events.append( event );
+        else if ( bufferCapacity > 0 )
+            buffer->_events[buffer->_numRecorded % bufferCapacity] = event;
+        ++buffer->_numRecorded;
+
+        unsigned index = event._depth * Profiler::MAX_SCOPES + event._scopeId;
+        if ( index >= buffer->_histogram.size() )
+            buffer->_histogram.resize( ( event._depth + 1 ) * Profiler::MAX_SCOPES );
+
+        HistogramBin &bin = buffer->_histogram[index];
+        ++bin._count;
+        bin._totalDuration += event._duration;
+        if ( event._duration > bin._maxDuration )
+            bin._maxDuration = event._duration;
+    }
+}
+
+std::atomic_bool Profiler::_enabled( false );
+
+void Profiler::enable( unsigned eventsPerThread )
+{
+    std::lock_guard<std::mutex> lock( registryMutex );
+
+    for ( auto &buffer : threadBuffers )
+    {
+        buffer->_events.clear();
+        buffer->_numRecorded = 0;
+        buffer->_histogram.clear();
+    }
+
+    bufferCapacity = eventsPerThread;
+    epoch = TimeUtils::sampleMicro();
+    _enabled = true;
+}
+
+void Profiler::disable()
+{
+    _enabled = false;
+}
+
+void Profiler::setSplitDepth( unsigned depth )
+{
+    if ( enabled() )
+        getThreadBuffer()->_splitDepth = depth;
+}
+
+unsigned Profiler::registerScope( const char *name )
+{
+    std::lock_guard<std::mutex> lock( registryMutex );
+
+    for ( unsigned i = 0; i < scopeNames.size(); ++i )
+    {
+        if ( String( scopeNames[i] ) == String( name ) )
+            return i;
+    }
+
+    if ( scopeNames.size() == MAX_SCOPES )
+        throw CommonError( CommonError::TOO_MANY_PROFILER_SCOPES );
+
+    scopeNames.push_back( name );
+    return scopeNames.size() - 1;
+}
+
+void Profiler::Scope::begin( unsigned scopeId )
+{
+    ThreadBuffer *buffer = getThreadBuffer();
+    ++buffer->_nesting;
+
+    _scopeId = scopeId;
+    _depth = buffer->_splitDepth;
+    _start = TimeUtils::sampleMicro();
+}
+
+void Profiler::Scope::end()
+{
+    struct timespec end = TimeUtils::sampleMicro();
+
+    ThreadBuffer *buffer = getThreadBuffer();
+    --buffer->_nesting;
+
+    Event event;
+    event._scopeId = _scopeId;
+    event._start = TimeUtils::timePassed( epoch, _start );
+    event._duration = TimeUtils::timePassed( _start, end );
+    event._depth = _depth;
+    event._nesting = buffer->_nesting;
+    record( buffer, event );
+}
+
+unsigned long long Profiler::getNumRecordedEvents()
+{
+    std::lock_guard<std::mutex> lock( registryMutex );
+
+    unsigned long long result = 0;
+    for ( const auto &buffer : threadBuffers )
+        result += buffer->_numRecorded;
+    return result;
+}
+
+unsigned long long Profiler::getNumDroppedEvents()
+{
+    std::lock_guard<std::mutex> lock( registryMutex );
+
+    unsigned long long result = 0;
+    for ( const auto &buffer : threadBuffers )
+        result += buffer->_numRecorded - buffer->_events.size();
+    return result;
+}
+
+void Profiler::writeChromeTrace( const String &path )
+{
+    std::lock_guard<std::mutex> lock( registryMutex );
+
+    File file( path );
+    file.open( File::MODE_WRITE_TRUNCATE );
+    file.write( "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n" );
+
+    bool first = true;
+    for ( const auto &buffer : threadBuffers )
+    {
+        if ( buffer->_numRecorded == 0 )
+            continue;
+
+        file.write( Stringf( "%s{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 0, \"tid\": %u, "
+                             "\"args\": {\"name\": \"Thread %u\"}}",
+                             first ? "" : ",\n",
+                             buffer->_threadIndex,
+                             buffer->_threadIndex ) );
+        first = false;
+
+        // The buffer is written in chunks, oldest event first
+        unsigned numEvents = buffer->_events.size();
+        unsigned oldest = 0;
+        if ( numEvents > 0 && buffer->_numRecorded > numEvents )
+            oldest = buffer->_numRecorded % numEvents;
+        String chunk;
+        for ( unsigned i = 0; i < numEvents; ++i )
+        {
+            const Event &event = buffer->_events[( oldest + i ) % numEvents];
+            chunk += Stringf( ",\n{\"name\": \"%s\", \"ph\": \"X\", \"pid\": 0, \"tid\": %u, "
+                              "\"ts\": %llu, \"dur\": %llu, \"args\": {\"depth\": %u, \"nesting\": %u}}",
+                              scopeNames[event._scopeId],
+                              buffer->_threadIndex,
+                              event._start,
+                              event._duration,
+                              event._depth,
+                              event._nesting );
+
+            if ( chunk.length() > 65536 )
+            {
+                file.write( chunk );
+                chunk = "";
+            }
+        }
+        file.write( chunk );
+    }
+
+    file.write( "\n]}\n" );
+}
+
+void Profiler::writeDepthHistograms( const String &path )
+{
+    std::lock_guard<std::mutex> lock( registryMutex );
+
+    // Merge the histograms of all threads
+    std::vector<HistogramBin> histogram;
+    for ( const auto &buffer : threadBuffers )
+    {
+        if ( buffer->_histogram.size() > histogram.size() )
+            histogram.resize( buffer->_histogram.size() );
+
+        for ( unsigned i = 0; i < buffer->_histogram.size(); ++i )
+        {
+            const HistogramBin &threadBin = buffer->_histogram[i];
+            HistogramBin &bin = histogram[i];
+            bin._count += threadBin._count;
+            bin._totalDuration += threadBin._totalDuration;
+            if ( threadBin._maxDuration > bin._maxDuration )
+                bin._maxDuration = threadBin._maxDuration;
+        }
+    }
+
+    File file( path );
+    file.open( File::MODE_WRITE_TRUNCATE );
+    file.write( "scope,depth,count,totalMicro,maxMicro\n" );
+
+    for ( unsigned i = 0; i < histogram.size(); ++i )
+    {
+        if ( histogram[i]._count == 0 )
+            continue;
+
+        file.write( Stringf( "%s,%u,%llu,%llu,%llu\n",
+                             scopeNames[i % MAX_SCOPES],
+                             i / MAX_SCOPES,
+                             histogram[i]._count,
+                             histogram[i]._totalDuration,
+                             histogram[i]._maxDuration ) );
+    }
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,149 @@
+/*********************                                                        */
+/*! \file Profiler.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** Instrumentation of the solver's hot paths. Scoped timers record an
+ ** event for every execution of a profiled scope: its name, start time,
+ ** duration, nesting level, and the depth of the SMT stack at the time.
+ ** Events go to a fixed-size ring buffer owned by the recording thread,
+ ** so recording takes no locks; when a buffer is full, its oldest
+ ** events are overwritten. In addition, each thread keeps exact
+ ** per-scope, per-depth totals, which are not affected by overflows.
+ ** Every profiled scope is registered once, on its first execution,
+ ** and is then identified by a small integer.
+ **
+ ** The events can be exported as a Chrome trace (viewable in
+ ** chrome://tracing or Perfetto), and the totals as per-depth
+ ** histograms. Profiling is off until enable() is called, in which case
+ ** a scoped timer costs a single flag check. Building with
+ ** -DENABLE_PROFILER=OFF removes the timers altogether.
+ **/
+
+#ifndef __Profiler_h__
+#define __Profiler_h__
+
+#include "MString.h"
+#include "TimeUtils.h"
+
+#include <atomic>
+
+class Profiler
+{
+public:
+    /*
+      Start recording events, keeping up to eventsPerThread events in
+      the buffer of each thread. Previously recorded events are
+      discarded. Must not be called while profiled scopes are active.
+    */
+    static void enable( unsigned eventsPerThread );
+    static void disable();
+
+    static bool enabled()
+    {
+        return _enabled.load( std::memory_order_relaxed );
+    }
+
+    /*
+      Inform the profiler of the depth of the SMT stack of the calling
+      thread. Events are tagged with the depth at the time they start.
+    */
+    static void setSplitDepth( unsigned depth );
+
+    /*
+      The maximal number of distinct scope names.
+    */
+    enum {
+        MAX_SCOPES = 128,
+    };
+
+    /*
+      Return the identifier of the scope with the given name,
+      registering it if needed. Scopes with equal names share an
+      identifier. The name must be a string literal, or otherwise
+      outlive the profiler's data.
+    */
+    static unsigned registerScope( const char *name );
+
+    /*
+      Write the recorded events in the Chrome trace event format. Each
+      thread appears as a separate track. Should be called when no
+      other thread is recording.
+    */
+    static void writeChromeTrace( const String &path );
+
+    /*
+      Write, for every profiled scope and every stack depth at which it
+      was entered, the number of executions and their total and
+      maximal duration (in microseconds), as CSV. Should be called when
+      no other thread is recording.
+    */
+    static void writeDepthHistograms( const String &path );
+
+    /*
+      The number of events recorded so far, and the number of those
+      that were overwritten, across all threads.
+    */
+    static unsigned long long getNumRecordedEvents();
+    static unsigned long long getNumDroppedEvents();
+
+    /*
+      A scoped timer, for a scope obtained from registerScope().
+    */
+    class Scope
+    {
+    public:
+        Scope( unsigned scopeId )
+            : _active( Profiler::enabled() )
+        {
+            if ( _active )
+                begin( scopeId );
+        }
+
+        ~Scope()
+        {
+            if ( _active )
+                end();
+        }
+
+    private:
+        bool _active;
+        unsigned _scopeId;
+        unsigned _depth;
+        struct timespec _start;
+
+        void begin( unsigned scopeId );
+        void end();
+    };
+
+private:
+    static std::atomic_bool _enabled;
+};
+
+#ifdef ENABLE_PROFILER
+#define PROFILE_SCOPE_NAME_CONCAT( x, y ) x##y
+#define PROFILE_SCOPE_NAME( prefix, line ) PROFILE_SCOPE_NAME_CONCAT( prefix, line )
+#define PROFILE_SCOPE( name )                                                               \
+    static const unsigned PROFILE_SCOPE_NAME( __profileScopeId, __LINE__ ) =                \
+        Profiler::registerScope( name );                                                    \
+    Profiler::Scope PROFILE_SCOPE_NAME( __profileScope, __LINE__ )(                         \
+        PROFILE_SCOPE_NAME( __profileScopeId, __LINE__ ) )
+#define PROFILE_SET_SPLIT_DEPTH( depth ) Profiler::setSplitDepth( depth )
+#else
+#define PROFILE_SCOPE( name )
+#define PROFILE_SET_SPLIT_DEPTH( depth )
+#endif
+
+#endif // __Profiler_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
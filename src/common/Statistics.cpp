@@ -14,11 +14,15 @@
  **/
 
 #include "FloatUtils.h"
+#include "MStringf.h"
 #include "Statistics.h"
 #include "TimeUtils.h"
 
+#include <algorithm>
+
 Statistics::Statistics()
-    : _numMainLoopIterations( 0 )
+    : _preprocessingTimeMicro( 0 )
+    , _numMainLoopIterations( 0 )
     , _numPlConstraints( 0 )
     , _numActivePlConstraints( 0 )
     , _numPlValidSplits( 0 )
@@ -28,6 +32,9 @@ Statistics::Statistics()
     , _numPrecisionRestorations( 0 )
     , _numSimplexSteps( 0 )
     , _timeSimplexStepsMicro( 0 )
+    , _numDualSimplexPhases( 0 )
+    , _numDualSimplexSteps( 0 )
+    , _timeDualSimplexStepsMicro( 0 )
     , _timeMainLoopMicro( 0 )
     , _timeConstraintFixingStepsMicro( 0 )
     , _numConstraintFixingSteps( 0 )
@@ -35,7 +42,11 @@ Statistics::Statistics()
     , _maxStackDepth( 0 )
     , _numSplits( 0 )
     , _numPops( 0 )
+    , _numBackjumps( 0 )
+    , _numLearnedClauses( 0 )
+    , _numClausePropagations( 0 )
     , _numVisitedTreeStates( 1 )
+    , _searchProgress( 0 )
     , _numTableauPivots( 0 )
     , _numTableauDegeneratePivots( 0 )
     , _numTableauDegeneratePivotsByRequest( 0 )
@@ -44,6 +55,7 @@ Statistics::Statistics()
     , _numSimplexUnstablePivots( 0 )
     , _numAddedRows( 0 )
     , _numMergedColumns( 0 )
+    , _numTableauMatrixCopies( 0 )
     , _currentTableauM( 0 )
     , _currentTableauN( 0 )
     , _numTableauBoundHopping( 0 )
@@ -55,9 +67,16 @@ Statistics::Statistics()
     , _numTighteningsFromExplicitBasis( 0 )
     , _numBoundNotificationsToPlConstraints( 0 )
     , _numBoundsProposedByPlConstraints( 0 )
+    , _numExportedBounds( 0 )
+    , _numImportedBounds( 0 )
     , _numBoundTighteningsOnConstraintMatrix( 0 )
     , _numTighteningsFromConstraintMatrix( 0 )
     , _numBasisRefactorizations( 0 )
+    , _numSparseLUFactorizations( 0 )
+    , _totalSparseLUBasisNonZeros( 0 )
+    , _totalSparseLUFactorNonZeros( 0 )
+    , _numAdaptiveRefactorizations( 0 )
+    , _totalBasisUpdatesBeforeAdaptiveRefactorization( 0 )
     , _pseNumIterations( 0 )
     , _pseNumResetReferenceSpace( 0 )
     , _ppNumEliminatedVars( 0 )
@@ -119,6 +138,10 @@ void Statistics::print()
             , printPercents( _timeSimplexStepsMicro, _timeMainLoopMicro )
             , _timeSimplexStepsMicro / 1000
             );
+    printf( "\t\t[%.2lf%%] Dual simplex steps: %llu milli\n"
+            , printPercents( _timeDualSimplexStepsMicro, _timeMainLoopMicro )
+            , _timeDualSimplexStepsMicro / 1000
+            );
     printf( "\t\t[%.2lf%%] Explicit-basis bound tightening: %llu milli\n"
             , printPercents( _totalTimeExplicitBasisBoundTighteningMicro, _timeMainLoopMicro )
             , _totalTimeExplicitBasisBoundTighteningMicro / 1000
@@ -166,6 +189,7 @@ void Statistics::print()
 
     unsigned long long total =
         _timeSimplexStepsMicro +
+        _timeDualSimplexStepsMicro +
         _timeConstraintFixingStepsMicro +
         _totalTimePerformingValidCaseSplitsMicro +
         _totalTimeHandlingStatisticsMicro +
@@ -205,6 +229,11 @@ void Statistics::print()
             , _timeConstraintFixingStepsMicro / 1000
             , printAverage( _timeConstraintFixingStepsMicro / 1000, _numConstraintFixingSteps )
             );
+    printf( "\tDual simplex phases: %llu. Dual simplex pivots: %llu. Total time: %llu milli\n"
+            , _numDualSimplexPhases
+            , _numDualSimplexSteps
+            , _timeDualSimplexStepsMicro / 1000
+            );
     printf( "\tNumber of active piecewise-linear constraints: %u / %u\n"
             "\t\tConstraints disabled by valid splits: %u. "
             "By SMT-originated splits: %u\n"
@@ -242,6 +271,7 @@ void Statistics::print()
     printf( "\tTotal number of rows added: %llu. Number of merged columns: %llu\n"
             , _numAddedRows
             , _numMergedColumns );
+    printf( "\tNumber of constraint matrix copies: %llu\n", _numTableauMatrixCopies );
     printf( "\tCurrent tableau dimensions: M = %u, N = %u\n"
             , _currentTableauM
             , _currentTableauN );
@@ -252,8 +282,13 @@ void Statistics::print()
             , _numVisitedTreeStates
             , _numSplits
             , _numPops );
-    printf( "\tMax stack depth: %u\n"
-            , _maxStackDepth );
+    printf( "\tMax stack depth: %u. Estimated search progress: %.2lf%%\n"
+            , _maxStackDepth
+            , _searchProgress * 100 );
+    printf( "\tNumber of backjumps: %u. Learned clauses: %u. Splits implied by learned clauses: %u\n"
+            , _numBackjumps
+            , _numLearnedClauses
+            , _numClausePropagations );
 
     printf( "\t--- Bound Tightening Statistics ---\n" );
     printf( "\tNumber of tightened bounds: %llu.\n", _numTightenedBounds );
@@ -274,9 +309,26 @@ void Statistics::print()
             , _numBoundNotificationsToPlConstraints
             , _numBoundsProposedByPlConstraints );
 
+    printf( "\t\tNumber of bounds shared with other engines: %llu. Received: %llu\n"
+            , _numExportedBounds
+            , _numImportedBounds );
+
     printf( "\t--- Basis Factorization statistics ---\n" );
     printf( "\tNumber of basis refactorizations: %llu\n",
             _numBasisRefactorizations );
+    printf( "\tNumber of sparse LU factorizations: %llu. Avg. non-zeros in basis: %.2lf, "
+            "in factors: %.2lf (fill-in ratio: %.2lf)\n"
+            , _numSparseLUFactorizations
+            , _numSparseLUFactorizations > 0 ?
+            (double)_totalSparseLUBasisNonZeros / _numSparseLUFactorizations : 0
+            , _numSparseLUFactorizations > 0 ?
+            (double)_totalSparseLUFactorNonZeros / _numSparseLUFactorizations : 0
+            , _totalSparseLUBasisNonZeros > 0 ?
+            (double)_totalSparseLUFactorNonZeros / _totalSparseLUBasisNonZeros : 0 );
+    printf( "\tNumber of adaptive refactorizations: %llu. Avg. basis updates before refactorizing: %.2lf\n"
+            , _numAdaptiveRefactorizations
+            , _numAdaptiveRefactorizations > 0 ?
+            (double)_totalBasisUpdatesBeforeAdaptiveRefactorization / _numAdaptiveRefactorizations : 0 );
 
     printf( "\t--- Projected Steepest Edge Statistics ---\n" );
     printf( "\tNumber of iterations: %llu.\n", _pseNumIterations );
@@ -289,6 +341,130 @@ void Statistics::print()
     printf( "\tNumber of tightened bounds: %llu\n", _numTighteningsFromSymbolicBoundTightening );
 }
 
+String Statistics::toJson() const
+{
+    struct timespec now = TimeUtils::sampleMicro();
+    unsigned long long totalElapsed = TimeUtils::timePassed( _startTime, now );
+
+    String json = "{\n";
+    json += Stringf( "    \"totalTime\": %llu,\n", totalElapsed );
+    json += Stringf( "    \"preprocessingTime\": %llu,\n", _preprocessingTimeMicro );
+    json += Stringf( "    \"mainLoopTime\": %llu,\n", _timeMainLoopMicro );
+    json += Stringf( "    \"simplexStepsTime\": %llu,\n", _timeSimplexStepsMicro );
+    json += Stringf( "    \"dualSimplexStepsTime\": %llu,\n", _timeDualSimplexStepsMicro );
+    json += Stringf( "    \"pivotsTime\": %llu,\n", _timePivotsMicro );
+    json += Stringf( "    \"smtCoreTime\": %llu,\n", _totalTimeSmtCoreMicro );
+    json += Stringf( "    \"symbolicBoundTighteningTime\": %llu,\n",
+                     _totalTimePerformingSymbolicBoundTightening );
+    json += Stringf( "    \"numMainLoopIterations\": %llu,\n", _numMainLoopIterations );
+    json += Stringf( "    \"numSimplexSteps\": %llu,\n", _numSimplexSteps );
+    json += Stringf( "    \"numDualSimplexSteps\": %llu,\n", _numDualSimplexSteps );
+    json += Stringf( "    \"numConstraintFixingSteps\": %llu,\n", _numConstraintFixingSteps );
+    json += Stringf( "    \"numTableauPivots\": %llu,\n", _numTableauPivots );
+    json += Stringf( "    \"numTableauDegeneratePivots\": %llu,\n", _numTableauDegeneratePivots );
+    json += Stringf( "    \"numPrecisionRestorations\": %u,\n", _numPrecisionRestorations );
+    json += Stringf( "    \"numPlConstraints\": %u,\n", _numPlConstraints );
+    json += Stringf( "    \"numSplits\": %u,\n", _numSplits );
+    json += Stringf( "    \"numPops\": %u,\n", _numPops );
+    json += Stringf( "    \"numVisitedTreeStates\": %u,\n", _numVisitedTreeStates );
+    json += Stringf( "    \"maxStackDepth\": %u,\n", _maxStackDepth );
+    json += Stringf( "    \"searchProgress\": %.4lf,\n", _searchProgress );
+    json += Stringf( "    \"numBackjumps\": %u,\n", _numBackjumps );
+    json += Stringf( "    \"numLearnedClauses\": %u,\n", _numLearnedClauses );
+    json += Stringf( "    \"numTightenedBounds\": %llu,\n", _numTightenedBounds );
+    json += Stringf( "    \"numTighteningsFromSymbolicBoundTightening\": %llu,\n",
+                     _numTighteningsFromSymbolicBoundTightening );
+    json += Stringf( "    \"numExportedBounds\": %llu,\n", _numExportedBounds );
+    json += Stringf( "    \"numImportedBounds\": %llu,\n", _numImportedBounds );
+    json += Stringf( "    \"numBasisRefactorizations\": %llu,\n", _numBasisRefactorizations );
+    json += Stringf( "    \"numSparseLUFactorizations\": %llu,\n", _numSparseLUFactorizations );
+    json += Stringf( "    \"totalSparseLUBasisNonZeros\": %llu,\n", _totalSparseLUBasisNonZeros );
+    json += Stringf( "    \"totalSparseLUFactorNonZeros\": %llu,\n", _totalSparseLUFactorNonZeros );
+    json += Stringf( "    \"numAdaptiveRefactorizations\": %llu,\n", _numAdaptiveRefactorizations );
+    json += Stringf( "    \"totalBasisUpdatesBeforeAdaptiveRefactorization\": %llu\n",
+                     _totalBasisUpdatesBeforeAdaptiveRefactorization );
+    json += "}";
+
+    return json;
+}
+
+void Statistics::aggregate( const Statistics &other )
+{
+    _preprocessingTimeMicro += other._preprocessingTimeMicro;
+    _numMainLoopIterations += other._numMainLoopIterations;
+    _numPlConstraints = std::max( _numPlConstraints, other._numPlConstraints );
+    _numActivePlConstraints = std::max( _numActivePlConstraints, other._numActivePlConstraints );
+    _numPlValidSplits = std::max( _numPlValidSplits, other._numPlValidSplits );
+    _numPlSmtOriginatedSplits = std::max( _numPlSmtOriginatedSplits, other._numPlSmtOriginatedSplits );
+    _currentDegradation = std::max( _currentDegradation, other._currentDegradation );
+    _maxDegradation = std::max( _maxDegradation, other._maxDegradation );
+    _numPrecisionRestorations += other._numPrecisionRestorations;
+    _numSimplexSteps += other._numSimplexSteps;
+    _timeSimplexStepsMicro += other._timeSimplexStepsMicro;
+    _numDualSimplexPhases += other._numDualSimplexPhases;
+    _numDualSimplexSteps += other._numDualSimplexSteps;
+    _timeDualSimplexStepsMicro += other._timeDualSimplexStepsMicro;
+    _timeMainLoopMicro += other._timeMainLoopMicro;
+    _timeConstraintFixingStepsMicro += other._timeConstraintFixingStepsMicro;
+    _numConstraintFixingSteps += other._numConstraintFixingSteps;
+    _currentStackDepth = std::max( _currentStackDepth, other._currentStackDepth );
+    _maxStackDepth = std::max( _maxStackDepth, other._maxStackDepth );
+    _numSplits += other._numSplits;
+    _numPops += other._numPops;
+    _numBackjumps += other._numBackjumps;
+    _numLearnedClauses += other._numLearnedClauses;
+    _numClausePropagations += other._numClausePropagations;
+    _numVisitedTreeStates += other._numVisitedTreeStates;
+    _searchProgress = std::max( _searchProgress, other._searchProgress );
+    _numTableauPivots += other._numTableauPivots;
+    _numTableauDegeneratePivots += other._numTableauDegeneratePivots;
+    _numTableauDegeneratePivotsByRequest += other._numTableauDegeneratePivotsByRequest;
+    _timePivotsMicro += other._timePivotsMicro;
+    _numSimplexPivotSelectionsIgnoredForStability += other._numSimplexPivotSelectionsIgnoredForStability;
+    _numSimplexUnstablePivots += other._numSimplexUnstablePivots;
+    _numAddedRows += other._numAddedRows;
+    _numMergedColumns += other._numMergedColumns;
+    _numTableauMatrixCopies += other._numTableauMatrixCopies;
+    _currentTableauM = std::max( _currentTableauM, other._currentTableauM );
+    _currentTableauN = std::max( _currentTableauN, other._currentTableauN );
+    _numTableauBoundHopping += other._numTableauBoundHopping;
+    _numTightenedBounds += other._numTightenedBounds;
+    _numTighteningsFromSymbolicBoundTightening += other._numTighteningsFromSymbolicBoundTightening;
+    _numRowsExaminedByRowTightener += other._numRowsExaminedByRowTightener;
+    _numTighteningsFromRows += other._numTighteningsFromRows;
+    _numBoundTighteningsOnExplicitBasis += other._numBoundTighteningsOnExplicitBasis;
+    _numTighteningsFromExplicitBasis += other._numTighteningsFromExplicitBasis;
+    _numBoundNotificationsToPlConstraints += other._numBoundNotificationsToPlConstraints;
+    _numBoundsProposedByPlConstraints += other._numBoundsProposedByPlConstraints;
+    _numExportedBounds += other._numExportedBounds;
+    _numImportedBounds += other._numImportedBounds;
+    _numBoundTighteningsOnConstraintMatrix += other._numBoundTighteningsOnConstraintMatrix;
+    _numTighteningsFromConstraintMatrix += other._numTighteningsFromConstraintMatrix;
+    _numBasisRefactorizations += other._numBasisRefactorizations;
+    _numSparseLUFactorizations += other._numSparseLUFactorizations;
+    _totalSparseLUBasisNonZeros += other._totalSparseLUBasisNonZeros;
+    _totalSparseLUFactorNonZeros += other._totalSparseLUFactorNonZeros;
+    _numAdaptiveRefactorizations += other._numAdaptiveRefactorizations;
+    _totalBasisUpdatesBeforeAdaptiveRefactorization += other._totalBasisUpdatesBeforeAdaptiveRefactorization;
+    _pseNumIterations += other._pseNumIterations;
+    _pseNumResetReferenceSpace += other._pseNumResetReferenceSpace;
+    _ppNumEliminatedVars = std::max( _ppNumEliminatedVars, other._ppNumEliminatedVars );
+    _ppNumTighteningIterations += other._ppNumTighteningIterations;
+    _ppNumConstraintsRemoved += other._ppNumConstraintsRemoved;
+    _ppNumEquationsRemoved += other._ppNumEquationsRemoved;
+    _totalTimePerformingValidCaseSplitsMicro += other._totalTimePerformingValidCaseSplitsMicro;
+    _totalTimePerformingSymbolicBoundTightening += other._totalTimePerformingSymbolicBoundTightening;
+    _totalTimeHandlingStatisticsMicro += other._totalTimeHandlingStatisticsMicro;
+    _totalNumberOfValidCaseSplits += other._totalNumberOfValidCaseSplits;
+    _totalTimeExplicitBasisBoundTighteningMicro += other._totalTimeExplicitBasisBoundTighteningMicro;
+    _totalTimeDegradationChecking += other._totalTimeDegradationChecking;
+    _totalTimePrecisionRestoration += other._totalTimePrecisionRestoration;
+    _totalTimeConstraintMatrixBoundTighteningMicro += other._totalTimeConstraintMatrixBoundTighteningMicro;
+    _totalTimeApplyingStoredTighteningsMicro += other._totalTimeApplyingStoredTighteningsMicro;
+    _totalTimeSmtCoreMicro += other._totalTimeSmtCoreMicro;
+    _timedOut = _timedOut || other._timedOut;
+}
+
 double Statistics::printPercents( unsigned long long part, unsigned long long total ) const
 {
     if ( total == 0 )
@@ -320,6 +496,11 @@ void Statistics::setNumActivePlConstraints( unsigned numberOfConstraints )
     _numActivePlConstraints = numberOfConstraints;
 }
 
+unsigned Statistics::getNumActivePlConstraints() const
+{
+    return _numActivePlConstraints;
+}
+
 void Statistics::setNumPlValidSplits( unsigned numberOfSplits )
 {
     _numPlValidSplits = numberOfSplits;
@@ -335,6 +516,21 @@ void Statistics::incNumSimplexSteps()
     ++_numSimplexSteps;
 }
 
+void Statistics::incNumDualSimplexPhases()
+{
+    ++_numDualSimplexPhases;
+}
+
+void Statistics::incNumDualSimplexSteps()
+{
+    ++_numDualSimplexSteps;
+}
+
+void Statistics::addTimeDualSimplexSteps( unsigned long long time )
+{
+    _timeDualSimplexStepsMicro += time;
+}
+
 void Statistics::incNumPrecisionRestorations()
 {
     ++_numPrecisionRestorations;
@@ -373,6 +569,11 @@ void Statistics::setCurrentStackDepth( unsigned depth )
         _maxStackDepth = _currentStackDepth;
 }
 
+unsigned Statistics::getCurrentStackDepth() const
+{
+    return _currentStackDepth;
+}
+
 unsigned Statistics::getMaxStackDepth() const
 {
     return _maxStackDepth;
@@ -393,6 +594,36 @@ unsigned Statistics::getNumPops() const
     return _numPops;
 }
 
+void Statistics::incNumBackjumps()
+{
+    ++_numBackjumps;
+}
+
+unsigned Statistics::getNumBackjumps() const
+{
+    return _numBackjumps;
+}
+
+void Statistics::incNumLearnedClauses()
+{
+    ++_numLearnedClauses;
+}
+
+unsigned Statistics::getNumLearnedClauses() const
+{
+    return _numLearnedClauses;
+}
+
+void Statistics::incNumClausePropagations()
+{
+    ++_numClausePropagations;
+}
+
+unsigned Statistics::getNumClausePropagations() const
+{
+    return _numClausePropagations;
+}
+
 void Statistics::incNumTableauPivots()
 {
     ++_numTableauPivots;
@@ -446,6 +677,11 @@ void Statistics::incNumMergedColumns()
     ++_numMergedColumns;
 }
 
+void Statistics::incNumTableauMatrixCopies()
+{
+    ++_numTableauMatrixCopies;
+}
+
 void Statistics::setCurrentTableauDimension( unsigned m, unsigned n )
 {
     _currentTableauM = m;
@@ -487,6 +723,26 @@ void Statistics::incNumBoundsProposedByPlConstraints()
     ++_numBoundsProposedByPlConstraints;
 }
 
+void Statistics::incNumExportedBounds()
+{
+    ++_numExportedBounds;
+}
+
+void Statistics::incNumImportedBounds()
+{
+    ++_numImportedBounds;
+}
+
+unsigned long long Statistics::getNumExportedBounds() const
+{
+    return _numExportedBounds;
+}
+
+unsigned long long Statistics::getNumImportedBounds() const
+{
+    return _numImportedBounds;
+}
+
 void Statistics::incNumBoundTighteningOnConstraintMatrix()
 {
     ++_numBoundTighteningsOnConstraintMatrix;
@@ -502,6 +758,20 @@ void Statistics::incNumBasisRefactorizations()
     ++_numBasisRefactorizations;
 }
 
+void Statistics::addSparseLUFactorization( unsigned long long basisNonZeros,
+                                           unsigned long long factorNonZeros )
+{
+    ++_numSparseLUFactorizations;
+    _totalSparseLUBasisNonZeros += basisNonZeros;
+    _totalSparseLUFactorNonZeros += factorNonZeros;
+}
+
+void Statistics::addAdaptiveRefactorization( unsigned numBasisUpdates )
+{
+    ++_numAdaptiveRefactorizations;
+    _totalBasisUpdatesBeforeAdaptiveRefactorization += numBasisUpdates;
+}
+
 void Statistics::pseIncNumIterations()
 {
     ++_pseNumIterations;
@@ -605,6 +875,16 @@ unsigned Statistics::getNumVisitedTreeStates() const
     return _numVisitedTreeStates;
 }
 
+void Statistics::setSearchProgress( double progress )
+{
+    _searchProgress = progress;
+}
+
+double Statistics::getSearchProgress() const
+{
+    return _searchProgress;
+}
+
 unsigned Statistics::getNumSplits() const
 {
     return _numSplits;
@@ -630,6 +910,11 @@ unsigned long long Statistics::getTimeSimplexStepsMicro() const
     return _timeSimplexStepsMicro;
 }
 
+unsigned long long Statistics::getNumDualSimplexSteps() const
+{
+    return _numDualSimplexSteps;
+}
+
 unsigned long long Statistics::getNumConstraintFixingSteps() const
 {
     return _numConstraintFixingSteps;
@@ -649,6 +934,7 @@ unsigned long long Statistics::getTotalTime() const
 {
     unsigned long long total =
         _timeSimplexStepsMicro +
+        _timeDualSimplexStepsMicro +
         _timeConstraintFixingStepsMicro +
         _totalTimePerformingValidCaseSplitsMicro +
         _totalTimeHandlingStatisticsMicro +
@@ -29,6 +29,20 @@ public:
     */
     void print();
 
+    /*
+      The main counters and timers, as a JSON object, for consumption
+      by scripts (e.g., the benchmark harness). Times are in
+      microseconds.
+    */
+    String toJson() const;
+
+    /*
+      Add the counters and times of another run (e.g., of a DnC
+      worker) to these. Maxima and the current state (stack depth,
+      tableau dimensions, etc.) keep the larger of the two values.
+    */
+    void aggregate( const Statistics &other );
+
     /*
       Set starting time of the main loop.
     */
@@ -44,13 +58,17 @@ public:
     */
     void incNumMainLoopIterations();
     void incNumSimplexSteps();
+    void incNumDualSimplexPhases();
+    void incNumDualSimplexSteps();
     void addTimeMainLoop( unsigned long long time );
     void addTimeSimplexSteps( unsigned long long time );
+    void addTimeDualSimplexSteps( unsigned long long time );
     void addTimeConstraintFixingSteps( unsigned long long time );
     void incNumConstraintFixingSteps();
     unsigned long long getNumMainLoopIterations() const;
     void setNumPlConstraints( unsigned numberOfConstraints );
     void setNumActivePlConstraints( unsigned numberOfConstraints );
+    unsigned getNumActivePlConstraints() const;
     void setNumPlValidSplits( unsigned numberOfSplits );
     void setNumPlSMTSplits( unsigned numberOfSplits );
     void setCurrentDegradation( double degradation );
@@ -66,6 +84,7 @@ public:
     double getMaxDegradation() const;
     unsigned getNumPrecisionRestorations() const;
     unsigned long long getTimeSimplexStepsMicro() const;
+    unsigned long long getNumDualSimplexSteps() const;
     unsigned long long getNumConstraintFixingSteps() const;
 
     /*
@@ -79,6 +98,7 @@ public:
     void incNumSimplexUnstablePivots();
     void incNumAddedRows();
     void incNumMergedColumns();
+    void incNumTableauMatrixCopies();
     void setCurrentTableauDimension( unsigned m, unsigned n );
     void addTimePivots( unsigned long long time );
     unsigned getAveragePivotTimeInMicro() const;
@@ -92,12 +112,21 @@ public:
     void setCurrentStackDepth( unsigned depth );
     void incNumSplits();
     void incNumPops();
+    void incNumBackjumps();
+    void incNumLearnedClauses();
+    void incNumClausePropagations();
     void addTimeSmtCore( unsigned long long time );
     void incNumVisitedTreeStates();
+    void setSearchProgress( double progress );
+    unsigned getCurrentStackDepth() const;
     unsigned getMaxStackDepth() const;
     unsigned getNumPops() const;
+    unsigned getNumBackjumps() const;
+    unsigned getNumLearnedClauses() const;
+    unsigned getNumClausePropagations() const;
     unsigned getNumVisitedTreeStates() const;
     unsigned getNumSplits() const;
+    double getSearchProgress() const;
     unsigned long long getTotalTime() const;
 
     /*
@@ -125,10 +154,21 @@ public:
 
     void incNumTighteningsFromSymbolicBoundTightening( unsigned increment );
 
+    /*
+      Bounds shared with other engines (in portfolio mode)
+    */
+    void incNumExportedBounds();
+    void incNumImportedBounds();
+    unsigned long long getNumExportedBounds() const;
+    unsigned long long getNumImportedBounds() const;
+
     /*
       Basis factorization statistics
     */
     void incNumBasisRefactorizations();
+    void addSparseLUFactorization( unsigned long long basisNonZeros,
+                                   unsigned long long factorNonZeros );
+    void addAdaptiveRefactorization( unsigned numBasisUpdates );
 
     /*
       Projected Steepest Edge related statistics.
@@ -177,6 +217,14 @@ private:
     // Total time spent on performing simplex steps, in microseconds
     unsigned long long _timeSimplexStepsMicro;
 
+    // Number of dual simplex phases invoked after bound changes, and
+    // the number of dual simplex pivots they performed
+    unsigned long long _numDualSimplexPhases;
+    unsigned long long _numDualSimplexSteps;
+
+    // Total time spent on performing dual simplex steps, in microseconds
+    unsigned long long _timeDualSimplexStepsMicro;
+
     // Total time spent in the main loop, in microseconds
     unsigned long long _timeMainLoopMicro;
 
@@ -197,9 +245,18 @@ private:
     // Total number of pops so far
     unsigned _numPops;
 
+    // Number of pops that skipped decision levels, number of learned
+    // clauses, and number of case splits implied by learned clauses
+    unsigned _numBackjumps;
+    unsigned _numLearnedClauses;
+    unsigned _numClausePropagations;
+
     // Total number of states in the search tree visited so far
     unsigned _numVisitedTreeStates;
 
+    // Estimated fraction of the search tree explored so far
+    double _searchProgress;
+
     // Total number of tableau pivot operations performed, both
     // degenerate and non-degenerate
     unsigned long long _numTableauPivots;
@@ -228,6 +285,10 @@ private:
     // Total number of merged columns in the tableau
     unsigned long long _numMergedColumns;
 
+    // Number of times the tableau copied a constraint matrix that was
+    // shared with stored states, before changing it
+    unsigned long long _numTableauMatrixCopies;
+
     // Current Tableau dimensions
     unsigned _currentTableauM;
     unsigned _currentTableauN;
@@ -259,6 +320,11 @@ private:
     // Number of bound tightenings proposed by the pl constraints
     unsigned long long _numBoundsProposedByPlConstraints;
 
+    // Number of root-level bounds shared with other engines, and number
+    // of bounds received from them
+    unsigned long long _numExportedBounds;
+    unsigned long long _numImportedBounds;
+
     // Number of bound tightening rounds performed on the constraint matrix, and
     // consequent tightenings proposed.
     unsigned long long _numBoundTighteningsOnConstraintMatrix;
@@ -267,6 +333,17 @@ private:
     // Basis factorization statistics
     unsigned long long _numBasisRefactorizations;
 
+    // Sparse LU factorizations performed, and the total number of non-zeros
+    // in the factorized bases and in the resulting factors (for fill-in)
+    unsigned long long _numSparseLUFactorizations;
+    unsigned long long _totalSparseLUBasisNonZeros;
+    unsigned long long _totalSparseLUFactorNonZeros;
+
+    // Refactorizations triggered by the amortized cost of the basis updates,
+    // and the total number of updates performed before them
+    unsigned long long _numAdaptiveRefactorizations;
+    unsigned long long _totalBasisUpdatesBeforeAdaptiveRefactorization;
+
     // Projected steepest edge statistics
     unsigned long long _pseNumIterations;
     unsigned long long _pseNumResetReferenceSpace;
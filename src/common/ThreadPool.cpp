@@ -0,0 +1,184 @@
+/*********************                                                        */
+/*! \file ThreadPool.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool( unsigned numberOfThreads )
+    : _task( NULL )
+    , _numberOfTasks( 0 )
+    , _generation( 0 )
+    , _nextTask( 0 )
+    , _activeWorkers( 0 )
+    , _shutdown( false )
+{
+    for ( unsigned i = 1; i < numberOfThreads; ++i )
+        _workers.push_back( std::thread( &ThreadPool::workerLoop, this ) );
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock( _mutex );
+        _shutdown = true;
+    }
+    _taskAvailable.notify_all();
+
+    for ( auto &worker : _workers )
+        worker.join();
+}
+
+unsigned ThreadPool::getNumberOfThreads() const
+{
+    return _workers.size() + 1;
+}
+
+void ThreadPool::run( unsigned numberOfTasks, const std::function<void( unsigned )> &task )
+{
+    if ( numberOfTasks == 0 )
+        return;
+
+    if ( _workers.empty() || numberOfTasks == 1 )
+    {
+        for ( unsigned i = 0; i < numberOfTasks; ++i )
+            task( i );
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock( _mutex );
+        _task = &task;
+        _numberOfTasks = numberOfTasks;
+        _nextTask = 0;
+        _exception = nullptr;
+        _activeWorkers = _workers.size();
+        ++_generation;
+    }
+    _taskAvailable.notify_all();
+
+    executeTasks();
+
+    std::unique_lock<std::mutex> lock( _mutex );
+    _batchDone.wait( lock, [this]{ return _activeWorkers == 0; } );
+    _task = NULL;
+
+    if ( _exception )
+    {
+        std::exception_ptr exception = _exception;
+        _exception = nullptr;
+        std::rethrow_exception( exception );
+    }
+}
+
+unsigned ThreadPool::getNumberOfBlocks( const ThreadPool *threadPool, unsigned size,
+                                        double workPerElement, double minimalWorkPerBlock )
+{
+    if ( !threadPool || size == 0 )
+        return 1;
+
+    double totalWork = size * workPerElement;
+    if ( totalWork < 2 * minimalWorkPerBlock )
+        return 1;
+
+    unsigned numberOfBlocks = threadPool->getNumberOfThreads();
+    if ( numberOfBlocks > size )
+        numberOfBlocks = size;
+    if ( numberOfBlocks > totalWork / minimalWorkPerBlock )
+        numberOfBlocks = (unsigned)( totalWork / minimalWorkPerBlock );
+
+    return numberOfBlocks;
+}
+
+void ThreadPool::runInBlocks( ThreadPool *threadPool, unsigned size, unsigned numberOfBlocks,
+                              const std::function<void( unsigned, unsigned, unsigned )> &computeBlock )
+{
+    if ( !threadPool || numberOfBlocks <= 1 )
+    {
+        computeBlock( 0, 0, size );
+        return;
+    }
+
+    threadPool->run( numberOfBlocks, [&]( unsigned block )
+    {
+        unsigned begin;
+        unsigned end;
+        getBlock( size, numberOfBlocks, block, begin, end );
+        computeBlock( block, begin, end );
+    } );
+}
+
+void ThreadPool::getBlock( unsigned size, unsigned numberOfBlocks, unsigned block,
+                           unsigned &begin, unsigned &end )
+{
+    unsigned blockSize = size / numberOfBlocks;
+    unsigned remainder = size % numberOfBlocks;
+
+    // The first remainder blocks get one extra element
+    begin = block * blockSize + ( block < remainder ? block : remainder );
+    end = begin + blockSize + ( block < remainder ? 1 : 0 );
+}
+
+void ThreadPool::workerLoop()
+{
+    unsigned long long lastGeneration = 0;
+
+    while ( true )
+    {
+        {
+            std::unique_lock<std::mutex> lock( _mutex );
+            _taskAvailable.wait( lock, [this, lastGeneration]{
+                    return _shutdown || _generation != lastGeneration;
+                } );
+
+            if ( _shutdown )
+                return;
+
+            lastGeneration = _generation;
+        }
+
+        executeTasks();
+
+        {
+            std::lock_guard<std::mutex> lock( _mutex );
+            --_activeWorkers;
+        }
+        _batchDone.notify_one();
+    }
+}
+
+void ThreadPool::executeTasks()
+{
+    unsigned taskIndex;
+    while ( ( taskIndex = _nextTask++ ) < _numberOfTasks )
+    {
+        try
+        {
+            ( *_task )( taskIndex );
+        }
+        catch ( ... )
+        {
+            std::lock_guard<std::mutex> lock( _mutex );
+            if ( !_exception )
+                _exception = std::current_exception();
+        }
+    }
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,108 @@
+/*********************                                                        */
+/*! \file ThreadPool.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** A fixed-size pool of threads for fork-join parallelism: the caller
+ ** submits a batch of indexed tasks, takes part in executing them, and
+ ** returns once all of them are done.
+ **/
+
+#ifndef __ThreadPool_h__
+#define __ThreadPool_h__
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool
+{
+public:
+    /*
+      The number of threads includes the calling thread, i.e. a pool
+      of n threads spawns n - 1 workers.
+    */
+    ThreadPool( unsigned numberOfThreads );
+    ~ThreadPool();
+
+    unsigned getNumberOfThreads() const;
+
+    /*
+      Execute task( 0 ), ..., task( numberOfTasks - 1 ), and return
+      once all of them have completed. Tasks are claimed dynamically,
+      so no assumptions should be made about which thread runs which
+      task. If any task throws, the first exception is rethrown here
+      (after all tasks have finished). Not reentrant.
+    */
+    void run( unsigned numberOfTasks, const std::function<void( unsigned )> &task );
+
+    /*
+      The number of blocks into which a range of the given size should
+      be split by runInBlocks(), given the amount of work per element:
+      at most one block per thread, and each block worth at least
+      minimalWorkPerBlock. A NULL pool always yields a single block.
+    */
+    static unsigned getNumberOfBlocks( const ThreadPool *threadPool, unsigned size,
+                                       double workPerElement, double minimalWorkPerBlock );
+
+    /*
+      Split [0, size) into numberOfBlocks contiguous blocks of (almost)
+      equal size, and call computeBlock( block, begin, end ) for each of
+      them -- concurrently, unless threadPool is NULL.
+    */
+    static void runInBlocks( ThreadPool *threadPool, unsigned size, unsigned numberOfBlocks,
+                             const std::function<void( unsigned, unsigned, unsigned )> &computeBlock );
+
+private:
+    std::vector<std::thread> _workers;
+
+    std::mutex _mutex;
+    std::condition_variable _taskAvailable;
+    std::condition_variable _batchDone;
+
+    /*
+      The current batch. Workers recognize a new batch by its
+      generation number.
+    */
+    const std::function<void( unsigned )> *_task;
+    unsigned _numberOfTasks;
+    unsigned long long _generation;
+    std::atomic_uint _nextTask;
+    unsigned _activeWorkers;
+    std::exception_ptr _exception;
+    bool _shutdown;
+
+    void workerLoop();
+
+    /*
+      The boundaries of the given block, when [0, size) is split into
+      numberOfBlocks blocks
+    */
+    static void getBlock( unsigned size, unsigned numberOfBlocks, unsigned block,
+                          unsigned &begin, unsigned &end );
+
+    /*
+      Claim and execute tasks of the current batch until none are left
+    */
+    void executeTasks();
+};
+
+#endif // __ThreadPool_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,95 @@
+/*********************                                                        */
+/*! \file Test_ObjectPool.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief [[ Add one-line brief description here ]]
+ **
+ ** [[ Add lengthier description here ]]
+ **/
+
+#include <cxxtest/TestSuite.h>
+
+#include "List.h"
+#include "MockErrno.h"
+#include "ObjectPool.h"
+#include "Set.h"
+
+class ObjectPoolTestSuite : public CxxTest::TestSuite
+{
+public:
+    MockErrno *mockErrno;
+
+    void setUp()
+    {
+        TS_ASSERT( mockErrno = new MockErrno );
+    }
+
+    void tearDown()
+    {
+        TS_ASSERT_THROWS_NOTHING( delete mockErrno );
+    }
+
+    void test_allocate_in_blocks()
+    {
+        ObjectPool<List<int>> pool( 4 );
+
+        TS_ASSERT_EQUALS( pool.getNumAllocated(), 0U );
+        TS_ASSERT_EQUALS( pool.getCapacity(), 0U );
+
+        Set<List<int> *> objects;
+        for ( unsigned i = 0; i < 5; ++i )
+        {
+            List<int> *object = pool.allocate();
+            TS_ASSERT( object->empty() );
+            object->append( i );
+            objects.insert( object );
+        }
+
+        TS_ASSERT_EQUALS( objects.size(), 5U );
+        TS_ASSERT_EQUALS( pool.getNumAllocated(), 5U );
+        TS_ASSERT_EQUALS( pool.getCapacity(), 8U );
+    }
+
+    void test_released_objects_are_reused()
+    {
+        ObjectPool<List<int>> pool( 2 );
+
+        List<int> *first = pool.allocate();
+        List<int> *second = pool.allocate();
+        TS_ASSERT_DIFFERS( first, second );
+
+        second->append( 3 );
+        pool.release( second );
+        TS_ASSERT_EQUALS( pool.getNumAllocated(), 1U );
+
+        // The most recently released object is handed out first, as is
+        List<int> *third = pool.allocate();
+        TS_ASSERT_EQUALS( third, second );
+        TS_ASSERT_EQUALS( third->size(), 1U );
+
+        pool.release( first );
+        pool.release( third );
+        TS_ASSERT_EQUALS( pool.getNumAllocated(), 0U );
+        TS_ASSERT_EQUALS( pool.getCapacity(), 2U );
+
+        // No new block is needed
+        pool.allocate();
+        pool.allocate();
+        TS_ASSERT_EQUALS( pool.getCapacity(), 2U );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
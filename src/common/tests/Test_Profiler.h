@@ -0,0 +1,232 @@
+/*********************                                                        */
+/*! \file Test_Profiler.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief [[ Add one-line brief description here ]]
+ **
+ ** [[ Add lengthier description here ]]
+ **/
+
+#include <cxxtest/TestSuite.h>
+
+#include "MString.h"
+#include "MockErrno.h"
+#include "Profiler.h"
+
+#include "T/sys/stat.h"
+#include "T/unistd.h"
+
+#include <string>
+#include <thread>
+
+class MockForProfiler :
+    public MockErrno,
+    public T::Base_open,
+    public T::Base_write,
+    public T::Base_close
+{
+public:
+    String lastPathname;
+    String writtenData;
+
+    int open( const char *pathname, int /* flags */, mode_t /* mode */ )
+    {
+        lastPathname = pathname;
+        writtenData = "";
+        return 17;
+    }
+
+    ssize_t write( int fd, const void *buf, size_t count )
+    {
+        TS_ASSERT_EQUALS( fd, 17 );
+        writtenData += String( (const char *)buf, count );
+        return count;
+    }
+
+    int close( int fd )
+    {
+        TS_ASSERT_EQUALS( fd, 17 );
+        return 0;
+    }
+};
+
+class ProfilerTestSuite : public CxxTest::TestSuite
+{
+public:
+    MockForProfiler *mock;
+
+    void setUp()
+    {
+        TS_ASSERT( mock = new MockForProfiler );
+    }
+
+    void tearDown()
+    {
+        // The depth is only tracked while the profiler is enabled
+        Profiler::enable( 16 );
+        Profiler::setSplitDepth( 0 );
+        Profiler::disable();
+        TS_ASSERT_THROWS_NOTHING( delete mock );
+    }
+
+    String writeChromeTrace()
+    {
+        TS_ASSERT_THROWS_NOTHING( Profiler::writeChromeTrace( "trace.json" ) );
+        TS_ASSERT_EQUALS( mock->lastPathname, "trace.json" );
+        return mock->writtenData;
+    }
+
+    String writeDepthHistograms()
+    {
+        TS_ASSERT_THROWS_NOTHING( Profiler::writeDepthHistograms( "histogram.csv" ) );
+        TS_ASSERT_EQUALS( mock->lastPathname, "histogram.csv" );
+        return mock->writtenData;
+    }
+
+    unsigned countOccurrences( const String &text, const String &pattern )
+    {
+        unsigned count = 0;
+        std::string haystack( text.ascii() );
+        size_t position = haystack.find( pattern.ascii() );
+        while ( position != std::string::npos )
+        {
+            ++count;
+            position = haystack.find( pattern.ascii(), position + 1 );
+        }
+        return count;
+    }
+
+    void test_nothing_recorded_while_disabled()
+    {
+        Profiler::enable( 16 );
+        Profiler::disable();
+
+        {
+            Profiler::Scope scope( Profiler::registerScope( "scope" ) );
+        }
+
+        TS_ASSERT( !Profiler::enabled() );
+        TS_ASSERT_EQUALS( Profiler::getNumRecordedEvents(), 0U );
+    }
+
+    void test_register_scope()
+    {
+        unsigned first = Profiler::registerScope( "registered" );
+        unsigned second = Profiler::registerScope( "alsoRegistered" );
+
+        TS_ASSERT_DIFFERS( first, second );
+
+        // Equal names share an identifier, even at different addresses
+        char name[] = "registered";
+        TS_ASSERT_EQUALS( Profiler::registerScope( name ), first );
+        TS_ASSERT_EQUALS( Profiler::registerScope( "alsoRegistered" ), second );
+    }
+
+    void test_nested_scopes_and_depths()
+    {
+        Profiler::enable( 16 );
+        TS_ASSERT( Profiler::enabled() );
+
+        {
+            Profiler::Scope outer( Profiler::registerScope( "outer" ) );
+            Profiler::setSplitDepth( 2 );
+            {
+                Profiler::Scope inner( Profiler::registerScope( "inner" ) );
+            }
+            {
+                Profiler::Scope inner( Profiler::registerScope( "inner" ) );
+            }
+        }
+
+        Profiler::disable();
+
+        TS_ASSERT_EQUALS( Profiler::getNumRecordedEvents(), 3U );
+        TS_ASSERT_EQUALS( Profiler::getNumDroppedEvents(), 0U );
+
+        // Events are tagged with the depth at which they started
+        String histogram = writeDepthHistograms();
+
+        TS_ASSERT( histogram.contains( "scope,depth,count,totalMicro,maxMicro\n" ) );
+        TS_ASSERT( histogram.contains( "outer,0,1," ) );
+        TS_ASSERT( histogram.contains( "inner,2,2," ) );
+        TS_ASSERT( !histogram.contains( "inner,0," ) );
+
+        String trace = writeChromeTrace();
+
+        TS_ASSERT( trace.contains( "\"traceEvents\"" ) );
+        TS_ASSERT_EQUALS( countOccurrences( trace, "\"ph\": \"X\"" ), 3U );
+        TS_ASSERT( trace.contains( "\"args\": {\"depth\": 0, \"nesting\": 0}" ) );
+        TS_ASSERT( trace.contains( "\"args\": {\"depth\": 2, \"nesting\": 1}" ) );
+    }
+
+    void test_ring_buffer_overflow()
+    {
+        Profiler::enable( 4 );
+
+        for ( unsigned i = 0; i < 10; ++i )
+        {
+            Profiler::Scope scope( Profiler::registerScope( "scope" ) );
+        }
+
+        Profiler::disable();
+
+        TS_ASSERT_EQUALS( Profiler::getNumRecordedEvents(), 10U );
+        TS_ASSERT_EQUALS( Profiler::getNumDroppedEvents(), 6U );
+
+        // Only the newest events are kept in the trace, but the
+        // histograms count them all
+        TS_ASSERT_EQUALS( countOccurrences( writeChromeTrace(), "\"ph\": \"X\"" ), 4U );
+        TS_ASSERT( writeDepthHistograms().contains( "scope,0,10," ) );
+
+        // Enabling the profiler again discards the old events
+        Profiler::enable( 4 );
+        Profiler::disable();
+        TS_ASSERT_EQUALS( Profiler::getNumRecordedEvents(), 0U );
+    }
+
+    void test_multiple_threads()
+    {
+        Profiler::enable( 16 );
+
+        auto work = []( unsigned depth )
+        {
+            Profiler::setSplitDepth( depth );
+            for ( unsigned i = 0; i < 5; ++i )
+            {
+                Profiler::Scope scope( Profiler::registerScope( "worker" ) );
+            }
+        };
+
+        std::thread first( work, 1 );
+        std::thread second( work, 3 );
+        first.join();
+        second.join();
+
+        Profiler::disable();
+
+        TS_ASSERT_EQUALS( Profiler::getNumRecordedEvents(), 10U );
+        TS_ASSERT_EQUALS( Profiler::getNumDroppedEvents(), 0U );
+
+        // Each recording thread gets its own track
+        TS_ASSERT_EQUALS( countOccurrences( writeChromeTrace(), "\"thread_name\"" ), 2U );
+
+        String histogram = writeDepthHistograms();
+        TS_ASSERT( histogram.contains( "worker,1,5," ) );
+        TS_ASSERT( histogram.contains( "worker,3,5," ) );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,144 @@
+/*********************                                                        */
+/*! \file Test_ThreadPool.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief [[ Add one-line brief description here ]]
+ **
+ ** [[ Add lengthier description here ]]
+ **/
+
+#include <cxxtest/TestSuite.h>
+
+#include "CommonError.h"
+#include "MockErrno.h"
+#include "ThreadPool.h"
+#include "Vector.h"
+
+#include <atomic>
+
+class ThreadPoolTestSuite : public CxxTest::TestSuite
+{
+public:
+    void test_run()
+    {
+        ThreadPool pool( 4 );
+        TS_ASSERT_EQUALS( pool.getNumberOfThreads(), 4U );
+
+        Vector<unsigned> results( 100, 0U );
+        std::atomic_uint executed( 0 );
+
+        // Run a few batches to make sure the workers pick up each one
+        for ( unsigned batch = 1; batch <= 5; ++batch )
+        {
+            TS_ASSERT_THROWS_NOTHING( pool.run( 100, [&]( unsigned task )
+                                                {
+                                                    results[task] += task * batch;
+                                                    ++executed;
+                                                } ) );
+        }
+
+        TS_ASSERT_EQUALS( executed.load(), 500U );
+        for ( unsigned i = 0; i < 100; ++i )
+            TS_ASSERT_EQUALS( results[i], 15 * i );
+    }
+
+    void test_single_thread()
+    {
+        ThreadPool pool( 1 );
+        TS_ASSERT_EQUALS( pool.getNumberOfThreads(), 1U );
+
+        // Without workers, tasks are executed in order by the caller
+        Vector<unsigned> order;
+        TS_ASSERT_THROWS_NOTHING( pool.run( 5, [&]( unsigned task ) { order.append( task ); } ) );
+        TS_ASSERT( order == Vector<unsigned>( { 0, 1, 2, 3, 4 } ) );
+    }
+
+    void test_exception_is_rethrown()
+    {
+        MockErrno mockErrno;
+        ThreadPool pool( 3 );
+        std::atomic_uint executed( 0 );
+
+        TS_ASSERT_THROWS_EQUALS( pool.run( 10, [&]( unsigned task )
+                                           {
+                                               ++executed;
+                                               if ( task == 7 )
+                                                   throw CommonError( CommonError::DIVISION_BY_ZERO );
+                                           } ),
+                                 const CommonError &e,
+                                 e.getCode(),
+                                 CommonError::DIVISION_BY_ZERO );
+
+        // All other tasks still ran, and the pool remains usable
+        TS_ASSERT_EQUALS( executed.load(), 10U );
+        TS_ASSERT_THROWS_NOTHING( pool.run( 10, [&]( unsigned ) { ++executed; } ) );
+        TS_ASSERT_EQUALS( executed.load(), 20U );
+    }
+
+    void test_number_of_blocks()
+    {
+        ThreadPool pool( 4 );
+
+        // No pool, or too little work: a single block
+        TS_ASSERT_EQUALS( ThreadPool::getNumberOfBlocks( NULL, 1000, 1000, 100 ), 1U );
+        TS_ASSERT_EQUALS( ThreadPool::getNumberOfBlocks( &pool, 10, 10, 100 ), 1U );
+
+        // Enough work for two blocks, but not for four
+        TS_ASSERT_EQUALS( ThreadPool::getNumberOfBlocks( &pool, 10, 25, 100 ), 2U );
+
+        // At most one block per thread, and at most one per element
+        TS_ASSERT_EQUALS( ThreadPool::getNumberOfBlocks( &pool, 1000, 1000, 100 ), 4U );
+        TS_ASSERT_EQUALS( ThreadPool::getNumberOfBlocks( &pool, 3, 1000, 100 ), 3U );
+    }
+
+    void test_run_in_blocks()
+    {
+        ThreadPool pool( 4 );
+
+        // The blocks partition the range, in order
+        Vector<unsigned> begins( 4, 0U );
+        Vector<unsigned> ends( 4, 0U );
+        Vector<unsigned> covered( 10, 0U );
+        TS_ASSERT_THROWS_NOTHING( ThreadPool::runInBlocks( &pool, 10, 4, [&]( unsigned block,
+                                                                             unsigned begin,
+                                                                             unsigned end )
+                                                           {
+                                                               begins[block] = begin;
+                                                               ends[block] = end;
+                                                               for ( unsigned i = begin; i < end; ++i )
+                                                                   ++covered[i];
+                                                           } ) );
+
+        TS_ASSERT( begins == Vector<unsigned>( { 0, 3, 6, 8 } ) );
+        TS_ASSERT( ends == Vector<unsigned>( { 3, 6, 8, 10 } ) );
+        TS_ASSERT( covered == Vector<unsigned>( 10, 1U ) );
+
+        // Without a pool, the whole range is a single block
+        unsigned calls = 0;
+        TS_ASSERT_THROWS_NOTHING( ThreadPool::runInBlocks( NULL, 10, 4, [&]( unsigned block,
+                                                                            unsigned begin,
+                                                                            unsigned end )
+                                                           {
+                                                               ++calls;
+                                                               TS_ASSERT_EQUALS( block, 0U );
+                                                               TS_ASSERT_EQUALS( begin, 0U );
+                                                               TS_ASSERT_EQUALS( end, 10U );
+                                                           } ) );
+        TS_ASSERT_EQUALS( calls, 1U );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -25,6 +25,7 @@ const bool GlobalConfiguration::USE_POLARITY_BASED_DIRECTION_HEURISTICS = true;
 const double GlobalConfiguration::DEFAULT_EPSILON_FOR_COMPARISONS = 0.0000000001;
 const unsigned GlobalConfiguration::DEFAULT_DOUBLE_TO_STRING_PRECISION = 10;
 const unsigned GlobalConfiguration::STATISTICS_PRINTING_FREQUENCY = 10000;
+const unsigned GlobalConfiguration::PROFILER_EVENTS_PER_THREAD = 262144;
 const double GlobalConfiguration::BOUND_COMPARISON_ADDITIVE_TOLERANCE = 0.0000001;
 const double GlobalConfiguration::BOUND_COMPARISON_MULTIPLICATIVE_TOLERANCE = 0.001 * 0.0000001;
 const double GlobalConfiguration::PIVOT_CHANGE_COLUMN_TOLERANCE = 0.000000001;
@@ -41,8 +42,14 @@ const unsigned GlobalConfiguration::DEGRADATION_CHECKING_FREQUENCY = 100;
 const double GlobalConfiguration::DEGRADATION_THRESHOLD = 0.1;
 const double GlobalConfiguration::ACCEPTABLE_SIMPLEX_PIVOT_THRESHOLD = 0.0001;
 const bool GlobalConfiguration::USE_COLUMN_MERGING_EQUATIONS = false;
+const bool GlobalConfiguration::USE_STATE_TRAIL = true;
+const bool GlobalConfiguration::USE_CONFLICT_ANALYSIS = true;
 const double GlobalConfiguration::GAUSSIAN_ELIMINATION_PIVOT_SCALE_THRESHOLD = 0.1;
+const unsigned GlobalConfiguration::GAUSSIAN_ELIMINATION_MARKOWITZ_SEARCH_LIMIT = 4;
 const unsigned GlobalConfiguration::MAX_SIMPLEX_PIVOT_SEARCH_ITERATIONS = 5;
+const bool GlobalConfiguration::USE_DUAL_SIMPLEX_AFTER_BOUND_CHANGES = true;
+const unsigned GlobalConfiguration::DUAL_SIMPLEX_MAX_ITERATIONS = 200;
+const double GlobalConfiguration::DUAL_STEEPEST_EDGE_MIN_WEIGHT = 0.000001;
 const DivideStrategy GlobalConfiguration::SPLITTING_HEURISTICS = DivideStrategy::ReLUViolation;
 const unsigned GlobalConfiguration::INTERVAL_SPLITTING_FREQUENCY = 5;
 const unsigned GlobalConfiguration::INTERVAL_SPLITTING_THRESHOLD = 10;
@@ -55,12 +62,15 @@ const unsigned GlobalConfiguration::SIMULATION_RANDOM_SEED = 1;
 const bool GlobalConfiguration::USE_HARRIS_RATIO_TEST = true;
 
 const double GlobalConfiguration::SYMBOLIC_TIGHTENING_ROUNDING_CONSTANT = 0.00000005;
+const double GlobalConfiguration::SYMBOLIC_TIGHTENING_SPARSE_WEIGHTS_DENSITY = 0.25;
+const double GlobalConfiguration::PARALLEL_PROPAGATION_MIN_WORK_PER_BLOCK = 32768;
 
 const bool GlobalConfiguration::PREPROCESS_INPUT_QUERY = true;
 const bool GlobalConfiguration::PREPROCESSOR_ELIMINATE_VARIABLES = true;
 const bool GlobalConfiguration::PREPROCESSOR_PL_CONSTRAINTS_ADD_AUX_EQUATIONS = true;
 const double GlobalConfiguration::PREPROCESSOR_ALMOST_FIXED_THRESHOLD = 0.00001;
 const bool GlobalConfiguration::PREPROCESSOR_MERGE_CONSECUTIVE_WEIGHTED_SUMS = false;
+const bool GlobalConfiguration::NETWORK_LEVEL_REASONER_DETECT_CONVOLUTIONS = true;
 
 const bool GlobalConfiguration::WARM_START = false;
 
@@ -80,6 +90,9 @@ const GlobalConfiguration::ExplicitBasisBoundTighteningType GlobalConfiguration:
 const bool GlobalConfiguration::EXPLICIT_BOUND_TIGHTENING_UNTIL_SATURATION = false;
 
 const unsigned GlobalConfiguration::REFACTORIZATION_THRESHOLD = 100;
+const bool GlobalConfiguration::USE_ADAPTIVE_REFACTORIZATION = true;
+const unsigned GlobalConfiguration::ADAPTIVE_REFACTORIZATION_MIN_UPDATES = 10;
+const unsigned GlobalConfiguration::ADAPTIVE_REFACTORIZATION_MAX_UPDATES = 200;
 const GlobalConfiguration::BasisFactorizationType GlobalConfiguration::BASIS_FACTORIZATION_TYPE =
     GlobalConfiguration::SPARSE_FORREST_TOMLIN_FACTORIZATION;
 
@@ -87,11 +100,27 @@ const unsigned GlobalConfiguration::POLARITY_CANDIDATES_THRESHOLD = 5;
 
 const unsigned GlobalConfiguration::DNC_DEPTH_THRESHOLD = 5;
 
+const unsigned GlobalConfiguration::BOUND_EXCHANGE_FREQUENCY = 100;
+const unsigned GlobalConfiguration::BOUND_EXCHANGE_CAPACITY = 100000;
+const unsigned GlobalConfiguration::DNC_BOUND_STORE_CAPACITY = 100000;
+const double GlobalConfiguration::DNC_NEARLY_DONE_SEARCH_PROGRESS = 0.5;
+const unsigned GlobalConfiguration::DNC_MAX_TIMEOUT_EXTENSIONS = 1;
+const double GlobalConfiguration::DNC_TIMEOUT_EXTENSION_SLACK = 1.5;
+const unsigned GlobalConfiguration::DNC_MIN_VISITED_STATES_FOR_ESTIMATE = 10;
+const unsigned GlobalConfiguration::DNC_MAX_ADAPTIVE_ONLINE_DIVIDES = 4;
+
 #ifdef ENABLE_GUROBI
 const unsigned GlobalConfiguration::GUROBI_NUMBER_OF_THREADS = 1;
 const bool GlobalConfiguration::GUROBI_LOGGING = false;
 #endif // ENABLE_GUROBI
 
+const double GlobalConfiguration::SIMPLEX_LP_SOLVER_FEASIBILITY_TOLERANCE = 0.000000001;
+const double GlobalConfiguration::SIMPLEX_LP_SOLVER_OPTIMALITY_TOLERANCE = 0.000000001;
+const double GlobalConfiguration::SIMPLEX_LP_SOLVER_PIVOT_TOLERANCE = 0.0000001;
+const double GlobalConfiguration::SIMPLEX_LP_SOLVER_INTEGRALITY_TOLERANCE = 0.00001;
+const unsigned GlobalConfiguration::SIMPLEX_LP_SOLVER_MAX_ITERATIONS = 100000;
+const unsigned GlobalConfiguration::SIMPLEX_LP_SOLVER_DEGENERATE_ITERATIONS_BEFORE_BLAND = 50;
+
 // Logging - note that it is enabled only in Debug mode
 const bool GlobalConfiguration::DNC_MANAGER_LOGGING = false;
 const bool GlobalConfiguration::ENGINE_LOGGING = false;
@@ -107,6 +136,7 @@ const bool GlobalConfiguration::QUERY_LOADER_LOGGING = false;
 const bool GlobalConfiguration::SYMBOLIC_BOUND_TIGHTENER_LOGGING = false;
 const bool GlobalConfiguration::NETWORK_LEVEL_REASONER_LOGGING = false;
 const bool GlobalConfiguration::MPS_PARSER_LOGGING= false;
+const bool GlobalConfiguration::SIMPLEX_LP_SOLVER_LOGGING = false;
 
 const bool GlobalConfiguration::USE_SMART_FIX = false;
 const bool GlobalConfiguration::USE_LEAST_FIX = false;
@@ -119,6 +149,7 @@ void GlobalConfiguration::print()
     printf( "  DEFAULT_EPSILON_FOR_COMPARISONS: %.15lf\n", DEFAULT_EPSILON_FOR_COMPARISONS );
     printf( "  DEFAULT_DOUBLE_TO_STRING_PRECISION: %u\n", DEFAULT_DOUBLE_TO_STRING_PRECISION );
     printf( "  STATISTICS_PRINTING_FREQUENCY: %u\n", STATISTICS_PRINTING_FREQUENCY );
+    printf( "  PROFILER_EVENTS_PER_THREAD: %u\n", PROFILER_EVENTS_PER_THREAD );
     printf( "  BOUND_COMPARISON_ADDITIVE_TOLERANCE: %.15lf\n", BOUND_COMPARISON_ADDITIVE_TOLERANCE );
     printf( "  BOUND_COMPARISON_MULTIPLICATIVE_TOLERANCE: %.15lf\n", BOUND_COMPARISON_MULTIPLICATIVE_TOLERANCE );
     printf( "  PIVOT_CHANGE_COLUMN_TOLERANCE: %.15lf\n", PIVOT_CHANGE_COLUMN_TOLERANCE );
@@ -130,8 +161,14 @@ void GlobalConfiguration::print()
     printf( "  DEGRADATION_THRESHOLD: %.15lf\n", DEGRADATION_THRESHOLD );
     printf( "  ACCEPTABLE_SIMPLEX_PIVOT_THRESHOLD: %.15lf\n", ACCEPTABLE_SIMPLEX_PIVOT_THRESHOLD );
     printf( "  USE_COLUMN_MERGING_EQUATIONS: %s\n", USE_COLUMN_MERGING_EQUATIONS ? "Yes" : "No" );
+    printf( "  USE_STATE_TRAIL: %s\n", USE_STATE_TRAIL ? "Yes" : "No" );
+    printf( "  USE_CONFLICT_ANALYSIS: %s\n", USE_CONFLICT_ANALYSIS ? "Yes" : "No" );
     printf( "  GAUSSIAN_ELIMINATION_PIVOT_SCALE_THRESHOLD: %.15lf\n", GAUSSIAN_ELIMINATION_PIVOT_SCALE_THRESHOLD );
+    printf( "  GAUSSIAN_ELIMINATION_MARKOWITZ_SEARCH_LIMIT: %u\n", GAUSSIAN_ELIMINATION_MARKOWITZ_SEARCH_LIMIT );
     printf( "  MAX_SIMPLEX_PIVOT_SEARCH_ITERATIONS: %u\n", MAX_SIMPLEX_PIVOT_SEARCH_ITERATIONS );
+    printf( "  USE_DUAL_SIMPLEX_AFTER_BOUND_CHANGES: %s\n", USE_DUAL_SIMPLEX_AFTER_BOUND_CHANGES ? "Yes" : "No" );
+    printf( "  DUAL_SIMPLEX_MAX_ITERATIONS: %u\n", DUAL_SIMPLEX_MAX_ITERATIONS );
+    printf( "  DUAL_STEEPEST_EDGE_MIN_WEIGHT: %.15lf\n", DUAL_STEEPEST_EDGE_MIN_WEIGHT );
     printf( "  BOUND_TIGHTING_ON_CONSTRAINT_MATRIX_FREQUENCY: %u\n",
             BOUND_TIGHTING_ON_CONSTRAINT_MATRIX_FREQUENCY );
     printf( "  COST_FUNCTION_ERROR_THRESHOLD: %.15lf\n", COST_FUNCTION_ERROR_THRESHOLD );
@@ -141,6 +178,8 @@ void GlobalConfiguration::print()
     printf( "  PREPROCESSOR_ELIMINATE_VARIABLES: %s\n", PREPROCESSOR_ELIMINATE_VARIABLES ? "Yes" : "No" );
     printf( "  PREPROCESSOR_PL_CONSTRAINTS_ADD_AUX_EQUATIONS: %s\n",
             PREPROCESSOR_PL_CONSTRAINTS_ADD_AUX_EQUATIONS ? "Yes" : "No" );
+    printf( "  NETWORK_LEVEL_REASONER_DETECT_CONVOLUTIONS: %s\n",
+            NETWORK_LEVEL_REASONER_DETECT_CONVOLUTIONS ? "Yes" : "No" );
     printf( "  PSE_ITERATIONS_BEFORE_RESET: %u\n", PSE_ITERATIONS_BEFORE_RESET );
     printf( "  PSE_GAMMA_ERROR_THRESHOLD: %.15lf\n", PSE_GAMMA_ERROR_THRESHOLD );
     printf( "  RELU_CONSTRAINT_COMPARISON_TOLERANCE: %.15lf\n", RELU_CONSTRAINT_COMPARISON_TOLERANCE );
@@ -165,6 +204,9 @@ void GlobalConfiguration::print()
     printf( "  EXPLICIT_BOUND_TIGHTENING_UNTIL_SATURATION: %s\n",
             EXPLICIT_BOUND_TIGHTENING_UNTIL_SATURATION ? "Yes" : "No" );
     printf( "  REFACTORIZATION_THRESHOLD: %u\n", REFACTORIZATION_THRESHOLD );
+    printf( "  USE_ADAPTIVE_REFACTORIZATION: %s\n", USE_ADAPTIVE_REFACTORIZATION ? "Yes" : "No" );
+    printf( "  ADAPTIVE_REFACTORIZATION_MIN_UPDATES: %u\n", ADAPTIVE_REFACTORIZATION_MIN_UPDATES );
+    printf( "  ADAPTIVE_REFACTORIZATION_MAX_UPDATES: %u\n", ADAPTIVE_REFACTORIZATION_MAX_UPDATES );
 
     String basisFactorizationType;
     if ( GlobalConfiguration::BASIS_FACTORIZATION_TYPE == GlobalConfiguration::LU_FACTORIZATION )
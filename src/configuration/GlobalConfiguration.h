@@ -34,6 +34,9 @@ public:
     // How often should the main loop print statistics?
     static const unsigned STATISTICS_PRINTING_FREQUENCY;
 
+    // How many profiler events to keep per thread, when profiling is enabled
+    static const unsigned PROFILER_EVENTS_PER_THREAD;
+
     // Tolerance when checking whether the value computed for a basic variable is out of bounds
     static const double BOUND_COMPARISON_ADDITIVE_TOLERANCE;
     static const double BOUND_COMPARISON_MULTIPLICATIVE_TOLERANCE;
@@ -85,6 +88,11 @@ public:
     // weighted sum layer, to reduce the number of variables
     static const bool PREPROCESSOR_MERGE_CONSECUTIVE_WEIGHTED_SUMS;
 
+    // If the flag is true, weighted sum layers of a constructed network
+    // level reasoner that compute a convolution are replaced by
+    // convolution layers, which store only their kernel
+    static const bool NETWORK_LEVEL_REASONER_DETECT_CONVOLUTIONS;
+
     // Try to set the initial tableau assignment to an assignment that is legal with
     // respect to the input network.
     static const bool WARM_START;
@@ -107,13 +115,37 @@ public:
     // to be merged (instead of a new row added).
     static const bool USE_COLUMN_MERGING_EQUATIONS;
 
+    // If true, the SMT core stores engine states incrementally, on undo trails of bound changes
+    // and constraint states, whenever the case splits involve no equations.
+    static const bool USE_STATE_TRAIL;
+
+    // If true, infeasible search states are explained in terms of the decision levels of the
+    // bounds involved, allowing the SMT core to backjump and to learn clauses over the phases
+    // of the piecewise-linear constraints. Requires the state trail.
+    static const bool USE_CONFLICT_ANALYSIS;
+
     // If a pivot element in a Gaussian elimination iteration is smaller than this threshold times
     // the largest element in the column, the elimination engine will attempt to pick another pivot.
     static const double GAUSSIAN_ELIMINATION_PIVOT_SCALE_THRESHOLD;
 
+    // Once a Markowitz pivot candidate has been found, the sparse elimination engine searches at
+    // most this many additional columns (in order of increasing sparsity) for a cheaper one.
+    static const unsigned GAUSSIAN_ELIMINATION_MARKOWITZ_SEARCH_LIMIT;
+
     // How many potential pivots should the engine inspect (at most) in every simplex iteration?
     static const unsigned MAX_SIMPLEX_PIVOT_SEARCH_ITERATIONS;
 
+    // If true, after case splits and bound tightenings the engine first attempts to restore
+    // feasibility with a dual simplex phase, before falling back to primal simplex steps.
+    static const bool USE_DUAL_SIMPLEX_AFTER_BOUND_CHANGES;
+
+    // The maximal number of pivots performed by a single dual simplex phase
+    static const unsigned DUAL_SIMPLEX_MAX_ITERATIONS;
+
+    // A lower bound on the dual steepest-edge weights, guarding against numerical cancellation
+    // in their updates
+    static const double DUAL_STEEPEST_EDGE_MIN_WEIGHT;
+
     static const DivideStrategy SPLITTING_HEURISTICS;
 
     // The frequency to use interval splitting when largest interval splitting strategy is in use.
@@ -180,6 +212,16 @@ public:
     // Symbolic tightening rounding constant
     static const double SYMBOLIC_TIGHTENING_ROUNDING_CONSTANT;
 
+    // Weight matrices whose fraction of non-zero entries is at most this value are propagated
+    // through a compressed-row kernel, instead of dense matrix multiplication
+    static const double SYMBOLIC_TIGHTENING_SPARSE_WEIGHTS_DENSITY;
+
+    // When bound propagation runs on multiple threads (see the
+    // num-propagation-threads option), the neurons of a layer are split
+    // into blocks of at least this many arithmetic operations each.
+    // Smaller layers are processed sequentially.
+    static const double PARALLEL_PROPAGATION_MIN_WORK_PER_BLOCK;
+
     /*
       Constraint fixing heuristics
     */
@@ -199,6 +241,14 @@ public:
     // The number of accumualted eta matrices, after which the basis will be refactorized
 	static const unsigned REFACTORIZATION_THRESHOLD;
 
+    // Whether the Forrest-Tomlin factorizations should decide when to refactorize
+    // by the amortized cost of their solves, instead of by REFACTORIZATION_THRESHOLD.
+    // The number of basis updates between adaptive refactorizations is bounded by
+    // the minimum and maximum below.
+    static const bool USE_ADAPTIVE_REFACTORIZATION;
+    static const unsigned ADAPTIVE_REFACTORIZATION_MIN_UPDATES;
+    static const unsigned ADAPTIVE_REFACTORIZATION_MAX_UPDATES;
+
     // The kind of basis factorization algorithm in use
     enum BasisFactorizationType {
         LU_FACTORIZATION,
@@ -217,6 +267,42 @@ public:
     */
     static const unsigned DNC_DEPTH_THRESHOLD;
 
+    /* In portfolio mode, how often (in main loop iterations) each engine
+       shares its root-level bounds and picks up those of the others
+    */
+    static const unsigned BOUND_EXCHANGE_FREQUENCY;
+
+    /* In portfolio mode, the max number of bounds each engine can share
+    */
+    static const unsigned BOUND_EXCHANGE_CAPACITY;
+
+    /* In DnC mode, the max number of root-level bounds of subqueries that
+       each worker can share with the workers solving their descendants
+    */
+    static const unsigned DNC_BOUND_STORE_CAPACITY;
+
+    /* In adaptive DnC scheduling, a timed-out subquery whose search is
+       estimated to be at least this far along is given more time instead
+       of being divided (at most DNC_MAX_TIMEOUT_EXTENSIONS times)
+    */
+    static const double DNC_NEARLY_DONE_SEARCH_PROGRESS;
+    static const unsigned DNC_MAX_TIMEOUT_EXTENSIONS;
+
+    /* In adaptive DnC scheduling, the estimated time a subquery needs is
+       multiplied by this factor when extending its timeout
+    */
+    static const double DNC_TIMEOUT_EXTENSION_SLACK;
+
+    /* In adaptive DnC scheduling, the progress estimate of a search that
+       visited fewer tree states than this is ignored
+    */
+    static const unsigned DNC_MIN_VISITED_STATES_FOR_ESTIMATE;
+
+    /* In adaptive DnC scheduling, the max number of online divides of a
+       subquery (unless more are requested by the options)
+    */
+    static const unsigned DNC_MAX_ADAPTIVE_ONLINE_DIVIDES;
+
 #ifdef ENABLE_GUROBI
     /*
       The number of threads Gurobi spawns
@@ -225,6 +311,19 @@ public:
     static const bool GUROBI_LOGGING;
 #endif // ENABLE_GUROBI
 
+    /*
+      Tolerances and limits of the native (MI)LP solver
+    */
+    static const double SIMPLEX_LP_SOLVER_FEASIBILITY_TOLERANCE;
+    static const double SIMPLEX_LP_SOLVER_OPTIMALITY_TOLERANCE;
+    static const double SIMPLEX_LP_SOLVER_PIVOT_TOLERANCE;
+    static const double SIMPLEX_LP_SOLVER_INTEGRALITY_TOLERANCE;
+    static const unsigned SIMPLEX_LP_SOLVER_MAX_ITERATIONS;
+
+    // After this many consecutive degenerate pivots, the native LP
+    // solver switches from Dantzig's rule to Bland's rule
+    static const unsigned SIMPLEX_LP_SOLVER_DEGENERATE_ITERATIONS_BEFORE_BLAND;
+
     /*
       Logging options
     */
@@ -242,6 +341,7 @@ public:
     static const bool SYMBOLIC_BOUND_TIGHTENER_LOGGING;
     static const bool NETWORK_LEVEL_REASONER_LOGGING;
     static const bool MPS_PARSER_LOGGING;
+    static const bool SIMPLEX_LP_SOLVER_LOGGING;
 };
 
 #endif // __GlobalConfiguration_h__
@@ -45,9 +45,15 @@ void OptionParser::initialize()
         ( "snc",
           boost::program_options::bool_switch( &((*_boolOptions)[Options::DNC_MODE]) ),
           "Use the split-and-conquer solving mode: largest-interval/polarity/auto. default: auto" )
+        ( "portfolio",
+          boost::program_options::bool_switch( &((*_boolOptions)[Options::PORTFOLIO_MODE]) ),
+          "Race num-workers differently configured engines on the query, sharing the bounds they derive" )
         ( "restore-tree-states",
           boost::program_options::bool_switch( &((*_boolOptions)[Options::RESTORE_TREE_STATES]) ),
           "Restore tree states in SnC mode" )
+        ( "adaptive-snc",
+          boost::program_options::bool_switch( &((*_boolOptions)[Options::ADAPTIVE_DNC_SCHEDULING]) ),
+          "In SnC mode, extend or split timed-out subqueries based on their estimated progress" )
         ( "dump-bounds",
           boost::program_options::bool_switch( &((*_boolOptions)[Options::DUMP_BOUNDS]) ),
           "Dump the bounds after preprocessing" )
@@ -63,9 +69,21 @@ void OptionParser::initialize()
         ( "summary-file",
           boost::program_options::value<std::string>( &((*_stringOptions)[Options::SUMMARY_FILE]) ),
           "Summary file" )
+        ( "statistics-file",
+          boost::program_options::value<std::string>( &((*_stringOptions)[Options::STATISTICS_FILE]) ),
+          "Write the result and the solver statistics to this file, in JSON format" )
+        ( "trace-file",
+          boost::program_options::value<std::string>( &((*_stringOptions)[Options::TRACE_FILE]) ),
+          "Profile the solver's hot paths and write a Chrome trace of them to this file" )
+        ( "depth-histogram-file",
+          boost::program_options::value<std::string>( &((*_stringOptions)[Options::DEPTH_HISTOGRAM_FILE]) ),
+          "Profile the solver's hot paths and write per-split-depth timing histograms to this file, as CSV" )
         ( "query-dump-file",
           boost::program_options::value<std::string>( &((*_stringOptions)[Options::QUERY_DUMP_FILE]) ),
           "Query dump file" )
+        ( "binary-query-dump",
+          boost::program_options::bool_switch( &((*_boolOptions)[Options::BINARY_QUERY_DUMP]) ),
+          "Dump the query in the binary format, which loads faster than the text format" )
         ( "num-workers",
           boost::program_options::value<int>( &((*_intOptions)[Options::NUM_WORKERS]) ),
           "(SnC) Number of workers" )
@@ -106,20 +124,24 @@ void OptionParser::initialize()
          ( "preprocessor-bound-tolerance",
           boost::program_options::value<float>( &((*_floatOptions)[Options::PREPROCESSOR_BOUND_TOLERANCE]) ),
           "epsilon for preprocessor bound tightening comparisons" )
-#ifdef ENABLE_GUROBI
         ( "milp",
           boost::program_options::bool_switch( &((*_boolOptions)[Options::SOLVE_WITH_MILP]) ),
           "Use a MILP solver to solve the input query" )
         ( "milp-tightening",
           boost::program_options::value<std::string>( &((*_stringOptions)[Options::MILP_SOLVER_BOUND_TIGHTENING_TYPE ]) ),
-          "The MILP solver bound tightening type: lp/lp-inc/milp/milp-inc/iter-prop/none. default: lp" )
+          "The MILP solver bound tightening type: lp/lp-inc/milp/milp-inc/iter-prop/none. default: lp with Gurobi, none otherwise" )
         ( "milp-timeout",
           boost::program_options::value<float>( &((*_floatOptions)[Options::MILP_SOLVER_TIMEOUT]) ),
           "Per-ReLU timeout for iterative propagation" )
         ( "num-simulations",
           boost::program_options::value<int>( &((*_intOptions)[Options::NUMBER_OF_SIMULATIONS]) ),
           "Number of simulations generated per neuron" )
-#endif // ENABLE_GUROBI
+        ( "num-propagation-threads",
+          boost::program_options::value<int>( &((*_intOptions)[Options::NUM_PROPAGATION_THREADS]) ),
+          "Number of threads used to propagate bounds (interval, symbolic and DeepPoly) within each layer. default: 1" )
+        ( "lp-solver",
+          boost::program_options::value<std::string>( &((*_stringOptions)[Options::LP_SOLVER]) ),
+          "The (MI)LP solver used by --milp and --milp-tightening: native/gurobi. default: gurobi if available, native otherwise" )
 
         ;
 
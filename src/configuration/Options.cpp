@@ -45,8 +45,11 @@ void Options::initializeDefaultValues()
     _boolOptions[DNC_MODE] = false;
     _boolOptions[PREPROCESSOR_PL_CONSTRAINTS_ADD_AUX_EQUATIONS] = false;
     _boolOptions[RESTORE_TREE_STATES] = false;
+    _boolOptions[ADAPTIVE_DNC_SCHEDULING] = false;
     _boolOptions[DUMP_BOUNDS] = false;
     _boolOptions[SOLVE_WITH_MILP] = false;
+    _boolOptions[BINARY_QUERY_DUMP] = false;
+    _boolOptions[PORTFOLIO_MODE] = false;
 
     /*
       Int options
@@ -59,6 +62,7 @@ void Options::initializeDefaultValues()
     _intOptions[TIMEOUT] = 0;
     _intOptions[CONSTRAINT_VIOLATION_THRESHOLD] = 20;
     _intOptions[NUMBER_OF_SIMULATIONS] = 100;
+    _intOptions[NUM_PROPAGATION_THREADS] = 1;
 
     /*
       Float options
@@ -75,11 +79,15 @@ void Options::initializeDefaultValues()
     _stringOptions[PROPERTY_FILE_PATH] = "";
     _stringOptions[INPUT_QUERY_FILE_PATH] = "";
     _stringOptions[SUMMARY_FILE] = "";
+    _stringOptions[STATISTICS_FILE] = "";
+    _stringOptions[TRACE_FILE] = "";
+    _stringOptions[DEPTH_HISTOGRAM_FILE] = "";
     _stringOptions[SPLITTING_STRATEGY] = "";
     _stringOptions[SNC_SPLITTING_STRATEGY] = "";
     _stringOptions[SYMBOLIC_BOUND_TIGHTENING_TYPE] = "";
     _stringOptions[MILP_SOLVER_BOUND_TIGHTENING_TYPE] = "";
     _stringOptions[QUERY_DUMP_FILE] = "";
+    _stringOptions[LP_SOLVER] = "";
 }
 
 void Options::parseOptions( int argc, char **argv )
@@ -175,28 +183,36 @@ SymbolicBoundTighteningType Options::getSymbolicBoundTighteningType() const
 
 MILPSolverBoundTighteningType Options::getMILPSolverBoundTighteningType() const
 {
-    if ( gurobiEnabled() )
-    {
-        String strategyString = String( _stringOptions.get( Options::MILP_SOLVER_BOUND_TIGHTENING_TYPE ) );
-        if ( strategyString == "lp" )
-            return MILPSolverBoundTighteningType::LP_RELAXATION;
-        else if ( strategyString == "lp-inc" )
-            return MILPSolverBoundTighteningType::LP_RELAXATION_INCREMENTAL;
-        else if ( strategyString == "milp" )
-            return MILPSolverBoundTighteningType::MILP_ENCODING;
-        else if ( strategyString == "milp-inc" )
-            return MILPSolverBoundTighteningType::MILP_ENCODING_INCREMENTAL;
-        else if ( strategyString == "iter-prop" )
-            return MILPSolverBoundTighteningType::ITERATIVE_PROPAGATION;
-        else if ( strategyString == "none" )
-            return MILPSolverBoundTighteningType::NONE;
-        else
-            return MILPSolverBoundTighteningType::LP_RELAXATION;
-    }
+    String strategyString = String( _stringOptions.get( Options::MILP_SOLVER_BOUND_TIGHTENING_TYPE ) );
+    if ( strategyString == "lp" )
+        return MILPSolverBoundTighteningType::LP_RELAXATION;
+    else if ( strategyString == "lp-inc" )
+        return MILPSolverBoundTighteningType::LP_RELAXATION_INCREMENTAL;
+    else if ( strategyString == "milp" )
+        return MILPSolverBoundTighteningType::MILP_ENCODING;
+    else if ( strategyString == "milp-inc" )
+        return MILPSolverBoundTighteningType::MILP_ENCODING_INCREMENTAL;
+    else if ( strategyString == "iter-prop" )
+        return MILPSolverBoundTighteningType::ITERATIVE_PROPAGATION;
+    else if ( strategyString == "none" )
+        return MILPSolverBoundTighteningType::NONE;
+
+    // By default, LP-based tightening is only performed with Gurobi
+    else if ( gurobiEnabled() )
+        return MILPSolverBoundTighteningType::LP_RELAXATION;
     else
-    {
         return MILPSolverBoundTighteningType::NONE;
-    }
+}
+
+LPSolverType Options::getLPSolverType() const
+{
+    String solverString = String( _stringOptions.get( Options::LP_SOLVER ) );
+    if ( solverString == "native" )
+        return LPSolverType::NATIVE;
+    else if ( solverString == "gurobi" && gurobiEnabled() )
+        return LPSolverType::GUROBI;
+    else
+        return gurobiEnabled() ? LPSolverType::GUROBI : LPSolverType::NATIVE;
 }
 
 //
@@ -17,6 +17,7 @@
 #define __Options_h__
 
 #include "DivideStrategy.h"
+#include "LPSolverType.h"
 #include "MString.h"
 #include "Map.h"
 #include "MILPSolverBoundTighteningType.h"
@@ -42,6 +43,10 @@ public:
         // Restore tree states of the parent when handling children in DnC.
         RESTORE_TREE_STATES,
 
+        // In DnC, decide per subquery whether to give it more time or how
+        // many ways to split it, based on its progress.
+        ADAPTIVE_DNC_SCHEDULING,
+
         // Dump the bounds of each variable after preprocessing
         DUMP_BOUNDS,
 
@@ -52,7 +57,13 @@ public:
         VERSION,
 
         // Solve the input query with a MILP solver
-        SOLVE_WITH_MILP
+        SOLVE_WITH_MILP,
+
+        // Dump the query (see QUERY_DUMP_FILE) in the binary format
+        BINARY_QUERY_DUMP,
+
+        // Race differently configured engines (see NUM_WORKERS) on the query
+        PORTFOLIO_MODE,
     };
 
     enum IntOptions {
@@ -72,6 +83,10 @@ public:
 
         // The number of simulations
         NUMBER_OF_SIMULATIONS,
+
+        // The number of threads used for the bound propagation within a
+        // layer of the network
+        NUM_PROPAGATION_THREADS,
     };
 
     enum FloatOptions{
@@ -90,11 +105,15 @@ public:
         PROPERTY_FILE_PATH,
         INPUT_QUERY_FILE_PATH,
         SUMMARY_FILE,
+        STATISTICS_FILE,
+        TRACE_FILE,
+        DEPTH_HISTOGRAM_FILE,
         SPLITTING_STRATEGY,
         SNC_SPLITTING_STRATEGY,
         SYMBOLIC_BOUND_TIGHTENING_TYPE,
         MILP_SOLVER_BOUND_TIGHTENING_TYPE,
         QUERY_DUMP_FILE,
+        LP_SOLVER,
     };
 
     /*
@@ -123,6 +142,7 @@ public:
     SnCDivideStrategy getSnCDivideStrategy() const;
     SymbolicBoundTighteningType getSymbolicBoundTighteningType() const;
     MILPSolverBoundTighteningType getMILPSolverBoundTighteningType() const;
+    LPSolverType getLPSolverType() const;
 
     /*
       Retrieve the value of the various options, by type
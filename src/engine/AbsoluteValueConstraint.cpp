@@ -78,6 +78,7 @@ ContextDependentPiecewiseLinearConstraint *AbsoluteValueConstraint::duplicateCon
     AbsoluteValueConstraint *clone = new AbsoluteValueConstraint( _b, _f );
     *clone = *this;
     this->initializeDuplicateCDOs( clone );
+    copyBoundsToDuplicate( clone );
     return clone;
 }
 
@@ -88,10 +89,12 @@ void AbsoluteValueConstraint::restoreState( const PiecewiseLinearConstraint *sta
     CVC4::context::CDO<bool> *activeStatus = _cdConstraintActive;
     CVC4::context::CDO<PhaseStatus> *phaseStatus = _cdPhaseStatus;
     CVC4::context::CDList<PhaseStatus> *infeasibleCases = _cdInfeasibleCases;
+    const ITableau *boundStore = _boundStore;
     *this = *abs;
     _cdConstraintActive = activeStatus;
     _cdPhaseStatus = phaseStatus;
     _cdInfeasibleCases = infeasibleCases;
+    _boundStore = boundStore;
 }
 
 void AbsoluteValueConstraint::registerAsWatcher( ITableau *tableau )
@@ -128,12 +131,9 @@ void AbsoluteValueConstraint::notifyLowerBound( unsigned variable, double bound
     if ( _statistics )
         _statistics->incNumBoundNotificationsPlConstraints();
 
-    if ( _lowerBounds.exists( variable ) &&
-         !FloatUtils::gt( bound, _lowerBounds[variable] ) )
+    if ( !updateLowerBound( variable, bound ) )
         return;
 
-    _lowerBounds[variable] = bound;
-
     // Check whether the phase has become fixed
     fixPhaseIfNeeded();
 
@@ -144,7 +144,7 @@ void AbsoluteValueConstraint::notifyLowerBound( unsigned variable, double bound
         {
             if ( bound < 0 )
             {
-                double fUpperBound = FloatUtils::max( -bound, _upperBounds[_b] );
+                double fUpperBound = FloatUtils::max( -bound, getUpperBound( _b ) );
                 _constraintBoundTightener->registerTighterUpperBound( _f, fUpperBound );
 
                 if ( _auxVarsInUse )
@@ -179,11 +179,9 @@ void AbsoluteValueConstraint::notifyUpperBound( unsigned variable, double bound
     if ( _statistics )
         _statistics->incNumBoundNotificationsPlConstraints();
 
-    if ( _upperBounds.exists( variable ) && !FloatUtils::lt( bound, _upperBounds[variable] ) )
+    if ( !updateUpperBound( variable, bound ) )
         return;
 
-    _upperBounds[variable] = bound;
-
     // Check whether the phase has become fixed
     fixPhaseIfNeeded();
 
@@ -194,7 +192,7 @@ void AbsoluteValueConstraint::notifyUpperBound( unsigned variable, double bound
         {
             if ( bound > 0 )
             {
-                double fUpperBound = FloatUtils::max( bound, -_lowerBounds[_b] );
+                double fUpperBound = FloatUtils::max( bound, -getLowerBound( _b ) );
                 _constraintBoundTightener->registerTighterUpperBound( _f, fUpperBound );
 
                 if ( _auxVarsInUse )
@@ -211,24 +209,24 @@ void AbsoluteValueConstraint::notifyUpperBound( unsigned variable, double bound
         else if ( variable == _f )
         {
             // F's upper bound can restrict both bounds of B
-            if ( bound < _upperBounds[_b] )
+            if ( bound < getUpperBound( _b ) )
                 _constraintBoundTightener->registerTighterUpperBound( _b, bound );
 
-            if ( -bound > _lowerBounds[_b] )
+            if ( -bound > getLowerBound( _b ) )
                 _constraintBoundTightener->registerTighterLowerBound( _b, -bound );
 
             if ( _auxVarsInUse )
             {
-                if ( _lowerBounds.exists( _b ) )
+                if ( existsLowerBound( _b ) )
                 {
                     _constraintBoundTightener->
-                        registerTighterUpperBound( _posAux, bound - _lowerBounds[_b] );
+                        registerTighterUpperBound( _posAux, bound - getLowerBound( _b ) );
                 }
 
-                if ( _upperBounds.exists( _b ) )
+                if ( existsUpperBound( _b ) )
                 {
                     _constraintBoundTightener->
-                        registerTighterUpperBound( _negAux, bound + _upperBounds[_b] );
+                        registerTighterUpperBound( _negAux, bound + getUpperBound( _b ) );
                 }
             }
         }
@@ -236,30 +234,30 @@ void AbsoluteValueConstraint::notifyUpperBound( unsigned variable, double bound
         {
             if ( variable == _posAux )
             {
-                if ( _upperBounds.exists( _b ) )
+                if ( existsUpperBound( _b ) )
                 {
                     _constraintBoundTightener->
-                        registerTighterUpperBound( _f, _upperBounds[_b] + bound );
+                        registerTighterUpperBound( _f, getUpperBound( _b ) + bound );
                 }
 
-                if ( _lowerBounds.exists( _f ) )
+                if ( existsLowerBound( _f ) )
                 {
                     _constraintBoundTightener->
-                        registerTighterLowerBound( _b, _lowerBounds[_f] - bound );
+                        registerTighterLowerBound( _b, getLowerBound( _f ) - bound );
                 }
             }
             else if ( variable == _negAux )
             {
-                if ( _lowerBounds.exists( _b ) )
+                if ( existsLowerBound( _b ) )
                 {
                     _constraintBoundTightener->
-                        registerTighterUpperBound( _f, bound - _lowerBounds[_b] );
+                        registerTighterUpperBound( _f, bound - getLowerBound( _b ) );
                 }
 
-                if ( _lowerBounds.exists( _f ) )
+                if ( existsLowerBound( _f ) )
                 {
                     _constraintBoundTightener->
-                        registerTighterUpperBound( _b, bound - _lowerBounds[_f] );
+                        registerTighterUpperBound( _b, bound - getLowerBound( _f ) );
                 }
             }
         }
@@ -438,24 +436,24 @@ void AbsoluteValueConstraint::dump( String &output ) const
                       );
 
     output += Stringf( "b in [%s, %s], ",
-                       _lowerBounds.exists( _b ) ? Stringf( "%lf", _lowerBounds[_b] ).ascii() : "-inf",
-                       _upperBounds.exists( _b ) ? Stringf( "%lf", _upperBounds[_b] ).ascii() : "inf" );
+                       existsLowerBound( _b ) ? Stringf( "%lf", getLowerBound( _b ) ).ascii() : "-inf",
+                       existsUpperBound( _b ) ? Stringf( "%lf", getUpperBound( _b ) ).ascii() : "inf" );
 
     output += Stringf( "f in [%s, %s]",
-                       _lowerBounds.exists( _f ) ? Stringf( "%lf", _lowerBounds[_f] ).ascii() : "-inf",
-                       _upperBounds.exists( _f ) ? Stringf( "%lf", _upperBounds[_f] ).ascii() : "inf" );
+                       existsLowerBound( _f ) ? Stringf( "%lf", getLowerBound( _f ) ).ascii() : "-inf",
+                       existsUpperBound( _f ) ? Stringf( "%lf", getUpperBound( _f ) ).ascii() : "inf" );
 
     if ( _auxVarsInUse )
     {
         output += Stringf( ". PosAux: %u. Range: [%s, %s]",
                            _posAux,
-                           _lowerBounds.exists( _posAux ) ? Stringf( "%lf", _lowerBounds[_posAux] ).ascii() : "-inf",
-                           _upperBounds.exists( _posAux ) ? Stringf( "%lf", _upperBounds[_posAux] ).ascii() : "inf" );
+                           existsLowerBound( _posAux ) ? Stringf( "%lf", getLowerBound( _posAux ) ).ascii() : "-inf",
+                           existsUpperBound( _posAux ) ? Stringf( "%lf", getUpperBound( _posAux ) ).ascii() : "inf" );
 
         output += Stringf( ". NegAux: %u. Range: [%s, %s]",
                            _negAux,
-                           _lowerBounds.exists( _negAux ) ? Stringf( "%lf", _lowerBounds[_negAux] ).ascii() : "-inf",
-                           _upperBounds.exists( _negAux ) ? Stringf( "%lf", _upperBounds[_negAux] ).ascii() : "inf" );
+                           existsLowerBound( _negAux ) ? Stringf( "%lf", getLowerBound( _negAux ) ).ascii() : "-inf",
+                           existsUpperBound( _negAux ) ? Stringf( "%lf", getUpperBound( _negAux ) ).ascii() : "inf" );
     }
 }
 
@@ -504,15 +502,15 @@ bool AbsoluteValueConstraint::constraintObsolete() const
 
 void AbsoluteValueConstraint::getEntailedTightenings( List<Tightening> &tightenings ) const
 {
-    ASSERT( _lowerBounds.exists( _b ) && _lowerBounds.exists( _f ) &&
-            _upperBounds.exists( _b ) && _upperBounds.exists( _f ) );
+    ASSERT( existsLowerBound( _b ) && existsLowerBound( _f ) &&
+            existsUpperBound( _b ) && existsUpperBound( _f ) );
 
     // Upper bounds
-    double bUpperBound = _upperBounds[_b];
-    double fUpperBound = _upperBounds[_f];
+    double bUpperBound = getUpperBound( _b );
+    double fUpperBound = getUpperBound( _f );
     // Lower bounds
-    double bLowerBound = _lowerBounds[_b];
-    double fLowerBound = _lowerBounds[_f];
+    double bLowerBound = getLowerBound( _b );
+    double fLowerBound = getLowerBound( _f );
 
     // F's lower bound should always be non-negative
     if ( fLowerBound < 0 )
@@ -672,25 +670,25 @@ String AbsoluteValueConstraint::serializeToString() const
 void AbsoluteValueConstraint::fixPhaseIfNeeded()
 {
     // Option 1: b's range is strictly positive
-    if ( _lowerBounds.exists( _b ) && _lowerBounds[_b] >= 0 )
+    if ( existsLowerBound( _b ) && getLowerBound( _b ) >= 0 )
     {
         setPhaseStatus( ABS_PHASE_POSITIVE );
         return;
     }
 
     // Option 2: b's range is strictly negative:
-    if ( _upperBounds.exists( _b ) && _upperBounds[_b] <= 0 )
+    if ( existsUpperBound( _b ) && getUpperBound( _b ) <= 0 )
     {
         setPhaseStatus( ABS_PHASE_NEGATIVE );
         return;
     }
 
-    if ( !_lowerBounds.exists( _f ) )
+    if ( !existsLowerBound( _f ) )
         return;
 
     // Option 3: f's range is strictly disjoint from b's positive
     // range
-    if ( _upperBounds.exists( _b ) && _lowerBounds[_f] > _upperBounds[_b] )
+    if ( existsUpperBound( _b ) && getLowerBound( _f ) > getUpperBound( _b ) )
     {
         setPhaseStatus( ABS_PHASE_NEGATIVE );
         return;
@@ -698,7 +696,7 @@ void AbsoluteValueConstraint::fixPhaseIfNeeded()
 
     // Option 4: f's range is strictly disjoint from b's negative
     // range, in absolute value
-    if ( _lowerBounds.exists( _b ) && _lowerBounds[_f] > -_lowerBounds[_b] )
+    if ( existsLowerBound( _b ) && getLowerBound( _f ) > -getLowerBound( _b ) )
     {
         setPhaseStatus( ABS_PHASE_POSITIVE );
         return;
@@ -707,28 +705,28 @@ void AbsoluteValueConstraint::fixPhaseIfNeeded()
     if ( _auxVarsInUse )
     {
         // Option 5: posAux has become zero, phase is positive
-        if ( _upperBounds.exists( _posAux ) && FloatUtils::isZero( _upperBounds[_posAux] ) )
+        if ( existsUpperBound( _posAux ) && FloatUtils::isZero( getUpperBound( _posAux ) ) )
         {
             setPhaseStatus( ABS_PHASE_POSITIVE );
             return;
         }
 
         // Option 6: posAux can never be zero, phase is negative
-        if ( _lowerBounds.exists( _posAux ) && FloatUtils::isPositive( _lowerBounds[_posAux] ) )
+        if ( existsLowerBound( _posAux ) && FloatUtils::isPositive( getLowerBound( _posAux ) ) )
         {
             setPhaseStatus( ABS_PHASE_NEGATIVE );
             return;
         }
 
         // Option 7: negAux has become zero, phase is negative
-        if ( _upperBounds.exists( _negAux ) && FloatUtils::isZero( _upperBounds[_negAux] ) )
+        if ( existsUpperBound( _negAux ) && FloatUtils::isZero( getUpperBound( _negAux ) ) )
         {
             setPhaseStatus( ABS_PHASE_NEGATIVE );
             return;
         }
 
         // Option 8: negAux can never be zero, phase is positive
-        if ( _lowerBounds.exists( _negAux ) && FloatUtils::isPositive( _lowerBounds[_negAux] ) )
+        if ( existsLowerBound( _negAux ) && FloatUtils::isPositive( getLowerBound( _negAux ) ) )
         {
             setPhaseStatus( ABS_PHASE_POSITIVE );
             return;
@@ -0,0 +1,117 @@
+/*********************                                                        */
+/*! \file BinaryQueryFormat.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** The binary query format's layout computation and header checks. The
+ ** section sizes are computed in 64 bits with overflow checks, because the
+ ** counts come from the (untrusted) file header.
+ **/
+
+#include "BinaryQueryFormat.h"
+#include "MStringf.h"
+#include "MarabouError.h"
+
+#include <string.h>
+
+const char BinaryQueryFormat::MAGIC[] = "MARABOUQ";
+const uint32_t BinaryQueryFormat::VERSION = 1;
+const uint32_t BinaryQueryFormat::BYTE_ORDER_MARK = 0x01020304;
+
+static uint64_t checkedAdd( uint64_t x, uint64_t y )
+{
+    if ( x > UINT64_MAX - y )
+        throw MarabouError( MarabouError::INVALID_BINARY_QUERY_FILE, "Section sizes overflow" );
+    return x + y;
+}
+
+/*
+  Return the offset of the section following one of count elements of
+  the given size, which starts at the given offset
+*/
+static uint64_t sectionEnd( uint64_t offset, uint64_t count, uint64_t elementSize )
+{
+    if ( count > UINT64_MAX / elementSize )
+        throw MarabouError( MarabouError::INVALID_BINARY_QUERY_FILE, "Section sizes overflow" );
+
+    uint64_t end = checkedAdd( offset, count * elementSize );
+    return checkedAdd( end, 7 ) & ~( (uint64_t)7 );
+}
+
+void BinaryQueryFormat::computeLayout( const Header &header, Layout &layout )
+{
+    uint64_t offset = sectionEnd( 0, 1, sizeof(Header) );
+
+    layout._inputVariables = offset;
+    offset = sectionEnd( offset, header._numInputVariables, sizeof(IndexedVariable) );
+
+    layout._outputVariables = offset;
+    offset = sectionEnd( offset, header._numOutputVariables, sizeof(IndexedVariable) );
+
+    layout._lowerBoundVariables = offset;
+    offset = sectionEnd( offset, header._numLowerBounds, sizeof(uint32_t) );
+    layout._lowerBoundValues = offset;
+    offset = sectionEnd( offset, header._numLowerBounds, sizeof(double) );
+
+    layout._upperBoundVariables = offset;
+    offset = sectionEnd( offset, header._numUpperBounds, sizeof(uint32_t) );
+    layout._upperBoundValues = offset;
+    offset = sectionEnd( offset, header._numUpperBounds, sizeof(double) );
+
+    layout._equations = offset;
+    offset = sectionEnd( offset, header._numEquations, sizeof(EquationRecord) );
+
+    layout._addendVariables = offset;
+    offset = sectionEnd( offset, header._numAddends, sizeof(uint32_t) );
+    layout._addendCoefficients = offset;
+    offset = sectionEnd( offset, header._numAddends, sizeof(double) );
+
+    layout._constraints = offset;
+    offset = sectionEnd( offset, header._numConstraints, sizeof(ConstraintRecord) );
+
+    layout._constraintData = offset;
+    layout._totalSize = checkedAdd( offset, header._constraintDataSize );
+}
+
+bool BinaryQueryFormat::rangeInBounds( uint64_t first, uint64_t count, uint64_t total )
+{
+    return first <= total && count <= total - first;
+}
+
+void BinaryQueryFormat::initializeHeader( Header &header )
+{
+    memset( &header, 0, sizeof(Header) );
+    memcpy( header._magic, MAGIC, MAGIC_LENGTH );
+    header._version = VERSION;
+    header._byteOrderMark = BYTE_ORDER_MARK;
+}
+
+bool BinaryQueryFormat::hasMagic( const char *data, uint64_t size )
+{
+    return size >= MAGIC_LENGTH && memcmp( data, MAGIC, MAGIC_LENGTH ) == 0;
+}
+
+void BinaryQueryFormat::checkHeader( const Header &header )
+{
+    if ( header._byteOrderMark != BYTE_ORDER_MARK )
+        throw MarabouError( MarabouError::INVALID_BINARY_QUERY_FILE,
+                            "Binary query was written with a different byte order" );
+
+    if ( header._version != VERSION )
+        throw MarabouError( MarabouError::INVALID_BINARY_QUERY_FILE,
+                            Stringf( "Unsupported binary query version: %u", header._version ).ascii() );
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
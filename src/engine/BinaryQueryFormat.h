@@ -0,0 +1,146 @@
+/*********************                                                        */
+/*! \file BinaryQueryFormat.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** The layout of binary query files. A file consists of a fixed-size
+ ** header, followed by the sections below, in this order. Every
+ ** section starts at an offset that is a multiple of 8 bytes, so that
+ ** a memory-mapped file can be read in place:
+ **
+ **   1. Input variables:  IndexedVariable[ numInputVariables ]
+ **   2. Output variables: IndexedVariable[ numOutputVariables ]
+ **   3. Lower bounds:     uint32_t variables[ numLowerBounds ],
+ **                        double values[ numLowerBounds ]
+ **   4. Upper bounds:     uint32_t variables[ numUpperBounds ],
+ **                        double values[ numUpperBounds ]
+ **   5. Equations:        EquationRecord[ numEquations ]
+ **   6. Addends:          uint32_t variables[ numAddends ],
+ **                        double coefficients[ numAddends ]
+ **   7. Constraints:      ConstraintRecord[ numConstraints ]
+ **   8. Constraint data:  char[ constraintDataSize ]
+ **
+ ** Each equation refers to a contiguous range of the addend arrays.
+ ** Each constraint refers to a range of the constraint data, which
+ ** holds the constraint's serialized form (the same one used by the
+ ** text format). All values are stored in the writer's byte order,
+ ** which is verified using the header's byte order mark.
+ **/
+
+#ifndef __BinaryQueryFormat_h__
+#define __BinaryQueryFormat_h__
+
+#include <cstdint>
+
+class BinaryQueryFormat
+{
+public:
+    static const char MAGIC[];
+    enum {
+        MAGIC_LENGTH = 8,
+    };
+
+    static const uint32_t VERSION;
+    static const uint32_t BYTE_ORDER_MARK;
+
+    struct Header
+    {
+        char _magic[MAGIC_LENGTH];
+        uint32_t _version;
+        uint32_t _byteOrderMark;
+        uint32_t _numberOfVariables;
+        uint32_t _numInputVariables;
+        uint32_t _numOutputVariables;
+        uint32_t _numLowerBounds;
+        uint32_t _numUpperBounds;
+        uint32_t _numEquations;
+        uint32_t _numConstraints;
+        uint32_t _reserved;
+        uint64_t _numAddends;
+        uint64_t _constraintDataSize;
+    };
+
+    struct IndexedVariable
+    {
+        uint32_t _index;
+        uint32_t _variable;
+    };
+
+    struct EquationRecord
+    {
+        uint32_t _type;
+        uint32_t _numAddends;
+        uint64_t _firstAddend;
+        double _scalar;
+    };
+
+    struct ConstraintRecord
+    {
+        uint64_t _offset;
+        uint64_t _length;
+    };
+
+    /*
+      The offsets of the sections within the file, in bytes
+    */
+    struct Layout
+    {
+        uint64_t _inputVariables;
+        uint64_t _outputVariables;
+        uint64_t _lowerBoundVariables;
+        uint64_t _lowerBoundValues;
+        uint64_t _upperBoundVariables;
+        uint64_t _upperBoundValues;
+        uint64_t _equations;
+        uint64_t _addendVariables;
+        uint64_t _addendCoefficients;
+        uint64_t _constraints;
+        uint64_t _constraintData;
+        uint64_t _totalSize;
+    };
+
+    /*
+      Compute the section offsets for the counts given in the header.
+      Throws if the file size would not fit in 64 bits.
+    */
+    static void computeLayout( const Header &header, Layout &layout );
+
+    /*
+      Return true iff the count elements starting at first are all
+      within [0, total), without risking an overflow
+    */
+    static bool rangeInBounds( uint64_t first, uint64_t count, uint64_t total );
+
+    /*
+      Initialize a header with the magic, version and byte order mark
+      (all counts are zero)
+    */
+    static void initializeHeader( Header &header );
+
+    /*
+      Return true iff the given file contents start with the binary
+      query magic
+    */
+    static bool hasMagic( const char *data, uint64_t size );
+
+    /*
+      Throw if the header's version or byte order are unsupported
+    */
+    static void checkHeader( const Header &header );
+};
+
+#endif // __BinaryQueryFormat_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
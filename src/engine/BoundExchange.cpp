@@ -0,0 +1,130 @@
+/*********************                                                        */
+/*! \file BoundExchange.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** Implementation of the bound exchange. Each participant has a buffer of
+ ** fixed capacity that only it writes to, and a read position into every
+ ** other participant's buffer. Publishing writes an entry and then
+ ** releases the buffer's new size; collecting acquires the sizes and reads
+ ** every entry from the previous read position up to them.
+
+ **/
+
+#include "BoundExchange.h"
+#include "Debug.h"
+#include "MarabouError.h"
+
+#include <algorithm>
+
+BoundExchange::BoundExchange( unsigned numberOfParticipants, unsigned capacity )
+    : _numberOfParticipants( numberOfParticipants )
+    , _capacity( capacity )
+    , _buffers( NULL )
+    , _readPositions( NULL )
+{
+    ASSERT( _numberOfParticipants > 0 );
+
+    _buffers = new Buffer[_numberOfParticipants];
+    if ( !_buffers )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "BoundExchange::buffers" );
+
+    for ( unsigned i = 0; i < _numberOfParticipants; ++i )
+    {
+        _buffers[i]._entries = new Entry[_capacity];
+        if ( !_buffers[i]._entries )
+            throw MarabouError( MarabouError::ALLOCATION_FAILED, "BoundExchange::entries" );
+        _buffers[i]._size = 0;
+    }
+
+    _readPositions = new unsigned[_numberOfParticipants * _numberOfParticipants];
+    if ( !_readPositions )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "BoundExchange::readPositions" );
+    std::fill_n( _readPositions, _numberOfParticipants * _numberOfParticipants, 0 );
+}
+
+BoundExchange::~BoundExchange()
+{
+    if ( _buffers )
+    {
+        for ( unsigned i = 0; i < _numberOfParticipants; ++i )
+            delete[] _buffers[i]._entries;
+
+        delete[] _buffers;
+        _buffers = NULL;
+    }
+
+    if ( _readPositions )
+    {
+        delete[] _readPositions;
+        _readPositions = NULL;
+    }
+}
+
+unsigned BoundExchange::getNumberOfParticipants() const
+{
+    return _numberOfParticipants;
+}
+
+bool BoundExchange::publish( unsigned participant, const Tightening &tightening )
+{
+    ASSERT( participant < _numberOfParticipants );
+
+    Buffer &buffer = _buffers[participant];
+
+    // Only this participant writes to its buffer
+    unsigned size = buffer._size.load( std::memory_order_relaxed );
+    if ( size == _capacity )
+        return false;
+
+    Entry &entry = buffer._entries[size];
+    entry._variable = tightening._variable;
+    entry._value = tightening._value;
+    entry._type = tightening._type;
+
+    // Make the entry visible to the readers only once it is complete
+    buffer._size.store( size + 1, std::memory_order_release );
+    return true;
+}
+
+void BoundExchange::collect( unsigned participant, List<Tightening> &tightenings )
+{
+    ASSERT( participant < _numberOfParticipants );
+
+    unsigned *readPositions = _readPositions + participant * _numberOfParticipants;
+    for ( unsigned writer = 0; writer < _numberOfParticipants; ++writer )
+    {
+        if ( writer == participant )
+            continue;
+
+        const Buffer &buffer = _buffers[writer];
+        unsigned size = buffer._size.load( std::memory_order_acquire );
+        for ( unsigned i = readPositions[writer]; i < size; ++i )
+        {
+            const Entry &entry = buffer._entries[i];
+            tightenings.append( Tightening( entry._variable, entry._value, entry._type ) );
+        }
+
+        readPositions[writer] = size;
+    }
+}
+
+unsigned BoundExchange::getNumPublished( unsigned participant ) const
+{
+    ASSERT( participant < _numberOfParticipants );
+    return _buffers[participant]._size.load( std::memory_order_acquire );
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
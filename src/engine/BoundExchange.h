@@ -0,0 +1,96 @@
+/*********************                                                        */
+/*! \file BoundExchange.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** A channel through which engines that solve the same (preprocessed)
+ ** query share the bound tightenings they derive at the root of their
+ ** search trees, which hold globally.
+ **
+ ** Each participant publishes into its own append-only buffer and reads
+ ** the buffers of the others. Every buffer has a single writer, which
+ ** fills an entry and only then advances the buffer's atomic size, so
+ ** no locks are needed. Once a participant's buffer is full, its further
+ ** tightenings are dropped.
+ **/
+
+#ifndef __BoundExchange_h__
+#define __BoundExchange_h__
+
+#include "List.h"
+#include "Tightening.h"
+
+#include <atomic>
+
+class BoundExchange
+{
+public:
+    BoundExchange( unsigned numberOfParticipants, unsigned capacity );
+    ~BoundExchange();
+
+    unsigned getNumberOfParticipants() const;
+
+    /*
+      Publish a tightening on behalf of a participant. Returns false if
+      the participant's buffer is full, in which case the tightening is
+      dropped.
+    */
+    bool publish( unsigned participant, const Tightening &tightening );
+
+    /*
+      Append to the list the tightenings published by the other
+      participants since the participant's previous call. Only the
+      participant itself may collect on its behalf.
+    */
+    void collect( unsigned participant, List<Tightening> &tightenings );
+
+    /*
+      The number of tightenings published by a participant.
+    */
+    unsigned getNumPublished( unsigned participant ) const;
+
+private:
+    struct Entry
+    {
+        unsigned _variable;
+        double _value;
+        Tightening::BoundType _type;
+    };
+
+    struct Buffer
+    {
+        Entry *_entries;
+
+        /*
+          The number of entries that are ready to be read
+        */
+        std::atomic_uint _size;
+    };
+
+    unsigned _numberOfParticipants;
+    unsigned _capacity;
+    Buffer *_buffers;
+
+    /*
+      For each reader and writer, the number of entries of the writer's
+      buffer that the reader has already collected. Row i is only
+      accessed by participant i.
+    */
+    unsigned *_readPositions;
+};
+
+#endif // __BoundExchange_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,259 @@
+/*********************                                                        */
+/*! \file ClauseDatabase.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include "ClauseDatabase.h"
+#include "Debug.h"
+
+ClauseDatabase::ClauseDatabase()
+{
+}
+
+ClauseDatabase::~ClauseDatabase()
+{
+    clear();
+}
+
+void ClauseDatabase::addClause( const List<PhaseLiteral> &phases )
+{
+    ASSERT( !phases.empty() );
+
+    Clause *clause = new Clause;
+    for ( const auto &phase : phases )
+    {
+        ASSERT( phase.known() );
+        clause->append( phase );
+    }
+
+    _clauses.append( clause );
+    watch( clause );
+    scheduleCheck( clause );
+}
+
+bool ClauseDatabase::assertPhase( const PhaseLiteral &phase, List<PhaseLiteral> &refutedPhases )
+{
+    ASSERT( phase.known() );
+    _assertedPhases[phase._constraint] = phase._phase;
+
+    if ( !_watches.exists( phase._constraint ) )
+        return true;
+
+    bool consistent = true;
+    List<Clause *> &watchingClauses = _watches[phase._constraint];
+    auto it = watchingClauses.begin();
+    while ( it != watchingClauses.end() )
+    {
+        Clause &clause = **it;
+
+        if ( clause.size() == 1 )
+        {
+            if ( clause[0] == phase )
+            {
+                _violatedClause = clause;
+                consistent = false;
+            }
+
+            ++it;
+            continue;
+        }
+
+        // Make the phase of the asserted constraint the second one
+        if ( clause[0]._constraint == phase._constraint )
+        {
+            PhaseLiteral temp = clause[0];
+            clause[0] = clause[1];
+            clause[1] = temp;
+        }
+        ASSERT( clause[1]._constraint == phase._constraint );
+
+        // A contradicted phase does not affect the clause, and a
+        // clause with a contradicted phase is satisfied
+        if ( !( clause[1] == phase ) || contradicted( clause[0] ) )
+        {
+            ++it;
+            continue;
+        }
+
+        // Look for another phase to watch
+        bool replaced = false;
+        for ( unsigned i = 2; i < clause.size(); ++i )
+        {
+            if ( !holds( clause[i] ) )
+            {
+                PhaseLiteral temp = clause[1];
+                clause[1] = clause[i];
+                clause[i] = temp;
+
+                _watches[clause[1]._constraint].append( *it );
+                it = watchingClauses.erase( it );
+                replaced = true;
+                break;
+            }
+        }
+
+        if ( replaced )
+            continue;
+
+        // All phases but the first watched one hold
+        if ( holds( clause[0] ) )
+        {
+            _violatedClause = clause;
+            consistent = false;
+        }
+        else
+            refutedPhases.append( clause[0] );
+
+        ++it;
+    }
+
+    return consistent;
+}
+
+void ClauseDatabase::retractPhase( PiecewiseLinearConstraint *constraint )
+{
+    if ( _assertedPhases.exists( constraint ) )
+        _assertedPhases.erase( constraint );
+
+    // The watched phases of these clauses may no longer be the ones
+    // that hold last
+    if ( _watches.exists( constraint ) )
+    {
+        for ( const auto &clause : _watches[constraint] )
+            scheduleCheck( clause );
+    }
+}
+
+bool ClauseDatabase::propagate( List<PhaseLiteral> &refutedPhases )
+{
+    bool consistent = true;
+    for ( const auto &clause : _clausesToCheck )
+    {
+        if ( !checkClause( clause, refutedPhases ) )
+            consistent = false;
+    }
+
+    _clausesToCheck.clear();
+    _scheduledClauses.clear();
+
+    return consistent;
+}
+
+const Vector<PhaseLiteral> &ClauseDatabase::getViolatedClause() const
+{
+    return _violatedClause;
+}
+
+bool ClauseDatabase::hasAssertedPhase( PiecewiseLinearConstraint *constraint ) const
+{
+    return _assertedPhases.exists( constraint );
+}
+
+bool ClauseDatabase::holds( const PhaseLiteral &phase ) const
+{
+    return _assertedPhases.exists( phase._constraint ) &&
+        _assertedPhases[phase._constraint] == phase._phase;
+}
+
+bool ClauseDatabase::contradicted( const PhaseLiteral &phase ) const
+{
+    return _assertedPhases.exists( phase._constraint ) &&
+        _assertedPhases[phase._constraint] != phase._phase;
+}
+
+unsigned ClauseDatabase::getNumClauses() const
+{
+    return _clauses.size();
+}
+
+void ClauseDatabase::clear()
+{
+    for ( auto &clause : _clauses )
+        delete clause;
+
+    _clauses.clear();
+    _watches.clear();
+    _assertedPhases.clear();
+    _clausesToCheck.clear();
+    _scheduledClauses.clear();
+    _violatedClause.clear();
+}
+
+void ClauseDatabase::watch( Clause *clause )
+{
+    _watches[( *clause )[0]._constraint].append( clause );
+    if ( clause->size() > 1 )
+        _watches[( *clause )[1]._constraint].append( clause );
+}
+
+void ClauseDatabase::unwatch( Clause *clause )
+{
+    _watches[( *clause )[0]._constraint].erase( clause );
+    if ( clause->size() > 1 )
+        _watches[( *clause )[1]._constraint].erase( clause );
+}
+
+void ClauseDatabase::scheduleCheck( Clause *clause )
+{
+    if ( _scheduledClauses.exists( clause ) )
+        return;
+
+    _scheduledClauses.insert( clause );
+    _clausesToCheck.append( clause );
+}
+
+bool ClauseDatabase::checkClause( Clause *clause, List<PhaseLiteral> &refutedPhases )
+{
+    unwatch( clause );
+
+    // Order the phases: contradicted ones first, then those of
+    // constraints without an asserted phase, then those that hold.
+    // The first two are watched.
+    Clause contradictedPhases;
+    Clause openPhases;
+    Clause holdingPhases;
+    for ( const auto &phase : *clause )
+    {
+        if ( contradicted( phase ) )
+            contradictedPhases.append( phase );
+        else if ( holds( phase ) )
+            holdingPhases.append( phase );
+        else
+            openPhases.append( phase );
+    }
+
+    *clause = contradictedPhases + openPhases + holdingPhases;
+    watch( clause );
+
+    if ( !contradictedPhases.empty() )
+        return true;
+
+    if ( openPhases.empty() )
+    {
+        _violatedClause = *clause;
+        return false;
+    }
+
+    if ( openPhases.size() == 1 )
+        refutedPhases.append( openPhases[0] );
+
+    return true;
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,140 @@
+/*********************                                                        */
+/*! \file ClauseDatabase.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** A database of clauses learned from conflicts. Each clause is a set
+ ** of phases of piecewise-linear constraints that cannot all hold at the
+ ** same time. The SMT core asserts the phases of its case splits, and
+ ** the database reports the phases that are refuted as a result: those
+ ** of clauses in which all other phases hold.
+ **
+ ** Clauses are propagated with two watched phases per clause. Unless a
+ ** clause is satisfied (one of its phases is contradicted by the phase
+ ** asserted for the same constraint) or unit, its watched phases do not
+ ** hold, so asserting a phase only requires visiting the clauses that
+ ** watch the phase's constraint. Retracting a phase, when backtracking,
+ ** schedules the clauses that watch its constraint to be checked again.
+
+**/
+
+#ifndef __ClauseDatabase_h__
+#define __ClauseDatabase_h__
+
+#include "HashSet.h"
+#include "List.h"
+#include "Map.h"
+#include "PhaseLiteral.h"
+#include "Vector.h"
+
+class ClauseDatabase
+{
+public:
+    ClauseDatabase();
+    ~ClauseDatabase();
+
+    /*
+      Add a clause, given as phases of distinct constraints that cannot
+      all hold at the same time. The clause is checked by the next call
+      to propagate().
+    */
+    void addClause( const List<PhaseLiteral> &phases );
+
+    /*
+      Assert the phase of a constraint. Every clause in which all
+      phases but one now hold, and the remaining phase belongs to a
+      constraint without an asserted phase, refutes that phase: it is
+      appended to refutedPhases. Returns false if all the phases of
+      some clause hold.
+    */
+    bool assertPhase( const PhaseLiteral &phase, List<PhaseLiteral> &refutedPhases );
+
+    /*
+      Retract the asserted phase of a constraint.
+    */
+    void retractPhase( PiecewiseLinearConstraint *constraint );
+
+    /*
+      Check the clauses that were added, or whose watched constraints
+      were retracted, since the last call. Reports refuted phases and
+      violated clauses like assertPhase().
+    */
+    bool propagate( List<PhaseLiteral> &refutedPhases );
+
+    /*
+      After assertPhase() or propagate() return false: the phases of
+      the violated clause.
+    */
+    const Vector<PhaseLiteral> &getViolatedClause() const;
+
+    /*
+      Information about the asserted phases.
+    */
+    bool hasAssertedPhase( PiecewiseLinearConstraint *constraint ) const;
+    bool holds( const PhaseLiteral &phase ) const;
+
+    unsigned getNumClauses() const;
+
+    /*
+      Discard all clauses and asserted phases.
+    */
+    void clear();
+
+private:
+    /*
+      The phases of a clause. The first two are the watched ones.
+    */
+    typedef Vector<PhaseLiteral> Clause;
+
+    List<Clause *> _clauses;
+
+    /*
+      The clauses watching each constraint.
+    */
+    Map<PiecewiseLinearConstraint *, List<Clause *>> _watches;
+
+    /*
+      The asserted phase of each constraint.
+    */
+    Map<PiecewiseLinearConstraint *, PhaseStatus> _assertedPhases;
+
+    /*
+      Clauses to be checked by the next call to propagate().
+    */
+    List<Clause *> _clausesToCheck;
+    HashSet<Clause *> _scheduledClauses;
+
+    Clause _violatedClause;
+
+    /*
+      A phase is contradicted if another phase is asserted for its
+      constraint.
+    */
+    bool contradicted( const PhaseLiteral &phase ) const;
+
+    void watch( Clause *clause );
+    void unwatch( Clause *clause );
+    void scheduleCheck( Clause *clause );
+
+    /*
+      Choose the watched phases of a clause from scratch, and report
+      whether it is unit or violated.
+    */
+    bool checkClause( Clause *clause, List<PhaseLiteral> &refutedPhases );
+};
+
+#endif // __ClauseDatabase_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -121,6 +121,26 @@ void ConstraintBoundTightener::notifyUpperBound( unsigned variable, double bound
     }
 }
 
+void ConstraintBoundTightener::notifyBounds( const ITableau::BoundUpdates &updates )
+{
+    for ( const auto &variable : updates._variables )
+    {
+        if ( ( updates._changed[variable] & ITableau::BoundUpdates::LOWER ) &&
+             updates._lowerBounds[variable] > _lowerBounds[variable] )
+        {
+            _lowerBounds[variable] = updates._lowerBounds[variable];
+            _tightenedLower[variable] = false;
+        }
+
+        if ( ( updates._changed[variable] & ITableau::BoundUpdates::UPPER ) &&
+             updates._upperBounds[variable] < _upperBounds[variable] )
+        {
+            _upperBounds[variable] = updates._upperBounds[variable];
+            _tightenedUpper[variable] = false;
+        }
+    }
+}
+
 void ConstraintBoundTightener::notifyDimensionChange( unsigned /* m */ , unsigned /* n */ )
 {
     setDimensions();
@@ -45,6 +45,7 @@ public:
     */
     void notifyLowerBound( unsigned variable, double bound );
     void notifyUpperBound( unsigned variable, double bound );
+    void notifyBounds( const ITableau::BoundUpdates &updates );
 
     /*
       Have the Bound Tightener start reporting statistics.
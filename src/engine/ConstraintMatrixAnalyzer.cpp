@@ -121,6 +121,24 @@ void ConstraintMatrixAnalyzer::analyze( const SparseUnsortedList **matrix,
     gaussianElimination();
 }
 
+void ConstraintMatrixAnalyzer::analyze( const SparseUnsortedArrays *matrix,
+                                        unsigned m,
+                                        unsigned n )
+{
+    freeMemoryIfNeeded();
+
+    _m = m;
+    _n = n;
+
+    matrix->storeIntoOther( &_A );
+    _A.transposeIntoOther( &_At );
+
+    allocateMemory();
+
+    // Perform the actual Gaussian elimination
+    gaussianElimination();
+}
+
 void ConstraintMatrixAnalyzer::allocateMemory()
 {
     // Initialize the row and column headers
@@ -0,0 +1,176 @@
+/*********************                                                        */
+/*! \file ConstraintStateTrail.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include "ConstraintStateTrail.h"
+#include "Debug.h"
+#include "PiecewiseLinearConstraint.h"
+
+ConstraintStateTrail::ConstraintStateTrail()
+    : _recording( false )
+    , _levelStart( 0 )
+{
+}
+
+ConstraintStateTrail::~ConstraintStateTrail()
+{
+    clear();
+    freeSpareStates();
+}
+
+void ConstraintStateTrail::initialize( const List<PiecewiseLinearConstraint *> &constraints )
+{
+    clear();
+    freeSpareStates();
+    _constraints.clear();
+    _variableToConstraints.clear();
+
+    for ( const auto &constraint : constraints )
+        _constraints.insert( constraint );
+
+    for ( const auto &constraint : constraints )
+        for ( unsigned variable : constraint->getParticipatingVariables() )
+            _variableToConstraints[variable].append( constraint );
+}
+
+void ConstraintStateTrail::setRecording( bool recording )
+{
+    _recording = recording;
+}
+
+bool ConstraintStateTrail::recording() const
+{
+    return _recording;
+}
+
+unsigned ConstraintStateTrail::getSize() const
+{
+    return _trail.size();
+}
+
+void ConstraintStateTrail::startLevel()
+{
+    _levelStart = _trail.size();
+}
+
+void ConstraintStateTrail::saveConstraint( PiecewiseLinearConstraint *constraint )
+{
+    // Constraints that are not tracked, e.g. the temporary disjunctions
+    // used for interval splitting, are not part of the engine state
+    if ( !_recording || !_constraints.exists( constraint ) )
+        return;
+
+    unsigned previousPosition = NOT_SAVED;
+    if ( _lastPosition.exists( constraint ) )
+    {
+        previousPosition = _lastPosition[constraint];
+
+        // Already saved in this decision level
+        if ( previousPosition >= _levelStart )
+            return;
+    }
+
+    TrailEntry entry;
+    entry._constraint = constraint;
+    if ( _spareStates.exists( constraint ) && !_spareStates[constraint].empty() )
+    {
+        entry._savedState = _spareStates[constraint].pop();
+        entry._savedState->restoreState( constraint );
+    }
+    else
+        entry._savedState = constraint->duplicateConstraint();
+    entry._previousPosition = previousPosition;
+
+    _lastPosition[constraint] = _trail.size();
+    _trail.append( entry );
+}
+
+void ConstraintStateTrail::undo( unsigned position, List<PiecewiseLinearConstraint *> &restoredConstraints )
+{
+    ASSERT( position <= _trail.size() );
+
+    while ( _trail.size() > position )
+    {
+        TrailEntry entry = _trail.pop();
+        entry._constraint->restoreState( entry._savedState );
+        _spareStates[entry._constraint].append( entry._savedState );
+
+        if ( entry._previousPosition == NOT_SAVED )
+            _lastPosition.erase( entry._constraint );
+        else
+            _lastPosition[entry._constraint] = entry._previousPosition;
+
+        restoredConstraints.append( entry._constraint );
+    }
+
+    _levelStart = position;
+}
+
+void ConstraintStateTrail::clear()
+{
+    for ( auto &entry : _trail )
+        delete entry._savedState;
+
+    _trail.clear();
+    _lastPosition.clear();
+    _levelStart = 0;
+    _recording = false;
+}
+
+void ConstraintStateTrail::freeSpareStates()
+{
+    for ( auto &spareStates : _spareStates )
+    {
+        for ( auto &state : spareStates.second )
+            delete state;
+    }
+
+    _spareStates.clear();
+}
+
+void ConstraintStateTrail::notifyLowerBound( unsigned variable, double /* bound */ )
+{
+    saveConstraintsOfVariable( variable );
+}
+
+void ConstraintStateTrail::notifyUpperBound( unsigned variable, double /* bound */ )
+{
+    saveConstraintsOfVariable( variable );
+}
+
+void ConstraintStateTrail::notifyBounds( const ITableau::BoundUpdates &updates )
+{
+    if ( !_recording )
+        return;
+
+    for ( const auto &variable : updates._variables )
+        saveConstraintsOfVariable( variable );
+}
+
+void ConstraintStateTrail::saveConstraintsOfVariable( unsigned variable )
+{
+    if ( !_recording || !_variableToConstraints.exists( variable ) )
+        return;
+
+    for ( const auto &constraint : _variableToConstraints[variable] )
+        saveConstraint( constraint );
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,148 @@
+/*********************                                                        */
+/*! \file ConstraintStateTrail.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** An undo trail for the states of the piecewise-linear constraints.
+ ** Instead of duplicating every constraint whenever the engine state is
+ ** stored, a constraint is duplicated only the first time it is about to
+ ** change after the most recent decision level began. Rolling the trail
+ ** back to a position restores exactly the constraints that changed since.
+ **
+ ** Constraint states change mostly when the tableau notifies them of new
+ ** bounds. The trail registers as a global watcher of the tableau, which
+ ** is notified before the per-variable watchers, and saves the
+ ** constraints that participate in the variable. Other changes (e.g.,
+ ** disabling a constraint) must be preceded by an explicit call to
+ ** saveConstraint().
+
+**/
+
+#ifndef __ConstraintStateTrail_h__
+#define __ConstraintStateTrail_h__
+
+#include "HashMap.h"
+#include "HashSet.h"
+#include "ITableau.h"
+#include "List.h"
+#include "Vector.h"
+
+class PiecewiseLinearConstraint;
+
+class ConstraintStateTrail : public ITableau::VariableWatcher
+{
+public:
+    ConstraintStateTrail();
+    ~ConstraintStateTrail();
+
+    /*
+      Set the constraints to be tracked.
+    */
+    void initialize( const List<PiecewiseLinearConstraint *> &constraints );
+
+    /*
+      Turn recording on/off.
+    */
+    void setRecording( bool recording );
+    bool recording() const;
+
+    /*
+      The current size of the trail.
+    */
+    unsigned getSize() const;
+
+    /*
+      Begin a new decision level at the current end of the trail.
+    */
+    void startLevel();
+
+    /*
+      Save the state of a tracked constraint on the trail, unless it has
+      already been saved since the current decision level began.
+    */
+    void saveConstraint( PiecewiseLinearConstraint *constraint );
+
+    /*
+      Restore the states of all constraints saved after the given
+      position, and make that position the beginning of the current
+      decision level. The restored constraints are placed in
+      restoredConstraints.
+    */
+    void undo( unsigned position, List<PiecewiseLinearConstraint *> &restoredConstraints );
+
+    /*
+      Discard the trail and stop recording.
+    */
+    void clear();
+
+    /*
+      Callbacks from the tableau.
+    */
+    void notifyLowerBound( unsigned variable, double bound );
+    void notifyUpperBound( unsigned variable, double bound );
+    void notifyBounds( const ITableau::BoundUpdates &updates );
+
+private:
+    struct TrailEntry
+    {
+        PiecewiseLinearConstraint *_constraint;
+        PiecewiseLinearConstraint *_savedState;
+
+        /*
+          The position of the previous entry of the same constraint,
+          or NOT_SAVED if there is none.
+        */
+        unsigned _previousPosition;
+    };
+
+    enum {
+        NOT_SAVED = 0xFFFFFFFF,
+    };
+
+    bool _recording;
+    Vector<TrailEntry> _trail;
+
+    /*
+      The position in the trail at which the current decision level
+      began.
+    */
+    unsigned _levelStart;
+
+    /*
+      The position of the most recent entry of each constraint.
+    */
+    HashMap<PiecewiseLinearConstraint *, unsigned> _lastPosition;
+
+    /*
+      The tracked constraints, and the constraints in which each variable
+      participates.
+    */
+    HashSet<PiecewiseLinearConstraint *> _constraints;
+    HashMap<unsigned, List<PiecewiseLinearConstraint *>> _variableToConstraints;
+
+    /*
+      Saved states that have been rolled back, kept for reuse by later
+      saves of the same constraint instead of being freed.
+    */
+    HashMap<PiecewiseLinearConstraint *, Vector<PiecewiseLinearConstraint *>> _spareStates;
+
+    void freeSpareStates();
+
+    void saveConstraintsOfVariable( unsigned variable );
+};
+
+#endif // __ConstraintStateTrail_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
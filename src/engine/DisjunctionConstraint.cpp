@@ -56,6 +56,7 @@ ContextDependentPiecewiseLinearConstraint *DisjunctionConstraint::duplicateConst
     DisjunctionConstraint *clone = new DisjunctionConstraint( _disjuncts );
     *clone = *this;
     initializeDuplicateCDOs( clone );
+    copyBoundsToDuplicate( clone );
     return clone;
 }
 
@@ -66,10 +67,12 @@ void DisjunctionConstraint::restoreState( const PiecewiseLinearConstraint *state
     CVC4::context::CDO<bool> *activeStatus = _cdConstraintActive;
     CVC4::context::CDO<PhaseStatus> *phaseStatus = _cdPhaseStatus;
     CVC4::context::CDList<PhaseStatus> *infeasibleCases = _cdInfeasibleCases;
+    const ITableau *boundStore = _boundStore;
     *this = *disjunction;
     _cdConstraintActive = activeStatus;
     _cdPhaseStatus = phaseStatus;
     _cdInfeasibleCases = infeasibleCases;
+    _boundStore = boundStore;
 }
 
 void DisjunctionConstraint::registerAsWatcher( ITableau *tableau )
@@ -94,11 +97,9 @@ void DisjunctionConstraint::notifyLowerBound( unsigned variable, double bound )
     if ( _statistics )
         _statistics->incNumBoundNotificationsPlConstraints();
 
-    if ( _lowerBounds.exists( variable ) && !FloatUtils::gt( bound, _lowerBounds[variable] ) )
+    if ( !updateLowerBound( variable, bound ) )
         return;
 
-    _lowerBounds[variable] = bound;
-
     updateFeasibleDisjuncts();
 }
 
@@ -107,11 +108,9 @@ void DisjunctionConstraint::notifyUpperBound( unsigned variable, double bound )
     if ( _statistics )
         _statistics->incNumBoundNotificationsPlConstraints();
 
-    if ( _upperBounds.exists( variable ) && !FloatUtils::lt( bound, _upperBounds[variable] ) )
+    if ( !updateUpperBound( variable, bound ) )
         return;
 
-    _upperBounds[variable] = bound;
-
     updateFeasibleDisjuncts();
 }
 
@@ -329,14 +328,14 @@ bool DisjunctionConstraint::caseSplitIsFeasible( const PiecewiseLinearCaseSplit
     {
         if ( bound._type == Tightening::LB )
         {
-            if ( _upperBounds.exists( bound._variable ) &&
-                 _upperBounds[bound._variable] < bound._value )
+            if ( existsUpperBound( bound._variable ) &&
+                 getUpperBound( bound._variable ) < bound._value )
                 return false;
         }
         else
         {
-            if ( _lowerBounds.exists( bound._variable ) &&
-                 _lowerBounds[bound._variable] > bound._value )
+            if ( existsLowerBound( bound._variable ) &&
+                 getLowerBound( bound._variable ) > bound._value )
                 return false;
         }
     }
@@ -0,0 +1,114 @@
+/*********************                                                        */
+/*! \file DnCBoundStore.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "Debug.h"
+#include "DnCBoundStore.h"
+#include "MarabouError.h"
+
+#include <cstring>
+
+DnCBoundStore::DnCBoundStore( unsigned numberOfWorkers, unsigned capacity )
+    : _numberOfWorkers( numberOfWorkers )
+    , _capacity( capacity )
+    , _buffers( NULL )
+{
+    ASSERT( _numberOfWorkers > 0 );
+
+    _buffers = new Buffer[_numberOfWorkers];
+    if ( !_buffers )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "DnCBoundStore::buffers" );
+
+    for ( unsigned i = 0; i < _numberOfWorkers; ++i )
+    {
+        _buffers[i]._entries = new Entry[_capacity];
+        if ( !_buffers[i]._entries )
+            throw MarabouError( MarabouError::ALLOCATION_FAILED, "DnCBoundStore::entries" );
+        _buffers[i]._size = 0;
+    }
+}
+
+DnCBoundStore::~DnCBoundStore()
+{
+    if ( _buffers )
+    {
+        for ( unsigned i = 0; i < _numberOfWorkers; ++i )
+            delete[] _buffers[i]._entries;
+
+        delete[] _buffers;
+        _buffers = NULL;
+    }
+}
+
+bool DnCBoundStore::publish( unsigned worker, const String &queryId, const Tightening &tightening )
+{
+    ASSERT( worker < _numberOfWorkers );
+
+    Buffer &buffer = _buffers[worker];
+
+    // Only this worker writes to its buffer
+    unsigned size = buffer._size.load( std::memory_order_relaxed );
+    if ( size == _capacity )
+        return false;
+
+    Entry &entry = buffer._entries[size];
+    entry._queryId = queryId;
+    entry._variable = tightening._variable;
+    entry._value = tightening._value;
+    entry._type = tightening._type;
+
+    // Make the entry visible to the readers only once it is complete
+    buffer._size.store( size + 1, std::memory_order_release );
+    return true;
+}
+
+void DnCBoundStore::getTightenings( const String &queryId, List<Tightening> &tightenings ) const
+{
+    for ( unsigned worker = 0; worker < _numberOfWorkers; ++worker )
+    {
+        const Buffer &buffer = _buffers[worker];
+        unsigned size = buffer._size.load( std::memory_order_acquire );
+        for ( unsigned i = 0; i < size; ++i )
+        {
+            const Entry &entry = buffer._entries[i];
+            if ( isAncestor( entry._queryId, queryId ) )
+                tightenings.append( Tightening( entry._variable, entry._value, entry._type ) );
+        }
+    }
+}
+
+unsigned DnCBoundStore::getNumPublished( unsigned worker ) const
+{
+    ASSERT( worker < _numberOfWorkers );
+    return _buffers[worker]._size.load( std::memory_order_acquire );
+}
+
+bool DnCBoundStore::isAncestor( const String &ancestorId, const String &queryId )
+{
+    // The id of a child is that of its parent, followed by "-" and an index
+    unsigned length = ancestorId.length();
+    return
+        length > 0 &&
+        queryId.length() > length &&
+        queryId[length] == '-' &&
+        strncmp( ancestorId.ascii(), queryId.ascii(), length ) == 0;
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,92 @@
+/*********************                                                        */
+/*! \file DnCBoundStore.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** A store through which DnC workers share the bound tightenings they
+ ** derive at the root of a subquery. Such a tightening holds throughout
+ ** the region of the subquery, and so for all of its descendants: a
+ ** subquery's id extends the id of its parent (e.g., "2-1-3" is a
+ ** descendant of "2" and of "2-1"). Each tightening is therefore keyed
+ ** by the id of the subquery it was derived in, and a worker about to
+ ** solve a subquery picks up the tightenings keyed by the subquery's
+ ** ancestors.
+ **
+ ** As in the BoundExchange, each worker publishes into its own
+ ** append-only buffer, so no locks are needed.
+ **/
+
+#ifndef __DnCBoundStore_h__
+#define __DnCBoundStore_h__
+
+#include "List.h"
+#include "MString.h"
+#include "Tightening.h"
+
+#include <atomic>
+
+class DnCBoundStore
+{
+public:
+    DnCBoundStore( unsigned numberOfWorkers, unsigned capacity );
+    ~DnCBoundStore();
+
+    /*
+      Publish a tightening that holds in the region of the given
+      subquery, on behalf of a worker. Returns false if the worker's
+      buffer is full, in which case the tightening is dropped.
+    */
+    bool publish( unsigned worker, const String &queryId, const Tightening &tightening );
+
+    /*
+      Append to the list the tightenings published for the proper
+      ancestors of the given subquery.
+    */
+    void getTightenings( const String &queryId, List<Tightening> &tightenings ) const;
+
+    unsigned getNumPublished( unsigned worker ) const;
+
+    /*
+      Whether the first subquery is a proper ancestor of the second
+    */
+    static bool isAncestor( const String &ancestorId, const String &queryId );
+
+private:
+    struct Entry
+    {
+        String _queryId;
+        unsigned _variable;
+        double _value;
+        Tightening::BoundType _type;
+    };
+
+    struct Buffer
+    {
+        Entry *_entries;
+
+        /*
+          The number of entries that are ready to be read
+        */
+        std::atomic_uint _size;
+    };
+
+    unsigned _numberOfWorkers;
+    unsigned _capacity;
+    Buffer *_buffers;
+};
+
+#endif // __DnCBoundStore_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -33,13 +33,15 @@
 #include <cmath>
 #include <thread>
 
-void DnCManager::dncSolve( WorkerQueue *workload, std::shared_ptr<Engine> engine,
+void DnCManager::dncSolve( WorkStealingQueue *workload, DnCBoundStore *boundStore,
+                           std::shared_ptr<Engine> engine,
                            std::unique_ptr<InputQuery> inputQuery,
                            std::atomic_uint &numUnsolvedSubQueries,
                            std::atomic_bool &shouldQuitSolving,
                            unsigned threadId, unsigned onlineDivides,
                            float timeoutFactor, SnCDivideStrategy divideStrategy,
-                           bool restoreTreeStates, unsigned verbosity )
+                           bool restoreTreeStates, bool adaptiveScheduling,
+                           unsigned verbosity, Statistics *statistics )
 {
     unsigned cpuId = 0;
     (void) threadId;
@@ -52,7 +54,8 @@ void DnCManager::dncSolve( WorkerQueue *workload, std::shared_ptr<Engine> engine
 
     DnCWorker worker( workload, engine, std::ref( numUnsolvedSubQueries ),
                       std::ref( shouldQuitSolving ), threadId, onlineDivides,
-                      timeoutFactor, divideStrategy, verbosity );
+                      timeoutFactor, divideStrategy, verbosity, boundStore,
+                      adaptiveScheduling, statistics );
     while ( !shouldQuitSolving.load() )
     {
         worker.popOneSubQueryAndSolve( restoreTreeStates );
@@ -63,6 +66,7 @@ DnCManager::DnCManager( InputQuery *inputQuery )
     : _baseInputQuery( inputQuery )
     , _exitCode( DnCManager::NOT_DONE )
     , _workload( NULL )
+    , _boundStore( NULL )
     , _timeoutReached( false )
     , _numUnsolvedSubQueries( 0 )
     , _verbosity( Options::get()->getInt( Options::VERBOSITY ) )
@@ -96,16 +100,16 @@ void DnCManager::freeMemoryIfNeeded()
 {
     if ( _workload )
     {
-        SubQuery *subQuery = NULL;
-        while ( !_workload->empty() )
-        {
-            _workload->pop( subQuery );
-            delete subQuery;
-        }
-
+        // Any remaining subqueries are deleted by the queue
         delete _workload;
         _workload = NULL;
     }
+
+    if ( _boundStore )
+    {
+        delete _boundStore;
+        _boundStore = NULL;
+    }
 }
 
 void DnCManager::solve()
@@ -134,46 +138,55 @@ void DnCManager::solve()
     for ( unsigned i = 0; i < numWorkers; ++i )
         quitThreads.append( _engines[i]->getQuitRequested() );
 
-    // Partition the input query into initial subqueries, and place these
-    // queries in the queue
-    _workload = new WorkerQueue( 0 );
+    // Partition the input query into initial subqueries, and distribute
+    // these queries among the deques of the workers in a round-robin fashion
+    _workload = new WorkStealingQueue( numWorkers );
     if ( !_workload )
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "DnCManager::workload" );
 
+    _boundStore = new DnCBoundStore( numWorkers, GlobalConfiguration::DNC_BOUND_STORE_CAPACITY );
+    if ( !_boundStore )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "DnCManager::boundStore" );
+
     SubQueries subQueries;
     initialDivide( subQueries );
 
     // Create objects shared across workers
     _numUnsolvedSubQueries = subQueries.size();
     std::atomic_bool shouldQuitSolving( false );
-    WorkerQueue *workload = new WorkerQueue( 0 );
+    unsigned workerId = 0;
     for ( auto &subQuery : subQueries )
     {
-        if ( !workload->push( subQuery ) )
+        if ( !_workload->push( workerId, subQuery ) )
         {
             // This should never happen
             ASSERT( false );
         }
+        workerId = ( workerId + 1 ) % numWorkers;
     }
 
     unsigned onlineDivides = Options::get()->getInt( Options::NUM_ONLINE_DIVIDES );
     float timeoutFactor = Options::get()->getFloat( Options::TIMEOUT_FACTOR );
     bool restoreTreeStates = Options::get()->getBool( Options::RESTORE_TREE_STATES );
+    bool adaptiveScheduling = Options::get()->getBool( Options::ADAPTIVE_DNC_SCHEDULING );
 
     // Spawn threads and start solving
+    _workerStatistics.assign( numWorkers, Statistics() );
     std::list<std::thread> threads;
     for ( unsigned threadId = 0; threadId < numWorkers; ++threadId )
     {
         // Get the processed input query from the base engine
         auto inputQuery = std::unique_ptr<InputQuery>
             ( new InputQuery( *( _baseEngine->getInputQuery() ) ) );
-        threads.push_back( std::thread( dncSolve, workload, _engines[ threadId ],
+        threads.push_back( std::thread( dncSolve, _workload, _boundStore,
+                                        _engines[ threadId ],
                                         std::move( inputQuery ),
                                         std::ref( _numUnsolvedSubQueries ),
                                         std::ref( shouldQuitSolving ),
                                         threadId, onlineDivides,
                                         timeoutFactor, _sncSplittingStrategy,
-                                        restoreTreeStates, _verbosity ) );
+                                        restoreTreeStates, adaptiveScheduling,
+                                        _verbosity, &_workerStatistics[threadId] ) );
     }
 
     // Wait until either all subQueries are solved or a satisfying assignment is
@@ -277,6 +290,15 @@ void DnCManager::getSolution( std::map<int, double> &ret,
     return;
 }
 
+void DnCManager::getStatistics( Statistics &statistics ) const
+{
+    if ( _baseEngine )
+        statistics = *_baseEngine->getStatistics();
+
+    for ( const auto &workerStatistics : _workerStatistics )
+        statistics.aggregate( workerStatistics );
+}
+
 void DnCManager::printResult()
 {
     std::cout << std::endl;
@@ -17,10 +17,12 @@
 #define __DnCManager_h__
 
 #include "SnCDivideStrategy.h"
+#include "DnCBoundStore.h"
 #include "Engine.h"
 #include "InputQuery.h"
 #include "SubQuery.h"
 #include "Vector.h"
+#include "WorkStealingQueue.h"
 
 #include <atomic>
 
@@ -72,17 +74,25 @@ public:
     */
     void getSolution( std::map<int, double> &ret, InputQuery &inputQuery );
 
+    /*
+      Store the statistics of the base engine, aggregated with those of
+      all subQueries solved by the workers
+    */
+    void getStatistics( Statistics &statistics ) const;
+
 private:
     /*
       Create and run a DnCWorker
     */
-    static void dncSolve( WorkerQueue *workload, std::shared_ptr<Engine> engine,
+    static void dncSolve( WorkStealingQueue *workload, DnCBoundStore *boundStore,
+                          std::shared_ptr<Engine> engine,
                           std::unique_ptr<InputQuery> inputQuery,
                           std::atomic_uint &numUnsolvedSubQueries,
                           std::atomic_bool &shouldQuitSolving,
                           unsigned threadId, unsigned onlineDivides,
                           float timeoutFactor, SnCDivideStrategy divideStrategy,
-                          bool restoreTreeStates, unsigned verbosity );
+                          bool restoreTreeStates, bool adaptiveScheduling,
+                          unsigned verbosity, Statistics *statistics );
 
     /*
       Create the base engine from the network and property files,
@@ -117,6 +127,11 @@ private:
     */
     Vector<std::shared_ptr<Engine>> _engines;
 
+    /*
+      The statistics of the subQueries solved by each worker
+    */
+    Vector<Statistics> _workerStatistics;
+
     /*
       The engine with the satisfying assignment
     */
@@ -134,9 +149,15 @@ private:
     DnCExitCode _exitCode;
 
     /*
-      Set of subQueries to be solved by workers
+      Set of subQueries to be solved by workers, with one deque per worker
+    */
+    WorkStealingQueue *_workload;
+
+    /*
+      Bounds derived at the roots of subQueries, shared with the workers
+      solving their descendants
     */
-    WorkerQueue *_workload;
+    DnCBoundStore *_boundStore;
 
     /*
       Whether the timeout has been reached
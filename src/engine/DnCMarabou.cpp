@@ -18,7 +18,9 @@
 #include "DnCMarabou.h"
 #include "File.h"
 #include "MStringf.h"
+#include "GlobalConfiguration.h"
 #include "Options.h"
+#include "Profiler.h"
 #include "PropertyParser.h"
 #include "MarabouError.h"
 #include "QueryLoader.h"
@@ -32,6 +34,11 @@ DnCMarabou::DnCMarabou()
 
 void DnCMarabou::run()
 {
+    String traceFilePath = Options::get()->getString( Options::TRACE_FILE );
+    String depthHistogramFilePath = Options::get()->getString( Options::DEPTH_HISTOGRAM_FILE );
+    if ( traceFilePath != "" || depthHistogramFilePath != "" )
+        Profiler::enable( GlobalConfiguration::PROFILER_EVENTS_PER_THREAD );
+
     String inputQueryFilePath = Options::get()->getString( Options::INPUT_QUERY_FILE_PATH );
     if ( inputQueryFilePath.length() > 0 )
     {
@@ -84,7 +91,9 @@ void DnCMarabou::run()
     String queryDumpFilePath = Options::get()->getString( Options::QUERY_DUMP_FILE );
     if ( queryDumpFilePath.length() > 0 )
     {
-        _inputQuery.saveQuery( queryDumpFilePath );
+        _inputQuery.saveQuery( queryDumpFilePath,
+                               Options::get()->getBool( Options::BINARY_QUERY_DUMP ) ?
+                               QueryFileFormat::BINARY : QueryFileFormat::TEXT );
         printf( "\nInput query successfully dumped to file\n" );
         exit( 0 );
     }
@@ -103,6 +112,16 @@ void DnCMarabou::run()
 
     unsigned long long totalElapsed = TimeUtils::timePassed( start, end );
     displayResults( totalElapsed );
+
+    // The workers have all joined, so their buffers can be exported
+    if ( Profiler::enabled() )
+    {
+        Profiler::disable();
+        if ( traceFilePath != "" )
+            Profiler::writeChromeTrace( traceFilePath );
+        if ( depthHistogramFilePath != "" )
+            Profiler::writeDepthHistograms( depthHistogramFilePath );
+    }
 }
 
 void DnCMarabou::displayResults( unsigned long long microSecondsElapsed ) const
@@ -130,6 +149,21 @@ void DnCMarabou::displayResults( unsigned long long microSecondsElapsed ) const
 
         summaryFile.write( "\n" );
     }
+
+    // Dump the statistics, if requested
+    String statisticsFilePath = Options::get()->getString( Options::STATISTICS_FILE );
+    if ( statisticsFilePath != "" )
+    {
+        File statisticsFile( statisticsFilePath );
+        statisticsFile.open( File::MODE_WRITE_TRUNCATE );
+        statisticsFile.write( Stringf( "{\n\"result\": \"%s\",\n", resultString.ascii() ) );
+        statisticsFile.write( Stringf( "\"elapsedTime\": %llu,\n", microSecondsElapsed ) );
+        Statistics statistics;
+        _dncManager->getStatistics( statistics );
+        statisticsFile.write( "\"statistics\": " );
+        statisticsFile.write( statistics.toJson() );
+        statisticsFile.write( "\n}\n" );
+    }
 }
 
 //
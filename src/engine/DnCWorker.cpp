@@ -18,28 +18,37 @@
 #include "DnCWorker.h"
 #include "IEngine.h"
 #include "EngineState.h"
+#include "FloatUtils.h"
 #include "LargestIntervalDivider.h"
+#include "Map.h"
 #include "MarabouError.h"
 #include "MStringf.h"
 #include "PiecewiseLinearCaseSplit.h"
 #include "PolarityBasedDivider.h"
+#include "Statistics.h"
 #include "SubQuery.h"
+#include "WorkStealingQueue.h"
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cmath>
 #include <thread>
 
-DnCWorker::DnCWorker( WorkerQueue *workload, std::shared_ptr<IEngine> engine,
+DnCWorker::DnCWorker( WorkStealingQueue *workload, std::shared_ptr<IEngine> engine,
                       std::atomic_uint &numUnsolvedSubQueries,
                       std::atomic_bool &shouldQuitSolving,
                       unsigned threadId, unsigned onlineDivides,
                       float timeoutFactor, SnCDivideStrategy divideStrategy,
-                      unsigned verbosity )
+                      unsigned verbosity, DnCBoundStore *boundStore,
+                      bool adaptiveScheduling, Statistics *statistics )
     : _workload( workload )
     , _engine( engine )
     , _numUnsolvedSubQueries( &numUnsolvedSubQueries )
     , _shouldQuitSolving( &shouldQuitSolving )
+    , _boundStore( boundStore )
+    , _adaptiveScheduling( adaptiveScheduling )
+    , _statistics( statistics )
     , _threadId( threadId )
     , _onlineDivides( onlineDivides )
     , _timeoutFactor( timeoutFactor )
@@ -68,10 +77,10 @@ void DnCWorker::setQueryDivider( SnCDivideStrategy divideStrategy )
 void DnCWorker::popOneSubQueryAndSolve( bool restoreTreeStates )
 {
     SubQuery *subQuery = NULL;
-    // Boost queue stores the next element into the passed-in pointer
-    // and returns true if the pop is successful (aka, the queue is not empty
-    // in most cases)
-    if ( _workload->pop( subQuery ) )
+    // The queue stores the next element into the passed-in pointer and
+    // returns true if the pop is successful, either from this worker's own
+    // deque or by stealing from another worker
+    if ( _workload->pop( _threadId, subQuery ) )
     {
         String queryId = subQuery->_queryId;
         unsigned depth = subQuery->_depth;
@@ -92,6 +101,20 @@ void DnCWorker::popOneSubQueryAndSolve( bool restoreTreeStates )
         // Apply the split and solve
         _engine->applySplit( *split );
 
+        // Start from the bounds derived at the roots of the ancestors
+        List<Tightening> ancestorTightenings;
+        if ( _boundStore )
+        {
+            _boundStore->getTightenings( queryId, ancestorTightenings );
+            if ( !ancestorTightenings.empty() )
+            {
+                PiecewiseLinearCaseSplit ancestorBounds;
+                for ( const auto &tightening : ancestorTightenings )
+                    ancestorBounds.storeBoundTightening( tightening );
+                _engine->applySplit( ancestorBounds );
+            }
+        }
+
         bool fullSolveNeeded = true; // denotes whether we need to solve the subquery
         if ( restoreTreeStates && smtState )
             fullSolveNeeded = _engine->restoreSmtState( *smtState );
@@ -100,6 +123,9 @@ void DnCWorker::popOneSubQueryAndSolve( bool restoreTreeStates )
         {
             _engine->solve( timeoutInSeconds );
             result = _engine->getExitCode();
+
+            if ( _statistics )
+                _statistics->aggregate( *_engine->getStatistics() );
         }
         else
         {
@@ -122,10 +148,42 @@ void DnCWorker::popOneSubQueryAndSolve( bool restoreTreeStates )
         {
             // If TIMEOUT, split the current input region and add the
             // new subQueries to the current queue
-            SubQueries subQueries;
+            if ( _boundStore )
+            {
+                for ( const auto &bound : split->getBoundTightenings() )
+                    ancestorTightenings.append( bound );
+                publishRootTightenings( queryId, ancestorTightenings );
+            }
+
             unsigned newTimeout = ( depth >= GlobalConfiguration::DNC_DEPTH_THRESHOLD - 1 ?
                                     0 : ( unsigned ) timeoutInSeconds * _timeoutFactor );
-            unsigned numNewSubQueries = pow( 2, _onlineDivides );
+            unsigned numDivides = _onlineDivides;
+            if ( _adaptiveScheduling )
+            {
+                // A subQuery that is nearly done is given more time
+                unsigned extendedTimeout =
+                    getExtendedTimeout( *subQuery, restoreTreeStates );
+                if ( extendedTimeout > 0 )
+                {
+                    subQuery->_split = std::move( split );
+                    subQuery->_timeoutInSeconds = extendedTimeout;
+                    ++subQuery->_numExtensions;
+                    if ( restoreTreeStates )
+                    {
+                        subQuery->_smtState = std::unique_ptr<SmtState>( new SmtState() );
+                        _engine->storeSmtState( *( subQuery->_smtState ) );
+                    }
+
+                    if ( !_workload->push( _threadId, subQuery ) )
+                        throw MarabouError( MarabouError::UNSUCCESSFUL_QUEUE_PUSH );
+                    return;
+                }
+
+                numDivides = getNumOnlineDivides( timeoutInSeconds, newTimeout );
+            }
+
+            SubQueries subQueries;
+            unsigned numNewSubQueries = pow( 2, numDivides );
             std::vector<std::unique_ptr<SmtState>> newSmtStates;
             if ( restoreTreeStates )
             {
@@ -150,7 +208,7 @@ void DnCWorker::popOneSubQueryAndSolve( bool restoreTreeStates )
                     newSubQuery->_smtState = std::move( newSmtStates[i++] );
                 }
 
-                if ( !_workload->push( std::move( newSubQuery ) ) )
+                if ( !_workload->push( _threadId, std::move( newSubQuery ) ) )
                 {
                     throw MarabouError( MarabouError::UNSUCCESSFUL_QUEUE_PUSH );
                 }
@@ -201,6 +259,93 @@ void DnCWorker::popOneSubQueryAndSolve( bool restoreTreeStates )
     }
 }
 
+void DnCWorker::publishRootTightenings( const String &queryId,
+                                        const List<Tightening> &initialTightenings )
+{
+    Map<unsigned, double> initialLowerBounds;
+    Map<unsigned, double> initialUpperBounds;
+    for ( const auto &tightening : initialTightenings )
+    {
+        Map<unsigned, double> &bounds = ( tightening._type == Tightening::LB ) ?
+            initialLowerBounds : initialUpperBounds;
+        if ( !bounds.exists( tightening._variable ) )
+            bounds[tightening._variable] = tightening._value;
+        else if ( tightening._type == Tightening::LB )
+            bounds[tightening._variable] = std::max( bounds[tightening._variable], tightening._value );
+        else
+            bounds[tightening._variable] = std::min( bounds[tightening._variable], tightening._value );
+    }
+
+    List<Tightening> rootTightenings;
+    _engine->getRootTightenings( rootTightenings );
+    for ( const auto &tightening : rootTightenings )
+    {
+        // The descendants already start from the initial bounds
+        unsigned variable = tightening._variable;
+        if ( tightening._type == Tightening::LB )
+        {
+            if ( initialLowerBounds.exists( variable ) &&
+                 !FloatUtils::gt( tightening._value, initialLowerBounds[variable] ) )
+                continue;
+        }
+        else
+        {
+            if ( initialUpperBounds.exists( variable ) &&
+                 !FloatUtils::lt( tightening._value, initialUpperBounds[variable] ) )
+                continue;
+        }
+
+        if ( !_boundStore->publish( _threadId, queryId, tightening ) )
+            return;
+    }
+}
+
+unsigned DnCWorker::getExtendedTimeout( const SubQuery &subQuery,
+                                        bool canResume ) const
+{
+    if ( subQuery._numExtensions >= GlobalConfiguration::DNC_MAX_TIMEOUT_EXTENSIONS )
+        return 0;
+
+    const Statistics *statistics = _engine->getStatistics();
+    double progress = statistics->getSearchProgress();
+    if ( statistics->getNumVisitedTreeStates() <
+         GlobalConfiguration::DNC_MIN_VISITED_STATES_FOR_ESTIMATE ||
+         progress < GlobalConfiguration::DNC_NEARLY_DONE_SEARCH_PROGRESS )
+        return 0;
+
+    // If the search cannot be resumed, it starts over
+    double timeSpent = subQuery._timeoutInSeconds;
+    double timeNeeded = timeSpent / progress;
+    if ( canResume )
+        timeNeeded -= timeSpent;
+
+    return std::max( 1u, ( unsigned )std::ceil
+                     ( timeNeeded * GlobalConfiguration::DNC_TIMEOUT_EXTENSION_SLACK ) );
+}
+
+unsigned DnCWorker::getNumOnlineDivides( unsigned timeoutInSeconds,
+                                         unsigned newTimeoutInSeconds ) const
+{
+    const Statistics *statistics = _engine->getStatistics();
+    double progress = statistics->getSearchProgress();
+    if ( statistics->getNumVisitedTreeStates() <
+         GlobalConfiguration::DNC_MIN_VISITED_STATES_FOR_ESTIMATE ||
+         progress <= 0 || newTimeoutInSeconds == 0 )
+        return _onlineDivides;
+
+    // Enough subQueries for each to finish within the new timeout, if the
+    // remaining work is divided evenly. There is no point in more divides
+    // than there are unfixed constraints.
+    double remainingTime = timeoutInSeconds * ( 1 - progress ) / progress;
+    double numSubQueries = remainingTime / newTimeoutInSeconds;
+    unsigned numDivides = ( numSubQueries <= 2 ) ? 1 : ( unsigned )std::ceil( std::log2( numSubQueries ) );
+
+    unsigned maxDivides = std::max( _onlineDivides,
+                                    GlobalConfiguration::DNC_MAX_ADAPTIVE_ONLINE_DIVIDES );
+    maxDivides = std::min( maxDivides, std::max( 1u, statistics->getNumActivePlConstraints() ) );
+    return std::min( numDivides, maxDivides );
+}
+
 void DnCWorker::printProgress( String queryId, IEngine::ExitCode result ) const
 {
     printf( "Worker %d: Query %s %s, %d tasks remaining\n", _threadId,
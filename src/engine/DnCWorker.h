@@ -17,23 +17,37 @@
 #define __DnCWorker_h__
 
 #include "SnCDivideStrategy.h"
+#include "DnCBoundStore.h"
 #include "Engine.h"
 #include "PiecewiseLinearCaseSplit.h"
 #include "QueryDivider.h"
+#include "WorkStealingQueue.h"
 
 #include <atomic>
 
 class DnCWorker
 {
 public:
-    DnCWorker( WorkerQueue *workload, std::shared_ptr<IEngine> engine,
+    DnCWorker( WorkStealingQueue *workload, std::shared_ptr<IEngine> engine,
                std::atomic_uint &numUnsolvedSubqueries,
                std::atomic_bool &shouldQuitSolving, unsigned threadId,
                unsigned onlineDivides, float timeoutFactor,
-               SnCDivideStrategy divideStrategy, unsigned verbosity );
+               SnCDivideStrategy divideStrategy, unsigned verbosity,
+               DnCBoundStore *boundStore = NULL,
+               bool adaptiveScheduling = false,
+               Statistics *statistics = NULL );
 
     /*
-      Pop one subQuery, solve it and handle the result
+      Pop one subQuery, solve it and handle the result. The subQuery is taken
+      from this worker's own deque if possible, and stolen from another worker
+      otherwise. New subQueries created by online divides are pushed to this
+      worker's own deque. If there is a bound store, the subQuery starts
+      from the bounds its ancestors derived, and if it times out, the bounds
+      derived at its root are shared with its descendants. With adaptive
+      scheduling, a subQuery that times out is given more time if it is
+      estimated to be nearly done, and is otherwise divided according to
+      the estimated remaining work. If the worker keeps statistics, those
+      of each solved subQuery are added to them.
       Return true if the DnCWorker should continue running
     */
     void popOneSubQueryAndSolve( bool restoreTreeStates = false );
@@ -44,6 +58,28 @@ private:
     */
     void setQueryDivider( SnCDivideStrategy divideStrategy );
 
+    /*
+      Publish the bounds derived at the root of a timed-out subQuery that are
+      tighter than the ones it started from
+    */
+    void publishRootTightenings( const String &queryId,
+                                 const List<Tightening> &initialTightenings );
+
+    /*
+      Adaptive scheduling of a timed-out subQuery, based on the statistics of
+      the engine that solved it. If the search is estimated to be nearly done,
+      return the time it needs to finish (from where it stopped, if it can
+      resume), and otherwise 0.
+    */
+    unsigned getExtendedTimeout( const SubQuery &subQuery, bool canResume ) const;
+
+    /*
+      The number of times to divide a timed-out subQuery, so that each new
+      subQuery is estimated to finish within the new timeout
+    */
+    unsigned getNumOnlineDivides( unsigned timeoutInSeconds,
+                                  unsigned newTimeoutInSeconds ) const;
+
     /*
       Convert the exitCode to string
     */
@@ -55,9 +91,9 @@ private:
     void printProgress( String queryId, IEngine::ExitCode result ) const;
 
     /*
-      The queue of subqueries (shared across threads)
+      The work-stealing queue of subqueries (shared across threads)
     */
-    WorkerQueue *_workload;
+    WorkStealingQueue *_workload;
     std::shared_ptr<IEngine> _engine;
 
     /*
@@ -77,6 +113,24 @@ private:
     */
     std::shared_ptr<EngineState> _initialState;
 
+    /*
+      The store of root-level bounds of subqueries (shared across threads),
+      if any
+    */
+    DnCBoundStore *_boundStore;
+
+    /*
+      Whether timed-out subQueries are extended or divided based on their
+      estimated progress
+    */
+    bool _adaptiveScheduling;
+
+    /*
+      The statistics of all subQueries solved by this worker, if any. The
+      engine's own statistics are reset for every subQuery.
+    */
+    Statistics *_statistics;
+
     unsigned _threadId;
     unsigned _onlineDivides;
     float _timeoutFactor;
@@ -21,6 +21,7 @@
 #include "EngineState.h"
 #include "InfeasibleQueryException.h"
 #include "InputQuery.h"
+#include "LPSolverFactory.h"
 #include "MStringf.h"
 #include "MalformedBasisException.h"
 #include "MarabouError.h"
@@ -28,6 +29,8 @@
 #include "Options.h"
 #include "PiecewiseLinearConstraint.h"
 #include "Preprocessor.h"
+#include "Profiler.h"
+#include "SparseUnsortedArrays.h"
 #include "TableauRow.h"
 #include "TimeUtils.h"
 #include "Vector.h" 
@@ -40,6 +43,9 @@ Engine::Engine()
     , _numPlConstraintsDisabledByValidSplits( 0 )
     , _preprocessingEnabled( false )
     , _initialStateStored( false )
+    , _stateTrailUsabilityChecked( false )
+    , _stateTrailUsable( false )
+    , _conflictExplained( false )
     , _work( NULL )
     , _basisRestorationRequired( Engine::RESTORATION_NOT_NEEDED )
     , _basisRestorationPerformed( Engine::NO_RESTORATION_PERFORMED )
@@ -58,6 +64,9 @@ Engine::Engine()
     , _gurobi( nullptr )
     , _milpEncoder( nullptr )
     , _simulationSize( Options::get()->getInt( Options::NUMBER_OF_SIMULATIONS ) )
+    , _boundExchange( NULL )
+    , _boundExchangeParticipant( 0 )
+    , _dualSimplexRequired( false )
 {
     _smtCore.setStatistics( &_statistics );
     _tableau->setStatistics( &_statistics );
@@ -85,6 +94,29 @@ void Engine::setVerbosity( unsigned verbosity )
     _verbosity = verbosity;
 }
 
+void Engine::setSplittingStrategy( DivideStrategy strategy )
+{
+    _splittingStrategy = strategy;
+}
+
+void Engine::setSymbolicBoundTighteningType( SymbolicBoundTighteningType type )
+{
+    _symbolicBoundTighteningType = type;
+}
+
+void Engine::setConstraintViolationThreshold( unsigned threshold )
+{
+    _smtCore.setConstraintViolationThreshold( threshold );
+}
+
+void Engine::setBoundExchange( BoundExchange *boundExchange, unsigned participant )
+{
+    ASSERT( participant < boundExchange->getNumberOfParticipants() );
+
+    _boundExchange = boundExchange;
+    _boundExchangeParticipant = participant;
+}
+
 void Engine::adjustWorkMemorySize()
 {
     if ( _work )
@@ -100,6 +132,8 @@ void Engine::adjustWorkMemorySize()
 
 bool Engine::solve( unsigned timeoutInSeconds )
 {
+    PROFILE_SCOPE( "Engine::solve" );
+
     SignalHandler::getInstance()->initialize();
     SignalHandler::getInstance()->registerClient( this );
 
@@ -109,6 +143,9 @@ bool Engine::solve( unsigned timeoutInSeconds )
     updateDirections();
     storeInitialEngineState();
 
+    _rootLowerBounds.clear();
+    _rootUpperBounds.clear();
+
     mainLoopStatistics();
     if ( _verbosity > 0 )
     {
@@ -119,6 +156,9 @@ bool Engine::solve( unsigned timeoutInSeconds )
 
     applyAllValidConstraintCaseSplits();
 
+    if ( _boundExchange )
+        exchangeBounds();
+
     bool splitJustPerformed = true;
     struct timespec mainLoopStart = TimeUtils::sampleMicro();
     while ( true )
@@ -166,6 +206,10 @@ bool Engine::solve( unsigned timeoutInSeconds )
             // Check whether progress has been made recently
             checkOverallProgress();
 
+            if ( _boundExchange && _statistics.getNumMainLoopIterations() %
+                 GlobalConfiguration::BOUND_EXCHANGE_FREQUENCY == 0 )
+                exchangeBounds();
+
             // If the basis has become malformed, we need to restore it
             if ( basisRestorationNeeded() )
             {
@@ -215,6 +259,9 @@ bool Engine::solve( unsigned timeoutInSeconds )
             // Perform any SmtCore-initiated case splits
             if ( _smtCore.needToSplit() )
             {
+                if ( _smtCore.getStackDepth() == 0 )
+                    storeRootBounds();
+
                 _smtCore.performSplit();
                 splitJustPerformed = true;
                 continue;
@@ -271,7 +318,14 @@ bool Engine::solve( unsigned timeoutInSeconds )
                 continue;
             }
 
-            // We have out-of-bounds variables.
+            // We have out-of-bounds variables. If bounds have changed
+            // since the last dual simplex phase, start with one.
+            if ( _dualSimplexRequired )
+            {
+                performDualSimplexPhase();
+                continue;
+            }
+
             performSimplexStep();
             continue;
         }
@@ -306,6 +360,7 @@ bool Engine::solve( unsigned timeoutInSeconds )
         {
             // The current query is unsat, and we need to pop.
             // If we're at level 0, the whole query is unsat.
+            analyzeConflict();
             if ( !_smtCore.popSplit() )
             {
                 if ( _verbosity > 0 )
@@ -351,8 +406,57 @@ void Engine::mainLoopStatistics()
     _statistics.addTimeForStatistics( TimeUtils::timePassed( start, end ) );
 }
 
+void Engine::performDualSimplexPhase()
+{
+    PROFILE_SCOPE( "Engine::performDualSimplexPhase" );
+
+    _dualSimplexRequired = false;
+
+    if ( !GlobalConfiguration::USE_DUAL_SIMPLEX_AFTER_BOUND_CHANGES ||
+         !_tableau->allBoundsValid() )
+        return;
+
+    // Statistics
+    _statistics.incNumDualSimplexPhases();
+    struct timespec start = TimeUtils::sampleMicro();
+
+    _tableau->resetDualSteepestEdgeWeights();
+
+    // The pivots change the statuses of basic variables, so the primal
+    // cost function needs to be recomputed afterwards; invalidating it
+    // now also spares the pivots its incremental update.
+    _costFunctionManager->invalidateCostFunction();
+
+    for ( unsigned i = 0; i < GlobalConfiguration::DUAL_SIMPLEX_MAX_ITERATIONS; ++i )
+    {
+        // Pick the leaving variable, i.e. the basic variable to fix
+        if ( !_tableau->pickDualLeavingVariable() )
+            break;
+
+        // Pick the entering variable by the dual ratio test
+        _tableau->computePivotRow();
+        if ( !_tableau->dualRatioTest() )
+            break;
+
+        _tableau->computeChangeColumn();
+        _tableau->updateDualSteepestEdgeWeights();
+        _rowBoundTightener->examinePivotRow();
+
+        _activeEntryStrategy->prePivotHook( _tableau, false );
+        _tableau->performPivot();
+        _activeEntryStrategy->postPivotHook( _tableau, false );
+
+        _statistics.incNumDualSimplexSteps();
+    }
+
+    struct timespec end = TimeUtils::sampleMicro();
+    _statistics.addTimeDualSimplexSteps( TimeUtils::timePassed( start, end ) );
+}
+
 void Engine::performConstraintFixingStep()
 {
+    PROFILE_SCOPE( "Engine::performConstraintFixingStep" );
+
     // Statistics
     _statistics.incNumConstraintFixingSteps();
     struct timespec start = TimeUtils::sampleMicro();
@@ -372,6 +476,8 @@ void Engine::performConstraintFixingStep()
 
 void Engine::performSimplexStep()
 {
+    PROFILE_SCOPE( "Engine::performSimplexStep" );
+
     // Statistics
     _statistics.incNumSimplexSteps();
     struct timespec start = TimeUtils::sampleMicro();
@@ -511,6 +617,9 @@ void Engine::performSimplexStep()
         else
         {
             // Cost function is fresh --- failure is real.
+            if ( _smtCore.conflictAnalysisEnabled() )
+                _conflictExplained = explainSimplexConflict( _conflictExplanation );
+
             struct timespec end = TimeUtils::sampleMicro();
             _statistics.addTimeSimplexSteps( TimeUtils::timePassed( start, end ) );
             throw InfeasibleQueryException();
@@ -746,19 +855,12 @@ void Engine::storeEquationsInDegradationChecker()
     _degradationChecker.storeEquations( _preprocessedQuery );
 }
 
-double *Engine::createConstraintMatrix()
+void Engine::createConstraintMatrix( SparseUnsortedArrays &constraintMatrix )
 {
     const List<Equation> &equations( _preprocessedQuery.getEquations() );
     unsigned m = equations.size();
     unsigned n = _preprocessedQuery.getNumberOfVariables();
 
-    // Step 1: create a constraint matrix from the equations
-    double *constraintMatrix = new double[n*m];
-    if ( !constraintMatrix )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Engine::constraintMatrix" );
-    std::fill_n( constraintMatrix, n*m, 0.0 );
-
-    unsigned equationIndex = 0;
     for ( const auto &equation : equations )
     {
         if ( equation._type != Equation::EQ )
@@ -766,17 +868,41 @@ double *Engine::createConstraintMatrix()
             _exitCode = Engine::ERROR;
             throw MarabouError( MarabouError::NON_EQUALITY_INPUT_EQUATION_DISCOVERED );
         }
+    }
+
+    /*
+      Create the sparse rows of the constraint matrix directly from the
+      equations, so that memory is proportional to the number of
+      non-zero entries. If a variable appears in several addends of an
+      equation, its last coefficient is the one that counts.
+    */
+    constraintMatrix.initializeToEmpty( m, n );
+
+    double *coefficients = new double[n];
+    if ( !coefficients )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Engine::coefficients" );
+    std::fill_n( coefficients, n, 0.0 );
 
+    unsigned equationIndex = 0;
+    for ( const auto &equation : equations )
+    {
         for ( const auto &addend : equation._addends )
-            constraintMatrix[equationIndex*n + addend._variable] = addend._coefficient;
+            coefficients[addend._variable] = addend._coefficient;
+
+        for ( const auto &addend : equation._addends )
+        {
+            if ( !FloatUtils::isZero( coefficients[addend._variable] ) )
+                constraintMatrix.append( equationIndex, addend._variable, coefficients[addend._variable] );
+            coefficients[addend._variable] = 0.0;
+        }
 
         ++equationIndex;
     }
 
-    return constraintMatrix;
+    delete[] coefficients;
 }
 
-void Engine::removeRedundantEquations( const double *constraintMatrix )
+void Engine::removeRedundantEquations( const SparseUnsortedArrays &constraintMatrix )
 {
     const List<Equation> &equations( _preprocessedQuery.getEquations() );
     unsigned m = equations.size();
@@ -784,7 +910,7 @@ void Engine::removeRedundantEquations( const double *constraintMatrix )
 
     // Step 1: analyze the matrix to identify redundant rows
     AutoConstraintMatrixAnalyzer analyzer;
-    analyzer->analyze( constraintMatrix, m, n );
+    analyzer->analyze( &constraintMatrix, m, n );
 
     ENGINE_LOG( Stringf( "Number of redundant rows: %u out of %u",
                          analyzer->getRedundantRows().size(), m ).ascii() );
@@ -799,7 +925,7 @@ void Engine::removeRedundantEquations( const double *constraintMatrix )
     }
 }
 
-void Engine::selectInitialVariablesForBasis( const double *constraintMatrix, List<unsigned> &initialBasis, List<unsigned> &basicRows )
+void Engine::selectInitialVariablesForBasis( const SparseUnsortedArrays &constraintMatrix, List<unsigned> &initialBasis, List<unsigned> &basicRows )
 {
     /*
       This method permutes rows and columns in the constraint matrix (prior
@@ -825,33 +951,38 @@ void Engine::selectInitialVariablesForBasis( const double *constraintMatrix, Lis
         return;
     }
 
+    // The columns of the matrix, for finding the rows of an entry
+    SparseUnsortedArrays columns;
+    constraintMatrix.transposeIntoOther( &columns );
+
     unsigned *nnzInRow = new unsigned[m];
     unsigned *nnzInColumn = new unsigned[n];
 
-    std::fill_n( nnzInRow, m, 0 );
-    std::fill_n( nnzInColumn, n, 0 );
-
     unsigned *columnOrdering = new unsigned[n];
     unsigned *rowOrdering = new unsigned[m];
 
+    // The current position of each row and column in the orderings
+    unsigned *columnPosition = new unsigned[n];
+    unsigned *rowPosition = new unsigned[m];
+
     for ( unsigned i = 0; i < m; ++i )
+    {
         rowOrdering[i] = i;
+        rowPosition[i] = i;
+    }
 
     for ( unsigned i = 0; i < n; ++i )
+    {
         columnOrdering[i] = i;
+        columnPosition[i] = i;
+    }
 
     // Initialize the counters
     for ( unsigned i = 0; i < m; ++i )
-    {
-        for ( unsigned j = 0; j < n; ++j )
-        {
-            if ( !FloatUtils::isZero( constraintMatrix[i*n + j] ) )
-            {
-                ++nnzInRow[i];
-                ++nnzInColumn[j];
-            }
-        }
-    }
+        nnzInRow[i] = constraintMatrix.getRow( i )->getNnz();
+
+    for ( unsigned i = 0; i < n; ++i )
+        nnzInColumn[i] = columns.getRow( i )->getNnz();
 
     DEBUG({
             for ( unsigned i = 0; i < m; ++i )
@@ -883,6 +1014,8 @@ void Engine::selectInitialVariablesForBasis( const double *constraintMatrix, Lis
             temp = rowOrdering[singletonRow];
             rowOrdering[singletonRow] = rowOrdering[numTriangularRows];
             rowOrdering[numTriangularRows] = temp;
+            rowPosition[rowOrdering[singletonRow]] = singletonRow;
+            rowPosition[rowOrdering[numTriangularRows]] = numTriangularRows;
 
             temp = nnzInRow[numTriangularRows];
             nnzInRow[numTriangularRows] = nnzInRow[singletonRow];
@@ -890,29 +1023,35 @@ void Engine::selectInitialVariablesForBasis( const double *constraintMatrix, Lis
 
             // Find the non-zero entry in the row and swap it to the diagonal
             DEBUG( bool foundNonZero = false );
-            for ( unsigned i = numTriangularRows; i < n - numExcluded; ++i )
+            const SparseUnsortedArray *row = constraintMatrix.getRow( rowOrdering[numTriangularRows] );
+            for ( unsigned j = 0; j < row->getNnz(); ++j )
             {
-                if ( !FloatUtils::isZero( constraintMatrix[rowOrdering[numTriangularRows] * n + columnOrdering[i]] ) )
-                {
-                    temp = columnOrdering[i];
-                    columnOrdering[i] = columnOrdering[numTriangularRows];
-                    columnOrdering[numTriangularRows] = temp;
+                unsigned i = columnPosition[row->getByArrayIndex( j )._index];
+                if ( i < numTriangularRows || i >= n - numExcluded )
+                    continue;
 
-                    temp = nnzInColumn[numTriangularRows];
-                    nnzInColumn[numTriangularRows] = nnzInColumn[i];
-                    nnzInColumn[i] = temp;
+                temp = columnOrdering[i];
+                columnOrdering[i] = columnOrdering[numTriangularRows];
+                columnOrdering[numTriangularRows] = temp;
+                columnPosition[columnOrdering[i]] = i;
+                columnPosition[columnOrdering[numTriangularRows]] = numTriangularRows;
 
-                    DEBUG( foundNonZero = true );
-                    break;
-                }
+                temp = nnzInColumn[numTriangularRows];
+                nnzInColumn[numTriangularRows] = nnzInColumn[i];
+                nnzInColumn[i] = temp;
+
+                DEBUG( foundNonZero = true );
+                break;
             }
 
             ASSERT( foundNonZero );
 
             // Remove all entries under the diagonal entry from the row counters
-            for ( unsigned i = numTriangularRows + 1; i < m; ++i )
+            const SparseUnsortedArray *column = columns.getRow( columnOrdering[numTriangularRows] );
+            for ( unsigned j = 0; j < column->getNnz(); ++j )
             {
-                if ( !FloatUtils::isZero( constraintMatrix[rowOrdering[i] * n + columnOrdering[numTriangularRows]] ) )
+                unsigned i = rowPosition[column->getByArrayIndex( j )._index];
+                if ( i > numTriangularRows )
                     --nnzInRow[i];
             }
 
@@ -934,10 +1073,12 @@ void Engine::selectInitialVariablesForBasis( const double *constraintMatrix, Lis
             }
 
             // Update the row counters to account for the excluded column
-            for ( unsigned i = numTriangularRows; i < m; ++i )
+            unsigned excludedColumn = columnOrdering[column];
+            const SparseUnsortedArray *entries = columns.getRow( excludedColumn );
+            for ( unsigned j = 0; j < entries->getNnz(); ++j )
             {
-                double element = constraintMatrix[rowOrdering[i]*n + columnOrdering[column]];
-                if ( !FloatUtils::isZero( element ) )
+                unsigned i = rowPosition[entries->getByArrayIndex( j )._index];
+                if ( i >= numTriangularRows )
                 {
                     ASSERT( nnzInRow[i] > 1 );
                     --nnzInRow[i];
@@ -945,6 +1086,8 @@ void Engine::selectInitialVariablesForBasis( const double *constraintMatrix, Lis
             }
 
             columnOrdering[column] = columnOrdering[n - 1 - numExcluded];
+            columnPosition[columnOrdering[column]] = column;
+            columnPosition[excludedColumn] = n - 1 - numExcluded;
             nnzInColumn[column] = nnzInColumn[n - 1 - numExcluded];
             ++numExcluded;
         }
@@ -968,6 +1111,8 @@ void Engine::selectInitialVariablesForBasis( const double *constraintMatrix, Lis
     delete[] nnzInColumn;
     delete[] columnOrdering;
     delete[] rowOrdering;
+    delete[] columnPosition;
+    delete[] rowPosition;
 }
 
 void Engine::addAuxiliaryVariables()
@@ -1007,7 +1152,7 @@ void Engine::augmentInitialBasisIfNeeded( List<unsigned> &initialBasis, const Li
     }
 }
 
-void Engine::initializeTableau( const double *constraintMatrix, const List<unsigned> &initialBasis )
+void Engine::initializeTableau( const SparseUnsortedArrays &constraintMatrix, const List<unsigned> &initialBasis )
 {
     const List<Equation> &equations( _preprocessedQuery.getEquations() );
     unsigned m = equations.size();
@@ -1025,7 +1170,7 @@ void Engine::initializeTableau( const double *constraintMatrix, const List<unsig
     }
 
     // Populate constriant matrix
-    _tableau->setConstraintMatrix( constraintMatrix );
+    _tableau->setConstraintMatrix( &constraintMatrix );
 
     for ( unsigned i = 0; i < n; ++i )
     {
@@ -1050,6 +1195,7 @@ void Engine::initializeTableau( const double *constraintMatrix, const List<unsig
     for ( const auto &constraint : _plConstraints )
     {
         constraint->registerAsWatcher( _tableau );
+        constraint->registerBoundStore( _tableau );
         constraint->setStatistics( &_statistics );
     }
 
@@ -1072,6 +1218,8 @@ void Engine::initializeNetworkLevelReasoning()
 
 bool Engine::processInputQuery( InputQuery &inputQuery, bool preprocess )
 {
+    PROFILE_SCOPE( "Engine::processInputQuery" );
+
     ENGINE_LOG( "processInputQuery starting\n" );
     struct timespec start = TimeUtils::sampleMicro();
 
@@ -1082,12 +1230,12 @@ bool Engine::processInputQuery( InputQuery &inputQuery, bool preprocess )
         if ( _verbosity > 0 )
             printInputBounds( inputQuery );
 
-        double *constraintMatrix = createConstraintMatrix();
+        SparseUnsortedArrays constraintMatrix;
+        createConstraintMatrix( constraintMatrix );
         removeRedundantEquations( constraintMatrix );
 
         // The equations have changed, recreate the constraint matrix
-        delete[] constraintMatrix;
-        constraintMatrix = createConstraintMatrix();
+        createConstraintMatrix( constraintMatrix );
 
         List<unsigned> initialBasis;
         List<unsigned> basicRows;
@@ -1098,8 +1246,7 @@ bool Engine::processInputQuery( InputQuery &inputQuery, bool preprocess )
         storeEquationsInDegradationChecker();
 
         // The equations have changed, recreate the constraint matrix
-        delete[] constraintMatrix;
-        constraintMatrix = createConstraintMatrix();
+        createConstraintMatrix( constraintMatrix );
 
         initializeNetworkLevelReasoning();
         initializeTableau( constraintMatrix, initialBasis );
@@ -1107,8 +1254,6 @@ bool Engine::processInputQuery( InputQuery &inputQuery, bool preprocess )
         if ( GlobalConfiguration::WARM_START )
             warmStart();
 
-        delete[] constraintMatrix;
-
         if ( preprocess )
         {
             performSymbolicBoundTightening();
@@ -1157,7 +1302,9 @@ bool Engine::processInputQuery( InputQuery &inputQuery, bool preprocess )
 
 void Engine::performMILPSolverBoundedTightening()
 {
-    if ( _networkLevelReasoner && Options::get()->gurobiEnabled() )
+    PROFILE_SCOPE( "Engine::performMILPSolverBoundedTightening" );
+
+    if ( _networkLevelReasoner )
     {
         _networkLevelReasoner->obtainCurrentBounds();
 
@@ -1180,15 +1327,7 @@ void Engine::performMILPSolverBoundedTightening()
         }
         List<Tightening> tightenings;
         _networkLevelReasoner->getConstraintTightenings( tightenings );
-
-        for ( const auto &tightening : tightenings )
-        {
-            if ( tightening._type == Tightening::LB )
-                _tableau->tightenLowerBound( tightening._variable, tightening._value );
-
-            else if ( tightening._type == Tightening::UB )
-                _tableau->tightenUpperBound( tightening._variable, tightening._value );
-        }
+        _tableau->applyTightenings( tightenings );
     }
 }
 
@@ -1301,9 +1440,38 @@ void Engine::restoreState( const EngineState &state )
 {
     ENGINE_LOG( "Restore state starting" );
 
+    if ( state._storedOnTrail )
+    {
+        ENGINE_LOG( "\tRolling back the undo trails" );
+        _tableau->undoBoundTrail( state._boundTrailPosition );
+
+        List<PiecewiseLinearConstraint *> restoredConstraints;
+        _constraintStateTrail.undo( state._constraintTrailPosition, restoredConstraints );
+
+        // The restored constraints may hold stale assignments
+        for ( const auto &constraint : restoredConstraints )
+        {
+            for ( unsigned variable : constraint->getParticipatingVariables() )
+                constraint->notifyVariableValue( variable, _tableau->getValue( variable ) );
+        }
+
+        _numPlConstraintsDisabledByValidSplits = state._numPlConstraintsDisabledByValidSplits;
+
+        _rowBoundTightener->resetBounds();
+        _constraintBoundTightener->resetBounds();
+
+        // Reset the violation counts in the SMT core
+        _smtCore.resetReportedViolations();
+        return;
+    }
+
     if ( !state._tableauStateIsStored )
         throw MarabouError( MarabouError::RESTORING_ENGINE_FROM_INVALID_STATE );
 
+    // Positions on the trails are meaningless after a full restoration
+    if ( stateTrailEnabled() )
+        clearStateTrail();
+
     ENGINE_LOG( "\tRestoring tableau state" );
     _tableau->restoreState( state._tableauState );
 
@@ -1334,6 +1502,91 @@ void Engine::setNumPlConstraintsDisabledByValidSplits( unsigned numConstraints )
     _numPlConstraintsDisabledByValidSplits = numConstraints;
 }
 
+bool Engine::storeStateOnTrail( EngineState &state )
+{
+    if ( !stateTrailUsable() )
+        return false;
+
+    if ( !stateTrailEnabled() )
+        setStateTrailEnabled( true );
+
+    state._storedOnTrail = true;
+    state._tableauStateIsStored = false;
+    state._boundTrailPosition = _tableau->getBoundTrailSize();
+    state._constraintTrailPosition = _constraintStateTrail.getSize();
+    state._numPlConstraintsDisabledByValidSplits = _numPlConstraintsDisabledByValidSplits;
+
+    _constraintStateTrail.startLevel();
+    return true;
+}
+
+void Engine::saveConstraintOnTrail( PiecewiseLinearConstraint *constraint )
+{
+    _constraintStateTrail.saveConstraint( constraint );
+}
+
+bool Engine::stateTrailUsable()
+{
+    if ( _stateTrailUsabilityChecked )
+        return _stateTrailUsable;
+
+    _stateTrailUsabilityChecked = true;
+    _stateTrailUsable = false;
+
+    if ( !GlobalConfiguration::USE_STATE_TRAIL )
+        return false;
+
+    // Splits that add equations change the dimensions of the tableau,
+    // which the trails cannot undo. The splits of max and disjunction
+    // constraints may come to include equations as the search
+    // progresses, so these are excluded up front.
+    for ( const auto &constraint : _plConstraints )
+    {
+        PiecewiseLinearFunctionType type = constraint->getType();
+        if ( type == MAX || type == DISJUNCTION )
+            return false;
+
+        if ( !constraint->isActive() )
+            continue;
+
+        List<PiecewiseLinearCaseSplit> splits;
+        if ( constraint->phaseFixed() )
+            splits.append( constraint->getValidCaseSplit() );
+        else
+            splits = constraint->getCaseSplits();
+
+        for ( const auto &split : splits )
+        {
+            if ( !split.getEquations().empty() )
+                return false;
+        }
+    }
+
+    _constraintStateTrail.initialize( _plConstraints );
+    _tableau->registerToWatchAllVariables( &_constraintStateTrail );
+
+    _stateTrailUsable = true;
+    return true;
+}
+
+bool Engine::stateTrailEnabled() const
+{
+    return _tableau->boundTrailEnabled();
+}
+
+void Engine::setStateTrailEnabled( bool enabled )
+{
+    _tableau->setBoundTrailEnabled( enabled );
+    _constraintStateTrail.setRecording( enabled );
+}
+
+void Engine::clearStateTrail()
+{
+    _tableau->clearBoundTrail();
+    _constraintStateTrail.clear();
+    setStateTrailEnabled( false );
+}
+
 bool Engine::attemptToMergeVariables( unsigned x1, unsigned x2 )
 {
     /*
@@ -1429,6 +1682,186 @@ bool Engine::attemptToMergeVariables( unsigned x1, unsigned x2 )
     return true;
 }
 
+void Engine::setDecisionLevel( unsigned level )
+{
+    _tableau->setDecisionLevel( level );
+}
+
+bool Engine::explainSimplexConflict( List<SmtCore::ExplanationBound> &explanation )
+{
+    explanation.clear();
+
+    // The cost function sums the rows of the out-of-bounds basic
+    // variables; their violated bounds are part of the explanation
+    for ( unsigned i = 0; i < _tableau->getM(); ++i )
+    {
+        unsigned variable = _tableau->basicIndexToVariable( i );
+        unsigned status = _tableau->getBasicStatusByIndex( i );
+
+        if ( status == ITableau::BELOW_LB )
+            explanation.append( { Tightening( variable, _tableau->getLowerBound( variable ), Tightening::LB ),
+                                  _tableau->getLowerBoundLevel( variable ) } );
+        else if ( status == ITableau::ABOVE_UB )
+            explanation.append( { Tightening( variable, _tableau->getUpperBound( variable ), Tightening::UB ),
+                                  _tableau->getUpperBoundLevel( variable ) } );
+    }
+
+    // No nonbasic variable can reduce the cost, because it is blocked
+    // by one of its bounds
+    const double *costFunction = _costFunctionManager->getCostFunction();
+    for ( unsigned i = 0; i < _tableau->getN() - _tableau->getM(); ++i )
+    {
+        double cost = costFunction[i];
+        if ( FloatUtils::isZero( cost ) )
+            continue;
+
+        unsigned variable = _tableau->nonBasicIndexToVariable( i );
+        double value = _tableau->getValue( variable );
+
+        if ( cost > 0 )
+        {
+            double lowerBound = _tableau->getLowerBound( variable );
+            if ( !FloatUtils::areEqual( value, lowerBound ) )
+                return false;
+
+            explanation.append( { Tightening( variable, lowerBound, Tightening::LB ),
+                                  _tableau->getLowerBoundLevel( variable ) } );
+        }
+        else
+        {
+            double upperBound = _tableau->getUpperBound( variable );
+            if ( !FloatUtils::areEqual( value, upperBound ) )
+                return false;
+
+            explanation.append( { Tightening( variable, upperBound, Tightening::UB ),
+                                  _tableau->getUpperBoundLevel( variable ) } );
+        }
+    }
+
+    return true;
+}
+
+bool Engine::explainInvalidBounds( List<SmtCore::ExplanationBound> &explanation ) const
+{
+    explanation.clear();
+
+    // Among the variables with invalid bounds, pick the one whose
+    // bounds were set the earliest
+    bool found = false;
+    unsigned bestVariable = 0;
+    unsigned bestLevel = 0;
+    for ( unsigned i = 0; i < _tableau->getN(); ++i )
+    {
+        if ( !FloatUtils::gt( _tableau->getLowerBound( i ), _tableau->getUpperBound( i ) ) )
+            continue;
+
+        unsigned level = _tableau->getLowerBoundLevel( i );
+        if ( _tableau->getUpperBoundLevel( i ) > level )
+            level = _tableau->getUpperBoundLevel( i );
+
+        if ( !found || level < bestLevel )
+        {
+            found = true;
+            bestVariable = i;
+            bestLevel = level;
+        }
+    }
+
+    if ( !found )
+        return false;
+
+    explanation.append( { Tightening( bestVariable, _tableau->getLowerBound( bestVariable ), Tightening::LB ),
+                          _tableau->getLowerBoundLevel( bestVariable ) } );
+    explanation.append( { Tightening( bestVariable, _tableau->getUpperBound( bestVariable ), Tightening::UB ),
+                          _tableau->getUpperBoundLevel( bestVariable ) } );
+    return true;
+}
+
+void Engine::analyzeConflict()
+{
+    PROFILE_SCOPE( "Engine::analyzeConflict" );
+
+    bool explained = _conflictExplained;
+    _conflictExplained = false;
+
+    if ( !_smtCore.conflictAnalysisEnabled() )
+        return;
+
+    // Conflicts that are not explained are handled by a chronological pop
+    if ( !explained && !explainInvalidBounds( _conflictExplanation ) )
+        return;
+
+    _smtCore.analyzeConflict( _conflictExplanation );
+}
+
+bool Engine::translateSplitToPreprocessedQuery( const PiecewiseLinearCaseSplit &split,
+                                                PiecewiseLinearCaseSplit &result ) const
+{
+    for ( const auto &bound : split.getBoundTightenings() )
+    {
+        unsigned variable = bound._variable;
+        if ( _preprocessingEnabled )
+        {
+            while ( _preprocessor.variableIsMerged( variable ) )
+                variable = _preprocessor.getMergedIndex( variable );
+
+            if ( _preprocessor.variableIsFixed( variable ) )
+            {
+                double value = _preprocessor.getFixedValue( variable );
+                if ( ( bound._type == Tightening::LB && FloatUtils::gt( bound._value, value ) ) ||
+                     ( bound._type == Tightening::UB && FloatUtils::lt( bound._value, value ) ) )
+                    return false;
+                continue;
+            }
+
+            variable = _preprocessor.getNewIndex( variable );
+        }
+
+        result.storeBoundTightening( Tightening( variable, bound._value, bound._type ) );
+    }
+
+    for ( const auto &equation : split.getEquations() )
+    {
+        Equation translated( equation._type );
+        double scalar = equation._scalar;
+
+        for ( const auto &addend : equation._addends )
+        {
+            unsigned variable = addend._variable;
+            if ( _preprocessingEnabled )
+            {
+                while ( _preprocessor.variableIsMerged( variable ) )
+                    variable = _preprocessor.getMergedIndex( variable );
+
+                if ( _preprocessor.variableIsFixed( variable ) )
+                {
+                    scalar -= addend._coefficient * _preprocessor.getFixedValue( variable );
+                    continue;
+                }
+
+                variable = _preprocessor.getNewIndex( variable );
+            }
+
+            translated.addAddend( addend._coefficient, variable );
+        }
+
+        if ( translated._addends.empty() )
+        {
+            // The equation reads 0 (=, >=, <=) scalar
+            if ( ( equation._type == Equation::EQ && !FloatUtils::isZero( scalar ) ) ||
+                 ( equation._type == Equation::GE && FloatUtils::isPositive( scalar ) ) ||
+                 ( equation._type == Equation::LE && FloatUtils::isNegative( scalar ) ) )
+                return false;
+            continue;
+        }
+
+        translated.setScalar( scalar );
+        result.addEquation( translated );
+    }
+
+    return true;
+}
+
 void Engine::applySplit( const PiecewiseLinearCaseSplit &split )
 {
     ENGINE_LOG( "" );
@@ -1436,7 +1869,7 @@ void Engine::applySplit( const PiecewiseLinearCaseSplit &split )
 
     DEBUG( _tableau->verifyInvariants() );
 
-    List<Tightening> bounds = split.getBoundTightenings();
+    Vector<Tightening> bounds = split.getBoundTightenings();
     List<Equation> equations = split.getEquations();
     for ( auto &equation : equations )
     {
@@ -1530,6 +1963,7 @@ void Engine::applySplit( const PiecewiseLinearCaseSplit &split )
     _rowBoundTightener->resetBounds();
     _constraintBoundTightener->resetBounds();
 
+    List<Tightening> tightenings;
     for ( auto &bound : bounds )
     {
         unsigned variable = _tableau->getVariableAfterMerging( bound._variable );
@@ -1537,14 +1971,17 @@ void Engine::applySplit( const PiecewiseLinearCaseSplit &split )
         if ( bound._type == Tightening::LB )
         {
             ENGINE_LOG( Stringf( "x%u: lower bound set to %.3lf", variable, bound._value ).ascii() );
-            _tableau->tightenLowerBound( variable, bound._value );
         }
         else
         {
             ENGINE_LOG( Stringf( "x%u: upper bound set to %.3lf", variable, bound._value ).ascii() );
-            _tableau->tightenUpperBound( variable, bound._value );
         }
+
+        tightenings.append( Tightening( variable, bound._value, bound._type ) );
     }
+    _tableau->applyTightenings( tightenings );
+
+    _dualSimplexRequired = true;
 
     DEBUG( _tableau->verifyInvariants() );
     ENGINE_LOG( "Done with split\n" );
@@ -1555,13 +1992,8 @@ void Engine::applyAllRowTightenings()
     List<Tightening> rowTightenings;
     _rowBoundTightener->getRowTightenings( rowTightenings );
 
-    for ( const auto &tightening : rowTightenings )
-    {
-        if ( tightening._type == Tightening::LB )
-            _tableau->tightenLowerBound( tightening._variable, tightening._value );
-        else
-            _tableau->tightenUpperBound( tightening._variable, tightening._value );
-    }
+    if ( _tableau->applyTightenings( rowTightenings ) > 0 )
+        _dualSimplexRequired = true;
 }
 
 void Engine::applyAllConstraintTightenings()
@@ -1570,19 +2002,17 @@ void Engine::applyAllConstraintTightenings()
 
     _constraintBoundTightener->getConstraintTightenings( entailedTightenings );
 
-    for ( const auto &tightening : entailedTightenings )
-    {
+    for ( unsigned i = 0; i < entailedTightenings.size(); ++i )
         _statistics.incNumBoundsProposedByPlConstraints();
 
-        if ( tightening._type == Tightening::LB )
-            _tableau->tightenLowerBound( tightening._variable, tightening._value );
-        else
-            _tableau->tightenUpperBound( tightening._variable, tightening._value );
-    }
+    if ( _tableau->applyTightenings( entailedTightenings ) > 0 )
+        _dualSimplexRequired = true;
 }
 
 void Engine::applyAllBoundTightenings()
 {
+    PROFILE_SCOPE( "Engine::applyAllBoundTightenings" );
+
     struct timespec start = TimeUtils::sampleMicro();
 
     applyAllRowTightenings();
@@ -1594,6 +2024,8 @@ void Engine::applyAllBoundTightenings()
 
 bool Engine::applyAllValidConstraintCaseSplits()
 {
+    PROFILE_SCOPE( "Engine::applyAllValidConstraintCaseSplits" );
+
     struct timespec start = TimeUtils::sampleMicro();
 
     bool appliedSplit = false;
@@ -1616,6 +2048,7 @@ bool Engine::applyValidConstraintCaseSplit( PiecewiseLinearConstraint *constrain
         ENGINE_LOG( Stringf( "A constraint has become valid. Dumping constraint: %s",
                              constraintString.ascii() ).ascii() );
 
+        saveConstraintOnTrail( constraint );
         constraint->setActiveConstraint( false );
         PiecewiseLinearCaseSplit validSplit = constraint->getValidCaseSplit();
         _smtCore.recordImpliedValidSplit( validSplit );
@@ -1656,6 +2089,8 @@ bool Engine::highDegradation()
 
 void Engine::tightenBoundsOnConstraintMatrix()
 {
+    PROFILE_SCOPE( "Engine::tightenBoundsOnConstraintMatrix" );
+
     struct timespec start = TimeUtils::sampleMicro();
 
     if ( _statistics.getNumMainLoopIterations() %
@@ -1671,6 +2106,8 @@ void Engine::tightenBoundsOnConstraintMatrix()
 
 void Engine::explicitBasisBoundTightening()
 {
+    PROFILE_SCOPE( "Engine::explicitBasisBoundTightening" );
+
     struct timespec start = TimeUtils::sampleMicro();
 
     bool saturation = GlobalConfiguration::EXPLICIT_BOUND_TIGHTENING_UNTIL_SATURATION;
@@ -1697,13 +2134,22 @@ void Engine::explicitBasisBoundTightening()
 
 void Engine::performPrecisionRestoration( PrecisionRestorer::RestoreBasics restoreBasics )
 {
+    PROFILE_SCOPE( "Engine::performPrecisionRestoration" );
+
     struct timespec start = TimeUtils::sampleMicro();
 
     // debug
     double before = _degradationChecker.computeDegradation( *_tableau );
     //
 
+    // The restoration ends with the same bounds and constraint states it
+    // started with, so the undo trails remain valid. Changes made along
+    // the way should not be recorded.
+    bool stateTrailWasEnabled = stateTrailEnabled();
+    setStateTrailEnabled( false );
+
     _precisionRestorer.restorePrecision( *this, *_tableau, _smtCore, restoreBasics );
+    setStateTrailEnabled( stateTrailWasEnabled );
     struct timespec end = TimeUtils::sampleMicro();
     _statistics.addTimeForPrecisionRestoration( TimeUtils::timePassed( start, end ) );
 
@@ -1724,8 +2170,10 @@ void Engine::performPrecisionRestoration( PrecisionRestorer::RestoreBasics resto
         // First round, with basic restoration, still resulted in high degradation.
         // Try again!
         start = TimeUtils::sampleMicro();
+        setStateTrailEnabled( false );
         _precisionRestorer.restorePrecision( *this, *_tableau, _smtCore,
                                              PrecisionRestorer::DO_NOT_RESTORE_BASICS );
+        setStateTrailEnabled( stateTrailWasEnabled );
         end = TimeUtils::sampleMicro();
         _statistics.addTimeForPrecisionRestoration( TimeUtils::timePassed( start, end ) );
         _statistics.incNumPrecisionRestorations();
@@ -1825,35 +2273,153 @@ List<unsigned> Engine::getInputVariables() const
     return _preprocessedQuery.getInputVariables();
 }
 
+void Engine::storeRootBounds()
+{
+    unsigned numberOfVariables = _preprocessedQuery.getNumberOfVariables();
+    _rootLowerBounds.clear();
+    _rootUpperBounds.clear();
+    for ( unsigned i = 0; i < numberOfVariables; ++i )
+    {
+        unsigned variable = _tableau->getVariableAfterMerging( i );
+        _rootLowerBounds.append( _tableau->getLowerBound( variable ) );
+        _rootUpperBounds.append( _tableau->getUpperBound( variable ) );
+    }
+}
+
+void Engine::getRootTightenings( List<Tightening> &tightenings ) const
+{
+    // Without a split the current bounds are still root-level ones
+    bool atRoot = ( _smtCore.getStackDepth() == 0 );
+    if ( !atRoot && _rootLowerBounds.empty() )
+        return;
+
+    unsigned numberOfVariables = _preprocessedQuery.getNumberOfVariables();
+    for ( unsigned i = 0; i < numberOfVariables; ++i )
+    {
+        unsigned variable = _tableau->getVariableAfterMerging( i );
+        double lb = atRoot ? _tableau->getLowerBound( variable ) : _rootLowerBounds.get( i );
+        double ub = atRoot ? _tableau->getUpperBound( variable ) : _rootUpperBounds.get( i );
+
+        if ( FloatUtils::gt( lb, _preprocessedQuery.getLowerBound( i ) ) )
+            tightenings.append( Tightening( i, lb, Tightening::LB ) );
+        if ( FloatUtils::lt( ub, _preprocessedQuery.getUpperBound( i ) ) )
+            tightenings.append( Tightening( i, ub, Tightening::UB ) );
+    }
+}
+
 void Engine::performSimulation()
 {
+    PROFILE_SCOPE( "Engine::performSimulation" );
+
     if ( _simulationSize == 0 || !_networkLevelReasoner )
     {
         ENGINE_LOG( Stringf( "Skip simulation...").ascii() );
         return;
     }
 
-    // outer vector is for neuron
-    // inner vector is for simulation value
-    Vector<Vector<double>> simulations;
+    // The simulation inputs are stored row-major: one input vector
+    // after the other
+    unsigned inputSize = _networkLevelReasoner->getLayer( 0 )->getSize();
+    Vector<double> simulations( _simulationSize * inputSize );
 
     std::mt19937 mt( GlobalConfiguration::SIMULATION_RANDOM_SEED );
 
-    for ( unsigned i = 0; i < _networkLevelReasoner->getLayer( 0 )->getSize(); ++i )
+    for ( unsigned i = 0; i < inputSize; ++i )
     {
         std::uniform_real_distribution<double> distribution( _networkLevelReasoner->getLayer( 0 )->getLb( i ),
                                                                 _networkLevelReasoner->getLayer( 0 )->getUb( i ) ); 
-        Vector<double> simulationInput( _simulationSize );
 
         for ( unsigned j = 0; j < _simulationSize; ++j )
-            simulationInput[j] = distribution( mt );
-        simulations.append( simulationInput );
+            simulations[j * inputSize + i] = distribution( mt );
     }
-    _networkLevelReasoner->simulate( &simulations );
+    _networkLevelReasoner->simulate( simulations.data(), _simulationSize );
+}
+
+void Engine::exchangeBounds()
+{
+    PROFILE_SCOPE( "Engine::exchangeBounds" );
+
+    unsigned numberOfVariables = _preprocessedQuery.getNumberOfVariables();
+    if ( _exchangedLowerBounds.empty() )
+    {
+        // All engines start from the bounds of the preprocessed query
+        for ( unsigned i = 0; i < numberOfVariables; ++i )
+        {
+            _exchangedLowerBounds.append( _preprocessedQuery.getLowerBound( i ) );
+            _exchangedUpperBounds.append( _preprocessedQuery.getUpperBound( i ) );
+        }
+    }
+
+    // Bounds derived at the root of the search tree hold globally.
+    // Variables added since preprocessing are not shared, as they
+    // differ between engines.
+    if ( _smtCore.getStackDepth() == 0 )
+    {
+        for ( unsigned i = 0; i < numberOfVariables; ++i )
+        {
+            // Variables merged into others no longer have bounds of their own
+            if ( _tableau->getVariableAfterMerging( i ) != i )
+                continue;
+
+            double lb = _tableau->getLowerBound( i );
+            if ( FloatUtils::gt( lb, _exchangedLowerBounds[i] ) &&
+                 _boundExchange->publish( _boundExchangeParticipant,
+                                          Tightening( i, lb, Tightening::LB ) ) )
+            {
+                _exchangedLowerBounds[i] = lb;
+                _statistics.incNumExportedBounds();
+            }
+
+            double ub = _tableau->getUpperBound( i );
+            if ( FloatUtils::lt( ub, _exchangedUpperBounds[i] ) &&
+                 _boundExchange->publish( _boundExchangeParticipant,
+                                          Tightening( i, ub, Tightening::UB ) ) )
+            {
+                _exchangedUpperBounds[i] = ub;
+                _statistics.incNumExportedBounds();
+            }
+        }
+    }
+
+    List<Tightening> received;
+    _boundExchange->collect( _boundExchangeParticipant, received );
+    for ( const auto &tightening : received )
+    {
+        // Received bounds are not published back
+        unsigned variable = tightening._variable;
+        if ( tightening._type == Tightening::LB )
+        {
+            if ( tightening._value > _exchangedLowerBounds[variable] )
+                _exchangedLowerBounds[variable] = tightening._value;
+        }
+        else
+        {
+            if ( tightening._value < _exchangedUpperBounds[variable] )
+                _exchangedUpperBounds[variable] = tightening._value;
+        }
+
+        _importedTightenings.append( tightening );
+        _statistics.incNumImportedBounds();
+    }
+
+    if ( _importedTightenings.empty() )
+        return;
+
+    // Variables may have been merged since the bounds were received
+    List<Tightening> tightenings;
+    for ( const auto &tightening : _importedTightenings )
+        tightenings.append( Tightening( _tableau->getVariableAfterMerging( tightening._variable ),
+                                        tightening._value,
+                                        tightening._type ) );
+
+    if ( _tableau->applyTightenings( tightenings ) > 0 )
+        _dualSimplexRequired = true;
 }
 
 void Engine::performSymbolicBoundTightening()
 {
+    PROFILE_SCOPE( "Engine::performSymbolicBoundTightening" );
+
     if ( _symbolicBoundTighteningType == SymbolicBoundTighteningType::NONE ||
          ( !_networkLevelReasoner ) )
         return;
@@ -1877,23 +2443,10 @@ void Engine::performSymbolicBoundTightening()
     List<Tightening> tightenings;
     _networkLevelReasoner->getConstraintTightenings( tightenings );
 
-    for ( const auto &tightening : tightenings )
-    {
-
-        if ( tightening._type == Tightening::LB &&
-             FloatUtils::gt( tightening._value, _tableau->getLowerBound( tightening._variable ) ) )
-        {
-            _tableau->tightenLowerBound( tightening._variable, tightening._value );
-            ++numTightenedBounds;
-        }
+    numTightenedBounds += _tableau->applyTightenings( tightenings );
 
-        if ( tightening._type == Tightening::UB &&
-             FloatUtils::lt( tightening._value, _tableau->getUpperBound( tightening._variable ) ) )
-        {
-            _tableau->tightenUpperBound( tightening._variable, tightening._value );
-            ++numTightenedBounds;
-        }
-    }
+    if ( numTightenedBounds > 0 )
+        _dualSimplexRequired = true;
 
     struct timespec end = TimeUtils::sampleMicro();
     _statistics.addTimeForSymbolicBoundTightening( TimeUtils::timePassed( start, end ) );
@@ -1915,6 +2468,9 @@ bool Engine::shouldExitDueToTimeout( unsigned timeout ) const
 
 void Engine::reset()
 {
+    if ( stateTrailEnabled() )
+        clearStateTrail();
+
     resetStatistics();
     clearViolatedPLConstraints();
     resetSmtCore();
@@ -1945,6 +2501,8 @@ void Engine::clearViolatedPLConstraints()
 void Engine::resetSmtCore()
 {
     _smtCore.reset();
+    _tableau->setDecisionLevel( 0 );
+    _conflictExplained = false;
 }
 
 void Engine::resetExitCode()
@@ -2178,6 +2736,7 @@ PiecewiseLinearConstraint *Engine::pickSplitPLConstraintSnC( SnCDivideStrategy s
 
 bool Engine::restoreSmtState( SmtState & smtState )
 {
+    bool result = true;
     try
     {
         ASSERT( _smtCore.getStackDepth() == 0 );
@@ -2227,10 +2786,16 @@ bool Engine::restoreSmtState( SmtState & smtState )
             _exitCode = Engine::UNSAT;
             for ( PiecewiseLinearConstraint *p : _plConstraints )
                 p->setActiveConstraint( true );
-            return false;
+            result = false;
         }
     }
-    return true;
+
+    // The SMT core has copied the replayed entries
+    for ( auto &stackEntry : smtState._stack )
+        delete stackEntry;
+    smtState._stack.clear();
+
+    return result;
 }
 
 void Engine::storeSmtState( SmtState & smtState )
@@ -2242,7 +2807,7 @@ bool Engine::solveWithMILPEncoding( unsigned timeoutInSeconds )
 {
     try
     {
-        // Apply bound tightening before handing to Gurobi
+        // Apply bound tightening before handing to the MILP solver
         if ( _tableau->basisMatrixAvailable() )
         {
 	    explicitBasisBoundTightening();
@@ -2261,15 +2826,15 @@ bool Engine::solveWithMILPEncoding( unsigned timeoutInSeconds )
         return false;
     }
     
-    ENGINE_LOG( "Encoding the input query with Gurobi...\n" );
-    _gurobi = std::unique_ptr<GurobiWrapper>( new GurobiWrapper() );
+    ENGINE_LOG( "Encoding the input query with the MILP solver...\n" );
+    _gurobi = std::unique_ptr<ILPSolver>( LPSolverFactory::createLPSolver() );
     _milpEncoder = std::unique_ptr<MILPEncoder>( new MILPEncoder( *_tableau ) );
     _milpEncoder->encodeInputQuery( *_gurobi, _preprocessedQuery );
-    ENGINE_LOG( "Query encoded in Gurobi...\n" );
+    ENGINE_LOG( "Query encoded in the MILP solver...\n" );
 
     double timeoutForGurobi = ( timeoutInSeconds == 0 ? FloatUtils::infinity()
                                 : timeoutInSeconds );
-    ENGINE_LOG( Stringf( "Gurobi timeout set to %f\n", timeoutForGurobi ).ascii() )
+    ENGINE_LOG( Stringf( "MILP solver timeout set to %f\n", timeoutForGurobi ).ascii() )
     _gurobi->setTimeLimit( timeoutForGurobi );
 
     _gurobi->solve();
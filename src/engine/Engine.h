@@ -21,13 +21,15 @@
 #include "AutoProjectedSteepestEdge.h"
 #include "AutoRowBoundTightener.h"
 #include "AutoTableau.h"
+#include "ConstraintStateTrail.h"
 #include "BlandsRule.h"
+#include "BoundExchange.h"
 #include "DantzigsRule.h"
 #include "DegradationChecker.h"
 #include "DivideStrategy.h"
 #include "SnCDivideStrategy.h"
 #include "GlobalConfiguration.h"
-#include "GurobiWrapper.h"
+#include "ILPSolver.h"
 #include "IEngine.h"
 #include "InputQuery.h"
 #include "Map.h"
@@ -50,6 +52,7 @@
 class EngineState;
 class InputQuery;
 class PiecewiseLinearConstraint;
+class SparseUnsortedArrays;
 class String;
 
 class Engine : public IEngine, public SignalHandler::Signalable
@@ -86,6 +89,8 @@ public:
     void storeState( EngineState &state, bool storeAlsoTableauState ) const;
     void restoreState( const EngineState &state );
     void setNumPlConstraintsDisabledByValidSplits( unsigned numConstraints );
+    bool storeStateOnTrail( EngineState &state );
+    void saveConstraintOnTrail( PiecewiseLinearConstraint *constraint );
 
     /*
       A request from the user to terminate
@@ -111,11 +116,32 @@ public:
     */
     List<unsigned> getInputVariables() const;
 
+    /*
+      The bounds of the preprocessed query's variables that were derived
+      before the first case split of the last solve, and are tighter than
+      those of the preprocessed query.
+    */
+    void getRootTightenings( List<Tightening> &tightenings ) const;
+
     /*
       Add equations and tightenings from a split.
     */
     void applySplit( const PiecewiseLinearCaseSplit &split );
 
+    /*
+      Translate a split over the variables of the original input query
+      into a split over the variables of the preprocessed query, which
+      can then be applied. Variables fixed by the preprocessor are
+      substituted. Returns false if the split contradicts their values.
+    */
+    bool translateSplitToPreprocessedQuery( const PiecewiseLinearCaseSplit &split,
+                                            PiecewiseLinearCaseSplit &result ) const;
+
+    /*
+      Set the decision level of the bounds set from now on.
+    */
+    void setDecisionLevel( unsigned level );
+
     /*
       Reset the state of the engine, before solving a new query
       (as part of DnC mode).
@@ -137,9 +163,27 @@ public:
     */
     void setVerbosity( unsigned verbosity );
 
+    /*
+      Override the configuration read from the options, e.g. to run
+      differently configured engines on the same query. Should be
+      called before the input query is processed.
+    */
+    void setSplittingStrategy( DivideStrategy strategy );
+    void setSymbolicBoundTighteningType( SymbolicBoundTighteningType type );
+    void setConstraintViolationThreshold( unsigned threshold );
+
+    /*
+      Share the bounds derived at the root of the search tree with other
+      engines that solve the same preprocessed query, and use the bounds
+      that they share. The participant is this engine's index in the
+      exchange.
+    */
+    void setBoundExchange( BoundExchange *boundExchange, unsigned participant );
+
     /*
       Apply the stack to the newly created SmtCore, returns false if UNSAT is
-      found in this process.
+      found in this process. The entries of the stack are freed, and the
+      stack is cleared.
     */
     bool restoreSmtState( SmtState &smtState );
 
@@ -260,6 +304,23 @@ private:
     */
     bool _initialStateStored;
 
+    /*
+      Undo trail for the states of the PL constraints, used (together
+      with the tableau's bound trail) to store states incrementally.
+      The trails are only usable if no case split contains equations;
+      this is checked the first time a state is stored.
+    */
+    ConstraintStateTrail _constraintStateTrail;
+    bool _stateTrailUsabilityChecked;
+    bool _stateTrailUsable;
+
+    /*
+      The bounds that explain the last simplex failure, for conflict
+      analysis by the SMT core.
+    */
+    List<SmtCore::ExplanationBound> _conflictExplanation;
+    bool _conflictExplained;
+
     /*
       Work memory (of size m)
     */
@@ -350,9 +411,9 @@ private:
     bool _solveWithMILP;
 
     /*
-      GurobiWrapper object
+      The (MI)LP solver used to solve the query with a MILP encoding
     */
-    std::unique_ptr<GurobiWrapper> _gurobi;
+    std::unique_ptr<ILPSolver> _gurobi;
 
     /*
       MILPEncoder
@@ -364,12 +425,63 @@ private:
     */
     unsigned _simulationSize;
 
+    /*
+      The exchange through which globally valid bounds are shared with
+      other engines, if any, and this engine's index in it.
+    */
+    BoundExchange *_boundExchange;
+    unsigned _boundExchangeParticipant;
+
+    /*
+      The bounds received through the exchange. Backtracking may undo
+      them, so they are applied again on every exchange.
+    */
+    List<Tightening> _importedTightenings;
+
+    /*
+      The tightest bounds of each variable of the preprocessed query
+      that have gone through the exchange, in either direction.
+    */
+    Vector<double> _exchangedLowerBounds;
+    Vector<double> _exchangedUpperBounds;
+
+    /*
+      Publish the bounds tightened at the root of the search tree, and
+      apply the bounds published by the other engines.
+    */
+    void exchangeBounds();
+
+    /*
+      The bounds of the preprocessed query's variables just before the
+      first case split of the current solve, if one was performed.
+    */
+    Vector<double> _rootLowerBounds;
+    Vector<double> _rootUpperBounds;
+    void storeRootBounds();
+
+    /*
+      True iff variable bounds have changed (due to a case split or
+      bound tightening) since the last dual simplex phase
+    */
+    bool _dualSimplexRequired;
+
     /*
       Perform a simplex step: compute the cost function, pick the
       entering and leaving variables and perform a pivot.
     */
     void performSimplexStep();
 
+    /*
+      Perform a dual simplex phase: starting from the current basis,
+      which bound changes leave dual feasible, repeatedly pivot an
+      out-of-bounds basic variable onto its violated bound. The phase
+      stops when all basic variables are within bounds, when no
+      eligible entering variable exists, or after a fixed number of
+      iterations; any remaining infeasibility is left to the primal
+      simplex steps.
+    */
+    void performDualSimplexPhase();
+
     /*
       Perform a constraint-fixing step: select a violated piece-wise
       linear constraint and attempt to fix it.
@@ -456,6 +568,27 @@ private:
     */
     void storeInitialEngineState();
     void performPrecisionRestoration( PrecisionRestorer::RestoreBasics restoreBasics );
+
+    /*
+      Helpers for the undo trails: check whether they can be used for
+      the current query, and turn them on/off.
+    */
+    bool stateTrailUsable();
+
+    /*
+      Conflict analysis helpers. When the simplex fails, the violated
+      bounds of the out-of-bounds basic variables and the bounds that
+      block the nonbasic variables with non-zero cost explain the
+      failure. When the bounds of a variable are invalid, they explain
+      the failure themselves. The explanation is passed to the SMT core
+      before it pops.
+    */
+    bool explainSimplexConflict( List<SmtCore::ExplanationBound> &explanation );
+    bool explainInvalidBounds( List<SmtCore::ExplanationBound> &explanation ) const;
+    void analyzeConflict();
+    bool stateTrailEnabled() const;
+    void setStateTrailEnabled( bool enabled );
+    void clearStateTrail();
     bool basisRestorationNeeded() const;
 
     /*
@@ -512,11 +645,11 @@ private:
     void invokePreprocessor( const InputQuery &inputQuery, bool preprocess );
     void printInputBounds( const InputQuery &inputQuery ) const;
     void storeEquationsInDegradationChecker();
-    void removeRedundantEquations( const double *constraintMatrix );
-    void selectInitialVariablesForBasis( const double *constraintMatrix, List<unsigned> &initialBasis, List<unsigned> &basicRows );
-    void initializeTableau( const double *constraintMatrix, const List<unsigned> &initialBasis );
+    void removeRedundantEquations( const SparseUnsortedArrays &constraintMatrix );
+    void selectInitialVariablesForBasis( const SparseUnsortedArrays &constraintMatrix, List<unsigned> &initialBasis, List<unsigned> &basicRows );
+    void initializeTableau( const SparseUnsortedArrays &constraintMatrix, const List<unsigned> &initialBasis );
     void initializeNetworkLevelReasoning();
-    double *createConstraintMatrix();
+    void createConstraintMatrix( SparseUnsortedArrays &constraintMatrix );
     void addAuxiliaryVariables();
     void augmentInitialBasisIfNeeded( List<unsigned> &initialBasis, const List<unsigned> &basicRows );
     void performMILPSolverBoundedTightening();
@@ -16,10 +16,21 @@
 #include "EngineState.h"
 
 EngineState::EngineState()
+    : _tableauStateIsStored( false )
+    , _numPlConstraintsDisabledByValidSplits( 0 )
+    , _storedOnTrail( false )
+    , _boundTrailPosition( 0 )
+    , _constraintTrailPosition( 0 )
+    , _stateId( 0 )
 {
 }
 
 EngineState::~EngineState()
+{
+    reset();
+}
+
+void EngineState::reset()
 {
     for ( auto &kv : _plConstraintToState )
     {
@@ -30,6 +41,16 @@ EngineState::~EngineState()
             kv.second = NULL;
         }
     }
+    _plConstraintToState.clear();
+
+    _tableauState.freeMemoryIfNeeded();
+    _tableauStateIsStored = false;
+
+    _numPlConstraintsDisabledByValidSplits = 0;
+    _storedOnTrail = false;
+    _boundTrailPosition = 0;
+    _constraintTrailPosition = 0;
+    _stateId = 0;
 }
 
 //
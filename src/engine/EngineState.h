@@ -27,6 +27,11 @@ public:
     EngineState();
     ~EngineState();
 
+    /*
+      Discard the stored state, so that the object may be reused.
+    */
+    void reset();
+
     /*
       The state of the tableau
     */
@@ -39,6 +44,14 @@ public:
     Map<PiecewiseLinearConstraint *, PiecewiseLinearConstraint *> _plConstraintToState;
     unsigned _numPlConstraintsDisabledByValidSplits;
 
+    /*
+      If the state was stored on the engine's undo trails rather than
+      copied, these are the positions of the trails to roll back to.
+    */
+    bool _storedOnTrail;
+    unsigned _boundTrailPosition;
+    unsigned _constraintTrailPosition;
+
     /*
       A unique ID allocated to every state that is stored, for
       debugging purposes. These are assigned by the SMT core.
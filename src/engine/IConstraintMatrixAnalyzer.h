@@ -19,6 +19,7 @@
 #include "List.h"
 #include "Set.h"
 
+class SparseUnsortedArrays;
 class SparseUnsortedList;
 
 class IConstraintMatrixAnalyzer
@@ -28,6 +29,7 @@ public:
 
     virtual void analyze( const double *matrix, unsigned m, unsigned n ) = 0;
     virtual void analyze( const SparseUnsortedList **matrix, unsigned m, unsigned n ) = 0;
+    virtual void analyze( const SparseUnsortedArrays *matrix, unsigned m, unsigned n ) = 0;
     virtual List<unsigned> getIndependentColumns() const = 0;
     virtual Set<unsigned> getRedundantRows() const = 0;
 };
@@ -28,7 +28,9 @@ class EngineState;
 class Equation;
 class PiecewiseLinearCaseSplit;
 class SmtState;
+class Statistics;
 class PiecewiseLinearConstraint;
+class Tightening;
 
 class IEngine
 {
@@ -57,6 +59,22 @@ public:
     virtual void restoreState( const EngineState &state ) = 0;
     virtual void setNumPlConstraintsDisabledByValidSplits( unsigned numConstraints ) = 0;
 
+    /*
+      Store the state incrementally, by marking the current positions of
+      the engine's undo trails. Returns false if the trails cannot be
+      used, in which case the state should be stored with storeState().
+      Any constraint that is about to be changed by something other than
+      a bound update must first be passed to saveConstraintOnTrail().
+    */
+    virtual bool storeStateOnTrail( EngineState &state ) = 0;
+    virtual void saveConstraintOnTrail( PiecewiseLinearConstraint *constraint ) = 0;
+
+    /*
+      Inform the engine of the current decision level (the depth of the
+      SMT stack), at which the bounds it sets from now on originate.
+    */
+    virtual void setDecisionLevel( unsigned level ) = 0;
+
     /*
       Store the current stack of the smtCore into smtState
     */
@@ -64,7 +82,8 @@ public:
 
     /*
       Apply the stack to the newly created SmtCore, returns false if UNSAT is
-      found in this process.
+      found in this process. The entries of the stack are freed, and the
+      stack is cleared.
     */
     virtual bool restoreSmtState( SmtState &smtState ) = 0;
 
@@ -85,6 +104,18 @@ public:
     virtual void reset() = 0;
     virtual List<unsigned> getInputVariables() const = 0;
 
+    /*
+      For DnC: the bounds derived before the first case split of the
+      last solve, which hold wherever the solved subquery holds.
+    */
+    virtual void getRootTightenings( List<Tightening> &tightenings ) const = 0;
+
+    /*
+      For DnC: the statistics of the last solve, used to estimate how far
+      it got.
+    */
+    virtual const Statistics *getStatistics() const = 0;
+
     /*
       Pick the piecewise linear constraint for internal splitting
     */
@@ -18,17 +18,20 @@
 
 #include "List.h"
 #include "Set.h"
+#include "Vector.h"
 
 class EntrySelectionStrategy;
 class Equation;
 class ICostFunctionManager;
 class PiecewiseLinearCaseSplit;
 class SparseMatrix;
+class SparseUnsortedArrays;
 class SparseUnsortedList;
 class SparseVector;
 class Statistics;
 class TableauRow;
 class TableauState;
+class Tightening;
 
 class ITableau
 {
@@ -51,6 +54,25 @@ public:
         BASIC_ASSIGNMENT_UPDATED = 2,
     };
 
+    /*
+      A batch of bound tightenings, as reported to the variable
+      watchers: the variables whose bounds changed, a bitmap (indexed
+      by variable) indicating which of their bounds changed, and the
+      tableau's bound arrays, which hold the new values.
+    */
+    struct BoundUpdates
+    {
+        enum {
+            LOWER = 1,
+            UPPER = 2,
+        };
+
+        const Vector<unsigned> &_variables;
+        const char *_changed;
+        const double *_lowerBounds;
+        const double *_upperBounds;
+    };
+
     /*
       A class for allowing objects (e.g., piecewise linear
       constraints) to register and receive updates regarding changes
@@ -71,6 +93,24 @@ public:
         */
         virtual void notifyLowerBound( unsigned /* variable */, double /* bound */ ) {}
         virtual void notifyUpperBound( unsigned /* variable */, double /* bound */ ) {}
+
+        /*
+          This callback will be invoked once per batch of bound
+          tightenings, for watchers of all variables. The default
+          implementation forwards each changed bound to the callbacks
+          above; watchers that keep their own per-variable data can
+          override it and read the bounds directly.
+        */
+        virtual void notifyBounds( const BoundUpdates &updates )
+        {
+            for ( const auto &variable : updates._variables )
+            {
+                if ( updates._changed[variable] & BoundUpdates::LOWER )
+                    notifyLowerBound( variable, updates._lowerBounds[variable] );
+                if ( updates._changed[variable] & BoundUpdates::UPPER )
+                    notifyUpperBound( variable, updates._upperBounds[variable] );
+            }
+        }
     };
 
     class ResizeWatcher
@@ -95,6 +135,7 @@ public:
 
     virtual void setDimensions( unsigned m, unsigned n ) = 0;
     virtual void setConstraintMatrix( const double *A ) = 0;
+    virtual void setConstraintMatrix( const SparseUnsortedArrays *A ) = 0;
     virtual void setRightHandSide( const double *b ) = 0;
     virtual void setRightHandSide( unsigned index, double value ) = 0;
     virtual void markAsBasic( unsigned variable ) = 0;
@@ -109,6 +150,7 @@ public:
     virtual void setUpperBound( unsigned variable, double value ) = 0;
     virtual void tightenLowerBound( unsigned variable, double value ) = 0;
     virtual void tightenUpperBound( unsigned variable, double value ) = 0;
+    virtual unsigned applyTightenings( const List<Tightening> &tightenings ) = 0;
     virtual unsigned getBasicStatus( unsigned basic ) = 0;
     virtual unsigned getBasicStatusByIndex( unsigned basicIndex ) = 0;
     virtual bool existsBasicOutOfBounds() const = 0;
@@ -128,6 +170,10 @@ public:
     virtual void setChangeRatio( double changeRatio ) = 0;
     virtual bool performingFakePivot() const = 0;
     virtual void performPivot() = 0;
+    virtual void resetDualSteepestEdgeWeights() = 0;
+    virtual bool pickDualLeavingVariable() = 0;
+    virtual bool dualRatioTest() = 0;
+    virtual void updateDualSteepestEdgeWeights() = 0;
     virtual double ratioConstraintPerBasic( unsigned basicIndex, double coefficient, bool decrease ) = 0;
     virtual bool isBasic( unsigned variable ) const = 0;
     virtual void setNonBasicAssignment( unsigned variable, double value, bool updateBasics ) = 0;
@@ -179,6 +225,15 @@ public:
     virtual void mergeColumns( unsigned x1, unsigned x2 ) = 0;
     virtual bool areLinearlyDependent( unsigned x1, unsigned x2, double &coefficient, double &inverseCoefficient ) = 0;
     virtual unsigned getVariableAfterMerging( unsigned variable ) const = 0;
+    virtual void setBoundTrailEnabled( bool enabled ) = 0;
+    virtual bool boundTrailEnabled() const = 0;
+    virtual unsigned getBoundTrailSize() const = 0;
+    virtual void undoBoundTrail( unsigned position ) = 0;
+    virtual void clearBoundTrail() = 0;
+    virtual void setDecisionLevel( unsigned level ) = 0;
+    virtual unsigned getDecisionLevel() const = 0;
+    virtual unsigned getLowerBoundLevel( unsigned variable ) const = 0;
+    virtual unsigned getUpperBoundLevel( unsigned variable ) const = 0;
 };
 
 #endif // __ITableau_h__
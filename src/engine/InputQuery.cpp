@@ -14,13 +14,19 @@
  **/
 
 #include "AutoFile.h"
+#include "BinaryQueryFormat.h"
+#include "ConstSimpleData.h"
 #include "Debug.h"
+#include "File.h"
 #include "FloatUtils.h"
 #include "InputQuery.h"
 #include "MStringf.h"
 #include "MarabouError.h"
 #include "MaxConstraint.h"
 
+#include <cstdint>
+#include <vector>
+
 #define INPUT_QUERY_LOG( x, ... ) LOG( GlobalConfiguration::INPUT_QUERY_LOGGING, "Input Query: %s\n", x )
 
 InputQuery::InputQuery()
@@ -321,7 +327,15 @@ void InputQuery::storeDebuggingSolution( unsigned variable, double value )
     _debuggingSolution[variable] = value;
 }
 
-void InputQuery::saveQuery( const String &fileName )
+void InputQuery::saveQuery( const String &fileName, QueryFileFormat format )
+{
+    if ( format == QueryFileFormat::BINARY )
+        saveQueryAsBinary( fileName );
+    else
+        saveQueryAsText( fileName );
+}
+
+void InputQuery::saveQueryAsText( const String &fileName )
 {
     AutoFile queryFile( fileName );
     queryFile->open( IFile::MODE_WRITE_TRUNCATE );
@@ -408,6 +422,137 @@ void InputQuery::saveQuery( const String &fileName )
     queryFile->close();
 }
 
+void InputQuery::saveQueryAsBinary( const String &fileName )
+{
+    BinaryQueryFormat::Header header;
+    BinaryQueryFormat::initializeHeader( header );
+
+    header._numberOfVariables = _numberOfVariables;
+    header._numInputVariables = getNumInputVariables();
+    header._numOutputVariables = getNumOutputVariables();
+    header._numLowerBounds = _lowerBounds.size();
+    header._numUpperBounds = _upperBounds.size();
+    header._numEquations = _equations.size();
+    header._numConstraints = _plConstraints.size();
+
+    for ( const auto &equation : _equations )
+        header._numAddends += equation._addends.size();
+
+    List<String> serializedConstraints;
+    for ( const auto &constraint : _plConstraints )
+    {
+        serializedConstraints.append( constraint->serializeToString() );
+        header._constraintDataSize += serializedConstraints.back().length();
+    }
+
+    BinaryQueryFormat::Layout layout;
+    BinaryQueryFormat::computeLayout( header, layout );
+
+    if ( layout._totalSize > SIZE_MAX )
+        throw MarabouError( MarabouError::INVALID_BINARY_QUERY_FILE, "Query too large to save" );
+
+    // Lay out the entire file in memory, and then write it at once
+    std::vector<char> buffer( (size_t)layout._totalSize, 0 );
+    char *data = buffer.data();
+
+    memcpy( data, &header, sizeof(header) );
+
+    BinaryQueryFormat::IndexedVariable *inputVariables =
+        (BinaryQueryFormat::IndexedVariable *)( data + layout._inputVariables );
+    unsigned i = 0;
+    for ( const auto &inVar : getInputVariables() )
+    {
+        inputVariables[i]._index = i;
+        inputVariables[i]._variable = inVar;
+        ++i;
+    }
+
+    BinaryQueryFormat::IndexedVariable *outputVariables =
+        (BinaryQueryFormat::IndexedVariable *)( data + layout._outputVariables );
+    i = 0;
+    for ( const auto &outVar : getOutputVariables() )
+    {
+        outputVariables[i]._index = i;
+        outputVariables[i]._variable = outVar;
+        ++i;
+    }
+
+    uint32_t *boundVariables = (uint32_t *)( data + layout._lowerBoundVariables );
+    double *boundValues = (double *)( data + layout._lowerBoundValues );
+    i = 0;
+    for ( const auto &lb : _lowerBounds )
+    {
+        boundVariables[i] = lb.first;
+        boundValues[i] = lb.second;
+        ++i;
+    }
+
+    boundVariables = (uint32_t *)( data + layout._upperBoundVariables );
+    boundValues = (double *)( data + layout._upperBoundValues );
+    i = 0;
+    for ( const auto &ub : _upperBounds )
+    {
+        boundVariables[i] = ub.first;
+        boundValues[i] = ub.second;
+        ++i;
+    }
+
+    BinaryQueryFormat::EquationRecord *equations =
+        (BinaryQueryFormat::EquationRecord *)( data + layout._equations );
+    uint32_t *addendVariables = (uint32_t *)( data + layout._addendVariables );
+    double *addendCoefficients = (double *)( data + layout._addendCoefficients );
+    uint64_t addend = 0;
+    i = 0;
+    for ( const auto &e : _equations )
+    {
+        equations[i]._type = e._type;
+        equations[i]._numAddends = e._addends.size();
+        equations[i]._firstAddend = addend;
+        equations[i]._scalar = e._scalar;
+
+        for ( const auto &a : e._addends )
+        {
+            addendVariables[addend] = a._variable;
+            addendCoefficients[addend] = a._coefficient;
+            ++addend;
+        }
+
+        ++i;
+    }
+
+    BinaryQueryFormat::ConstraintRecord *constraints =
+        (BinaryQueryFormat::ConstraintRecord *)( data + layout._constraints );
+    uint64_t offset = 0;
+    i = 0;
+    for ( const auto &serialized : serializedConstraints )
+    {
+        constraints[i]._offset = offset;
+        constraints[i]._length = serialized.length();
+        memcpy( data + layout._constraintData + offset, serialized.ascii(), serialized.length() );
+        offset += serialized.length();
+        ++i;
+    }
+
+    // Binary files are always written to disk directly, as they are
+    // loaded by mapping them into memory
+    File queryFile( fileName );
+    queryFile.open( IFile::MODE_WRITE_TRUNCATE );
+
+    enum {
+        MAX_WRITE_SIZE = 1 << 26,
+    };
+
+    for ( uint64_t written = 0; written < layout._totalSize; written += MAX_WRITE_SIZE )
+    {
+        uint64_t chunk = layout._totalSize - written;
+        if ( chunk > MAX_WRITE_SIZE )
+            chunk = MAX_WRITE_SIZE;
+        queryFile.write( ConstSimpleData( data + written, chunk ) );
+    }
+
+    queryFile.close();
+}
+
 void InputQuery::markInputVariable( unsigned variable, unsigned inputIndex )
 {
     _variableToInputIndex[variable] = inputIndex;
@@ -599,6 +744,98 @@ NLR::NetworkLevelReasoner *InputQuery::getNetworkLevelReasoner() const
     return _networkLevelReasoner;
 }
 
+void InputQuery::evaluateNetwork( const double *inputs, double *outputs, unsigned batchSize )
+{
+    if ( !_networkLevelReasoner && !constructNetworkLevelReasoner() )
+        throw MarabouError( MarabouError::NETWORK_LEVEL_REASONER_NOT_AVAILABLE,
+                            "The constraints of the query cannot be arranged into layers" );
+
+    if ( batchSize == 0 )
+        return;
+
+    NLR::NetworkLevelReasoner *nlr = _networkLevelReasoner;
+    unsigned numInputs = getNumInputVariables();
+    unsigned numOutputs = getNumOutputVariables();
+
+    /*
+      The input layer is ordered by variable, not by input index, and
+      the outputs can be any neurons of the network. The vectors are
+      only copied when these orders differ.
+    */
+    const NLR::Layer *inputLayer = nlr->getLayer( 0 );
+    Vector<unsigned> inputNeurons;
+    bool inputsInOrder = true;
+    for ( unsigned i = 0; i < numInputs; ++i )
+    {
+        unsigned neuron = inputLayer->variableToNeuron( inputVariableByIndex( i ) );
+        inputNeurons.append( neuron );
+        inputsInOrder = inputsInOrder && ( neuron == i );
+    }
+
+    unsigned lastLayerIndex = nlr->getNumberOfLayers() - 1;
+    const NLR::Layer *lastLayer = nlr->getLayer( lastLayerIndex );
+    bool outputsInOrder = ( lastLayer->getSize() == numOutputs );
+    for ( unsigned i = 0; outputsInOrder && i < numOutputs; ++i )
+    {
+        outputsInOrder = lastLayer->neuronHasVariable( i ) &&
+            lastLayer->neuronToVariable( i ) == outputVariableByIndex( i );
+    }
+
+    Vector<NLR::NeuronIndex> outputNeurons;
+    if ( !outputsInOrder )
+    {
+        Map<unsigned, NLR::NeuronIndex> variableToNeuron;
+        for ( unsigned layer = 0; layer <= lastLayerIndex; ++layer )
+        {
+            const NLR::Layer *current = nlr->getLayer( layer );
+            for ( unsigned neuron = 0; neuron < current->getSize(); ++neuron )
+            {
+                if ( current->neuronHasVariable( neuron ) )
+                    variableToNeuron[current->neuronToVariable( neuron )] = NLR::NeuronIndex( layer, neuron );
+            }
+        }
+
+        for ( unsigned i = 0; i < numOutputs; ++i )
+        {
+            unsigned variable = outputVariableByIndex( i );
+            if ( !variableToNeuron.exists( variable ) )
+                throw MarabouError( MarabouError::NETWORK_LEVEL_REASONER_NOT_AVAILABLE,
+                                    Stringf( "Output variable %u is not computed by the network",
+                                             variable ).ascii() );
+            outputNeurons.append( variableToNeuron[variable] );
+        }
+    }
+
+    std::vector<double> permutedInputs;
+    if ( !inputsInOrder )
+    {
+        permutedInputs.resize( (size_t)batchSize * numInputs );
+        for ( unsigned k = 0; k < batchSize; ++k )
+        {
+            for ( unsigned i = 0; i < numInputs; ++i )
+                permutedInputs[(size_t)k * numInputs + inputNeurons[i]] = inputs[(size_t)k * numInputs + i];
+        }
+        inputs = permutedInputs.data();
+    }
+
+    if ( outputsInOrder )
+    {
+        nlr->evaluateBatch( inputs, outputs, batchSize );
+        return;
+    }
+
+    std::vector<double> lastLayerOutputs( (size_t)batchSize * lastLayer->getSize() );
+    nlr->evaluateBatch( inputs, lastLayerOutputs.data(), batchSize );
+
+    // Every layer keeps the assignment of the whole batch
+    for ( unsigned i = 0; i < numOutputs; ++i )
+    {
+        const NLR::Layer *layer = nlr->getLayer( outputNeurons[i]._layer );
+        for ( unsigned k = 0; k < batchSize; ++k )
+            outputs[(size_t)k * numOutputs + i] = layer->getBatchAssignment( outputNeurons[i]._neuron, k );
+    }
+}
+
 bool InputQuery::constructNetworkLevelReasoner()
 {
     INPUT_QUERY_LOG( "PP: constructing an NLR... " );
@@ -653,6 +890,9 @@ bool InputQuery::constructNetworkLevelReasoner()
                       count,
                       getNumberOfVariables() ).ascii() );
 
+        if ( GlobalConfiguration::NETWORK_LEVEL_REASONER_DETECT_CONVOLUTIONS )
+            nlr->detectConvolutionLayers();
+
         _networkLevelReasoner = nlr;
     }
     else
@@ -22,6 +22,7 @@
 #include "Map.h"
 #include "NetworkLevelReasoner.h"
 #include "PiecewiseLinearConstraint.h"
+#include "QueryFileFormat.h"
 
 class InputQuery
 {
@@ -104,8 +105,10 @@ public:
 
     /*
       Serializes the query to a file which can then be loaded using QueryLoader.
+      The text format is meant for interchange; the binary format (see
+      BinaryQueryFormat.h) is much faster to load.
     */
-    void saveQuery( const String &fileName );
+    void saveQuery( const String &fileName, QueryFileFormat format = QueryFileFormat::TEXT );
 
     /*
       Print input and output bounds
@@ -134,6 +137,17 @@ public:
     void setNetworkLevelReasoner( NLR::NetworkLevelReasoner *nlr );
     NLR::NetworkLevelReasoner *getNetworkLevelReasoner() const;
 
+    /*
+      Evaluate the network of the query for a batch of inputs, through
+      its network level reasoner, without solving the query. The inputs
+      are stored row-major, one vector per point, ordered by input
+      index; the outputs are stored likewise, ordered by output index.
+      The network level reasoner is constructed on the first call, and
+      a MarabouError is thrown if that is impossible, or if an output
+      variable is not computed by the network.
+    */
+    void evaluateNetwork( const double *inputs, double *outputs, unsigned batchSize );
+
 private:
     unsigned _numberOfVariables;
     List<Equation> _equations;
@@ -148,6 +162,12 @@ private:
     */
     void freeConstraintsIfNeeded();
 
+    /*
+      Serialize the query in the text or binary format
+    */
+    void saveQueryAsText( const String &fileName );
+    void saveQueryAsBinary( const String &fileName );
+
     /*
       Methods called by constructNetworkLevelReasoner
     */
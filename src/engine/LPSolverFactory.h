@@ -0,0 +1,40 @@
+/*********************                                                        */
+/*! \file LPSolverFactory.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#ifndef __LPSolverFactory_h__
+#define __LPSolverFactory_h__
+
+#include "ILPSolver.h"
+#include "LPSolverType.h"
+
+class LPSolverFactory
+{
+public:
+    /*
+      Create an (MI)LP solver of the type selected by the options
+    */
+    static ILPSolver *createLPSolver();
+    static ILPSolver *createLPSolver( LPSolverType type );
+};
+
+#endif // __LPSolverFactory_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,31 @@
+/*********************                                                        */
+/*! \file LPSolverType.h
+** \verbatim
+** Top contributors (to current version):
+**   Guy Katz
+** This file is part of the Marabou project.
+** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved. See the file COPYING in the top-level source
+** directory for licensing information.\endverbatim
+**
+** [[ Add lengthier description here ]]
+
+**/
+
+#ifndef __LPSolverType_h__
+#define __LPSolverType_h__
+
+/*
+  The (MI)LP solvers available for LP-based bound tightening and for
+  solving queries with a MILP encoding
+*/
+enum class LPSolverType
+{
+     // The in-tree simplex-based solver
+     NATIVE = 0,
+     // Gurobi, only available when compiled with ENABLE_GUROBI
+     GUROBI = 1,
+};
+
+#endif // __LPSolverType_h__
@@ -39,7 +39,7 @@ void LargestIntervalDivider::createSubQueries( unsigned numNewSubqueries,
 
     // Create the first input region from the previous case split
     InputRegion region;
-    List<Tightening> bounds = previousSplit.getBoundTightenings();
+    const Vector<Tightening> &bounds = previousSplit.getBoundTightenings();
     for ( const auto &bound : bounds )
     {
         if ( bound._type == Tightening::LB )
@@ -21,7 +21,7 @@ MILPEncoder::MILPEncoder( const ITableau &tableau )
     : _tableau( tableau )
 {}
 
-void MILPEncoder::encodeInputQuery( GurobiWrapper &gurobi,
+void MILPEncoder::encodeInputQuery( ILPSolver &gurobi,
                                     const InputQuery &inputQuery )
 {
     gurobi.reset();
@@ -54,7 +54,7 @@ void MILPEncoder::encodeInputQuery( GurobiWrapper &gurobi,
             break;
         default:
             throw MarabouError( MarabouError::UNSUPPORTED_PIECEWISE_LINEAR_CONSTRAINT,
-                                "GurobiWrapper::encodeInputQuery: "
+                                "MILPEncoder::encodeInputQuery: "
                                 "Only ReLU and Max are supported\n" );
         }
     }
@@ -67,12 +67,12 @@ String MILPEncoder::getVariableNameFromVariable( unsigned variable )
     return _variableToVariableName[variable];
 }
 
-void MILPEncoder::encodeEquation( GurobiWrapper &gurobi, const Equation &equation )
+void MILPEncoder::encodeEquation( ILPSolver &gurobi, const Equation &equation )
 {
-    List<GurobiWrapper::Term> terms;
+    List<ILPSolver::Term> terms;
     double scalar = equation._scalar;
     for ( const auto &term : equation._addends )
-        terms.append( GurobiWrapper::Term
+        terms.append( ILPSolver::Term
                       ( term._coefficient,
                         Stringf( "x%u", term._variable ) ) );
     switch ( equation._type )
@@ -91,7 +91,7 @@ void MILPEncoder::encodeEquation( GurobiWrapper &gurobi, const Equation &equatio
     }
 }
 
-void MILPEncoder::encodeReLUConstraint( GurobiWrapper &gurobi, ReluConstraint *relu)
+void MILPEncoder::encodeReLUConstraint( ILPSolver &gurobi, ReluConstraint *relu)
 {
 
     if ( !relu->isActive() || relu->phaseFixed() )
@@ -108,26 +108,26 @@ void MILPEncoder::encodeReLUConstraint( GurobiWrapper &gurobi, ReluConstraint *r
     gurobi.addVariable( Stringf( "a%u", _binVarIndex ),
                         0,
                         1,
-                        GurobiWrapper::BINARY );
+                        ILPSolver::BINARY );
 
     unsigned sourceVariable = relu->getB();
     unsigned targetVariable = relu->getF();
     double sourceLb = _tableau.getLowerBound( sourceVariable );
     double sourceUb = _tableau.getUpperBound( sourceVariable );
 
-    List<GurobiWrapper::Term> terms;
-    terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-    terms.append( GurobiWrapper::Term( -1, Stringf( "x%u", sourceVariable ) ) );
-    terms.append( GurobiWrapper::Term( -sourceLb, Stringf( "a%u", _binVarIndex ) ) );
+    List<ILPSolver::Term> terms;
+    terms.append( ILPSolver::Term( 1, Stringf( "x%u", targetVariable ) ) );
+    terms.append( ILPSolver::Term( -1, Stringf( "x%u", sourceVariable ) ) );
+    terms.append( ILPSolver::Term( -sourceLb, Stringf( "a%u", _binVarIndex ) ) );
     gurobi.addLeqConstraint( terms, -sourceLb );
 
     terms.clear();
-    terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-    terms.append( GurobiWrapper::Term( -sourceUb, Stringf( "a%u", _binVarIndex++ ) ) );
+    terms.append( ILPSolver::Term( 1, Stringf( "x%u", targetVariable ) ) );
+    terms.append( ILPSolver::Term( -sourceUb, Stringf( "a%u", _binVarIndex++ ) ) );
     gurobi.addLeqConstraint( terms, 0 );
 }
 
-void MILPEncoder::encodeMaxConstraint( GurobiWrapper &gurobi, MaxConstraint *max )
+void MILPEncoder::encodeMaxConstraint( ILPSolver &gurobi, MaxConstraint *max )
 {
     if ( !max->isActive() )
         return;
@@ -144,7 +144,7 @@ void MILPEncoder::encodeMaxConstraint( GurobiWrapper &gurobi, MaxConstraint *max
     std::priority_queue<qtype, std::vector<qtype>, decltype( cmp )> ubq( cmp );
 
     // terms for Gurobi
-    List<GurobiWrapper::Term> terms;
+    List<ILPSolver::Term> terms;
 
     for ( const auto &x : xs ) 
     {
@@ -154,9 +154,9 @@ void MILPEncoder::encodeMaxConstraint( GurobiWrapper &gurobi, MaxConstraint *max
         gurobi.addVariable( Stringf( "a%u_%u", _binVarIndex, x ),
                             0,
                             1,
-                            GurobiWrapper::BINARY );
+                            ILPSolver::BINARY );
 
-        terms.append( GurobiWrapper::Term( 1, Stringf( "a%u_%u", _binVarIndex, x ) ) );
+        terms.append( ILPSolver::Term( 1, Stringf( "a%u_%u", _binVarIndex, x ) ) );
         ubq.push( { _tableau.getUpperBound( x ), x } );
     }
 
@@ -178,9 +178,9 @@ void MILPEncoder::encodeMaxConstraint( GurobiWrapper &gurobi, MaxConstraint *max
             umax = ubMax1.first;
         else
             umax = ubMax2.first;
-        terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", y ) ) );
-        terms.append( GurobiWrapper::Term( -1, Stringf( "x%u", x ) ) );
-        terms.append( GurobiWrapper::Term( umax - _tableau.getLowerBound( x ), Stringf( "a%u_%u", _binVarIndex, x ) ) );
+        terms.append( ILPSolver::Term( 1, Stringf( "x%u", y ) ) );
+        terms.append( ILPSolver::Term( -1, Stringf( "x%u", x ) ) );
+        terms.append( ILPSolver::Term( umax - _tableau.getLowerBound( x ), Stringf( "a%u_%u", _binVarIndex, x ) ) );
         gurobi.addLeqConstraint( terms, umax - _tableau.getLowerBound( x ) );
 
         terms.clear();
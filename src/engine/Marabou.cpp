@@ -20,6 +20,7 @@
 #include "MStringf.h"
 #include "Marabou.h"
 #include "Options.h"
+#include "Profiler.h"
 #include "PropertyParser.h"
 #include "MarabouError.h"
 #include "QueryLoader.h"
@@ -31,6 +32,7 @@
 Marabou::Marabou()
     : _acasParser( NULL )
     , _engine()
+    , _portfolioManager( NULL )
 {
 }
 
@@ -41,10 +43,21 @@ Marabou::~Marabou()
         delete _acasParser;
         _acasParser = NULL;
     }
+
+    if ( _portfolioManager )
+    {
+        delete _portfolioManager;
+        _portfolioManager = NULL;
+    }
 }
 
 void Marabou::run()
 {
+    String traceFilePath = Options::get()->getString( Options::TRACE_FILE );
+    String depthHistogramFilePath = Options::get()->getString( Options::DEPTH_HISTOGRAM_FILE );
+    if ( traceFilePath != "" || depthHistogramFilePath != "" )
+        Profiler::enable( GlobalConfiguration::PROFILER_EVENTS_PER_THREAD );
+
     struct timespec start = TimeUtils::sampleMicro();
 
     prepareInputQuery();
@@ -54,6 +67,15 @@ void Marabou::run()
 
     unsigned long long totalElapsed = TimeUtils::timePassed( start, end );
     displayResults( totalElapsed );
+
+    if ( Profiler::enabled() )
+    {
+        Profiler::disable();
+        if ( traceFilePath != "" )
+            Profiler::writeChromeTrace( traceFilePath );
+        if ( depthHistogramFilePath != "" )
+            Profiler::writeDepthHistograms( depthHistogramFilePath );
+    }
 }
 
 void Marabou::prepareInputQuery()
@@ -110,7 +132,9 @@ void Marabou::prepareInputQuery()
     String queryDumpFilePath = Options::get()->getString( Options::QUERY_DUMP_FILE );
     if ( queryDumpFilePath.length() > 0 )
     {
-        _inputQuery.saveQuery( queryDumpFilePath );
+        _inputQuery.saveQuery( queryDumpFilePath,
+                               Options::get()->getBool( Options::BINARY_QUERY_DUMP ) ?
+                               QueryFileFormat::BINARY : QueryFileFormat::TEXT );
         printf( "\nInput query successfully dumped to file\n" );
         exit( 0 );
     }
@@ -118,6 +142,18 @@ void Marabou::prepareInputQuery()
 
 void Marabou::solveQuery()
 {
+    if ( Options::get()->getBool( Options::PORTFOLIO_MODE ) )
+    {
+        _portfolioManager = new PortfolioManager( &_inputQuery );
+        _portfolioManager->solve( Options::get()->getInt( Options::NUM_WORKERS ),
+                                  Options::get()->getInt( Options::TIMEOUT ) );
+
+        if ( _portfolioManager->getExitCode() == Engine::SAT )
+            _portfolioManager->extractSolution( _inputQuery );
+
+        return;
+    }
+
     if ( _engine.processInputQuery( _inputQuery ) )
         _engine.solve( Options::get()->getInt( Options::TIMEOUT ) );
 
@@ -125,11 +161,31 @@ void Marabou::solveQuery()
         _engine.extractSolution( _inputQuery );
 }
 
+Engine::ExitCode Marabou::getExitCode() const
+{
+    if ( _portfolioManager )
+        return _portfolioManager->getExitCode();
+
+    return _engine.getExitCode();
+}
+
+const Statistics *Marabou::getStatistics() const
+{
+    if ( _portfolioManager )
+        return _portfolioManager->getStatistics();
+
+    return _engine.getStatistics();
+}
+
 void Marabou::displayResults( unsigned long long microSecondsElapsed ) const
 {
-    Engine::ExitCode result = _engine.getExitCode();
+    Engine::ExitCode result = getExitCode();
     String resultString;
 
+    if ( _portfolioManager && _portfolioManager->getWinner() != PortfolioManager::NO_WINNER )
+        printf( "Decided by engine %d (%s)\n", _portfolioManager->getWinner(),
+                _portfolioManager->getConfiguration( _portfolioManager->getWinner() ).toString().ascii() );
+
     if ( result == Engine::UNSAT )
     {
         resultString = "unsat";
@@ -204,14 +260,27 @@ void Marabou::displayResults( unsigned long long microSecondsElapsed ) const
 
         // Field #3: number of visited tree states
         summaryFile.write( Stringf( "%u ",
-                                    _engine.getStatistics()->getNumVisitedTreeStates() ) );
+                                    getStatistics()->getNumVisitedTreeStates() ) );
 
         // Field #4: average pivot time in micro seconds
         summaryFile.write( Stringf( "%u",
-                                    _engine.getStatistics()->getAveragePivotTimeInMicro() ) );
+                                    getStatistics()->getAveragePivotTimeInMicro() ) );
 
         summaryFile.write( "\n" );
     }
+
+    // Dump the statistics, if requested
+    String statisticsFilePath = Options::get()->getString( Options::STATISTICS_FILE );
+    if ( statisticsFilePath != "" )
+    {
+        File statisticsFile( statisticsFilePath );
+        statisticsFile.open( File::MODE_WRITE_TRUNCATE );
+        statisticsFile.write( Stringf( "{\n\"result\": \"%s\",\n", resultString.ascii() ) );
+        statisticsFile.write( Stringf( "\"elapsedTime\": %llu,\n", microSecondsElapsed ) );
+        statisticsFile.write( "\"statistics\": " );
+        statisticsFile.write( getStatistics()->toJson() );
+        statisticsFile.write( "\n}\n" );
+    }
 }
 
 //
@@ -19,6 +19,7 @@
 #include "AcasParser.h"
 #include "Engine.h"
 #include "InputQuery.h"
+#include "PortfolioManager.h"
 
 class Marabou
 {
@@ -51,6 +52,12 @@ private:
     */
     void displayResults( unsigned long long microSecondsElapsed ) const;
 
+    /*
+      The result and statistics of whichever solver was used
+    */
+    Engine::ExitCode getExitCode() const;
+    const Statistics *getStatistics() const;
+
     /*
       ACAS network parser
     */
@@ -60,6 +67,11 @@ private:
       The solver
     */
     Engine _engine;
+
+    /*
+      The solver in portfolio mode
+    */
+    PortfolioManager *_portfolioManager;
 };
 
 #endif // __Marabou_h__
@@ -54,6 +54,7 @@ public:
         FILE_DOES_NOT_EXIST = 100,
         INVALID_EQUATION_TYPE = 101,
         UNSUPPORTED_PIECEWISE_LINEAR_CONSTRAINT = 102,
+        INVALID_BINARY_QUERY_FILE = 103,
 
         FEATURE_NOT_YET_SUPPORTED = 900,
 
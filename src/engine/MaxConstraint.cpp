@@ -108,6 +108,7 @@ ContextDependentPiecewiseLinearConstraint *MaxConstraint::duplicateConstraint()
     clone->_eliminatedVariables = _eliminatedVariables;
     clone->_maxValueOfEliminated = _maxValueOfEliminated;
     this->initializeDuplicateCDOs( clone );
+    copyBoundsToDuplicate( clone );
     return clone;
 }
 
@@ -118,10 +119,12 @@ void MaxConstraint::restoreState( const PiecewiseLinearConstraint *state )
     CVC4::context::CDO<bool> *activeStatus = _cdConstraintActive;
     CVC4::context::CDO<PhaseStatus> *phaseStatus = _cdPhaseStatus;
     CVC4::context::CDList<PhaseStatus> *infeasibleCases = _cdInfeasibleCases;
+    const ITableau *boundStore = _boundStore;
     *this = *max;
     _cdConstraintActive = activeStatus;
     _cdPhaseStatus = phaseStatus;
     _cdInfeasibleCases = infeasibleCases;
+    _boundStore = boundStore;
 }
 
 void MaxConstraint::registerAsWatcher( ITableau *tableau )
@@ -157,11 +160,9 @@ void MaxConstraint::notifyLowerBound( unsigned variable, double value )
     if ( _statistics )
         _statistics->incNumBoundNotificationsPlConstraints();
 
-    if ( _lowerBounds.exists( variable ) && !FloatUtils::gt( value, _lowerBounds[variable] ) )
+    if ( !updateLowerBound( variable, value ) )
         return;
 
-    _lowerBounds[variable] = value;
-
     bool maxErased = false;
 
     if ( _elements.exists( variable ) && FloatUtils::gt( value, _maxLowerBound ) )
@@ -172,8 +173,8 @@ void MaxConstraint::notifyLowerBound( unsigned variable, double value )
         {
             if ( element == variable || element == _f )
                 continue;
-            if ( _upperBounds.exists( element ) &&
-                 FloatUtils::lt( _upperBounds[element], value ) )
+            if ( existsUpperBound( element ) &&
+                 FloatUtils::lt( getUpperBound( element ), value ) )
             {
                 toRemove.append( element );
             }
@@ -215,11 +216,9 @@ void MaxConstraint::notifyUpperBound( unsigned variable, double value )
     if ( _statistics )
         _statistics->incNumBoundNotificationsPlConstraints();
 
-    if ( _upperBounds.exists( variable ) && !FloatUtils::lt( value, _upperBounds[variable] ) )
+    if ( !updateUpperBound( variable, value ) )
         return;
 
-    _upperBounds[variable] = value;
-
     if ( _elements.exists( variable ) && _f != variable && FloatUtils::lt( value, _maxLowerBound ) )
     {
         if ( _cdInfeasibleCases )
@@ -253,8 +252,8 @@ void MaxConstraint::notifyUpperBound( unsigned variable, double value )
 void MaxConstraint::getEntailedTightenings( List<Tightening> &tightenings ) const
 {
     // Lower and upper bounds for the f variable
-    double fLB = _lowerBounds.exists( _f ) ? _lowerBounds.get( _f ) : FloatUtils::negativeInfinity();
-    double fUB = _upperBounds.exists( _f ) ? _upperBounds.get( _f ) : FloatUtils::infinity();
+    double fLB = existsLowerBound( _f ) ? getLowerBound( _f ) : FloatUtils::negativeInfinity();
+    double fUB = existsUpperBound( _f ) ? getUpperBound( _f ) : FloatUtils::infinity();
 
     // Compute the maximal bounds (lower and upper) for the elements
     double maxElementLB = FloatUtils::negativeInfinity();
@@ -262,13 +261,13 @@ void MaxConstraint::getEntailedTightenings( List<Tightening> &tightenings ) cons
 
     for ( const auto &element : _elements )
     {
-        if ( _lowerBounds.exists( element ) )
-            maxElementLB = FloatUtils::max( _lowerBounds[element], maxElementLB );
+        if ( existsLowerBound( element ) )
+            maxElementLB = FloatUtils::max( getLowerBound( element ), maxElementLB );
 
-        if ( !_upperBounds.exists( element ) )
+        if ( !existsUpperBound( element ) )
             maxElementUB = FloatUtils::infinity();
         else
-            maxElementUB = FloatUtils::max( _upperBounds[element], maxElementUB );
+            maxElementUB = FloatUtils::max( getUpperBound( element ), maxElementUB );
     }
 
     // Treat the maxValueEliminated as an element
@@ -290,7 +289,7 @@ void MaxConstraint::getEntailedTightenings( List<Tightening> &tightenings ) cons
 			// f_UB <= maxElementUB
             for ( const auto &element : _elements )
             {
-                if ( !_upperBounds.exists( element ) || FloatUtils::gt( _upperBounds[element], fUB ) )
+                if ( !existsUpperBound( element ) || FloatUtils::gt( getUpperBound( element ), fUB ) )
                     tightenings.append( Tightening( element, fUB, Tightening::UB ) );
             }
         }
@@ -537,10 +536,10 @@ bool MaxConstraint::phaseFixed() const
             return true;
 
         unsigned singleVarLeft = *_elements.begin();
-        if ( _lowerBounds.exists( singleVarLeft ) && FloatUtils::gte( _lowerBounds[singleVarLeft], _maxValueOfEliminated ) )
+        if ( existsLowerBound( singleVarLeft ) && FloatUtils::gte( getLowerBound( singleVarLeft ), _maxValueOfEliminated ) )
             return true;
 
-        if ( _upperBounds.exists( singleVarLeft ) && FloatUtils::lte( _upperBounds[singleVarLeft], _maxValueOfEliminated ) )
+        if ( existsUpperBound( singleVarLeft ) && FloatUtils::lte( getUpperBound( singleVarLeft ), _maxValueOfEliminated ) )
             return true;
     }
 
@@ -615,12 +614,12 @@ PiecewiseLinearCaseSplit MaxConstraint::getSplit( unsigned argMax ) const
         gtEquation.setScalar( 0 );
         maxPhase.addEquation( gtEquation );
 
-        if ( _upperBounds.exists( argMax ) )
+        if ( existsUpperBound( argMax ) )
         {
-            if ( !_upperBounds.exists( other ) ||
-                 FloatUtils::gt( _upperBounds[other], _upperBounds[argMax] ) )
+            if ( !existsUpperBound( other ) ||
+                 FloatUtils::gt( getUpperBound( other ), getUpperBound( argMax ) ) )
             {
-                maxPhase.storeBoundTightening( Tightening( other, _upperBounds[argMax], Tightening::UB ) );
+                maxPhase.storeBoundTightening( Tightening( other, getUpperBound( argMax ), Tightening::UB ) );
             }
         }
     }
@@ -0,0 +1,63 @@
+/*********************                                                        */
+/*! \file PhaseLiteral.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#ifndef __PhaseLiteral_h__
+#define __PhaseLiteral_h__
+
+#include "PiecewiseLinearConstraint.h"
+
+/*
+  A literal of the learned clauses: a piecewise-linear constraint
+  and one of its phases. A literal with no constraint stands for a
+  phase that is not known, e.g. of a split replayed from another
+  engine.
+*/
+struct PhaseLiteral
+{
+    PhaseLiteral()
+        : _constraint( NULL )
+        , _phase( PHASE_NOT_FIXED )
+    {
+    }
+
+    PhaseLiteral( PiecewiseLinearConstraint *constraint, PhaseStatus phase )
+        : _constraint( constraint )
+        , _phase( phase )
+    {
+    }
+
+    bool known() const
+    {
+        return _constraint != NULL;
+    }
+
+    bool operator==( const PhaseLiteral &other ) const
+    {
+        return ( _constraint == other._constraint ) && ( _phase == other._phase );
+    }
+
+    PiecewiseLinearConstraint *_constraint;
+    PhaseStatus _phase;
+};
+
+#endif // __PhaseLiteral_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
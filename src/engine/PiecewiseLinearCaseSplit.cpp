@@ -22,7 +22,7 @@ void PiecewiseLinearCaseSplit::storeBoundTightening( const Tightening &tightenin
     _bounds.append( tightening );
 }
 
-const List<Tightening> & PiecewiseLinearCaseSplit::getBoundTightenings() const
+const Vector<Tightening> & PiecewiseLinearCaseSplit::getBoundTightenings() const
 {
     return _bounds;
 }
@@ -21,6 +21,7 @@
 #include "MString.h"
 #include "Pair.h"
 #include "Tightening.h"
+#include "Vector.h"
 
 class PiecewiseLinearCaseSplit
 {
@@ -29,7 +30,7 @@ public:
       Store information regarding a bound tightening.
     */
     void storeBoundTightening( const Tightening &tightening );
-    const List<Tightening> &getBoundTightenings() const;
+    const Vector<Tightening> &getBoundTightenings() const;
 
     /*
       Store information regarding a new equation to be added.
@@ -55,9 +56,10 @@ public:
 
 private:
     /*
-      Bound tightening information.
+      Bound tightening information. This is stored contiguously, as
+      case splits are created and copied with every split.
     */
-    List<Tightening> _bounds;
+    Vector<Tightening> _bounds;
 
     /*
       The equation that needs to be added.
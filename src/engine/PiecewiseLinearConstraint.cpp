@@ -19,6 +19,7 @@
 PiecewiseLinearConstraint::PiecewiseLinearConstraint()
     : _constraintActive( true )
     , _phaseStatus( PHASE_NOT_FIXED )
+    , _boundStore( NULL )
     , _score( FloatUtils::negativeInfinity() )
     , _constraintBoundTightener( NULL )
     , _statistics( NULL )
@@ -35,6 +36,24 @@ void PiecewiseLinearConstraint::registerConstraintBoundTightener( IConstraintBou
     _constraintBoundTightener = tightener;
 }
 
+void PiecewiseLinearConstraint::registerBoundStore( const ITableau *tableau )
+{
+    _boundStore = tableau;
+}
+
+void PiecewiseLinearConstraint::copyBoundsToDuplicate( PiecewiseLinearConstraint *clone ) const
+{
+    if ( !_boundStore )
+        return;
+
+    for ( const auto &variable : getParticipatingVariables() )
+    {
+        clone->_lowerBounds[variable] = _boundStore->getLowerBound( variable );
+        clone->_upperBounds[variable] = _boundStore->getUpperBound( variable );
+    }
+    clone->_boundStore = NULL;
+}
+
 //
 // Local Variables:
 // compile-command: "make -C ../.. "
@@ -220,6 +220,14 @@ public:
     */
     void registerConstraintBoundTightener( IConstraintBoundTightener *tightener );
 
+    /*
+      Register the tableau as the bound store. From then on, the bounds
+      of the participating variables are read from the tableau's bound
+      arrays instead of being copied into the constraint. Duplicates of
+      the constraint get a snapshot of the bounds and no bound store.
+    */
+    void registerBoundStore( const ITableau *tableau );
+
     /*
       Return true if and only if this piecewise linear constraint supports
       the polarity metric
@@ -259,12 +267,12 @@ public:
     */
     double getLowerBound( unsigned i ) const
     {
-        return _lowerBounds[i];
+        return _boundStore ? _boundStore->getLowerBound( i ) : _lowerBounds[i];
     }
 
     double getUpperBound( unsigned i ) const
     {
-        return _upperBounds[i];
+        return _boundStore ? _boundStore->getUpperBound( i ) : _upperBounds[i];
     }
 
 protected:
@@ -274,6 +282,12 @@ protected:
     Map<unsigned, double> _lowerBounds;
     Map<unsigned, double> _upperBounds;
 
+    /*
+      If set, the tableau holds the bounds, and the maps above are only
+      used before the constraint is registered with it
+    */
+    const ITableau *_boundStore;
+
     /*
       The score denotes priority for splitting. When score is negative, the PL constraint
       is not being considered for splitting.
@@ -297,6 +311,55 @@ protected:
         _phaseStatus = phase;
     };
 
+    /*
+      Whether a bound is known for a participating variable. The bound
+      store has a bound (possibly infinite) for every variable.
+    */
+    bool existsLowerBound( unsigned variable ) const
+    {
+        return _boundStore || _lowerBounds.exists( variable );
+    }
+
+    bool existsUpperBound( unsigned variable ) const
+    {
+        return _boundStore || _upperBounds.exists( variable );
+    }
+
+    /*
+      Record a bound the constraint was notified of. Returns false if it
+      is not tighter than the known bound, and can be ignored. With a
+      bound store, the tableau has already stored the bound.
+    */
+    bool updateLowerBound( unsigned variable, double bound )
+    {
+        if ( _boundStore )
+            return true;
+
+        if ( _lowerBounds.exists( variable ) && !FloatUtils::gt( bound, _lowerBounds[variable] ) )
+            return false;
+
+        _lowerBounds[variable] = bound;
+        return true;
+    }
+
+    bool updateUpperBound( unsigned variable, double bound )
+    {
+        if ( _boundStore )
+            return true;
+
+        if ( _upperBounds.exists( variable ) && !FloatUtils::lt( bound, _upperBounds[variable] ) )
+            return false;
+
+        _upperBounds[variable] = bound;
+        return true;
+    }
+
+    /*
+      Store the current bounds in the maps of a duplicate of this
+      constraint, and detach it from the bound store.
+    */
+    void copyBoundsToDuplicate( PiecewiseLinearConstraint *clone ) const;
+
     PhaseStatus getPhaseStatus() const
     {
         return _phaseStatus;
@@ -0,0 +1,263 @@
+/*********************                                                        */
+/*! \file PortfolioManager.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** Implementation of the portfolio. The query is preprocessed once, by a
+ ** base engine; each racing engine then loads a copy of the preprocessed
+ ** query, so that all engines agree on the variables whose bounds they
+ ** exchange. The engines run on their own threads, and the first one to
+ ** reach SAT or UNSAT asks the others to quit. A solution is extracted by
+ ** moving the winner's tableau state into the base engine, which knows how
+ ** to undo the preprocessing.
+
+ **/
+
+#include "Debug.h"
+#include "GlobalConfiguration.h"
+#include "MStringf.h"
+#include "Options.h"
+#include "PortfolioManager.h"
+#include "TableauState.h"
+
+#include <thread>
+
+static String divideStrategyToString( DivideStrategy strategy )
+{
+    switch ( strategy )
+    {
+    case DivideStrategy::Polarity:
+        return "polarity";
+    case DivideStrategy::EarliestReLU:
+        return "earliest-relu";
+    case DivideStrategy::ReLUViolation:
+        return "relu-violation";
+    case DivideStrategy::LargestInterval:
+        return "largest-interval";
+    default:
+        return "auto";
+    }
+}
+
+static String symbolicBoundTighteningTypeToString( SymbolicBoundTighteningType type )
+{
+    switch ( type )
+    {
+    case SymbolicBoundTighteningType::SYMBOLIC_BOUND_TIGHTENING:
+        return "sbt";
+    case SymbolicBoundTighteningType::DEEP_POLY:
+        return "deeppoly";
+    default:
+        return "none";
+    }
+}
+
+PortfolioManager::Configuration::Configuration( DivideStrategy divideStrategy,
+                                                SymbolicBoundTighteningType symbolicBoundTighteningType,
+                                                unsigned constraintViolationThreshold )
+    : _divideStrategy( divideStrategy )
+    , _symbolicBoundTighteningType( symbolicBoundTighteningType )
+    , _constraintViolationThreshold( constraintViolationThreshold )
+{
+}
+
+bool PortfolioManager::Configuration::operator==( const Configuration &other ) const
+{
+    return
+        _divideStrategy == other._divideStrategy &&
+        _symbolicBoundTighteningType == other._symbolicBoundTighteningType &&
+        _constraintViolationThreshold == other._constraintViolationThreshold;
+}
+
+String PortfolioManager::Configuration::toString() const
+{
+    return Stringf( "split-strategy %s, tightening-strategy %s, threshold %u",
+                    divideStrategyToString( _divideStrategy ).ascii(),
+                    symbolicBoundTighteningTypeToString( _symbolicBoundTighteningType ).ascii(),
+                    _constraintViolationThreshold );
+}
+
+PortfolioManager::PortfolioManager( InputQuery *inputQuery )
+    : _inputQuery( inputQuery )
+    , _winner( NO_WINNER )
+    , _exitCode( Engine::NOT_DONE )
+{
+}
+
+void PortfolioManager::getConfigurations( unsigned numberOfEngines,
+                                          Vector<Configuration> &configurations )
+{
+    /*
+      Configurations that tend to do well on different queries: each
+      splitting strategy with each kind of symbolic bound tightening,
+      and both eager and lazy splitting.
+    */
+    static const Configuration diverseConfigurations[] = {
+        Configuration( DivideStrategy::ReLUViolation, SymbolicBoundTighteningType::DEEP_POLY, 20 ),
+        Configuration( DivideStrategy::Polarity, SymbolicBoundTighteningType::DEEP_POLY, 20 ),
+        Configuration( DivideStrategy::EarliestReLU, SymbolicBoundTighteningType::SYMBOLIC_BOUND_TIGHTENING, 20 ),
+        Configuration( DivideStrategy::LargestInterval, SymbolicBoundTighteningType::DEEP_POLY, 20 ),
+        Configuration( DivideStrategy::ReLUViolation, SymbolicBoundTighteningType::SYMBOLIC_BOUND_TIGHTENING, 5 ),
+        Configuration( DivideStrategy::Polarity, SymbolicBoundTighteningType::SYMBOLIC_BOUND_TIGHTENING, 50 ),
+        Configuration( DivideStrategy::ReLUViolation, SymbolicBoundTighteningType::DEEP_POLY, 5 ),
+        Configuration( DivideStrategy::EarliestReLU, SymbolicBoundTighteningType::NONE, 20 ),
+    };
+    const unsigned numberOfDiverseConfigurations =
+        sizeof( diverseConfigurations ) / sizeof( diverseConfigurations[0] );
+
+    configurations.clear();
+    if ( numberOfEngines == 0 )
+        return;
+
+    Options *options = Options::get();
+    configurations.append( Configuration( options->getDivideStrategy(),
+                                          options->getSymbolicBoundTighteningType(),
+                                          options->getInt( Options::CONSTRAINT_VIOLATION_THRESHOLD ) ) );
+
+    for ( unsigned i = 0; i < numberOfDiverseConfigurations; ++i )
+    {
+        if ( configurations.size() == numberOfEngines )
+            return;
+
+        if ( !configurations.exists( diverseConfigurations[i] ) )
+            configurations.append( diverseConfigurations[i] );
+    }
+
+    // Any further engines split more and more lazily
+    for ( unsigned i = 0; configurations.size() < numberOfEngines; ++i )
+    {
+        Configuration configuration = diverseConfigurations[i % numberOfDiverseConfigurations];
+        configuration._constraintViolationThreshold *= 2 + i / numberOfDiverseConfigurations;
+        configurations.append( configuration );
+    }
+}
+
+void PortfolioManager::solve( unsigned numberOfEngines, unsigned timeoutInSeconds )
+{
+    ASSERT( numberOfEngines > 0 );
+
+    if ( !_baseEngine.processInputQuery( *_inputQuery ) )
+    {
+        // Solved by preprocessing
+        _exitCode = Engine::UNSAT;
+        return;
+    }
+
+    getConfigurations( numberOfEngines, _configurations );
+
+    _boundExchange = std::unique_ptr<BoundExchange>
+        ( new BoundExchange( numberOfEngines, GlobalConfiguration::BOUND_EXCHANGE_CAPACITY ) );
+
+    for ( unsigned i = 0; i < numberOfEngines; ++i )
+    {
+        auto engine = std::make_shared<Engine>();
+        engine->setVerbosity( 0 );
+        engine->setSplittingStrategy( _configurations[i]._divideStrategy );
+        engine->setSymbolicBoundTighteningType( _configurations[i]._symbolicBoundTighteningType );
+        engine->setConstraintViolationThreshold( _configurations[i]._constraintViolationThreshold );
+        engine->setBoundExchange( _boundExchange.get(), i );
+        _engines.append( engine );
+    }
+
+    std::list<std::thread> threads;
+    for ( unsigned i = 0; i < numberOfEngines; ++i )
+        threads.push_back( std::thread( &PortfolioManager::runEngine, this, i, timeoutInSeconds ) );
+
+    for ( auto &thread : threads )
+        thread.join();
+
+    if ( _winner != NO_WINNER )
+    {
+        _exitCode = _engines[_winner]->getExitCode();
+        return;
+    }
+
+    // No engine decided the query
+    bool hasTimeout = false;
+    bool hasError = false;
+    for ( const auto &engine : _engines )
+    {
+        if ( engine->getExitCode() == Engine::TIMEOUT )
+            hasTimeout = true;
+        else if ( engine->getExitCode() == Engine::ERROR )
+            hasError = true;
+    }
+
+    if ( hasTimeout )
+        _exitCode = Engine::TIMEOUT;
+    else if ( hasError )
+        _exitCode = Engine::ERROR;
+    else
+        _exitCode = Engine::QUIT_REQUESTED;
+}
+
+void PortfolioManager::runEngine( unsigned engine, unsigned timeoutInSeconds )
+{
+    // All engines work on the same preprocessed query, so that their
+    // variables (and the bounds they share) match
+    InputQuery inputQuery( *_baseEngine.getInputQuery() );
+    if ( _engines[engine]->processInputQuery( inputQuery, false ) )
+        _engines[engine]->solve( timeoutInSeconds );
+
+    Engine::ExitCode exitCode = _engines[engine]->getExitCode();
+    if ( exitCode != Engine::SAT && exitCode != Engine::UNSAT )
+        return;
+
+    int noWinner = NO_WINNER;
+    if ( _winner.compare_exchange_strong( noWinner, engine ) )
+    {
+        for ( const auto &other : _engines )
+        {
+            if ( other != _engines[engine] )
+                *other->getQuitRequested() = true;
+        }
+    }
+}
+
+Engine::ExitCode PortfolioManager::getExitCode() const
+{
+    return _exitCode;
+}
+
+int PortfolioManager::getWinner() const
+{
+    return _winner;
+}
+
+PortfolioManager::Configuration PortfolioManager::getConfiguration( unsigned engine ) const
+{
+    return _configurations.get( engine );
+}
+
+const Statistics *PortfolioManager::getStatistics() const
+{
+    if ( _winner != NO_WINNER )
+        return _engines.get( _winner )->getStatistics();
+
+    return _baseEngine.getStatistics();
+}
+
+void PortfolioManager::extractSolution( InputQuery &inputQuery )
+{
+    ASSERT( _exitCode == Engine::SAT );
+
+    // The base engine knows how the query was preprocessed
+    TableauState tableauStateWithSolution;
+    _engines[_winner]->storeTableauState( tableauStateWithSolution );
+    _baseEngine.restoreTableauState( tableauStateWithSolution );
+    _baseEngine.extractSolution( inputQuery );
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
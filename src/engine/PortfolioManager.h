@@ -0,0 +1,127 @@
+/*********************                                                        */
+/*! \file PortfolioManager.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** Portfolio solving: several engines, each with a different splitting
+ ** strategy, symbolic bound tightening type and splitting threshold,
+ ** race on the same preprocessed query. The first engine to decide the
+ ** query stops the others. While racing, the engines share the bounds
+ ** they derive at the roots of their search trees.
+ **/
+
+#ifndef __PortfolioManager_h__
+#define __PortfolioManager_h__
+
+#include "BoundExchange.h"
+#include "DivideStrategy.h"
+#include "Engine.h"
+#include "InputQuery.h"
+#include "MString.h"
+#include "SymbolicBoundTighteningType.h"
+#include "Vector.h"
+
+#include <atomic>
+#include <memory>
+
+class PortfolioManager
+{
+public:
+    struct Configuration
+    {
+        Configuration( DivideStrategy divideStrategy,
+                       SymbolicBoundTighteningType symbolicBoundTighteningType,
+                       unsigned constraintViolationThreshold );
+
+        DivideStrategy _divideStrategy;
+        SymbolicBoundTighteningType _symbolicBoundTighteningType;
+        unsigned _constraintViolationThreshold;
+
+        bool operator==( const Configuration &other ) const;
+        String toString() const;
+    };
+
+    enum {
+        NO_WINNER = -1,
+    };
+
+    PortfolioManager( InputQuery *inputQuery );
+
+    /*
+      The configurations of the given number of engines. The first one
+      is given by the options, and the others are picked from a fixed
+      list of diverse configurations.
+    */
+    static void getConfigurations( unsigned numberOfEngines,
+                                   Vector<Configuration> &configurations );
+
+    /*
+      Preprocess the query and race the engines on it, until one of
+      them decides it or all of them stop (a timeout of 0 means no time
+      limit).
+    */
+    void solve( unsigned numberOfEngines, unsigned timeoutInSeconds = 0 );
+
+    /*
+      SAT or UNSAT if some engine decided the query, or else the reason
+      the engines stopped.
+    */
+    Engine::ExitCode getExitCode() const;
+
+    /*
+      The index of the engine that decided the query, or NO_WINNER.
+    */
+    int getWinner() const;
+    Configuration getConfiguration( unsigned engine ) const;
+
+    /*
+      The statistics of the engine that decided the query, or of the
+      engine used for preprocessing if there is none.
+    */
+    const Statistics *getStatistics() const;
+
+    /*
+      If the query is SAT, store the solution (over the variables of
+      the original query) in the given query.
+    */
+    void extractSolution( InputQuery &inputQuery );
+
+private:
+    /*
+      Solve the query with one of the engines, and stop the others if
+      it decides the query first.
+    */
+    void runEngine( unsigned engine, unsigned timeoutInSeconds );
+
+    InputQuery *_inputQuery;
+
+    /*
+      The engine that preprocesses the query, and maps the solution
+      back to the original variables
+    */
+    Engine _baseEngine;
+
+    Vector<Configuration> _configurations;
+    Vector<std::shared_ptr<Engine>> _engines;
+
+    std::unique_ptr<BoundExchange> _boundExchange;
+
+    std::atomic_int _winner;
+    Engine::ExitCode _exitCode;
+};
+
+#endif // __PortfolioManager_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,38 @@
+/*********************                                                        */
+/*! \file QueryFileFormat.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#ifndef __QueryFileFormat_h__
+#define __QueryFileFormat_h__
+
+/*
+  The formats in which an input query can be serialized
+*/
+enum class QueryFileFormat
+{
+    // Comma-separated text, one entry per line
+    TEXT = 0,
+    // Versioned binary format that can be memory-mapped
+    BINARY = 1,
+};
+
+#endif // __QueryFileFormat_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
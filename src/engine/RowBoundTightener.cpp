@@ -690,6 +690,26 @@ void RowBoundTightener::notifyUpperBound( unsigned variable, double bound )
     }
 }
 
+void RowBoundTightener::notifyBounds( const ITableau::BoundUpdates &updates )
+{
+    for ( const auto &variable : updates._variables )
+    {
+        if ( ( updates._changed[variable] & ITableau::BoundUpdates::LOWER ) &&
+             FloatUtils::gt( updates._lowerBounds[variable], _lowerBounds[variable] ) )
+        {
+            _lowerBounds[variable] = updates._lowerBounds[variable];
+            _tightenedLower[variable] = false;
+        }
+
+        if ( ( updates._changed[variable] & ITableau::BoundUpdates::UPPER ) &&
+             FloatUtils::lt( updates._upperBounds[variable], _upperBounds[variable] ) )
+        {
+            _upperBounds[variable] = updates._upperBounds[variable];
+            _tightenedUpper[variable] = false;
+        }
+    }
+}
+
 void RowBoundTightener::notifyDimensionChange( unsigned /* m */ , unsigned /* n */ )
 {
     setDimensions();
@@ -50,6 +50,7 @@ public:
     */
     void notifyLowerBound( unsigned variable, double bound );
     void notifyUpperBound( unsigned variable, double bound );
+    void notifyBounds( const ITableau::BoundUpdates &updates );
 
     /*
       Callback from the Tableau, to inform of a change in dimensions
@@ -65,6 +65,7 @@ ContextDependentPiecewiseLinearConstraint *SignConstraint::duplicateConstraint()
     SignConstraint *clone = new SignConstraint( _b, _f );
     *clone = *this;
     this->initializeDuplicateCDOs( clone );
+    copyBoundsToDuplicate( clone );
     return clone;
 }
 
@@ -75,10 +76,12 @@ void SignConstraint::restoreState( const PiecewiseLinearConstraint *state )
     CVC4::context::CDO<bool> *activeStatus = _cdConstraintActive;
     CVC4::context::CDO<PhaseStatus> *phaseStatus = _cdPhaseStatus;
     CVC4::context::CDList<PhaseStatus> *infeasibleCases = _cdInfeasibleCases;
+    const ITableau *boundStore = _boundStore;
     *this = *sign;
     _cdConstraintActive = activeStatus;
     _cdPhaseStatus = phaseStatus;
     _cdInfeasibleCases = infeasibleCases;
+    _boundStore = boundStore;
 }
 
 void SignConstraint::registerAsWatcher( ITableau *tableau )
@@ -252,10 +255,10 @@ bool SignConstraint::haveOutOfBoundVariables() const
     double bValue = _assignment.get( _b );
     double fValue = _assignment.get( _f );
 
-    if ( FloatUtils::gt( _lowerBounds[_b], bValue ) || FloatUtils::lt( _upperBounds[_b], bValue ) )
+    if ( FloatUtils::gt( getLowerBound( _b ), bValue ) || FloatUtils::lt( getUpperBound( _b ), bValue ) )
         return true;
 
-    if ( FloatUtils::gt( _lowerBounds[_f], fValue ) || FloatUtils::lt( _upperBounds[_f], fValue ) )
+    if ( FloatUtils::gt( getLowerBound( _f ), fValue ) || FloatUtils::lt( getUpperBound( _f ), fValue ) )
         return true;
 
     return false;
@@ -293,12 +296,9 @@ void SignConstraint::notifyLowerBound( unsigned variable, double bound )
         _statistics->incNumBoundNotificationsPlConstraints();
 
     // If there's an already-stored tighter bound, return
-    if ( _lowerBounds.exists( variable ) && !FloatUtils::gt( bound, _lowerBounds[variable] ) )
+    if ( !updateLowerBound( variable, bound ) )
         return;
 
-    // Otherwise - update bound
-    _lowerBounds[variable] = bound;
-
     if ( variable == _f && FloatUtils::gt( bound, -1 ) )
     {
         setPhaseStatus( PhaseStatus::SIGN_PHASE_POSITIVE );
@@ -324,12 +324,9 @@ void SignConstraint::notifyUpperBound( unsigned variable, double bound )
         _statistics->incNumBoundNotificationsPlConstraints();
 
     // If there's an already-stored tighter bound, return
-    if ( _upperBounds.exists( variable ) && !FloatUtils::lt( bound, _upperBounds[variable] ) )
+    if ( !updateUpperBound( variable, bound ) )
         return;
 
-    // Otherwise - update bound
-    _upperBounds[variable] = bound;
-
     if ( variable == _f && FloatUtils::lt( bound, 1 ) )
     {
         setPhaseStatus( PhaseStatus::SIGN_PHASE_NEGATIVE );
@@ -370,14 +367,14 @@ List<PiecewiseLinearConstraint::Fix> SignConstraint::getSmartFixes( ITableau * )
 
 void SignConstraint::getEntailedTightenings( List<Tightening> &tightenings ) const
 {
-    ASSERT( _lowerBounds.exists( _b ) && _lowerBounds.exists( _f ) &&
-            _upperBounds.exists( _b ) && _upperBounds.exists( _f ) );
+    ASSERT( existsLowerBound( _b ) && existsLowerBound( _f ) &&
+            existsUpperBound( _b ) && existsUpperBound( _f ) );
 
-    double bLowerBound = _lowerBounds[_b];
-    double fLowerBound = _lowerBounds[_f];
+    double bLowerBound = getLowerBound( _b );
+    double fLowerBound = getLowerBound( _f );
 
-    double bUpperBound = _upperBounds[_b];
-    double fUpperBound = _upperBounds[_f];
+    double bUpperBound = getUpperBound( _b );
+    double fUpperBound = getUpperBound( _f );
 
     // Always make f between -1 and 1
     tightenings.append( Tightening( _f, -1, Tightening::LB ) );
@@ -488,18 +485,18 @@ void SignConstraint::dump( String &output ) const
                       );
 
     output += Stringf( "b in [%s, %s], ",
-                       _lowerBounds.exists( _b ) ? Stringf( "%lf", _lowerBounds[_b] ).ascii() : "-inf",
-                       _upperBounds.exists( _b ) ? Stringf( "%lf", _upperBounds[_b] ).ascii() : "inf" );
+                       existsLowerBound( _b ) ? Stringf( "%lf", getLowerBound( _b ) ).ascii() : "-inf",
+                       existsUpperBound( _b ) ? Stringf( "%lf", getUpperBound( _b ) ).ascii() : "inf" );
 
     output += Stringf( "f in [%s, %s]\n",
-                       _lowerBounds.exists( _f ) ? Stringf( "%lf", _lowerBounds[_f] ).ascii() : "-inf",
-                       _upperBounds.exists( _f ) ? Stringf( "%lf", _upperBounds[_f] ).ascii() : "inf" );
+                       existsLowerBound( _f ) ? Stringf( "%lf", getLowerBound( _f ) ).ascii() : "-inf",
+                       existsUpperBound( _f ) ? Stringf( "%lf", getUpperBound( _f ) ).ascii() : "inf" );
 }
 
 double SignConstraint::computePolarity() const
 {
-  double currentLb = _lowerBounds[_b];
-  double currentUb = _upperBounds[_b];
+  double currentLb = getLowerBound( _b );
+  double currentUb = getUpperBound( _b );
   if ( !FloatUtils::isNegative( currentLb ) ) return 1;
   if ( FloatUtils::isNegative( currentUb ) ) return -1;
   double width = currentUb - currentLb;
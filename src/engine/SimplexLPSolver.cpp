@@ -0,0 +1,1383 @@
+/*********************                                                        */
+/*! \file SimplexLPSolver.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "BasisFactorizationFactory.h"
+#include "CommonError.h"
+#include "Debug.h"
+#include "File.h"
+#include "FloatUtils.h"
+#include "GlobalConfiguration.h"
+#include "MStringf.h"
+#include "MalformedBasisException.h"
+#include "Options.h"
+#include "SimplexLPSolver.h"
+#include "SparseColumnsOfBasis.h"
+#include "TimeUtils.h"
+
+#include <cmath>
+
+SimplexLPSolver::SimplexLPSolver()
+    : _maximize( false )
+    , _cutoffInUse( false )
+    , _cutoff( 0 )
+    , _defaultTimeLimit( Options::get()->getFloat( Options::MILP_SOLVER_TIMEOUT ) )
+    , _timeLimit( _defaultTimeLimit )
+    , _columnsValid( false )
+    , _basisFactorization( NULL )
+    , _factorizationSize( 0 )
+    , _rhs( NULL )
+    , _work( NULL )
+    , _changeColumn( NULL )
+    , _duals( NULL )
+    , _basicCosts( NULL )
+    , _pivotRow( NULL )
+    , _workSize( 0 )
+    , _result( NOT_SOLVED )
+    , _solutionObjective( 0 )
+    , _haveSolution( false )
+    , _objectiveBound( 0 )
+    , _numIterations( 0 )
+{
+}
+
+SimplexLPSolver::~SimplexLPSolver()
+{
+    freeFactorization();
+    freeColumns();
+    freeWorkMemory();
+}
+
+void SimplexLPSolver::freeFactorization()
+{
+    if ( _basisFactorization )
+    {
+        delete _basisFactorization;
+        _basisFactorization = NULL;
+    }
+    _factorizationSize = 0;
+}
+
+void SimplexLPSolver::freeColumns()
+{
+    for ( auto &column : _columns )
+        delete column;
+    _columns.clear();
+    _columnsValid = false;
+}
+
+void SimplexLPSolver::freeWorkMemory()
+{
+    if ( _rhs )
+    {
+        delete[] _rhs;
+        _rhs = NULL;
+    }
+
+    if ( _work )
+    {
+        delete[] _work;
+        _work = NULL;
+    }
+
+    if ( _changeColumn )
+    {
+        delete[] _changeColumn;
+        _changeColumn = NULL;
+    }
+
+    if ( _duals )
+    {
+        delete[] _duals;
+        _duals = NULL;
+    }
+
+    if ( _basicCosts )
+    {
+        delete[] _basicCosts;
+        _basicCosts = NULL;
+    }
+
+    if ( _pivotRow )
+    {
+        delete[] _pivotRow;
+        _pivotRow = NULL;
+    }
+
+    _workSize = 0;
+}
+
+void SimplexLPSolver::resetModel()
+{
+    freeFactorization();
+    freeColumns();
+
+    _variableNames.clear();
+    _nameToVariable.clear();
+    _lowerBounds.clear();
+    _upperBounds.clear();
+    _binaryVariables.clear();
+    _rows.clear();
+    _costs.clear();
+    _maximize = false;
+
+    _variableStatus.clear();
+    _basicIndexToVariable.clear();
+    _values.clear();
+
+    _cutoffInUse = false;
+    _cutoff = 0;
+    _timeLimit = _defaultTimeLimit;
+
+    reset();
+}
+
+void SimplexLPSolver::reset()
+{
+    // The basis is deliberately kept, to warm-start the next solve
+    _result = NOT_SOLVED;
+    _solution.clear();
+    _solutionObjective = 0;
+    _haveSolution = false;
+    _objectiveBound = 0;
+    _numIterations = 0;
+}
+
+void SimplexLPSolver::addVariable( String name, double lb, double ub, VariableType type )
+{
+    ASSERT( !_nameToVariable.exists( name ) );
+
+    if ( type == BINARY )
+    {
+        lb = FloatUtils::max( lb, 0 );
+        ub = FloatUtils::min( ub, 1 );
+    }
+
+    unsigned variable = _variableNames.size();
+    _variableNames.append( name );
+    _nameToVariable[name] = variable;
+    _lowerBounds.append( lb );
+    _upperBounds.append( ub );
+    _costs.append( 0 );
+    _values.append( 0 );
+
+    // New variables join the basis as non-basic, which keeps the
+    // current basis valid
+    _variableStatus.append( AT_LOWER );
+
+    if ( type == BINARY )
+        _binaryVariables.append( variable );
+
+    _columnsValid = false;
+}
+
+unsigned SimplexLPSolver::getVariable( const String &name ) const
+{
+    if ( !_nameToVariable.exists( name ) )
+        throw CommonError( CommonError::KEY_DOESNT_EXIST_IN_MAP,
+                           Stringf( "Unknown LP variable: %s", name.ascii() ).ascii() );
+
+    return _nameToVariable.get( name );
+}
+
+void SimplexLPSolver::setLowerBound( String name, double lb )
+{
+    _lowerBounds[getVariable( name )] = lb;
+}
+
+void SimplexLPSolver::setUpperBound( String name, double ub )
+{
+    _upperBounds[getVariable( name )] = ub;
+}
+
+void SimplexLPSolver::addLeqConstraint( const List<Term> &terms, double scalar )
+{
+    addConstraint( terms, scalar, 'L' );
+}
+
+void SimplexLPSolver::addGeqConstraint( const List<Term> &terms, double scalar )
+{
+    addConstraint( terms, scalar, 'G' );
+}
+
+void SimplexLPSolver::addEqConstraint( const List<Term> &terms, double scalar )
+{
+    addConstraint( terms, scalar, 'E' );
+}
+
+void SimplexLPSolver::addConstraint( const List<Term> &terms, double scalar, char sense )
+{
+    /*
+      The constraint sum( a_j x_j ) <sense> scalar is stored as
+      sum( a_j x_j ) - s = 0, where the bounds of the slack variable s
+      are determined by the sense.
+    */
+    Map<unsigned, double> coefficients;
+    for ( const auto &term : terms )
+    {
+        unsigned variable = getVariable( term._variable );
+        if ( coefficients.exists( variable ) )
+            coefficients[variable] += term._coefficient;
+        else
+            coefficients[variable] = term._coefficient;
+    }
+
+    Row row;
+    for ( const auto &coefficient : coefficients )
+    {
+        if ( !FloatUtils::isZero( coefficient.second ) )
+            row._terms.append( Pair<unsigned, double>( coefficient.first, coefficient.second ) );
+    }
+
+    unsigned slack = _variableNames.size();
+    _variableNames.append( "" );
+    _lowerBounds.append( sense == 'L' ? FloatUtils::negativeInfinity() : scalar );
+    _upperBounds.append( sense == 'G' ? FloatUtils::infinity() : scalar );
+    _costs.append( 0 );
+    _values.append( 0 );
+
+    // The new slack is basic, which keeps the basis non-singular
+    _variableStatus.append( BASIC );
+    _basicIndexToVariable.append( slack );
+
+    row._slack = slack;
+    _rows.append( row );
+
+    _columnsValid = false;
+}
+
+void SimplexLPSolver::setCost( const List<Term> &terms )
+{
+    setObjectiveFunction( terms, false );
+}
+
+void SimplexLPSolver::setObjective( const List<Term> &terms )
+{
+    setObjectiveFunction( terms, true );
+}
+
+void SimplexLPSolver::setObjectiveFunction( const List<Term> &terms, bool maximize )
+{
+    for ( unsigned i = 0; i < _costs.size(); ++i )
+        _costs[i] = 0;
+
+    for ( const auto &term : terms )
+        _costs[getVariable( term._variable )] += term._coefficient;
+
+    _maximize = maximize;
+}
+
+void SimplexLPSolver::setCutoff( double cutoff )
+{
+    _cutoffInUse = true;
+    _cutoff = cutoff;
+}
+
+void SimplexLPSolver::setTimeLimit( double seconds )
+{
+    _timeLimit = seconds;
+}
+
+bool SimplexLPSolver::optimal()
+{
+    return _result == OPTIMAL;
+}
+
+bool SimplexLPSolver::cutoffOccurred()
+{
+    return _result == CUTOFF;
+}
+
+bool SimplexLPSolver::infeasbile()
+{
+    return _result == INFEASIBLE;
+}
+
+bool SimplexLPSolver::timeout()
+{
+    return _result == TIMEOUT;
+}
+
+bool SimplexLPSolver::haveFeasibleSolution()
+{
+    return _haveSolution;
+}
+
+unsigned SimplexLPSolver::getNumberOfIterations() const
+{
+    return _numIterations;
+}
+
+void SimplexLPSolver::extractSolution( Map<String, double> &values, double &costOrObjective )
+{
+    ASSERT( _haveSolution );
+
+    values.clear();
+    for ( const auto &variable : _nameToVariable )
+        values[variable.first] = _solution[variable.second];
+
+    costOrObjective = _solutionObjective;
+}
+
+double SimplexLPSolver::getObjectiveBound()
+{
+    return _objectiveBound;
+}
+
+void SimplexLPSolver::dumpModel( String name )
+{
+    File file( name );
+    file.open( IFile::MODE_WRITE_TRUNCATE );
+
+    file.write( _maximize ? "Maximize\n" : "Minimize\n" );
+    String objective;
+    for ( unsigned i = 0; i < _variableNames.size(); ++i )
+    {
+        if ( !FloatUtils::isZero( _costs[i] ) )
+            objective += Stringf( " %+.10lf %s", _costs[i], _variableNames[i].ascii() );
+    }
+    file.write( Stringf( "  obj:%s\n", objective.ascii() ) );
+
+    file.write( "Subject To\n" );
+    for ( unsigned i = 0; i < _rows.size(); ++i )
+    {
+        String row;
+        for ( const auto &term : _rows[i]._terms )
+            row += Stringf( " %+.10lf %s", term.second(), _variableNames[term.first()].ascii() );
+
+        unsigned slack = _rows[i]._slack;
+        if ( FloatUtils::areEqual( _lowerBounds[slack], _upperBounds[slack] ) )
+            row += Stringf( " = %.10lf", _lowerBounds[slack] );
+        else if ( FloatUtils::isFinite( _upperBounds[slack] ) )
+            row += Stringf( " <= %.10lf", _upperBounds[slack] );
+        else
+            row += Stringf( " >= %.10lf", _lowerBounds[slack] );
+
+        file.write( Stringf( "  c%u:%s\n", i, row.ascii() ) );
+    }
+
+    file.write( "Bounds\n" );
+    for ( const auto &variable : _nameToVariable )
+    {
+        unsigned i = variable.second;
+        String lb = FloatUtils::isFinite( _lowerBounds[i] ) ?
+            Stringf( "%.10lf", _lowerBounds[i] ) : String( "-inf" );
+        String ub = FloatUtils::isFinite( _upperBounds[i] ) ?
+            Stringf( "%.10lf", _upperBounds[i] ) : String( "+inf" );
+        file.write( Stringf( "  %s <= %s <= %s\n", lb.ascii(), _variableNames[i].ascii(), ub.ascii() ) );
+    }
+
+    if ( !_binaryVariables.empty() )
+    {
+        file.write( "Binaries\n" );
+        for ( const auto &variable : _binaryVariables )
+            file.write( Stringf( "  %s\n", _variableNames[variable].ascii() ) );
+    }
+
+    file.write( "End\n" );
+}
+
+void SimplexLPSolver::getColumnOfBasis( unsigned column, double *result ) const
+{
+    ASSERT( column < _basicIndexToVariable.size() );
+    _columns.get( _basicIndexToVariable.get( column ) )->toDense( result );
+}
+
+void SimplexLPSolver::getColumnOfBasis( unsigned column, SparseUnsortedList *result ) const
+{
+    ASSERT( column < _basicIndexToVariable.size() );
+    _columns.get( _basicIndexToVariable.get( column ) )->storeIntoOther( result );
+}
+
+void SimplexLPSolver::getSparseBasis( SparseColumnsOfBasis &basis ) const
+{
+    for ( unsigned i = 0; i < _basicIndexToVariable.size(); ++i )
+        basis._columns[i] = _columns.get( _basicIndexToVariable.get( i ) );
+}
+
+void SimplexLPSolver::solve()
+{
+    reset();
+    _solveStart = TimeUtils::sampleMicro();
+
+    if ( _binaryVariables.empty() )
+    {
+        Status status = solveLP();
+
+        if ( status == OPTIMAL )
+        {
+            storeSolution();
+            _objectiveBound = _solutionObjective;
+
+            if ( _cutoffInUse && isWorse( _solutionObjective, _cutoff ) )
+            {
+                _result = CUTOFF;
+                _haveSolution = false;
+            }
+            else
+                _result = OPTIMAL;
+        }
+        else
+        {
+            _result = status;
+            _objectiveBound = _maximize ? FloatUtils::infinity() : FloatUtils::negativeInfinity();
+        }
+    }
+    else
+    {
+        solveMILP();
+    }
+
+    SIMPLEX_LP_SOLVER_LOG( Stringf( "Solved with status %u after %u iterations",
+                                    _result, _numIterations ).ascii() );
+}
+
+bool SimplexLPSolver::isWorse( double value, double reference ) const
+{
+    double tolerance = GlobalConfiguration::SIMPLEX_LP_SOLVER_OPTIMALITY_TOLERANCE;
+    if ( _maximize )
+        return value < reference - tolerance;
+    else
+        return value > reference + tolerance;
+}
+
+bool SimplexLPSolver::shouldQuitDueToTimeout() const
+{
+    if ( !FloatUtils::isFinite( _timeLimit ) )
+        return false;
+
+    struct timespec now = TimeUtils::sampleMicro();
+    return TimeUtils::timePassed( _solveStart, now ) >= _timeLimit * 1000000;
+}
+
+void SimplexLPSolver::storeSolution()
+{
+    _solution = _values;
+    _solutionObjective = computeObjectiveValue();
+    _haveSolution = true;
+}
+
+double SimplexLPSolver::computeObjectiveValue() const
+{
+    double result = 0;
+    for ( unsigned i = 0; i < _costs.size(); ++i )
+    {
+        if ( _costs.get( i ) != 0 )
+            result += _costs.get( i ) * _values.get( i );
+    }
+    return result;
+}
+
+void SimplexLPSolver::prepareColumns()
+{
+    if ( _columnsValid )
+        return;
+
+    freeColumns();
+
+    unsigned m = _rows.size();
+    for ( unsigned i = 0; i < _variableNames.size(); ++i )
+        _columns.append( new SparseUnsortedList( m ) );
+
+    for ( unsigned i = 0; i < m; ++i )
+    {
+        for ( const auto &term : _rows[i]._terms )
+            _columns[term.first()]->append( i, term.second() );
+        _columns[_rows[i]._slack]->append( i, -1 );
+    }
+
+    _columnsValid = true;
+}
+
+void SimplexLPSolver::prepareWorkMemory()
+{
+    unsigned m = _rows.size();
+    if ( _workSize == m && _rhs )
+        return;
+
+    freeWorkMemory();
+
+    if ( m == 0 )
+        return;
+
+    _rhs = new double[m];
+    _work = new double[m];
+    _changeColumn = new double[m];
+    _duals = new double[m];
+    _basicCosts = new double[m];
+    _pivotRow = new double[m];
+    _workSize = m;
+}
+
+void SimplexLPSolver::placeNonBasic( unsigned variable )
+{
+    double lb = _lowerBounds[variable];
+    double ub = _upperBounds[variable];
+    bool lbFinite = FloatUtils::isFinite( lb );
+    bool ubFinite = FloatUtils::isFinite( ub );
+
+    if ( !lbFinite && !ubFinite )
+    {
+        _variableStatus[variable] = FREE;
+        _values[variable] = 0;
+    }
+    else if ( ( _variableStatus[variable] == AT_UPPER && ubFinite ) || !lbFinite )
+    {
+        _variableStatus[variable] = AT_UPPER;
+        _values[variable] = ub;
+    }
+    else
+    {
+        _variableStatus[variable] = AT_LOWER;
+        _values[variable] = lb;
+    }
+}
+
+void SimplexLPSolver::useSlackBasis()
+{
+    for ( unsigned i = 0; i < _variableStatus.size(); ++i )
+    {
+        if ( _variableStatus[i] == BASIC )
+            _variableStatus[i] = AT_LOWER;
+    }
+
+    for ( unsigned i = 0; i < _rows.size(); ++i )
+    {
+        _basicIndexToVariable[i] = _rows[i]._slack;
+        _variableStatus[_rows[i]._slack] = BASIC;
+    }
+}
+
+bool SimplexLPSolver::refactorize()
+{
+    if ( _rows.empty() )
+        return true;
+
+    try
+    {
+        _basisFactorization->obtainFreshBasis();
+    }
+    catch ( const MalformedBasisException & )
+    {
+        return false;
+    }
+
+    return true;
+}
+
+void SimplexLPSolver::computeBasicValues()
+{
+    unsigned m = _rows.size();
+    if ( m == 0 )
+        return;
+
+    /*
+      The basic variables satisfy B * x_B = - N * x_N
+    */
+    std::fill_n( _rhs, m, 0 );
+    for ( unsigned i = 0; i < _variableNames.size(); ++i )
+    {
+        if ( _variableStatus[i] == BASIC || _values[i] == 0 )
+            continue;
+
+        for ( const auto &entry : *_columns[i] )
+            _rhs[entry._index] -= entry._value * _values[i];
+    }
+
+    _basisFactorization->forwardTransformation( _rhs, _work );
+
+    for ( unsigned i = 0; i < m; ++i )
+        _values[_basicIndexToVariable[i]] = _work[i];
+}
+
+double SimplexLPSolver::computeSumOfInfeasibilities() const
+{
+    double sum = 0;
+    for ( const auto &variable : _basicIndexToVariable )
+    {
+        double value = _values.get( variable );
+        if ( value < _lowerBounds.get( variable ) )
+            sum += _lowerBounds.get( variable ) - value;
+        else if ( value > _upperBounds.get( variable ) )
+            sum += value - _upperBounds.get( variable );
+    }
+    return sum;
+}
+
+SimplexLPSolver::Status SimplexLPSolver::solveLP()
+{
+    unsigned m = _rows.size();
+    unsigned n = _variableNames.size();
+
+    // Contradictory bounds make the problem trivially infeasible
+    for ( unsigned i = 0; i < n; ++i )
+    {
+        if ( FloatUtils::gt( _lowerBounds[i], _upperBounds[i],
+                             GlobalConfiguration::SIMPLEX_LP_SOLVER_FEASIBILITY_TOLERANCE ) )
+            return INFEASIBLE;
+    }
+
+    prepareColumns();
+    prepareWorkMemory();
+
+    if ( _factorizationSize != m )
+    {
+        freeFactorization();
+        if ( m > 0 )
+            _basisFactorization = BasisFactorizationFactory::createBasisFactorization( m, *this );
+        _factorizationSize = m;
+    }
+
+    for ( unsigned i = 0; i < n; ++i )
+    {
+        if ( _variableStatus[i] != BASIC )
+            placeNonBasic( i );
+    }
+
+    if ( !refactorize() )
+    {
+        // The previous basis has become singular, start over
+        SIMPLEX_LP_SOLVER_LOG( "Warm-start basis is singular, using the slack basis" );
+        useSlackBasis();
+        for ( unsigned i = 0; i < n; ++i )
+        {
+            if ( _variableStatus[i] != BASIC )
+                placeNonBasic( i );
+        }
+        refactorize();
+    }
+
+    try
+    {
+        computeBasicValues();
+
+        /*
+          A warm-start basis that is infeasible only because bounds were
+          tightened or binaries fixed is usually still dual feasible, and
+          is re-optimized with the dual simplex. If the basis is not dual
+          feasible, or the dual simplex gives up, the primal phases below
+          continue from wherever it stopped.
+        */
+        if ( computeSumOfInfeasibilities() > GlobalConfiguration::SIMPLEX_LP_SOLVER_FEASIBILITY_TOLERANCE )
+        {
+            Status status = runDualSimplex();
+            if ( status == INFEASIBLE || status == TIMEOUT )
+                return status;
+        }
+
+        /*
+          Phase one: find a feasible basis. Infeasibility is only
+          declared after confirming it with a fresh factorization.
+        */
+        for ( unsigned attempt = 0; attempt < 2; ++attempt )
+        {
+            Status status = runSimplex( true );
+            if ( status != OPTIMAL )
+                return status;
+
+            if ( !refactorize() )
+                return TIMEOUT;
+            computeBasicValues();
+
+            if ( computeSumOfInfeasibilities() <=
+                 GlobalConfiguration::SIMPLEX_LP_SOLVER_FEASIBILITY_TOLERANCE * ( m + 1 ) )
+                break;
+
+            if ( attempt == 1 )
+                return INFEASIBLE;
+        }
+
+        // Phase two: optimize
+        return runSimplex( false );
+    }
+    catch ( const MalformedBasisException & )
+    {
+        // A singular basis was reached; the next solve will start
+        // over from the slack basis
+        SIMPLEX_LP_SOLVER_LOG( "Basis became singular" );
+        return TIMEOUT;
+    }
+}
+
+bool SimplexLPSolver::computeBasicCosts( bool phaseOne )
+{
+    double tolerance = GlobalConfiguration::SIMPLEX_LP_SOLVER_FEASIBILITY_TOLERANCE;
+    double sign = _maximize ? -1 : 1;
+    bool nonZero = false;
+
+    for ( unsigned i = 0; i < _basicIndexToVariable.size(); ++i )
+    {
+        unsigned variable = _basicIndexToVariable[i];
+
+        if ( phaseOne )
+        {
+            double value = _values[variable];
+            if ( value > _upperBounds[variable] + tolerance )
+                _basicCosts[i] = 1;
+            else if ( value < _lowerBounds[variable] - tolerance )
+                _basicCosts[i] = -1;
+            else
+                _basicCosts[i] = 0;
+        }
+        else
+        {
+            _basicCosts[i] = sign * _costs[variable];
+        }
+
+        if ( _basicCosts[i] != 0 )
+            nonZero = true;
+    }
+
+    return nonZero;
+}
+
+SimplexLPSolver::Status SimplexLPSolver::runSimplex( bool phaseOne )
+{
+    unsigned m = _rows.size();
+    unsigned n = _variableNames.size();
+
+    double feasibilityTolerance = GlobalConfiguration::SIMPLEX_LP_SOLVER_FEASIBILITY_TOLERANCE;
+    double optimalityTolerance = GlobalConfiguration::SIMPLEX_LP_SOLVER_OPTIMALITY_TOLERANCE;
+    double pivotTolerance = GlobalConfiguration::SIMPLEX_LP_SOLVER_PIVOT_TOLERANCE;
+
+    unsigned degenerateIterations = 0;
+    unsigned pivotsSinceRefactorization = 0;
+
+    while ( true )
+    {
+        if ( shouldQuitDueToTimeout() ||
+             _numIterations >= GlobalConfiguration::SIMPLEX_LP_SOLVER_MAX_ITERATIONS )
+            return TIMEOUT;
+
+        // Compute the duals, y * B = c_B
+        bool haveBasicCosts = ( m > 0 ) && computeBasicCosts( phaseOne );
+        if ( phaseOne && !haveBasicCosts )
+            return OPTIMAL;
+
+        if ( haveBasicCosts )
+            _basisFactorization->backwardTransformation( _basicCosts, _duals );
+        else if ( m > 0 )
+            std::fill_n( _duals, m, 0 );
+
+        /*
+          Pricing: Dantzig's rule, switching to Bland's rule while the
+          iterations are degenerate, to avoid cycling
+        */
+        bool useBland = degenerateIterations > GlobalConfiguration::SIMPLEX_LP_SOLVER_DEGENERATE_ITERATIONS_BEFORE_BLAND;
+        unsigned entering = n;
+        int direction = 0;
+        double bestScore = 0;
+
+        for ( unsigned j = 0; j < n; ++j )
+        {
+            VariableStatus status = _variableStatus[j];
+            if ( status == BASIC )
+                continue;
+
+            bool canIncrease = ( status == FREE ) ||
+                ( status == AT_LOWER && _values[j] < _upperBounds[j] );
+            bool canDecrease = ( status == FREE ) ||
+                ( status == AT_UPPER && _values[j] > _lowerBounds[j] );
+
+            if ( !canIncrease && !canDecrease )
+                continue;
+
+            double reducedCost = computeReducedCost( j, phaseOne );
+
+            double score = 0;
+            int candidateDirection = 0;
+            if ( reducedCost < -optimalityTolerance && canIncrease )
+            {
+                score = -reducedCost;
+                candidateDirection = 1;
+            }
+            else if ( reducedCost > optimalityTolerance && canDecrease )
+            {
+                score = reducedCost;
+                candidateDirection = -1;
+            }
+            else
+                continue;
+
+            if ( score > bestScore )
+            {
+                entering = j;
+                direction = candidateDirection;
+                bestScore = score;
+
+                if ( useBland )
+                    break;
+            }
+        }
+
+        if ( entering == n )
+            return OPTIMAL;
+
+        /*
+          Ratio test. As the entering variable changes by t in the
+          chosen direction, basic variable i changes by
+          -direction * alpha_i * t, where alpha = inv(B) * a_entering.
+          In phase one, an infeasible basic variable blocks when it
+          reaches the bound it violates.
+        */
+        if ( m > 0 )
+        {
+            _columns[entering]->toDense( _work );
+            _basisFactorization->forwardTransformation( _work, _changeColumn );
+        }
+
+        double maxStep = FloatUtils::infinity();
+        if ( FloatUtils::isFinite( _lowerBounds[entering] ) && FloatUtils::isFinite( _upperBounds[entering] ) )
+            maxStep = _upperBounds[entering] - _lowerBounds[entering];
+
+        unsigned leaving = m;
+        bool leavingToLower = false;
+        double bestAlpha = 0;
+
+        for ( unsigned i = 0; i < m; ++i )
+        {
+            double alpha = _changeColumn[i];
+            if ( FloatUtils::abs( alpha ) < pivotTolerance )
+                continue;
+
+            unsigned variable = _basicIndexToVariable[i];
+            double value = _values[variable];
+            double lb = _lowerBounds[variable];
+            double ub = _upperBounds[variable];
+            double rate = -direction * alpha;
+
+            double limit;
+            bool toLower;
+            if ( rate > 0 )
+            {
+                if ( phaseOne && value < lb - feasibilityTolerance )
+                {
+                    limit = ( lb - value ) / rate;
+                    toLower = true;
+                }
+                else if ( value <= ub + feasibilityTolerance && FloatUtils::isFinite( ub ) )
+                {
+                    limit = ( ub - value ) / rate;
+                    toLower = false;
+                }
+                else
+                    continue;
+            }
+            else
+            {
+                if ( phaseOne && value > ub + feasibilityTolerance )
+                {
+                    limit = ( value - ub ) / -rate;
+                    toLower = false;
+                }
+                else if ( value >= lb - feasibilityTolerance && FloatUtils::isFinite( lb ) )
+                {
+                    limit = ( value - lb ) / -rate;
+                    toLower = true;
+                }
+                else
+                    continue;
+            }
+
+            if ( limit < 0 )
+                limit = 0;
+
+            // Prefer larger pivot elements among (nearly) tied ratios
+            if ( limit < maxStep - feasibilityTolerance ||
+                 ( limit <= maxStep && FloatUtils::abs( alpha ) > bestAlpha ) )
+            {
+                maxStep = limit;
+                leaving = i;
+                leavingToLower = toLower;
+                bestAlpha = FloatUtils::abs( alpha );
+            }
+        }
+
+        if ( !FloatUtils::isFinite( maxStep ) )
+        {
+            // Phase one is bounded from below, so this is a numerical failure
+            return phaseOne ? TIMEOUT : UNBOUNDED;
+        }
+
+        if ( maxStep < feasibilityTolerance )
+            ++degenerateIterations;
+        else
+            degenerateIterations = 0;
+
+        // Update the assignment
+        _values[entering] += direction * maxStep;
+        for ( unsigned i = 0; i < m; ++i )
+        {
+            if ( _changeColumn[i] != 0 )
+                _values[_basicIndexToVariable[i]] -= direction * _changeColumn[i] * maxStep;
+        }
+
+        if ( leaving == m )
+        {
+            // A bound flip of the entering variable
+            if ( direction > 0 )
+            {
+                _variableStatus[entering] = AT_UPPER;
+                _values[entering] = _upperBounds[entering];
+            }
+            else
+            {
+                _variableStatus[entering] = AT_LOWER;
+                _values[entering] = _lowerBounds[entering];
+            }
+        }
+        else
+        {
+            unsigned leavingVariable = _basicIndexToVariable[leaving];
+            _variableStatus[leavingVariable] = leavingToLower ? AT_LOWER : AT_UPPER;
+            _values[leavingVariable] = leavingToLower ?
+                _lowerBounds[leavingVariable] : _upperBounds[leavingVariable];
+
+            _basicIndexToVariable[leaving] = entering;
+            _variableStatus[entering] = BASIC;
+
+            // _work still holds the dense entering column
+            _basisFactorization->updateToAdjacentBasis( leaving, _changeColumn, _work );
+
+            if ( ++pivotsSinceRefactorization >= GlobalConfiguration::REFACTORIZATION_THRESHOLD )
+            {
+                // Recompute the assignment, to limit the accumulated error
+                if ( !refactorize() )
+                    return TIMEOUT;
+                computeBasicValues();
+                pivotsSinceRefactorization = 0;
+            }
+        }
+
+        ++_numIterations;
+    }
+}
+
+double SimplexLPSolver::computeReducedCost( unsigned variable, bool phaseOne ) const
+{
+    double reducedCost = phaseOne ? 0 : ( _maximize ? -1 : 1 ) * _costs.get( variable );
+    for ( const auto &entry : *_columns.get( variable ) )
+        reducedCost -= _duals[entry._index] * entry._value;
+    return reducedCost;
+}
+
+bool SimplexLPSolver::makeDualFeasible()
+{
+    unsigned m = _rows.size();
+    unsigned n = _variableNames.size();
+    double optimalityTolerance = GlobalConfiguration::SIMPLEX_LP_SOLVER_OPTIMALITY_TOLERANCE;
+
+    if ( computeBasicCosts( false ) )
+        _basisFactorization->backwardTransformation( _basicCosts, _duals );
+    else
+        std::fill_n( _duals, m, 0 );
+
+    /*
+      A boxed non-basic variable can always be moved to the bound that
+      matches the sign of its reduced cost. Any other variable must
+      already have a reduced cost of the right sign.
+    */
+    Vector<unsigned> flips;
+    for ( unsigned j = 0; j < n; ++j )
+    {
+        VariableStatus status = _variableStatus[j];
+        if ( status == BASIC || _lowerBounds[j] == _upperBounds[j] )
+            continue;
+
+        double reducedCost = computeReducedCost( j, false );
+        bool boxed = FloatUtils::isFinite( _lowerBounds[j] ) && FloatUtils::isFinite( _upperBounds[j] );
+
+        if ( reducedCost < -optimalityTolerance && status != AT_UPPER )
+        {
+            if ( !boxed )
+                return false;
+            flips.append( j );
+        }
+        else if ( reducedCost > optimalityTolerance && status != AT_LOWER )
+        {
+            if ( !boxed )
+                return false;
+            flips.append( j );
+        }
+    }
+
+    if ( flips.empty() )
+        return true;
+
+    for ( const auto &variable : flips )
+    {
+        _variableStatus[variable] = ( _variableStatus[variable] == AT_LOWER ) ? AT_UPPER : AT_LOWER;
+        _values[variable] = ( _variableStatus[variable] == AT_LOWER ) ?
+            _lowerBounds[variable] : _upperBounds[variable];
+    }
+    computeBasicValues();
+
+    return true;
+}
+
+SimplexLPSolver::Status SimplexLPSolver::runDualSimplex()
+{
+    unsigned m = _rows.size();
+    unsigned n = _variableNames.size();
+
+    double feasibilityTolerance = GlobalConfiguration::SIMPLEX_LP_SOLVER_FEASIBILITY_TOLERANCE;
+    double optimalityTolerance = GlobalConfiguration::SIMPLEX_LP_SOLVER_OPTIMALITY_TOLERANCE;
+    double pivotTolerance = GlobalConfiguration::SIMPLEX_LP_SOLVER_PIVOT_TOLERANCE;
+
+    if ( m == 0 || !makeDualFeasible() )
+        return NOT_SOLVED;
+
+    unsigned degenerateIterations = 0;
+    unsigned pivotsSinceRefactorization = 0;
+
+    while ( true )
+    {
+        if ( shouldQuitDueToTimeout() ||
+             _numIterations >= GlobalConfiguration::SIMPLEX_LP_SOLVER_MAX_ITERATIONS )
+            return TIMEOUT;
+
+        // The leaving variable is the most infeasible basic variable
+        unsigned leaving = m;
+        bool leavingToLower = false;
+        double worstViolation = feasibilityTolerance;
+        for ( unsigned i = 0; i < m; ++i )
+        {
+            unsigned variable = _basicIndexToVariable[i];
+            double value = _values[variable];
+            if ( _lowerBounds[variable] - value > worstViolation )
+            {
+                leaving = i;
+                leavingToLower = true;
+                worstViolation = _lowerBounds[variable] - value;
+            }
+            else if ( value - _upperBounds[variable] > worstViolation )
+            {
+                leaving = i;
+                leavingToLower = false;
+                worstViolation = value - _upperBounds[variable];
+            }
+        }
+
+        if ( leaving == m )
+            return OPTIMAL;
+
+        // The duals, and the row of inv(B) * A of the leaving variable
+        if ( computeBasicCosts( false ) )
+            _basisFactorization->backwardTransformation( _basicCosts, _duals );
+        else
+            std::fill_n( _duals, m, 0 );
+
+        std::fill_n( _rhs, m, 0 );
+        _rhs[leaving] = 1;
+        _basisFactorization->backwardTransformation( _rhs, _pivotRow );
+
+        /*
+          Ratio test. As non-basic variable j changes by t, the leaving
+          variable changes by -alpha_j * t. Among the variables that can
+          move it towards its violated bound, the entering variable is
+          the one whose reduced cost reaches zero first, which keeps the
+          basis dual feasible.
+        */
+        unsigned entering = n;
+        double bestRatio = FloatUtils::infinity();
+        double bestAlpha = 0;
+
+        for ( unsigned j = 0; j < n; ++j )
+        {
+            VariableStatus status = _variableStatus[j];
+            if ( status == BASIC )
+                continue;
+
+            double alpha = 0;
+            for ( const auto &entry : *_columns[j] )
+                alpha += _pivotRow[entry._index] * entry._value;
+
+            if ( FloatUtils::abs( alpha ) < pivotTolerance )
+                continue;
+
+            int direction = ( leavingToLower == ( alpha < 0 ) ) ? 1 : -1;
+            bool canMove = ( status == FREE ) ||
+                ( direction > 0 && status == AT_LOWER && _values[j] < _upperBounds[j] ) ||
+                ( direction < 0 && status == AT_UPPER && _values[j] > _lowerBounds[j] );
+
+            if ( !canMove )
+                continue;
+
+            double reducedCost = direction * computeReducedCost( j, false );
+            double ratio = ( reducedCost > 0 ? reducedCost : 0 ) / FloatUtils::abs( alpha );
+
+            // Prefer larger pivot elements among (nearly) tied ratios
+            if ( ratio < bestRatio - optimalityTolerance ||
+                 ( ratio <= bestRatio && FloatUtils::abs( alpha ) > bestAlpha ) )
+            {
+                entering = j;
+                bestRatio = ratio;
+                bestAlpha = FloatUtils::abs( alpha );
+            }
+        }
+
+        if ( entering == n )
+        {
+            // Infeasibility is only declared after a fresh factorization
+            if ( pivotsSinceRefactorization == 0 )
+                return INFEASIBLE;
+
+            if ( !refactorize() )
+                return TIMEOUT;
+            computeBasicValues();
+            pivotsSinceRefactorization = 0;
+            continue;
+        }
+
+        if ( bestRatio < optimalityTolerance )
+            ++degenerateIterations;
+        else
+            degenerateIterations = 0;
+
+        // Leave a (possibly cycling) degenerate stretch to the primal simplex
+        if ( degenerateIterations > GlobalConfiguration::SIMPLEX_LP_SOLVER_DEGENERATE_ITERATIONS_BEFORE_BLAND )
+            return NOT_SOLVED;
+
+        _columns[entering]->toDense( _work );
+        _basisFactorization->forwardTransformation( _work, _changeColumn );
+
+        double pivot = _changeColumn[leaving];
+        if ( FloatUtils::abs( pivot ) < pivotTolerance )
+            return NOT_SOLVED;
+
+        // Move the leaving variable exactly onto its violated bound
+        unsigned leavingVariable = _basicIndexToVariable[leaving];
+        double target = leavingToLower ? _lowerBounds[leavingVariable] : _upperBounds[leavingVariable];
+        double step = ( _values[leavingVariable] - target ) / pivot;
+
+        _values[entering] += step;
+        for ( unsigned i = 0; i < m; ++i )
+        {
+            if ( _changeColumn[i] != 0 )
+                _values[_basicIndexToVariable[i]] -= _changeColumn[i] * step;
+        }
+
+        _variableStatus[leavingVariable] = leavingToLower ? AT_LOWER : AT_UPPER;
+        _values[leavingVariable] = target;
+
+        _basicIndexToVariable[leaving] = entering;
+        _variableStatus[entering] = BASIC;
+
+        // _work still holds the dense entering column
+        _basisFactorization->updateToAdjacentBasis( leaving, _changeColumn, _work );
+
+        if ( ++pivotsSinceRefactorization >= GlobalConfiguration::REFACTORIZATION_THRESHOLD )
+        {
+            if ( !refactorize() )
+                return TIMEOUT;
+            computeBasicValues();
+            pivotsSinceRefactorization = 0;
+        }
+
+        ++_numIterations;
+    }
+}
+
+void SimplexLPSolver::solveMILP()
+{
+    /*
+      Depth-first branch and bound over the binary variables. Each
+      node is described by the binaries it fixes, and holds the
+      objective value of its parent's relaxation, which bounds its own.
+    */
+    struct Node
+    {
+        List<Pair<unsigned, double>> _fixings;
+        double _bound;
+    };
+
+    double worstValue = _maximize ? FloatUtils::negativeInfinity() : FloatUtils::infinity();
+    double bestValue = _maximize ? FloatUtils::infinity() : FloatUtils::negativeInfinity();
+
+    bool haveObjective = false;
+    for ( const auto &cost : _costs )
+    {
+        if ( cost != 0 )
+            haveObjective = true;
+    }
+
+    Vector<Pair<double, double>> originalBounds;
+    for ( const auto &variable : _binaryVariables )
+        originalBounds.append( Pair<double, double>( _lowerBounds[variable], _upperBounds[variable] ) );
+
+    List<Node> nodes;
+    Node root;
+    root._bound = bestValue;
+    nodes.append( root );
+
+    Vector<double> incumbent;
+    double incumbentValue = worstValue;
+    bool haveIncumbent = false;
+    bool prunedByCutoff = false;
+    bool timedOut = false;
+    bool unbounded = false;
+
+    double integralityTolerance = GlobalConfiguration::SIMPLEX_LP_SOLVER_INTEGRALITY_TOLERANCE;
+
+    while ( !nodes.empty() )
+    {
+        if ( shouldQuitDueToTimeout() )
+        {
+            timedOut = true;
+            break;
+        }
+
+        Node node = nodes.back();
+        nodes.popBack();
+
+        if ( haveIncumbent && ( !haveObjective || !isWorse( incumbentValue, node._bound ) ) )
+            continue;
+
+        if ( _cutoffInUse && isWorse( node._bound, _cutoff ) )
+        {
+            prunedByCutoff = true;
+            continue;
+        }
+
+        for ( unsigned i = 0; i < _binaryVariables.size(); ++i )
+        {
+            _lowerBounds[_binaryVariables[i]] = originalBounds[i].first();
+            _upperBounds[_binaryVariables[i]] = originalBounds[i].second();
+        }
+
+        for ( const auto &fixing : node._fixings )
+        {
+            _lowerBounds[fixing.first()] = fixing.second();
+            _upperBounds[fixing.first()] = fixing.second();
+        }
+
+        Status status = solveLP();
+        if ( status == TIMEOUT )
+        {
+            nodes.append( node );
+            timedOut = true;
+            break;
+        }
+        else if ( status == UNBOUNDED )
+        {
+            unbounded = true;
+            break;
+        }
+        else if ( status == INFEASIBLE )
+            continue;
+
+        double value = computeObjectiveValue();
+        if ( haveIncumbent && !isWorse( incumbentValue, value ) )
+            continue;
+
+        if ( _cutoffInUse && isWorse( value, _cutoff ) )
+        {
+            prunedByCutoff = true;
+            continue;
+        }
+
+        // Branch on the most fractional binary variable
+        unsigned branchVariable = 0;
+        double branchValue = 0;
+        double mostFractional = integralityTolerance;
+        for ( const auto &variable : _binaryVariables )
+        {
+            double fractionality = FloatUtils::abs( _values[variable] - std::round( _values[variable] ) );
+            if ( fractionality > mostFractional )
+            {
+                mostFractional = fractionality;
+                branchVariable = variable;
+                branchValue = _values[variable];
+            }
+        }
+
+        if ( mostFractional == integralityTolerance )
+        {
+            // Integral: a new incumbent
+            incumbent = _values;
+            for ( const auto &variable : _binaryVariables )
+                incumbent[variable] = std::round( incumbent[variable] );
+            incumbentValue = value;
+            haveIncumbent = true;
+            continue;
+        }
+
+        // The child closer to the relaxed value is explored first
+        Node down = node;
+        down._fixings.append( Pair<unsigned, double>( branchVariable, 0 ) );
+        down._bound = value;
+        Node up = node;
+        up._fixings.append( Pair<unsigned, double>( branchVariable, 1 ) );
+        up._bound = value;
+
+        if ( branchValue < 0.5 )
+        {
+            nodes.append( up );
+            nodes.append( down );
+        }
+        else
+        {
+            nodes.append( down );
+            nodes.append( up );
+        }
+    }
+
+    for ( unsigned i = 0; i < _binaryVariables.size(); ++i )
+    {
+        _lowerBounds[_binaryVariables[i]] = originalBounds[i].first();
+        _upperBounds[_binaryVariables[i]] = originalBounds[i].second();
+    }
+
+    if ( haveIncumbent )
+    {
+        _solution = incumbent;
+        _solutionObjective = incumbentValue;
+        _haveSolution = true;
+    }
+
+    if ( unbounded )
+    {
+        _result = UNBOUNDED;
+        _objectiveBound = bestValue;
+    }
+    else if ( timedOut )
+    {
+        // The best bound over the incumbent and the open nodes
+        _result = TIMEOUT;
+        _objectiveBound = haveIncumbent ? incumbentValue : worstValue;
+        for ( const auto &node : nodes )
+        {
+            if ( isWorse( _objectiveBound, node._bound ) )
+                _objectiveBound = node._bound;
+        }
+    }
+    else if ( haveIncumbent )
+    {
+        _result = OPTIMAL;
+        _objectiveBound = incumbentValue;
+    }
+    else
+    {
+        _result = prunedByCutoff ? CUTOFF : INFEASIBLE;
+        _objectiveBound = _cutoffInUse ? _cutoff : worstValue;
+    }
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
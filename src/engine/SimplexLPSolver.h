@@ -0,0 +1,232 @@
+/*********************                                                        */
+/*! \file SimplexLPSolver.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** An in-tree (MI)LP solver, used when Gurobi is unavailable. LPs are
+ ** solved with a bounded-variable revised primal simplex, which uses
+ ** Marabou's basis factorizations for its forward and backward
+ ** transformations. Each constraint is given a slack variable, so that
+ ** the model has the form Ax - s = 0, l <= (x,s) <= u, and the slacks
+ ** form an initial basis. Infeasible starting points are handled by a
+ ** phase that minimizes the sum of infeasibilities, unless the starting
+ ** basis is dual feasible, in which case a dual simplex restores primal
+ ** feasibility while keeping optimality.
+ **
+ ** The final basis of every solve is kept and used as the starting
+ ** point of the next solve, also across changes to the bounds, the
+ ** objective function or the addition of variables and constraints.
+ ** This makes the repeated per-neuron min/max optimizations of the
+ ** bound tightening procedures cheap.
+ **
+ ** Binary variables are handled by a depth-first branch and bound
+ ** over the LP relaxation.
+
+ **/
+
+#ifndef __SimplexLPSolver_h__
+#define __SimplexLPSolver_h__
+
+#include "IBasisFactorization.h"
+#include "ILPSolver.h"
+#include "Map.h"
+#include "Pair.h"
+#include "SparseUnsortedList.h"
+#include "Vector.h"
+
+#include <time.h>
+
+#define SIMPLEX_LP_SOLVER_LOG(x, ...) LOG(GlobalConfiguration::SIMPLEX_LP_SOLVER_LOGGING, "SimplexLPSolver: %s\n", x)
+
+class SimplexLPSolver : public ILPSolver, public IBasisFactorization::BasisColumnOracle
+{
+public:
+    SimplexLPSolver();
+    ~SimplexLPSolver();
+
+    void addVariable( String name, double lb, double ub, VariableType type = CONTINUOUS );
+    void setLowerBound( String name, double lb );
+    void setUpperBound( String name, double ub );
+    void addLeqConstraint( const List<Term> &terms, double scalar );
+    void addGeqConstraint( const List<Term> &terms, double scalar );
+    void addEqConstraint( const List<Term> &terms, double scalar );
+    void setCost( const List<Term> &terms );
+    void setObjective( const List<Term> &terms );
+    void setCutoff( double cutoff );
+    bool optimal();
+    bool cutoffOccurred();
+    bool infeasbile();
+    bool timeout();
+    bool haveFeasibleSolution();
+    void setTimeLimit( double seconds );
+    void solve();
+    void extractSolution( Map<String, double> &values, double &costOrObjective );
+    double getObjectiveBound();
+    void reset();
+    void resetModel();
+    void dumpModel( String name );
+
+    /*
+      The number of simplex iterations performed by the last call to
+      solve(), for testing purposes.
+    */
+    unsigned getNumberOfIterations() const;
+
+    /*
+      Callbacks for the basis factorization
+    */
+    void getColumnOfBasis( unsigned column, double *result ) const;
+    void getColumnOfBasis( unsigned column, SparseUnsortedList *result ) const;
+    void getSparseBasis( SparseColumnsOfBasis &basis ) const;
+
+private:
+    enum Status {
+        NOT_SOLVED = 0,
+        OPTIMAL = 1,
+        INFEASIBLE = 2,
+        CUTOFF = 3,
+        TIMEOUT = 4,
+        UNBOUNDED = 5,
+    };
+
+    enum VariableStatus {
+        BASIC = 0,
+        AT_LOWER = 1,
+        AT_UPPER = 2,
+        // Non-basic and with no finite bounds, fixed at zero
+        FREE = 3,
+    };
+
+    struct Row
+    {
+        List<Pair<unsigned, double>> _terms;
+        unsigned _slack;
+    };
+
+    /*
+      The model. Variables are indexed in the order in which they were
+      added; the slack variables of the constraints are interleaved
+      with the variables of the user.
+    */
+    Vector<String> _variableNames;
+    Map<String, unsigned> _nameToVariable;
+    Vector<double> _lowerBounds;
+    Vector<double> _upperBounds;
+    Vector<unsigned> _binaryVariables;
+    Vector<Row> _rows;
+    Vector<double> _costs;
+    bool _maximize;
+
+    bool _cutoffInUse;
+    double _cutoff;
+    double _defaultTimeLimit;
+    double _timeLimit;
+
+    /*
+      The basis, which survives across solves
+    */
+    Vector<VariableStatus> _variableStatus;
+    Vector<unsigned> _basicIndexToVariable;
+
+    /*
+      Columns of the constraint matrix, built when the model changes
+    */
+    Vector<SparseUnsortedList *> _columns;
+    bool _columnsValid;
+
+    IBasisFactorization *_basisFactorization;
+    unsigned _factorizationSize;
+
+    /*
+      Work memory
+    */
+    Vector<double> _values;
+    double *_rhs;
+    double *_work;
+    double *_changeColumn;
+    double *_duals;
+    double *_basicCosts;
+    double *_pivotRow;
+    unsigned _workSize;
+
+    /*
+      The result of the last solve
+    */
+    Status _result;
+    Vector<double> _solution;
+    double _solutionObjective;
+    bool _haveSolution;
+    double _objectiveBound;
+    unsigned _numIterations;
+    struct timespec _solveStart;
+
+    void addConstraint( const List<Term> &terms, double scalar, char sense );
+    void setObjectiveFunction( const List<Term> &terms, bool maximize );
+    unsigned getVariable( const String &name ) const;
+
+    /*
+      Preparation of the simplex: the columns, the factorization and
+      the values of the non-basic variables
+    */
+    void prepareColumns();
+    void prepareWorkMemory();
+    void placeNonBasic( unsigned variable );
+    void useSlackBasis();
+    bool refactorize();
+    void computeBasicValues();
+
+    /*
+      Solve the LP relaxation under the current bounds. Returns OPTIMAL,
+      INFEASIBLE, UNBOUNDED or TIMEOUT.
+    */
+    Status solveLP();
+
+    /*
+      Perform simplex iterations until optimality, with respect to
+      either the sum of infeasibilities (phase one) or the objective.
+    */
+    Status runSimplex( bool phaseOne );
+    bool computeBasicCosts( bool phaseOne );
+    double computeReducedCost( unsigned variable, bool phaseOne ) const;
+    double computeSumOfInfeasibilities() const;
+    double computeObjectiveValue() const;
+
+    /*
+      Re-optimize a basis that violates some bounds but is dual
+      feasible, possibly after moving boxed non-basic variables to their
+      other bound. Returns OPTIMAL, INFEASIBLE or TIMEOUT, or NOT_SOLVED
+      if the basis is not dual feasible or the dual simplex gave up, in
+      which case the assignment is still consistent with the basis.
+    */
+    Status runDualSimplex();
+    bool makeDualFeasible();
+
+    /*
+      Branch and bound over the binary variables
+    */
+    void solveMILP();
+
+    bool isWorse( double value, double reference ) const;
+    bool shouldQuitDueToTimeout() const;
+    void storeSolution();
+
+    void freeFactorization();
+    void freeColumns();
+    void freeWorkMemory();
+};
+
+#endif // __SimplexLPSolver_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -13,16 +13,20 @@
 
  **/
 
+#include "ContextDependentPiecewiseLinearConstraint.h"
 #include "Debug.h"
 #include "DivideStrategy.h"
 #include "EngineState.h"
 #include "FloatUtils.h"
 #include "GlobalConfiguration.h"
 #include "IEngine.h"
+#include "InfeasibleQueryException.h"
 #include "MStringf.h"
 #include "MarabouError.h"
 #include "Options.h"
+#include "Profiler.h"
 #include "ReluConstraint.h"
+#include "Set.h"
 #include "SmtCore.h"
 
 SmtCore::SmtCore( IEngine *engine )
@@ -32,6 +36,9 @@ SmtCore::SmtCore( IEngine *engine )
     , _constraintForSplitting( NULL )
     , _stateId( 0 )
     , _constraintViolationThreshold( Options::get()->getInt( Options::CONSTRAINT_VIOLATION_THRESHOLD ) )
+    , _conflictAnalysisEnabled( false )
+    , _backjumpPending( false )
+    , _backjumpLevel( 0 )
 {
 }
 
@@ -43,10 +50,7 @@ SmtCore::~SmtCore()
 void SmtCore::freeMemory()
 {
     for ( const auto &stackEntry : _stack )
-    {
-        delete stackEntry->_engineState;
-        delete stackEntry;
-    }
+        releaseStackEntry( stackEntry );
 
     _stack.clear();
 }
@@ -59,6 +63,11 @@ void SmtCore::reset()
     _constraintForSplitting = NULL;
     _stateId = 0;
     _constraintToViolationCount.clear();
+    _conflictAnalysisEnabled = false;
+    _clauseDatabase.clear();
+    _backjumpPending = false;
+    _backjumpLevel = 0;
+    PROFILE_SET_SPLIT_DEPTH( 0 );
 }
 
 void SmtCore::reportViolatedConstraint( PiecewiseLinearConstraint *constraint )
@@ -94,6 +103,8 @@ bool SmtCore::needToSplit() const
 
 void SmtCore::performSplit()
 {
+    PROFILE_SCOPE( "SmtCore::performSplit" );
+
     ASSERT( _needToSplit );
 
     // Maybe the constraint has already become inactive - if so, ignore
@@ -122,22 +133,24 @@ void SmtCore::performSplit()
     List<PiecewiseLinearCaseSplit> splits = _constraintForSplitting->getCaseSplits();
     ASSERT( !splits.empty() );
     ASSERT( splits.size() >= 2 ); // Not really necessary, can add code to handle this case.
+    _engine->saveConstraintOnTrail( _constraintForSplitting );
     _constraintForSplitting->setActiveConstraint( false );
 
     // Obtain the current state of the engine
-    EngineState *stateBeforeSplits = new EngineState;
-    stateBeforeSplits->_stateId = _stateId;
-    ++_stateId;
-    _engine->storeState( *stateBeforeSplits, true );
+    EngineState *stateBeforeSplits = storeStateBeforeSplit();
 
-    SmtStackEntry *stackEntry = new SmtStackEntry;
+    SmtStackEntry *stackEntry = _stackEntryPool.allocate();
     // Perform the first split: add bounds and equations
     List<PiecewiseLinearCaseSplit>::iterator split = splits.begin();
+    _engine->setDecisionLevel( _stack.size() + 1 );
     _engine->applySplit( *split );
     stackEntry->_activeSplit = *split;
+    if ( _conflictAnalysisEnabled )
+        stackEntry->_activePhase = getPhaseOfSplit( _constraintForSplitting, *split );
 
     // Store the remaining splits on the stack, for later
     stackEntry->_engineState = stateBeforeSplits;
+    stackEntry->_numCases = splits.size();
     ++split;
     while ( split != splits.end() )
     {
@@ -146,14 +159,24 @@ void SmtCore::performSplit()
     }
 
     _stack.append( stackEntry );
+    bool consistent = propagatePhases();
+
+    PROFILE_SET_SPLIT_DEPTH( getStackDepth() );
+
     if ( _statistics )
     {
         _statistics->setCurrentStackDepth( getStackDepth() );
+        _statistics->setSearchProgress( getSearchProgress() );
         struct timespec end = TimeUtils::sampleMicro();
         _statistics->addTimeSmtCore( TimeUtils::timePassed( start, end ) );
     }
 
     _constraintForSplitting = NULL;
+
+    // A learned clause rules out the new split; the backjump is
+    // performed by the next pop
+    if ( !consistent )
+        throw InfeasibleQueryException();
 }
 
 unsigned SmtCore::getStackDepth() const
@@ -161,8 +184,27 @@ unsigned SmtCore::getStackDepth() const
     return _stack.size();
 }
 
+double SmtCore::getSearchProgress() const
+{
+    // The cases of a split before its active one have been explored. The
+    // subtree of each case is assumed to be as large as that of any other.
+    double progress = 0;
+    double weight = 1;
+    for ( const auto &stackEntry : _stack )
+    {
+        unsigned numExploredCases =
+            stackEntry->_numCases - 1 - stackEntry->_alternativeSplits.size();
+        weight /= stackEntry->_numCases;
+        progress += weight * numExploredCases;
+    }
+
+    return progress;
+}
+
 bool SmtCore::popSplit()
 {
+    PROFILE_SCOPE( "SmtCore::popSplit" );
+
     SMT_LOG( "Performing a pop" );
 
     if ( _stack.empty() )
@@ -178,10 +220,40 @@ bool SmtCore::popSplit()
         _statistics->incNumVisitedTreeStates();
     }
 
-    // Remove any entries that have no alternatives
-    String error;
-    while ( _stack.back()->_alternativeSplits.empty() )
+    while ( true )
     {
+        // Discard the stack levels that the last conflict did not depend
+        // on, along with their alternative splits
+        if ( _backjumpPending )
+        {
+            _backjumpPending = false;
+            if ( _backjumpLevel < _stack.size() )
+            {
+                SMT_LOG( Stringf( "\tBackjumping to level %u", _backjumpLevel ).ascii() );
+                if ( _statistics )
+                    _statistics->incNumBackjumps();
+
+                while ( _stack.size() > _backjumpLevel )
+                    discardTopStackEntry();
+            }
+        }
+
+        // Remove any entries that have no alternatives
+        while ( !_stack.empty() && _stack.back()->_alternativeSplits.empty() )
+        {
+            if ( checkSkewFromDebuggingSolution() )
+            {
+                // Pops should not occur from a compliant stack!
+                printf( "Error! Popping from a compliant stack\n" );
+                throw MarabouError( MarabouError::DEBUGGING_ERROR );
+            }
+
+            discardTopStackEntry();
+        }
+
+        if ( _stack.empty() )
+            return false;
+
         if ( checkSkewFromDebuggingSolution() )
         {
             // Pops should not occur from a compliant stack!
@@ -189,44 +261,48 @@ bool SmtCore::popSplit()
             throw MarabouError( MarabouError::DEBUGGING_ERROR );
         }
 
-        delete _stack.back()->_engineState;
-        delete _stack.back();
-        _stack.popBack();
+        SmtStackEntry *stackEntry = _stack.back();
 
-        if ( _stack.empty() )
-            return false;
-    }
+        // Restore the state of the engine
+        SMT_LOG( "\tRestoring engine state..." );
+        _engine->restoreState( *( stackEntry->_engineState ) );
+        _engine->setDecisionLevel( _stack.size() );
+        retractPhases( stackEntry );
+        SMT_LOG( "\tRestoring engine state - DONE" );
 
-    if ( checkSkewFromDebuggingSolution() )
-    {
-        // Pops should not occur from a compliant stack!
-        printf( "Error! Popping from a compliant stack\n" );
-        throw MarabouError( MarabouError::DEBUGGING_ERROR );
-    }
+        // Apply the new split and erase it from the list
+        auto split = stackEntry->_alternativeSplits.begin();
 
-    SmtStackEntry *stackEntry = _stack.back();
+        // Erase any valid splits that were learned using the split we just popped
+        stackEntry->_impliedValidSplits.clear();
 
-    // Restore the state of the engine
-    SMT_LOG( "\tRestoring engine state..." );
-    _engine->restoreState( *( stackEntry->_engineState ) );
-    SMT_LOG( "\tRestoring engine state - DONE" );
+        SMT_LOG( "\tApplying new split..." );
+        _engine->applySplit( *split );
+        SMT_LOG( "\tApplying new split - DONE" );
 
-    // Apply the new split and erase it from the list
-    auto split = stackEntry->_alternativeSplits.begin();
+        stackEntry->_activeSplit = *split;
+        if ( _conflictAnalysisEnabled && stackEntry->_activePhase.known() )
+            stackEntry->_activePhase = getPhaseOfSplit( stackEntry->_activePhase._constraint, *split );
+        stackEntry->_alternativeSplits.erase( split );
 
-    // Erase any valid splits that were learned using the split we just popped
-    stackEntry->_impliedValidSplits.clear();
+        if ( propagatePhases() )
+            break;
 
-    SMT_LOG( "\tApplying new split..." );
-    _engine->applySplit( *split );
-    SMT_LOG( "\tApplying new split - DONE" );
+        // A learned clause rules out the new split as well
+        SMT_LOG( "\tNew split violates a learned clause" );
+        if ( _statistics )
+        {
+            _statistics->incNumPops();
+            _statistics->incNumVisitedTreeStates();
+        }
+    }
 
-    stackEntry->_activeSplit = *split;
-    stackEntry->_alternativeSplits.erase( split );
+    PROFILE_SET_SPLIT_DEPTH( getStackDepth() );
 
     if ( _statistics )
     {
         _statistics->setCurrentStackDepth( getStackDepth() );
+        _statistics->setSearchProgress( getSearchProgress() );
         struct timespec end = TimeUtils::sampleMicro();
         _statistics->addTimeSmtCore( TimeUtils::timePassed( start, end ) );
     }
@@ -272,6 +348,11 @@ void SmtCore::setStatistics( Statistics *statistics )
     _statistics = statistics;
 }
 
+void SmtCore::setConstraintViolationThreshold( unsigned threshold )
+{
+    _constraintViolationThreshold = threshold;
+}
+
 void SmtCore::storeDebuggingSolution( const Map<unsigned, double> &debuggingSolution )
 {
     _debuggingSolution = debuggingSolution;
@@ -403,10 +484,17 @@ PiecewiseLinearConstraint *SmtCore::chooseViolatedConstraintForFixing( List<Piec
     return candidate;
 }
 
-void SmtCore::replaySmtStackEntry( SmtStackEntry *stackEntry )
+void SmtCore::replaySmtStackEntry( const SmtStackEntry *storedEntry )
 {
     struct timespec start = TimeUtils::sampleMicro();
 
+    // The stored entry was allocated outside of the pool
+    SmtStackEntry *stackEntry = _stackEntryPool.allocate();
+    stackEntry->_activeSplit = storedEntry->_activeSplit;
+    stackEntry->_impliedValidSplits = storedEntry->_impliedValidSplits;
+    stackEntry->_alternativeSplits = storedEntry->_alternativeSplits;
+    stackEntry->_numCases = storedEntry->_numCases;
+
     if ( _statistics )
     {
         _statistics->incNumSplits();
@@ -414,22 +502,22 @@ void SmtCore::replaySmtStackEntry( SmtStackEntry *stackEntry )
     }
 
     // Obtain the current state of the engine
-    EngineState *stateBeforeSplits = new EngineState;
-    stateBeforeSplits->_stateId = _stateId;
-    ++_stateId;
-    _engine->storeState( *stateBeforeSplits, true );
-    stackEntry->_engineState = stateBeforeSplits;
+    stackEntry->_engineState = storeStateBeforeSplit();
 
     // Apply all the splits
+    _engine->setDecisionLevel( _stack.size() + 1 );
     _engine->applySplit( stackEntry->_activeSplit );
     for ( const auto &impliedSplit : stackEntry->_impliedValidSplits )
         _engine->applySplit( impliedSplit );
 
     _stack.append( stackEntry );
 
+    PROFILE_SET_SPLIT_DEPTH( getStackDepth() );
+
     if ( _statistics )
     {
         _statistics->setCurrentStackDepth( getStackDepth() );
+        _statistics->setSearchProgress( getSearchProgress() );
         struct timespec end = TimeUtils::sampleMicro();
         _statistics->addTimeSmtCore( TimeUtils::timePassed( start, end ) );
     }
@@ -451,3 +539,276 @@ bool SmtCore::pickSplitPLConstraint()
         _constraintForSplitting = _engine->pickSplitPLConstraint();
     return _constraintForSplitting != NULL;
 }
+
+bool SmtCore::conflictAnalysisEnabled() const
+{
+    return _conflictAnalysisEnabled;
+}
+
+void SmtCore::analyzeConflict( const List<ExplanationBound> &explanation )
+{
+    if ( !_conflictAnalysisEnabled || _stack.empty() )
+        return;
+
+    // The conflict depends on all the decisions up to prefixLevel, and
+    // on the decisions at decisionLevels
+    unsigned prefixLevel = 0;
+    Set<unsigned> decisionLevels;
+
+    for ( const auto &explanationBound : explanation )
+    {
+        unsigned level = explanationBound._level;
+        if ( level > _stack.size() )
+            level = _stack.size();
+
+        // Bounds set at the root, or covered by the prefix, add nothing
+        if ( level <= prefixLevel )
+            continue;
+
+        // A bound that is entailed by a decision depends on that
+        // decision only
+        unsigned decisionLevel = 0;
+        unsigned currentLevel = 1;
+        for ( const auto &stackEntry : _stack )
+        {
+            if ( currentLevel > level )
+                break;
+
+            if ( splitEntailsBound( stackEntry->_activeSplit, explanationBound._bound ) )
+            {
+                decisionLevel = currentLevel;
+                break;
+            }
+
+            ++currentLevel;
+        }
+
+        if ( decisionLevel > 0 )
+            decisionLevels.insert( decisionLevel );
+        else
+            prefixLevel = level;
+    }
+
+    unsigned conflictLevel = prefixLevel;
+    unsigned numLevels = prefixLevel;
+    for ( const auto &level : decisionLevels )
+    {
+        if ( level > prefixLevel )
+        {
+            ++numLevels;
+            if ( level > conflictLevel )
+                conflictLevel = level;
+        }
+    }
+
+    SMT_LOG( Stringf( "Conflict depends on %u of %u stack levels", numLevels, _stack.size() ).ascii() );
+    scheduleBackjump( conflictLevel );
+
+    // A clause made of all the levels up to the conflict level prunes
+    // nothing that the backjump does not
+    if ( numLevels == conflictLevel )
+        return;
+
+    List<PhaseLiteral> phases;
+    unsigned currentLevel = _stack.size();
+    for ( auto it = _stack.rbegin(); it != _stack.rend(); ++it, --currentLevel )
+    {
+        if ( currentLevel > conflictLevel )
+            continue;
+
+        if ( currentLevel > prefixLevel && !decisionLevels.exists( currentLevel ) )
+            continue;
+
+        if ( !( *it )->_activePhase.known() )
+            return;
+
+        phases.append( ( *it )->_activePhase );
+    }
+
+    _clauseDatabase.addClause( phases );
+    if ( _statistics )
+        _statistics->incNumLearnedClauses();
+}
+
+EngineState *SmtCore::storeStateBeforeSplit()
+{
+    EngineState *state = _engineStatePool.allocate();
+    state->_stateId = _stateId;
+    ++_stateId;
+
+    // Prefer the undo trails, and fall back to a full copy if they are
+    // unavailable. Conflict analysis requires the trails.
+    bool storedOnTrail = _engine->storeStateOnTrail( *state );
+    if ( !storedOnTrail )
+        _engine->storeState( *state, true );
+
+    _conflictAnalysisEnabled = storedOnTrail && GlobalConfiguration::USE_CONFLICT_ANALYSIS;
+    return state;
+}
+
+void SmtCore::scheduleBackjump( unsigned level )
+{
+    if ( _backjumpPending && _backjumpLevel <= level )
+        return;
+
+    _backjumpPending = true;
+    _backjumpLevel = level;
+}
+
+void SmtCore::discardTopStackEntry()
+{
+    SmtStackEntry *stackEntry = _stack.back();
+    retractPhases( stackEntry );
+    releaseStackEntry( stackEntry );
+    _stack.popBack();
+}
+
+void SmtCore::releaseStackEntry( SmtStackEntry *stackEntry )
+{
+    if ( stackEntry->_engineState )
+    {
+        stackEntry->_engineState->reset();
+        _engineStatePool.release( stackEntry->_engineState );
+    }
+
+    *stackEntry = SmtStackEntry();
+    _stackEntryPool.release( stackEntry );
+}
+
+void SmtCore::retractPhases( SmtStackEntry *stackEntry )
+{
+    for ( auto it = stackEntry->_impliedPhases.rbegin(); it != stackEntry->_impliedPhases.rend(); ++it )
+        _clauseDatabase.retractPhase( it->_constraint );
+    stackEntry->_impliedPhases.clear();
+
+    if ( stackEntry->_activePhase.known() )
+        _clauseDatabase.retractPhase( stackEntry->_activePhase._constraint );
+}
+
+bool SmtCore::propagatePhases()
+{
+    if ( !_conflictAnalysisEnabled )
+        return true;
+
+    ASSERT( !_stack.empty() );
+    SmtStackEntry *stackEntry = _stack.back();
+
+    List<PhaseLiteral> refutedPhases;
+    bool consistent = _clauseDatabase.propagate( refutedPhases );
+    if ( consistent && stackEntry->_activePhase.known() )
+        consistent = _clauseDatabase.assertPhase( stackEntry->_activePhase, refutedPhases );
+
+    // Apply the other phase of each refuted two-phase constraint. This
+    // may refute further phases, which are appended to the list.
+    for ( auto it = refutedPhases.begin(); consistent && it != refutedPhases.end(); ++it )
+    {
+        if ( _clauseDatabase.hasAssertedPhase( it->_constraint ) )
+            continue;
+
+        PhaseLiteral impliedPhase = getOtherPhase( *it );
+        if ( !impliedPhase.known() )
+            continue;
+
+        ContextDependentPiecewiseLinearConstraint *constraint =
+            static_cast<ContextDependentPiecewiseLinearConstraint *>( impliedPhase._constraint );
+        PiecewiseLinearCaseSplit split = constraint->getCaseSplit( impliedPhase._phase );
+
+        SMT_LOG( "\tApplying a split implied by a learned clause" );
+        _engine->applySplit( split );
+        stackEntry->_impliedValidSplits.append( split );
+        stackEntry->_impliedPhases.append( impliedPhase );
+        if ( _statistics )
+            _statistics->incNumClausePropagations();
+
+        consistent = _clauseDatabase.assertPhase( impliedPhase, refutedPhases );
+    }
+
+    if ( !consistent )
+    {
+        // The violated clause depends on the levels at which its phases
+        // were asserted
+        unsigned level = 0;
+        for ( const auto &phase : _clauseDatabase.getViolatedClause() )
+        {
+            unsigned phaseLevel = getLevelOfPhase( phase );
+            if ( phaseLevel > level )
+                level = phaseLevel;
+        }
+
+        scheduleBackjump( level );
+    }
+
+    return consistent;
+}
+
+PhaseLiteral SmtCore::getPhaseOfSplit( PiecewiseLinearConstraint *constraint,
+                                       const PiecewiseLinearCaseSplit &split ) const
+{
+    // Disjunctions are only split on while conflict analysis is enabled
+    // if they are the temporary ones created for input interval
+    // splitting (see Engine::stateTrailUsable()). These do not outlive
+    // the split, so their phases cannot be learned.
+    if ( constraint->getType() == DISJUNCTION )
+        return PhaseLiteral();
+
+    ContextDependentPiecewiseLinearConstraint *cdConstraint =
+        dynamic_cast<ContextDependentPiecewiseLinearConstraint *>( constraint );
+    if ( !cdConstraint )
+        return PhaseLiteral();
+
+    for ( const auto &phase : cdConstraint->getAllCases() )
+    {
+        if ( cdConstraint->getCaseSplit( phase ) == split )
+            return PhaseLiteral( constraint, phase );
+    }
+
+    return PhaseLiteral();
+}
+
+PhaseLiteral SmtCore::getOtherPhase( const PhaseLiteral &phase ) const
+{
+    ContextDependentPiecewiseLinearConstraint *cdConstraint =
+        dynamic_cast<ContextDependentPiecewiseLinearConstraint *>( phase._constraint );
+    if ( !cdConstraint )
+        return PhaseLiteral();
+
+    List<PhaseStatus> phases = cdConstraint->getAllCases();
+    if ( phases.size() != 2 )
+        return PhaseLiteral();
+
+    if ( phases.front() == phase._phase )
+        return PhaseLiteral( phase._constraint, phases.back() );
+    if ( phases.back() == phase._phase )
+        return PhaseLiteral( phase._constraint, phases.front() );
+
+    return PhaseLiteral();
+}
+
+unsigned SmtCore::getLevelOfPhase( const PhaseLiteral &phase ) const
+{
+    unsigned level = 1;
+    for ( const auto &stackEntry : _stack )
+    {
+        if ( stackEntry->_activePhase == phase || stackEntry->_impliedPhases.exists( phase ) )
+            return level;
+        ++level;
+    }
+
+    return _stack.size();
+}
+
+bool SmtCore::splitEntailsBound( const PiecewiseLinearCaseSplit &split, const Tightening &bound ) const
+{
+    for ( const auto &splitBound : split.getBoundTightenings() )
+    {
+        if ( splitBound._variable != bound._variable || splitBound._type != bound._type )
+            continue;
+
+        if ( bound._type == Tightening::LB && splitBound._value >= bound._value )
+            return true;
+        if ( bound._type == Tightening::UB && splitBound._value <= bound._value )
+            return true;
+    }
+
+    return false;
+}
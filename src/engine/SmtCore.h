@@ -16,6 +16,8 @@
 #ifndef __SmtCore_h__
 #define __SmtCore_h__
 
+#include "ClauseDatabase.h"
+#include "ObjectPool.h"
 #include "PiecewiseLinearCaseSplit.h"
 #include "PiecewiseLinearConstraint.h"
 #include "SmtState.h"
@@ -37,6 +39,16 @@ public:
     SmtCore( IEngine *engine );
     ~SmtCore();
 
+    /*
+      A bound that takes part in the explanation of a conflict, and the
+      decision level at which it was set.
+    */
+    struct ExplanationBound
+    {
+        Tightening _bound;
+        unsigned _level;
+    };
+
     /*
       Clear the stack.
     */
@@ -77,14 +89,39 @@ public:
     /*
       Pop an old split from the stack, and perform a new split as
       needed. Return true if successful, false if the stack is empty.
+      If a conflict was analyzed, first discard the stack levels that
+      it does not depend on.
     */
     bool popSplit();
 
+    /*
+      Conflict analysis. Given bounds that explain why the current
+      search state is infeasible, find the decisions that the conflict
+      depends on: a bound set at some decision level depends on all the
+      decisions up to that level, unless it is entailed by a single
+      decision. The next popSplit() backjumps to the deepest of these
+      decisions, and if their phases are known and they do not make up
+      the entire stack, they are learned as a clause.
+
+      Conflict analysis is enabled when the engine stores its states on
+      the undo trails, i.e. when no case split adds equations: the
+      tableau rows are then the same at every decision level.
+    */
+    bool conflictAnalysisEnabled() const;
+    void analyzeConflict( const List<ExplanationBound> &explanation );
+
     /*
       The current stack depth.
     */
     unsigned getStackDepth() const;
 
+    /*
+      An estimate of the fraction of the search tree that has been
+      explored, based on how many cases of each split on the stack have
+      been explored.
+    */
+    double getSearchProgress() const;
+
     /*
       Let the smt core know of an implied valid case split that was discovered.
     */
@@ -110,9 +147,10 @@ public:
     void setConstraintViolationThreshold( unsigned threshold );
 
     /*
-      Replay a stackEntry
+      Replay a stackEntry. The entry is copied onto the stack, and
+      remains owned by the caller.
     */
-    void replaySmtStackEntry( SmtStackEntry *stackEntry );
+    void replaySmtStackEntry( const SmtStackEntry *stackEntry );
 
     /*
       Store the current state of the SmtCore into smtState
@@ -179,6 +217,76 @@ private:
       Split when some relu has been violated for this many times
     */
     unsigned _constraintViolationThreshold;
+
+    /*
+      Conflict analysis: the learned clauses, and the decision level
+      that the next pop should backjump to.
+    */
+    bool _conflictAnalysisEnabled;
+    ClauseDatabase _clauseDatabase;
+    bool _backjumpPending;
+    unsigned _backjumpLevel;
+
+    /*
+      The stack entries and the engine states stored in them are
+      recycled through these pools, rather than allocated and freed with
+      every split and pop.
+    */
+    ObjectPool<SmtStackEntry> _stackEntryPool;
+    ObjectPool<EngineState> _engineStatePool;
+
+    /*
+      Store the state of the engine before a split, and note whether
+      conflict analysis can be used.
+    */
+    EngineState *storeStateBeforeSplit();
+
+    /*
+      Return a stack entry, along with its engine state, to the pools.
+    */
+    void releaseStackEntry( SmtStackEntry *stackEntry );
+
+    /*
+      Schedule a backjump to the given level, unless one to a lower
+      level is already scheduled.
+    */
+    void scheduleBackjump( unsigned level );
+
+    /*
+      Discard the top stack entry, retracting its phases.
+    */
+    void discardTopStackEntry();
+
+    /*
+      Retract the phases asserted at a stack level.
+    */
+    void retractPhases( SmtStackEntry *stackEntry );
+
+    /*
+      Assert the phase of the active split of the top stack entry, and
+      apply the splits implied by the learned clauses. Returns false,
+      after scheduling a backjump, if a learned clause is violated.
+    */
+    bool propagatePhases();
+
+    /*
+      The phase of a constraint that corresponds to a case split, and
+      the other phase of a two-phase constraint. Return unknown phases
+      if these cannot be determined.
+    */
+    PhaseLiteral getPhaseOfSplit( PiecewiseLinearConstraint *constraint,
+                                  const PiecewiseLinearCaseSplit &split ) const;
+    PhaseLiteral getOtherPhase( const PhaseLiteral &phase ) const;
+
+    /*
+      The stack level at which a phase was asserted.
+    */
+    unsigned getLevelOfPhase( const PhaseLiteral &phase ) const;
+
+    /*
+      Check whether the bounds of a case split entail a bound.
+    */
+    bool splitEntailsBound( const PiecewiseLinearCaseSplit &split, const Tightening &bound ) const;
 };
 
 #endif // __SmtCore_h__
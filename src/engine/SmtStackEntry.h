@@ -17,6 +17,7 @@
 #define __SmtStackEntry_h__
 
 #include "EngineState.h"
+#include "PhaseLiteral.h"
 #include "PiecewiseLinearCaseSplit.h"
 
 /*
@@ -30,8 +31,22 @@ public:
     PiecewiseLinearCaseSplit _activeSplit;
     List<PiecewiseLinearCaseSplit> _impliedValidSplits;
     List<PiecewiseLinearCaseSplit> _alternativeSplits;
+
+    /*
+      The number of cases of the split, explored or not
+    */
+    unsigned _numCases;
     EngineState *_engineState;
 
+    /*
+      For conflict analysis: the phase chosen by the active split, if
+      known, and the phases implied by learned clauses at this level.
+      These are not copied by duplicateSmtStackEntry(), since the
+      constraints belong to a specific engine.
+    */
+    PhaseLiteral _activePhase;
+    List<PhaseLiteral> _impliedPhases;
+
     /*
       Create a copy of the SmtStackEntry on the stack and returns a pointer to
       the copy.
@@ -45,6 +60,7 @@ public:
         copy->_activeSplit = _activeSplit;
         copy->_impliedValidSplits = _impliedValidSplits;
         copy->_alternativeSplits = _alternativeSplits;
+        copy->_numCases = _numCases;
         copy->_engineState = NULL;
 
         return copy;
@@ -0,0 +1,118 @@
+/*********************                                                        */
+/*! \file SolverSession.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** Implementation of the solver session. The base query is preprocessed and
+ ** its engine state stored once, in the constructor. Every call to solve()
+ ** restores that state, translates the query's bounds and equations into
+ ** the preprocessed variables, and applies them as a case split before
+ ** solving. If preprocessing alone shows the base query to be infeasible,
+ ** every query is UNSAT.
+
+ **/
+
+#include "SolverSession.h"
+
+SolverSession::SolverSession( const InputQuery &baseQuery )
+    : _baseQuery( baseQuery )
+    , _baseQueryInfeasible( false )
+    , _numSolvedQueries( 0 )
+    , _lastExitCode( IEngine::NOT_DONE )
+{
+    if ( !_engine.processInputQuery( _baseQuery ) )
+    {
+        // Solved by preprocessing
+        _baseQueryInfeasible = true;
+        return;
+    }
+
+    _engine.storeState( _baseState, true );
+}
+
+IEngine::ExitCode SolverSession::solve( const PiecewiseLinearCaseSplit &property,
+                                        unsigned timeoutInSeconds )
+{
+    ++_numSolvedQueries;
+
+    // Undo the previous query, if any
+    if ( !_baseQueryInfeasible )
+    {
+        _engine.restoreState( _baseState );
+        _engine.reset();
+    }
+
+    PiecewiseLinearCaseSplit translated;
+    if ( _baseQueryInfeasible || !_engine.translateSplitToPreprocessedQuery( property, translated ) )
+    {
+        _lastExitCode = IEngine::UNSAT;
+        return _lastExitCode;
+    }
+
+    _engine.applySplit( translated );
+    _engine.solve( timeoutInSeconds );
+
+    _lastExitCode = _engine.getExitCode();
+    return _lastExitCode;
+}
+
+IEngine::ExitCode SolverSession::solve( const Map<unsigned, double> &lowerBounds,
+                                        const Map<unsigned, double> &upperBounds,
+                                        const List<Equation> &equations,
+                                        unsigned timeoutInSeconds )
+{
+    PiecewiseLinearCaseSplit property;
+    for ( const auto &bound : lowerBounds )
+        property.storeBoundTightening( Tightening( bound.first, bound.second, Tightening::LB ) );
+    for ( const auto &bound : upperBounds )
+        property.storeBoundTightening( Tightening( bound.first, bound.second, Tightening::UB ) );
+    for ( const auto &equation : equations )
+        property.addEquation( equation );
+
+    return solve( property, timeoutInSeconds );
+}
+
+void SolverSession::extractSolution( InputQuery &inputQuery )
+{
+    ASSERT( _lastExitCode == IEngine::SAT );
+    _engine.extractSolution( inputQuery );
+}
+
+void SolverSession::extractSolution( Map<unsigned, double> &values )
+{
+    InputQuery solution = _baseQuery;
+    extractSolution( solution );
+
+    values.clear();
+    for ( unsigned i = 0; i < solution.getNumberOfVariables(); ++i )
+        values[i] = solution.getSolutionValue( i );
+}
+
+const Statistics *SolverSession::getStatistics() const
+{
+    return _engine.getStatistics();
+}
+
+unsigned SolverSession::getNumSolvedQueries() const
+{
+    return _numSolvedQueries;
+}
+
+const InputQuery &SolverSession::getBaseQuery() const
+{
+    return _baseQuery;
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
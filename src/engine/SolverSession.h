@@ -0,0 +1,111 @@
+/*********************                                                        */
+/*! \file SolverSession.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** A session for solving many queries that share a network and differ
+ ** only in some bounds and equations (e.g., a sweep over properties).
+ ** The base query is preprocessed and loaded into an engine once; each
+ ** query is then solved by restoring the engine to its base state and
+ ** applying the query's bounds and equations as a case split.
+ **/
+
+#ifndef __SolverSession_h__
+#define __SolverSession_h__
+
+#include "Engine.h"
+#include "EngineState.h"
+#include "InputQuery.h"
+#include "List.h"
+#include "Map.h"
+#include "PiecewiseLinearCaseSplit.h"
+
+class SolverSession
+{
+public:
+    /*
+      Preprocess the base query and set up the engine. The bounds of
+      the base query must hold for all queries solved in the session:
+      bounds passed to solve() can only tighten them.
+    */
+    SolverSession( const InputQuery &baseQuery );
+
+    /*
+      Solve the base query, conjoined with the bounds and equations of
+      the given split, which are over the variables of the base query.
+      Returns SAT, UNSAT, TIMEOUT, QUIT_REQUESTED or ERROR.
+    */
+    IEngine::ExitCode solve( const PiecewiseLinearCaseSplit &property,
+                             unsigned timeoutInSeconds = 0 );
+
+    /*
+      Solve the base query, conjoined with the given lower bounds,
+      upper bounds and equations. This is the form in which queries
+      arrive from the Python bindings.
+    */
+    IEngine::ExitCode solve( const Map<unsigned, double> &lowerBounds,
+                             const Map<unsigned, double> &upperBounds,
+                             const List<Equation> &equations,
+                             unsigned timeoutInSeconds = 0 );
+
+    /*
+      If the last query was SAT, store the solution (over the variables
+      of the base query) in the given query.
+    */
+    void extractSolution( InputQuery &inputQuery );
+
+    /*
+      If the last query was SAT, store the value of every variable of
+      the base query in the given map.
+    */
+    void extractSolution( Map<unsigned, double> &values );
+
+    /*
+      The statistics of the last call to solve().
+    */
+    const Statistics *getStatistics() const;
+
+    /*
+      The number of queries solved in this session.
+    */
+    unsigned getNumSolvedQueries() const;
+
+    /*
+      The base query, over whose variables solutions are extracted.
+    */
+    const InputQuery &getBaseQuery() const;
+
+private:
+    InputQuery _baseQuery;
+    Engine _engine;
+
+    /*
+      The state of the engine right after the base query was processed.
+    */
+    EngineState _baseState;
+
+    /*
+      True if the base query was found infeasible during processing,
+      in which case every query in the session is UNSAT.
+    */
+    bool _baseQueryInfeasible;
+
+    unsigned _numSolvedQueries;
+    IEngine::ExitCode _lastExitCode;
+};
+
+#endif // __SolverSession_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -21,13 +21,16 @@
 #include "PiecewiseLinearCaseSplit.h"
 #include "SmtState.h"
 
-#include <boost/lockfree/queue.hpp>
+#include <memory>
 #include <utility>
 
 // Struct representing a subquery
 struct SubQuery
 {
     SubQuery()
+        : _timeoutInSeconds( 0 )
+        , _depth( 0 )
+        , _numExtensions( 0 )
     {
     }
 
@@ -36,11 +39,11 @@ struct SubQuery
     std::unique_ptr<SmtState> _smtState;
     unsigned _timeoutInSeconds;
     unsigned _depth;
-};
 
-// Synchronized Queue containing the Sub-Queries shared by workers
-typedef boost::lockfree::queue<SubQuery *, boost::lockfree::
-  fixed_sized<false>>WorkerQueue;
+    // The number of times the subquery was given more time instead of
+    // being divided
+    unsigned _numExtensions;
+};
 
 // A vector of Sub-Queries
 
@@ -27,24 +27,26 @@
 #include "MalformedBasisException.h"
 #include "MarabouError.h"
 #include "PiecewiseLinearCaseSplit.h"
+#include "Profiler.h"
+#include "SparseUnsortedArrays.h"
+#include "TableauMatrix.h"
 #include "TableauRow.h"
 #include "TableauState.h"
+#include "Tightening.h"
 
 #include <string.h>
 
 Tableau::Tableau()
     : _n( 0 )
     , _m( 0 )
-    , _A( NULL )
-    , _sparseColumnsOfA( NULL )
-    , _sparseRowsOfA( NULL )
-    , _denseA( NULL )
+    , _denseAColumn( NULL )
     , _changeColumn( NULL )
     , _pivotRow( NULL )
     , _b( NULL )
     , _workM( NULL )
     , _workN( NULL )
-    , _unitVector( NULL )
+    , _dualSteepestEdgeWeights( NULL )
+    , _dualSteepestEdgeWork( NULL )
     , _basisFactorization( NULL )
     , _multipliers( NULL )
     , _basicIndexToVariable( NULL )
@@ -53,6 +55,10 @@ Tableau::Tableau()
     , _nonBasicAssignment( NULL )
     , _lowerBounds( NULL )
     , _upperBounds( NULL )
+    , _boundChanged( NULL )
+    , _lowerBoundLevels( NULL )
+    , _upperBoundLevels( NULL )
+    , _decisionLevel( 0 )
     , _boundsValid( true )
     , _basicAssignment( NULL )
     , _basicStatus( NULL )
@@ -60,6 +66,7 @@ Tableau::Tableau()
     , _statistics( NULL )
     , _costFunctionManager( NULL )
     , _rhsIsAllZeros( true )
+    , _boundTrailEnabled( false )
 {
 }
 
@@ -70,46 +77,12 @@ Tableau::~Tableau()
 
 void Tableau::freeMemoryIfNeeded()
 {
-    if ( _A )
-    {
-        delete _A;
-        _A = NULL;
-    }
-
-    if ( _sparseColumnsOfA )
-    {
-        for ( unsigned i = 0; i < _n; ++i )
-        {
-            if ( _sparseColumnsOfA[i] )
-            {
-                delete _sparseColumnsOfA[i];
-                _sparseColumnsOfA[i] = NULL;
-            }
-        }
-
-        delete[] _sparseColumnsOfA;
-        _sparseColumnsOfA = NULL;
-    }
-
-    if ( _sparseRowsOfA )
-    {
-        for ( unsigned i = 0; i < _m; ++i )
-        {
-            if ( _sparseRowsOfA[i] )
-            {
-                delete _sparseRowsOfA[i];
-                _sparseRowsOfA[i] = NULL;
-            }
-        }
-
-        delete[] _sparseRowsOfA;
-        _sparseRowsOfA = NULL;
-    }
+    _matrix.reset();
 
-    if ( _denseA )
+    if ( _denseAColumn )
     {
-        delete[] _denseA;
-        _denseA = NULL;
+        delete[] _denseAColumn;
+        _denseAColumn = NULL;
     }
 
     if ( _changeColumn )
@@ -130,10 +103,16 @@ void Tableau::freeMemoryIfNeeded()
         _b = NULL;
     }
 
-    if ( _unitVector )
+    if ( _dualSteepestEdgeWeights )
     {
-        delete[] _unitVector;
-        _unitVector = NULL;
+        delete[] _dualSteepestEdgeWeights;
+        _dualSteepestEdgeWeights = NULL;
+    }
+
+    if ( _dualSteepestEdgeWork )
+    {
+        delete[] _dualSteepestEdgeWork;
+        _dualSteepestEdgeWork = NULL;
     }
 
     if ( _multipliers )
@@ -178,6 +157,24 @@ void Tableau::freeMemoryIfNeeded()
         _upperBounds = NULL;
     }
 
+    if ( _boundChanged )
+    {
+        delete[] _boundChanged;
+        _boundChanged = NULL;
+    }
+
+    if ( _lowerBoundLevels )
+    {
+        delete[] _lowerBoundLevels;
+        _lowerBoundLevels = NULL;
+    }
+
+    if ( _upperBoundLevels )
+    {
+        delete[] _upperBoundLevels;
+        _upperBoundLevels = NULL;
+    }
+
     if ( _basicAssignment )
     {
         delete[] _basicAssignment;
@@ -211,38 +208,20 @@ void Tableau::freeMemoryIfNeeded()
 
 void Tableau::setDimensions( unsigned m, unsigned n )
 {
-    _m = m;
-    _n = n;
-
-    _A = new CSRMatrix();
-    if ( !_A )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::A" );
-
-    _sparseColumnsOfA = new SparseUnsortedList *[n];
-    if ( !_sparseColumnsOfA )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::sparseColumnsOfA" );
+    _matrix = std::make_shared<TableauMatrix>();
+    _matrix->setDimensions( m, n );
 
-    for ( unsigned i = 0; i < n; ++i )
-    {
-        _sparseColumnsOfA[i] = new SparseUnsortedList( _m );
-        if ( !_sparseColumnsOfA[i] )
-            throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::sparseColumnsOfA[i]" );
-    }
-
-    _sparseRowsOfA = new SparseUnsortedList *[m];
-    if ( !_sparseRowsOfA )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::sparseRowOfA" );
+    allocateMemory( m, n );
+}
 
-    for ( unsigned i = 0; i < m; ++i )
-    {
-        _sparseRowsOfA[i] = new SparseUnsortedList( _n );
-        if ( !_sparseRowsOfA[i] )
-            throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::sparseRowOfA[i]" );
-    }
+void Tableau::allocateMemory( unsigned m, unsigned n )
+{
+    _m = m;
+    _n = n;
 
-    _denseA = new double[m*n];
-    if ( !_denseA )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::denseA" );
+    _denseAColumn = new double[m];
+    if ( !_denseAColumn )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::denseAColumn" );
 
     _changeColumn = new double[m];
     if ( !_changeColumn )
@@ -256,9 +235,14 @@ void Tableau::setDimensions( unsigned m, unsigned n )
     if ( !_b )
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::b" );
 
-    _unitVector = new double[m];
-    if ( !_unitVector )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::unitVector" );
+    _dualSteepestEdgeWeights = new double[m];
+    if ( !_dualSteepestEdgeWeights )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::dualSteepestEdgeWeights" );
+    std::fill_n( _dualSteepestEdgeWeights, m, 1.0 );
+
+    _dualSteepestEdgeWork = new double[m];
+    if ( !_dualSteepestEdgeWork )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::dualSteepestEdgeWork" );
 
     _multipliers = new double[m];
     if ( !_multipliers )
@@ -290,6 +274,24 @@ void Tableau::setDimensions( unsigned m, unsigned n )
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::upperBounds" );
     std::fill_n( _upperBounds, n, FloatUtils::infinity() );
 
+    _boundChanged = new char[n];
+    if ( !_boundChanged )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::boundChanged" );
+    std::fill_n( _boundChanged, n, 0 );
+    _changedVariables.clear();
+
+    // The origin of the bounds is unknown, e.g. after a full state
+    // restoration, so they are attributed to the current level
+    _lowerBoundLevels = new unsigned[n];
+    if ( !_lowerBoundLevels )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::lowerBoundLevels" );
+    std::fill_n( _lowerBoundLevels, n, _decisionLevel );
+
+    _upperBoundLevels = new unsigned[n];
+    if ( !_upperBoundLevels )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::upperBoundLevels" );
+    std::fill_n( _upperBoundLevels, n, _decisionLevel );
+
     _basicAssignment = new double[m];
     if ( !_basicAssignment )
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::assignment" );
@@ -317,18 +319,56 @@ void Tableau::setDimensions( unsigned m, unsigned n )
 
 void Tableau::setConstraintMatrix( const double *A )
 {
-    _A->initialize( A, _m, _n );
+    makeMatrixUnique();
+
+    _matrix->_A->initialize( A, _m, _n );
 
     for ( unsigned column = 0; column < _n; ++column )
+        _matrix->_sparseColumnsOfA[column]->clear();
+
+    for ( unsigned row = 0; row < _m; ++row )
     {
-        for ( unsigned row = 0; row < _m; ++row )
-            _denseA[column*_m + row] = A[row*_n + column];
+        _matrix->_sparseRowsOfA[row]->initialize( A + ( row * _n ), _n );
 
-        _sparseColumnsOfA[column]->initialize( _denseA + ( column * _m ), _m );
+        for ( const auto &entry : *_matrix->_sparseRowsOfA[row] )
+            _matrix->_sparseColumnsOfA[entry._index]->append( row, entry._value );
     }
+}
+
+void Tableau::setConstraintMatrix( const SparseUnsortedArrays *A )
+{
+    makeMatrixUnique();
+
+    for ( unsigned column = 0; column < _n; ++column )
+        _matrix->_sparseColumnsOfA[column]->clear();
 
     for ( unsigned row = 0; row < _m; ++row )
-        _sparseRowsOfA[row]->initialize( A + ( row * _n ), _n );
+    {
+        _matrix->_sparseRowsOfA[row]->clear();
+
+        const SparseUnsortedArray *sparseRow = A->getRow( row );
+        for ( unsigned i = 0; i < sparseRow->getNnz(); ++i )
+        {
+            SparseUnsortedArray::Entry entry = sparseRow->getByArrayIndex( i );
+            _matrix->_sparseRowsOfA[row]->append( entry._index, entry._value );
+            _matrix->_sparseColumnsOfA[entry._index]->append( row, entry._value );
+        }
+    }
+
+    _matrix->_A->initialize( (const SparseUnsortedList **)_matrix->_sparseRowsOfA, _m, _n );
+}
+
+void Tableau::makeMatrixUnique()
+{
+    if ( _matrix.use_count() == 1 )
+        return;
+
+    std::shared_ptr<TableauMatrix> copy = std::make_shared<TableauMatrix>();
+    _matrix->storeIntoOther( copy.get() );
+    _matrix = copy;
+
+    if ( _statistics )
+        _statistics->incNumTableauMatrixCopies();
 }
 
 void Tableau::markAsBasic( unsigned variable )
@@ -407,7 +447,7 @@ void Tableau::computeAssignment()
         unsigned var = _nonBasicIndexToVariable[i];
         double value = _nonBasicAssignment[i];
 
-        for ( const auto &entry : *_sparseColumnsOfA[var] )
+        for ( const auto &entry : *_matrix->_sparseColumnsOfA[var] )
             _workM[entry._index] -= entry._value * value;
     }
 
@@ -470,7 +510,11 @@ void Tableau::computeBasicStatus( unsigned basicIndex )
 void Tableau::setLowerBound( unsigned variable, double value )
 {
     ASSERT( variable < _n );
+    if ( _boundTrailEnabled )
+        _boundTrail.append( { variable, true, _lowerBounds[variable],
+                              _lowerBoundLevels[variable], _boundsValid } );
     _lowerBounds[variable] = value;
+    _lowerBoundLevels[variable] = _decisionLevel;
     notifyLowerBound( variable, value );
     checkBoundsValid( variable );
 }
@@ -478,7 +522,11 @@ void Tableau::setLowerBound( unsigned variable, double value )
 void Tableau::setUpperBound( unsigned variable, double value )
 {
     ASSERT( variable < _n );
+    if ( _boundTrailEnabled )
+        _boundTrail.append( { variable, false, _upperBounds[variable],
+                              _upperBoundLevels[variable], _boundsValid } );
     _upperBounds[variable] = value;
+    _upperBoundLevels[variable] = _decisionLevel;
     notifyUpperBound( variable, value );
     checkBoundsValid( variable );
 }
@@ -714,6 +762,7 @@ bool Tableau::performingFakePivot() const
 
 void Tableau::performPivot()
 {
+    PROFILE_SCOPE( "Tableau::performPivot" );
 
     bool decrease;
     unsigned  nonBasic;
@@ -858,6 +907,165 @@ void Tableau::performDegeneratePivot()
     }
 }
 
+void Tableau::resetDualSteepestEdgeWeights()
+{
+    /*
+      The exact weights are the squared norms of the rows of inv(B).
+      Computing them requires m backward transformations, so instead
+      we start every dual simplex phase from the reference framework
+      of unit weights (which is exact for the initial, all-auxiliary
+      basis), and update the weights from there.
+    */
+    std::fill_n( _dualSteepestEdgeWeights, _m, 1.0 );
+}
+
+bool Tableau::pickDualLeavingVariable()
+{
+    /*
+      Dual steepest-edge pricing: among the out-of-bounds basic
+      variables, pick the one maximizing infeasibility^2 / weight.
+    */
+    _leavingVariable = _m;
+    double bestScore = 0;
+
+    for ( unsigned i = 0; i < _m; ++i )
+    {
+        double infeasibility;
+        if ( _basicStatus[i] == Tableau::BELOW_LB )
+            infeasibility = _lowerBounds[_basicIndexToVariable[i]] - _basicAssignment[i];
+        else if ( _basicStatus[i] == Tableau::ABOVE_UB )
+            infeasibility = _basicAssignment[i] - _upperBounds[_basicIndexToVariable[i]];
+        else
+            continue;
+
+        double score = ( infeasibility * infeasibility ) / _dualSteepestEdgeWeights[i];
+        if ( score > bestScore )
+        {
+            bestScore = score;
+            _leavingVariable = i;
+        }
+    }
+
+    if ( _leavingVariable == _m )
+        return false;
+
+    // The leaving variable moves towards its violated bound
+    _leavingVariableIncreases = ( _basicStatus[_leavingVariable] == Tableau::BELOW_LB );
+    return true;
+}
+
+bool Tableau::dualRatioTest()
+{
+    /*
+      Requires the pivot row of the leaving variable to have been
+      computed. The row reads:
+
+          leaving = sum( coefficient_j * nonBasic_j ) + scalar
+
+      and a non-basic variable is eligible for entry if it can move
+      (within its bounds) in a direction that moves the leaving
+      variable towards its violated bound.
+
+      As the tableau has no objective, all reduced costs are zero and
+      all dual ratios are tied. We break the tie Harris-style: prefer
+      candidates that can absorb the entire required change while
+      staying within their own bounds, and among those pick the largest
+      pivot element.
+    */
+    ASSERT( _leavingVariable < _m );
+
+    unsigned leaving = _basicIndexToVariable[_leavingVariable];
+    double basicDelta = _leavingVariableIncreases ?
+        _lowerBounds[leaving] - _basicAssignment[_leavingVariable] :
+        _upperBounds[leaving] - _basicAssignment[_leavingVariable];
+
+    unsigned bestWithinBounds = _n - _m;
+    double bestWithinBoundsPivot = 0;
+    unsigned best = _n - _m;
+    double bestPivot = 0;
+
+    for ( unsigned i = 0; i < _n - _m; ++i )
+    {
+        double coefficient = _pivotRow->_row[i]._coefficient;
+        double absCoefficient = FloatUtils::abs( coefficient );
+        if ( absCoefficient < GlobalConfiguration::PIVOT_CHANGE_COLUMN_TOLERANCE )
+            continue;
+
+        bool nonBasicIncreases = ( coefficient > 0 ) == _leavingVariableIncreases;
+        if ( nonBasicIncreases ? !nonBasicCanIncrease( i ) : !nonBasicCanDecrease( i ) )
+            continue;
+
+        if ( absCoefficient > bestPivot )
+        {
+            best = i;
+            bestPivot = absCoefficient;
+        }
+
+        unsigned nonBasic = _nonBasicIndexToVariable[i];
+        double nonBasicDelta = basicDelta / coefficient;
+        double room = nonBasicIncreases ?
+            _upperBounds[nonBasic] - _nonBasicAssignment[i] :
+            _nonBasicAssignment[i] - _lowerBounds[nonBasic];
+
+        if ( FloatUtils::abs( nonBasicDelta ) <= room && absCoefficient > bestWithinBoundsPivot )
+        {
+            bestWithinBounds = i;
+            bestWithinBoundsPivot = absCoefficient;
+        }
+    }
+
+    if ( bestWithinBoundsPivot >= GlobalConfiguration::ACCEPTABLE_SIMPLEX_PIVOT_THRESHOLD )
+        best = bestWithinBounds;
+    else if ( bestPivot < GlobalConfiguration::ACCEPTABLE_SIMPLEX_PIVOT_THRESHOLD )
+        return false;
+
+    _enteringVariable = best;
+    _changeRatio = basicDelta / _pivotRow->_row[best]._coefficient;
+    return true;
+}
+
+void Tableau::updateDualSteepestEdgeWeights()
+{
+    /*
+      Requires the pivot row (and hence the multipliers, which hold row
+      r of inv(B)) and the change column d to have been computed. After
+      the pivot, row i of the new inv(B) is row_i - ( d_i / d_r ) * row_r,
+      and row r becomes row_r / d_r. So, with tau = inv(B) * row_r:
+
+          w_i <- w_i - 2 ( d_i / d_r ) tau_i + ( d_i / d_r )^2 w_r
+          w_r <- w_r / d_r^2
+
+      where w_r is computed exactly from the multipliers.
+    */
+    ASSERT( _leavingVariable < _m );
+
+    double pivotElement = _changeColumn[_leavingVariable];
+    ASSERT( !FloatUtils::isZero( pivotElement ) );
+
+    double leavingWeight = 0;
+    for ( unsigned i = 0; i < _m; ++i )
+        leavingWeight += _multipliers[i] * _multipliers[i];
+
+    _basisFactorization->forwardTransformation( _multipliers, _dualSteepestEdgeWork );
+
+    for ( unsigned i = 0; i < _m; ++i )
+    {
+        if ( i == _leavingVariable || FloatUtils::isZero( _changeColumn[i] ) )
+            continue;
+
+        double ratio = _changeColumn[i] / pivotElement;
+        double weight = _dualSteepestEdgeWeights[i] -
+            2 * ratio * _dualSteepestEdgeWork[i] +
+            ratio * ratio * leavingWeight;
+
+        _dualSteepestEdgeWeights[i] = FloatUtils::max( weight, GlobalConfiguration::DUAL_STEEPEST_EDGE_MIN_WEIGHT );
+    }
+
+    _dualSteepestEdgeWeights[_leavingVariable] =
+        FloatUtils::max( leavingWeight / ( pivotElement * pivotElement ),
+                         GlobalConfiguration::DUAL_STEEPEST_EDGE_MIN_WEIGHT );
+}
+
 double Tableau::ratioConstraintPerBasic( unsigned basicIndex, double coefficient, bool decrease )
 {
     unsigned basic = _basicIndexToVariable[basicIndex];
@@ -1387,8 +1595,10 @@ void Tableau::setChangeRatio( double changeRatio )
 
 void Tableau::computeChangeColumn()
 {
-    // Compute d = inv(B) * a using the basis factorization
-    const double *a = getAColumn( _nonBasicIndexToVariable[_enteringVariable] );
+    // Compute d = inv(B) * a using the basis factorization. The column
+    // of A is usually very sparse, so use the sparse transformation
+    const SparseUnsortedList *a =
+        _matrix->_sparseColumnsOfA[_nonBasicIndexToVariable[_enteringVariable]];
     _basisFactorization->forwardTransformation( a, _changeColumn );
 }
 
@@ -1484,7 +1694,7 @@ void Tableau::dump() const
     {
         for ( unsigned j = 0; j < _n; ++j )
         {
-            printf( "%5.1lf ", _A->get( i, j ) );
+            printf( "%5.1lf ", _matrix->_A->get( i, j ) );
         }
         printf( "\n" );
     }
@@ -1510,16 +1720,16 @@ void Tableau::getTableauRow( unsigned index, TableauRow *row )
 
     ASSERT( index < _m );
 
-    std::fill( _unitVector, _unitVector + _m, 0.0 );
-    _unitVector[index] = 1;
-    computeMultipliers( _unitVector );
+    _unitVector.clear();
+    _unitVector.append( index, 1 );
+    _basisFactorization->backwardTransformation( &_unitVector, _multipliers );
 
     for ( unsigned i = 0; i < _n - _m; ++i )
     {
         row->_row[i]._var = _nonBasicIndexToVariable[i];
         row->_row[i]._coefficient = 0;
 
-        SparseUnsortedList *column = _sparseColumnsOfA[_nonBasicIndexToVariable[i]];
+        SparseUnsortedList *column = _matrix->_sparseColumnsOfA[_nonBasicIndexToVariable[i]];
 
         for ( const auto &entry : *column )
             row->_row[i]._coefficient -= ( _multipliers[entry._index] * entry._value );
@@ -1543,32 +1753,33 @@ void Tableau::getTableauRow( unsigned index, TableauRow *row )
 
 const SparseMatrix *Tableau::getSparseA() const
 {
-    return _A;
+    return _matrix->_A;
 }
 
 const double *Tableau::getAColumn( unsigned variable ) const
 {
-    return _denseA + ( variable * _m );
+    _matrix->_sparseColumnsOfA[variable]->toDense( _denseAColumn );
+    return _denseAColumn;
 }
 
 void Tableau::getSparseAColumn( unsigned variable, SparseUnsortedList *result ) const
 {
-    _sparseColumnsOfA[variable]->storeIntoOther( result );
+    _matrix->_sparseColumnsOfA[variable]->storeIntoOther( result );
 }
 
 const SparseUnsortedList *Tableau::getSparseAColumn( unsigned variable ) const
 {
-    return _sparseColumnsOfA[variable];
+    return _matrix->_sparseColumnsOfA[variable];
 }
 
 const SparseUnsortedList *Tableau::getSparseARow( unsigned row ) const
 {
-    return _sparseRowsOfA[row];
+    return _matrix->_sparseRowsOfA[row];
 }
 
 void Tableau::getSparseARow( unsigned row, SparseUnsortedList *result ) const
 {
-    _sparseRowsOfA[row]->storeIntoOther( result );
+    _matrix->_sparseRowsOfA[row]->storeIntoOther( result );
 }
 
 void Tableau::dumpEquations()
@@ -1590,13 +1801,8 @@ void Tableau::storeState( TableauState &state ) const
     // Set the dimensions
     state.setDimensions( _m, _n, *this );
 
-    // Store matrix A
-    _A->storeIntoOther( state._A );
-    for ( unsigned i = 0; i < _n; ++i )
-        _sparseColumnsOfA[i]->storeIntoOther( state._sparseColumnsOfA[i] );
-    for ( unsigned i = 0; i < _m; ++i )
-        _sparseRowsOfA[i]->storeIntoOther( state._sparseRowsOfA[i] );
-    memcpy( state._denseA, _denseA, sizeof(double) * _m * _n );
+    // Share matrix A, which is copied before it is next changed
+    state._matrix = _matrix;
 
     // Store right hand side vector _b
     memcpy( state._b, _b, sizeof(double) * _m );
@@ -1631,15 +1837,10 @@ void Tableau::storeState( TableauState &state ) const
 void Tableau::restoreState( const TableauState &state )
 {
     freeMemoryIfNeeded();
-    setDimensions( state._m, state._n );
 
-    // Restore matrix A
-    state._A->storeIntoOther( _A );
-    for ( unsigned i = 0; i < _n; ++i )
-        state._sparseColumnsOfA[i]->storeIntoOther( _sparseColumnsOfA[i] );
-    for ( unsigned i = 0; i < _m; ++i )
-        state._sparseRowsOfA[i]->storeIntoOther( _sparseRowsOfA[i] );
-    memcpy( _denseA, state._denseA, sizeof(double) * _m * _n );
+    // Restore matrix A, by sharing it with the state
+    _matrix = state._matrix;
+    allocateMemory( state._m, state._n );
 
     // Restore right hand side vector _b
     memcpy( _b, state._b, sizeof(double) * _m );
@@ -1705,6 +1906,115 @@ bool Tableau::allBoundsValid() const
     return _boundsValid;
 }
 
+void Tableau::setBoundTrailEnabled( bool enabled )
+{
+    _boundTrailEnabled = enabled;
+}
+
+bool Tableau::boundTrailEnabled() const
+{
+    return _boundTrailEnabled;
+}
+
+unsigned Tableau::getBoundTrailSize() const
+{
+    return _boundTrail.size();
+}
+
+void Tableau::undoBoundTrail( unsigned position )
+{
+    ASSERT( position <= _boundTrail.size() );
+
+    bool basicStatusChanged = false;
+    Set<unsigned> nonBasicVariables;
+    while ( _boundTrail.size() > position )
+    {
+        BoundTrailEntry entry = _boundTrail.pop();
+        unsigned variable = entry._variable;
+
+        if ( entry._isLowerBound )
+        {
+            _lowerBounds[variable] = entry._previousValue;
+            _lowerBoundLevels[variable] = entry._previousLevel;
+        }
+        else
+        {
+            _upperBounds[variable] = entry._previousValue;
+            _upperBoundLevels[variable] = entry._previousLevel;
+        }
+
+        _boundsValid = entry._previousBoundsValid;
+
+        if ( _basicVariables.exists( variable ) )
+        {
+            unsigned index = _variableToIndex[variable];
+            unsigned oldStatus = _basicStatus[index];
+            computeBasicStatus( index );
+            if ( _basicStatus[index] != oldStatus )
+                basicStatusChanged = true;
+        }
+        else
+        {
+            nonBasicVariables.insert( variable );
+        }
+    }
+
+    // A non-basic variable usually remains within its (looser) bounds.
+    // However, if the bounds became invalid, it may have been moved
+    // past the bound that is now restored.
+    for ( unsigned variable : nonBasicVariables )
+    {
+        double value = _nonBasicAssignment[_variableToIndex[variable]];
+        if ( FloatUtils::lt( value, _lowerBounds[variable] ) )
+            setNonBasicAssignment( variable, _lowerBounds[variable], true );
+        else if ( FloatUtils::gt( value, _upperBounds[variable] ) )
+            setNonBasicAssignment( variable, _upperBounds[variable], true );
+    }
+
+    if ( basicStatusChanged )
+        _costFunctionManager->invalidateCostFunction();
+}
+
+void Tableau::clearBoundTrail()
+{
+    _boundTrail.clear();
+}
+
+void Tableau::setDecisionLevel( unsigned level )
+{
+    // When backtracking, bounds set at deeper levels that were not
+    // rolled back (e.g., after a full state restoration) can only
+    // depend on the decisions that remain
+    if ( level < _decisionLevel )
+    {
+        for ( unsigned i = 0; i < _n; ++i )
+        {
+            if ( _lowerBoundLevels[i] > level )
+                _lowerBoundLevels[i] = level;
+            if ( _upperBoundLevels[i] > level )
+                _upperBoundLevels[i] = level;
+        }
+    }
+
+    _decisionLevel = level;
+}
+
+unsigned Tableau::getDecisionLevel() const
+{
+    return _decisionLevel;
+}
+
+unsigned Tableau::getLowerBoundLevel( unsigned variable ) const
+{
+    ASSERT( variable < _n );
+    return _lowerBoundLevels[variable];
+}
+
+unsigned Tableau::getUpperBoundLevel( unsigned variable ) const
+{
+    ASSERT( variable < _n );
+    return _upperBoundLevels[variable];
+}
 
 void Tableau::updateVariableToComplyWithLowerBoundUpdate( unsigned variable, double value )
 {
@@ -1774,6 +2084,76 @@ void Tableau::tightenUpperBound( unsigned variable, double value )
     updateVariableToComplyWithUpperBoundUpdate( variable, value );
 }
 
+unsigned Tableau::applyTightenings( const List<Tightening> &tightenings )
+{
+    unsigned numTightenedBounds = 0;
+
+    for ( const auto &tightening : tightenings )
+    {
+        unsigned variable = tightening._variable;
+        double value = tightening._value;
+        ASSERT( variable < _n );
+
+        if ( tightening._type == Tightening::LB )
+        {
+            if ( !FloatUtils::gt( value, _lowerBounds[variable] ) )
+                continue;
+
+            if ( _boundTrailEnabled )
+                _boundTrail.append( { variable, true, _lowerBounds[variable],
+                                      _lowerBoundLevels[variable], _boundsValid } );
+            _lowerBounds[variable] = value;
+            _lowerBoundLevels[variable] = _decisionLevel;
+
+            if ( !_boundChanged[variable] )
+                _changedVariables.append( variable );
+            _boundChanged[variable] |= BoundUpdates::LOWER;
+
+            checkBoundsValid( variable );
+        }
+        else
+        {
+            if ( !FloatUtils::lt( value, _upperBounds[variable] ) )
+                continue;
+
+            if ( _boundTrailEnabled )
+                _boundTrail.append( { variable, false, _upperBounds[variable],
+                                      _upperBoundLevels[variable], _boundsValid } );
+            _upperBounds[variable] = value;
+            _upperBoundLevels[variable] = _decisionLevel;
+
+            if ( !_boundChanged[variable] )
+                _changedVariables.append( variable );
+            _boundChanged[variable] |= BoundUpdates::UPPER;
+
+            checkBoundsValid( variable );
+        }
+
+        if ( _statistics )
+            _statistics->incNumTightenedBounds();
+        ++numTightenedBounds;
+    }
+
+    // The watchers only see the final bounds of each variable. As with
+    // single bound updates, they are notified before the variables are
+    // updated to comply with the new bounds.
+    notifyBoundUpdates();
+
+    for ( const auto &variable : _changedVariables )
+    {
+        if ( _boundChanged[variable] & BoundUpdates::LOWER )
+            updateVariableToComplyWithLowerBoundUpdate( variable, _lowerBounds[variable] );
+        if ( _boundChanged[variable] & BoundUpdates::UPPER )
+            updateVariableToComplyWithUpperBoundUpdate( variable, _upperBounds[variable] );
+
+        _boundChanged[variable] = 0;
+    }
+
+    _changedVariables.clear();
+
+    return numTightenedBounds;
+}
+
 unsigned Tableau::addEquation( const Equation &equation )
 {
     // The fresh auxiliary variable assigned to the equation is _n.
@@ -1785,21 +2165,19 @@ unsigned Tableau::addEquation( const Equation &equation )
     addRow();
 
     // Adjust the constraint matrix
-    _A->addEmptyColumn();
+    _matrix->_A->addEmptyColumn();
     std::fill_n( _workN, _n, 0.0 );
     for ( const auto &addend : equation._addends )
     {
         _workN[addend._variable] = addend._coefficient;
-        _sparseColumnsOfA[addend._variable]->set( _m - 1, addend._coefficient );
-        _sparseRowsOfA[_m - 1]->set( addend._variable, addend._coefficient );
-        _denseA[(addend._variable * _m) + _m - 1] = addend._coefficient;
+        _matrix->_sparseColumnsOfA[addend._variable]->set( _m - 1, addend._coefficient );
+        _matrix->_sparseRowsOfA[_m - 1]->set( addend._variable, addend._coefficient );
     }
 
     _workN[auxVariable] = 1;
-    _sparseColumnsOfA[auxVariable]->set( _m - 1, 1 );
-    _sparseRowsOfA[_m - 1]->set( auxVariable, 1 );
-    _denseA[(auxVariable * _m) + _m - 1] = 1;
-    _A->addLastRow( _workN );
+    _matrix->_sparseColumnsOfA[auxVariable]->set( _m - 1, 1 );
+    _matrix->_sparseRowsOfA[_m - 1]->set( auxVariable, 1 );
+    _matrix->_A->addLastRow( _workN );
 
     // Invalidate the cost function, so that it is recomputed in the next iteration.
     _costFunctionManager->invalidateCostFunction();
@@ -1877,7 +2255,7 @@ unsigned Tableau::addEquation( const Equation &equation )
     else
     {
         ConstraintMatrixAnalyzer analyzer;
-        analyzer.analyze( (const SparseUnsortedList **)_sparseRowsOfA, _m, _n );
+        analyzer.analyze( (const SparseUnsortedList **)_matrix->_sparseRowsOfA, _m, _n );
         List<unsigned> independentColumns = analyzer.getIndependentColumns();
 
         try
@@ -1908,6 +2286,9 @@ void Tableau::addRow()
       that are of size _n - _m are left as is.
     */
 
+    // Stored states that share matrix A keep the old one
+    makeMatrixUnique();
+
     // Allocate a larger _sparseColumnsOfA, keep old ones
     SparseUnsortedList **newSparseColumnsOfA = new SparseUnsortedList *[newN];
     if ( !newSparseColumnsOfA )
@@ -1915,7 +2296,7 @@ void Tableau::addRow()
 
     for ( unsigned i = 0; i < _n; ++i )
     {
-        newSparseColumnsOfA[i] = _sparseColumnsOfA[i];
+        newSparseColumnsOfA[i] = _matrix->_sparseColumnsOfA[i];
         newSparseColumnsOfA[i]->incrementSize();
     }
 
@@ -1923,8 +2304,8 @@ void Tableau::addRow()
     if ( !newSparseColumnsOfA[newN - 1] )
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newSparseColumnsOfA[newN-1]" );
 
-    delete[] _sparseColumnsOfA;
-    _sparseColumnsOfA = newSparseColumnsOfA;
+    delete[] _matrix->_sparseColumnsOfA;
+    _matrix->_sparseColumnsOfA = newSparseColumnsOfA;
 
     // Allocate a larger _sparseRowsOfA, keep old ones
     SparseUnsortedList **newSparseRowsOfA = new SparseUnsortedList *[newM];
@@ -1933,7 +2314,7 @@ void Tableau::addRow()
 
     for ( unsigned i = 0; i < _m; ++i )
     {
-        newSparseRowsOfA[i] = _sparseRowsOfA[i];
+        newSparseRowsOfA[i] = _matrix->_sparseRowsOfA[i];
         newSparseRowsOfA[i]->incrementSize();
     }
 
@@ -1941,23 +2322,15 @@ void Tableau::addRow()
     if ( !newSparseRowsOfA[newM - 1] )
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newSparseRowsOfA[newN-1]" );
 
-    delete[] _sparseRowsOfA;
-    _sparseRowsOfA = newSparseRowsOfA;
+    delete[] _matrix->_sparseRowsOfA;
+    _matrix->_sparseRowsOfA = newSparseRowsOfA;
 
-    // Allocate a larger _denseA, keep old entries
-    double *newDenseA = new double[newM * newN];
-    if ( !newDenseA )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newDenseA" );
-
-    for ( unsigned column = 0; column < _n; ++column )
-    {
-        memcpy( newDenseA + ( column * newM ), _denseA + ( column * _m ), sizeof(double) * _m );
-        newDenseA[column*newM + newM - 1] = 0.0;
-    }
-    std::fill_n( newDenseA + ( newN - 1 ) * newM, newM, 0.0 );
-
-    delete[] _denseA;
-    _denseA = newDenseA;
+    // Allocate a new dense column of A. Don't need to initialize
+    double *newDenseAColumn = new double[newM];
+    if ( !newDenseAColumn )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newDenseAColumn" );
+    delete[] _denseAColumn;
+    _denseAColumn = newDenseAColumn;
 
     // Allocate a new changeColumn. Don't need to initialize
     double *newChangeColumn = new double[newM];
@@ -1975,12 +2348,21 @@ void Tableau::addRow()
     delete[] _b;
     _b = newB;
 
-    // Allocate a new unit vector. Don't need to initialize
-    double *newUnitVector = new double[newM];
-    if ( !newUnitVector )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newUnitVector" );
-    delete[] _unitVector;
-    _unitVector = newUnitVector;
+    // Allocate new dual steepest-edge weights. The new row's weight is
+    // that of a unit row of inv(B), the others are kept
+    double *newDualSteepestEdgeWeights = new double[newM];
+    if ( !newDualSteepestEdgeWeights )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newDualSteepestEdgeWeights" );
+    memcpy( newDualSteepestEdgeWeights, _dualSteepestEdgeWeights, _m * sizeof(double) );
+    newDualSteepestEdgeWeights[_m] = 1.0;
+    delete[] _dualSteepestEdgeWeights;
+    _dualSteepestEdgeWeights = newDualSteepestEdgeWeights;
+
+    double *newDualSteepestEdgeWork = new double[newM];
+    if ( !newDualSteepestEdgeWork )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newDualSteepestEdgeWork" );
+    delete[] _dualSteepestEdgeWork;
+    _dualSteepestEdgeWork = newDualSteepestEdgeWork;
 
     // Allocate new multipliers. Don't need to initialize
     double *newMultipliers = new double[newM];
@@ -2038,6 +2420,30 @@ void Tableau::addRow()
     _lowerBounds[_n] = FloatUtils::negativeInfinity();
     _upperBounds[_n] = FloatUtils::infinity();
 
+    char *newBoundChanged = new char[newN];
+    if ( !newBoundChanged )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newBoundChanged" );
+    memcpy( newBoundChanged, _boundChanged, _n * sizeof(char) );
+    newBoundChanged[_n] = 0;
+    delete[] _boundChanged;
+    _boundChanged = newBoundChanged;
+
+    unsigned *newLowerBoundLevels = new unsigned[newN];
+    if ( !newLowerBoundLevels )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newLowerBoundLevels" );
+    memcpy( newLowerBoundLevels, _lowerBoundLevels, _n * sizeof(unsigned) );
+    newLowerBoundLevels[_n] = _decisionLevel;
+    delete[] _lowerBoundLevels;
+    _lowerBoundLevels = newLowerBoundLevels;
+
+    unsigned *newUpperBoundLevels = new unsigned[newN];
+    if ( !newUpperBoundLevels )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newUpperBoundLevels" );
+    memcpy( newUpperBoundLevels, _upperBoundLevels, _n * sizeof(unsigned) );
+    newUpperBoundLevels[_n] = _decisionLevel;
+    delete[] _upperBoundLevels;
+    _upperBoundLevels = newUpperBoundLevels;
+
     // Allocate a larger basis factorization
     IBasisFactorization *newBasisFactorization =
         BasisFactorizationFactory::createBasisFactorization( newM, *this );
@@ -2060,6 +2466,8 @@ void Tableau::addRow()
     delete[] _workN;
     _workN = newWorkN;
 
+    _matrix->_m = newM;
+    _matrix->_n = newN;
     _m = newM;
     _n = newN;
     _costFunctionManager->initialize();
@@ -2076,12 +2484,16 @@ void Tableau::addRow()
 
 void Tableau::registerToWatchVariable( VariableWatcher *watcher, unsigned variable )
 {
+    while ( _variableToWatchers.size() <= variable )
+        _variableToWatchers.append( VariableWatchers() );
+
     _variableToWatchers[variable].append( watcher );
 }
 
 void Tableau::unregisterToWatchVariable( VariableWatcher *watcher, unsigned variable )
 {
-    _variableToWatchers[variable].erase( watcher );
+    if ( variable < _variableToWatchers.size() )
+        _variableToWatchers[variable].erase( watcher );
 }
 
 void Tableau::registerToWatchAllVariables( VariableWatcher *watcher )
@@ -2099,7 +2511,7 @@ void Tableau::notifyVariableValue( unsigned variable, double value )
     for ( auto &watcher : _globalWatchers )
         watcher->notifyVariableValue( variable, value );
 
-    if ( _variableToWatchers.exists( variable ) )
+    if ( variable < _variableToWatchers.size() )
     {
         for ( auto &watcher : _variableToWatchers[variable] )
             watcher->notifyVariableValue( variable, value );
@@ -2111,7 +2523,7 @@ void Tableau::notifyLowerBound( unsigned variable, double bound )
     for ( auto &watcher : _globalWatchers )
         watcher->notifyLowerBound( variable, bound );
 
-    if ( _variableToWatchers.exists( variable ) )
+    if ( variable < _variableToWatchers.size() )
     {
         for ( auto &watcher : _variableToWatchers[variable] )
             watcher->notifyLowerBound( variable, bound );
@@ -2123,13 +2535,37 @@ void Tableau::notifyUpperBound( unsigned variable, double bound )
     for ( auto &watcher : _globalWatchers )
         watcher->notifyUpperBound( variable, bound );
 
-    if ( _variableToWatchers.exists( variable ) )
+    if ( variable < _variableToWatchers.size() )
     {
         for ( auto &watcher : _variableToWatchers[variable] )
             watcher->notifyUpperBound( variable, bound );
     }
 }
 
+void Tableau::notifyBoundUpdates()
+{
+    if ( _changedVariables.empty() )
+        return;
+
+    BoundUpdates updates = { _changedVariables, _boundChanged, _lowerBounds, _upperBounds };
+    for ( auto &watcher : _globalWatchers )
+        watcher->notifyBounds( updates );
+
+    for ( const auto &variable : _changedVariables )
+    {
+        if ( variable < _variableToWatchers.size() )
+        {
+            for ( auto &watcher : _variableToWatchers[variable] )
+            {
+                if ( _boundChanged[variable] & BoundUpdates::LOWER )
+                    watcher->notifyLowerBound( variable, _lowerBounds[variable] );
+                if ( _boundChanged[variable] & BoundUpdates::UPPER )
+                    watcher->notifyUpperBound( variable, _upperBounds[variable] );
+            }
+        }
+    }
+}
+
 const double *Tableau::getRightHandSide() const
 {
     return _b;
@@ -2394,8 +2830,9 @@ void Tableau::updateAssignmentForPivot()
 
 void Tableau::updateCostFunctionForPivot()
 {
-    // If the pivot is fake, the cost function does not change
-    if ( performingFakePivot() )
+    // If the pivot is fake, the cost function does not change. If the
+    // cost function is invalid, it will be recomputed from scratch.
+    if ( performingFakePivot() || _costFunctionManager->costFunctionInvalid() )
         return;
 
     double pivotElement = -_changeColumn[_leavingVariable];
@@ -2458,13 +2895,13 @@ void Tableau::getColumnOfBasis( unsigned column, double *result ) const
     ASSERT( column < _m );
     ASSERT( !_mergedVariables.exists( _basicIndexToVariable[column] ) );
 
-    _sparseColumnsOfA[_basicIndexToVariable[column]]->toDense( result );
+    _matrix->_sparseColumnsOfA[_basicIndexToVariable[column]]->toDense( result );
 }
 
 void Tableau::getSparseBasis( SparseColumnsOfBasis &basis ) const
 {
     for ( unsigned i = 0; i < _m; ++i )
-        basis._columns[i] = _sparseColumnsOfA[_basicIndexToVariable[i]];
+        basis._columns[i] = _matrix->_sparseColumnsOfA[_basicIndexToVariable[i]];
 }
 
 void Tableau::getColumnOfBasis( unsigned column, SparseUnsortedList *result ) const
@@ -2472,7 +2909,7 @@ void Tableau::getColumnOfBasis( unsigned column, SparseUnsortedList *result ) co
     ASSERT( column < _m );
     ASSERT( !_mergedVariables.exists( _basicIndexToVariable[column] ) );
 
-    _sparseColumnsOfA[_basicIndexToVariable[column]]->storeIntoOther( result );
+    _matrix->_sparseColumnsOfA[_basicIndexToVariable[column]]->storeIntoOther( result );
 }
 
 void Tableau::refreshBasisFactorization()
@@ -2508,20 +2945,16 @@ void Tableau::mergeColumns( unsigned x1, unsigned x2 )
       Merge column x2 of the constraint matrix into x1
       and zero-out column x2
     */
-    _A->mergeColumns( x1, x2 );
+    makeMatrixUnique();
+    _matrix->_A->mergeColumns( x1, x2 );
     _mergedVariables[x2] = x1;
 
     // Adjust sparse columns and rows, also
-    _sparseColumnsOfA[x2]->clear();
-    _A->getColumn( x1, _sparseColumnsOfA[x1] );
-
-    for ( unsigned i = 0; i < _m; ++i )
-        _sparseRowsOfA[i]->mergeEntries( x2, x1 );
+    _matrix->_sparseColumnsOfA[x2]->clear();
+    _matrix->_A->getColumn( x1, _matrix->_sparseColumnsOfA[x1] );
 
-    // And the dense ones, too
     for ( unsigned i = 0; i < _m; ++i )
-        _denseA[x1*_m + i] += _denseA[x2*_m + i];
-    std::fill_n( _denseA + x2 * _m, _m, 0 );
+        _matrix->_sparseRowsOfA[i]->mergeEntries( x2, x1 );
 
     computeAssignment();
     computeCostFunction();
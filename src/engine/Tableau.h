@@ -25,12 +25,16 @@
 #include "SparseMatrix.h"
 #include "SparseUnsortedList.h"
 #include "Statistics.h"
+#include "Vector.h"
+
+#include <memory>
 
 #define TABLEAU_LOG( x, ... ) LOG( GlobalConfiguration::TABLEAU_LOGGING, "Tableau: %s\n", x )
 
 class Equation;
 class ICostFunctionManager;
 class PiecewiseLinearCaseSplit;
+class TableauMatrix;
 class TableauState;
 
 class Tableau : public ITableau, public IBasisFactorization::BasisColumnOracle
@@ -47,9 +51,11 @@ public:
     void setDimensions( unsigned m, unsigned n );
 
     /*
-      Initialize the constraint matrix
+      Initialize the constraint matrix, from its dense (row-major)
+      form or from its sparse rows
     */
     void setConstraintMatrix( const double *A );
+    void setConstraintMatrix( const SparseUnsortedArrays *A );
 
     /*
       Set which variable will enter the basis. The input is the
@@ -176,6 +182,15 @@ public:
     void tightenLowerBound( unsigned variable, double value );
     void tightenUpperBound( unsigned variable, double value );
 
+    /*
+      Apply a batch of tightenings. All bounds are first updated in
+      place, and the watchers are then notified of the final bounds,
+      once per batch. Tightenings that are not tighter than the current
+      bounds are ignored. Returns the number of bounds that were
+      actually tightened.
+    */
+    unsigned applyTightenings( const List<Tightening> &tightenings );
+
     /*
       Return the current status of the basic variable
     */
@@ -245,6 +260,38 @@ public:
      */
     void performDegeneratePivot();
 
+    /*
+      The dual simplex mode. Bound changes (case splits and bound
+      tightenings) leave the current basis dual feasible, since the
+      tableau has no objective beyond feasibility. The dual simplex
+      restores primal feasibility by repeatedly:
+
+        1. Picking an out-of-bounds basic variable as the leaving
+           variable, using dual steepest-edge pricing
+           (pickDualLeavingVariable). Returns false if all basic
+           variables are within bounds.
+
+        2. Computing the pivot row, and selecting the entering variable
+           using the dual ratio test (dualRatioTest). With zero reduced
+           costs all dual ratios are tied, and the test picks the
+           eligible non-basic with the largest pivot element. Returns
+           false if no non-basic variable can move the leaving variable
+           towards its violated bound.
+
+        3. Computing the change column, updating the dual steepest-edge
+           weights (updateDualSteepestEdgeWeights) and performing the
+           pivot, which moves the leaving variable onto its violated
+           bound.
+
+      The weights are indexed by basic index, and are only meaningful
+      during a single dual simplex phase: resetDualSteepestEdgeWeights()
+      should be called when a phase begins.
+    */
+    void resetDualSteepestEdgeWeights();
+    bool pickDualLeavingVariable();
+    bool dualRatioTest();
+    void updateDualSteepestEdgeWeights();
+
     /*
       Calculate the ratio constraint for the entering variable
       imposed by a basic variable.
@@ -322,8 +369,9 @@ public:
     void getTableauRow( unsigned index, TableauRow *row );
 
     /*
-      Get the original constraint matrix A or a column thereof,
-      in dense form.
+      Get the original constraint matrix A or a column thereof.
+      The dense column returned by getAColumn() is only valid
+      until the next call.
     */
     const SparseMatrix *getSparseA() const;
     const double *getAColumn( unsigned variable ) const;
@@ -372,6 +420,12 @@ public:
     void notifyLowerBound( unsigned variable, double bound );
     void notifyUpperBound( unsigned variable, double bound );
 
+    /*
+      Notify all watchers of the bounds changed in the current batch.
+      The batch is cleared by the caller.
+    */
+    void notifyBoundUpdates();
+
     /*
       Have the Tableau start reporting statistics.
      */
@@ -453,12 +507,53 @@ public:
      */
     unsigned getVariableAfterMerging( unsigned variable ) const;
 
+    /*
+      Trail-based undo of bound changes. While the trail is enabled,
+      every change to a lower or upper bound is recorded together with
+      the previous value. undoBoundTrail() rolls back all changes
+      recorded after the given position (obtained from
+      getBoundTrailSize()), in reverse order. The basis and the
+      assignment are not rolled back: loosening the bounds keeps the
+      non-basic assignment within bounds, so only the status of the
+      affected basic variables is recomputed.
+    */
+    void setBoundTrailEnabled( bool enabled );
+    bool boundTrailEnabled() const;
+    unsigned getBoundTrailSize() const;
+    void undoBoundTrail( unsigned position );
+    void clearBoundTrail();
+
+    /*
+      Decision levels of the bounds, for conflict analysis: every bound
+      records the decision level (the depth of the SMT stack) at which
+      it was last set. A bound set at a level may depend on all the
+      decisions up to that level, but not on deeper ones. Lowering the
+      decision level caps the levels of all bounds.
+    */
+    void setDecisionLevel( unsigned level );
+    unsigned getDecisionLevel() const;
+    unsigned getLowerBoundLevel( unsigned variable ) const;
+    unsigned getUpperBoundLevel( unsigned variable ) const;
+
 private:
+    /*
+      An entry of the bound trail: the bound of a variable, before
+      it was changed.
+    */
+    struct BoundTrailEntry
+    {
+        unsigned _variable;
+        bool _isLowerBound;
+        double _previousValue;
+        unsigned _previousLevel;
+        bool _previousBoundsValid;
+    };
+
     /*
       Variable watchers
     */
     typedef List<VariableWatcher *> VariableWatchers;
-    HashMap<unsigned, VariableWatchers> _variableToWatchers;
+    Vector<VariableWatchers> _variableToWatchers;
     List<VariableWatcher *> _globalWatchers;
 
     /*
@@ -473,14 +568,12 @@ private:
     unsigned _m;
 
     /*
-      The constraint matrix A, and a collection of its
-      sparse columns. The matrix is also stored in dense
-      form (column-major).
+      The constraint matrix A, shared with the stored states
+      until it changes. A column is only made dense on demand,
+      in _denseAColumn.
     */
-    SparseMatrix *_A;
-    SparseUnsortedList **_sparseColumnsOfA;
-    SparseUnsortedList **_sparseRowsOfA;
-    double *_denseA;
+    std::shared_ptr<TableauMatrix> _matrix;
+    double *_denseAColumn;
 
     /*
       Used to compute inv(B)*a
@@ -504,9 +597,17 @@ private:
     double *_workN;
 
     /*
-      A unit vector of size m
+      A sparse unit vector, for computing rows of inv(B)
+    */
+    SparseUnsortedList _unitVector;
+
+    /*
+      The dual steepest-edge weights of the basic variables, i.e. the
+      squared norms of the rows of inv(B), and working memory for
+      updating them (both of size m)
     */
-    double *_unitVector;
+    double *_dualSteepestEdgeWeights;
+    double *_dualSteepestEdgeWork;
 
     /*
       The current factorization of the basis
@@ -549,6 +650,22 @@ private:
     double *_lowerBounds;
     double *_upperBounds;
 
+    /*
+      The bounds changed in the current batch of tightenings: a bitmap
+      of BoundUpdates flags, indexed by variable, and the list of
+      variables whose flags are set.
+    */
+    char *_boundChanged;
+    Vector<unsigned> _changedVariables;
+
+    /*
+      The decision levels at which the current bounds were set, and
+      the current decision level.
+    */
+    unsigned *_lowerBoundLevels;
+    unsigned *_upperBoundLevels;
+    unsigned _decisionLevel;
+
     /*
       Whether all variables have valid bounds (l <= u).
     */
@@ -614,9 +731,23 @@ private:
     bool _rhsIsAllZeros;
 
     /*
-      Free all allocated memory.
+      The trail of bound changes, and whether it is being recorded.
+    */
+    bool _boundTrailEnabled;
+    Vector<BoundTrailEntry> _boundTrail;
+
+    /*
+      Free all allocated memory, or allocate the memory of an m x n
+      tableau other than its constraint matrix.
     */
     void freeMemoryIfNeeded();
+    void allocateMemory( unsigned m, unsigned n );
+
+    /*
+      Copy the constraint matrix, if it is shared with stored states,
+      before it is changed.
+    */
+    void makeMatrixUnique();
 
     /*
       Resize the relevant data structures to add a new row to the tableau.
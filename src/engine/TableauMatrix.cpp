@@ -0,0 +1,127 @@
+/*********************                                                        */
+/*! \file TableauMatrix.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** Implementation of the tableau's constraint matrix: allocation of its
+ ** sparse matrix, sparse column and sparse row forms for given dimensions,
+ ** and deep copying into another matrix, which the tableau does before
+ ** changing a matrix it shares with its stored states.
+
+ **/
+
+#include "CSRMatrix.h"
+#include "MarabouError.h"
+#include "TableauMatrix.h"
+
+TableauMatrix::TableauMatrix()
+    : _m( 0 )
+    , _n( 0 )
+    , _A( NULL )
+    , _sparseColumnsOfA( NULL )
+    , _sparseRowsOfA( NULL )
+{
+}
+
+TableauMatrix::~TableauMatrix()
+{
+    freeMemoryIfNeeded();
+}
+
+void TableauMatrix::freeMemoryIfNeeded()
+{
+    if ( _A )
+    {
+        delete _A;
+        _A = NULL;
+    }
+
+    if ( _sparseColumnsOfA )
+    {
+        for ( unsigned i = 0; i < _n; ++i )
+        {
+            if ( _sparseColumnsOfA[i] )
+            {
+                delete _sparseColumnsOfA[i];
+                _sparseColumnsOfA[i] = NULL;
+            }
+        }
+
+        delete[] _sparseColumnsOfA;
+        _sparseColumnsOfA = NULL;
+    }
+
+    if ( _sparseRowsOfA )
+    {
+        for ( unsigned i = 0; i < _m; ++i )
+        {
+            if ( _sparseRowsOfA[i] )
+            {
+                delete _sparseRowsOfA[i];
+                _sparseRowsOfA[i] = NULL;
+            }
+        }
+
+        delete[] _sparseRowsOfA;
+        _sparseRowsOfA = NULL;
+    }
+}
+
+void TableauMatrix::setDimensions( unsigned m, unsigned n )
+{
+    freeMemoryIfNeeded();
+
+    _m = m;
+    _n = n;
+
+    _A = new CSRMatrix();
+    if ( !_A )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauMatrix::A" );
+
+    _sparseColumnsOfA = new SparseUnsortedList *[n];
+    if ( !_sparseColumnsOfA )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauMatrix::sparseColumnsOfA" );
+
+    for ( unsigned i = 0; i < n; ++i )
+    {
+        _sparseColumnsOfA[i] = new SparseUnsortedList( _m );
+        if ( !_sparseColumnsOfA[i] )
+            throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauMatrix::sparseColumnsOfA[i]" );
+    }
+
+    _sparseRowsOfA = new SparseUnsortedList *[m];
+    if ( !_sparseRowsOfA )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauMatrix::sparseRowsOfA" );
+
+    for ( unsigned i = 0; i < m; ++i )
+    {
+        _sparseRowsOfA[i] = new SparseUnsortedList( _n );
+        if ( !_sparseRowsOfA[i] )
+            throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauMatrix::sparseRowsOfA[i]" );
+    }
+}
+
+void TableauMatrix::storeIntoOther( TableauMatrix *other ) const
+{
+    other->setDimensions( _m, _n );
+
+    _A->storeIntoOther( other->_A );
+    for ( unsigned i = 0; i < _n; ++i )
+        _sparseColumnsOfA[i]->storeIntoOther( other->_sparseColumnsOfA[i] );
+    for ( unsigned i = 0; i < _m; ++i )
+        _sparseRowsOfA[i]->storeIntoOther( other->_sparseRowsOfA[i] );
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
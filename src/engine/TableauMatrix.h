@@ -0,0 +1,65 @@
+/*********************                                                        */
+/*! \file TableauMatrix.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** The constraint matrix A of the tableau, in its sparse matrix, sparse
+ ** column and sparse row forms. The matrix only changes when rows are
+ ** added or columns are merged, so the tableau and its stored states
+ ** share it, and the tableau copies it before changing it.
+ **/
+
+#ifndef __TableauMatrix_h__
+#define __TableauMatrix_h__
+
+#include "SparseMatrix.h"
+#include "SparseUnsortedList.h"
+
+class TableauMatrix
+{
+public:
+    TableauMatrix();
+    ~TableauMatrix();
+
+    /*
+      Allocate an empty m x n matrix
+    */
+    void setDimensions( unsigned m, unsigned n );
+
+    /*
+      Deep copy the matrix into another
+    */
+    void storeIntoOther( TableauMatrix *other ) const;
+
+    /*
+      The dimensions of the matrix
+    */
+    unsigned _m;
+    unsigned _n;
+
+    /*
+      The matrix, and a collection of its sparse columns and rows
+    */
+    SparseMatrix *_A;
+    SparseUnsortedList **_sparseColumnsOfA;
+    SparseUnsortedList **_sparseRowsOfA;
+
+private:
+    void freeMemoryIfNeeded();
+};
+
+#endif // __TableauMatrix_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -14,17 +14,11 @@
  **/
 
 #include "BasisFactorizationFactory.h"
-#include "CSRMatrix.h"
 #include "MarabouError.h"
-#include "SparseUnsortedList.h"
 #include "TableauState.h"
 
 TableauState::TableauState()
-    : _A( NULL )
-    , _sparseColumnsOfA( NULL )
-    , _sparseRowsOfA( NULL )
-    , _denseA( NULL )
-    , _b( NULL )
+    : _b( NULL )
     , _lowerBounds( NULL )
     , _upperBounds( NULL )
     , _basicAssignment( NULL )
@@ -38,47 +32,12 @@ TableauState::TableauState()
 
 TableauState::~TableauState()
 {
-    if ( _A )
-    {
-        delete _A;
-        _A = NULL;
-    }
-
-    if ( _sparseColumnsOfA )
-    {
-        for ( unsigned i = 0; i < _n; ++i )
-        {
-            if ( _sparseColumnsOfA[i] )
-            {
-                delete _sparseColumnsOfA[i];
-                _sparseColumnsOfA[i] = NULL;
-            }
-        }
-
-        delete[] _sparseColumnsOfA;
-        _sparseColumnsOfA = NULL;
-    }
-
-    if ( _sparseRowsOfA )
-    {
-        for ( unsigned i = 0; i < _m; ++i )
-        {
-            if ( _sparseRowsOfA[i] )
-            {
-                delete _sparseRowsOfA[i];
-                _sparseRowsOfA[i] = NULL;
-            }
-        }
-
-        delete[] _sparseRowsOfA;
-        _sparseRowsOfA = NULL;
-    }
+    freeMemoryIfNeeded();
+}
 
-    if ( _denseA )
-    {
-        delete[] _denseA;
-        _denseA = NULL;
-    }
+void TableauState::freeMemoryIfNeeded()
+{
+    _matrix.reset();
 
     if ( _b )
     {
@@ -137,39 +96,11 @@ TableauState::~TableauState()
 
 void TableauState::setDimensions( unsigned m, unsigned n, const IBasisFactorization::BasisColumnOracle &oracle )
 {
+    freeMemoryIfNeeded();
+
     _m = m;
     _n = n;
 
-    _A = new CSRMatrix();
-    if ( !_A )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauState::A" );
-
-    _sparseColumnsOfA = new SparseUnsortedList *[n];
-    if ( !_sparseColumnsOfA )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauState::sparseColumnsOfA" );
-
-    for ( unsigned i = 0; i < n; ++i )
-    {
-        _sparseColumnsOfA[i] = new SparseUnsortedList;
-        if ( !_sparseColumnsOfA[i] )
-            throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauState::sparseColumnsOfA[i]" );
-    }
-
-    _sparseRowsOfA = new SparseUnsortedList *[m];
-    if ( !_sparseRowsOfA )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauState::sparseRowsOfA" );
-
-    for ( unsigned i = 0; i < m; ++i )
-    {
-        _sparseRowsOfA[i] = new SparseUnsortedList;
-        if ( !_sparseRowsOfA[i] )
-            throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauState::sparseRowsOfA[i]" );
-    }
-
-    _denseA = new double[m*n];
-    if ( !_denseA )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauState::denseA" );
-
     _b = new double[m];
     if ( !_b )
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauState::b" );
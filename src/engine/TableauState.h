@@ -21,6 +21,9 @@
 #include "Map.h"
 #include "Set.h"
 #include "SparseMatrix.h"
+#include "TableauMatrix.h"
+
+#include <memory>
 
 class TableauState
 {
@@ -43,6 +46,11 @@ public:
 
     void setDimensions( unsigned m, unsigned n, const IBasisFactorization::BasisColumnOracle &oracle );
 
+    /*
+      Free the stored elements, so that the state may be set again.
+    */
+    void freeMemoryIfNeeded();
+
     /*
       The dimensions of matrix A
     */
@@ -50,12 +58,9 @@ public:
     unsigned _n;
 
     /*
-      The matrix
+      The matrix, shared with the tableau and other states
     */
-    SparseMatrix *_A;
-    SparseUnsortedList **_sparseColumnsOfA;
-    SparseUnsortedList **_sparseRowsOfA;
-    double *_denseA;
+    std::shared_ptr<TableauMatrix> _matrix;
 
     /*
       The right hand side
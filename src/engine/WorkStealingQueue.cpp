@@ -0,0 +1,153 @@
+/*********************                                                        */
+/*! \file WorkStealingQueue.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** Implementation of the per-worker deques. A worker pops from the back of
+ ** its own deque, and falls back to stealing from the front of the deque
+ ** whose oldest subquery is the shallowest. A shared atomic counter of the
+ ** pending subqueries lets thieves stop looking once all deques are empty.
+
+**/
+
+#include "Debug.h"
+#include "MarabouError.h"
+#include "WorkStealingQueue.h"
+
+WorkStealingQueue::WorkStealingQueue( unsigned numberOfWorkers )
+    : _numberOfWorkers( numberOfWorkers )
+    , _deques( NULL )
+    , _size( 0 )
+{
+    ASSERT( _numberOfWorkers > 0 );
+
+    _deques = new WorkerDeque[_numberOfWorkers];
+    if ( !_deques )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "WorkStealingQueue::deques" );
+}
+
+WorkStealingQueue::~WorkStealingQueue()
+{
+    if ( _deques )
+    {
+        for ( unsigned i = 0; i < _numberOfWorkers; ++i )
+        {
+            for ( auto &subQuery : _deques[i]._subQueries )
+                delete subQuery;
+            _deques[i]._subQueries.clear();
+        }
+
+        delete[] _deques;
+        _deques = NULL;
+    }
+}
+
+bool WorkStealingQueue::push( unsigned workerId, SubQuery *subQuery )
+{
+    if ( workerId >= _numberOfWorkers || !subQuery )
+        return false;
+
+    WorkerDeque &deque = _deques[workerId];
+    std::lock_guard<std::mutex> lock( deque._mutex );
+    deque._subQueries.push_back( subQuery );
+    ++_size;
+    return true;
+}
+
+bool WorkStealingQueue::pop( unsigned workerId, SubQuery *&subQuery )
+{
+    if ( workerId >= _numberOfWorkers )
+        return false;
+
+    {
+        WorkerDeque &deque = _deques[workerId];
+        std::lock_guard<std::mutex> lock( deque._mutex );
+        if ( !deque._subQueries.empty() )
+        {
+            subQuery = deque._subQueries.back();
+            deque._subQueries.pop_back();
+            --_size;
+            return true;
+        }
+    }
+
+    return steal( workerId, subQuery );
+}
+
+bool WorkStealingQueue::steal( unsigned thiefId, SubQuery *&subQuery )
+{
+    while ( _size.load() > 0 )
+    {
+        // Find the victim whose oldest pending subquery is the shallowest.
+        // Start the scan right after the thief, so that different thieves
+        // do not all go after the same victim on ties.
+        bool found = false;
+        unsigned victim = 0;
+        unsigned shallowestDepth = 0;
+        for ( unsigned i = 1; i <= _numberOfWorkers; ++i )
+        {
+            unsigned candidate = ( thiefId + i ) % _numberOfWorkers;
+            if ( candidate == thiefId && _numberOfWorkers > 1 )
+                continue;
+
+            WorkerDeque &deque = _deques[candidate];
+            std::lock_guard<std::mutex> lock( deque._mutex );
+            if ( deque._subQueries.empty() )
+                continue;
+
+            unsigned depth = deque._subQueries.front()->_depth;
+            if ( !found || depth < shallowestDepth )
+            {
+                found = true;
+                victim = candidate;
+                shallowestDepth = depth;
+            }
+        }
+
+        if ( !found )
+            return false;
+
+        // The victim may have been drained in the meantime, in which case
+        // we look again
+        WorkerDeque &deque = _deques[victim];
+        std::lock_guard<std::mutex> lock( deque._mutex );
+        if ( !deque._subQueries.empty() )
+        {
+            subQuery = deque._subQueries.front();
+            deque._subQueries.pop_front();
+            --_size;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+unsigned WorkStealingQueue::size() const
+{
+    return _size.load();
+}
+
+bool WorkStealingQueue::empty() const
+{
+    return _size.load() == 0;
+}
+
+unsigned WorkStealingQueue::getNumberOfWorkers() const
+{
+    return _numberOfWorkers;
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,95 @@
+/*********************                                                        */
+/*! \file WorkStealingQueue.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** The workload shared by the DnCWorkers. Each worker owns a deque of
+ ** subqueries: it pushes and pops at the back of its own deque, so that it
+ ** keeps exploring its own subtree depth-first. When a worker's deque is
+ ** empty, it steals from the front of another worker's deque, picking the
+ ** victim whose oldest pending subquery is the shallowest.
+ **
+ ** Each deque is protected by its own lock, so the owner only contends with
+ ** thieves, and only when its deque is being stolen from.
+
+**/
+
+#ifndef __WorkStealingQueue_h__
+#define __WorkStealingQueue_h__
+
+#include "SubQuery.h"
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+
+class WorkStealingQueue
+{
+public:
+    WorkStealingQueue( unsigned numberOfWorkers );
+
+    /*
+      Any subqueries left in the deques are deleted
+    */
+    ~WorkStealingQueue();
+
+    /*
+      Push a subquery into the deque of the given worker. Ownership of the
+      subquery is transferred to the queue.
+    */
+    bool push( unsigned workerId, SubQuery *subQuery );
+
+    /*
+      Pop the most recently pushed subquery of the given worker. If that
+      worker's deque is empty, try to steal from the other workers. Returns
+      true iff a subquery was obtained.
+    */
+    bool pop( unsigned workerId, SubQuery *&subQuery );
+
+    /*
+      Steal the shallowest pending subquery of any worker other than the thief.
+      Returns true iff a subquery was obtained.
+    */
+    bool steal( unsigned thiefId, SubQuery *&subQuery );
+
+    /*
+      The total number of pending subqueries, across all workers
+    */
+    unsigned size() const;
+    bool empty() const;
+
+    unsigned getNumberOfWorkers() const;
+
+private:
+    struct WorkerDeque
+    {
+        std::mutex _mutex;
+        std::deque<SubQuery *> _subQueries;
+    };
+
+    unsigned _numberOfWorkers;
+    WorkerDeque *_deques;
+
+    /*
+      The total number of subqueries in all deques. Used to let idle workers
+      avoid scanning the deques of the other workers when there is nothing to
+      steal.
+    */
+    std::atomic_uint _size;
+};
+
+#endif // __WorkStealingQueue_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
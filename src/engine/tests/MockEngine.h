@@ -20,6 +20,7 @@
 #include "List.h"
 #include "PiecewiseLinearCaseSplit.h"
 #include "PiecewiseLinearConstraint.h"
+#include "Statistics.h"
 
 class MockEngine : public IEngine
 {
@@ -30,6 +31,8 @@ public:
         wasDiscarded = false;
 
         lastStoredState = NULL;
+        lastDecisionLevel = 0;
+        stateStoredOnTrail = false;
     }
     
     ~MockEngine()
@@ -69,7 +72,7 @@ public:
     List<Equation> lastEquations;
     void applySplit( const PiecewiseLinearCaseSplit &split )
     {
-        List<Tightening> bounds = split.getBoundTightenings();
+        Vector<Tightening> bounds = split.getBoundTightenings();
         auto equations = split.getEquations();
         for ( auto &it : equations )
         {
@@ -105,6 +108,22 @@ public:
     {
     }
 
+    bool stateStoredOnTrail;
+    bool storeStateOnTrail( EngineState &/* state */ )
+    {
+        return stateStoredOnTrail;
+    }
+
+    void saveConstraintOnTrail( PiecewiseLinearConstraint */* constraint */ )
+    {
+    }
+
+    unsigned lastDecisionLevel;
+    void setDecisionLevel( unsigned level )
+    {
+        lastDecisionLevel = level;
+    }
+
     unsigned _timeToSolve;
     IEngine::ExitCode _exitCode;
     bool solve( unsigned timeoutInSeconds )
@@ -144,6 +163,19 @@ public:
         return _inputVariables;
     }
 
+    Statistics statistics;
+    const Statistics *getStatistics() const
+    {
+        return &statistics;
+    }
+
+    List<Tightening> rootTightenings;
+    void getRootTightenings( List<Tightening> &tightenings ) const
+    {
+        for ( const auto &tightening : rootTightenings )
+            tightenings.append( tightening );
+    }
+
     void updateScores( DivideStrategy /**/ )
     {
     }
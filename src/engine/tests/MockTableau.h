@@ -19,8 +19,10 @@
 #include "FloatUtils.h"
 #include "ITableau.h"
 #include "Map.h"
+#include "SparseUnsortedArrays.h"
 #include "SparseUnsortedList.h"
 #include "TableauRow.h"
+#include "Tightening.h"
 
 #include <cstring>
 
@@ -135,6 +137,12 @@ public:
         memcpy( lastEntries, A, sizeof(double) * lastM * lastN );
     }
 
+    void setConstraintMatrix( const SparseUnsortedArrays *A )
+    {
+        TS_ASSERT( setDimensionsCalled );
+        A->toDense( lastEntries );
+    }
+
     double *lastRightHandSide;
     void setRightHandSide( const double * b )
     {
@@ -269,6 +277,10 @@ public:
     void setChangeRatio( double /* changeRatio */ ) {}
 
     void performPivot() {}
+    void resetDualSteepestEdgeWeights() {}
+    bool pickDualLeavingVariable() { return false; }
+    bool dualRatioTest() { return false; }
+    void updateDualSteepestEdgeWeights() {}
     bool performingFakePivot() const
     {
         return false;
@@ -485,6 +497,18 @@ public:
         tightenedUpperBounds[variable] = value;
     }
 
+    unsigned applyTightenings( const List<Tightening> &tightenings )
+    {
+        for ( const auto &tightening : tightenings )
+        {
+            if ( tightening._type == Tightening::LB )
+                tightenLowerBound( tightening._variable, tightening._value );
+            else
+                tightenUpperBound( tightening._variable, tightening._value );
+        }
+        return tightenings.size();
+    }
+
     void applySplit( const PiecewiseLinearCaseSplit &/* split */)
     {
     }
@@ -595,6 +619,47 @@ public:
     {
         return 0;
     }
+
+    void setBoundTrailEnabled( bool /* enabled */ )
+    {
+    }
+
+    bool boundTrailEnabled() const
+    {
+        return false;
+    }
+
+    unsigned getBoundTrailSize() const
+    {
+        return 0;
+    }
+
+    void undoBoundTrail( unsigned /* position */ )
+    {
+    }
+
+    void clearBoundTrail()
+    {
+    }
+
+    void setDecisionLevel( unsigned /* level */ )
+    {
+    }
+
+    unsigned getDecisionLevel() const
+    {
+        return 0;
+    }
+
+    unsigned getLowerBoundLevel( unsigned /* variable */ ) const
+    {
+        return 0;
+    }
+
+    unsigned getUpperBoundLevel( unsigned /* variable */ ) const
+    {
+        return 0;
+    }
 };
 
 #endif // __MockTableau_h__
@@ -805,7 +805,7 @@ public:
 
     bool isPositiveSplit( unsigned b, unsigned f, List<PiecewiseLinearCaseSplit>::iterator &split )
     {
-        List<Tightening> bounds = split->getBoundTightenings();
+        Vector<Tightening> bounds = split->getBoundTightenings();
 
         auto bound = bounds.begin();
         Tightening bound1 = *bound;
@@ -840,7 +840,7 @@ public:
 
     bool isNegativeSplit( unsigned b, unsigned f, List<PiecewiseLinearCaseSplit>::iterator &split )
     {
-        List<Tightening> bounds = split->getBoundTightenings();
+        Vector<Tightening> bounds = split->getBoundTightenings();
 
         auto bound = bounds.begin();
         Tightening bound1 = *bound;
@@ -955,7 +955,7 @@ public:
 
         Equation activeEquation;
 
-        List<Tightening> bounds = split.getBoundTightenings();
+        Vector<Tightening> bounds = split.getBoundTightenings();
 
         TS_ASSERT_EQUALS( bounds.size(), 1U );
         auto bound = bounds.begin();
@@ -1001,7 +1001,7 @@ public:
 
         Equation activeEquation;
 
-        List<Tightening> bounds = split.getBoundTightenings();
+        Vector<Tightening> bounds = split.getBoundTightenings();
 
         TS_ASSERT_EQUALS( bounds.size(), 1U );
         auto bound = bounds.begin();
@@ -1152,7 +1152,7 @@ public:
         TS_ASSERT_EQUALS( validSplit.getBoundTightenings().size(), 2U );
         TS_ASSERT_EQUALS( *validSplit.getBoundTightenings().begin(),
                           Tightening( b, 0, Tightening::LB ) );
-        TS_ASSERT_EQUALS( *validSplit.getBoundTightenings().rbegin(),
+        TS_ASSERT_EQUALS( validSplit.getBoundTightenings().last(),
                           Tightening( posAux, 0, Tightening::UB ) );
     }
 
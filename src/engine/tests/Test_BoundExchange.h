@@ -0,0 +1,144 @@
+/*********************                                                        */
+/*! \file Test_BoundExchange.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "BoundExchange.h"
+
+#include <list>
+#include <thread>
+
+class BoundExchangeTestSuite : public CxxTest::TestSuite
+{
+public:
+    void test_collect_in_publication_order()
+    {
+        BoundExchange exchange( 3, 10 );
+        TS_ASSERT_EQUALS( exchange.getNumberOfParticipants(), 3U );
+
+        TS_ASSERT( exchange.publish( 0, Tightening( 1, 2.5, Tightening::LB ) ) );
+        TS_ASSERT( exchange.publish( 0, Tightening( 3, -1, Tightening::UB ) ) );
+        TS_ASSERT( exchange.publish( 1, Tightening( 4, 7, Tightening::UB ) ) );
+
+        TS_ASSERT_EQUALS( exchange.getNumPublished( 0 ), 2U );
+        TS_ASSERT_EQUALS( exchange.getNumPublished( 1 ), 1U );
+        TS_ASSERT_EQUALS( exchange.getNumPublished( 2 ), 0U );
+
+        List<Tightening> tightenings;
+        exchange.collect( 2, tightenings );
+
+        List<Tightening> expected;
+        expected.append( Tightening( 1, 2.5, Tightening::LB ) );
+        expected.append( Tightening( 3, -1, Tightening::UB ) );
+        expected.append( Tightening( 4, 7, Tightening::UB ) );
+        TS_ASSERT_EQUALS( tightenings, expected );
+
+        // Only new tightenings are collected the second time
+        TS_ASSERT( exchange.publish( 1, Tightening( 5, 0, Tightening::LB ) ) );
+        tightenings.clear();
+        exchange.collect( 2, tightenings );
+        TS_ASSERT_EQUALS( tightenings.size(), 1U );
+        TS_ASSERT_EQUALS( *tightenings.begin(), Tightening( 5, 0, Tightening::LB ) );
+
+        tightenings.clear();
+        exchange.collect( 2, tightenings );
+        TS_ASSERT( tightenings.empty() );
+    }
+
+    void test_own_tightenings_are_not_collected()
+    {
+        BoundExchange exchange( 2, 10 );
+
+        TS_ASSERT( exchange.publish( 0, Tightening( 1, 2, Tightening::LB ) ) );
+        TS_ASSERT( exchange.publish( 1, Tightening( 2, 3, Tightening::UB ) ) );
+
+        List<Tightening> tightenings;
+        exchange.collect( 0, tightenings );
+        TS_ASSERT_EQUALS( tightenings.size(), 1U );
+        TS_ASSERT_EQUALS( *tightenings.begin(), Tightening( 2, 3, Tightening::UB ) );
+
+        tightenings.clear();
+        exchange.collect( 1, tightenings );
+        TS_ASSERT_EQUALS( tightenings.size(), 1U );
+        TS_ASSERT_EQUALS( *tightenings.begin(), Tightening( 1, 2, Tightening::LB ) );
+    }
+
+    void test_full_buffer_drops_tightenings()
+    {
+        BoundExchange exchange( 2, 2 );
+
+        TS_ASSERT( exchange.publish( 0, Tightening( 1, 1, Tightening::LB ) ) );
+        TS_ASSERT( exchange.publish( 0, Tightening( 2, 2, Tightening::LB ) ) );
+        TS_ASSERT( !exchange.publish( 0, Tightening( 3, 3, Tightening::LB ) ) );
+        TS_ASSERT_EQUALS( exchange.getNumPublished( 0 ), 2U );
+
+        // The other participant's buffer is unaffected
+        TS_ASSERT( exchange.publish( 1, Tightening( 4, 4, Tightening::UB ) ) );
+
+        List<Tightening> tightenings;
+        exchange.collect( 1, tightenings );
+        TS_ASSERT_EQUALS( tightenings.size(), 2U );
+    }
+
+    void test_concurrent_publish_and_collect()
+    {
+        const unsigned numberOfParticipants = 4;
+        const unsigned numberOfTightenings = 1000;
+
+        BoundExchange exchange( numberOfParticipants, numberOfTightenings );
+        Vector<List<Tightening>> collected( numberOfParticipants );
+
+        std::list<std::thread> threads;
+        for ( unsigned i = 0; i < numberOfParticipants; ++i )
+        {
+            threads.push_back( std::thread( [&, i]() {
+                for ( unsigned j = 0; j < numberOfTightenings; ++j )
+                {
+                    exchange.publish( i, Tightening( i, j, Tightening::LB ) );
+                    if ( j % 10 == 0 )
+                        exchange.collect( i, collected[i] );
+                }
+            } ) );
+        }
+
+        for ( auto &thread : threads )
+            thread.join();
+
+        for ( unsigned i = 0; i < numberOfParticipants; ++i )
+        {
+            exchange.collect( i, collected[i] );
+            TS_ASSERT_EQUALS( collected[i].size(),
+                              ( numberOfParticipants - 1 ) * numberOfTightenings );
+
+            // Each writer's tightenings arrive complete and in order
+            Vector<double> next( numberOfParticipants, 0.0 );
+            for ( const auto &tightening : collected[i] )
+            {
+                TS_ASSERT_DIFFERS( tightening._variable, i );
+                TS_ASSERT_EQUALS( tightening._type, Tightening::LB );
+                TS_ASSERT_EQUALS( tightening._value, next[tightening._variable] );
+                next[tightening._variable] += 1;
+            }
+        }
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
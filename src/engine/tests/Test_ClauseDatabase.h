@@ -0,0 +1,144 @@
+/*********************                                                        */
+/*! \file Test_ClauseDatabase.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "ClauseDatabase.h"
+#include "ReluConstraint.h"
+
+class ClauseDatabaseTestSuite : public CxxTest::TestSuite
+{
+public:
+    void test_unit_propagation()
+    {
+        ReluConstraint relu1( 0, 1 );
+        ReluConstraint relu2( 2, 3 );
+        ReluConstraint relu3( 4, 5 );
+
+        PhaseLiteral active1( &relu1, RELU_PHASE_ACTIVE );
+        PhaseLiteral inactive2( &relu2, RELU_PHASE_INACTIVE );
+        PhaseLiteral active3( &relu3, RELU_PHASE_ACTIVE );
+
+        ClauseDatabase database;
+        database.addClause( { active1, inactive2, active3 } );
+        TS_ASSERT_EQUALS( database.getNumClauses(), 1U );
+
+        List<PhaseLiteral> refuted;
+        TS_ASSERT( database.propagate( refuted ) );
+        TS_ASSERT( refuted.empty() );
+
+        // One phase holds: nothing is refuted yet
+        TS_ASSERT( database.assertPhase( active1, refuted ) );
+        TS_ASSERT( refuted.empty() );
+        TS_ASSERT( database.holds( active1 ) );
+        TS_ASSERT( database.hasAssertedPhase( &relu1 ) );
+        TS_ASSERT( !database.hasAssertedPhase( &relu2 ) );
+
+        // Two phases hold: the third one is refuted
+        TS_ASSERT( database.assertPhase( active3, refuted ) );
+        TS_ASSERT_EQUALS( refuted.size(), 1U );
+        TS_ASSERT( *refuted.begin() == inactive2 );
+
+        // Asserting the refuted phase violates the clause
+        refuted.clear();
+        TS_ASSERT( !database.assertPhase( inactive2, refuted ) );
+        TS_ASSERT_EQUALS( database.getViolatedClause().size(), 3U );
+    }
+
+    void test_contradicted_phase_satisfies_clause()
+    {
+        ReluConstraint relu1( 0, 1 );
+        ReluConstraint relu2( 2, 3 );
+        ReluConstraint relu3( 4, 5 );
+
+        ClauseDatabase database;
+        database.addClause( { PhaseLiteral( &relu1, RELU_PHASE_ACTIVE ),
+                              PhaseLiteral( &relu2, RELU_PHASE_ACTIVE ),
+                              PhaseLiteral( &relu3, RELU_PHASE_ACTIVE ) } );
+
+        List<PhaseLiteral> refuted;
+        TS_ASSERT( database.propagate( refuted ) );
+
+        TS_ASSERT( database.assertPhase( PhaseLiteral( &relu2, RELU_PHASE_INACTIVE ), refuted ) );
+        TS_ASSERT( database.assertPhase( PhaseLiteral( &relu1, RELU_PHASE_ACTIVE ), refuted ) );
+        TS_ASSERT( database.assertPhase( PhaseLiteral( &relu3, RELU_PHASE_ACTIVE ), refuted ) );
+        TS_ASSERT( refuted.empty() );
+    }
+
+    void test_retract_and_recheck()
+    {
+        ReluConstraint relu1( 0, 1 );
+        ReluConstraint relu2( 2, 3 );
+
+        PhaseLiteral active1( &relu1, RELU_PHASE_ACTIVE );
+        PhaseLiteral active2( &relu2, RELU_PHASE_ACTIVE );
+
+        ClauseDatabase database;
+        List<PhaseLiteral> refuted;
+
+        TS_ASSERT( database.assertPhase( active1, refuted ) );
+
+        // A clause added while one of its phases holds is unit
+        database.addClause( { active1, active2 } );
+        TS_ASSERT( database.propagate( refuted ) );
+        TS_ASSERT_EQUALS( refuted.size(), 1U );
+        TS_ASSERT( *refuted.begin() == active2 );
+
+        // After retracting the phase, the clause is no longer unit
+        refuted.clear();
+        database.retractPhase( &relu1 );
+        TS_ASSERT( !database.holds( active1 ) );
+        TS_ASSERT( database.propagate( refuted ) );
+        TS_ASSERT( refuted.empty() );
+
+        // Asserting the other phase first refutes the first one
+        TS_ASSERT( database.assertPhase( active2, refuted ) );
+        TS_ASSERT_EQUALS( refuted.size(), 1U );
+        TS_ASSERT( *refuted.begin() == active1 );
+
+        refuted.clear();
+        TS_ASSERT( !database.assertPhase( active1, refuted ) );
+
+        database.clear();
+        TS_ASSERT_EQUALS( database.getNumClauses(), 0U );
+        TS_ASSERT( !database.hasAssertedPhase( &relu2 ) );
+    }
+
+    void test_unit_clause()
+    {
+        ReluConstraint relu1( 0, 1 );
+        PhaseLiteral active1( &relu1, RELU_PHASE_ACTIVE );
+
+        ClauseDatabase database;
+        database.addClause( { active1 } );
+
+        List<PhaseLiteral> refuted;
+        TS_ASSERT( database.propagate( refuted ) );
+        TS_ASSERT_EQUALS( refuted.size(), 1U );
+
+        refuted.clear();
+        TS_ASSERT( database.assertPhase( PhaseLiteral( &relu1, RELU_PHASE_INACTIVE ), refuted ) );
+        database.retractPhase( &relu1 );
+        TS_ASSERT( !database.assertPhase( active1, refuted ) );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -100,6 +100,48 @@ public:
         TS_ASSERT_EQUALS( upper->_variable, 3U );
         TS_ASSERT_EQUALS( upper->_value, 2 );
     }
+
+    void test_batched_bound_updates()
+    {
+        ConstraintBoundTightener tightener( *tableau );
+
+        tableau->setDimensions( 2, 5 );
+
+        for ( unsigned i = 0; i < 5; ++i )
+        {
+            tableau->setLowerBound( i, -10 );
+            tableau->setUpperBound( i, 10 );
+        }
+
+        tightener.setDimensions();
+
+        TS_ASSERT_THROWS_NOTHING( tightener.registerTighterLowerBound( 1, 7 ) );
+        TS_ASSERT_THROWS_NOTHING( tightener.registerTighterUpperBound( 3, 2 ) );
+        TS_ASSERT_THROWS_NOTHING( tightener.registerTighterUpperBound( 4, 5 ) );
+
+        // The tableau reports a batch in which x1's lower bound and x3's
+        // upper bound became tighter than the registered ones, and
+        // x4's upper bound became looser than the registered one
+        double lowerBounds[] = { -10, 8, -10, -10, -10 };
+        double upperBounds[] = { 10, 10, 10, 1, 6 };
+        char changed[] = { 0,
+                           ITableau::BoundUpdates::LOWER,
+                           0,
+                           ITableau::BoundUpdates::UPPER,
+                           ITableau::BoundUpdates::UPPER };
+        Vector<unsigned> variables = { 1, 3, 4 };
+        ITableau::BoundUpdates updates = { variables, changed, lowerBounds, upperBounds };
+
+        TS_ASSERT_THROWS_NOTHING( tightener.notifyBounds( updates ) );
+
+        List<Tightening> tightenings;
+        TS_ASSERT_THROWS_NOTHING( tightener.getConstraintTightenings( tightenings ) );
+        TS_ASSERT_EQUALS( tightenings.size(), 1U );
+
+        TS_ASSERT_EQUALS( tightenings.begin()->_variable, 4U );
+        TS_ASSERT_EQUALS( tightenings.begin()->_type, Tightening::UB );
+        TS_ASSERT_EQUALS( tightenings.begin()->_value, 5 );
+    }
 };
 
 //
@@ -181,6 +181,34 @@ public:
             TS_ASSERT( !columns.exists( 0 ) );
         }
     }
+
+    void test_analyze_sparse_rows()
+    {
+        ConstraintMatrixAnalyzer analyzer;
+
+        double A1[] = {
+            15, 3,  0, 1, 0,
+            0 , 0, -1, 1, 4,
+            15, 3, -1, 2, 4,
+        };
+
+        SparseUnsortedArrays rows;
+        rows.initialize( A1, 3, 5 );
+
+        TS_ASSERT_THROWS_NOTHING( analyzer.analyze( &rows, 3, 5 ) );
+
+        TS_ASSERT_EQUALS( analyzer.getRedundantRows().size(), 1U );
+
+        List<unsigned> columns = analyzer.getIndependentColumns();
+        TS_ASSERT_EQUALS( columns.size(), 2U );
+        TS_ASSERT( !columns.exists( 0 ) || !columns.exists( 1 ) );
+        TS_ASSERT( !columns.exists( 2 ) || !columns.exists( 4 ) );
+
+        // The input rows are not changed by the analysis
+        double dense[15];
+        rows.toDense( dense );
+        TS_ASSERT_SAME_DATA( dense, A1, sizeof(A1) );
+    }
 };
 
 //
@@ -0,0 +1,137 @@
+/*********************                                                        */
+/*! \file Test_ConstraintStateTrail.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "ConstraintStateTrail.h"
+#include "ReluConstraint.h"
+
+class ConstraintStateTrailTestSuite : public CxxTest::TestSuite
+{
+public:
+    void test_save_and_undo()
+    {
+        ReluConstraint relu1( 0, 1 );
+        ReluConstraint relu2( 2, 3 );
+
+        List<PiecewiseLinearConstraint *> constraints = { &relu1, &relu2 };
+
+        ConstraintStateTrail trail;
+        trail.initialize( constraints );
+
+        // Nothing is saved while not recording
+        trail.notifyLowerBound( 0, -5 );
+        TS_ASSERT_EQUALS( trail.getSize(), 0U );
+
+        trail.setRecording( true );
+        TS_ASSERT( trail.recording() );
+
+        // First level: relu1 becomes active
+        unsigned level1 = trail.getSize();
+        trail.startLevel();
+
+        trail.notifyLowerBound( 1, 2 );
+        relu1.notifyLowerBound( 1, 2 );
+        TS_ASSERT_EQUALS( trail.getSize(), 1U );
+        TS_ASSERT( relu1.phaseFixed() );
+
+        // A constraint is saved only once per level
+        trail.notifyUpperBound( 0, 5 );
+        relu1.notifyUpperBound( 0, 5 );
+        TS_ASSERT_EQUALS( trail.getSize(), 1U );
+
+        // Second level: relu1 is disabled, relu2 becomes active
+        unsigned level2 = trail.getSize();
+        trail.startLevel();
+
+        trail.saveConstraint( &relu1 );
+        relu1.setActiveConstraint( false );
+        trail.notifyLowerBound( 3, 1 );
+        relu2.notifyLowerBound( 3, 1 );
+        TS_ASSERT_EQUALS( trail.getSize(), 3U );
+
+        TS_ASSERT( !relu1.isActive() );
+        TS_ASSERT( relu2.phaseFixed() );
+
+        List<PiecewiseLinearConstraint *> restored;
+        trail.undo( level2, restored );
+        TS_ASSERT_EQUALS( trail.getSize(), level2 );
+        TS_ASSERT_EQUALS( restored.size(), 2U );
+
+        TS_ASSERT( relu1.isActive() );
+        TS_ASSERT( relu1.phaseFixed() );
+        TS_ASSERT( !relu2.phaseFixed() );
+
+        // The second level starts over, and relu1 is saved again
+        trail.saveConstraint( &relu1 );
+        TS_ASSERT_EQUALS( trail.getSize(), level2 + 1 );
+        trail.saveConstraint( &relu1 );
+        TS_ASSERT_EQUALS( trail.getSize(), level2 + 1 );
+
+        restored.clear();
+        trail.undo( level1, restored );
+        TS_ASSERT_EQUALS( trail.getSize(), 0U );
+        TS_ASSERT_EQUALS( restored.size(), 2U );
+        TS_ASSERT( !relu1.phaseFixed() );
+
+        trail.notifyLowerBound( 1, 3 );
+        TS_ASSERT_EQUALS( trail.getSize(), 1U );
+
+        trail.clear();
+        TS_ASSERT_EQUALS( trail.getSize(), 0U );
+        TS_ASSERT( !trail.recording() );
+    }
+
+    void test_rolled_back_states_are_reused()
+    {
+        ReluConstraint relu( 0, 1 );
+
+        List<PiecewiseLinearConstraint *> constraints = { &relu };
+
+        ConstraintStateTrail trail;
+        trail.initialize( constraints );
+        trail.setRecording( true );
+
+        trail.startLevel();
+        trail.notifyLowerBound( 1, 2 );
+        relu.notifyLowerBound( 1, 2 );
+        TS_ASSERT( relu.phaseFixed() );
+
+        List<PiecewiseLinearConstraint *> restored;
+        trail.undo( 0, restored );
+        TS_ASSERT( !relu.phaseFixed() );
+
+        // The state saved next is the current one, not the one the
+        // reused copy held before
+        relu.notifyLowerBound( 1, 2 );
+        trail.startLevel();
+        trail.saveConstraint( &relu );
+        relu.setActiveConstraint( false );
+
+        restored.clear();
+        trail.undo( 0, restored );
+        TS_ASSERT_EQUALS( restored.size(), 1U );
+        TS_ASSERT( relu.isActive() );
+        TS_ASSERT( relu.phaseFixed() );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,133 @@
+/*********************                                                        */
+/*! \file Test_DnCBoundStore.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "DnCBoundStore.h"
+#include "MStringf.h"
+
+#include <atomic>
+#include <list>
+#include <thread>
+
+class DnCBoundStoreTestSuite : public CxxTest::TestSuite
+{
+public:
+    void test_is_ancestor()
+    {
+        TS_ASSERT( DnCBoundStore::isAncestor( "2", "2-1" ) );
+        TS_ASSERT( DnCBoundStore::isAncestor( "2", "2-1-3" ) );
+        TS_ASSERT( DnCBoundStore::isAncestor( "2-1", "2-1-3" ) );
+
+        TS_ASSERT( !DnCBoundStore::isAncestor( "2", "2" ) );
+        TS_ASSERT( !DnCBoundStore::isAncestor( "2-1", "2" ) );
+        TS_ASSERT( !DnCBoundStore::isAncestor( "2", "21-1" ) );
+        TS_ASSERT( !DnCBoundStore::isAncestor( "2-1", "2-10" ) );
+        TS_ASSERT( !DnCBoundStore::isAncestor( "1", "2-1" ) );
+        TS_ASSERT( !DnCBoundStore::isAncestor( "", "2-1" ) );
+    }
+
+    void test_tightenings_of_ancestors()
+    {
+        DnCBoundStore store( 2, 10 );
+
+        TS_ASSERT( store.publish( 0, "1", Tightening( 1, 0.5, Tightening::LB ) ) );
+        TS_ASSERT( store.publish( 1, "1-2", Tightening( 2, 3, Tightening::UB ) ) );
+        TS_ASSERT( store.publish( 1, "2", Tightening( 3, 4, Tightening::UB ) ) );
+        TS_ASSERT( store.publish( 0, "1-2-1", Tightening( 4, 5, Tightening::LB ) ) );
+
+        TS_ASSERT_EQUALS( store.getNumPublished( 0 ), 2U );
+        TS_ASSERT_EQUALS( store.getNumPublished( 1 ), 2U );
+
+        List<Tightening> tightenings;
+        store.getTightenings( "1-2-1", tightenings );
+
+        List<Tightening> expected;
+        expected.append( Tightening( 1, 0.5, Tightening::LB ) );
+        expected.append( Tightening( 2, 3, Tightening::UB ) );
+        TS_ASSERT_EQUALS( tightenings, expected );
+
+        tightenings.clear();
+        store.getTightenings( "1-1", tightenings );
+        TS_ASSERT_EQUALS( tightenings.size(), 1U );
+        TS_ASSERT_EQUALS( *tightenings.begin(), Tightening( 1, 0.5, Tightening::LB ) );
+
+        tightenings.clear();
+        store.getTightenings( "3", tightenings );
+        TS_ASSERT( tightenings.empty() );
+    }
+
+    void test_full_buffer_drops_tightenings()
+    {
+        DnCBoundStore store( 1, 1 );
+
+        TS_ASSERT( store.publish( 0, "1", Tightening( 1, 1, Tightening::LB ) ) );
+        TS_ASSERT( !store.publish( 0, "1", Tightening( 2, 2, Tightening::LB ) ) );
+
+        List<Tightening> tightenings;
+        store.getTightenings( "1-1", tightenings );
+        TS_ASSERT_EQUALS( tightenings.size(), 1U );
+    }
+
+    void test_concurrent_publish_and_read()
+    {
+        const unsigned numberOfWorkers = 4;
+        const unsigned numberOfTightenings = 500;
+
+        DnCBoundStore store( numberOfWorkers, numberOfTightenings );
+        std::atomic_uint numForeignTightenings( 0 );
+
+        std::list<std::thread> threads;
+        for ( unsigned i = 0; i < numberOfWorkers; ++i )
+        {
+            threads.push_back( std::thread( [&, i]() {
+                String queryId = Stringf( "%u", i + 1 );
+                for ( unsigned j = 0; j < numberOfTightenings; ++j )
+                {
+                    store.publish( i, queryId, Tightening( i, j, Tightening::UB ) );
+
+                    // Only the worker's own region is read
+                    List<Tightening> tightenings;
+                    store.getTightenings( queryId + "-1", tightenings );
+                    for ( const auto &tightening : tightenings )
+                    {
+                        if ( tightening._variable != i )
+                            ++numForeignTightenings;
+                    }
+                }
+            } ) );
+        }
+
+        for ( auto &thread : threads )
+            thread.join();
+
+        TS_ASSERT_EQUALS( numForeignTightenings.load(), 0U );
+
+        for ( unsigned i = 0; i < numberOfWorkers; ++i )
+        {
+            List<Tightening> tightenings;
+            store.getTightenings( Stringf( "%u-1", i + 1 ), tightenings );
+            TS_ASSERT_EQUALS( tightenings.size(), numberOfTightenings );
+        }
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
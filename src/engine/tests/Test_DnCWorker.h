@@ -16,6 +16,7 @@
 #include <cxxtest/TestSuite.h>
 
 #include "DnCWorker.h"
+#include "GlobalConfiguration.h"
 #include "MockEngine.h"
 
 #include <string.h>
@@ -24,7 +25,7 @@ class DnCWorkerTestSuite : public CxxTest::TestSuite
 {
 public:
 
-    WorkerQueue *_workload;
+    WorkStealingQueue *_workload;
     std::shared_ptr<MockEngine> _engine;
 
     DnCWorkerTestSuite()
@@ -34,7 +35,7 @@ public:
 
     void setUp()
     {
-        _workload = new WorkerQueue( 0 );
+        _workload = new WorkStealingQueue( 1 );
 
         // Initialize the mockEngine
         _engine = std::make_shared<MockEngine>();
@@ -59,7 +60,7 @@ public:
         SubQuery *subQuery = NULL;
         while ( !_workload->empty() )
         {
-            _workload->pop( subQuery );
+            _workload->pop( 0, subQuery );
             if ( subQuery )
             {
                 delete subQuery;
@@ -97,7 +98,7 @@ public:
         subQuery->_queryId = "";
         subQuery->_split = std::move( split );
         subQuery->_timeoutInSeconds = 5;
-        TS_ASSERT( _workload->push( std::move( subQuery ) ) );
+        TS_ASSERT( _workload->push( 0, std::move( subQuery ) ) );
     }
 
     // Test different branches of DnCWorker.popOneSubQueryAndSolve()
@@ -252,6 +253,151 @@ public:
         TS_ASSERT( numUnsolvedSubQueries.load() == 1 );
         TS_ASSERT( shouldQuitSolving.load() );
     }
+
+    bool hasBound( const List<MockEngine::Bound> &bounds, unsigned variable, double value )
+    {
+        for ( const auto &bound : bounds )
+        {
+            if ( bound._variable == variable && bound._bound == value )
+                return true;
+        }
+        return false;
+    }
+
+    void test_root_bounds_are_shared_with_descendants()
+    {
+        DnCBoundStore boundStore( 1, 100 );
+
+        createPlaceHolderSubQuery();
+        SubQuery *subQuery = NULL;
+        TS_ASSERT( _workload->pop( 0, subQuery ) );
+        subQuery->_queryId = "1";
+        TS_ASSERT( _workload->push( 0, subQuery ) );
+
+        // The root bound of x1 is the one the subQuery started from, and
+        // is not shared
+        _engine->rootTightenings.append( Tightening( 1, -2.0, Tightening::LB ) );
+        _engine->rootTightenings.append( Tightening( 1, 1.5, Tightening::UB ) );
+        _engine->rootTightenings.append( Tightening( 7, 4.0, Tightening::LB ) );
+        _engine->setTimeToSolve( 10 );
+        _engine->setExitCode( IEngine::TIMEOUT );
+
+        std::atomic_uint numUnsolvedSubQueries( 1 );
+        std::atomic_bool shouldQuitSolving( false );
+        DnCWorker dncWorker( _workload, _engine, numUnsolvedSubQueries,
+                             shouldQuitSolving, 0, 1, 1,
+                             SnCDivideStrategy::LargestInterval, 0, &boundStore );
+
+        dncWorker.popOneSubQueryAndSolve();
+        TS_ASSERT_EQUALS( numUnsolvedSubQueries.load(), 2U );
+        TS_ASSERT_EQUALS( boundStore.getNumPublished( 0 ), 2U );
+
+        // A child starts from the bounds derived at the root of its parent
+        _engine->lastLowerBounds.clear();
+        _engine->lastUpperBounds.clear();
+        _engine->rootTightenings.clear();
+        _engine->setExitCode( IEngine::UNSAT );
+
+        dncWorker.popOneSubQueryAndSolve();
+        TS_ASSERT_EQUALS( numUnsolvedSubQueries.load(), 1U );
+        TS_ASSERT( hasBound( _engine->lastUpperBounds, 1, 1.5 ) );
+        TS_ASSERT( hasBound( _engine->lastLowerBounds, 7, 4.0 ) );
+    }
+
+    void reportSearchProgress( double progress, unsigned numActivePlConstraints )
+    {
+        for ( unsigned i = 0; i < GlobalConfiguration::DNC_MIN_VISITED_STATES_FOR_ESTIMATE; ++i )
+            _engine->statistics.incNumVisitedTreeStates();
+        _engine->statistics.setSearchProgress( progress );
+        _engine->statistics.setNumActivePlConstraints( numActivePlConstraints );
+    }
+
+    void test_adaptive_scheduling_extends_nearly_done_sub_query()
+    {
+        createPlaceHolderSubQuery();
+        reportSearchProgress( 0.75, 10 );
+        _engine->setTimeToSolve( 10 );
+        _engine->setExitCode( IEngine::TIMEOUT );
+
+        std::atomic_uint numUnsolvedSubQueries( 1 );
+        std::atomic_bool shouldQuitSolving( false );
+        DnCWorker dncWorker( _workload, _engine, numUnsolvedSubQueries,
+                             shouldQuitSolving, 0, 1, 1,
+                             SnCDivideStrategy::LargestInterval, 0, NULL, true );
+
+        // The subQuery is requeued as is, with more time
+        dncWorker.popOneSubQueryAndSolve();
+        TS_ASSERT_EQUALS( numUnsolvedSubQueries.load(), 1U );
+
+        SubQuery *subQuery = NULL;
+        TS_ASSERT( _workload->pop( 0, subQuery ) );
+        TS_ASSERT( _workload->empty() );
+        TS_ASSERT_EQUALS( subQuery->_numExtensions, 1U );
+        TS_ASSERT( subQuery->_timeoutInSeconds > 5 );
+        TS_ASSERT_EQUALS( subQuery->_split->getBoundTightenings().size(), 6U );
+        TS_ASSERT( _workload->push( 0, subQuery ) );
+
+        // Having used up its extensions, the subQuery is split
+        dncWorker.popOneSubQueryAndSolve();
+        TS_ASSERT_EQUALS( numUnsolvedSubQueries.load(), 2U );
+        TS_ASSERT_EQUALS( clearSubQueries(), 2U );
+    }
+
+    void test_adaptive_scheduling_divides_by_remaining_work()
+    {
+        // Far from done: 99 timeouts' worth of work remains, which calls
+        // for 7 divides, but there are only 3 constraints left to split on
+        createPlaceHolderSubQuery();
+        reportSearchProgress( 0.01, 3 );
+        _engine->setTimeToSolve( 10 );
+        _engine->setExitCode( IEngine::TIMEOUT );
+
+        std::atomic_uint numUnsolvedSubQueries( 1 );
+        std::atomic_bool shouldQuitSolving( false );
+        DnCWorker dncWorker( _workload, _engine, numUnsolvedSubQueries,
+                             shouldQuitSolving, 0, 1, 1,
+                             SnCDivideStrategy::LargestInterval, 0, NULL, true );
+
+        dncWorker.popOneSubQueryAndSolve();
+        TS_ASSERT_EQUALS( numUnsolvedSubQueries.load(), 8U );
+        TS_ASSERT_EQUALS( clearSubQueries(), 8U );
+
+        // Without an estimate, the default number of divides is used
+        createPlaceHolderSubQuery();
+        _engine->statistics = Statistics();
+        numUnsolvedSubQueries = 1;
+
+        dncWorker.popOneSubQueryAndSolve();
+        TS_ASSERT_EQUALS( numUnsolvedSubQueries.load(), 2U );
+        TS_ASSERT_EQUALS( clearSubQueries(), 2U );
+    }
+
+    void test_statistics_are_aggregated_across_sub_queries()
+    {
+        createPlaceHolderSubQuery();
+        createPlaceHolderSubQuery();
+        _engine->setExitCode( IEngine::UNSAT );
+        _engine->statistics.incNumSplits();
+        _engine->statistics.incNumSplits();
+        _engine->statistics.incNumPops();
+
+        std::atomic_uint numUnsolvedSubQueries( 2 );
+        std::atomic_bool shouldQuitSolving( false );
+        Statistics statistics;
+        DnCWorker dncWorker( _workload, _engine, numUnsolvedSubQueries,
+                             shouldQuitSolving, 0, 1, 1,
+                             SnCDivideStrategy::LargestInterval, 0, NULL, false,
+                             &statistics );
+
+        dncWorker.popOneSubQueryAndSolve();
+        TS_ASSERT_EQUALS( statistics.getNumSplits(), 2U );
+        TS_ASSERT_EQUALS( statistics.getNumPops(), 1U );
+
+        dncWorker.popOneSubQueryAndSolve();
+        TS_ASSERT_EQUALS( statistics.getNumSplits(), 4U );
+        TS_ASSERT_EQUALS( statistics.getNumPops(), 2U );
+        TS_ASSERT_EQUALS( numUnsolvedSubQueries.load(), 0U );
+    }
 };
 
 //
@@ -181,6 +181,66 @@ public:
 
         delete inputQuery;
     }
+
+    void test_evaluate_network()
+    {
+        /*
+          x0, x1 -> b2 = x0 + x1, b3 = x0 - 2x1
+                 -> f4 = relu( b2 ), f5 = relu( b3 )
+                 -> y6 = f4 + 3f5
+
+          Input 0 is x1 and input 1 is x0. Output 0 is y6, and output 1
+          is the hidden neuron f5.
+        */
+        InputQuery inputQuery;
+        inputQuery.setNumberOfVariables( 8 );
+
+        Equation equation1;
+        equation1.addAddend( 1, 0 );
+        equation1.addAddend( 1, 1 );
+        equation1.addAddend( -1, 2 );
+        equation1.setScalar( 0 );
+        inputQuery.addEquation( equation1 );
+
+        Equation equation2;
+        equation2.addAddend( 1, 0 );
+        equation2.addAddend( -2, 1 );
+        equation2.addAddend( -1, 3 );
+        equation2.setScalar( 0 );
+        inputQuery.addEquation( equation2 );
+
+        Equation equation3;
+        equation3.addAddend( 1, 4 );
+        equation3.addAddend( 3, 5 );
+        equation3.addAddend( -1, 6 );
+        equation3.setScalar( 0 );
+        inputQuery.addEquation( equation3 );
+
+        inputQuery.addPiecewiseLinearConstraint( new ReluConstraint( 2, 4 ) );
+        inputQuery.addPiecewiseLinearConstraint( new ReluConstraint( 3, 5 ) );
+
+        inputQuery.markInputVariable( 1, 0 );
+        inputQuery.markInputVariable( 0, 1 );
+        inputQuery.markOutputVariable( 6, 0 );
+        inputQuery.markOutputVariable( 5, 1 );
+
+        double inputs[] = { 1, 2,  2, -1,  0, 3 };
+        double outputs[6];
+        double expectedOutputs[] = { 3, 0,  1, 0,  12, 3 };
+
+        TS_ASSERT_THROWS_NOTHING( inputQuery.evaluateNetwork( inputs, outputs, 3 ) );
+        TS_ASSERT( inputQuery.getNetworkLevelReasoner() );
+        for ( unsigned i = 0; i < 6; ++i )
+            TS_ASSERT( FloatUtils::areEqual( outputs[i], expectedOutputs[i] ) );
+
+        // Variable 7 is not computed by the network
+        inputQuery.markOutputVariable( 7, 2 );
+        double moreOutputs[3];
+        TS_ASSERT_THROWS_EQUALS( inputQuery.evaluateNetwork( inputs, moreOutputs, 1 ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::NETWORK_LEVEL_REASONER_NOT_AVAILABLE );
+    }
 };
 
 //
@@ -282,7 +282,7 @@ public:
         auto split = splits.begin();
         for ( unsigned i = 2; i < 10; ++i, ++split )
         {
-            List<Tightening> bounds = split->getBoundTightenings();
+            Vector<Tightening> bounds = split->getBoundTightenings();
 
             // Since no upper bounds known for any of the variables, no bounds
             TS_ASSERT_EQUALS( bounds.size(), 0U );
@@ -351,7 +351,7 @@ public:
 
         split = splits.begin();
 
-        List<Tightening> bounds = split->getBoundTightenings();
+        Vector<Tightening> bounds = split->getBoundTightenings();
 
         // Since no upper bounds known for any of the variables, no bounds
         TS_ASSERT_EQUALS( bounds.size(), 0U );
@@ -850,7 +850,7 @@ public:
         auto split = splits.begin();
         for ( unsigned i = 2; i < 5; ++i, ++split )
         {
-            List<Tightening> bounds = split->getBoundTightenings();
+            Vector<Tightening> bounds = split->getBoundTightenings();
 
             // For each split, there is a single LB element >= maxValueEliminated
             TS_ASSERT_EQUALS( bounds.size(), 1U );
@@ -933,7 +933,7 @@ public:
 
         split = splits.begin();
 
-        List<Tightening> bounds = split->getBoundTightenings();
+        Vector<Tightening> bounds = split->getBoundTightenings();
 
         // Check single bound f >= maxValueEliminated
         TS_ASSERT_EQUALS( bounds.size(), 1U );
@@ -1013,7 +1013,7 @@ public:
         // In the case f is no in the input elements, and variables were eliminated
         PiecewiseLinearCaseSplit validSplit = max.getValidCaseSplit();
 
-        List<Tightening> bounds = validSplit.getBoundTightenings();
+        Vector<Tightening> bounds = validSplit.getBoundTightenings();
 
         // Check single bound f >= maxValueEliminated
         TS_ASSERT_EQUALS( bounds.size(), 1U );
@@ -1189,7 +1189,7 @@ public:
 
         PiecewiseLinearCaseSplit validSplit = max.getValidCaseSplit();
 
-        List<Tightening> bounds = validSplit.getBoundTightenings();
+        Vector<Tightening> bounds = validSplit.getBoundTightenings();
 
         // Check 3 bounds
         TS_ASSERT_EQUALS( bounds.size(), 3U );
@@ -219,7 +219,7 @@ public:
 
     bool isActiveSplit( unsigned b, unsigned f, List<PiecewiseLinearCaseSplit>::iterator &split )
     {
-        List<Tightening> bounds = split->getBoundTightenings();
+        Vector<Tightening> bounds = split->getBoundTightenings();
 
         auto bound = bounds.begin();
         Tightening bound1 = *bound;
@@ -254,7 +254,7 @@ public:
 
     bool isInactiveSplit( unsigned b, unsigned f, List<PiecewiseLinearCaseSplit>::iterator &split )
     {
-        List<Tightening> bounds = split->getBoundTightenings();
+        Vector<Tightening> bounds = split->getBoundTightenings();
 
         auto bound = bounds.begin();
         Tightening bound1 = *bound;
@@ -319,7 +319,7 @@ public:
 
     bool isActiveSplitWithAux( unsigned b, unsigned aux, List<PiecewiseLinearCaseSplit>::iterator &split )
     {
-        List<Tightening> bounds = split->getBoundTightenings();
+        Vector<Tightening> bounds = split->getBoundTightenings();
 
         TS_ASSERT_EQUALS( bounds.size(), 2U );
 
@@ -571,7 +571,7 @@ public:
 
         Equation activeEquation;
 
-        List<Tightening> bounds = split.getBoundTightenings();
+        Vector<Tightening> bounds = split.getBoundTightenings();
 
         TS_ASSERT_EQUALS( bounds.size(), 1U );
         auto bound = bounds.begin();
@@ -617,7 +617,7 @@ public:
 
         Equation activeEquation;
 
-        List<Tightening> bounds = split.getBoundTightenings();
+        Vector<Tightening> bounds = split.getBoundTightenings();
 
         TS_ASSERT_EQUALS( bounds.size(), 2U );
         auto bound = bounds.begin();
@@ -759,6 +759,49 @@ public:
         TS_ASSERT_THROWS_NOTHING( delete relu2 );
     }
 
+    void test_bound_store()
+    {
+        unsigned b = 1;
+        unsigned f = 4;
+
+        MockTableau tableau;
+        tableau.setLowerBound( b, -5 );
+        tableau.setUpperBound( b, 5 );
+        tableau.setLowerBound( f, 0 );
+        tableau.setUpperBound( f, 5 );
+
+        ReluConstraint relu( b, f );
+        relu.notifyLowerBound( b, -10 );
+        relu.notifyUpperBound( b, 10 );
+        relu.registerAsWatcher( &tableau );
+        relu.registerBoundStore( &tableau );
+
+        // Bounds are read from the tableau
+        TS_ASSERT_EQUALS( relu.getLowerBound( b ), -5 );
+        TS_ASSERT_EQUALS( relu.getUpperBound( f ), 5 );
+        TS_ASSERT( !relu.phaseFixed() );
+
+        // The tableau stores a bound before notifying its watchers
+        tableau.setLowerBound( b, 1 );
+        relu.notifyLowerBound( b, 1 );
+        TS_ASSERT( relu.phaseFixed() );
+        TS_ASSERT_EQUALS( relu.getLowerBound( b ), 1 );
+
+        // A duplicate keeps a snapshot of the bounds
+        PiecewiseLinearConstraint *duplicate = relu.duplicateConstraint();
+        tableau.setLowerBound( b, 2 );
+        TS_ASSERT_EQUALS( relu.getLowerBound( b ), 2 );
+        TS_ASSERT_EQUALS( duplicate->getLowerBound( b ), 1 );
+        TS_ASSERT_EQUALS( duplicate->getUpperBound( b ), 5 );
+
+        // Restoring a state does not detach the constraint from the store
+        relu.restoreState( duplicate );
+        TS_ASSERT_EQUALS( relu.getLowerBound( b ), 2 );
+
+        relu.unregisterAsWatcher( &tableau );
+        TS_ASSERT_THROWS_NOTHING( delete duplicate );
+    }
+
     void test_eliminate_variable_active()
     {
         unsigned b = 1;
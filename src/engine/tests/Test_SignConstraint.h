@@ -237,7 +237,7 @@ public:
     bool isPositiveSplit( unsigned b, unsigned f,
                           List<PiecewiseLinearCaseSplit>::iterator &split )
     {
-        List<Tightening> bounds = split->getBoundTightenings();
+        Vector<Tightening> bounds = split->getBoundTightenings();
 
         auto bound = bounds.begin();
         Tightening bound1 = *bound;
@@ -268,7 +268,7 @@ public:
     bool isNegativeSplit( unsigned b, unsigned f,
                           List<PiecewiseLinearCaseSplit>::iterator &split )
     {
-        List<Tightening> bounds = split->getBoundTightenings();
+        Vector<Tightening> bounds = split->getBoundTightenings();
 
         auto bound = bounds.begin();
         Tightening bound1 = *bound;
@@ -552,7 +552,7 @@ public:
 
         Equation activeEquation;
 
-        List<Tightening> bounds = split.getBoundTightenings();
+        Vector<Tightening> bounds = split.getBoundTightenings();
 
         TS_ASSERT_EQUALS( bounds.size(), 2U );
         auto bound = bounds.begin();
@@ -599,7 +599,7 @@ public:
 
         Equation activeEquation;
 
-        List<Tightening> bounds = split.getBoundTightenings();
+        Vector<Tightening> bounds = split.getBoundTightenings();
 
         TS_ASSERT_EQUALS( bounds.size(), 2U );
         auto bound = bounds.begin();
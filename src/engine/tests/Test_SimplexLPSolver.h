@@ -0,0 +1,490 @@
+/*********************                                                        */
+/*! \file Test_SimplexLPSolver.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "CommonError.h"
+#include "FloatUtils.h"
+#include "MString.h"
+#include "MStringf.h"
+#include "MockErrno.h"
+#include "SimplexLPSolver.h"
+
+class SimplexLPSolverTestSuite : public CxxTest::TestSuite
+{
+public:
+    MockErrno *mockErrno;
+
+    void setUp()
+    {
+        TS_ASSERT( mockErrno = new MockErrno );
+    }
+
+    void tearDown()
+    {
+        TS_ASSERT_THROWS_NOTHING( delete mockErrno );
+    }
+
+    void test_optimize()
+    {
+        SimplexLPSolver solver;
+
+        solver.addVariable( "x", 0, 3 );
+        solver.addVariable( "y", 0, 3 );
+        solver.addVariable( "z", 0, 3 );
+
+        // x + y + z <= 5
+        List<ILPSolver::Term> contraint = {
+            ILPSolver::Term( 1, "x" ),
+            ILPSolver::Term( 1, "y" ),
+            ILPSolver::Term( 1, "z" ),
+        };
+
+        solver.addLeqConstraint( contraint, 5 );
+
+        // Cost: -x - 2y + z
+        List<ILPSolver::Term> cost = {
+            ILPSolver::Term( -1, "x" ),
+            ILPSolver::Term( -2, "y" ),
+            ILPSolver::Term( +1, "z" ),
+        };
+
+        solver.setCost( cost );
+
+        // Solve and extract
+        TS_ASSERT_THROWS_NOTHING( solver.solve() );
+
+        TS_ASSERT( solver.optimal() );
+        TS_ASSERT( solver.haveFeasibleSolution() );
+
+        Map<String, double> solution;
+        double costValue;
+
+        TS_ASSERT_THROWS_NOTHING( solver.extractSolution( solution, costValue ) );
+
+        TS_ASSERT( FloatUtils::areEqual( solution["x"], 2 ) );
+        TS_ASSERT( FloatUtils::areEqual( solution["y"], 3 ) );
+        TS_ASSERT( FloatUtils::areEqual( solution["z"], 0 ) );
+
+        TS_ASSERT( FloatUtils::areEqual( costValue, -8 ) );
+        TS_ASSERT( FloatUtils::areEqual( solver.getObjectiveBound(), -8 ) );
+    }
+
+    void test_infeasible_starting_point()
+    {
+        SimplexLPSolver solver;
+
+        solver.addVariable( "x", -10, 10 );
+        solver.addVariable( "y", -10, 10 );
+        solver.addVariable( "z", FloatUtils::negativeInfinity(), FloatUtils::infinity() );
+
+        // x + y >= 4
+        List<ILPSolver::Term> terms = {
+            ILPSolver::Term( 1, "x" ),
+            ILPSolver::Term( 1, "y" ),
+        };
+        solver.addGeqConstraint( terms, 4 );
+
+        // x - y = 1
+        terms = {
+            ILPSolver::Term( 1, "x" ),
+            ILPSolver::Term( -1, "y" ),
+        };
+        solver.addEqConstraint( terms, 1 );
+
+        // z - 2x = 0
+        terms = {
+            ILPSolver::Term( 1, "z" ),
+            ILPSolver::Term( -2, "x" ),
+        };
+        solver.addEqConstraint( terms, 0 );
+
+        // Minimize z, i.e. minimize x: x = 2.5, y = 1.5
+        solver.setCost( { ILPSolver::Term( 1, "z" ) } );
+        solver.solve();
+
+        TS_ASSERT( solver.optimal() );
+
+        Map<String, double> solution;
+        double costValue;
+        solver.extractSolution( solution, costValue );
+
+        TS_ASSERT( FloatUtils::areEqual( solution["x"], 2.5 ) );
+        TS_ASSERT( FloatUtils::areEqual( solution["y"], 1.5 ) );
+        TS_ASSERT( FloatUtils::areEqual( solution["z"], 5 ) );
+        TS_ASSERT( FloatUtils::areEqual( costValue, 5 ) );
+
+        // Maximize z: x = 10, y = 9
+        solver.setObjective( { ILPSolver::Term( 1, "z" ) } );
+        solver.solve();
+
+        TS_ASSERT( solver.optimal() );
+        solver.extractSolution( solution, costValue );
+
+        TS_ASSERT( FloatUtils::areEqual( solution["x"], 10 ) );
+        TS_ASSERT( FloatUtils::areEqual( solution["y"], 9 ) );
+        TS_ASSERT( FloatUtils::areEqual( costValue, 20 ) );
+    }
+
+    void test_infeasible()
+    {
+        SimplexLPSolver solver;
+
+        solver.addVariable( "x", 0, 1 );
+        solver.addVariable( "y", 0, 1 );
+
+        // x + y >= 3
+        List<ILPSolver::Term> terms = {
+            ILPSolver::Term( 1, "x" ),
+            ILPSolver::Term( 1, "y" ),
+        };
+        solver.addGeqConstraint( terms, 3 );
+
+        solver.setCost( { ILPSolver::Term( 1, "x" ) } );
+        solver.solve();
+
+        TS_ASSERT( solver.infeasbile() );
+        TS_ASSERT( !solver.optimal() );
+        TS_ASSERT( !solver.haveFeasibleSolution() );
+
+        // Relaxing the bounds restores feasibility
+        solver.setUpperBound( "x", 5 );
+        solver.solve();
+
+        TS_ASSERT( solver.optimal() );
+
+        Map<String, double> solution;
+        double costValue;
+        solver.extractSolution( solution, costValue );
+        TS_ASSERT( FloatUtils::areEqual( costValue, 2 ) );
+    }
+
+    void test_cutoff()
+    {
+        SimplexLPSolver solver;
+
+        solver.addVariable( "x", 0, 2 );
+        solver.addVariable( "y", 0, 2 );
+
+        // x + y <= 3
+        List<ILPSolver::Term> terms = {
+            ILPSolver::Term( 1, "x" ),
+            ILPSolver::Term( 1, "y" ),
+        };
+        solver.addLeqConstraint( terms, 3 );
+
+        // The maximal value of x + y is 3, below the cutoff
+        solver.setCutoff( 4 );
+        solver.setObjective( terms );
+        solver.solve();
+
+        TS_ASSERT( solver.cutoffOccurred() );
+        TS_ASSERT( !solver.optimal() );
+
+        // Above the cutoff
+        solver.setCutoff( 2 );
+        solver.solve();
+
+        TS_ASSERT( !solver.cutoffOccurred() );
+        TS_ASSERT( solver.optimal() );
+
+        Map<String, double> solution;
+        double objectiveValue;
+        solver.extractSolution( solution, objectiveValue );
+        TS_ASSERT( FloatUtils::areEqual( objectiveValue, 3 ) );
+    }
+
+    void test_warm_start()
+    {
+        SimplexLPSolver solver;
+
+        // A chain: x0 in [-1, 1], x(i+1) = x(i) + 1
+        unsigned chainLength = 20;
+        solver.addVariable( "x0", -1, 1 );
+        for ( unsigned i = 1; i < chainLength; ++i )
+        {
+            String current = Stringf( "x%u", i );
+            solver.addVariable( current, -100, 100 );
+
+            List<ILPSolver::Term> terms = {
+                ILPSolver::Term( 1, current ),
+                ILPSolver::Term( -1, Stringf( "x%u", i - 1 ) ),
+            };
+            solver.addEqConstraint( terms, 1 );
+        }
+
+        String last = Stringf( "x%u", chainLength - 1 );
+        Map<String, double> solution;
+        double value;
+
+        solver.setObjective( { ILPSolver::Term( 1, last ) } );
+        solver.solve();
+        TS_ASSERT( solver.optimal() );
+        solver.extractSolution( solution, value );
+        TS_ASSERT( FloatUtils::areEqual( value, chainLength ) );
+
+        unsigned coldIterations = solver.getNumberOfIterations();
+
+        // Optimizing the same objective again requires no pivots
+        solver.reset();
+        solver.solve();
+        TS_ASSERT( solver.optimal() );
+        solver.extractSolution( solution, value );
+        TS_ASSERT( FloatUtils::areEqual( value, chainLength ) );
+        TS_ASSERT( solver.getNumberOfIterations() <= coldIterations );
+        TS_ASSERT_EQUALS( solver.getNumberOfIterations(), 0U );
+
+        // Tightening a bound and changing the objective
+        solver.setUpperBound( "x0", 0.5 );
+        solver.setCost( { ILPSolver::Term( 1, last ) } );
+        solver.solve();
+        TS_ASSERT( solver.optimal() );
+        solver.extractSolution( solution, value );
+        TS_ASSERT( FloatUtils::areEqual( value, chainLength - 2 ) );
+
+        solver.setObjective( { ILPSolver::Term( 1, last ) } );
+        solver.solve();
+        TS_ASSERT( solver.optimal() );
+        solver.extractSolution( solution, value );
+        TS_ASSERT( FloatUtils::areEqual( value, chainLength - 0.5 ) );
+
+        // Adding to the model keeps the basis
+        solver.addVariable( "y", 0, 10 );
+        List<ILPSolver::Term> terms = {
+            ILPSolver::Term( 1, "y" ),
+            ILPSolver::Term( 1, last ),
+        };
+        solver.addLeqConstraint( terms, chainLength + 1 );
+
+        solver.setObjective( { ILPSolver::Term( 1, "y" ) } );
+        solver.solve();
+        TS_ASSERT( solver.optimal() );
+        solver.extractSolution( solution, value );
+        TS_ASSERT( FloatUtils::areEqual( value, 3 ) );
+        TS_ASSERT( FloatUtils::areEqual( solution[last], chainLength - 2 ) );
+
+        // Starting from scratch
+        solver.resetModel();
+        solver.addVariable( "x", 0, 1 );
+        solver.setObjective( { ILPSolver::Term( 1, "x" ) } );
+        solver.solve();
+        TS_ASSERT( solver.optimal() );
+        solver.extractSolution( solution, value );
+        TS_ASSERT( FloatUtils::areEqual( value, 1 ) );
+        TS_ASSERT_EQUALS( solution.size(), 1U );
+    }
+
+    void buildDualTestModel( SimplexLPSolver &solver )
+    {
+        // 0 <= x, y <= 10, x + 2y <= 14, 3x - y >= 0, x - y <= 2
+        solver.addVariable( "x", 0, 10 );
+        solver.addVariable( "y", 0, 10 );
+        solver.addLeqConstraint( { ILPSolver::Term( 1, "x" ), ILPSolver::Term( 2, "y" ) }, 14 );
+        solver.addGeqConstraint( { ILPSolver::Term( 3, "x" ), ILPSolver::Term( -1, "y" ) }, 0 );
+        solver.addLeqConstraint( { ILPSolver::Term( 1, "x" ), ILPSolver::Term( -1, "y" ) }, 2 );
+        solver.setObjective( { ILPSolver::Term( 3, "x" ), ILPSolver::Term( 4, "y" ) } );
+    }
+
+    void test_dual_reoptimization()
+    {
+        SimplexLPSolver solver;
+        buildDualTestModel( solver );
+
+        Map<String, double> solution;
+        double value;
+
+        // The optimum is x = 6, y = 4
+        solver.solve();
+        TS_ASSERT( solver.optimal() );
+        solver.extractSolution( solution, value );
+        TS_ASSERT( FloatUtils::areEqual( value, 34 ) );
+        TS_ASSERT( FloatUtils::areEqual( solution["x"], 6 ) );
+        TS_ASSERT( FloatUtils::areEqual( solution["y"], 4 ) );
+
+        // Cutting off the optimum leaves the basis dual feasible
+        solver.setUpperBound( "x", 4 );
+        solver.solve();
+        TS_ASSERT( solver.optimal() );
+        solver.extractSolution( solution, value );
+        TS_ASSERT( FloatUtils::areEqual( value, 32 ) );
+        TS_ASSERT( FloatUtils::areEqual( solution["x"], 4 ) );
+        TS_ASSERT( FloatUtils::areEqual( solution["y"], 5 ) );
+        unsigned warmIterations = solver.getNumberOfIterations();
+
+        SimplexLPSolver cold;
+        buildDualTestModel( cold );
+        cold.setUpperBound( "x", 4 );
+        cold.solve();
+        TS_ASSERT( cold.optimal() );
+        cold.extractSolution( solution, value );
+        TS_ASSERT( FloatUtils::areEqual( value, 32 ) );
+        TS_ASSERT( warmIterations < cold.getNumberOfIterations() );
+
+        // Infeasibility is detected from the warm basis too
+        solver.setLowerBound( "y", 7 );
+        solver.solve();
+        TS_ASSERT( solver.infeasbile() );
+
+        // And relaxing the bounds again recovers the original optimum
+        solver.setLowerBound( "y", 0 );
+        solver.setUpperBound( "x", 10 );
+        solver.solve();
+        TS_ASSERT( solver.optimal() );
+        solver.extractSolution( solution, value );
+        TS_ASSERT( FloatUtils::areEqual( value, 34 ) );
+    }
+
+    void test_unbounded()
+    {
+        SimplexLPSolver solver;
+
+        solver.addVariable( "x", 0, FloatUtils::infinity() );
+        solver.addVariable( "y", 0, 1 );
+
+        // x - y >= 0
+        List<ILPSolver::Term> terms = {
+            ILPSolver::Term( 1, "x" ),
+            ILPSolver::Term( -1, "y" ),
+        };
+        solver.addGeqConstraint( terms, 0 );
+
+        solver.setObjective( { ILPSolver::Term( 1, "x" ) } );
+        solver.solve();
+
+        TS_ASSERT( !solver.optimal() );
+        TS_ASSERT( !solver.infeasbile() );
+        TS_ASSERT( !FloatUtils::isFinite( solver.getObjectiveBound() ) );
+    }
+
+    void test_milp()
+    {
+        SimplexLPSolver solver;
+
+        // A knapsack: maximize 5a + 4b + 3c s.t. 2a + 3b + c <= 4,
+        // whose relaxation is fractional
+        solver.addVariable( "a", 0, 1, ILPSolver::BINARY );
+        solver.addVariable( "b", 0, 1, ILPSolver::BINARY );
+        solver.addVariable( "c", 0, 1, ILPSolver::BINARY );
+
+        List<ILPSolver::Term> terms = {
+            ILPSolver::Term( 2, "a" ),
+            ILPSolver::Term( 3, "b" ),
+            ILPSolver::Term( 1, "c" ),
+        };
+        solver.addLeqConstraint( terms, 4 );
+
+        terms = {
+            ILPSolver::Term( 5, "a" ),
+            ILPSolver::Term( 4, "b" ),
+            ILPSolver::Term( 3, "c" ),
+        };
+        solver.setObjective( terms );
+        solver.solve();
+
+        TS_ASSERT( solver.optimal() );
+
+        Map<String, double> solution;
+        double objectiveValue;
+        solver.extractSolution( solution, objectiveValue );
+
+        TS_ASSERT( FloatUtils::areEqual( objectiveValue, 8 ) );
+        TS_ASSERT( FloatUtils::areEqual( solution["a"], 1 ) );
+        TS_ASSERT( FloatUtils::areEqual( solution["b"], 0 ) );
+        TS_ASSERT( FloatUtils::areEqual( solution["c"], 1 ) );
+        TS_ASSERT( FloatUtils::areEqual( solver.getObjectiveBound(), 8 ) );
+
+        // With a cutoff above the optimum
+        solver.setCutoff( 9 );
+        solver.solve();
+        TS_ASSERT( solver.cutoffOccurred() );
+    }
+
+    void test_milp_integer_infeasible()
+    {
+        SimplexLPSolver solver;
+
+        // x = 0.5a, 0.2 <= x <= 0.3: feasible only for fractional a
+        solver.addVariable( "x", 0.2, 0.3 );
+        solver.addVariable( "a", 0, 1, ILPSolver::BINARY );
+
+        List<ILPSolver::Term> terms = {
+            ILPSolver::Term( 1, "x" ),
+            ILPSolver::Term( -0.5, "a" ),
+        };
+        solver.addEqConstraint( terms, 0 );
+
+        solver.solve();
+
+        TS_ASSERT( solver.infeasbile() );
+        TS_ASSERT( !solver.haveFeasibleSolution() );
+
+        // Relaxing x
+        solver.setUpperBound( "x", 1 );
+        solver.solve();
+
+        TS_ASSERT( solver.haveFeasibleSolution() );
+
+        Map<String, double> solution;
+        double dontCare;
+        solver.extractSolution( solution, dontCare );
+        TS_ASSERT( FloatUtils::areEqual( solution["a"], 1 ) );
+        TS_ASSERT( FloatUtils::areEqual( solution["x"], 0.5 ) );
+    }
+
+    void test_timeout()
+    {
+        SimplexLPSolver solver;
+
+        solver.addVariable( "x", 0, 1 );
+        solver.addVariable( "y", 0, 1 );
+
+        List<ILPSolver::Term> terms = {
+            ILPSolver::Term( 1, "x" ),
+            ILPSolver::Term( 1, "y" ),
+        };
+        solver.addLeqConstraint( terms, 1 );
+        solver.setObjective( terms );
+
+        // A timeout yields a sound bound
+        solver.setTimeLimit( 0 );
+        solver.solve();
+        TS_ASSERT( solver.timeout() );
+        TS_ASSERT( FloatUtils::areEqual( solver.getObjectiveBound(), FloatUtils::infinity() ) );
+
+        solver.setTimeLimit( FloatUtils::infinity() );
+        solver.solve();
+        TS_ASSERT( solver.optimal() );
+    }
+
+    void test_unknown_variable()
+    {
+        SimplexLPSolver solver;
+
+        solver.addVariable( "x", 0, 1 );
+
+        TS_ASSERT_THROWS_EQUALS( solver.setUpperBound( "y", 1 ),
+                                 const CommonError &e,
+                                 e.getCode(),
+                                 CommonError::KEY_DOESNT_EXIST_IN_MAP );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -15,6 +15,7 @@
 
 #include <cxxtest/TestSuite.h>
 
+#include "FloatUtils.h"
 #include "InputQuery.h"
 #include "MockEngine.h"
 #include "MockErrno.h"
@@ -22,6 +23,7 @@
 #include "PiecewiseLinearConstraint.h"
 #include "ReluConstraint.h"
 #include "SmtCore.h"
+#include "Statistics.h"
 
 #include <string.h>
 
@@ -576,6 +578,138 @@ public:
         TS_ASSERT_THROWS_NOTHING( smtCore.popSplit() );
     }
 
+    void test_replay_smt_stack_entries()
+    {
+        ReluConstraint relu1( 0, 1 );
+        ReluConstraint relu2( 2, 3 );
+
+        SmtCore smtCore( engine );
+        for ( ReluConstraint *relu : { &relu1, &relu2 } )
+        {
+            for ( unsigned i = 0; i < ( unsigned ) Options::get()->getInt( Options::CONSTRAINT_VIOLATION_THRESHOLD ); ++i )
+                smtCore.reportViolatedConstraint( relu );
+
+            TS_ASSERT_THROWS_NOTHING( smtCore.performSplit() );
+        }
+
+        SmtState smtState;
+        smtCore.storeSmtState( smtState );
+        TS_ASSERT_EQUALS( smtState._stack.size(), 2U );
+
+        // Replaying copies the entries, which remain owned by the state
+        SmtCore otherSmtCore( engine );
+        for ( const auto &stackEntry : smtState._stack )
+            TS_ASSERT_THROWS_NOTHING( otherSmtCore.replaySmtStackEntry( stackEntry ) );
+
+        TS_ASSERT_EQUALS( otherSmtCore.getStackDepth(), 2U );
+        TS_ASSERT( ( *smtState._stack.begin() )->_activeSplit ==
+                   *( relu1.getCaseSplits().begin() ) );
+        TS_ASSERT( ( *( ++smtState._stack.begin() ) )->_activeSplit ==
+                   *( relu2.getCaseSplits().begin() ) );
+
+        List<PiecewiseLinearCaseSplit> allSplitsSoFar;
+        TS_ASSERT_THROWS_NOTHING( otherSmtCore.allSplitsSoFar( allSplitsSoFar ) );
+        TS_ASSERT_EQUALS( allSplitsSoFar.size(), 2U );
+
+        clearSmtState( smtState );
+    }
+
+    void test_backjump_with_learned_clauses()
+    {
+        SmtCore smtCore( engine );
+
+        // Conflict analysis requires the states to be stored on the trail
+        engine->stateStoredOnTrail = true;
+
+        ReluConstraint relu1( 0, 1 );
+        ReluConstraint relu2( 2, 3 );
+        ReluConstraint relu3( 4, 5 );
+
+        // Split on all three constraints, inactive phase first
+        for ( ReluConstraint *relu : { &relu1, &relu2, &relu3 } )
+        {
+            for ( unsigned i = 0; i < ( unsigned ) Options::get()->getInt( Options::CONSTRAINT_VIOLATION_THRESHOLD ); ++i )
+                smtCore.reportViolatedConstraint( relu );
+
+            TS_ASSERT_THROWS_NOTHING( smtCore.performSplit() );
+            TS_ASSERT_EQUALS( engine->lastDecisionLevel, smtCore.getStackDepth() );
+        }
+
+        TS_ASSERT( smtCore.conflictAnalysisEnabled() );
+        TS_ASSERT_EQUALS( smtCore.getStackDepth(), 3U );
+
+        // A conflict that depends on the splits of relu1 and relu3:
+        // backjump to level 3, and try the active phase of relu3
+        List<SmtCore::ExplanationBound> explanation;
+        explanation.append( { Tightening( 0, 0, Tightening::UB ), 1 } );
+        explanation.append( { Tightening( 4, 0, Tightening::UB ), 3 } );
+        smtCore.analyzeConflict( explanation );
+
+        TS_ASSERT( smtCore.popSplit() );
+        TS_ASSERT_EQUALS( smtCore.getStackDepth(), 3U );
+        TS_ASSERT_EQUALS( engine->lastDecisionLevel, 3U );
+
+        // The active phase of relu3 conflicts with the split of relu1
+        // as well. Backtracking to level 2 and splitting relu2
+        // differently does not help: the learned clauses imply both
+        // phases of relu3, and so the pop goes back to level 1.
+        explanation.clear();
+        explanation.append( { Tightening( 0, 0, Tightening::UB ), 1 } );
+        explanation.append( { Tightening( 4, 0, Tightening::LB ), 3 } );
+        smtCore.analyzeConflict( explanation );
+
+        TS_ASSERT( smtCore.popSplit() );
+        TS_ASSERT_EQUALS( smtCore.getStackDepth(), 1U );
+        TS_ASSERT_EQUALS( engine->lastDecisionLevel, 1U );
+
+        List<PiecewiseLinearCaseSplit> splits;
+        smtCore.allSplitsSoFar( splits );
+        TS_ASSERT_EQUALS( splits.size(), 1U );
+        TS_ASSERT_EQUALS( *splits.begin(), relu1.getCaseSplit( RELU_PHASE_ACTIVE ) );
+
+        // A conflict that depends on the whole stack ends the search
+        explanation.clear();
+        explanation.append( { Tightening( 0, 0, Tightening::LB ), 1 } );
+        smtCore.analyzeConflict( explanation );
+        TS_ASSERT( !smtCore.popSplit() );
+    }
+
+    void test_search_progress()
+    {
+        SmtCore smtCore( engine );
+        Statistics statistics;
+        smtCore.setStatistics( &statistics );
+
+        ReluConstraint relu1( 0, 1 );
+        ReluConstraint relu2( 2, 3 );
+        ReluConstraint relu3( 4, 5 );
+
+        for ( ReluConstraint *relu : { &relu1, &relu2, &relu3 } )
+        {
+            for ( unsigned i = 0; i < ( unsigned ) Options::get()->getInt( Options::CONSTRAINT_VIOLATION_THRESHOLD ); ++i )
+                smtCore.reportViolatedConstraint( relu );
+
+            TS_ASSERT_THROWS_NOTHING( smtCore.performSplit() );
+        }
+
+        TS_ASSERT_EQUALS( smtCore.getSearchProgress(), 0 );
+
+        // The first phase of relu3 is done: 1/8 of the tree
+        TS_ASSERT( smtCore.popSplit() );
+        TS_ASSERT( FloatUtils::areEqual( smtCore.getSearchProgress(), 0.125 ) );
+        TS_ASSERT( FloatUtils::areEqual( statistics.getSearchProgress(), 0.125 ) );
+
+        // Both phases of relu3 under the first phase of relu2 are done
+        TS_ASSERT( smtCore.popSplit() );
+        TS_ASSERT_EQUALS( smtCore.getStackDepth(), 2U );
+        TS_ASSERT( FloatUtils::areEqual( smtCore.getSearchProgress(), 0.25 ) );
+
+        TS_ASSERT( smtCore.popSplit() );
+        TS_ASSERT_EQUALS( smtCore.getStackDepth(), 1U );
+        TS_ASSERT( FloatUtils::areEqual( smtCore.getSearchProgress(), 0.5 ) );
+        TS_ASSERT( FloatUtils::areEqual( statistics.getSearchProgress(), 0.5 ) );
+    }
+
     void clearSmtState( SmtState &smtState )
     {
         for ( const auto &stackEntry : smtState._stack )
@@ -20,9 +20,11 @@
 #include "MockCostFunctionManager.h"
 #include "MockErrno.h"
 #include "MarabouError.h"
+#include "SparseUnsortedArrays.h"
 #include "Tableau.h"
 #include "TableauRow.h"
 #include "TableauState.h"
+#include "Tightening.h"
 
 #include <string.h>
 
@@ -53,6 +55,56 @@ public:
     }
 };
 
+class MockBatchWatcher : public ITableau::VariableWatcher
+{
+public:
+    MockBatchWatcher()
+        : numBatches( 0 )
+        , numLowerBoundNotifications( 0 )
+        , numUpperBoundNotifications( 0 )
+    {
+    }
+
+    unsigned numBatches;
+    Vector<unsigned> lastBatchVariables;
+    Map<unsigned, double> lastBatchLowerBounds;
+    Map<unsigned, double> lastBatchUpperBounds;
+    void notifyBounds( const ITableau::BoundUpdates &updates )
+    {
+        ++numBatches;
+        lastBatchVariables = updates._variables;
+        lastBatchLowerBounds.clear();
+        lastBatchUpperBounds.clear();
+
+        for ( const auto &variable : updates._variables )
+        {
+            if ( updates._changed[variable] & ITableau::BoundUpdates::LOWER )
+                lastBatchLowerBounds[variable] = updates._lowerBounds[variable];
+            if ( updates._changed[variable] & ITableau::BoundUpdates::UPPER )
+                lastBatchUpperBounds[variable] = updates._upperBounds[variable];
+        }
+    }
+
+    unsigned numLowerBoundNotifications;
+    void notifyLowerBound( unsigned /* variable */, double /* bound */ )
+    {
+        ++numLowerBoundNotifications;
+    }
+
+    unsigned numUpperBoundNotifications;
+    void notifyUpperBound( unsigned /* variable */, double /* bound */ )
+    {
+        ++numUpperBoundNotifications;
+    }
+
+    // The number of batches seen when each variable's value last changed
+    Map<unsigned, unsigned> batchesBeforeValue;
+    void notifyVariableValue( unsigned variable, double /* value */ )
+    {
+        batchesBeforeValue[variable] = numBatches;
+    }
+};
+
 class TableauTestSuite : public CxxTest::TestSuite
 {
 public:
@@ -126,6 +178,49 @@ public:
         TS_ASSERT_THROWS_NOTHING( delete tableau );
     }
 
+    void test_set_sparse_constraint_matrix()
+    {
+        Tableau *tableau = NULL;
+
+        TS_ASSERT( tableau = new Tableau );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setDimensions( 3, 7 ) );
+
+        double A[] = {
+            3, 2, 1, 2, 1, 0, 0,
+            1, 1, 1, 1, 0, 1, 0,
+            4, 3, 3, 4, 0, 0, 1,
+        };
+
+        // The rows are built out of order, as from the addends of equations
+        SparseUnsortedArrays rows;
+        rows.initializeToEmpty( 3, 7 );
+        for ( unsigned i = 0; i < 3; ++i )
+        {
+            for ( unsigned j = 7; j > 0; --j )
+            {
+                if ( A[i*7 + j - 1] != 0 )
+                    rows.append( i, j - 1, A[i*7 + j - 1] );
+            }
+        }
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setConstraintMatrix( &rows ) );
+
+        for ( unsigned j = 0; j < 7; ++j )
+        {
+            const double *column = tableau->getAColumn( j );
+            for ( unsigned i = 0; i < 3; ++i )
+            {
+                TS_ASSERT_EQUALS( column[i], A[i*7 + j] );
+                TS_ASSERT_EQUALS( tableau->getSparseA()->get( i, j ), A[i*7 + j] );
+                TS_ASSERT_EQUALS( tableau->getSparseAColumn( j )->get( i ), A[i*7 + j] );
+                TS_ASSERT_EQUALS( tableau->getSparseARow( i )->get( j ), A[i*7 + j] );
+            }
+        }
+
+        TS_ASSERT_THROWS_NOTHING( delete tableau );
+    }
+
     void test_initalize_basis_get_value()
     {
         Tableau *tableau = NULL;
@@ -1122,6 +1217,59 @@ public:
         TS_ASSERT_THROWS_NOTHING( delete tableau );
     }
 
+    void test_store_and_restore_shares_matrix()
+    {
+        Tableau *tableau = NULL;
+        MockCostFunctionManager costFunctionManager;
+
+        TS_ASSERT( tableau = new Tableau );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setDimensions( 3, 7 ) );
+        tableau->registerCostFunctionManager( &costFunctionManager );
+        initializeTableauValues( *tableau );
+
+        for ( unsigned i = 0; i < 7; ++i )
+        {
+            TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( i, 0 ) );
+            TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( i, 500 ) );
+        }
+
+        List<unsigned> basics = { 4, 5, 6 };
+        TS_ASSERT_THROWS_NOTHING( tableau->initializeTableau( basics ) );
+
+        // Storing the state does not copy the matrix
+        TableauState *tableauState = NULL;
+        TS_ASSERT( tableauState = new TableauState );
+        TS_ASSERT_THROWS_NOTHING( tableau->storeState( *tableauState ) );
+        TS_ASSERT_EQUALS( tableauState->_matrix.use_count(), 2 );
+
+        // Adding an equation detaches the tableau's matrix
+        Equation equation;
+        equation.addAddend( 2, 1 );
+        equation.addAddend( -4, 2 );
+        equation.setScalar( 5 );
+        TS_ASSERT_THROWS_NOTHING( tableau->addEquation( equation ) );
+
+        TS_ASSERT_EQUALS( tableau->getM(), 4U );
+        TS_ASSERT_EQUALS( tableauState->_matrix.use_count(), 1 );
+        TS_ASSERT_EQUALS( tableauState->_matrix->_m, 3U );
+        TS_ASSERT_EQUALS( tableauState->_matrix->_n, 7U );
+
+        // Restoring brings back the original matrix, shared again
+        TS_ASSERT_THROWS_NOTHING( tableau->restoreState( *tableauState ) );
+        TS_ASSERT_EQUALS( tableau->getM(), 3U );
+        TS_ASSERT_EQUALS( tableau->getN(), 7U );
+        TS_ASSERT_EQUALS( tableauState->_matrix.use_count(), 2 );
+
+        double expectedColumn2[] = { 1, 1, 3 };
+        const double *column = tableau->getAColumn( 2 );
+        for ( unsigned i = 0; i < 3; ++i )
+            TS_ASSERT_EQUALS( column[i], expectedColumn2[i] );
+
+        TS_ASSERT_THROWS_NOTHING( delete tableauState );
+        TS_ASSERT_THROWS_NOTHING( delete tableau );
+    }
+
     void test_add_equation()
     {
         Tableau *tableau = NULL;
@@ -1356,6 +1504,335 @@ public:
         TS_ASSERT_THROWS_NOTHING( delete tableau );
     }
 
+    void test_apply_tightenings()
+    {
+        Tableau *tableau = NULL;
+        MockCostFunctionManager costFunctionManager;
+
+        TS_ASSERT( tableau = new Tableau );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setDimensions( 3, 7 ) );
+        tableau->registerCostFunctionManager( &costFunctionManager );
+        initializeTableauValues( *tableau );
+
+        for ( unsigned i = 0; i < 4; ++i )
+        {
+            TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( i, 1 ) );
+            TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( i, 10 ) );
+        }
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 4, 218 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 4, 228 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 5, 100 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 5, 114 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 6, 400 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 6, 402 ) );
+
+        List<unsigned> basics = { 4, 5, 6 };
+        TS_ASSERT_THROWS_NOTHING( tableau->initializeTableau( basics ) );
+
+        MockBatchWatcher globalWatcher;
+        MockBatchWatcher watcherOfX1;
+        MockBatchWatcher watcherOfX3;
+        tableau->registerToWatchAllVariables( &globalWatcher );
+        tableau->registerToWatchVariable( &watcherOfX1, 1 );
+        tableau->registerToWatchVariable( &watcherOfX3, 3 );
+
+        List<Tightening> tightenings = {
+            Tightening( 1, 3, Tightening::LB ),
+            Tightening( 1, 4, Tightening::LB ),
+            Tightening( 1, 12, Tightening::UB ),
+            Tightening( 2, 8, Tightening::UB ),
+            Tightening( 1, 2, Tightening::LB ),
+            Tightening( 3, 0.5, Tightening::LB ),
+        };
+
+        unsigned numTightenedBounds = 0;
+        TS_ASSERT_THROWS_NOTHING( numTightenedBounds = tableau->applyTightenings( tightenings ) );
+        TS_ASSERT_EQUALS( numTightenedBounds, 3U );
+
+        // The bounds and assignment are as if tightened one by one
+        TS_ASSERT_EQUALS( tableau->getLowerBound( 1 ), 4 );
+        TS_ASSERT_EQUALS( tableau->getUpperBound( 1 ), 10 );
+        TS_ASSERT_EQUALS( tableau->getValue( 1 ), 4.0 );
+        TS_ASSERT_EQUALS( tableau->getUpperBound( 2 ), 8 );
+        TS_ASSERT_EQUALS( tableau->getLowerBound( 3 ), 1 );
+
+        // The global watcher sees a single batch with the final bounds
+        TS_ASSERT_EQUALS( globalWatcher.numBatches, 1U );
+        TS_ASSERT( globalWatcher.lastBatchVariables == Vector<unsigned>( { 1, 2 } ) );
+        TS_ASSERT_EQUALS( globalWatcher.lastBatchLowerBounds.size(), 1U );
+        TS_ASSERT_EQUALS( globalWatcher.lastBatchLowerBounds[1], 4.0 );
+        TS_ASSERT_EQUALS( globalWatcher.lastBatchUpperBounds.size(), 1U );
+        TS_ASSERT_EQUALS( globalWatcher.lastBatchUpperBounds[2], 8.0 );
+        TS_ASSERT_EQUALS( globalWatcher.numLowerBoundNotifications, 0U );
+
+        // Watchers of a variable hear once about each of its changed bounds
+        TS_ASSERT_EQUALS( watcherOfX1.numLowerBoundNotifications, 1U );
+        TS_ASSERT_EQUALS( watcherOfX1.numUpperBoundNotifications, 0U );
+        TS_ASSERT_EQUALS( watcherOfX3.numLowerBoundNotifications, 0U );
+
+        // The new bounds are reported before x1 is moved to its new lower bound
+        TS_ASSERT( globalWatcher.batchesBeforeValue.exists( 1 ) );
+        TS_ASSERT_EQUALS( globalWatcher.batchesBeforeValue[1], 1U );
+
+        // A batch without tightenings is not reported
+        TS_ASSERT_EQUALS( tableau->applyTightenings( tightenings ), 0U );
+        TS_ASSERT_EQUALS( globalWatcher.numBatches, 1U );
+        TS_ASSERT_EQUALS( watcherOfX1.numLowerBoundNotifications, 1U );
+
+        TS_ASSERT_THROWS_NOTHING( delete tableau );
+    }
+
+    void test_bound_trail()
+    {
+        Tableau *tableau = NULL;
+        MockCostFunctionManager costFunctionManager;
+
+        TS_ASSERT( tableau = new Tableau );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setDimensions( 3, 7 ) );
+        tableau->registerCostFunctionManager( &costFunctionManager );
+        initializeTableauValues( *tableau );
+
+        for ( unsigned i = 0; i < 4; ++i )
+        {
+            TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( i, 1 ) );
+            TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( i, 10 ) );
+        }
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 4, 218 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 4, 228 ) );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 5, 100 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 5, 114 ) );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 6, 400 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 6, 402 ) );
+
+        List<unsigned> basics = { 4, 5, 6 };
+        TS_ASSERT_THROWS_NOTHING( tableau->initializeTableau( basics ) );
+
+        // Nothing is recorded while the trail is disabled
+        TS_ASSERT( !tableau->boundTrailEnabled() );
+        TS_ASSERT_THROWS_NOTHING( tableau->tightenUpperBound( 0, 9 ) );
+        TS_ASSERT_EQUALS( tableau->getBoundTrailSize(), 0U );
+
+        tableau->setBoundTrailEnabled( true );
+        TS_ASSERT( tableau->boundTrailEnabled() );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->tightenLowerBound( 1, 4 ) );
+        unsigned position = tableau->getBoundTrailSize();
+        TS_ASSERT_EQUALS( position, 1U );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->tightenUpperBound( 1, 8 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->tightenLowerBound( 1, 5 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->tightenLowerBound( 5, 111 ) );
+        TS_ASSERT_EQUALS( tableau->getBoundTrailSize(), 4U );
+
+        TS_ASSERT_EQUALS( tableau->getLowerBound( 1 ), 5 );
+        TS_ASSERT_EQUALS( tableau->getUpperBound( 1 ), 8 );
+        TS_ASSERT_EQUALS( tableau->getLowerBound( 5 ), 111 );
+
+        // Rolling back restores the bounds, but keeps the assignment
+        TS_ASSERT_THROWS_NOTHING( tableau->undoBoundTrail( position ) );
+        TS_ASSERT_EQUALS( tableau->getBoundTrailSize(), position );
+
+        TS_ASSERT_EQUALS( tableau->getLowerBound( 1 ), 4 );
+        TS_ASSERT_EQUALS( tableau->getUpperBound( 1 ), 10 );
+        TS_ASSERT_EQUALS( tableau->getValue( 1 ), 5.0 );
+        TS_ASSERT_EQUALS( tableau->getLowerBound( 5 ), 100 );
+        TS_ASSERT_EQUALS( tableau->getUpperBound( 0 ), 9 );
+
+        // A non-basic variable pushed past its restored bounds is moved back
+        TS_ASSERT_THROWS_NOTHING( tableau->tightenLowerBound( 1, 12 ) );
+        TS_ASSERT_EQUALS( tableau->getValue( 1 ), 12.0 );
+        TS_ASSERT_THROWS_NOTHING( tableau->undoBoundTrail( position ) );
+        TS_ASSERT_EQUALS( tableau->getValue( 1 ), 10.0 );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->undoBoundTrail( 0 ) );
+        TS_ASSERT_EQUALS( tableau->getLowerBound( 1 ), 1 );
+
+        tableau->tightenUpperBound( 2, 5 );
+        TS_ASSERT_EQUALS( tableau->getBoundTrailSize(), 1U );
+        tableau->clearBoundTrail();
+        TS_ASSERT_EQUALS( tableau->getBoundTrailSize(), 0U );
+        TS_ASSERT_EQUALS( tableau->getUpperBound( 2 ), 5 );
+
+        TS_ASSERT_THROWS_NOTHING( delete tableau );
+    }
+
+    void test_bound_decision_levels()
+    {
+        Tableau *tableau = NULL;
+        MockCostFunctionManager costFunctionManager;
+
+        TS_ASSERT( tableau = new Tableau );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setDimensions( 3, 7 ) );
+        tableau->registerCostFunctionManager( &costFunctionManager );
+        initializeTableauValues( *tableau );
+
+        for ( unsigned i = 0; i < 4; ++i )
+        {
+            TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( i, 1 ) );
+            TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( i, 10 ) );
+        }
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 4, 218 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 4, 228 ) );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 5, 100 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 5, 114 ) );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 6, 400 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 6, 402 ) );
+
+        List<unsigned> basics = { 4, 5, 6 };
+        TS_ASSERT_THROWS_NOTHING( tableau->initializeTableau( basics ) );
+
+        TS_ASSERT_EQUALS( tableau->getDecisionLevel(), 0U );
+        TS_ASSERT_EQUALS( tableau->getLowerBoundLevel( 1 ), 0U );
+
+        tableau->setBoundTrailEnabled( true );
+
+        tableau->setDecisionLevel( 1 );
+        unsigned position = tableau->getBoundTrailSize();
+        TS_ASSERT_THROWS_NOTHING( tableau->tightenLowerBound( 1, 4 ) );
+
+        tableau->setDecisionLevel( 2 );
+        TS_ASSERT_THROWS_NOTHING( tableau->tightenLowerBound( 1, 5 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->tightenUpperBound( 2, 7 ) );
+
+        // A bound that is not tightened keeps its level
+        TS_ASSERT_THROWS_NOTHING( tableau->tightenUpperBound( 1, 12 ) );
+
+        TS_ASSERT_EQUALS( tableau->getLowerBoundLevel( 1 ), 2U );
+        TS_ASSERT_EQUALS( tableau->getUpperBoundLevel( 1 ), 0U );
+        TS_ASSERT_EQUALS( tableau->getUpperBoundLevel( 2 ), 2U );
+        TS_ASSERT_EQUALS( tableau->getLowerBoundLevel( 2 ), 0U );
+
+        // Lowering the decision level caps the levels of the bounds
+        tableau->setDecisionLevel( 1 );
+        TS_ASSERT_EQUALS( tableau->getLowerBoundLevel( 1 ), 1U );
+        TS_ASSERT_EQUALS( tableau->getUpperBoundLevel( 2 ), 1U );
+
+        // Rolling back the trail restores the levels of the bounds
+        TS_ASSERT_THROWS_NOTHING( tableau->undoBoundTrail( position ) );
+        TS_ASSERT_EQUALS( tableau->getLowerBound( 1 ), 1 );
+        TS_ASSERT_EQUALS( tableau->getLowerBoundLevel( 1 ), 0U );
+        TS_ASSERT_EQUALS( tableau->getUpperBoundLevel( 2 ), 0U );
+
+        TS_ASSERT_THROWS_NOTHING( delete tableau );
+    }
+
+    void test_dual_simplex_pivot()
+    {
+        Tableau *tableau = NULL;
+        MockCostFunctionManager costFunctionManager;
+
+        TS_ASSERT( tableau = new Tableau );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setDimensions( 3, 7 ) );
+        tableau->registerCostFunctionManager( &costFunctionManager );
+        initializeTableauValues( *tableau );
+
+        for ( unsigned i = 0; i < 4; ++i )
+        {
+            TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( i, 1 ) );
+            TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( i, 10 ) );
+        }
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 4, 210 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 4, 228 ) );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 5, 100 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 5, 114 ) );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 6, 400 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 6, 402 ) );
+
+        List<unsigned> basics = { 4, 5, 6 };
+        TS_ASSERT_THROWS_NOTHING( tableau->initializeTableau( basics ) );
+
+        TS_ASSERT_EQUALS( tableau->getValue( 4 ), 217.0 );
+        TS_ASSERT_EQUALS( tableau->getValue( 5 ), 113.0 );
+        TS_ASSERT_EQUALS( tableau->getValue( 6 ), 406.0 );
+
+        // x7 is the only out-of-bounds basic variable
+        TS_ASSERT_THROWS_NOTHING( tableau->resetDualSteepestEdgeWeights() );
+        TS_ASSERT( tableau->pickDualLeavingVariable() );
+        TS_ASSERT_EQUALS( tableau->getLeavingVariable(), 6u );
+
+        // x7 = 420 - 4x1 - 3x2 - 3x3 - 4x4 needs to decrease by 4. All the
+        // non-basics can increase; x1 and x4 have the largest pivot, and
+        // the tie is broken by index
+        TS_ASSERT_THROWS_NOTHING( tableau->computePivotRow() );
+        TS_ASSERT( tableau->dualRatioTest() );
+        TS_ASSERT_EQUALS( tableau->getEnteringVariable(), 0u );
+        TS_ASSERT( FloatUtils::areEqual( tableau->getChangeRatio(), 1.0 ) );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->computeChangeColumn() );
+        TS_ASSERT_THROWS_NOTHING( tableau->updateDualSteepestEdgeWeights() );
+        TS_ASSERT_THROWS_NOTHING( tableau->performPivot() );
+
+        TS_ASSERT( tableau->isBasic( 0u ) );
+        TS_ASSERT( !tableau->isBasic( 6u ) );
+
+        // The leaving variable is placed on its violated bound
+        TS_ASSERT( FloatUtils::areEqual( tableau->getValue( 0 ), 2.0 ) );
+        TS_ASSERT( FloatUtils::areEqual( tableau->getValue( 4 ), 214.0 ) );
+        TS_ASSERT( FloatUtils::areEqual( tableau->getValue( 5 ), 112.0 ) );
+        TS_ASSERT( FloatUtils::areEqual( tableau->getValue( 6 ), 402.0 ) );
+
+        // All basic variables are now within bounds
+        TS_ASSERT( !tableau->existsBasicOutOfBounds() );
+        TS_ASSERT( !tableau->pickDualLeavingVariable() );
+
+        TS_ASSERT_THROWS_NOTHING( delete tableau );
+    }
+
+    void test_dual_ratio_test_no_eligible_variables()
+    {
+        Tableau *tableau = NULL;
+        MockCostFunctionManager costFunctionManager;
+
+        TS_ASSERT( tableau = new Tableau );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setDimensions( 3, 7 ) );
+        tableau->registerCostFunctionManager( &costFunctionManager );
+        initializeTableauValues( *tableau );
+
+        // The non-basic variables are fixed at 1
+        for ( unsigned i = 0; i < 4; ++i )
+        {
+            TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( i, 1 ) );
+            TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( i, 1 ) );
+        }
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 4, 210 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 4, 228 ) );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 5, 100 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 5, 114 ) );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 6, 400 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 6, 402 ) );
+
+        List<unsigned> basics = { 4, 5, 6 };
+        TS_ASSERT_THROWS_NOTHING( tableau->initializeTableau( basics ) );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->resetDualSteepestEdgeWeights() );
+        TS_ASSERT( tableau->pickDualLeavingVariable() );
+        TS_ASSERT_EQUALS( tableau->getLeavingVariable(), 6u );
+
+        // No non-basic variable can move, so x7 cannot be fixed
+        TS_ASSERT_THROWS_NOTHING( tableau->computePivotRow() );
+        TS_ASSERT( !tableau->dualRatioTest() );
+
+        TS_ASSERT_THROWS_NOTHING( delete tableau );
+    }
+
     void test_are_dependent()
     {
         Tableau *tableau = NULL;
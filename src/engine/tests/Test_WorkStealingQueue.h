@@ -0,0 +1,107 @@
+/*********************                                                        */
+/*! \file Test_WorkStealingQueue.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "WorkStealingQueue.h"
+
+class WorkStealingQueueTestSuite : public CxxTest::TestSuite
+{
+public:
+
+    SubQuery *createSubQuery( String queryId, unsigned depth )
+    {
+        SubQuery *subQuery = new SubQuery;
+        subQuery->_queryId = queryId;
+        subQuery->_depth = depth;
+        return subQuery;
+    }
+
+    void test_owner_pops_last_pushed()
+    {
+        WorkStealingQueue queue( 2 );
+        TS_ASSERT( queue.empty() );
+        TS_ASSERT_EQUALS( queue.getNumberOfWorkers(), 2U );
+
+        TS_ASSERT( queue.push( 0, createSubQuery( "1", 1 ) ) );
+        TS_ASSERT( queue.push( 0, createSubQuery( "1-1", 2 ) ) );
+        TS_ASSERT( queue.push( 0, createSubQuery( "1-2", 2 ) ) );
+        TS_ASSERT_EQUALS( queue.size(), 3U );
+
+        SubQuery *subQuery = NULL;
+        TS_ASSERT( queue.pop( 0, subQuery ) );
+        TS_ASSERT_EQUALS( subQuery->_queryId, "1-2" );
+        delete subQuery;
+
+        TS_ASSERT( queue.pop( 0, subQuery ) );
+        TS_ASSERT_EQUALS( subQuery->_queryId, "1-1" );
+        delete subQuery;
+
+        TS_ASSERT_EQUALS( queue.size(), 1U );
+    }
+
+    void test_thief_steals_shallowest()
+    {
+        WorkStealingQueue queue( 3 );
+
+        TS_ASSERT( queue.push( 0, createSubQuery( "1-1", 2 ) ) );
+        TS_ASSERT( queue.push( 0, createSubQuery( "1-1-1", 3 ) ) );
+        TS_ASSERT( queue.push( 1, createSubQuery( "2", 1 ) ) );
+        TS_ASSERT( queue.push( 1, createSubQuery( "2-1", 2 ) ) );
+
+        // Worker 2 has nothing of its own, and steals the shallowest
+        // pending subquery
+        SubQuery *subQuery = NULL;
+        TS_ASSERT( queue.pop( 2, subQuery ) );
+        TS_ASSERT_EQUALS( subQuery->_queryId, "2" );
+        delete subQuery;
+
+        TS_ASSERT( queue.steal( 2, subQuery ) );
+        TS_ASSERT_EQUALS( subQuery->_queryId, "1-1" );
+        delete subQuery;
+
+        TS_ASSERT( queue.steal( 2, subQuery ) );
+        TS_ASSERT_EQUALS( subQuery->_queryId, "2-1" );
+        delete subQuery;
+
+        // Worker 1's deque is now empty, so it steals from worker 0
+        TS_ASSERT( queue.pop( 1, subQuery ) );
+        TS_ASSERT_EQUALS( subQuery->_queryId, "1-1-1" );
+        delete subQuery;
+
+        TS_ASSERT( queue.empty() );
+        TS_ASSERT( !queue.pop( 0, subQuery ) );
+        TS_ASSERT( !queue.steal( 1, subQuery ) );
+    }
+
+    void test_invalid_worker()
+    {
+        WorkStealingQueue queue( 1 );
+        SubQuery *subQuery = createSubQuery( "1", 1 );
+
+        TS_ASSERT( !queue.push( 1, subQuery ) );
+        TS_ASSERT( queue.push( 0, subQuery ) );
+
+        // Remaining subqueries are deleted by the queue
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,359 @@
+/*********************                                                        */
+/*! \file ConvolutionDetector.cpp
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** The detector guesses the shapes of the two layers, and for each
+ ** pair derives the candidate kernel extents, strides and paddings
+ ** from the input positions read by the first row and first column
+ ** of the output. A candidate is accepted only if every non-zero
+ ** weight matches a shared kernel entry, and every in-bounds kernel
+ ** entry appears as a weight.
+
+**/
+
+#include "ConvolutionDetector.h"
+#include "List.h"
+
+#include <algorithm>
+#include <climits>
+
+namespace NLR {
+
+namespace {
+
+// A non-zero weight into a target neuron
+struct Weight
+{
+    unsigned _source;
+    double _value;
+};
+
+// The neurons of a layer, viewed as channels of rows
+struct Shape
+{
+    unsigned _channels;
+    unsigned _height;
+    unsigned _width;
+};
+
+// The kernel extent, stride and padding along one spatial dimension
+struct Dimension
+{
+    unsigned _kernel;
+    unsigned _stride;
+    unsigned _padding;
+};
+
+void enumerateShapes( unsigned size, List<Shape> &shapes )
+{
+    for ( unsigned channels = 1; channels <= size; ++channels )
+    {
+        if ( size % channels != 0 )
+            continue;
+
+        unsigned area = size / channels;
+        for ( unsigned height = 1; height <= area; ++height )
+        {
+            if ( area % height == 0 )
+                shapes.append( { channels, height, area / height } );
+        }
+    }
+}
+
+/*
+  Given the lowest and highest input position read by each output
+  position along a dimension, list the kernel extents, strides and
+  paddings that are consistent with them
+*/
+void enumerateDimensions( Vector<int> &low, Vector<int> &high,
+                          unsigned inputSize, List<Dimension> &dimensions )
+{
+    int last = low.size() - 1;
+    for ( int i = 0; i <= last; ++i )
+    {
+        if ( low[i] > high[i] )
+            return;
+    }
+
+    int stride = 1;
+    for ( int i = 0; i < last; ++i )
+    {
+        stride = std::max( stride, low[i + 1] - low[i] );
+        stride = std::max( stride, high[i + 1] - high[i] );
+    }
+
+    // The padding is exact, unless the last window is clipped at the start
+    int n = inputSize;
+    int minPadding = std::max( 0, last * stride - low[last] );
+    int maxPadding = ( low[last] == 0 ) ? minPadding + n : minPadding;
+
+    for ( int padding = minPadding; padding <= maxPadding; ++padding )
+    {
+        // The number of outputs is ( n + 2 * padding - kernel ) / stride + 1
+        int maxKernel = n + 2 * padding - last * stride;
+        int minKernel = std::max( padding + 1, maxKernel - stride + 1 );
+
+        for ( int kernel = minKernel; kernel <= maxKernel; ++kernel )
+        {
+            bool consistent = true;
+            for ( int i = 0; consistent && i <= last; ++i )
+            {
+                int first = i * stride - padding;
+                consistent = ( low[i] >= first && high[i] < first + kernel );
+            }
+
+            if ( consistent )
+                dimensions.append( { (unsigned)kernel, (unsigned)stride, (unsigned)padding } );
+        }
+    }
+}
+
+/*
+  Check whether the weights and biases are exactly those of the
+  convolution with the given parameters, and if so store its kernel
+  and channel biases
+*/
+bool extractConvolution( const Layer &layer,
+                         Vector<Vector<Weight>> &targetWeights,
+                         unsigned numNonZeros,
+                         ConvolutionDetector::Convolution &convolution )
+{
+    const Layer::ConvolutionParameters &parameters = convolution._parameters;
+    int inputHeight = parameters._inputHeight;
+    int inputWidth = parameters._inputWidth;
+    int kernelHeight = parameters._kernelHeight;
+    int kernelWidth = parameters._kernelWidth;
+    int strideHeight = parameters._strideHeight;
+    int strideWidth = parameters._strideWidth;
+    int paddingHeight = parameters._paddingHeight;
+    int paddingWidth = parameters._paddingWidth;
+    unsigned inputChannels = parameters._inputChannels;
+    unsigned outputChannels = parameters._outputChannels;
+    unsigned inputArea = inputHeight * inputWidth;
+    unsigned outputWidth = parameters.getOutputWidth();
+    unsigned outputArea = parameters.getOutputHeight() * outputWidth;
+
+    Vector<double> &kernel = convolution._kernel;
+    kernel.assign( outputChannels * inputChannels * kernelHeight * kernelWidth, 0 );
+    Vector<char> kernelSet( kernel.size(), false );
+
+    for ( unsigned target = 0; target < targetWeights.size(); ++target )
+    {
+        unsigned outputChannel = target / outputArea;
+        int firstRow = (int)( ( target % outputArea ) / outputWidth ) * strideHeight - paddingHeight;
+        int firstColumn = (int)( target % outputWidth ) * strideWidth - paddingWidth;
+
+        for ( const Weight &weight : targetWeights[target] )
+        {
+            unsigned inputChannel = weight._source / inputArea;
+            int row = (int)( ( weight._source % inputArea ) / inputWidth ) - firstRow;
+            int column = (int)( weight._source % inputWidth ) - firstColumn;
+
+            if ( row < 0 || row >= kernelHeight || column < 0 || column >= kernelWidth )
+                return false;
+
+            unsigned index = ( ( outputChannel * inputChannels + inputChannel ) * kernelHeight + row ) *
+                kernelWidth + column;
+
+            if ( !kernelSet[index] )
+            {
+                kernelSet[index] = true;
+                kernel[index] = weight._value;
+            }
+            else if ( kernel[index] != weight._value )
+                return false;
+        }
+    }
+
+    // Every kernel entry must be applied wherever its window is within the input
+    unsigned numApplications = 0;
+    for ( unsigned target = 0; target < targetWeights.size(); ++target )
+    {
+        unsigned outputChannel = target / outputArea;
+        int firstRow = (int)( ( target % outputArea ) / outputWidth ) * strideHeight - paddingHeight;
+        int firstColumn = (int)( target % outputWidth ) * strideWidth - paddingWidth;
+
+        unsigned index = outputChannel * inputChannels * kernelHeight * kernelWidth;
+        for ( unsigned inputChannel = 0; inputChannel < inputChannels; ++inputChannel )
+        {
+            for ( int row = 0; row < kernelHeight; ++row )
+            {
+                for ( int column = 0; column < kernelWidth; ++column, ++index )
+                {
+                    if ( kernelSet[index] &&
+                         firstRow + row >= 0 && firstRow + row < inputHeight &&
+                         firstColumn + column >= 0 && firstColumn + column < inputWidth )
+                        ++numApplications;
+                }
+            }
+        }
+    }
+
+    if ( numApplications != numNonZeros )
+        return false;
+
+    Vector<double> &channelBiases = convolution._channelBiases;
+    channelBiases.assign( outputChannels, 0 );
+    for ( unsigned outputChannel = 0; outputChannel < outputChannels; ++outputChannel )
+    {
+        double bias = layer.getBias( outputChannel * outputArea );
+        for ( unsigned i = 1; i < outputArea; ++i )
+        {
+            if ( layer.getBias( outputChannel * outputArea + i ) != bias )
+                return false;
+        }
+
+        channelBiases[outputChannel] = bias;
+    }
+
+    return true;
+}
+
+} // namespace
+
+bool ConvolutionDetector::detect( const Layer &layer, Convolution &convolution )
+{
+    if ( layer.getLayerType() != Layer::WEIGHTED_SUM || layer.getSourceLayers().size() != 1 )
+        return false;
+
+    unsigned sourceLayer = layer.getSourceLayers().begin()->first;
+    unsigned sourceSize = layer.getSourceLayers().begin()->second;
+    unsigned size = layer.getSize();
+    const double *weights = layer.getWeightMatrix( sourceLayer );
+
+    Vector<double> values;
+    for ( unsigned i = 0; i < sourceSize * size; ++i )
+    {
+        if ( weights[i] != 0 )
+            values.append( weights[i] );
+    }
+
+    unsigned numNonZeros = values.size();
+    if ( numNonZeros == 0 )
+        return false;
+
+    // The kernel holds every distinct weight, and must be smaller than the layer
+    values.sort();
+    unsigned numDistinctValues = 1;
+    for ( unsigned i = 1; i < numNonZeros; ++i )
+    {
+        if ( values[i] != values[i - 1] )
+            ++numDistinctValues;
+    }
+
+    if ( numDistinctValues == numNonZeros )
+        return false;
+
+    Vector<Vector<Weight>> targetWeights( size );
+    for ( unsigned source = 0; source < sourceSize; ++source )
+    {
+        for ( unsigned target = 0; target < size; ++target )
+        {
+            double weight = weights[source * size + target];
+            if ( weight != 0 )
+                targetWeights[target].append( { source, weight } );
+        }
+    }
+
+    List<Shape> inputShapes;
+    List<Shape> outputShapes;
+    enumerateShapes( sourceSize, inputShapes );
+    enumerateShapes( size, outputShapes );
+
+    bool found = false;
+    unsigned bestKernelSize = numNonZeros;
+
+    for ( const Shape &output : outputShapes )
+    {
+        // Weights are only shared between different output positions
+        if ( output._height * output._width < 2 )
+            continue;
+
+        for ( const Shape &input : inputShapes )
+        {
+            unsigned inputArea = input._height * input._width;
+            unsigned outputArea = output._height * output._width;
+
+            Vector<int> rowLow( output._height, INT_MAX );
+            Vector<int> rowHigh( output._height, -1 );
+            Vector<int> columnLow( output._width, INT_MAX );
+            Vector<int> columnHigh( output._width, -1 );
+
+            for ( unsigned channel = 0; channel < output._channels; ++channel )
+            {
+                for ( unsigned row = 0; row < output._height; ++row )
+                {
+                    for ( const Weight &weight : targetWeights[channel * outputArea + row * output._width] )
+                    {
+                        int inputRow = ( weight._source % inputArea ) / input._width;
+                        rowLow[row] = std::min( rowLow[row], inputRow );
+                        rowHigh[row] = std::max( rowHigh[row], inputRow );
+                    }
+                }
+
+                for ( unsigned column = 0; column < output._width; ++column )
+                {
+                    for ( const Weight &weight : targetWeights[channel * outputArea + column] )
+                    {
+                        int inputColumn = weight._source % input._width;
+                        columnLow[column] = std::min( columnLow[column], inputColumn );
+                        columnHigh[column] = std::max( columnHigh[column], inputColumn );
+                    }
+                }
+            }
+
+            List<Dimension> rows;
+            List<Dimension> columns;
+            enumerateDimensions( rowLow, rowHigh, input._height, rows );
+            enumerateDimensions( columnLow, columnHigh, input._width, columns );
+
+            for ( const Dimension &row : rows )
+            {
+                for ( const Dimension &column : columns )
+                {
+                    unsigned kernelSize =
+                        output._channels * input._channels * row._kernel * column._kernel;
+                    if ( kernelSize >= bestKernelSize || kernelSize < numDistinctValues )
+                        continue;
+
+                    Convolution candidate;
+                    Layer::ConvolutionParameters &parameters = candidate._parameters;
+                    parameters._inputChannels = input._channels;
+                    parameters._inputHeight = input._height;
+                    parameters._inputWidth = input._width;
+                    parameters._outputChannels = output._channels;
+                    parameters._kernelHeight = row._kernel;
+                    parameters._kernelWidth = column._kernel;
+                    parameters._strideHeight = row._stride;
+                    parameters._strideWidth = column._stride;
+                    parameters._paddingHeight = row._padding;
+                    parameters._paddingWidth = column._padding;
+
+                    if ( extractConvolution( layer, targetWeights, numNonZeros, candidate ) )
+                    {
+                        convolution = candidate;
+                        bestKernelSize = kernelSize;
+                        found = true;
+                    }
+                }
+            }
+        }
+    }
+
+    return found;
+}
+
+} // namespace NLR
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,59 @@
+/*********************                                                        */
+/*! \file ConvolutionDetector.h
+ ** \verbatim
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** Recognizes weighted sum layers whose weights are those of a
+ ** convolution, so that they can be represented by their kernel.
+
+**/
+
+#ifndef __ConvolutionDetector_h__
+#define __ConvolutionDetector_h__
+
+#include "Layer.h"
+#include "Vector.h"
+
+namespace NLR {
+
+class ConvolutionDetector
+{
+public:
+    /*
+      A detected convolution: its parameters, its kernel (indexed by
+      output channel, input channel, row and column, in that order)
+      and the bias of each output channel
+    */
+    struct Convolution
+    {
+        Layer::ConvolutionParameters _parameters;
+        Vector<double> _kernel;
+        Vector<double> _channelBiases;
+    };
+
+    /*
+      Check whether a weighted sum layer with a single source layer
+      computes a convolution of that layer. Both layers are assumed to
+      be stored channel by channel, and each channel row by row. Only
+      convolutions whose kernel is smaller than the number of non-zero
+      weights of the layer are reported, and the one with the smallest
+      kernel is chosen.
+    */
+    static bool detect( const Layer &layer, Convolution &convolution );
+};
+
+} // namespace NLR
+
+#endif // __ConvolutionDetector_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
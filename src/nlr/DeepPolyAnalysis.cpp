@@ -193,7 +193,7 @@ DeepPolyElement *DeepPolyAnalysis::createDeepPolyElement( Layer *layer )
     DeepPolyElement *deepPolyElement;
     if ( type == Layer::INPUT )
         deepPolyElement = new DeepPolyInputElement( layer );
-    else if ( type == Layer::WEIGHTED_SUM )
+    else if ( type == Layer::WEIGHTED_SUM || type == Layer::CONVOLUTION )
     {
         deepPolyElement = new DeepPolyWeightedSumElement( layer );
         // Weighted sum layers need working memory for back substitution
@@ -214,6 +214,8 @@ DeepPolyElement *DeepPolyAnalysis::createDeepPolyElement( Layer *layer )
         throw NLRError( NLRError::LAYER_TYPE_NOT_SUPPORTED,
                         Stringf( "Layer %u not yet supported",
                                  layer->getLayerType() ).ascii() );
+
+    deepPolyElement->setThreadPool( _layerOwner->getThreadPool() );
     return deepPolyElement;
 }
 
@@ -33,6 +33,7 @@ DeepPolyElement::DeepPolyElement()
     , _work2SymbolicUb( NULL )
     , _workSymbolicLowerBias( NULL )
     , _workSymbolicUpperBias( NULL )
+    , _threadPool( NULL )
 {};
 
 unsigned DeepPolyElement::getSize() const
@@ -152,4 +153,9 @@ void DeepPolyElement::setWorkingMemory( double *work1SymbolicLb,
     _workSymbolicUpperBias = workSymbolicUpperBias;
 }
 
+void DeepPolyElement::setThreadPool( ThreadPool *threadPool )
+{
+    _threadPool = threadPool;
+}
+
 } // namespace NLR
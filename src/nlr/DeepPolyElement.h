@@ -20,6 +20,7 @@
 #include "Map.h"
 #include "MStringf.h"
 #include "NLRError.h"
+#include "ThreadPool.h"
 #include <climits>
 
 namespace NLR {
@@ -71,6 +72,12 @@ public:
                            double *workSymbolicLowerBias,
                            double *workSymbolicUpperBias );
 
+    /*
+      The pool on which the computation is split into blocks of
+      target neurons, or NULL for sequential execution
+    */
+    void setThreadPool( ThreadPool *threadPool );
+
     double getLowerBoundFromLayer( unsigned index ) const;
     double getUpperBoundFromLayer( unsigned index ) const;
 
@@ -98,6 +105,8 @@ protected:
     double * _workSymbolicLowerBias;
     double * _workSymbolicUpperBias;
 
+    ThreadPool *_threadPool;
+
     void allocateMemory();
     void freeMemoryIfNeeded();
 
@@ -15,6 +15,7 @@
 
 #include "DeepPolyReLUElement.h"
 #include "FloatUtils.h"
+#include "GlobalConfiguration.h"
 
 namespace NLR {
 
@@ -131,66 +132,76 @@ void DeepPolyReLUElement::symbolicBoundInTermsOfPredecessor
       ReLU outputs, the goal is to compute the symbolic bound of the target
       layer in terms of the ReLU inputs.
     */
-    for ( unsigned i = 0; i < _size; ++i )
+    // Each target neuron is substituted independently, so blocks of
+    // target neurons can be handled concurrently
+    unsigned numberOfBlocks =
+        ThreadPool::getNumberOfBlocks( _threadPool, targetLayerSize, _size,
+                                       GlobalConfiguration::PARALLEL_PROPAGATION_MIN_WORK_PER_BLOCK );
+
+    ThreadPool::runInBlocks( _threadPool, targetLayerSize, numberOfBlocks,
+                             [&]( unsigned, unsigned begin, unsigned end )
     {
-        NeuronIndex sourceIndex = *( _layer->
-                                     getActivationSources( i ).begin() );
-        unsigned sourceNeuronIndex = sourceIndex._neuron;
-        DEBUG({
-                ASSERT( predecessor->getLayerIndex() == sourceIndex._layer );
-            });
-
-        /*
-          Take symbolic upper bound as an example.
-          Suppose the symbolic upper bound of the j-th neuron in the
-          target layer is ... + a_i * f_i + ...,
-          and the symbolic bounds of f_i in terms of b_i is
-          m * b_i + n <= f_i <= p * b_i + q.
-          If a_i >= 0, replace f_i with p * b_i + q, otherwise,
-          replace f_i with m * b_i + n
-        */
-
-        // Symbolic bounds of the ReLU output in terms of the ReLU input
-        // coeffLb * b_i + lowerBias <= f_i <= coeffUb * b_i + upperBias
-        double coeffLb = _symbolicLb[i];
-        double coeffUb = _symbolicUb[i];
-        double lowerBias = _symbolicLowerBias[i];
-        double upperBias = _symbolicUpperBias[i];
-
-        // Substitute the ReLU input for the ReLU output
-        for ( unsigned j = 0; j < targetLayerSize; ++j )
+        for ( unsigned i = 0; i < _size; ++i )
         {
-            // The symbolic lower- and upper- bounds of the j-th neuron in the
-            // target layer are ... + weightLb * f_i + ...
-            // and ... + weightUb * f_i + ..., respectively.
-            unsigned newIndex = sourceNeuronIndex * targetLayerSize + j;
-            unsigned oldIndex = i * targetLayerSize + j;
-
-            // Update the symbolic lower bound
-            double weightLb = symbolicLb[oldIndex];
-            if ( weightLb >= 0 )
-            {
-                symbolicLbInTermsOfPredecessor[newIndex] += weightLb * coeffLb;
-                symbolicLowerBias[j] += weightLb * lowerBias;
-            } else
-            {
-                symbolicLbInTermsOfPredecessor[newIndex] += weightLb * coeffUb;
-                symbolicLowerBias[j] += weightLb * upperBias;
-            }
+            NeuronIndex sourceIndex = *( _layer->
+                                         getActivationSources( i ).begin() );
+            unsigned sourceNeuronIndex = sourceIndex._neuron;
+            DEBUG({
+                    ASSERT( predecessor->getLayerIndex() == sourceIndex._layer );
+                });
 
-            // Update the symbolic upper bound
-            double weightUb = symbolicUb[oldIndex];
-            if ( weightUb >= 0 )
-            {
-                symbolicUbInTermsOfPredecessor[newIndex] += weightUb * coeffUb;
-                symbolicUpperBias[j] += weightUb * upperBias;
-            } else
+            /*
+              Take symbolic upper bound as an example.
+              Suppose the symbolic upper bound of the j-th neuron in the
+              target layer is ... + a_i * f_i + ...,
+              and the symbolic bounds of f_i in terms of b_i is
+              m * b_i + n <= f_i <= p * b_i + q.
+              If a_i >= 0, replace f_i with p * b_i + q, otherwise,
+              replace f_i with m * b_i + n
+            */
+
+            // Symbolic bounds of the ReLU output in terms of the ReLU input
+            // coeffLb * b_i + lowerBias <= f_i <= coeffUb * b_i + upperBias
+            double coeffLb = _symbolicLb[i];
+            double coeffUb = _symbolicUb[i];
+            double lowerBias = _symbolicLowerBias[i];
+            double upperBias = _symbolicUpperBias[i];
+
+            // Substitute the ReLU input for the ReLU output
+            for ( unsigned j = begin; j < end; ++j )
             {
-                symbolicUbInTermsOfPredecessor[newIndex] += weightUb * coeffLb;
-                symbolicUpperBias[j] += weightUb * lowerBias;
+                // The symbolic lower- and upper- bounds of the j-th neuron in the
+                // target layer are ... + weightLb * f_i + ...
+                // and ... + weightUb * f_i + ..., respectively.
+                unsigned newIndex = sourceNeuronIndex * targetLayerSize + j;
+                unsigned oldIndex = i * targetLayerSize + j;
+
+                // Update the symbolic lower bound
+                double weightLb = symbolicLb[oldIndex];
+                if ( weightLb >= 0 )
+                {
+                    symbolicLbInTermsOfPredecessor[newIndex] += weightLb * coeffLb;
+                    symbolicLowerBias[j] += weightLb * lowerBias;
+                } else
+                {
+                    symbolicLbInTermsOfPredecessor[newIndex] += weightLb * coeffUb;
+                    symbolicLowerBias[j] += weightLb * upperBias;
+                }
+
+                // Update the symbolic upper bound
+                double weightUb = symbolicUb[oldIndex];
+                if ( weightUb >= 0 )
+                {
+                    symbolicUbInTermsOfPredecessor[newIndex] += weightUb * coeffUb;
+                    symbolicUpperBias[j] += weightUb * upperBias;
+                } else
+                {
+                    symbolicUbInTermsOfPredecessor[newIndex] += weightUb * coeffLb;
+                    symbolicUpperBias[j] += weightUb * lowerBias;
+                }
             }
         }
-    }
+    } );
 }
 
 void DeepPolyReLUElement::allocateMemory()
@@ -15,7 +15,9 @@
 
 #include "DeepPolyWeightedSumElement.h"
 #include "FloatUtils.h"
+#include "GlobalConfiguration.h"
 
+#include <algorithm>
 #include <string.h>
 
 namespace NLR {
@@ -73,11 +75,8 @@ void DeepPolyWeightedSumElement::computeBoundWithBackSubstitution
             log( Stringf( "Adding residual from layer %u...",
                           predecessorIndex ) );
             allocateMemoryForResidualsIfNeeded( predecessorIndex, pair.second );
-            const double *weights = _layer->getWeights( predecessorIndex );
-            memcpy( _residualLb[predecessorIndex], weights,
-                    _size * pair.second * sizeof(double) );
-            memcpy( _residualUb[predecessorIndex], weights,
-                    _size * pair.second * sizeof(double) );
+            storeWeights( predecessorIndex, pair.second, _residualLb[predecessorIndex] );
+            storeWeights( predecessorIndex, pair.second, _residualUb[predecessorIndex] );
             ++counter;
             log( Stringf( "Adding residual from layer %u - done", pair.first ) );
         }
@@ -89,11 +88,8 @@ void DeepPolyWeightedSumElement::computeBoundWithBackSubstitution
         deepPolyElementsBefore[predecessorIndex];
     unsigned sourceLayerSize = precedingElement->getSize();
 
-    const double *weights = _layer->getWeights( predecessorIndex );
-    memcpy( _work1SymbolicLb,
-            weights, _size * sourceLayerSize * sizeof(double) );
-    memcpy( _work1SymbolicUb,
-            weights, _size * sourceLayerSize * sizeof(double) );
+    storeWeights( predecessorIndex, sourceLayerSize, _work1SymbolicLb );
+    storeWeights( predecessorIndex, sourceLayerSize, _work1SymbolicUb );
 
     double *bias = _layer->getBiases();
     memcpy( _workSymbolicLowerBias, bias, _size * sizeof(double) );
@@ -284,38 +280,53 @@ void DeepPolyWeightedSumElement::concretizeSymbolicBoundForSourceLayer
         });
     */
 
-    // Get concrete bounds
-    for ( unsigned i = 0; i < sourceElement->getSize(); ++i )
+    if ( GlobalConfiguration::NETWORK_LEVEL_REASONER_LOGGING )
     {
-        double sourceLb = sourceElement->getLowerBoundFromLayer( i );
-        double sourceUb = sourceElement->getUpperBoundFromLayer( i );
+        for ( unsigned i = 0; i < sourceElement->getSize(); ++i )
+            log( Stringf( "Bounds of neuron%u_%u: [%f, %f]\n", sourceElement->
+                          getLayerIndex(), i, sourceElement->getLowerBoundFromLayer( i ),
+                          sourceElement->getUpperBoundFromLayer( i ) ) );
+    }
 
-        log( Stringf( "Bounds of neuron%u_%u: [%f, %f]\n", sourceElement->
-                      getLayerIndex(), i, sourceLb, sourceUb ) );
+    // Get concrete bounds. Each block of neurons of this layer is
+    // concretized independently.
+    unsigned sourceSize = sourceElement->getSize();
+    unsigned numberOfBlocks =
+        ThreadPool::getNumberOfBlocks( _threadPool, _size, sourceSize,
+                                       GlobalConfiguration::PARALLEL_PROPAGATION_MIN_WORK_PER_BLOCK );
 
-        for ( unsigned j = 0; j < _size; ++j )
+    ThreadPool::runInBlocks( _threadPool, _size, numberOfBlocks,
+                             [&]( unsigned, unsigned begin, unsigned end )
+    {
+        for ( unsigned i = 0; i < sourceSize; ++i )
         {
-            // Compute lower bound
-            double weight = symbolicLb[i * _size + j];
-            if ( weight >= 0 )
-            {
-                _workLb[j] += ( weight * sourceLb );
-            } else
-            {
-                _workLb[j] += ( weight * sourceUb );
-            }
+            double sourceLb = sourceElement->getLowerBoundFromLayer( i );
+            double sourceUb = sourceElement->getUpperBoundFromLayer( i );
 
-            // Compute upper bound
-            weight = symbolicUb[i * _size + j];
-            if ( weight >= 0 )
-            {
-                _workUb[j] += ( weight * sourceUb );
-            } else
+            for ( unsigned j = begin; j < end; ++j )
             {
-                _workUb[j] += ( weight * sourceLb );
+                // Compute lower bound
+                double weight = symbolicLb[i * _size + j];
+                if ( weight >= 0 )
+                {
+                    _workLb[j] += ( weight * sourceLb );
+                } else
+                {
+                    _workLb[j] += ( weight * sourceUb );
+                }
+
+                // Compute upper bound
+                weight = symbolicUb[i * _size + j];
+                if ( weight >= 0 )
+                {
+                    _workUb[j] += ( weight * sourceUb );
+                } else
+                {
+                    _workUb[j] += ( weight * sourceLb );
+                }
             }
         }
-    }
+    } );
 
     for ( unsigned i = 0; i < _size; ++i )
     {
@@ -338,17 +349,45 @@ void DeepPolyWeightedSumElement::symbolicBoundInTermsOfPredecessor
                   predecessorIndex ) );
     unsigned predecessorSize = predecessor->getSize();
 
-    double *weights = _layer->getWeights( predecessorIndex );
     double *biases = _layer->getBiases();
 
     // newSymbolicLb = weights * symbolicLb
     // newSymbolicUb = weights * symbolicUb
-    matrixMultiplication( weights, symbolicLb,
-                          symbolicLbInTermsOfPredecessor, predecessorSize,
-                          _size, targetLayerSize );
-    matrixMultiplication( weights, symbolicUb,
-                          symbolicUbInTermsOfPredecessor, predecessorSize,
-                          _size, targetLayerSize );
+    if ( _layer->getLayerType() == Layer::CONVOLUTION )
+    {
+        // Only the non-zero weights of the kernel contribute
+        const Layer::SparseWeights *sparseWeights = _layer->getSparseWeights( predecessorIndex );
+        for ( unsigned k = 0; k < predecessorSize; ++k )
+        {
+            double *lbRow = symbolicLbInTermsOfPredecessor + k * targetLayerSize;
+            double *ubRow = symbolicUbInTermsOfPredecessor + k * targetLayerSize;
+
+            unsigned rowEnd = sparseWeights->_rowStart.get( k + 1 );
+            for ( unsigned entry = sparseWeights->_rowStart.get( k ); entry < rowEnd; ++entry )
+            {
+                double weight = sparseWeights->_weights.get( entry );
+                unsigned j = sparseWeights->_targetNeurons.get( entry );
+                const double *sourceLbRow = symbolicLb + j * targetLayerSize;
+                const double *sourceUbRow = symbolicUb + j * targetLayerSize;
+
+                for ( unsigned i = 0; i < targetLayerSize; ++i )
+                {
+                    lbRow[i] += weight * sourceLbRow[i];
+                    ubRow[i] += weight * sourceUbRow[i];
+                }
+            }
+        }
+    }
+    else
+    {
+        double *weights = _layer->getWeights( predecessorIndex );
+        matrixMultiplication( weights, symbolicLb,
+                              symbolicLbInTermsOfPredecessor, predecessorSize,
+                              _size, targetLayerSize, _threadPool );
+        matrixMultiplication( weights, symbolicUb,
+                              symbolicUbInTermsOfPredecessor, predecessorSize,
+                              _size, targetLayerSize, _threadPool );
+    }
 
     // symbolicLowerBias = biases * symbolicLb
     // symbolicUpperBias = biases * symbolicUb
@@ -362,6 +401,29 @@ void DeepPolyWeightedSumElement::symbolicBoundInTermsOfPredecessor
                   predecessorIndex ) );
 }
 
+void DeepPolyWeightedSumElement::storeWeights( unsigned predecessorIndex,
+                                               unsigned predecessorSize,
+                                               double *matrix ) const
+{
+    if ( _layer->getLayerType() != Layer::CONVOLUTION )
+    {
+        memcpy( matrix, _layer->getWeights( predecessorIndex ),
+                _size * predecessorSize * sizeof(double) );
+        return;
+    }
+
+    // Convolutions have no dense weights: scatter the non-zero ones
+    const Layer::SparseWeights *sparseWeights = _layer->getSparseWeights( predecessorIndex );
+    std::fill_n( matrix, _size * predecessorSize, 0 );
+    for ( unsigned k = 0; k < predecessorSize; ++k )
+    {
+        unsigned rowEnd = sparseWeights->_rowStart.get( k + 1 );
+        for ( unsigned entry = sparseWeights->_rowStart.get( k ); entry < rowEnd; ++entry )
+            matrix[k * _size + sparseWeights->_targetNeurons.get( entry )] =
+                sparseWeights->_weights.get( entry );
+    }
+}
+
 void DeepPolyWeightedSumElement::allocateMemoryForResidualsIfNeeded
 ( unsigned residualLayerIndex, unsigned residualLayerSize )
 {
@@ -75,6 +75,13 @@ private:
                                                 const double *symbolicUpperBias,
                                                 DeepPolyElement *sourceElement );
 
+    /*
+      Store the weights from a predecessor in a (predecessor size) x
+      (layer size) matrix.
+    */
+    void storeWeights( unsigned predecessorIndex, unsigned predecessorSize,
+                       double *matrix ) const;
+
     void allocateMemoryForResidualsIfNeeded( unsigned residualLayerIndex,
                                              unsigned residualLayerSize );
     void allocateMemory();
@@ -16,6 +16,7 @@
 #include "Debug.h"
 #include "InfeasibleQueryException.h"
 #include "IterativePropagator.h"
+#include "LPSolverFactory.h"
 #include "Layer.h"
 #include "MStringf.h"
 #include "NLRError.h"
@@ -47,14 +48,14 @@ void IterativePropagator::optimizeBoundsWithIterativePropagation( const Map<unsi
     // Time to wait if no idle worker is availble
     boost::chrono::milliseconds waitTime( numberOfWorkers - 1 );
 
-    Map<GurobiWrapper *, unsigned> solverToIndex;
+    Map<ILPSolver *, unsigned> solverToIndex;
     // Create a queue of free workers
     // When a worker is working, it is popped off the queue, when it is done, it
     // is added back to the queue.
     SolverQueue freeSolvers( numberOfWorkers );
     for ( unsigned i = 0; i < numberOfWorkers; ++i )
     {
-        GurobiWrapper *gurobi = new GurobiWrapper();
+        ILPSolver *gurobi = LPSolverFactory::createLPSolver();
         solverToIndex[gurobi] = i;
         enqueueSolver( freeSolvers, gurobi );
     }
@@ -162,7 +163,7 @@ void IterativePropagator::optimizeBoundsWithIterativePropagation( const Map<unsi
                 }
 
                 // Wait until there is an idle solver
-                GurobiWrapper *freeSolver;
+                ILPSolver *freeSolver;
                 while ( !freeSolvers.pop( freeSolver ) )
                     boost::this_thread::sleep_for( waitTime );
 
@@ -218,13 +219,13 @@ void IterativePropagator::setCutoff( double cutoff )
 }
 
 
-double IterativePropagator::optimizeWithGurobi( GurobiWrapper &gurobi, MinOrMax
+double IterativePropagator::optimizeWithGurobi( ILPSolver &gurobi, MinOrMax
                                            minOrMax, String variableName,
                                            double cutoffValue,
                                            std::atomic_bool *infeasible )
 {
-    List<GurobiWrapper::Term> terms;
-    terms.append( GurobiWrapper::Term( 1, variableName ) );
+    List<ILPSolver::Term> terms;
+    terms.append( ILPSolver::Term( 1, variableName ) );
 
     if ( minOrMax == MAX )
         gurobi.setObjective( terms );
@@ -278,7 +279,7 @@ void IterativePropagator::tightenSingleVariableBounds( ThreadArgument &argument
                 tightenSingleVariableLowerBounds( argument );
         }
         SolverQueue &freeSolvers = argument._freeSolvers;
-        GurobiWrapper *gurobi = argument._gurobi;
+        ILPSolver *gurobi = argument._gurobi;
         enqueueSolver( freeSolvers, gurobi );
     }
     catch ( boost::thread_interrupted& )
@@ -289,7 +290,7 @@ void IterativePropagator::tightenSingleVariableBounds( ThreadArgument &argument
 
 bool IterativePropagator::tightenSingleVariableLowerBounds( ThreadArgument &argument )
 {
-    GurobiWrapper *gurobi = argument._gurobi;
+    ILPSolver *gurobi = argument._gurobi;
     Layer *layer = argument._layer;
     unsigned index = argument._index;
     double currentLb = argument._currentLb;
@@ -345,7 +346,7 @@ bool IterativePropagator::tightenSingleVariableLowerBounds( ThreadArgument &argu
 
 bool IterativePropagator::tightenSingleVariableUpperBounds( ThreadArgument &argument )
 {
-    GurobiWrapper *gurobi = argument._gurobi;
+    ILPSolver *gurobi = argument._gurobi;
     Layer *layer = argument._layer;
     unsigned index = argument._index;
     double currentUb = argument._currentUb;
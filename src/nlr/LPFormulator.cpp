@@ -13,9 +13,10 @@
 
  **/
 
-#include "GurobiWrapper.h"
+#include "ILPSolver.h"
 #include "InfeasibleQueryException.h"
 #include "LPFormulator.h"
+#include "LPSolverFactory.h"
 #include "Layer.h"
 #include "MStringf.h"
 #include "NLRError.h"
@@ -24,6 +25,7 @@
 #include "Vector.h"
 
 #include <boost/thread.hpp>
+#include <memory>
 
 namespace NLR {
 
@@ -38,31 +40,31 @@ LPFormulator::~LPFormulator()
 {
 }
 
-double LPFormulator::solveLPRelaxation( GurobiWrapper &gurobi,
+double LPFormulator::solveLPRelaxation( ILPSolver &lpSolver,
                                         const Map<unsigned, Layer *> &layers,
                                         MinOrMax minOrMax, String variableName,
                                         unsigned lastLayer )
 {
-    gurobi.resetModel();
-    createLPRelaxation( layers, gurobi, lastLayer );
-    return optimizeWithGurobi( gurobi, minOrMax, variableName, _cutoffValue );
+    lpSolver.resetModel();
+    createLPRelaxation( layers, lpSolver, lastLayer );
+    return optimizeWithGurobi( lpSolver, minOrMax, variableName, _cutoffValue );
 }
 
-double LPFormulator::optimizeWithGurobi( GurobiWrapper &gurobi,
+double LPFormulator::optimizeWithGurobi( ILPSolver &lpSolver,
                                          MinOrMax minOrMax, String variableName,
                                          double cutoffValue, std::atomic_bool *infeasible )
 {
-    List<GurobiWrapper::Term> terms;
-    terms.append( GurobiWrapper::Term( 1, variableName ) );
+    List<ILPSolver::Term> terms;
+    terms.append( ILPSolver::Term( 1, variableName ) );
 
     if ( minOrMax == MAX )
-        gurobi.setObjective( terms );
+        lpSolver.setObjective( terms );
     else
-        gurobi.setCost( terms );
+        lpSolver.setCost( terms );
 
-    gurobi.solve();
+    lpSolver.solve();
 
-    if ( gurobi.infeasbile() )
+    if ( lpSolver.infeasbile() )
     {
         if ( infeasible )
         {
@@ -73,19 +75,19 @@ double LPFormulator::optimizeWithGurobi( GurobiWrapper &gurobi,
             throw InfeasibleQueryException();
     }
 
-    if ( gurobi.cutoffOccurred() )
+    if ( lpSolver.cutoffOccurred() )
         return cutoffValue;
 
-    if ( gurobi.optimal() )
+    if ( lpSolver.optimal() )
     {
         Map<String, double> dontCare;
         double result = 0;
-        gurobi.extractSolution( dontCare, result );
+        lpSolver.extractSolution( dontCare, result );
         return result;
     }
-    else if ( gurobi.timeout() )
+    else if ( lpSolver.timeout() )
     {
-        return gurobi.getObjectiveBound();
+        return lpSolver.getObjectiveBound();
     }
 
     throw NLRError( NLRError::UNEXPECTED_RETURN_STATUS_FROM_GUROBI );
@@ -93,9 +95,10 @@ double LPFormulator::optimizeWithGurobi( GurobiWrapper &gurobi,
 
 void LPFormulator::optimizeBoundsWithIncrementalLpRelaxation( const Map<unsigned, Layer *> &layers )
 {
-    GurobiWrapper gurobi;
+    std::unique_ptr<ILPSolver> solver( LPSolverFactory::createLPSolver() );
+    ILPSolver &lpSolver = *solver;
 
-    List<GurobiWrapper::Term> terms;
+    List<ILPSolver::Term> terms;
     Map<String, double> dontCare;
     double lb = 0;
     double ub = 0;
@@ -121,7 +124,7 @@ void LPFormulator::optimizeBoundsWithIncrementalLpRelaxation( const Map<unsigned
         */
         ASSERT( layers.exists( i ) );
         Layer *layer = layers[i];
-        addLayerToModel( gurobi, layer );
+        addLayerToModel( lpSolver, layer );
 
         for ( unsigned j = 0; j < layer->getSize(); ++j )
         {
@@ -138,27 +141,27 @@ void LPFormulator::optimizeBoundsWithIncrementalLpRelaxation( const Map<unsigned
             Stringf variableName( "x%u", variable );
 
             terms.clear();
-            terms.append( GurobiWrapper::Term( 1, variableName ) );
+            terms.append( ILPSolver::Term( 1, variableName ) );
 
             // Maximize
-            gurobi.reset();
-            gurobi.setObjective( terms );
-            gurobi.solve();
+            lpSolver.reset();
+            lpSolver.setObjective( terms );
+            lpSolver.solve();
 
-            if ( gurobi.infeasbile() )
+            if ( lpSolver.infeasbile() )
                 throw InfeasibleQueryException();
 
-            if ( gurobi.cutoffOccurred() )
+            if ( lpSolver.cutoffOccurred() )
             {
                 ub = _cutoffValue;
             }
-            else if ( gurobi.optimal() )
+            else if ( lpSolver.optimal() )
             {
-                gurobi.extractSolution( dontCare, ub );
+                lpSolver.extractSolution( dontCare, ub );
             }
-            else if ( gurobi.timeout() )
+            else if ( lpSolver.timeout() )
             {
-                ub = gurobi.getObjectiveBound();
+                ub = lpSolver.getObjectiveBound();
             }
             else
             {
@@ -168,7 +171,7 @@ void LPFormulator::optimizeBoundsWithIncrementalLpRelaxation( const Map<unsigned
             // If the bound is tighter, store it
             if ( ub < currentUb )
             {
-                gurobi.setUpperBound( variableName, ub );
+                lpSolver.setUpperBound( variableName, ub );
 
                 if ( FloatUtils::isPositive( currentUb ) &&
                      !FloatUtils::isPositive( ub ) )
@@ -188,24 +191,24 @@ void LPFormulator::optimizeBoundsWithIncrementalLpRelaxation( const Map<unsigned
             }
 
             // Minimize
-            gurobi.reset();
-            gurobi.setCost( terms );
-            gurobi.solve();
+            lpSolver.reset();
+            lpSolver.setCost( terms );
+            lpSolver.solve();
 
-            if ( gurobi.infeasbile() )
+            if ( lpSolver.infeasbile() )
                 throw InfeasibleQueryException();
 
-            if ( gurobi.cutoffOccurred() )
+            if ( lpSolver.cutoffOccurred() )
             {
                 lb = _cutoffValue;
             }
-            else if ( gurobi.optimal() )
+            else if ( lpSolver.optimal() )
             {
-                gurobi.extractSolution( dontCare, lb );
+                lpSolver.extractSolution( dontCare, lb );
             }
-            else if ( gurobi.timeout() )
+            else if ( lpSolver.timeout() )
             {
-                lb = gurobi.getObjectiveBound();
+                lb = lpSolver.getObjectiveBound();
             }
             else
             {
@@ -215,7 +218,7 @@ void LPFormulator::optimizeBoundsWithIncrementalLpRelaxation( const Map<unsigned
             // If the bound is tighter, store it
             if ( lb > currentLb )
             {
-                gurobi.setLowerBound( variableName, lb );
+                lpSolver.setLowerBound( variableName, lb );
 
                 if ( FloatUtils::isNegative( currentLb ) &&
                      !FloatUtils::isNegative( lb ) )
@@ -250,16 +253,16 @@ void LPFormulator::optimizeBoundsWithLpRelaxation( const Map<unsigned, Layer *>
     // Time to wait if no idle worker is availble
     boost::chrono::milliseconds waitTime( numberOfWorkers - 1 );
 
-    Map<GurobiWrapper *, unsigned> solverToIndex;
+    Map<ILPSolver *, unsigned> solverToIndex;
     // Create a queue of free workers
     // When a worker is working, it is popped off the queue, when it is done, it
     // is added back to the queue.
     SolverQueue freeSolvers( numberOfWorkers );
     for ( unsigned i = 0; i < numberOfWorkers; ++i )
     {
-        GurobiWrapper *gurobi = new GurobiWrapper();
-        solverToIndex[gurobi] = i;
-        enqueueSolver( freeSolvers, gurobi );
+        ILPSolver *lpSolver = LPSolverFactory::createLPSolver();
+        solverToIndex[lpSolver] = i;
+        enqueueSolver( freeSolvers, lpSolver );
     }
 
     boost::thread *threads = new boost::thread[numberOfWorkers];
@@ -287,8 +290,8 @@ void LPFormulator::optimizeBoundsWithLpRelaxation( const Map<unsigned, Layer *>
     {
         Layer *layer = currentLayer.second;
 
-        // declare simulations as local var to avoid a problem which can happen due to multi thread process.
-        const Vector<Vector<double>> *simulations = _layerOwner->getLayer( currentLayer.first )->getSimulations();
+        // The simulations are read from the owner's layer, as the layers being relaxed may be copies
+        const Layer *simulatedLayer = _layerOwner->getLayer( currentLayer.first );
 
         for ( unsigned i = 0; i < layer->getSize(); ++i )
         {
@@ -305,8 +308,10 @@ void LPFormulator::optimizeBoundsWithLpRelaxation( const Map<unsigned, Layer *>
             skipTightenUb = false;
 
             // Loop for simulation
-            for ( const auto &simValue : (*simulations).get( i ) )
+            for ( unsigned k = 0; k < simulatedLayer->getBatchSize(); ++k )
             {
+                double simValue = simulatedLayer->getBatchAssignment( i, k );
+
                 if ( _cutoffInUse && _cutoffValue < simValue ) // If x_lower < 0 < x_sim, do not try to call tightning upper bound.
                     skipTightenUb = true;
 
@@ -348,7 +353,7 @@ void LPFormulator::optimizeBoundsWithLpRelaxation( const Map<unsigned, Layer *>
             }
 
             // Wait until there is an idle solver
-            GurobiWrapper *freeSolver;
+            ILPSolver *freeSolver;
             while ( !freeSolvers.pop( freeSolver ) )
                 boost::this_thread::sleep_for( waitTime );
 
@@ -399,7 +404,7 @@ void LPFormulator::tightenSingleVariableBoundsWithLPRelaxation( ThreadArgument &
 {
     try
     {
-        GurobiWrapper *gurobi = argument._gurobi;
+        ILPSolver *lpSolver = argument._gurobi;
         Layer *layer = argument._layer;
         unsigned index = argument._index;
         double currentLb = argument._currentLb;
@@ -425,7 +430,7 @@ void LPFormulator::tightenSingleVariableBoundsWithLPRelaxation( ThreadArgument &
         if ( !skipTightenUb )
         {
             LPFormulator_LOG( Stringf( "Computing upperbound..." ).ascii() );
-            double ub = optimizeWithGurobi( *gurobi, MinOrMax::MAX, variableName,
+            double ub = optimizeWithGurobi( *lpSolver, MinOrMax::MAX, variableName,
                                             cutoffValue, &infeasible );
             LPFormulator_LOG( Stringf( "Upperbound computed %f", ub ).ascii() );
 
@@ -448,7 +453,7 @@ void LPFormulator::tightenSingleVariableBoundsWithLPRelaxation( ThreadArgument &
                 if ( cutoffInUse && ub < cutoffValue )
                 {
                     ++cutoffs;
-                    enqueueSolver( freeSolvers, gurobi );
+                    enqueueSolver( freeSolvers, lpSolver );
                     return;
                 }
             }
@@ -457,8 +462,8 @@ void LPFormulator::tightenSingleVariableBoundsWithLPRelaxation( ThreadArgument &
         if ( !skipTightenLb )
         {
             LPFormulator_LOG( Stringf( "Computing lowerbound..." ).ascii() );
-            gurobi->reset();
-            double lb = optimizeWithGurobi( *gurobi, MinOrMax::MIN, variableName,
+            lpSolver->reset();
+            double lb = optimizeWithGurobi( *lpSolver, MinOrMax::MIN, variableName,
                                             cutoffValue, &infeasible );
             LPFormulator_LOG( Stringf( "Lowerbound computed: %f", lb ).ascii() );
             // Store the new bound if it is tighter
@@ -480,7 +485,7 @@ void LPFormulator::tightenSingleVariableBoundsWithLPRelaxation( ThreadArgument &
                     ++cutoffs;
             }
         }
-        enqueueSolver( freeSolvers, gurobi );
+        enqueueSolver( freeSolvers, lpSolver );
     }
     catch ( boost::thread_interrupted& )
     {
@@ -489,7 +494,7 @@ void LPFormulator::tightenSingleVariableBoundsWithLPRelaxation( ThreadArgument &
 }
 
 void LPFormulator::createLPRelaxation( const Map<unsigned, Layer *> &layers,
-                                       GurobiWrapper &gurobi,
+                                       ILPSolver &lpSolver,
                                        unsigned lastLayer )
 {
     for ( const auto &layer : layers )
@@ -497,32 +502,33 @@ void LPFormulator::createLPRelaxation( const Map<unsigned, Layer *> &layers,
         if ( layer.second->getLayerIndex() > lastLayer )
             continue;
 
-        addLayerToModel( gurobi, layer.second );
+        addLayerToModel( lpSolver, layer.second );
     }
 }
 
-void LPFormulator::addLayerToModel( GurobiWrapper &gurobi, const Layer *layer )
+void LPFormulator::addLayerToModel( ILPSolver &lpSolver, const Layer *layer )
 {
     switch ( layer->getLayerType() )
     {
     case Layer::INPUT:
-        addInputLayerToLpRelaxation( gurobi, layer );
+        addInputLayerToLpRelaxation( lpSolver, layer );
         break;
 
     case Layer::RELU:
-        addReluLayerToLpRelaxation( gurobi, layer );
+        addReluLayerToLpRelaxation( lpSolver, layer );
         break;
 
     case Layer::WEIGHTED_SUM:
-        addWeightedSumLayerToLpRelaxation( gurobi, layer );
+    case Layer::CONVOLUTION:
+        addWeightedSumLayerToLpRelaxation( lpSolver, layer );
         break;
 
     case Layer::SIGN:
-        addSignLayerToLpRelaxation( gurobi, layer );
+        addSignLayerToLpRelaxation( lpSolver, layer );
         break;
 
     case Layer::MAX:
-        addMaxLayerToLpRelaxation( gurobi, layer );
+        addMaxLayerToLpRelaxation( lpSolver, layer );
         break;
 
     default:
@@ -531,19 +537,19 @@ void LPFormulator::addLayerToModel( GurobiWrapper &gurobi, const Layer *layer )
     }
 }
 
-void LPFormulator::addInputLayerToLpRelaxation( GurobiWrapper &gurobi,
+void LPFormulator::addInputLayerToLpRelaxation( ILPSolver &lpSolver,
                                                 const Layer *layer )
 {
     for ( unsigned i = 0; i < layer->getSize(); ++i )
     {
         unsigned variable = layer->neuronToVariable( i );
-        gurobi.addVariable( Stringf( "x%u", variable ),
+        lpSolver.addVariable( Stringf( "x%u", variable ),
                             layer->getLb( i ),
                             layer->getUb( i ) );
     }
 }
 
-void LPFormulator::addReluLayerToLpRelaxation( GurobiWrapper &gurobi,
+void LPFormulator::addReluLayerToLpRelaxation( ILPSolver &lpSolver,
                                                const Layer *layer )
 {
     for ( unsigned i = 0; i < layer->getSize(); ++i )
@@ -562,7 +568,7 @@ void LPFormulator::addReluLayerToLpRelaxation( GurobiWrapper &gurobi,
                 double sourceValue = sourceLayer->getEliminatedNeuronValue( sourceNeuron );
                 double targetValue = sourceValue > 0 ? sourceValue : 0;
 
-                gurobi.addVariable( Stringf( "x%u", targetVariable ),
+                lpSolver.addVariable( Stringf( "x%u", targetVariable ),
                                     targetValue,
                                     targetValue );
 
@@ -573,7 +579,7 @@ void LPFormulator::addReluLayerToLpRelaxation( GurobiWrapper &gurobi,
             double sourceLb = sourceLayer->getLb( sourceNeuron );
             double sourceUb = sourceLayer->getUb( sourceNeuron );
 
-            gurobi.addVariable( Stringf( "x%u", targetVariable ),
+            lpSolver.addVariable( Stringf( "x%u", targetVariable ),
                                 0,
                                 layer->getUb( i ) );
 
@@ -583,17 +589,17 @@ void LPFormulator::addReluLayerToLpRelaxation( GurobiWrapper &gurobi,
                 if ( sourceLb < 0 )
                     sourceLb = 0;
 
-                List<GurobiWrapper::Term> terms;
-                terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-                terms.append( GurobiWrapper::Term( -1, Stringf( "x%u", sourceVariable ) ) );
-                gurobi.addEqConstraint( terms, 0 );
+                List<ILPSolver::Term> terms;
+                terms.append( ILPSolver::Term( 1, Stringf( "x%u", targetVariable ) ) );
+                terms.append( ILPSolver::Term( -1, Stringf( "x%u", sourceVariable ) ) );
+                lpSolver.addEqConstraint( terms, 0 );
             }
             else if ( !FloatUtils::isPositive( sourceUb ) )
             {
                 // The ReLU is inactive, y = 0
-                List<GurobiWrapper::Term> terms;
-                terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-                gurobi.addEqConstraint( terms, 0 );
+                List<ILPSolver::Term> terms;
+                terms.append( ILPSolver::Term( 1, Stringf( "x%u", targetVariable ) ) );
+                lpSolver.addEqConstraint( terms, 0 );
             }
             else
             {
@@ -608,15 +614,15 @@ void LPFormulator::addReluLayerToLpRelaxation( GurobiWrapper &gurobi,
                 */
 
                 // y >= 0
-                List<GurobiWrapper::Term> terms;
-                terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-                gurobi.addGeqConstraint( terms, 0 );
+                List<ILPSolver::Term> terms;
+                terms.append( ILPSolver::Term( 1, Stringf( "x%u", targetVariable ) ) );
+                lpSolver.addGeqConstraint( terms, 0 );
 
                 // y >= x, i.e. y - x >= 0
                 terms.clear();
-                terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-                terms.append( GurobiWrapper::Term( -1, Stringf( "x%u", sourceVariable ) ) );
-                gurobi.addGeqConstraint( terms, 0 );
+                terms.append( ILPSolver::Term( 1, Stringf( "x%u", targetVariable ) ) );
+                terms.append( ILPSolver::Term( -1, Stringf( "x%u", sourceVariable ) ) );
+                lpSolver.addGeqConstraint( terms, 0 );
 
                 /*
                          u        ul
@@ -624,15 +630,15 @@ void LPFormulator::addReluLayerToLpRelaxation( GurobiWrapper &gurobi,
                        u - l     u - l
                 */
                 terms.clear();
-                terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-                terms.append( GurobiWrapper::Term( -sourceUb / ( sourceUb - sourceLb ), Stringf( "x%u", sourceVariable ) ) );
-                gurobi.addLeqConstraint( terms, ( -sourceUb * sourceLb ) / ( sourceUb - sourceLb ) );
+                terms.append( ILPSolver::Term( 1, Stringf( "x%u", targetVariable ) ) );
+                terms.append( ILPSolver::Term( -sourceUb / ( sourceUb - sourceLb ), Stringf( "x%u", sourceVariable ) ) );
+                lpSolver.addLeqConstraint( terms, ( -sourceUb * sourceLb ) / ( sourceUb - sourceLb ) );
             }
         }
     }
 }
 
-void LPFormulator::addSignLayerToLpRelaxation( GurobiWrapper &gurobi,
+void LPFormulator::addSignLayerToLpRelaxation( ILPSolver &lpSolver,
                                                const Layer *layer )
 {
     for ( unsigned i = 0; i < layer->getSize(); ++i )
@@ -652,7 +658,7 @@ void LPFormulator::addSignLayerToLpRelaxation( GurobiWrapper &gurobi,
             double sourceValue = sourceLayer->getEliminatedNeuronValue( sourceNeuron );
             double targetValue = FloatUtils::isNegative( sourceValue ) ? -1 : 1;
 
-            gurobi.addVariable( Stringf( "x%u", targetVariable ),
+            lpSolver.addVariable( Stringf( "x%u", targetVariable ),
                                 targetValue,
                                 targetValue );
 
@@ -666,12 +672,12 @@ void LPFormulator::addSignLayerToLpRelaxation( GurobiWrapper &gurobi,
         if ( !FloatUtils::isNegative( sourceLb ) )
         {
             // The Sign is positive, y = 1
-            gurobi.addVariable( Stringf( "x%u", targetVariable ), 1, 1 );
+            lpSolver.addVariable( Stringf( "x%u", targetVariable ), 1, 1 );
         }
         else if ( FloatUtils::isNegative( sourceUb ) )
         {
             // The Sign is negative, y = -1
-            gurobi.addVariable( Stringf( "x%u", targetVariable ), -1, -1 );
+            lpSolver.addVariable( Stringf( "x%u", targetVariable ), -1, -1 );
         }
         else
         {
@@ -687,17 +693,17 @@ void LPFormulator::addSignLayerToLpRelaxation( GurobiWrapper &gurobi,
             */
 
             // -1 <= y <= 1
-            gurobi.addVariable( Stringf( "x%u", targetVariable ), -1, 1 );
+            lpSolver.addVariable( Stringf( "x%u", targetVariable ), -1, 1 );
 
             /*
                      2
               y <= ----- x + 1
                     - l
             */
-            List<GurobiWrapper::Term> terms;
-            terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-            terms.append( GurobiWrapper::Term( 2.0 / sourceLb, Stringf( "x%u", sourceVariable ) ) );
-            gurobi.addLeqConstraint( terms, 1 );
+            List<ILPSolver::Term> terms;
+            terms.append( ILPSolver::Term( 1, Stringf( "x%u", targetVariable ) ) );
+            terms.append( ILPSolver::Term( 2.0 / sourceLb, Stringf( "x%u", sourceVariable ) ) );
+            lpSolver.addLeqConstraint( terms, 1 );
 
             /*
                      2
@@ -705,14 +711,14 @@ void LPFormulator::addSignLayerToLpRelaxation( GurobiWrapper &gurobi,
                      u
             */
             terms.clear();
-            terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-            terms.append( GurobiWrapper::Term( -2.0 / sourceUb, Stringf( "x%u", sourceVariable ) ) );
-            gurobi.addGeqConstraint( terms, -1 );
+            terms.append( ILPSolver::Term( 1, Stringf( "x%u", targetVariable ) ) );
+            terms.append( ILPSolver::Term( -2.0 / sourceUb, Stringf( "x%u", sourceVariable ) ) );
+            lpSolver.addGeqConstraint( terms, -1 );
         }
     }
 }
 
-void LPFormulator::addMaxLayerToLpRelaxation( GurobiWrapper &gurobi,
+void LPFormulator::addMaxLayerToLpRelaxation( ILPSolver &lpSolver,
                                               const Layer *layer )
 {
     for ( unsigned i = 0; i < layer->getSize(); ++i )
@@ -721,7 +727,7 @@ void LPFormulator::addMaxLayerToLpRelaxation( GurobiWrapper &gurobi,
             continue;
 
         unsigned targetVariable = layer->neuronToVariable( i );
-        gurobi.addVariable( Stringf( "x%u", targetVariable ), layer->getLb( i ), layer->getUb( i ) );
+        lpSolver.addVariable( Stringf( "x%u", targetVariable ), layer->getLb( i ), layer->getUb( i ) );
 
         List<NeuronIndex> sources = layer->getActivationSources( i );
 
@@ -730,7 +736,7 @@ void LPFormulator::addMaxLayerToLpRelaxation( GurobiWrapper &gurobi,
 
         double maxConcreteUb = FloatUtils::negativeInfinity();
 
-        List<GurobiWrapper::Term> terms;
+        List<ILPSolver::Term> terms;
 
         for ( const auto &source : sources )
         {
@@ -750,9 +756,9 @@ void LPFormulator::addMaxLayerToLpRelaxation( GurobiWrapper &gurobi,
 
             // Target is at least source: target - source >= 0
             terms.clear();
-            terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-            terms.append( GurobiWrapper::Term( -1, Stringf( "x%u", sourceVariable ) ) );
-            gurobi.addGeqConstraint( terms, 0 );
+            terms.append( ILPSolver::Term( 1, Stringf( "x%u", targetVariable ) ) );
+            terms.append( ILPSolver::Term( -1, Stringf( "x%u", sourceVariable ) ) );
+            lpSolver.addGeqConstraint( terms, 0 );
 
             // Find maximal concrete upper bound
             double sourceUb = sourceLayer->getUb( sourceNeuron );
@@ -765,8 +771,8 @@ void LPFormulator::addMaxLayerToLpRelaxation( GurobiWrapper &gurobi,
             // At least one of the sources has a fixed value,
             // and this fixed value dominates other sources.
             terms.clear();
-            terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-            gurobi.addEqConstraint( terms, maxFixedSourceValue );
+            terms.append( ILPSolver::Term( 1, Stringf( "x%u", targetVariable ) ) );
+            lpSolver.addEqConstraint( terms, maxFixedSourceValue );
         }
         else
         {
@@ -774,19 +780,19 @@ void LPFormulator::addMaxLayerToLpRelaxation( GurobiWrapper &gurobi,
             if ( haveFixedSourceValue )
             {
                 terms.clear();
-                terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-                gurobi.addGeqConstraint( terms, maxFixedSourceValue );
+                terms.append( ILPSolver::Term( 1, Stringf( "x%u", targetVariable ) ) );
+                lpSolver.addGeqConstraint( terms, maxFixedSourceValue );
             }
 
             // Target must be smaller than greatest concrete upper bound
             terms.clear();
-            terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-            gurobi.addLeqConstraint( terms, maxConcreteUb );
+            terms.append( ILPSolver::Term( 1, Stringf( "x%u", targetVariable ) ) );
+            lpSolver.addLeqConstraint( terms, maxConcreteUb );
         }
     }
 }
 
-void LPFormulator::addWeightedSumLayerToLpRelaxation( GurobiWrapper &gurobi, const Layer *layer )
+void LPFormulator::addWeightedSumLayerToLpRelaxation( ILPSolver &lpSolver, const Layer *layer )
 {
     for ( unsigned i = 0; i < layer->getSize(); ++i )
     {
@@ -794,12 +800,12 @@ void LPFormulator::addWeightedSumLayerToLpRelaxation( GurobiWrapper &gurobi, con
         {
             unsigned variable = layer->neuronToVariable( i );
 
-            gurobi.addVariable( Stringf( "x%u", variable ),
+            lpSolver.addVariable( Stringf( "x%u", variable ),
                                 layer->getLb( i ),
                                 layer->getUb( i ) );
 
-            List<GurobiWrapper::Term> terms;
-            terms.append( GurobiWrapper::Term( -1, Stringf( "x%u", variable ) ) );
+            List<ILPSolver::Term> terms;
+            terms.append( ILPSolver::Term( -1, Stringf( "x%u", variable ) ) );
 
             double bias = -layer->getBias( i );
 
@@ -815,7 +821,7 @@ void LPFormulator::addWeightedSumLayerToLpRelaxation( GurobiWrapper &gurobi, con
                     {
                         Stringf sourceVariableName( "x%u",
                                                     sourceLayer->neuronToVariable( j ) );
-                        terms.append( GurobiWrapper::Term( weight, sourceVariableName ) );
+                        terms.append( ILPSolver::Term( weight, sourceVariableName ) );
                     }
                     else
                     {
@@ -824,7 +830,7 @@ void LPFormulator::addWeightedSumLayerToLpRelaxation( GurobiWrapper &gurobi, con
                 }
             }
 
-            gurobi.addEqConstraint( terms, bias );
+            lpSolver.addEqConstraint( terms, bias );
         }
     }
 }
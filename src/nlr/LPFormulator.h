@@ -16,7 +16,7 @@
 #ifndef __LPFormulator_h__
 #define __LPFormulator_h__
 
-#include "GurobiWrapper.h"
+#include "ILPSolver.h"
 #include "LayerOwner.h"
 #include "ParallelSolver.h"
 #include <climits>
@@ -65,15 +65,15 @@ public:
       tightening
     */
     void createLPRelaxation( const Map<unsigned, Layer *> &layers,
-                             GurobiWrapper &gurobi,
+                             ILPSolver &lpSolver,
                              unsigned lastLayer = UINT_MAX );
 
-    double solveLPRelaxation( GurobiWrapper &gurobi,
+    double solveLPRelaxation( ILPSolver &lpSolver,
                               const Map<unsigned, Layer *> &layers,
                               MinOrMax minOrMax, String variableName,
                               unsigned lastLayer = UINT_MAX );
 
-    void addLayerToModel( GurobiWrapper &gurobi, const Layer *layer );
+    void addLayerToModel( ILPSolver &lpSolver, const Layer *layer );
 
 private:
 
@@ -81,26 +81,26 @@ private:
     bool _cutoffInUse;
     double _cutoffValue;
 
-    void addInputLayerToLpRelaxation( GurobiWrapper &gurobi,
+    void addInputLayerToLpRelaxation( ILPSolver &lpSolver,
                                       const Layer *layer );
 
-    void addReluLayerToLpRelaxation( GurobiWrapper &gurobi,
+    void addReluLayerToLpRelaxation( ILPSolver &lpSolver,
                                      const Layer *layer );
 
-    void addSignLayerToLpRelaxation( GurobiWrapper &gurobi,
+    void addSignLayerToLpRelaxation( ILPSolver &lpSolver,
                                      const Layer *layer );
 
-    void addMaxLayerToLpRelaxation( GurobiWrapper &gurobi,
+    void addMaxLayerToLpRelaxation( ILPSolver &lpSolver,
                                      const Layer *layer );
 
-    void addWeightedSumLayerToLpRelaxation( GurobiWrapper &gurobi,
+    void addWeightedSumLayerToLpRelaxation( ILPSolver &lpSolver,
                                             const Layer *layer );
 
     /*
       Optimize for the min/max value of variableName with respect to the constraints
-      encoded in gurobi. If the query is infeasible, *infeasible is set to true.
+      encoded in the LP solver. If the query is infeasible, *infeasible is set to true.
     */
-    static double optimizeWithGurobi( GurobiWrapper &gurobi, MinOrMax minOrMax,
+    static double optimizeWithGurobi( ILPSolver &lpSolver, MinOrMax minOrMax,
                                       String variableName, double cutoffValue,
                                       std::atomic_bool *infeasible = NULL );
 
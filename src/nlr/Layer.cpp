@@ -13,6 +13,7 @@
 
  **/
 
+#include "GlobalConfiguration.h"
 #include "Layer.h"
 #include "Options.h"
 #include "SymbolicBoundTighteningType.h"
@@ -35,7 +36,13 @@ Layer::Layer( unsigned index, Type type, unsigned size, LayerOwner *layerOwner )
     , _size( size )
     , _layerOwner( layerOwner )
     , _bias( NULL )
+    , _sparseWeightsComputed( false )
+    , _kernel( NULL )
+    , _kernelSize( 0 )
     , _assignment( NULL )
+    , _batchAssignment( NULL )
+    , _batchSize( 0 )
+    , _batchCapacity( 0 )
     , _lb( NULL )
     , _ub( NULL )
     , _inputLayerSize( 0 )
@@ -53,7 +60,7 @@ Layer::Layer( unsigned index, Type type, unsigned size, LayerOwner *layerOwner )
 
 void Layer::allocateMemory()
 {
-    if ( _type == WEIGHTED_SUM )
+    if ( _type == WEIGHTED_SUM || _type == CONVOLUTION )
     {
         _bias = new double[_size];
         std::fill_n( _bias, _size, 0 );
@@ -67,40 +74,47 @@ void Layer::allocateMemory()
 
     _assignment = new double[_size];
 
-    _simulations.assign( _size, Vector<double>( Options::get()->getInt( Options::NUMBER_OF_SIMULATIONS ) ) );
-
     _inputLayerSize = ( _type == INPUT ) ? _size : _layerOwner->getLayer( 0 )->getSize();
     if ( Options::get()->getSymbolicBoundTighteningType() ==
          SymbolicBoundTighteningType::SYMBOLIC_BOUND_TIGHTENING )
-    {
-        _symbolicLb = new double[_size * _inputLayerSize];
-        _symbolicUb = new double[_size * _inputLayerSize];
+        allocateSymbolicMemoryIfNeeded();
+}
 
-        std::fill_n( _symbolicLb, _size * _inputLayerSize, 0 );
-        std::fill_n( _symbolicUb, _size * _inputLayerSize, 0 );
+void Layer::allocateSymbolicMemoryIfNeeded()
+{
+    if ( _symbolicLb )
+        return;
 
-        _symbolicLowerBias = new double[_size];
-        _symbolicUpperBias = new double[_size];
+    _symbolicLb = new double[_size * _inputLayerSize];
+    _symbolicUb = new double[_size * _inputLayerSize];
 
-        std::fill_n( _symbolicLowerBias, _size, 0 );
-        std::fill_n( _symbolicUpperBias, _size, 0 );
+    std::fill_n( _symbolicLb, _size * _inputLayerSize, 0 );
+    std::fill_n( _symbolicUb, _size * _inputLayerSize, 0 );
 
-        _symbolicLbOfLb = new double[_size];
-        _symbolicUbOfLb = new double[_size];
-        _symbolicLbOfUb = new double[_size];
-        _symbolicUbOfUb = new double[_size];
+    _symbolicLowerBias = new double[_size];
+    _symbolicUpperBias = new double[_size];
 
-        std::fill_n( _symbolicLbOfLb, _size, 0 );
-        std::fill_n( _symbolicUbOfLb, _size, 0 );
-        std::fill_n( _symbolicLbOfUb, _size, 0 );
-        std::fill_n( _symbolicUbOfUb, _size, 0 );
-    }
+    std::fill_n( _symbolicLowerBias, _size, 0 );
+    std::fill_n( _symbolicUpperBias, _size, 0 );
+
+    _symbolicLbOfLb = new double[_size];
+    _symbolicUbOfLb = new double[_size];
+    _symbolicLbOfUb = new double[_size];
+    _symbolicUbOfUb = new double[_size];
+
+    std::fill_n( _symbolicLbOfLb, _size, 0 );
+    std::fill_n( _symbolicUbOfLb, _size, 0 );
+    std::fill_n( _symbolicLbOfUb, _size, 0 );
+    std::fill_n( _symbolicUbOfUb, _size, 0 );
 }
 
 void Layer::setAssignment( const double *values )
 {
-    ASSERT( _eliminatedNeurons.empty() );
     memcpy( _assignment, values, _size * sizeof(double) );
+
+    // Eliminated neurons keep their set values
+    for ( const auto &eliminated : _eliminatedNeurons )
+        _assignment[eliminated.first] = eliminated.second;
 }
 
 const double *Layer::getAssignment() const
@@ -113,14 +127,47 @@ double Layer::getAssignment( unsigned neuron ) const
     return _assignment[neuron];
 }
 
-void Layer::setSimulations( const Vector<Vector<double>> *values )
+void Layer::setBatchAssignment( const double *values, unsigned batchSize )
 {
-    _simulations = *values;
+    allocateBatchMemory( batchSize );
+    memcpy( _batchAssignment, values, batchSize * _size * sizeof(double) );
+
+    // Eliminated neurons keep their set values
+    for ( const auto &eliminated : _eliminatedNeurons )
+    {
+        for ( unsigned k = 0; k < batchSize; ++k )
+            _batchAssignment[k * _size + eliminated.first] = eliminated.second;
+    }
 }
 
-const Vector<Vector<double>> *Layer::getSimulations() const
+const double *Layer::getBatchAssignment() const
 {
-    return &_simulations;
+    return _batchAssignment;
+}
+
+double Layer::getBatchAssignment( unsigned neuron, unsigned input ) const
+{
+    ASSERT( neuron < _size && input < _batchSize );
+    return _batchAssignment[input * _size + neuron];
+}
+
+unsigned Layer::getBatchSize() const
+{
+    return _batchSize;
+}
+
+void Layer::allocateBatchMemory( unsigned batchSize )
+{
+    if ( batchSize > _batchCapacity )
+    {
+        if ( _batchAssignment )
+            delete[] _batchAssignment;
+
+        _batchAssignment = new double[batchSize * _size];
+        _batchCapacity = batchSize;
+    }
+
+    _batchSize = batchSize;
 }
 
 void Layer::computeAssignment()
@@ -146,6 +193,12 @@ void Layer::computeAssignment()
         }
     }
 
+    else if ( _type == CONVOLUTION )
+    {
+        const Layer *sourceLayer = _layerOwner->getLayer( _sourceLayers.begin()->first );
+        computeConvolution( sourceLayer->getAssignment(), _assignment );
+    }
+
     else if ( _type == RELU )
     {
         for ( unsigned i = 0; i < _size; ++i )
@@ -207,82 +260,86 @@ void Layer::computeAssignment()
         _assignment[eliminated.first] = eliminated.second;
 }
 
-void Layer::computeSimulations()
+void Layer::computeBatchAssignment( unsigned batchSize )
 {
     ASSERT( _type != INPUT );
 
-    unsigned simulationSize = Options::get()->getInt( Options::NUMBER_OF_SIMULATIONS );
+    allocateBatchMemory( batchSize );
+
     if ( _type == WEIGHTED_SUM )
     {
-        // Process each of the source layers
+        // Initialize every row to the bias
+        for ( unsigned k = 0; k < batchSize; ++k )
+            memcpy( _batchAssignment + k * _size, _bias, sizeof(double) * _size );
+
+        // Each source layer adds the product of its batch and weights
         for ( auto &sourceLayerEntry : _sourceLayers )
         {
             const Layer *sourceLayer = _layerOwner->getLayer( sourceLayerEntry.first );
-            const Vector<Vector<double>> *sourceSimulations = sourceLayer->getSimulations();
+            ASSERT( sourceLayer->getBatchSize() == batchSize );
+
+            matrixMultiplication( sourceLayer->getBatchAssignment(),
+                                  _layerToWeights[sourceLayerEntry.first],
+                                  _batchAssignment,
+                                  batchSize,
+                                  sourceLayerEntry.second,
+                                  _size,
+                                  _layerOwner->getThreadPool() );
+        }
+    }
 
-            unsigned sourceSize = sourceLayerEntry.second;
-            const double *weights = _layerToWeights[sourceLayerEntry.first];
+    else if ( _type == CONVOLUTION )
+    {
+        const Layer *sourceLayer = _layerOwner->getLayer( _sourceLayers.begin()->first );
+        ASSERT( sourceLayer->getBatchSize() == batchSize );
 
-            for ( unsigned i = 0; i < _size; i++ )
-            {
-                for ( unsigned j = 0; j < simulationSize; ++j )
-                    _simulations[i][j] = _bias[i];
-            }
+        unsigned sourceSize = sourceLayer->getSize();
+        for ( unsigned k = 0; k < batchSize; ++k )
+            computeConvolution( sourceLayer->getBatchAssignment() + k * sourceSize,
+                                _batchAssignment + k * _size );
+    }
 
-            for ( unsigned i = 0; i < sourceSize; ++i )
-                for ( unsigned j = 0; j < simulationSize; ++j )
-                    for ( unsigned k = 0; k < _size; ++k )
-                        _simulations[k][j] += ( ( *sourceSimulations ).get( i ).get( j ) * weights[i * _size + k] );
-        }
-    } 
     else if ( _type == RELU )
     {
-        for ( unsigned i = 0; i < _size; ++i )
-        {
-            NeuronIndex sourceIndex = *_neuronToActivationSources[i].begin();            
-            const Vector<double> &simulations = ( *( _layerOwner->getLayer( sourceIndex._layer )->getSimulations() ) ).get( sourceIndex._neuron );
-            for ( unsigned j = 0; j < simulationSize; ++j )
-                _simulations[i][j] = FloatUtils::max( simulations.get( j ), 0 );
-        }
+        computeBatchActivation( batchSize, []( double value ) {
+                                               return FloatUtils::max( value, 0 );
+                                           } );
     }
+
     else if ( _type == ABSOLUTE_VALUE )
     {
-        for ( unsigned i = 0; i < _size; ++i )
-        {
-            NeuronIndex sourceIndex = *_neuronToActivationSources[i].begin();
-            const Vector<double> &simulations = ( *( _layerOwner->getLayer( sourceIndex._layer )->getSimulations() ) ).get( sourceIndex._neuron );
-            for ( unsigned j = 0; j < simulationSize; ++j ) 
-                _simulations[i][j] = FloatUtils::abs( simulations.get( j ) );
-        }
+        computeBatchActivation( batchSize, []( double value ) {
+                                               return FloatUtils::abs( value );
+                                           } );
     }
+
+    else if ( _type == SIGN )
+    {
+        computeBatchActivation( batchSize, []( double value ) {
+                                               return FloatUtils::isNegative( value ) ? -1.0 : 1.0;
+                                           } );
+    }
+
     else if ( _type == MAX )
     {
-        for ( unsigned i = 0; i < _size; ++i )
+        for ( unsigned k = 0; k < batchSize; ++k )
         {
-            for ( unsigned j = 0; j < simulationSize; ++j )
+            double *assignment = _batchAssignment + k * _size;
+            for ( unsigned i = 0; i < _size; ++i )
             {
-                _simulations[i][j] = FloatUtils::negativeInfinity();
+                assignment[i] = FloatUtils::negativeInfinity();
 
                 for ( const auto &input : _neuronToActivationSources[i] )
                 {
-                    //double value = ( *( _layerOwner->getLayer( input._layer )->getSimulations() ) )[input._neuron][j];
-                    double value = ( *( _layerOwner->getLayer( input._layer )->getSimulations() ) ).get( input._neuron ).get( j );
-                    if ( value > _simulations[i][j] )
-                        _simulations[i][j] = value;
+                    const Layer *sourceLayer = _layerOwner->getLayer( input._layer );
+                    double value = sourceLayer->getBatchAssignment()[k * sourceLayer->getSize() + input._neuron];
+                    if ( value > assignment[i] )
+                        assignment[i] = value;
                 }
             }
         }
     }
-    else if ( _type == SIGN )
-    {
-        for ( unsigned i = 0; i < _size; ++i )
-        {
-            NeuronIndex sourceIndex = *_neuronToActivationSources[i].begin();
-            const Vector<double> &simulations = ( *( _layerOwner->getLayer( sourceIndex._layer )->getSimulations() ) ).get( i );
-            for ( unsigned j = 0; j < simulationSize; ++j )
-                _simulations[i][j] = FloatUtils::isNegative( simulations.get( j ) ) ? -1 : 1;
-        }
-    }
+
     else
     {
         printf( "Error! Neuron type %u unsupported\n", _type );
@@ -294,11 +351,66 @@ void Layer::computeSimulations()
     // prevail.
     for ( const auto &eliminated : _eliminatedNeurons )
     {
-        for ( unsigned j = 0; j < simulationSize; ++j )
-            _simulations[eliminated.first][j] = eliminated.second;
+        for ( unsigned k = 0; k < batchSize; ++k )
+            _batchAssignment[k * _size + eliminated.first] = eliminated.second;
     }
 }
 
+template <typename Activation>
+void Layer::computeBatchActivation( unsigned batchSize, Activation activation )
+{
+    const Layer *sourceLayer = getElementwiseSourceLayer();
+    if ( sourceLayer )
+    {
+        // A single pass over the whole batch
+        const double *source = sourceLayer->getBatchAssignment();
+        unsigned batchEntries = batchSize * _size;
+        for ( unsigned j = 0; j < batchEntries; ++j )
+            _batchAssignment[j] = activation( source[j] );
+        return;
+    }
+
+    for ( unsigned i = 0; i < _size; ++i )
+    {
+        NeuronIndex sourceIndex = *_neuronToActivationSources[i].begin();
+        const Layer *neuronSourceLayer = _layerOwner->getLayer( sourceIndex._layer );
+        const double *source = neuronSourceLayer->getBatchAssignment() + sourceIndex._neuron;
+        unsigned sourceSize = neuronSourceLayer->getSize();
+
+        for ( unsigned k = 0; k < batchSize; ++k )
+            _batchAssignment[k * _size + i] = activation( source[k * sourceSize] );
+    }
+}
+
+const Layer *Layer::getElementwiseSourceLayer() const
+{
+    const Layer *sourceLayer = NULL;
+    for ( unsigned i = 0; i < _size; ++i )
+    {
+        if ( !_neuronToActivationSources.exists( i ) )
+            return NULL;
+
+        const List<NeuronIndex> &sources = _neuronToActivationSources[i];
+        if ( sources.size() != 1 )
+            return NULL;
+
+        NeuronIndex sourceIndex = *sources.begin();
+        if ( sourceIndex._neuron != i )
+            return NULL;
+
+        if ( !sourceLayer )
+        {
+            sourceLayer = _layerOwner->getLayer( sourceIndex._layer );
+            if ( sourceLayer->getSize() != _size )
+                return NULL;
+        }
+        else if ( sourceLayer->getLayerIndex() != sourceIndex._layer )
+            return NULL;
+    }
+
+    return sourceLayer;
+}
+
 void Layer::addSourceLayer( unsigned layerNumber, unsigned layerSize )
 {
     ASSERT( _type != INPUT );
@@ -306,10 +418,18 @@ void Layer::addSourceLayer( unsigned layerNumber, unsigned layerSize )
     if ( _sourceLayers.exists( layerNumber ) )
         return;
 
+    // A convolution has a single source layer
+    ASSERT( _type != CONVOLUTION || _sourceLayers.empty() );
+
     _sourceLayers[layerNumber] = layerSize;
 
+    if ( _type == CONVOLUTION )
+        invalidateSparseWeights();
+
     if ( _type == WEIGHTED_SUM )
     {
+        invalidateSparseWeights();
+
         _layerToWeights[layerNumber] = new double[layerSize * _size];
         _layerToPositiveWeights[layerNumber] = new double[layerSize * _size];
         _layerToNegativeWeights[layerNumber] = new double[layerSize * _size];
@@ -339,6 +459,8 @@ void Layer::removeSourceLayer( unsigned sourceLayer )
     delete[] _layerToPositiveWeights[sourceLayer];
     delete[] _layerToNegativeWeights[sourceLayer];
 
+    invalidateSparseWeights();
+
     _sourceLayers.erase( sourceLayer );
     _layerToWeights.erase( sourceLayer );
     _layerToPositiveWeights.erase( sourceLayer );
@@ -347,8 +469,11 @@ void Layer::removeSourceLayer( unsigned sourceLayer )
 
 void Layer::setWeight( unsigned sourceLayer, unsigned sourceNeuron, unsigned targetNeuron, double weight )
 {
+    ASSERT( _type == WEIGHTED_SUM );
+
     unsigned index = sourceNeuron * _size + targetNeuron;
     _layerToWeights[sourceLayer][index] = weight;
+    invalidateSparseWeights();
 
     if ( weight > 0 )
     {
@@ -366,6 +491,33 @@ double Layer::getWeight( unsigned sourceLayer,
                          unsigned sourceNeuron,
                          unsigned targetNeuron ) const
 {
+    if ( _type == CONVOLUTION )
+    {
+        ASSERT( _sourceLayers.exists( sourceLayer ) );
+
+        const ConvolutionParameters &parameters = _convolutionParameters;
+        unsigned outputHeight = parameters.getOutputHeight();
+        unsigned outputWidth = parameters.getOutputWidth();
+
+        unsigned outputChannel = targetNeuron / ( outputHeight * outputWidth );
+        unsigned outputRow = ( targetNeuron / outputWidth ) % outputHeight;
+        unsigned outputColumn = targetNeuron % outputWidth;
+
+        unsigned inputChannel = sourceNeuron / ( parameters._inputHeight * parameters._inputWidth );
+        unsigned inputRow = ( sourceNeuron / parameters._inputWidth ) % parameters._inputHeight;
+        unsigned inputColumn = sourceNeuron % parameters._inputWidth;
+
+        // The position of the source neuron within the receptive field
+        int row = (int)( inputRow + parameters._paddingHeight ) - (int)( outputRow * parameters._strideHeight );
+        int column = (int)( inputColumn + parameters._paddingWidth ) - (int)( outputColumn * parameters._strideWidth );
+
+        if ( row < 0 || row >= (int)parameters._kernelHeight ||
+             column < 0 || column >= (int)parameters._kernelWidth )
+            return 0;
+
+        return _kernel[getKernelIndex( outputChannel, inputChannel, row, column )];
+    }
+
     unsigned index = sourceNeuron * _size + targetNeuron;
     return _layerToWeights[sourceLayer][index];
 }
@@ -400,6 +552,129 @@ double *Layer::getBiases() const
     return _bias;
 }
 
+void Layer::setConvolutionParameters( const ConvolutionParameters &parameters )
+{
+    ASSERT( _type == CONVOLUTION );
+    ASSERT( parameters._strideHeight > 0 && parameters._strideWidth > 0 );
+    ASSERT( parameters._inputHeight + 2 * parameters._paddingHeight >= parameters._kernelHeight );
+    ASSERT( parameters._inputWidth + 2 * parameters._paddingWidth >= parameters._kernelWidth );
+    ASSERT( _size == parameters._outputChannels *
+            parameters.getOutputHeight() * parameters.getOutputWidth() );
+
+    _convolutionParameters = parameters;
+
+    if ( _kernel )
+        delete[] _kernel;
+
+    _kernelSize = parameters._outputChannels * parameters._inputChannels *
+        parameters._kernelHeight * parameters._kernelWidth;
+    _kernel = new double[_kernelSize];
+    std::fill_n( _kernel, _kernelSize, 0 );
+
+    invalidateSparseWeights();
+}
+
+const Layer::ConvolutionParameters &Layer::getConvolutionParameters() const
+{
+    return _convolutionParameters;
+}
+
+unsigned Layer::getKernelIndex( unsigned outputChannel,
+                                unsigned inputChannel,
+                                unsigned row,
+                                unsigned column ) const
+{
+    const ConvolutionParameters &parameters = _convolutionParameters;
+    ASSERT( outputChannel < parameters._outputChannels );
+    ASSERT( inputChannel < parameters._inputChannels );
+    ASSERT( row < parameters._kernelHeight );
+    ASSERT( column < parameters._kernelWidth );
+
+    return ( ( outputChannel * parameters._inputChannels + inputChannel ) *
+             parameters._kernelHeight + row ) * parameters._kernelWidth + column;
+}
+
+void Layer::setKernelWeight( unsigned outputChannel,
+                             unsigned inputChannel,
+                             unsigned row,
+                             unsigned column,
+                             double weight )
+{
+    ASSERT( _type == CONVOLUTION );
+    _kernel[getKernelIndex( outputChannel, inputChannel, row, column )] = weight;
+    invalidateSparseWeights();
+}
+
+double Layer::getKernelWeight( unsigned outputChannel,
+                               unsigned inputChannel,
+                               unsigned row,
+                               unsigned column ) const
+{
+    ASSERT( _type == CONVOLUTION );
+    return _kernel[getKernelIndex( outputChannel, inputChannel, row, column )];
+}
+
+void Layer::setChannelBias( unsigned outputChannel, double bias )
+{
+    ASSERT( _type == CONVOLUTION );
+
+    unsigned channelSize =
+        _convolutionParameters.getOutputHeight() * _convolutionParameters.getOutputWidth();
+    std::fill_n( _bias + outputChannel * channelSize, channelSize, bias );
+}
+
+template <typename Visitor>
+void Layer::forEachConvolutionWeight( unsigned neuron, Visitor visit ) const
+{
+    const ConvolutionParameters &parameters = _convolutionParameters;
+    unsigned outputHeight = parameters.getOutputHeight();
+    unsigned outputWidth = parameters.getOutputWidth();
+
+    unsigned outputChannel = neuron / ( outputHeight * outputWidth );
+    unsigned outputRow = ( neuron / outputWidth ) % outputHeight;
+    unsigned outputColumn = neuron % outputWidth;
+
+    // The top-left corner of the receptive field, which may lie in the padding
+    int firstRow = (int)( outputRow * parameters._strideHeight ) - (int)parameters._paddingHeight;
+    int firstColumn = (int)( outputColumn * parameters._strideWidth ) - (int)parameters._paddingWidth;
+
+    for ( unsigned inputChannel = 0; inputChannel < parameters._inputChannels; ++inputChannel )
+    {
+        const double *kernel = _kernel + getKernelIndex( outputChannel, inputChannel, 0, 0 );
+        unsigned channelStart = inputChannel * parameters._inputHeight * parameters._inputWidth;
+
+        for ( unsigned row = 0; row < parameters._kernelHeight; ++row )
+        {
+            int inputRow = firstRow + (int)row;
+            if ( inputRow < 0 || inputRow >= (int)parameters._inputHeight )
+                continue;
+
+            for ( unsigned column = 0; column < parameters._kernelWidth; ++column )
+            {
+                int inputColumn = firstColumn + (int)column;
+                if ( inputColumn < 0 || inputColumn >= (int)parameters._inputWidth )
+                    continue;
+
+                visit( channelStart + inputRow * parameters._inputWidth + inputColumn,
+                       kernel[row * parameters._kernelWidth + column] );
+            }
+        }
+    }
+}
+
+void Layer::computeConvolution( const double *sourceAssignment, double *assignment ) const
+{
+    for ( unsigned i = 0; i < _size; ++i )
+    {
+        double value = _bias[i];
+        forEachConvolutionWeight( i, [&]( unsigned sourceNeuron, double weight )
+                                     {
+                                         value += weight * sourceAssignment[sourceNeuron];
+                                     } );
+        assignment[i] = value;
+    }
+}
+
 void Layer::addActivationSource( unsigned sourceLayer, unsigned sourceNeuron, unsigned targetNeuron )
 {
     ASSERT( _type == RELU || _type == ABSOLUTE_VALUE || _type == MAX || _type == SIGN );
@@ -505,6 +780,10 @@ void Layer::computeIntervalArithmeticBounds()
         computeIntervalArithmeticBoundsForWeightedSum();
         break;
 
+    case CONVOLUTION:
+        computeIntervalArithmeticBoundsForConvolution();
+        break;
+
     case RELU:
         computeIntervalArithmeticBoundsForRelu();
         break;
@@ -528,24 +807,35 @@ void Layer::computeIntervalArithmeticBounds()
 
 void Layer::computeIntervalArithmeticBoundsForWeightedSum()
 {
-    double *newLb = new double[_size];
-    double *newUb = new double[_size];
+    unsigned sourceNeurons = 0;
+    for ( const auto &sourceLayerEntry : _sourceLayers )
+        sourceNeurons += sourceLayerEntry.second;
 
-    for ( unsigned i = 0; i < _size; ++i )
-    {
-        newLb[i] = _bias[i];
-        newUb[i] = _bias[i];
-    }
+    computeInNeuronBlocks( sourceNeurons,
+                           [this]( unsigned begin, unsigned end, List<Tightening> &tightenings )
+                           {
+                               computeIntervalArithmeticBoundsForWeightedSum( begin, end, tightenings );
+                           } );
+}
 
-    for ( const auto &sourceLayerEntry : _sourceLayers )
+void Layer::computeIntervalArithmeticBoundsForWeightedSum( unsigned begin, unsigned end,
+                                                           List<Tightening> &tightenings )
+{
+    for ( unsigned i = begin; i < end; ++i )
     {
-        unsigned sourceLayerIndex = sourceLayerEntry.first;
-        unsigned sourceLayerSize = sourceLayerEntry.second;
-        const Layer *sourceLayer = _layerOwner->getLayer( sourceLayerIndex );
-        const double *weights = _layerToWeights[sourceLayerIndex];
+        if ( _eliminatedNeurons.exists( i ) )
+            continue;
 
-        for ( unsigned i = 0; i < _size; ++i )
+        double newLb = _bias[i];
+        double newUb = _bias[i];
+
+        for ( const auto &sourceLayerEntry : _sourceLayers )
         {
+            unsigned sourceLayerIndex = sourceLayerEntry.first;
+            unsigned sourceLayerSize = sourceLayerEntry.second;
+            const Layer *sourceLayer = _layerOwner->getLayer( sourceLayerIndex );
+            const double *weights = _layerToWeights[sourceLayerIndex];
+
             for ( unsigned j = 0; j < sourceLayerSize; ++j )
             {
                 double previousLb = sourceLayer->getLb( j );
@@ -554,42 +844,96 @@ void Layer::computeIntervalArithmeticBoundsForWeightedSum()
 
                 if ( weight > 0 )
                 {
-                    newLb[i] += weight * previousLb;
-                    newUb[i] += weight * previousUb;
+                    newLb += weight * previousLb;
+                    newUb += weight * previousUb;
                 }
                 else
                 {
-                    newLb[i] += weight * previousUb;
-                    newUb[i] += weight * previousLb;
+                    newLb += weight * previousUb;
+                    newUb += weight * previousLb;
                 }
             }
         }
+
+        if ( newLb > _lb[i] )
+        {
+            _lb[i] = newLb;
+            tightenings.append( Tightening( _neuronToVariable[i], _lb[i], Tightening::LB ) );
+        }
+        if ( newUb < _ub[i] )
+        {
+            _ub[i] = newUb;
+            tightenings.append( Tightening( _neuronToVariable[i], _ub[i], Tightening::UB ) );
+        }
     }
+}
 
-    for ( unsigned i = 0; i < _size; ++i )
+void Layer::computeIntervalArithmeticBoundsForConvolution()
+{
+    const ConvolutionParameters &parameters = _convolutionParameters;
+    computeInNeuronBlocks( parameters._inputChannels * parameters._kernelHeight * parameters._kernelWidth,
+                           [this]( unsigned begin, unsigned end, List<Tightening> &tightenings )
+                           {
+                               computeIntervalArithmeticBoundsForConvolution( begin, end, tightenings );
+                           } );
+}
+
+void Layer::computeIntervalArithmeticBoundsForConvolution( unsigned begin, unsigned end,
+                                                           List<Tightening> &tightenings )
+{
+    const Layer *sourceLayer = _layerOwner->getLayer( _sourceLayers.begin()->first );
+    const double *sourceLbs = sourceLayer->getLbs();
+    const double *sourceUbs = sourceLayer->getUbs();
+
+    for ( unsigned i = begin; i < end; ++i )
     {
         if ( _eliminatedNeurons.exists( i ) )
             continue;
 
-        if ( newLb[i] > _lb[i] )
+        double newLb = _bias[i];
+        double newUb = _bias[i];
+
+        // Only the receptive field of the neuron contributes
+        forEachConvolutionWeight( i, [&]( unsigned sourceNeuron, double weight )
+                                     {
+                                         if ( weight > 0 )
+                                         {
+                                             newLb += weight * sourceLbs[sourceNeuron];
+                                             newUb += weight * sourceUbs[sourceNeuron];
+                                         }
+                                         else
+                                         {
+                                             newLb += weight * sourceUbs[sourceNeuron];
+                                             newUb += weight * sourceLbs[sourceNeuron];
+                                         }
+                                     } );
+
+        if ( newLb > _lb[i] )
         {
-            _lb[i] = newLb[i];
-            _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _lb[i], Tightening::LB ) );
+            _lb[i] = newLb;
+            tightenings.append( Tightening( _neuronToVariable[i], _lb[i], Tightening::LB ) );
         }
-        if ( newUb[i] < _ub[i] )
+        if ( newUb < _ub[i] )
         {
-            _ub[i] = newUb[i];
-            _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _ub[i], Tightening::UB ) );
+            _ub[i] = newUb;
+            tightenings.append( Tightening( _neuronToVariable[i], _ub[i], Tightening::UB ) );
         }
     }
-
-    delete[] newLb;
-    delete[] newUb;
 }
 
 void Layer::computeIntervalArithmeticBoundsForRelu()
 {
-    for ( unsigned i = 0; i < _size; ++i )
+    computeInNeuronBlocks( 1,
+                           [this]( unsigned begin, unsigned end, List<Tightening> &tightenings )
+                           {
+                               computeIntervalArithmeticBoundsForRelu( begin, end, tightenings );
+                           } );
+}
+
+void Layer::computeIntervalArithmeticBoundsForRelu( unsigned begin, unsigned end,
+                                                    List<Tightening> &tightenings )
+{
+    for ( unsigned i = begin; i < end; ++i )
     {
         if ( _eliminatedNeurons.exists( i ) )
             continue;
@@ -606,19 +950,29 @@ void Layer::computeIntervalArithmeticBoundsForRelu()
         if ( lb > _lb[i] )
         {
             _lb[i] = lb;
-            _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _lb[i], Tightening::LB ) );
+            tightenings.append( Tightening( _neuronToVariable[i], _lb[i], Tightening::LB ) );
         }
         if ( ub < _ub[i] )
         {
             _ub[i] = ub;
-            _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _ub[i], Tightening::UB ) );
+            tightenings.append( Tightening( _neuronToVariable[i], _ub[i], Tightening::UB ) );
         }
     }
 }
 
 void Layer::computeIntervalArithmeticBoundsForAbs()
 {
-    for ( unsigned i = 0; i < _size; ++i )
+    computeInNeuronBlocks( 1,
+                           [this]( unsigned begin, unsigned end, List<Tightening> &tightenings )
+                           {
+                               computeIntervalArithmeticBoundsForAbs( begin, end, tightenings );
+                           } );
+}
+
+void Layer::computeIntervalArithmeticBoundsForAbs( unsigned begin, unsigned end,
+                                                   List<Tightening> &tightenings )
+{
+    for ( unsigned i = begin; i < end; ++i )
     {
         if ( _eliminatedNeurons.exists( i ) )
             continue;
@@ -634,12 +988,12 @@ void Layer::computeIntervalArithmeticBoundsForAbs()
             if ( lb > _lb[i] )
             {
                 _lb[i] = lb;
-                _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _lb[i], Tightening::LB ) );
+                tightenings.append( Tightening( _neuronToVariable[i], _lb[i], Tightening::LB ) );
             }
             if ( ub < _ub[i] )
             {
                 _ub[i] = ub;
-                _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _ub[i], Tightening::UB ) );
+                tightenings.append( Tightening( _neuronToVariable[i], _ub[i], Tightening::UB ) );
             }
         }
         else if ( ub < 0 )
@@ -647,12 +1001,12 @@ void Layer::computeIntervalArithmeticBoundsForAbs()
             if ( -ub > _lb[i] )
             {
                 _lb[i] = -ub;
-                _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _lb[i], Tightening::LB ) );
+                tightenings.append( Tightening( _neuronToVariable[i], _lb[i], Tightening::LB ) );
             }
             if ( -lb < _ub[i] )
             {
                 _ub[i] = -lb;
-                _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _ub[i], Tightening::UB ) );
+                tightenings.append( Tightening( _neuronToVariable[i], _ub[i], Tightening::UB ) );
             }
         }
         else
@@ -661,13 +1015,13 @@ void Layer::computeIntervalArithmeticBoundsForAbs()
             if ( _lb[i] < 0 )
             {
                 _lb[i] = 0;
-                _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _lb[i], Tightening::LB ) );
+                tightenings.append( Tightening( _neuronToVariable[i], _lb[i], Tightening::LB ) );
             }
 
             if ( FloatUtils::max( ub, -lb ) < _ub[i] )
             {
                 _ub[i] = FloatUtils::max( ub, -lb );
-                _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _ub[i], Tightening::UB ) );
+                tightenings.append( Tightening( _neuronToVariable[i], _ub[i], Tightening::UB ) );
             }
         }
     }
@@ -706,6 +1060,10 @@ void Layer::computeIntervalArithmeticBoundsForSign()
 
 void Layer::computeSymbolicBounds()
 {
+    // The memory may not have been allocated, if the symbolic bound
+    // tightening type was set per engine rather than in the options
+    allocateSymbolicMemoryIfNeeded();
+
     switch ( _type )
     {
 
@@ -714,6 +1072,8 @@ void Layer::computeSymbolicBounds()
         break;
 
     case WEIGHTED_SUM:
+    case CONVOLUTION:
+        // Convolutions always have sparse weights
         computeSymbolicBoundsForWeightedSum();
         break;
 
@@ -805,7 +1165,17 @@ void Layer::computeSymbolicBoundsForRelu()
     std::fill_n( _symbolicLb, _size * _inputLayerSize, 0 );
     std::fill_n( _symbolicUb, _size * _inputLayerSize, 0 );
 
-    for ( unsigned i = 0; i < _size; ++i )
+    computeInNeuronBlocks( _inputLayerSize,
+                           [this]( unsigned begin, unsigned end, List<Tightening> &tightenings )
+                           {
+                               computeSymbolicBoundsForRelu( begin, end, tightenings );
+                           } );
+}
+
+void Layer::computeSymbolicBoundsForRelu( unsigned begin, unsigned end,
+                                          List<Tightening> &tightenings )
+{
+    for ( unsigned i = begin; i < end; ++i )
     {
         if ( _eliminatedNeurons.exists( i ) )
         {
@@ -819,7 +1189,7 @@ void Layer::computeSymbolicBoundsForRelu()
         }
     }
 
-    for ( unsigned i = 0; i < _size; ++i )
+    for ( unsigned i = begin; i < end; ++i )
     {
         if ( _eliminatedNeurons.exists( i ) )
             continue;
@@ -953,13 +1323,13 @@ void Layer::computeSymbolicBoundsForRelu()
         if ( _lb[i] < _symbolicLbOfLb[i] )
         {
             _lb[i] = _symbolicLbOfLb[i];
-            _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _lb[i], Tightening::LB ) );
+            tightenings.append( Tightening( _neuronToVariable[i], _lb[i], Tightening::LB ) );
         }
 
         if ( _ub[i] > _symbolicUbOfUb[i] )
         {
             _ub[i] = _symbolicUbOfUb[i];
-            _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _ub[i], Tightening::UB ) );
+            tightenings.append( Tightening( _neuronToVariable[i], _ub[i], Tightening::UB ) );
         }
     }
 }
@@ -969,7 +1339,17 @@ void Layer::computeSymbolicBoundsForSign()
     std::fill_n( _symbolicLb, _size * _inputLayerSize, 0 );
     std::fill_n( _symbolicUb, _size * _inputLayerSize, 0 );
 
-    for ( unsigned i = 0; i < _size; ++i )
+    computeInNeuronBlocks( _inputLayerSize,
+                           [this]( unsigned begin, unsigned end, List<Tightening> &tightenings )
+                           {
+                               computeSymbolicBoundsForSign( begin, end, tightenings );
+                           } );
+}
+
+void Layer::computeSymbolicBoundsForSign( unsigned begin, unsigned end,
+                                          List<Tightening> &tightenings )
+{
+    for ( unsigned i = begin; i < end; ++i )
     {
         // Eliminate neurons are skipped
         if ( _eliminatedNeurons.exists( i ) )
@@ -1139,13 +1519,13 @@ void Layer::computeSymbolicBoundsForSign()
         if ( _lb[i] < _symbolicLbOfLb[i] )
         {
             _lb[i] = _symbolicLbOfLb[i];
-            _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _lb[i], Tightening::LB ) );
+            tightenings.append( Tightening( _neuronToVariable[i], _lb[i], Tightening::LB ) );
         }
 
         if ( _ub[i] > _symbolicUbOfUb[i] )
         {
             _ub[i] = _symbolicUbOfUb[i];
-            _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _ub[i], Tightening::UB ) );
+            tightenings.append( Tightening( _neuronToVariable[i], _ub[i], Tightening::UB ) );
         }
     }
 }
@@ -1155,7 +1535,17 @@ void Layer::computeSymbolicBoundsForAbsoluteValue()
     std::fill_n( _symbolicLb, _size * _inputLayerSize, 0 );
     std::fill_n( _symbolicUb, _size * _inputLayerSize, 0 );
 
-    for ( unsigned i = 0; i < _size; ++i )
+    computeInNeuronBlocks( _inputLayerSize,
+                           [this]( unsigned begin, unsigned end, List<Tightening> &tightenings )
+                           {
+                               computeSymbolicBoundsForAbsoluteValue( begin, end, tightenings );
+                           } );
+}
+
+void Layer::computeSymbolicBoundsForAbsoluteValue( unsigned begin, unsigned end,
+                                                   List<Tightening> &tightenings )
+{
+    for ( unsigned i = begin; i < end; ++i )
     {
         if ( _eliminatedNeurons.exists( i ) )
         {
@@ -1267,13 +1657,13 @@ void Layer::computeSymbolicBoundsForAbsoluteValue()
         if ( _lb[i] < _symbolicLbOfLb[i] )
         {
             _lb[i] = _symbolicLbOfLb[i];
-            _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _lb[i], Tightening::LB ) );
+            tightenings.append( Tightening( _neuronToVariable[i], _lb[i], Tightening::LB ) );
         }
 
         if ( _ub[i] > _symbolicUbOfUb[i] )
         {
             _ub[i] = _symbolicUbOfUb[i];
-            _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _ub[i], Tightening::UB ) );
+            tightenings.append( Tightening( _neuronToVariable[i], _ub[i], Tightening::UB ) );
         }
     }
 }
@@ -1302,6 +1692,9 @@ void Layer::computeSymbolicBoundsForWeightedSum()
         }
     }
 
+    if ( !_sparseWeightsComputed )
+        computeSparseWeights();
+
     for ( const auto &sourceLayerEntry : _sourceLayers )
     {
         unsigned sourceLayerIndex = sourceLayerEntry.first;
@@ -1315,18 +1708,78 @@ void Layer::computeSymbolicBoundsForWeightedSum()
           newLB = oldUB * negWeights + oldLB * posWeights
         */
 
-        matrixMultiplication( sourceLayer->getSymbolicUb(), _layerToPositiveWeights[sourceLayerIndex],
-                              _symbolicUb, _inputLayerSize,
-                              sourceLayerSize, _size );
-        matrixMultiplication( sourceLayer->getSymbolicLb(), _layerToNegativeWeights[sourceLayerIndex],
-                              _symbolicUb, _inputLayerSize,
-                              sourceLayerSize, _size );
-        matrixMultiplication( sourceLayer->getSymbolicLb(), _layerToPositiveWeights[sourceLayerIndex],
-                              _symbolicLb, _inputLayerSize,
-                              sourceLayerSize, _size);
-        matrixMultiplication( sourceLayer->getSymbolicUb(), _layerToNegativeWeights[sourceLayerIndex],
-                              _symbolicLb, _inputLayerSize,
-                              sourceLayerSize, _size);
+        if ( _layerToSparseWeights.exists( sourceLayerIndex ) )
+        {
+            /*
+              For sparse weights, compute all four products in a
+              single pass over the non-zero weights, one row of the
+              symbolic bounds (i.e., one input variable) at a time.
+            */
+            SparseWeights &sparseWeights = _layerToSparseWeights[sourceLayerIndex];
+            const double *sourceSymbolicLb = sourceLayer->getSymbolicLb();
+            const double *sourceSymbolicUb = sourceLayer->getSymbolicUb();
+
+            // The rows are independent, and can be split between threads
+            ThreadPool *threadPool = _layerOwner->getThreadPool();
+            unsigned numberOfBlocks =
+                ThreadPool::getNumberOfBlocks( threadPool, _inputLayerSize, sparseWeights._weights.size(),
+                                               GlobalConfiguration::PARALLEL_PROPAGATION_MIN_WORK_PER_BLOCK );
+
+            ThreadPool::runInBlocks( threadPool, _inputLayerSize, numberOfBlocks,
+                                     [&]( unsigned, unsigned begin, unsigned end )
+            {
+                for ( unsigned i = begin; i < end; ++i )
+                {
+                    const double *sourceLbRow = sourceSymbolicLb + i * sourceLayerSize;
+                    const double *sourceUbRow = sourceSymbolicUb + i * sourceLayerSize;
+                    double *lbRow = _symbolicLb + i * _size;
+                    double *ubRow = _symbolicUb + i * _size;
+
+                    for ( unsigned k = 0; k < sourceLayerSize; ++k )
+                    {
+                        double sourceLb = sourceLbRow[k];
+                        double sourceUb = sourceUbRow[k];
+
+                        if ( sourceLb == 0 && sourceUb == 0 )
+                            continue;
+
+                        unsigned rowEnd = sparseWeights._rowStart[k + 1];
+                        for ( unsigned entry = sparseWeights._rowStart[k]; entry < rowEnd; ++entry )
+                        {
+                            unsigned j = sparseWeights._targetNeurons[entry];
+                            double weight = sparseWeights._weights[entry];
+
+                            if ( weight > 0 )
+                            {
+                                lbRow[j] += sourceLb * weight;
+                                ubRow[j] += sourceUb * weight;
+                            }
+                            else
+                            {
+                                lbRow[j] += sourceUb * weight;
+                                ubRow[j] += sourceLb * weight;
+                            }
+                        }
+                    }
+                }
+            } );
+        }
+        else
+        {
+            ThreadPool *threadPool = _layerOwner->getThreadPool();
+            matrixMultiplication( sourceLayer->getSymbolicUb(), _layerToPositiveWeights[sourceLayerIndex],
+                                  _symbolicUb, _inputLayerSize,
+                                  sourceLayerSize, _size, threadPool );
+            matrixMultiplication( sourceLayer->getSymbolicLb(), _layerToNegativeWeights[sourceLayerIndex],
+                                  _symbolicUb, _inputLayerSize,
+                                  sourceLayerSize, _size, threadPool );
+            matrixMultiplication( sourceLayer->getSymbolicLb(), _layerToPositiveWeights[sourceLayerIndex],
+                                  _symbolicLb, _inputLayerSize,
+                                  sourceLayerSize, _size, threadPool );
+            matrixMultiplication( sourceLayer->getSymbolicUb(), _layerToNegativeWeights[sourceLayerIndex],
+                                  _symbolicLb, _inputLayerSize,
+                                  sourceLayerSize, _size, threadPool );
+        }
 
         // Restore the zero bound on eliminated neurons
         unsigned index;
@@ -1343,6 +1796,38 @@ void Layer::computeSymbolicBoundsForWeightedSum()
         /*
           Compute the biases for the new layer
         */
+        if ( _layerToSparseWeights.exists( sourceLayerIndex ) )
+        {
+            SparseWeights &sparseWeights = _layerToSparseWeights[sourceLayerIndex];
+            const double *sourceLowerBias = sourceLayer->getSymbolicLowerBias();
+            const double *sourceUpperBias = sourceLayer->getSymbolicUpperBias();
+
+            for ( unsigned k = 0; k < sourceLayerSize; ++k )
+            {
+                unsigned rowEnd = sparseWeights._rowStart[k + 1];
+                for ( unsigned entry = sparseWeights._rowStart[k]; entry < rowEnd; ++entry )
+                {
+                    unsigned j = sparseWeights._targetNeurons[entry];
+                    if ( _eliminatedNeurons.exists( j ) )
+                        continue;
+
+                    double weight = sparseWeights._weights[entry];
+                    if ( weight > 0 )
+                    {
+                        _symbolicLowerBias[j] += sourceLowerBias[k] * weight;
+                        _symbolicUpperBias[j] += sourceUpperBias[k] * weight;
+                    }
+                    else
+                    {
+                        _symbolicLowerBias[j] += sourceUpperBias[k] * weight;
+                        _symbolicUpperBias[j] += sourceLowerBias[k] * weight;
+                    }
+                }
+            }
+
+            continue;
+        }
+
         for ( unsigned j = 0; j < _size; ++j )
         {
             if ( _eliminatedNeurons.exists( j ) )
@@ -1374,7 +1859,18 @@ void Layer::computeSymbolicBoundsForWeightedSum()
       it. For each of these bounds, we compute an upper bound and
       a lower bound.
     */
-    for ( unsigned i = 0; i < _size; ++i )
+    computeInNeuronBlocks( _inputLayerSize,
+                           [this]( unsigned begin, unsigned end, List<Tightening> &tightenings )
+                           {
+                               concretizeSymbolicBounds( begin, end, tightenings );
+                           } );
+}
+
+void Layer::concretizeSymbolicBounds( unsigned begin, unsigned end, List<Tightening> &tightenings )
+{
+    const Layer *inputLayer = _layerOwner->getLayer( 0 );
+
+    for ( unsigned i = begin; i < end; ++i )
     {
         if ( _eliminatedNeurons.exists( i ) )
             continue;
@@ -1386,8 +1882,8 @@ void Layer::computeSymbolicBoundsForWeightedSum()
 
         for ( unsigned j = 0; j < _inputLayerSize; ++j )
         {
-            double inputLb = _layerOwner->getLayer( 0 )->getLb( j );
-            double inputUb = _layerOwner->getLayer( 0 )->getUb( j );
+            double inputLb = inputLayer->getLb( j );
+            double inputUb = inputLayer->getUb( j );
 
             double entry = _symbolicLb[j * _size + i];
 
@@ -1424,24 +1920,160 @@ void Layer::computeSymbolicBoundsForWeightedSum()
         if ( _lb[i] < _symbolicLbOfLb[i] )
         {
             _lb[i] = _symbolicLbOfLb[i];
-            _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _lb[i], Tightening::LB ) );
+            tightenings.append( Tightening( _neuronToVariable[i], _lb[i], Tightening::LB ) );
         }
 
         if ( _ub[i] > _symbolicUbOfUb[i] )
         {
             _ub[i] = _symbolicUbOfUb[i];
-            _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _ub[i], Tightening::UB ) );
+            tightenings.append( Tightening( _neuronToVariable[i], _ub[i], Tightening::UB ) );
+        }
+    }
+}
+
+void Layer::computeSparseWeights() const
+{
+    _layerToSparseWeights.clear();
+
+    if ( _type == CONVOLUTION )
+    {
+        computeSparseWeightsForConvolution();
+        _sparseWeightsComputed = true;
+        return;
+    }
+
+    for ( const auto &sourceLayerEntry : _sourceLayers )
+    {
+        unsigned sourceLayerIndex = sourceLayerEntry.first;
+        unsigned sourceLayerSize = sourceLayerEntry.second;
+        const double *weights = _layerToWeights[sourceLayerIndex];
+
+        unsigned numberOfEntries = sourceLayerSize * _size;
+        unsigned numberOfNonZeros = 0;
+        for ( unsigned i = 0; i < numberOfEntries; ++i )
+        {
+            if ( weights[i] != 0 )
+                ++numberOfNonZeros;
+        }
+
+        if ( numberOfEntries == 0 ||
+             numberOfNonZeros > GlobalConfiguration::SYMBOLIC_TIGHTENING_SPARSE_WEIGHTS_DENSITY * numberOfEntries )
+            continue;
+
+        SparseWeights &sparseWeights = _layerToSparseWeights[sourceLayerIndex];
+        for ( unsigned k = 0; k < sourceLayerSize; ++k )
+        {
+            sparseWeights._rowStart.append( sparseWeights._weights.size() );
+            for ( unsigned j = 0; j < _size; ++j )
+            {
+                double weight = weights[k * _size + j];
+                if ( weight != 0 )
+                {
+                    sparseWeights._targetNeurons.append( j );
+                    sparseWeights._weights.append( weight );
+                }
+            }
         }
+        sparseWeights._rowStart.append( sparseWeights._weights.size() );
+    }
+
+    _sparseWeightsComputed = true;
+}
+
+void Layer::computeSparseWeightsForConvolution() const
+{
+    ASSERT( _sourceLayers.size() == 1 );
+
+    unsigned sourceLayerIndex = _sourceLayers.begin()->first;
+    unsigned sourceLayerSize = _sourceLayers.begin()->second;
+    SparseWeights &sparseWeights = _layerToSparseWeights[sourceLayerIndex];
+
+    /*
+      The receptive fields are listed per target neuron, but the rows
+      are per source neuron: first count the entries of each row, and
+      then place every entry in its row.
+    */
+    sparseWeights._rowStart.assign( sourceLayerSize + 1, 0 );
+    for ( unsigned j = 0; j < _size; ++j )
+    {
+        forEachConvolutionWeight( j, [&]( unsigned sourceNeuron, double weight )
+                                     {
+                                         if ( weight != 0 )
+                                             ++sparseWeights._rowStart[sourceNeuron + 1];
+                                     } );
+    }
+
+    for ( unsigned k = 0; k < sourceLayerSize; ++k )
+        sparseWeights._rowStart[k + 1] += sparseWeights._rowStart[k];
+
+    unsigned numberOfNonZeros = sparseWeights._rowStart[sourceLayerSize];
+    sparseWeights._targetNeurons.assign( numberOfNonZeros, 0 );
+    sparseWeights._weights.assign( numberOfNonZeros, 0 );
+
+    Vector<unsigned> nextEntry;
+    nextEntry.assign( sourceLayerSize, 0 );
+    for ( unsigned k = 0; k < sourceLayerSize; ++k )
+        nextEntry[k] = sparseWeights._rowStart[k];
+
+    for ( unsigned j = 0; j < _size; ++j )
+    {
+        forEachConvolutionWeight( j, [&]( unsigned sourceNeuron, double weight )
+                                     {
+                                         if ( weight == 0 )
+                                             return;
+
+                                         unsigned entry = nextEntry[sourceNeuron]++;
+                                         sparseWeights._targetNeurons[entry] = j;
+                                         sparseWeights._weights[entry] = weight;
+                                     } );
     }
 }
 
+const Layer::SparseWeights *Layer::getSparseWeights( unsigned sourceLayer ) const
+{
+    if ( !_sparseWeightsComputed )
+        computeSparseWeights();
+
+    if ( !_layerToSparseWeights.exists( sourceLayer ) )
+        return NULL;
+
+    return &_layerToSparseWeights[sourceLayer];
+}
+
+void Layer::invalidateSparseWeights()
+{
+    if ( _sparseWeightsComputed )
+    {
+        _layerToSparseWeights.clear();
+        _sparseWeightsComputed = false;
+    }
+}
+
+void Layer::computeInNeuronBlocks( double workPerNeuron,
+                                   const std::function<void( unsigned, unsigned, List<Tightening> & )> &computeBlock )
+{
+    ThreadPool *threadPool = _layerOwner->getThreadPool();
+    unsigned numberOfBlocks =
+        ThreadPool::getNumberOfBlocks( threadPool, _size, workPerNeuron,
+                                       GlobalConfiguration::PARALLEL_PROPAGATION_MIN_WORK_PER_BLOCK );
+
+    Vector<List<Tightening>> blockTightenings( numberOfBlocks );
+    ThreadPool::runInBlocks( threadPool, _size, numberOfBlocks,
+                             [&]( unsigned block, unsigned begin, unsigned end )
+                             {
+                                 computeBlock( begin, end, blockTightenings[block] );
+                             } );
+
+    for ( const auto &tightenings : blockTightenings )
+        for ( const auto &tightening : tightenings )
+            _layerOwner->receiveTighterBound( tightening );
+}
+
 void Layer::eliminateVariable( unsigned variable, double value )
 {
     if ( !_variableToNeuron.exists( variable ) )
         return;
 
-    ASSERT( _type != INPUT );
-
     unsigned neuron = _variableToNeuron[variable];
     _eliminatedNeurons[neuron] = value;
     _lb[neuron] = value;
@@ -1503,7 +2135,13 @@ unsigned Layer::getLayerIndex() const
 
 Layer::Layer( const Layer *other )
     : _bias( NULL )
+    , _sparseWeightsComputed( false )
+    , _kernel( NULL )
+    , _kernelSize( 0 )
     , _assignment( NULL )
+    , _batchAssignment( NULL )
+    , _batchSize( 0 )
+    , _batchCapacity( 0 )
     , _lb( NULL )
     , _ub( NULL )
     , _inputLayerSize( 0 )
@@ -1546,6 +2184,14 @@ Layer::Layer( const Layer *other )
     if ( other->_bias )
         memcpy( _bias, other->_bias, sizeof(double) * _size );
 
+    if ( other->_kernel )
+    {
+        _convolutionParameters = other->_convolutionParameters;
+        _kernelSize = other->_kernelSize;
+        _kernel = new double[_kernelSize];
+        memcpy( _kernel, other->_kernel, sizeof(double) * _kernelSize );
+    }
+
     _neuronToActivationSources = other->_neuronToActivationSources;
 
     _neuronToVariable = other->_neuronToVariable;
@@ -1615,12 +2261,27 @@ void Layer::freeMemoryIfNeeded()
         _bias = NULL;
     }
 
+    if ( _kernel )
+    {
+        delete[] _kernel;
+        _kernel = NULL;
+    }
+    _kernelSize = 0;
+
     if ( _assignment )
     {
         delete[] _assignment;
         _assignment = NULL;
     }
 
+    if ( _batchAssignment )
+    {
+        delete[] _batchAssignment;
+        _batchAssignment = NULL;
+    }
+    _batchSize = 0;
+    _batchCapacity = 0;
+
     if ( _lb )
     {
         delete[] _lb;
@@ -1694,6 +2355,10 @@ String Layer::typeToString( Type type )
         return "WEIGHTED_SUM";
         break;
 
+    case CONVOLUTION:
+        return "CONVOLUTION";
+        break;
+
     case RELU:
         return "RELU";
         break;
@@ -1763,6 +2428,21 @@ void Layer::dump() const
         printf( "\n" );
         break;
 
+    case CONVOLUTION:
+    {
+        const ConvolutionParameters &parameters = _convolutionParameters;
+        printf( "\t\tSource layer %u: %u x %u x %u, kernel %u x %u x %u x %u, stride %u x %u, padding %u x %u\n",
+                _sourceLayers.begin()->first,
+                parameters._inputChannels, parameters._inputHeight, parameters._inputWidth,
+                parameters._outputChannels, parameters._inputChannels,
+                parameters._kernelHeight, parameters._kernelWidth,
+                parameters._strideHeight, parameters._strideWidth,
+                parameters._paddingHeight, parameters._paddingWidth );
+        printf( "\t\tOutput: %u x %u x %u\n\n",
+                parameters._outputChannels, parameters.getOutputHeight(), parameters.getOutputWidth() );
+        break;
+    }
+
     case RELU:
     case ABSOLUTE_VALUE:
     case MAX:
@@ -1840,6 +2520,7 @@ void Layer::reduceIndexFromAllMaps( unsigned startIndex )
     adjustWeightMapIndexing( _layerToWeights, startIndex );
     adjustWeightMapIndexing( _layerToPositiveWeights, startIndex );
     adjustWeightMapIndexing( _layerToNegativeWeights, startIndex );
+    invalidateSparseWeights();
 
     // Adjust the neuron activations
     for ( auto &neuronToSources : _neuronToActivationSources )
@@ -1901,6 +2582,18 @@ bool Layer::operator==( const Layer &layer ) const
     if ( !compareWeights( _layerToNegativeWeights, layer._layerToNegativeWeights ) )
         return false;
 
+    if ( _kernelSize != layer._kernelSize )
+        return false;
+
+    if ( _kernel )
+    {
+        if ( !( _convolutionParameters == layer._convolutionParameters ) )
+            return false;
+
+        if ( std::memcmp( _kernel, layer._kernel, _kernelSize * sizeof(double) ) != 0 )
+            return false;
+    }
+
     return true;
 }
 
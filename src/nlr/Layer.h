@@ -28,6 +28,8 @@
 #include "SignConstraint.h"
 #include "Vector.h"
 
+#include <functional>
+
 namespace NLR {
 
 class Layer
@@ -37,6 +39,7 @@ public:
         // Linear layers
         INPUT = 0,
         WEIGHTED_SUM,
+        CONVOLUTION,
 
         // Activation functions
         RELU,
@@ -45,6 +48,76 @@ public:
         SIGN,
     };
 
+    /*
+      The geometry of a convolution layer. The neurons of the layer
+      and of its source are ordered by channel, then row, then column;
+      the kernel is indexed by output channel, input channel, row and
+      column. Padding is added on both sides of each dimension.
+    */
+    struct ConvolutionParameters
+    {
+        ConvolutionParameters()
+            : _inputChannels( 0 )
+            , _inputHeight( 0 )
+            , _inputWidth( 0 )
+            , _outputChannels( 0 )
+            , _kernelHeight( 0 )
+            , _kernelWidth( 0 )
+            , _strideHeight( 1 )
+            , _strideWidth( 1 )
+            , _paddingHeight( 0 )
+            , _paddingWidth( 0 )
+        {
+        }
+
+        unsigned getOutputHeight() const
+        {
+            return ( _inputHeight + 2 * _paddingHeight - _kernelHeight ) / _strideHeight + 1;
+        }
+
+        unsigned getOutputWidth() const
+        {
+            return ( _inputWidth + 2 * _paddingWidth - _kernelWidth ) / _strideWidth + 1;
+        }
+
+        bool operator==( const ConvolutionParameters &other ) const
+        {
+            return
+                _inputChannels == other._inputChannels &&
+                _inputHeight == other._inputHeight &&
+                _inputWidth == other._inputWidth &&
+                _outputChannels == other._outputChannels &&
+                _kernelHeight == other._kernelHeight &&
+                _kernelWidth == other._kernelWidth &&
+                _strideHeight == other._strideHeight &&
+                _strideWidth == other._strideWidth &&
+                _paddingHeight == other._paddingHeight &&
+                _paddingWidth == other._paddingWidth;
+        }
+
+        unsigned _inputChannels;
+        unsigned _inputHeight;
+        unsigned _inputWidth;
+        unsigned _outputChannels;
+        unsigned _kernelHeight;
+        unsigned _kernelWidth;
+        unsigned _strideHeight;
+        unsigned _strideWidth;
+        unsigned _paddingHeight;
+        unsigned _paddingWidth;
+    };
+
+    /*
+      Compressed-row copies of sparse weight matrices. Row k lists the
+      non-zero weights from neuron k of the source layer.
+    */
+    struct SparseWeights
+    {
+        Vector<unsigned> _rowStart;
+        Vector<unsigned> _targetNeurons;
+        Vector<double> _weights;
+    };
+
     /*
       Construct a layer directly and populate its fields, or clone
       from another layer
@@ -81,6 +154,32 @@ public:
     double getBias( unsigned neuron ) const;
     double *getBiases() const;
 
+    /*
+      Convolution layers have a single source layer. Their weights are
+      given by a kernel that is shared by all positions of the output,
+      and are never stored as a dense matrix: getWeight() computes
+      them from the kernel. The bias is set per output channel.
+    */
+    void setConvolutionParameters( const ConvolutionParameters &parameters );
+    const ConvolutionParameters &getConvolutionParameters() const;
+    void setKernelWeight( unsigned outputChannel,
+                          unsigned inputChannel,
+                          unsigned row,
+                          unsigned column,
+                          double weight );
+    double getKernelWeight( unsigned outputChannel,
+                            unsigned inputChannel,
+                            unsigned row,
+                            unsigned column ) const;
+    void setChannelBias( unsigned outputChannel, double bias );
+
+    /*
+      The non-zero weights from a source layer in compressed-row
+      form, or NULL if the weights are too dense for this to pay off.
+      Convolution layers always have them.
+    */
+    const SparseWeights *getSparseWeights( unsigned sourceLayer ) const;
+
     void addActivationSource( unsigned sourceLayer,
                               unsigned sourceNeuron,
                               unsigned targetNeuron );
@@ -105,11 +204,15 @@ public:
     void computeAssignment();
 
     /*
-      Set/get the simulations, or compute it from source layers
+      Set/get the assignments of a batch of inputs, or compute them
+      from source layers. A batch is stored row-major: the assignment
+      for the k'th input occupies entries k * size, ..., (k + 1) * size - 1.
     */
-   void setSimulations( const Vector<Vector<double>> *values );
-   void computeSimulations();
-   const Vector<Vector<double>> *getSimulations() const;
+    void setBatchAssignment( const double *values, unsigned batchSize );
+    const double *getBatchAssignment() const;
+    double getBatchAssignment( unsigned neuron, unsigned input ) const;
+    unsigned getBatchSize() const;
+    void computeBatchAssignment( unsigned batchSize );
 
     /*
       Bound related functionality: grab the current bounds from the
@@ -163,9 +266,31 @@ private:
     Map<unsigned, double *> _layerToNegativeWeights;
     double *_bias;
 
+    /*
+      Compressed-row copies of the sparse weight matrices, used for
+      symbolic bound propagation. Source layers whose weights are too
+      dense have no entry here. The copies are built on first use,
+      and discarded whenever the weights change.
+    */
+    mutable Map<unsigned, SparseWeights> _layerToSparseWeights;
+    mutable bool _sparseWeightsComputed;
+
+    /*
+      The geometry and the kernel of a convolution layer
+    */
+    ConvolutionParameters _convolutionParameters;
+    double *_kernel;
+    unsigned _kernelSize;
+
     double *_assignment;
 
-    Vector<Vector<double>> _simulations;
+    /*
+      The assignments of the last batch, and the number of inputs for
+      which memory is allocated.
+    */
+    double *_batchAssignment;
+    unsigned _batchSize;
+    unsigned _batchCapacity;
 
     double *_lb;
     double *_ub;
@@ -187,26 +312,75 @@ private:
     double *_symbolicUbOfUb;
 
     void allocateMemory();
+    void allocateSymbolicMemoryIfNeeded();
     void freeMemoryIfNeeded();
 
     /*
-      Helper functions for symbolic bound tightening
+      Helper functions for batch evaluation. If each neuron of an
+      activation layer has a single source, with the same index in a
+      source layer of the same size, the activation is applied
+      elementwise to the source layer's batch.
+    */
+    void allocateBatchMemory( unsigned batchSize );
+    const Layer *getElementwiseSourceLayer() const;
+    template <typename Activation>
+    void computeBatchActivation( unsigned batchSize, Activation activation );
+
+    /*
+      Helper functions for convolution layers: visit the source
+      neurons in the receptive field of a neuron, with their kernel
+      weights, and evaluate the layer for a single input.
+    */
+    unsigned getKernelIndex( unsigned outputChannel,
+                             unsigned inputChannel,
+                             unsigned row,
+                             unsigned column ) const;
+    template <typename Visitor>
+    void forEachConvolutionWeight( unsigned neuron, Visitor visit ) const;
+    void computeConvolution( const double *sourceAssignment, double *assignment ) const;
+
+    /*
+      Helper functions for symbolic bound tightening. The overloads
+      that take a range of neurons only handle those neurons, and
+      collect the bounds that they tighten instead of reporting them.
     */
     void comptueSymbolicBoundsForInput();
     void computeSymbolicBoundsForRelu();
+    void computeSymbolicBoundsForRelu( unsigned begin, unsigned end, List<Tightening> &tightenings );
     void computeSymbolicBoundsForSign();
+    void computeSymbolicBoundsForSign( unsigned begin, unsigned end, List<Tightening> &tightenings );
     void computeSymbolicBoundsForAbsoluteValue();
+    void computeSymbolicBoundsForAbsoluteValue( unsigned begin, unsigned end, List<Tightening> &tightenings );
     void computeSymbolicBoundsForWeightedSum();
+    void concretizeSymbolicBounds( unsigned begin, unsigned end, List<Tightening> &tightenings );
+    void computeSparseWeights() const;
+    void computeSparseWeightsForConvolution() const;
+    void invalidateSparseWeights();
     void computeSymbolicBoundsDefault();
 
     /*
       Helper functions for interval bound tightening
     */
     void computeIntervalArithmeticBoundsForWeightedSum();
+    void computeIntervalArithmeticBoundsForWeightedSum( unsigned begin, unsigned end, List<Tightening> &tightenings );
+    void computeIntervalArithmeticBoundsForConvolution();
+    void computeIntervalArithmeticBoundsForConvolution( unsigned begin, unsigned end, List<Tightening> &tightenings );
     void computeIntervalArithmeticBoundsForRelu();
+    void computeIntervalArithmeticBoundsForRelu( unsigned begin, unsigned end, List<Tightening> &tightenings );
     void computeIntervalArithmeticBoundsForAbs();
+    void computeIntervalArithmeticBoundsForAbs( unsigned begin, unsigned end, List<Tightening> &tightenings );
     void computeIntervalArithmeticBoundsForSign();
 
+    /*
+      Run computeBlock( begin, end, tightenings ) on contiguous blocks
+      of this layer's neurons -- concurrently, if the layer owner
+      provides a thread pool and the layer is large enough. The
+      tightenings collected by the blocks are then reported to the
+      layer owner in neuron order, exactly as a sequential pass would.
+    */
+    void computeInNeuronBlocks( double workPerNeuron,
+                                const std::function<void( unsigned, unsigned, List<Tightening> & )> &computeBlock );
+
     const double *getSymbolicLb() const;
     const double *getSymbolicUb() const;
     const double *getSymbolicLowerBias() const;
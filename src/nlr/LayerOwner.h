@@ -16,6 +16,7 @@
 #ifndef __LayerOwner_h__
 #define __LayerOwner_h__
 
+#include "ThreadPool.h"
 #include "Tightening.h"
 
 namespace NLR {
@@ -32,6 +33,12 @@ public:
     virtual const ITableau *getTableau() const = 0;
     virtual unsigned getNumberOfLayers() const = 0;
     virtual void receiveTighterBound( Tightening tightening ) = 0;
+
+    /*
+      The pool on which layers split their bound propagation, or NULL
+      if it should be sequential
+    */
+    virtual ThreadPool *getThreadPool() const = 0;
 };
 
 } // namespace NLR
@@ -13,9 +13,10 @@
 
  **/
 
-#include "GurobiWrapper.h"
+#include "ILPSolver.h"
 #include "InfeasibleQueryException.h"
 #include "LPFormulator.h"
+#include "LPSolverFactory.h"
 #include "Layer.h"
 #include "MILPFormulator.h"
 #include "MStringf.h"
@@ -25,6 +26,7 @@
 #include "Vector.h"
 
 #include <boost/thread.hpp>
+#include <memory>
 
 namespace NLR {
 
@@ -49,11 +51,12 @@ void MILPFormulator::optimizeBoundsWithIncrementalMILPEncoding( const Map<unsign
     _signChanges = 0;
     _cutoffs = 0;
 
-    GurobiWrapper gurobi;
+    std::unique_ptr<ILPSolver> solver( LPSolverFactory::createLPSolver() );
+    ILPSolver &lpSolver = *solver;
 
     double currentLb;
     double currentUb;
-    List<GurobiWrapper::Term> terms;
+    List<ILPSolver::Term> terms;
     Map<String, double> dontCare;
 
     struct timespec gurobiStart = TimeUtils::sampleMicro();
@@ -66,7 +69,7 @@ void MILPFormulator::optimizeBoundsWithIncrementalMILPEncoding( const Map<unsign
         */
         ASSERT( layers.exists( i ) );
         Layer *layer = layers[i];
-        _lpFormulator.addLayerToModel( gurobi, layer );
+        _lpFormulator.addLayerToModel( lpSolver, layer );
 
         /*
           The optimiziation is performed layer by layer, and for each
@@ -93,7 +96,7 @@ void MILPFormulator::optimizeBoundsWithIncrementalMILPEncoding( const Map<unsign
             if ( _cutoffInUse && ( currentLb >= _cutoffValue || currentUb <= _cutoffValue ) )
             {
                 if ( layerRequiresMILP )
-                    addNeuronToModel( gurobi, layer, j, _layerOwner );
+                    addNeuronToModel( lpSolver, layer, j, _layerOwner );
                 continue;
             }
 
@@ -101,21 +104,21 @@ void MILPFormulator::optimizeBoundsWithIncrementalMILPEncoding( const Map<unsign
             Stringf variableName( "x%u", variable );
 
             terms.clear();
-            terms.append( GurobiWrapper::Term( 1, variableName ) );
+            terms.append( ILPSolver::Term( 1, variableName ) );
 
             // Maximize, using just the LP relaxation for the current layer
-            if ( tightenUpperBound( gurobi, layer, j, variable, currentUb ) )
+            if ( tightenUpperBound( lpSolver, layer, j, variable, currentUb ) )
             {
                 if ( layerRequiresMILP )
-                    addNeuronToModel( gurobi, layer, j, _layerOwner );
+                    addNeuronToModel( lpSolver, layer, j, _layerOwner );
                 continue;
             }
 
             // Minimize, using just the LP relaxation for the current layer
-            if ( tightenLowerBound( gurobi, layer, j, variable, currentLb ) )
+            if ( tightenLowerBound( lpSolver, layer, j, variable, currentLb ) )
             {
                 if ( layerRequiresMILP )
-                    addNeuronToModel( gurobi, layer, j, _layerOwner );
+                    addNeuronToModel( lpSolver, layer, j, _layerOwner );
                 continue;
             }
 
@@ -125,14 +128,14 @@ void MILPFormulator::optimizeBoundsWithIncrementalMILPEncoding( const Map<unsign
             if ( !layerRequiresMILP )
                 continue;
 
-            addNeuronToModel( gurobi, layer, j, _layerOwner );
+            addNeuronToModel( lpSolver, layer, j, _layerOwner );
 
             // Maximize, using just the exact MILP encoding
-            if ( tightenUpperBound( gurobi, layer, j, variable, currentUb ) )
+            if ( tightenUpperBound( lpSolver, layer, j, variable, currentUb ) )
                 continue;
 
             // Minimize, using just the exact MILP encoding
-            if ( tightenLowerBound( gurobi, layer, j, variable, currentLb ) )
+            if ( tightenLowerBound( lpSolver, layer, j, variable, currentLb ) )
                 continue;
         }
     }
@@ -151,16 +154,16 @@ void MILPFormulator::optimizeBoundsWithMILPEncoding( const Map<unsigned, Layer *
     // Time to wait if no idle worker is availble
     boost::chrono::milliseconds waitTime( numberOfWorkers - 1 );
 
-    Map<GurobiWrapper *, unsigned> solverToIndex;
+    Map<ILPSolver *, unsigned> solverToIndex;
     // Create a queue of free workers
     // When a worker is working, it is popped off the queue, when it is done, it
     // is added back to the queue.
     SolverQueue freeSolvers( numberOfWorkers );
     for ( unsigned i = 0; i < numberOfWorkers; ++i )
     {
-        GurobiWrapper *gurobi = new GurobiWrapper();
-        solverToIndex[gurobi] = i;
-        enqueueSolver( freeSolvers, gurobi );
+        ILPSolver *lpSolver = LPSolverFactory::createLPSolver();
+        solverToIndex[lpSolver] = i;
+        enqueueSolver( freeSolvers, lpSolver );
     }
 
     boost::thread *threads = new boost::thread[numberOfWorkers];
@@ -183,8 +186,8 @@ void MILPFormulator::optimizeBoundsWithMILPEncoding( const Map<unsigned, Layer *
     {
         Layer *layer = currentLayer.second;
 
-        // declare simulations as local var to avoid a problem which can happen due to multi thread process.
-        const Vector<Vector<double>> *simulations = _layerOwner->getLayer( currentLayer.first )->getSimulations();
+        // The simulations are read from the owner's layer, as the layers being relaxed may be copies
+        const Layer *simulatedLayer = _layerOwner->getLayer( currentLayer.first );
 
         for ( unsigned i = 0; i < layer->getSize(); ++i )
         {
@@ -200,8 +203,10 @@ void MILPFormulator::optimizeBoundsWithMILPEncoding( const Map<unsigned, Layer *
             skipTightenUb = false;
 
             // Loop for simulation
-            for ( const auto &simValue : (*simulations).get( i ) )
+            for ( unsigned k = 0; k < simulatedLayer->getBatchSize(); ++k )
             {
+                double simValue = simulatedLayer->getBatchAssignment( i, k );
+
                 if ( _cutoffInUse && _cutoffValue < simValue ) // If x_lower < 0 < x_sim, do not try to call tightning upper bound.
                     skipTightenUb = true;
 
@@ -243,7 +248,7 @@ void MILPFormulator::optimizeBoundsWithMILPEncoding( const Map<unsigned, Layer *
             }
 
             // Wait until there is an idle solver
-            GurobiWrapper *freeSolver;
+            ILPSolver *freeSolver;
             while ( !freeSolvers.pop( freeSolver ) )
                 boost::this_thread::sleep_for( waitTime );
 
@@ -308,7 +313,7 @@ void MILPFormulator::tightenSingleVariableBoundsWithMILPEncoding( ThreadArgument
           ReLUs, as their phase would become fixed in these cases)
         */
 
-        GurobiWrapper *gurobi = argument._gurobi;
+        ILPSolver *lpSolver = argument._gurobi;
         Layer *layer = argument._layer;
         const Map<unsigned, Layer *> &layers = *( argument._layers );
         unsigned index = argument._index;
@@ -336,7 +341,7 @@ void MILPFormulator::tightenSingleVariableBoundsWithMILPEncoding( ThreadArgument
         if ( !skipTightenLb )
         {
             log( Stringf( "Computing lowerbound..." ).ascii() );
-            double lb = optimizeWithGurobi( *gurobi, MinOrMax::MIN, variableName,
+            double lb = optimizeWithGurobi( *lpSolver, MinOrMax::MIN, variableName,
                                             cutoffValue, &infeasible );
             log( Stringf( "Lowerbound computed: %f", lb ).ascii() );
 
@@ -358,7 +363,7 @@ void MILPFormulator::tightenSingleVariableBoundsWithMILPEncoding( ThreadArgument
                 if ( cutoffInUse && lb > cutoffValue )
                 {
                     ++cutoffs;
-                    enqueueSolver( freeSolvers, gurobi );
+                    enqueueSolver( freeSolvers, lpSolver );
                     return;
                 }
             }
@@ -367,8 +372,8 @@ void MILPFormulator::tightenSingleVariableBoundsWithMILPEncoding( ThreadArgument
         if ( !skipTightenUb )
         {
             log( Stringf( "Computing upperbound..." ).ascii() );
-            gurobi->reset();
-            double ub = optimizeWithGurobi( *gurobi, MinOrMax::MAX, variableName,
+            lpSolver->reset();
+            double ub = optimizeWithGurobi( *lpSolver, MinOrMax::MAX, variableName,
                                             cutoffValue, &infeasible );
             log( Stringf( "Upperbound computed %f", ub ).ascii() );
 
@@ -391,13 +396,13 @@ void MILPFormulator::tightenSingleVariableBoundsWithMILPEncoding( ThreadArgument
                 if ( cutoffInUse && ub < cutoffValue )
                 {
                     ++cutoffs;
-                    enqueueSolver( freeSolvers, gurobi );
+                    enqueueSolver( freeSolvers, lpSolver );
                     return;
                 }
             }
         }
 
-        gurobi->reset();
+        lpSolver->reset();
         // Exact encoding
         // Now, add the MILP constraints
         unsigned lastLayer = layer->getLayerIndex();
@@ -406,13 +411,13 @@ void MILPFormulator::tightenSingleVariableBoundsWithMILPEncoding( ThreadArgument
             if ( layer.second->getLayerIndex() > lastLayer )
                 continue;
 
-            addLayerToModel( *gurobi, layer.second, layerOwner );
+            addLayerToModel( *lpSolver, layer.second, layerOwner );
         }
 
         if ( !skipTightenLb )
         {
             log( Stringf( "Computing lowerbound..." ).ascii() );
-            double lb = optimizeWithGurobi( *gurobi, MinOrMax::MIN, variableName,
+            double lb = optimizeWithGurobi( *lpSolver, MinOrMax::MIN, variableName,
                                     cutoffValue, &infeasible );
             log( Stringf( "Lowerbound computed: %f", lb ).ascii() );
 
@@ -434,7 +439,7 @@ void MILPFormulator::tightenSingleVariableBoundsWithMILPEncoding( ThreadArgument
                 if ( cutoffInUse && lb > cutoffValue )
                 {
                     ++cutoffs;
-                    enqueueSolver( freeSolvers, gurobi );
+                    enqueueSolver( freeSolvers, lpSolver );
                     return;
                 }
             }
@@ -446,8 +451,8 @@ void MILPFormulator::tightenSingleVariableBoundsWithMILPEncoding( ThreadArgument
                                     layer->getLayerIndex(), index ).ascii() );
 
             log( Stringf( "Computing upperbound..." ).ascii() );
-            gurobi->reset();
-            double ub = optimizeWithGurobi( *gurobi, MinOrMax::MAX, variableName,
+            lpSolver->reset();
+            double ub = optimizeWithGurobi( *lpSolver, MinOrMax::MAX, variableName,
                                     cutoffValue, &infeasible );
             log( Stringf( "Upperbound computed %f", ub ).ascii() );
 
@@ -472,7 +477,7 @@ void MILPFormulator::tightenSingleVariableBoundsWithMILPEncoding( ThreadArgument
             }
         }
 
-        enqueueSolver( freeSolvers, gurobi );
+        enqueueSolver( freeSolvers, lpSolver );
     }
     catch ( boost::thread_interrupted& )
     {
@@ -481,11 +486,11 @@ void MILPFormulator::tightenSingleVariableBoundsWithMILPEncoding( ThreadArgument
 }
 
 void MILPFormulator::createMILPEncoding( const Map<unsigned, Layer *> &layers,
-                                         GurobiWrapper &gurobi,
+                                         ILPSolver &lpSolver,
                                          unsigned lastLayer )
 {
     // First, create the LP relaxation of the problem
-    _lpFormulator.createLPRelaxation( layers, gurobi, lastLayer );
+    _lpFormulator.createLPRelaxation( layers, lpSolver, lastLayer );
 
     // Now, add the MILP constraints
     for ( const auto &layer : layers )
@@ -493,21 +498,22 @@ void MILPFormulator::createMILPEncoding( const Map<unsigned, Layer *> &layers,
         if ( layer.second->getLayerIndex() > lastLayer )
             continue;
 
-        addLayerToModel( gurobi, layer.second, _layerOwner );
+        addLayerToModel( lpSolver, layer.second, _layerOwner );
     }
 }
 
-void MILPFormulator::addLayerToModel( GurobiWrapper &gurobi, const Layer *layer,
+void MILPFormulator::addLayerToModel( ILPSolver &lpSolver, const Layer *layer,
                                       LayerOwner *layerOwner )
 {
     switch ( layer->getLayerType() )
     {
         case Layer::INPUT:
         case Layer::WEIGHTED_SUM:
+        case Layer::CONVOLUTION:
             break;
 
         case Layer::RELU:
-            addReluLayerToMILPFormulation( gurobi, layer, layerOwner );
+            addReluLayerToMILPFormulation( lpSolver, layer, layerOwner );
             break;
 
         default:
@@ -516,7 +522,7 @@ void MILPFormulator::addLayerToModel( GurobiWrapper &gurobi, const Layer *layer,
     }
 }
 
-void MILPFormulator::addNeuronToModel( GurobiWrapper &gurobi, const Layer *layer,
+void MILPFormulator::addNeuronToModel( ILPSolver &lpSolver, const Layer *layer,
                                        unsigned neuron, LayerOwner *layerOwner )
 {
     if ( layer->getLayerType() != Layer::RELU )
@@ -555,48 +561,48 @@ void MILPFormulator::addNeuronToModel( GurobiWrapper &gurobi, const Layer *layer
       y - ua <= 0
     */
 
-    gurobi.addVariable( Stringf( "a%u", targetVariable ),
+    lpSolver.addVariable( Stringf( "a%u", targetVariable ),
                         0,
                         1,
-                        GurobiWrapper::BINARY );
+                        ILPSolver::BINARY );
 
-    List<GurobiWrapper::Term> terms;
-    terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-    terms.append( GurobiWrapper::Term( -1, Stringf( "x%u", sourceVariable ) ) );
-    terms.append( GurobiWrapper::Term( -sourceLb, Stringf( "a%u", targetVariable ) ) );
-    gurobi.addLeqConstraint( terms, -sourceLb );
+    List<ILPSolver::Term> terms;
+    terms.append( ILPSolver::Term( 1, Stringf( "x%u", targetVariable ) ) );
+    terms.append( ILPSolver::Term( -1, Stringf( "x%u", sourceVariable ) ) );
+    terms.append( ILPSolver::Term( -sourceLb, Stringf( "a%u", targetVariable ) ) );
+    lpSolver.addLeqConstraint( terms, -sourceLb );
 
     terms.clear();
-    terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-    terms.append( GurobiWrapper::Term( -sourceUb, Stringf( "a%u", targetVariable ) ) );
-    gurobi.addLeqConstraint( terms, 0 );
+    terms.append( ILPSolver::Term( 1, Stringf( "x%u", targetVariable ) ) );
+    terms.append( ILPSolver::Term( -sourceUb, Stringf( "a%u", targetVariable ) ) );
+    lpSolver.addLeqConstraint( terms, 0 );
 }
 
-void MILPFormulator::addReluLayerToMILPFormulation( GurobiWrapper &gurobi,
+void MILPFormulator::addReluLayerToMILPFormulation( ILPSolver &lpSolver,
                                                     const Layer *layer,
                                                     LayerOwner *layerOwner )
 {
     for ( unsigned i = 0; i < layer->getSize(); ++i )
     {
-        addNeuronToModel( gurobi, layer, i, layerOwner );
+        addNeuronToModel( lpSolver, layer, i, layerOwner );
     }
 }
 
-double MILPFormulator::optimizeWithGurobi( GurobiWrapper &gurobi,
+double MILPFormulator::optimizeWithGurobi( ILPSolver &lpSolver,
                                            MinOrMax minOrMax, String variableName,
                                            double cutoffValue, std::atomic_bool *infeasible )
 {
-    List<GurobiWrapper::Term> terms;
-    terms.append( GurobiWrapper::Term( 1, variableName ) );
+    List<ILPSolver::Term> terms;
+    terms.append( ILPSolver::Term( 1, variableName ) );
 
     if ( minOrMax == MAX )
-        gurobi.setObjective( terms );
+        lpSolver.setObjective( terms );
     else
-        gurobi.setCost( terms );
+        lpSolver.setCost( terms );
 
-    gurobi.solve();
+    lpSolver.solve();
 
-    if ( gurobi.infeasbile() )
+    if ( lpSolver.infeasbile() )
     {
         if ( infeasible )
         {
@@ -607,19 +613,19 @@ double MILPFormulator::optimizeWithGurobi( GurobiWrapper &gurobi,
             throw InfeasibleQueryException();
     }
 
-    if ( gurobi.cutoffOccurred() )
+    if ( lpSolver.cutoffOccurred() )
         return cutoffValue;
 
-    if ( gurobi.optimal() )
+    if ( lpSolver.optimal() )
     {
         Map<String, double> dontCare;
         double result = 0;
-        gurobi.extractSolution( dontCare, result );
+        lpSolver.extractSolution( dontCare, result );
         return result;
     }
-    else if ( gurobi.timeout() )
+    else if ( lpSolver.timeout() )
     {
-        return gurobi.getObjectiveBound();
+        return lpSolver.getObjectiveBound();
     }
 
     throw NLRError( NLRError::UNEXPECTED_RETURN_STATUS_FROM_GUROBI );
@@ -663,7 +669,7 @@ void MILPFormulator::setCutoff( double cutoff )
     _cutoffValue = cutoff;
 }
 
-bool MILPFormulator::tightenUpperBound( GurobiWrapper &gurobi,
+bool MILPFormulator::tightenUpperBound( ILPSolver &lpSolver,
                                         Layer *layer,
                                         unsigned neuron,
                                         unsigned variable,
@@ -673,41 +679,38 @@ bool MILPFormulator::tightenUpperBound( GurobiWrapper &gurobi,
 
     Stringf variableName( "x%u", variable );
 
-    List<GurobiWrapper::Term> terms;
-    terms.append( GurobiWrapper::Term( 1, variableName ) );
+    List<ILPSolver::Term> terms;
+    terms.append( ILPSolver::Term( 1, variableName ) );
 
-    gurobi.reset();
-    gurobi.setObjective( terms );
-    gurobi.solve();
+    lpSolver.reset();
+    lpSolver.setObjective( terms );
+    lpSolver.solve();
 
-    if ( gurobi.infeasbile() )
+    if ( lpSolver.infeasbile() )
         throw InfeasibleQueryException();
 
-    if ( gurobi.cutoffOccurred() )
+    if ( lpSolver.cutoffOccurred() )
     {
         newUb = _cutoffValue;
     }
-    else if ( gurobi.optimal() )
+    else if ( lpSolver.optimal() )
     {
         Map<String, double> dontCare;
-        gurobi.extractSolution( dontCare, newUb );
+        lpSolver.extractSolution( dontCare, newUb );
     }
-    else if ( gurobi.timeout() )
+    else if ( lpSolver.timeout() )
     {
-        newUb = gurobi.getObjectiveBound();
+        newUb = lpSolver.getObjectiveBound();
     }
     else
     {
         throw NLRError( NLRError::UNEXPECTED_RETURN_STATUS_FROM_GUROBI );
     }
 
-    Map<String, double> dontCare;
-    gurobi.extractSolution( dontCare, newUb );
-
     // If the bound is tighter, store it
     if ( newUb < currentUb )
     {
-        gurobi.setUpperBound( variableName, newUb );
+        lpSolver.setUpperBound( variableName, newUb );
 
         if ( FloatUtils::isPositive( currentUb ) &&
              !FloatUtils::isPositive( newUb ) )
@@ -731,7 +734,7 @@ bool MILPFormulator::tightenUpperBound( GurobiWrapper &gurobi,
     return false;
 }
 
-bool MILPFormulator::tightenLowerBound( GurobiWrapper &gurobi,
+bool MILPFormulator::tightenLowerBound( ILPSolver &lpSolver,
                                         Layer *layer,
                                         unsigned neuron,
                                         unsigned variable,
@@ -740,28 +743,28 @@ bool MILPFormulator::tightenLowerBound( GurobiWrapper &gurobi,
     double newLb = FloatUtils::negativeInfinity();
     Stringf variableName( "x%u", variable );
 
-    List<GurobiWrapper::Term> terms;
-    terms.append( GurobiWrapper::Term( 1, variableName ) );
+    List<ILPSolver::Term> terms;
+    terms.append( ILPSolver::Term( 1, variableName ) );
 
-    gurobi.reset();
-    gurobi.setCost( terms );
-    gurobi.solve();
+    lpSolver.reset();
+    lpSolver.setCost( terms );
+    lpSolver.solve();
 
-    if ( gurobi.infeasbile() )
+    if ( lpSolver.infeasbile() )
         throw InfeasibleQueryException();
 
-    if ( gurobi.cutoffOccurred() )
+    if ( lpSolver.cutoffOccurred() )
     {
         newLb = _cutoffValue;
     }
-    else if ( gurobi.optimal() )
+    else if ( lpSolver.optimal() )
     {
         Map<String, double> dontCare;
-        gurobi.extractSolution( dontCare, newLb );
+        lpSolver.extractSolution( dontCare, newLb );
     }
-    else if ( gurobi.timeout() )
+    else if ( lpSolver.timeout() )
     {
-        newLb = gurobi.getObjectiveBound();
+        newLb = lpSolver.getObjectiveBound();
     }
     else
     {
@@ -771,7 +774,7 @@ bool MILPFormulator::tightenLowerBound( GurobiWrapper &gurobi,
     // If the bound is tighter, store it
     if ( newLb > currentLb )
     {
-        gurobi.setLowerBound( variableName, newLb );
+        lpSolver.setLowerBound( variableName, newLb );
 
         if ( FloatUtils::isNegative( currentLb ) &&
              !FloatUtils::isNegative( newLb ) )
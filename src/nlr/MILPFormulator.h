@@ -16,7 +16,7 @@
 #ifndef __MILPFormulator_h__
 #define __MILPFormulator_h__
 
-#include "GurobiWrapper.h"
+#include "ILPSolver.h"
 #include "LayerOwner.h"
 #include "LPFormulator.h"
 
@@ -50,7 +50,7 @@ public:
     void setCutoff( double cutoff );
 
     void createMILPEncoding( const Map<unsigned, Layer *> &layers,
-                             GurobiWrapper &gurobi,
+                             ILPSolver &lpSolver,
                              unsigned lastLayer = UINT_MAX );
 
 private:
@@ -62,35 +62,35 @@ private:
     bool _cutoffInUse;
     double _cutoffValue;
 
-    bool tightenLowerBound( GurobiWrapper &gurobi,
+    bool tightenLowerBound( ILPSolver &lpSolver,
                             Layer *layer,
                             unsigned neuron,
                             unsigned variable,
                             double &currentLb );
 
-    bool tightenUpperBound( GurobiWrapper &gurobi,
+    bool tightenUpperBound( ILPSolver &lpSolver,
                             Layer *layer,
                             unsigned neuron,
                             unsigned variable,
                             double &currentUb );
 
-    static void addLayerToModel( GurobiWrapper &gurobi, const Layer *layer,
+    static void addLayerToModel( ILPSolver &lpSolver, const Layer *layer,
                                  LayerOwner *layerOwner );
 
-    static void addReluLayerToMILPFormulation( GurobiWrapper &gurobi,
+    static void addReluLayerToMILPFormulation( ILPSolver &lpSolver,
                                                const Layer *layer,
                                                LayerOwner *layerOwner );
 
-    static void addNeuronToModel( GurobiWrapper &gurobi,
+    static void addNeuronToModel( ILPSolver &lpSolver,
                                   const Layer *layer,
                                   unsigned neuron,
                                   LayerOwner *layerOwner );
 
     /*
       Optimize for the min/max value of variableName with respect to the constraints
-      encoded in gurobi. If the query is infeasible, *infeasible is set to true.
+      encoded in the LP solver. If the query is infeasible, *infeasible is set to true.
     */
-    static double optimizeWithGurobi( GurobiWrapper &gurobi, MinOrMax minOrMax,
+    static double optimizeWithGurobi( ILPSolver &lpSolver, MinOrMax minOrMax,
                                       String variableName, double cutoffValue,
                                       std::atomic_bool *infeasible = NULL );
 
@@ -14,6 +14,7 @@
  **/
 
 #include "AbsoluteValueConstraint.h"
+#include "ConvolutionDetector.h"
 #include "Debug.h"
 #include "FloatUtils.h"
 #include "InputQuery.h"
@@ -27,6 +28,7 @@
 #include "NLRError.h"
 #include "NetworkLevelReasoner.h"
 #include "Options.h"
+#include "Profiler.h"
 #include "ReluConstraint.h"
 #include "SignConstraint.h"
 #include <cstring>
@@ -84,6 +86,27 @@ void NetworkLevelReasoner::setBias( unsigned layer, unsigned neuron, double bias
     _layerIndexToLayer[layer]->setBias( neuron, bias );
 }
 
+void NetworkLevelReasoner::setConvolutionParameters( unsigned layer,
+                                                     const Layer::ConvolutionParameters &parameters )
+{
+    _layerIndexToLayer[layer]->setConvolutionParameters( parameters );
+}
+
+void NetworkLevelReasoner::setKernelWeight( unsigned layer,
+                                            unsigned outputChannel,
+                                            unsigned inputChannel,
+                                            unsigned row,
+                                            unsigned column,
+                                            double weight )
+{
+    _layerIndexToLayer[layer]->setKernelWeight( outputChannel, inputChannel, row, column, weight );
+}
+
+void NetworkLevelReasoner::setChannelBias( unsigned layer, unsigned outputChannel, double bias )
+{
+    _layerIndexToLayer[layer]->setChannelBias( outputChannel, bias );
+}
+
 void NetworkLevelReasoner::addActivationSource( unsigned sourceLayer,
                                                 unsigned sourceNeuron,
                                                 unsigned targetLayer,
@@ -114,11 +137,42 @@ void NetworkLevelReasoner::evaluate( double *input, double *output )
             sizeof(double) * outputLayer->getSize() );
 }
 
+void NetworkLevelReasoner::evaluateBatch( const double *input, double *output, unsigned batchSize )
+{
+    _layerIndexToLayer[0]->setBatchAssignment( input, batchSize );
+    for ( unsigned i = 1; i < _layerIndexToLayer.size(); ++i )
+        _layerIndexToLayer[i]->computeBatchAssignment( batchSize );
+
+    const Layer *outputLayer = _layerIndexToLayer[_layerIndexToLayer.size() - 1];
+    memcpy( output,
+            outputLayer->getBatchAssignment(),
+            sizeof(double) * batchSize * outputLayer->getSize() );
+}
+
 void NetworkLevelReasoner::simulate( Vector<Vector<double>> *input )
 {
-    _layerIndexToLayer[0]->setSimulations( input );
+    // Transpose the per-neuron values into a batch
+    unsigned inputSize = input->size();
+    unsigned numberOfSimulations = ( inputSize == 0 ) ? 0 : ( *input )[0].size();
+
+    Vector<double> batch( numberOfSimulations * inputSize );
+    for ( unsigned i = 0; i < inputSize; ++i )
+    {
+        const Vector<double> &values = ( *input )[i];
+        for ( unsigned k = 0; k < numberOfSimulations; ++k )
+            batch[k * inputSize + i] = values.get( k );
+    }
+
+    simulate( batch.data(), numberOfSimulations );
+}
+
+void NetworkLevelReasoner::simulate( const double *input, unsigned numberOfSimulations )
+{
+    PROFILE_SCOPE( "NLR::simulate" );
+
+    _layerIndexToLayer[0]->setBatchAssignment( input, numberOfSimulations );
     for ( unsigned i = 1; i < _layerIndexToLayer.size(); ++i )
-        _layerIndexToLayer[i]->computeSimulations();
+        _layerIndexToLayer[i]->computeBatchAssignment( numberOfSimulations );
 }
 
 void NetworkLevelReasoner::setNeuronVariable( NeuronIndex index, unsigned variable )
@@ -131,6 +185,20 @@ void NetworkLevelReasoner::receiveTighterBound( Tightening tightening )
     _boundTightenings.append( tightening );
 }
 
+ThreadPool *NetworkLevelReasoner::getThreadPool() const
+{
+    if ( !_threadPool )
+    {
+        int numberOfThreads = Options::get()->getInt( Options::NUM_PROPAGATION_THREADS );
+        if ( numberOfThreads <= 1 )
+            return NULL;
+
+        _threadPool = std::unique_ptr<ThreadPool>( new ThreadPool( numberOfThreads ) );
+    }
+
+    return _threadPool.get();
+}
+
 void NetworkLevelReasoner::getConstraintTightenings( List<Tightening> &tightenings )
 {
     tightenings = _boundTightenings;
@@ -139,12 +207,16 @@ void NetworkLevelReasoner::getConstraintTightenings( List<Tightening> &tightenin
 
 void NetworkLevelReasoner::symbolicBoundPropagation()
 {
+    PROFILE_SCOPE( "NLR::symbolicBoundPropagation" );
+
     for ( unsigned i = 0; i < _layerIndexToLayer.size(); ++i )
         _layerIndexToLayer[i]->computeSymbolicBounds();
 }
 
 void NetworkLevelReasoner::deepPolyPropagation()
 {
+    PROFILE_SCOPE( "NLR::deepPolyPropagation" );
+
     if ( _deepPolyAnalysis == nullptr )
         _deepPolyAnalysis = std::unique_ptr<DeepPolyAnalysis>
             ( new DeepPolyAnalysis( this ) );
@@ -153,6 +225,8 @@ void NetworkLevelReasoner::deepPolyPropagation()
 
 void NetworkLevelReasoner::lpRelaxationPropagation()
 {
+    PROFILE_SCOPE( "NLR::lpRelaxationPropagation" );
+
     LPFormulator lpFormulator( this );
     lpFormulator.setCutoff( 0 );
 
@@ -166,6 +240,8 @@ void NetworkLevelReasoner::lpRelaxationPropagation()
 
 void NetworkLevelReasoner::MILPPropagation()
 {
+    PROFILE_SCOPE( "NLR::MILPPropagation" );
+
     MILPFormulator milpFormulator( this );
     milpFormulator.setCutoff( 0 );
 
@@ -179,6 +255,8 @@ void NetworkLevelReasoner::MILPPropagation()
 
 void NetworkLevelReasoner::iterativePropagation()
 {
+    PROFILE_SCOPE( "NLR::iterativePropagation" );
+
     IterativePropagator iterativePropagator( this );
     iterativePropagator.setCutoff( 0 );
     iterativePropagator.optimizeBoundsWithIterativePropagation( _layerIndexToLayer );
@@ -186,6 +264,8 @@ void NetworkLevelReasoner::iterativePropagation()
 
 void NetworkLevelReasoner::intervalArithmeticBoundPropagation()
 {
+    PROFILE_SCOPE( "NLR::intervalArithmeticBoundPropagation" );
+
     for ( unsigned i = 1; i < _layerIndexToLayer.size(); ++i )
         _layerIndexToLayer[i]->computeIntervalArithmeticBounds();
 }
@@ -351,6 +431,10 @@ void NetworkLevelReasoner::generateInputQueryForLayer( InputQuery &inputQuery,
         generateInputQueryForWeightedSumLayer( inputQuery, layer );
         break;
 
+    case Layer::CONVOLUTION:
+        generateInputQueryForConvolutionLayer( inputQuery, layer );
+        break;
+
     case Layer::RELU:
         generateInputQueryForReluLayer( inputQuery, layer );
         break;
@@ -447,6 +531,83 @@ void NetworkLevelReasoner::generateInputQueryForWeightedSumLayer( InputQuery &in
     }
 }
 
+void NetworkLevelReasoner::generateInputQueryForConvolutionLayer( InputQuery &inputQuery, const Layer &layer )
+{
+    // Only the weights inside each neuron's receptive field are non-zero,
+    // so the equations are built from the layer's sparse weights
+    Vector<Equation> equations( layer.getSize() );
+    for ( unsigned i = 0; i < layer.getSize(); ++i )
+    {
+        equations[i].setScalar( -layer.getBias( i ) );
+        equations[i].addAddend( -1, layer.neuronToVariable( i ) );
+    }
+
+    for ( const auto &it : layer.getSourceLayers() )
+    {
+        const Layer *sourceLayer = _layerIndexToLayer[it.first];
+        const Layer::SparseWeights *sparseWeights = layer.getSparseWeights( it.first );
+
+        for ( unsigned j = 0; j < sourceLayer->getSize(); ++j )
+        {
+            unsigned rowEnd = sparseWeights->_rowStart.get( j + 1 );
+            for ( unsigned entry = sparseWeights->_rowStart.get( j ); entry < rowEnd; ++entry )
+                equations[sparseWeights->_targetNeurons.get( entry )].addAddend
+                    ( sparseWeights->_weights.get( entry ), sourceLayer->neuronToVariable( j ) );
+        }
+    }
+
+    for ( const auto &equation : equations )
+        inputQuery.addEquation( equation );
+}
+
+void NetworkLevelReasoner::detectConvolutionLayers()
+{
+    for ( unsigned i = 1; i < getNumberOfLayers(); ++i )
+    {
+        Layer *weightedSum = _layerIndexToLayer[i];
+
+        bool hasEliminatedNeurons = false;
+        for ( unsigned j = 0; j < weightedSum->getSize(); ++j )
+        {
+            if ( weightedSum->neuronEliminated( j ) )
+                hasEliminatedNeurons = true;
+        }
+
+        ConvolutionDetector::Convolution detected;
+        if ( hasEliminatedNeurons || !ConvolutionDetector::detect( *weightedSum, detected ) )
+            continue;
+
+        const Layer::ConvolutionParameters &parameters = detected._parameters;
+        unsigned sourceLayer = weightedSum->getSourceLayers().begin()->first;
+        Layer *convolution = new Layer( i, Layer::CONVOLUTION, weightedSum->getSize(), this );
+        convolution->addSourceLayer( sourceLayer, _layerIndexToLayer[sourceLayer]->getSize() );
+        convolution->setConvolutionParameters( parameters );
+
+        unsigned index = 0;
+        for ( unsigned oc = 0; oc < parameters._outputChannels; ++oc )
+        {
+            for ( unsigned ic = 0; ic < parameters._inputChannels; ++ic )
+                for ( unsigned row = 0; row < parameters._kernelHeight; ++row )
+                    for ( unsigned column = 0; column < parameters._kernelWidth; ++column )
+                        convolution->setKernelWeight( oc, ic, row, column, detected._kernel[index++] );
+
+            convolution->setChannelBias( oc, detected._channelBiases[oc] );
+        }
+
+        for ( unsigned j = 0; j < weightedSum->getSize(); ++j )
+        {
+            if ( weightedSum->neuronHasVariable( j ) )
+                convolution->setNeuronVariable( j, weightedSum->neuronToVariable( j ) );
+
+            convolution->setLb( j, weightedSum->getLb( j ) );
+            convolution->setUb( j, weightedSum->getUb( j ) );
+        }
+
+        _layerIndexToLayer[i] = convolution;
+        delete weightedSum;
+    }
+}
+
 void NetworkLevelReasoner::mergeConsecutiveWSLayers()
 {
     // Iterate over all layers, except the input layer
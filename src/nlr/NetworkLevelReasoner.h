@@ -55,6 +55,15 @@ public:
                     unsigned targetNeuron,
                     double weight );
     void setBias( unsigned layer, unsigned neuron, double bias );
+    void setConvolutionParameters( unsigned layer,
+                                   const Layer::ConvolutionParameters &parameters );
+    void setKernelWeight( unsigned layer,
+                          unsigned outputChannel,
+                          unsigned inputChannel,
+                          unsigned row,
+                          unsigned column,
+                          double weight );
+    void setChannelBias( unsigned layer, unsigned outputChannel, double bias );
     void addActivationSource( unsigned sourceLayer,
                               unsigned sourceNeuron,
                               unsigned targetLeyer,
@@ -75,9 +84,21 @@ public:
     void evaluate( double *input , double *output );
 
     /*
-      Perform a simulation of the network for a specific input
+      Evaluate the network for a batch of inputs. Inputs and outputs
+      are stored row-major, one vector after the other. Weighted-sum
+      layers are evaluated as a single matrix multiplication for the
+      whole batch.
+    */
+    void evaluateBatch( const double *input, double *output, unsigned batchSize );
+
+    /*
+      Perform a simulation of the network for a set of inputs: either
+      per input neuron (one vector of values per neuron), or as a
+      row-major batch. The results are the layers' batch assignments,
+      see Layer::getBatchAssignment().
     */
    void simulate( Vector<Vector<double>> *input );
+   void simulate( const double *input, unsigned numberOfSimulations );
 
     /*
       Bound propagation methods:
@@ -104,6 +125,14 @@ public:
         - receiveTighterBound: this is a callback from the layer
           objects, through which they report tighter bounds.
 
+        - getThreadPool: the pool on which the layers (and DeepPoly)
+          split the propagation within a layer into blocks of
+          neurons. It is created on first use, with the number of
+          threads given by the num-propagation-threads option; for a
+          single thread there is no pool, and propagation is
+          sequential. Either way, the same bounds are reported, in the
+          same order.
+
         - getConstraintTightenings: this is the function that an
           external user calls in order to collect the tighter bounds
           discovered by the NLR.
@@ -123,6 +152,8 @@ public:
     void receiveTighterBound( Tightening tightening );
     void getConstraintTightenings( List<Tightening> &tightenings );
 
+    ThreadPool *getThreadPool() const;
+
     /*
       For debugging purposes: dump the network topology
     */
@@ -163,6 +194,13 @@ public:
     */
     void mergeConsecutiveWSLayers();
 
+    /*
+      Replace weighted sum layers whose weights are those of a
+      convolution (e.g., convolutions lowered to equations by a front
+      end) with convolution layers
+    */
+    void detectConvolutionLayers();
+
     /*
       Print the bounds of variables layer by layer
     */
@@ -185,6 +223,8 @@ private:
 
     std::unique_ptr<DeepPolyAnalysis> _deepPolyAnalysis;
 
+    mutable std::unique_ptr<ThreadPool> _threadPool;
+
     void freeMemoryIfNeeded();
 
     List<PiecewiseLinearConstraint *> _constraintsInTopologicalOrder;
@@ -192,6 +232,7 @@ private:
     // Helper functions for generating an input query
     void generateInputQueryForLayer( InputQuery &inputQuery, const Layer &layer );
     void generateInputQueryForWeightedSumLayer( InputQuery &inputQuery, const Layer &layer );
+    void generateInputQueryForConvolutionLayer( InputQuery &inputQuery, const Layer &layer );
     void generateInputQueryForReluLayer( InputQuery &inputQuery, const Layer &layer );
     void generateInputQueryForSignLayer( InputQuery &inputQuery, const Layer &layer );
     void generateInputQueryForAbsoluteValueLayer( InputQuery &inputQuery, const Layer &layer );
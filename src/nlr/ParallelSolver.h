@@ -16,7 +16,7 @@
 #ifndef __ParallelSolver_h__
 #define __ParallelSolver_h__
 
-#include "GurobiWrapper.h"
+#include "ILPSolver.h"
 
 #include <atomic>
 #include <boost/lockfree/queue.hpp>
@@ -33,7 +33,7 @@ class ParallelSolver
 public:
 
     typedef boost::lockfree::queue
-    <GurobiWrapper *, boost::lockfree::fixed_sized<true>> SolverQueue;
+    <ILPSolver *, boost::lockfree::fixed_sized<true>> SolverQueue;
 
     /*
       Arguments for the spawned thread. This is needed because Boost::thread does
@@ -41,7 +41,7 @@ public:
     */
     struct ThreadArgument{
 
-        ThreadArgument( GurobiWrapper *gurobi, Layer *layer,
+        ThreadArgument( ILPSolver *gurobi, Layer *layer,
                         const Map<unsigned, Layer *> *layers,
                         unsigned index, double currentLb, double currentUb,
                         bool cutoffInUse, double cutoffValue,
@@ -72,7 +72,7 @@ public:
         {
         }
 
-        ThreadArgument( GurobiWrapper *gurobi, Layer *layer,
+        ThreadArgument( ILPSolver *gurobi, Layer *layer,
                         unsigned index, double currentLb, double currentUb,
                         bool cutoffInUse, double cutoffValue,
                         LayerOwner *layerOwner, SolverQueue &freeSolvers,
@@ -102,7 +102,7 @@ public:
         {
         }
 
-        ThreadArgument( GurobiWrapper *gurobi, Layer *layer,
+        ThreadArgument( ILPSolver *gurobi, Layer *layer,
                         unsigned index, double currentLb, double currentUb,
                         bool cutoffInUse, double cutoffValue,
                         LayerOwner *layerOwner, SolverQueue &freeSolvers,
@@ -129,7 +129,7 @@ public:
         {
         }
 
-        GurobiWrapper *_gurobi;
+        ILPSolver *_gurobi;
         Layer *_layer;
         const Map<unsigned, Layer *> *_layers;
         unsigned _index;
@@ -154,7 +154,7 @@ public:
     */
     static void clearSolverQueue( SolverQueue &freeSolvers );
 
-    static void enqueueSolver( SolverQueue &solvers, GurobiWrapper *solver );
+    static void enqueueSolver( SolverQueue &solvers, ILPSolver *solver );
 };
 
 } // namespace NLR
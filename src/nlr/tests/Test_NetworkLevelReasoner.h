@@ -24,6 +24,8 @@
 #include "Tightening.h"
 #include "Vector.h"
 
+#include <cmath>
+
 class MockForNetworkLevelReasoner
 {
 public:
@@ -278,6 +280,113 @@ public:
         TS_ASSERT( FloatUtils::areEqual( output[1], 4 ) );
     }
 
+    void test_evaluate_batch()
+    {
+        NLR::NetworkLevelReasoner nlr;
+
+        populateNetwork( nlr );
+
+        // The inputs of test_evaluate_relus, one after the other
+        double input[6] = { 0, 0, 1, 1, 1, 2 };
+        double output[6];
+
+        TS_ASSERT_THROWS_NOTHING( nlr.evaluateBatch( input, output, 3 ) );
+
+        TS_ASSERT( FloatUtils::areEqual( output[0], 1 ) );
+        TS_ASSERT( FloatUtils::areEqual( output[1], 4 ) );
+        TS_ASSERT( FloatUtils::areEqual( output[2], 1 ) );
+        TS_ASSERT( FloatUtils::areEqual( output[3], 1 ) );
+        TS_ASSERT( FloatUtils::areEqual( output[4], 0 ) );
+        TS_ASSERT( FloatUtils::areEqual( output[5], 0 ) );
+
+        // The intermediate layers keep the batch
+        TS_ASSERT_EQUALS( nlr.getLayer( 1 )->getBatchSize(), 3U );
+
+        // Each row matches a single evaluation
+        double singleOutput[2];
+        for ( unsigned k = 0; k < 3; ++k )
+        {
+            TS_ASSERT_THROWS_NOTHING( nlr.evaluate( input + 2 * k, singleOutput ) );
+            TS_ASSERT( FloatUtils::areEqual( output[2 * k], singleOutput[0] ) );
+            TS_ASSERT( FloatUtils::areEqual( output[2 * k + 1], singleOutput[1] ) );
+        }
+
+        // A smaller batch reuses the memory
+        TS_ASSERT_THROWS_NOTHING( nlr.evaluateBatch( input + 4, output, 1 ) );
+        TS_ASSERT( FloatUtils::areEqual( output[0], 0 ) );
+        TS_ASSERT( FloatUtils::areEqual( output[1], 0 ) );
+
+        // An eliminated input neuron keeps its value, whatever the input
+        NLR::NetworkLevelReasoner original;
+        populateNetwork( original );
+        double fixedInput[4] = { 0, 2, 1, 2 };
+        double expectedOutput[4];
+        TS_ASSERT_THROWS_NOTHING( original.evaluateBatch( fixedInput, expectedOutput, 2 ) );
+
+        nlr.eliminateVariable( 1, 2 );
+        TS_ASSERT_THROWS_NOTHING( nlr.evaluateBatch( input, output, 2 ) );
+        for ( unsigned i = 0; i < 4; ++i )
+            TS_ASSERT( FloatUtils::areEqual( output[i], expectedOutput[i] ) );
+        TS_ASSERT( FloatUtils::areEqual( nlr.getLayer( 0 )->getBatchAssignment( 1, 0 ), 2 ) );
+
+        TS_ASSERT_THROWS_NOTHING( nlr.evaluate( input, output ) );
+        TS_ASSERT( FloatUtils::areEqual( output[0], expectedOutput[0] ) );
+        TS_ASSERT( FloatUtils::areEqual( output[1], expectedOutput[1] ) );
+    }
+
+    void test_evaluate_batch_non_consecutive_layers()
+    {
+        NLR::NetworkLevelReasoner nlr;
+
+        // Create the layers
+        nlr.addLayer( 0, NLR::Layer::INPUT, 2 );
+        nlr.addLayer( 1, NLR::Layer::WEIGHTED_SUM, 3 );
+        nlr.addLayer( 2, NLR::Layer::RELU, 3 );
+        nlr.addLayer( 3, NLR::Layer::WEIGHTED_SUM, 2 );
+        nlr.addLayer( 4, NLR::Layer::RELU, 3 );
+        nlr.addLayer( 5, NLR::Layer::WEIGHTED_SUM, 1 );
+
+        // Mark layer dependencies
+        nlr.addLayerDependency( 0, 1 );
+        nlr.addLayerDependency( 1, 2 );
+        nlr.addLayerDependency( 2, 3 );
+        nlr.addLayerDependency( 0, 3 );
+        nlr.addLayerDependency( 3, 4 );
+        nlr.addLayerDependency( 0, 4 );
+        nlr.addLayerDependency( 4, 5 );
+
+        // Set the weights and relus
+        nlr.setWeight( 0, 0, 1, 0, 1 );
+        nlr.setWeight( 0, 0, 1, 1, 2 );
+        nlr.setWeight( 0, 1, 1, 1, -3 );
+        nlr.setWeight( 0, 1, 1, 2, 1 );
+
+        nlr.addActivationSource( 1, 0, 2, 0 );
+        nlr.addActivationSource( 1, 1, 2, 1 );
+        nlr.addActivationSource( 1, 2, 2, 2 );
+
+        nlr.setWeight( 2, 0, 3, 0, 1 );
+        nlr.setWeight( 2, 1, 3, 0, 2 );
+        nlr.setWeight( 2, 2, 3, 1, -2 );
+        nlr.setWeight( 0, 1, 3, 1, 1 );
+
+        nlr.addActivationSource( 3, 0, 4, 0 );
+        nlr.addActivationSource( 3, 1, 4, 1 );
+        nlr.addActivationSource( 0, 0, 4, 2 );
+
+        nlr.setWeight( 4, 0, 5, 0, 1 );
+        nlr.setWeight( 4, 1, 5, 0, 1 );
+        nlr.setWeight( 4, 2, 5, 0, 1 );
+
+        // Evaluate
+        double input[4] = { 1, 1, -1, 2 };
+        double output[2];
+
+        TS_ASSERT_THROWS_NOTHING( nlr.evaluateBatch( input, output, 2 ) );
+        TS_ASSERT( FloatUtils::areEqual( output[0], 2 ) );
+        TS_ASSERT( FloatUtils::areEqual( output[1], 0 ) );
+    }
+
     void test_store_into_other()
     {
         NLR::NetworkLevelReasoner nlr;
@@ -1493,6 +1602,552 @@ public:
             TS_ASSERT( expectedBounds.exists( bound ) );
     }
 
+    void test_sbt_sparse_weights()
+    {
+        Options::get()->setString( Options::SYMBOLIC_BOUND_TIGHTENING_TYPE,
+                                   "sbt" );
+
+        NLR::NetworkLevelReasoner nlr;
+        MockTableau tableau;
+        nlr.setTableau( &tableau );
+
+        /*
+          The first weighted sum layer is diagonal, and so is
+          propagated through the sparse kernel:
+
+          x4 = 2x0 + 1     x8  = ReLU( x4 )
+          x5 = -x1         x9  = ReLU( x5 )
+          x6 = x2          x10 = ReLU( x6 )
+          x7 = -3x3        x11 = ReLU( x7 )
+
+          x12 = x8 - x10 + x11
+        */
+        nlr.addLayer( 0, NLR::Layer::INPUT, 4 );
+        nlr.addLayer( 1, NLR::Layer::WEIGHTED_SUM, 4 );
+        nlr.addLayer( 2, NLR::Layer::RELU, 4 );
+        nlr.addLayer( 3, NLR::Layer::WEIGHTED_SUM, 1 );
+
+        for ( unsigned i = 1; i <= 3; ++i )
+            nlr.addLayerDependency( i - 1, i );
+
+        nlr.setWeight( 0, 0, 1, 0, 2 );
+        nlr.setWeight( 0, 1, 1, 1, -1 );
+        nlr.setWeight( 0, 2, 1, 2, 1 );
+        nlr.setWeight( 0, 3, 1, 3, -3 );
+        nlr.setBias( 1, 0, 1 );
+
+        nlr.setWeight( 2, 0, 3, 0, 1 );
+        nlr.setWeight( 2, 2, 3, 0, -1 );
+        nlr.setWeight( 2, 3, 3, 0, 1 );
+
+        for ( unsigned i = 0; i < 4; ++i )
+            nlr.addActivationSource( 1, i, 2, i );
+
+        for ( unsigned i = 0; i < 4; ++i )
+        {
+            nlr.setNeuronVariable( NLR::NeuronIndex( 0, i ), i );
+            nlr.setNeuronVariable( NLR::NeuronIndex( 1, i ), i + 4 );
+            nlr.setNeuronVariable( NLR::NeuronIndex( 2, i ), i + 8 );
+        }
+        nlr.setNeuronVariable( NLR::NeuronIndex( 3, 0 ), 12 );
+
+        double large = 1000000;
+        for ( unsigned i = 4; i <= 12; ++i )
+        {
+            tableau.setLowerBound( i, -large );
+            tableau.setUpperBound( i, large );
+        }
+
+        tableau.setLowerBound( 0, 1 );
+        tableau.setUpperBound( 0, 2 );
+        tableau.setLowerBound( 1, -1 );
+        tableau.setUpperBound( 1, 1 );
+        tableau.setLowerBound( 2, 0 );
+        tableau.setUpperBound( 2, 3 );
+        tableau.setLowerBound( 3, -2 );
+        tableau.setUpperBound( 3, -1 );
+
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_THROWS_NOTHING( nlr.symbolicBoundPropagation() );
+
+        List<Tightening> expectedBounds({
+                Tightening( 4, 3, Tightening::LB ),
+                Tightening( 4, 5, Tightening::UB ),
+                Tightening( 5, -1, Tightening::LB ),
+                Tightening( 5, 1, Tightening::UB ),
+                Tightening( 6, 0, Tightening::LB ),
+                Tightening( 6, 3, Tightening::UB ),
+                Tightening( 7, 3, Tightening::LB ),
+                Tightening( 7, 6, Tightening::UB ),
+
+                Tightening( 8, 3, Tightening::LB ),
+                Tightening( 8, 5, Tightening::UB ),
+                Tightening( 10, 0, Tightening::LB ),
+                Tightening( 10, 3, Tightening::UB ),
+                Tightening( 11, 3, Tightening::LB ),
+                Tightening( 11, 6, Tightening::UB ),
+
+                Tightening( 12, 3, Tightening::LB ),
+                Tightening( 12, 11, Tightening::UB ),
+                    });
+
+        List<Tightening> bounds;
+        TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( bounds ) );
+        for ( const auto &bound : expectedBounds )
+            TS_ASSERT( bounds.exists( bound ) );
+
+        // Changing a weight discards the sparse copy of the weights
+        nlr.setWeight( 0, 0, 1, 0, 3 );
+
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_THROWS_NOTHING( nlr.symbolicBoundPropagation() );
+
+        bounds.clear();
+        TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( bounds ) );
+        TS_ASSERT( bounds.exists( Tightening( 4, 4, Tightening::LB ) ) );
+        TS_ASSERT( bounds.exists( Tightening( 4, 7, Tightening::UB ) ) );
+        TS_ASSERT( bounds.exists( Tightening( 12, 4, Tightening::LB ) ) );
+        TS_ASSERT( bounds.exists( Tightening( 12, 13, Tightening::UB ) ) );
+    }
+
+    void populateWideNetwork( NLR::NetworkLevelReasoner &nlr, MockTableau &tableau )
+    {
+        /*
+          A network that is wide enough for the propagation within a
+          layer to be split between threads: 256 inputs, followed by
+          a dense weighted sum, ReLUs, a sparse weighted sum, absolute
+          values, a dense weighted sum, ReLUs and 4 outputs.
+        */
+        const unsigned width = 256;
+        nlr.addLayer( 0, NLR::Layer::INPUT, width );
+        nlr.addLayer( 1, NLR::Layer::WEIGHTED_SUM, width );
+        nlr.addLayer( 2, NLR::Layer::RELU, width );
+        nlr.addLayer( 3, NLR::Layer::WEIGHTED_SUM, width );
+        nlr.addLayer( 4, NLR::Layer::ABSOLUTE_VALUE, width );
+        nlr.addLayer( 5, NLR::Layer::WEIGHTED_SUM, width );
+        nlr.addLayer( 6, NLR::Layer::RELU, width );
+        nlr.addLayer( 7, NLR::Layer::WEIGHTED_SUM, 4 );
+
+        for ( unsigned i = 1; i <= 7; ++i )
+            nlr.addLayerDependency( i - 1, i );
+
+        for ( unsigned layer = 1; layer <= 7; layer += 2 )
+        {
+            unsigned targetSize = ( layer == 7 ) ? 4 : width;
+            for ( unsigned i = 0; i < width; ++i )
+            {
+                for ( unsigned j = 0; j < targetSize; ++j )
+                {
+                    // Only about a fifth of the weights of layer 3 are non-zero
+                    if ( layer == 3 && ( i * 7 + j * 3 ) % 5 != 0 )
+                        continue;
+
+                    nlr.setWeight( layer - 1, i, layer, j, std::sin( 1 + 0.37 * i + 1.93 * j + 7 * layer ) );
+                }
+            }
+
+            for ( unsigned j = 0; j < targetSize; ++j )
+                nlr.setBias( layer, j, 0.1 * std::cos( j + layer ) );
+
+            if ( layer < 7 )
+            {
+                for ( unsigned i = 0; i < width; ++i )
+                    nlr.addActivationSource( layer, i, layer + 1, i );
+            }
+        }
+
+        unsigned variable = 0;
+        for ( unsigned layer = 0; layer <= 7; ++layer )
+        {
+            unsigned size = ( layer == 7 ) ? 4 : width;
+            for ( unsigned i = 0; i < size; ++i )
+            {
+                nlr.setNeuronVariable( NLR::NeuronIndex( layer, i ), variable );
+
+                if ( layer == 0 )
+                {
+                    tableau.setLowerBound( variable, -0.1 + 0.001 * i );
+                    tableau.setUpperBound( variable, 0.1 + 0.002 * i );
+                }
+                else
+                {
+                    tableau.setLowerBound( variable, -1000000 );
+                    tableau.setUpperBound( variable, 1000000 );
+                }
+
+                ++variable;
+            }
+        }
+    }
+
+    void test_parallel_propagation_matches_sequential()
+    {
+        Options::get()->setString( Options::SYMBOLIC_BOUND_TIGHTENING_TYPE,
+                                   "sbt" );
+
+        enum {
+            INTERVAL_ARITHMETIC,
+            SYMBOLIC,
+            DEEP_POLY,
+        };
+
+        for ( unsigned propagation = INTERVAL_ARITHMETIC; propagation <= DEEP_POLY; ++propagation )
+        {
+            List<Tightening> sequentialBounds;
+            List<Tightening> parallelBounds;
+
+            for ( unsigned numberOfThreads : { 1, 4 } )
+            {
+                Options::get()->setInt( Options::NUM_PROPAGATION_THREADS, numberOfThreads );
+
+                NLR::NetworkLevelReasoner nlr;
+                MockTableau tableau;
+                nlr.setTableau( &tableau );
+                populateWideNetwork( nlr, tableau );
+
+                TS_ASSERT_EQUALS( nlr.getThreadPool() != NULL, numberOfThreads > 1 );
+
+                TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+                if ( propagation == INTERVAL_ARITHMETIC )
+                    TS_ASSERT_THROWS_NOTHING( nlr.intervalArithmeticBoundPropagation() );
+                if ( propagation == SYMBOLIC )
+                    TS_ASSERT_THROWS_NOTHING( nlr.symbolicBoundPropagation() );
+                if ( propagation == DEEP_POLY )
+                    TS_ASSERT_THROWS_NOTHING( nlr.deepPolyPropagation() );
+
+                TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings
+                                          ( numberOfThreads == 1 ? sequentialBounds : parallelBounds ) );
+            }
+
+            // The same bounds are discovered, in the same order
+            TS_ASSERT( !sequentialBounds.empty() );
+            TS_ASSERT_EQUALS( sequentialBounds.size(), parallelBounds.size() );
+
+            auto sequential = sequentialBounds.begin();
+            auto parallel = parallelBounds.begin();
+            for ( ; sequential != sequentialBounds.end() && parallel != parallelBounds.end();
+                  ++sequential, ++parallel )
+            {
+                TS_ASSERT_EQUALS( sequential->_variable, parallel->_variable );
+                TS_ASSERT_EQUALS( sequential->_type, parallel->_type );
+                TS_ASSERT_EQUALS( sequential->_value, parallel->_value );
+            }
+        }
+
+        Options::get()->setInt( Options::NUM_PROPAGATION_THREADS, 1 );
+    }
+
+    void test_evaluate_convolution()
+    {
+        NLR::NetworkLevelReasoner nlr;
+
+        /*
+          A single 3x3 input channel, and two 2x2 kernels with stride 1
+          and no padding, followed by ReLUs:
+
+                             | 1  0 |           | 0 -1 |
+          input = x0..x8,    | 0  2 | + 1,      | 1  0 |
+        */
+        nlr.addLayer( 0, NLR::Layer::INPUT, 9 );
+        nlr.addLayer( 1, NLR::Layer::CONVOLUTION, 8 );
+        nlr.addLayer( 2, NLR::Layer::RELU, 8 );
+
+        nlr.addLayerDependency( 0, 1 );
+        nlr.addLayerDependency( 1, 2 );
+
+        NLR::Layer::ConvolutionParameters parameters;
+        parameters._inputChannels = 1;
+        parameters._inputHeight = 3;
+        parameters._inputWidth = 3;
+        parameters._outputChannels = 2;
+        parameters._kernelHeight = 2;
+        parameters._kernelWidth = 2;
+        nlr.setConvolutionParameters( 1, parameters );
+
+        nlr.setKernelWeight( 1, 0, 0, 0, 0, 1 );
+        nlr.setKernelWeight( 1, 0, 0, 1, 1, 2 );
+        nlr.setKernelWeight( 1, 1, 0, 0, 1, -1 );
+        nlr.setKernelWeight( 1, 1, 0, 1, 0, 1 );
+        nlr.setChannelBias( 1, 0, 1 );
+
+        for ( unsigned i = 0; i < 8; ++i )
+            nlr.addActivationSource( 1, i, 2, i );
+
+        // Output neuron 3 is the bottom right corner of the first channel
+        const NLR::Layer *convolution = nlr.getLayer( 1 );
+        TS_ASSERT_EQUALS( convolution->getWeight( 0, 4, 3 ), 1 );
+        TS_ASSERT_EQUALS( convolution->getWeight( 0, 8, 3 ), 2 );
+        TS_ASSERT_EQUALS( convolution->getWeight( 0, 0, 3 ), 0 );
+        TS_ASSERT_EQUALS( convolution->getBias( 3 ), 1 );
+        TS_ASSERT_EQUALS( convolution->getBias( 4 ), 0 );
+
+        double input[9] = { 1, 2, 3,
+                            4, 5, 6,
+                            7, 8, 9 };
+        double output[8];
+
+        TS_ASSERT_THROWS_NOTHING( nlr.evaluate( input, output ) );
+
+        double expected[8] = { 12, 15, 21, 24,
+                               2, 2, 2, 2 };
+        for ( unsigned i = 0; i < 8; ++i )
+            TS_ASSERT( FloatUtils::areEqual( output[i], expected[i] ) );
+
+        // With negated inputs, all the ReLUs are inactive
+        for ( unsigned i = 0; i < 9; ++i )
+            input[i] = -input[i];
+
+        TS_ASSERT_THROWS_NOTHING( nlr.evaluateBatch( input, output, 1 ) );
+        for ( unsigned i = 0; i < 8; ++i )
+            TS_ASSERT( FloatUtils::areEqual( output[i], 0 ) );
+    }
+
+    void populateConvolutionNetwork( NLR::NetworkLevelReasoner &nlr, MockTableau &tableau,
+                                     const NLR::Layer *convolution )
+    {
+        /*
+          Two 5x5 input channels, a convolution with three 3x3 kernels,
+          stride 2 and padding 1, ReLUs and 2 outputs. If a convolution
+          layer is given, layer 1 is instead a weighted sum with the
+          same (dense) weights.
+        */
+        nlr.addLayer( 0, NLR::Layer::INPUT, 50 );
+        nlr.addLayer( 1, convolution ? NLR::Layer::WEIGHTED_SUM : NLR::Layer::CONVOLUTION, 27 );
+        nlr.addLayer( 2, NLR::Layer::RELU, 27 );
+        nlr.addLayer( 3, NLR::Layer::WEIGHTED_SUM, 2 );
+
+        for ( unsigned i = 1; i <= 3; ++i )
+            nlr.addLayerDependency( i - 1, i );
+
+        if ( convolution )
+        {
+            for ( unsigned i = 0; i < 50; ++i )
+                for ( unsigned j = 0; j < 27; ++j )
+                    nlr.setWeight( 0, i, 1, j, convolution->getWeight( 0, i, j ) );
+
+            for ( unsigned j = 0; j < 27; ++j )
+                nlr.setBias( 1, j, convolution->getBias( j ) );
+        }
+        else
+        {
+            NLR::Layer::ConvolutionParameters parameters;
+            parameters._inputChannels = 2;
+            parameters._inputHeight = 5;
+            parameters._inputWidth = 5;
+            parameters._outputChannels = 3;
+            parameters._kernelHeight = 3;
+            parameters._kernelWidth = 3;
+            parameters._strideHeight = 2;
+            parameters._strideWidth = 2;
+            parameters._paddingHeight = 1;
+            parameters._paddingWidth = 1;
+            nlr.setConvolutionParameters( 1, parameters );
+
+            for ( unsigned oc = 0; oc < 3; ++oc )
+            {
+                for ( unsigned ic = 0; ic < 2; ++ic )
+                    for ( unsigned row = 0; row < 3; ++row )
+                        for ( unsigned column = 0; column < 3; ++column )
+                            nlr.setKernelWeight( 1, oc, ic, row, column,
+                                                 std::sin( 1 + oc + 0.7 * ic + 1.3 * row + 0.4 * column ) );
+
+                nlr.setChannelBias( 1, oc, 0.1 * oc );
+            }
+        }
+
+        for ( unsigned i = 0; i < 27; ++i )
+        {
+            nlr.addActivationSource( 1, i, 2, i );
+            for ( unsigned j = 0; j < 2; ++j )
+                nlr.setWeight( 2, i, 3, j, std::cos( 0.3 * i + 2 * j ) );
+        }
+
+        unsigned variable = 0;
+        for ( unsigned layer = 0; layer <= 3; ++layer )
+        {
+            for ( unsigned i = 0; i < nlr.getLayer( layer )->getSize(); ++i )
+            {
+                nlr.setNeuronVariable( NLR::NeuronIndex( layer, i ), variable );
+
+                if ( layer == 0 )
+                {
+                    tableau.setLowerBound( variable, -0.1 * ( i % 3 ) );
+                    tableau.setUpperBound( variable, 0.2 + 0.01 * i );
+                }
+                else
+                {
+                    tableau.setLowerBound( variable, -1000000 );
+                    tableau.setUpperBound( variable, 1000000 );
+                }
+
+                ++variable;
+            }
+        }
+    }
+
+    void test_convolution_matches_weighted_sum()
+    {
+        Options::get()->setString( Options::SYMBOLIC_BOUND_TIGHTENING_TYPE,
+                                   "sbt" );
+
+        NLR::NetworkLevelReasoner convolutionNlr;
+        MockTableau convolutionTableau;
+        convolutionNlr.setTableau( &convolutionTableau );
+        populateConvolutionNetwork( convolutionNlr, convolutionTableau, NULL );
+
+        NLR::NetworkLevelReasoner denseNlr;
+        MockTableau denseTableau;
+        denseNlr.setTableau( &denseTableau );
+        populateConvolutionNetwork( denseNlr, denseTableau, convolutionNlr.getLayer( 1 ) );
+
+        // Each output neuron sees at most 2 * 3 * 3 inputs
+        unsigned nonZeros = 0;
+        for ( unsigned i = 0; i < 50; ++i )
+            for ( unsigned j = 0; j < 27; ++j )
+                if ( denseNlr.getLayer( 1 )->getWeight( 0, i, j ) != 0 )
+                    ++nonZeros;
+        TS_ASSERT( nonZeros > 0 );
+        TS_ASSERT( nonZeros <= 27U * 18 );
+
+        // Evaluation
+        double input[100];
+        for ( unsigned i = 0; i < 100; ++i )
+            input[i] = std::sin( 0.5 * i );
+
+        double convolutionOutput[4];
+        double denseOutput[4];
+
+        TS_ASSERT_THROWS_NOTHING( convolutionNlr.evaluateBatch( input, convolutionOutput, 2 ) );
+        TS_ASSERT_THROWS_NOTHING( denseNlr.evaluateBatch( input, denseOutput, 2 ) );
+        for ( unsigned i = 0; i < 4; ++i )
+            TS_ASSERT( FloatUtils::areEqual( convolutionOutput[i], denseOutput[i] ) );
+
+        TS_ASSERT_THROWS_NOTHING( convolutionNlr.evaluate( input + 50, convolutionOutput ) );
+        TS_ASSERT( FloatUtils::areEqual( convolutionOutput[0], denseOutput[2] ) );
+        TS_ASSERT( FloatUtils::areEqual( convolutionOutput[1], denseOutput[3] ) );
+
+        // Bound propagation
+        enum {
+            INTERVAL_ARITHMETIC,
+            SYMBOLIC,
+            DEEP_POLY,
+        };
+
+        for ( unsigned propagation = INTERVAL_ARITHMETIC; propagation <= DEEP_POLY; ++propagation )
+        {
+            List<Tightening> convolutionBounds;
+            List<Tightening> denseBounds;
+
+            for ( NLR::NetworkLevelReasoner *nlr : { &convolutionNlr, &denseNlr } )
+            {
+                TS_ASSERT_THROWS_NOTHING( nlr->obtainCurrentBounds() );
+                if ( propagation == INTERVAL_ARITHMETIC )
+                    TS_ASSERT_THROWS_NOTHING( nlr->intervalArithmeticBoundPropagation() );
+                if ( propagation == SYMBOLIC )
+                    TS_ASSERT_THROWS_NOTHING( nlr->symbolicBoundPropagation() );
+                if ( propagation == DEEP_POLY )
+                    TS_ASSERT_THROWS_NOTHING( nlr->deepPolyPropagation() );
+
+                TS_ASSERT_THROWS_NOTHING( nlr->getConstraintTightenings
+                                          ( nlr == &convolutionNlr ? convolutionBounds : denseBounds ) );
+            }
+
+            TS_ASSERT( !convolutionBounds.empty() );
+            TS_ASSERT_EQUALS( convolutionBounds.size(), denseBounds.size() );
+
+            auto convolution = convolutionBounds.begin();
+            auto dense = denseBounds.begin();
+            for ( ; convolution != convolutionBounds.end() && dense != denseBounds.end();
+                  ++convolution, ++dense )
+            {
+                TS_ASSERT_EQUALS( convolution->_variable, dense->_variable );
+                TS_ASSERT_EQUALS( convolution->_type, dense->_type );
+                TS_ASSERT( FloatUtils::areEqual( convolution->_value, dense->_value ) );
+            }
+        }
+    }
+
+    void test_detect_convolution_layers()
+    {
+        NLR::NetworkLevelReasoner convolutionNlr;
+        MockTableau convolutionTableau;
+        convolutionNlr.setTableau( &convolutionTableau );
+        populateConvolutionNetwork( convolutionNlr, convolutionTableau, NULL );
+
+        NLR::NetworkLevelReasoner denseNlr;
+        MockTableau denseTableau;
+        denseNlr.setTableau( &denseTableau );
+        populateConvolutionNetwork( denseNlr, denseTableau, convolutionNlr.getLayer( 1 ) );
+
+        TS_ASSERT_THROWS_NOTHING( denseNlr.detectConvolutionLayers() );
+        TS_ASSERT_EQUALS( denseNlr.getLayer( 1 )->getLayerType(), NLR::Layer::CONVOLUTION );
+        TS_ASSERT( denseNlr.getLayer( 1 )->getConvolutionParameters() ==
+                   convolutionNlr.getLayer( 1 )->getConvolutionParameters() );
+        TS_ASSERT( *denseNlr.getLayer( 1 ) == *convolutionNlr.getLayer( 1 ) );
+        TS_ASSERT_EQUALS( denseNlr.getLayer( 3 )->getLayerType(), NLR::Layer::WEIGHTED_SUM );
+
+        // Breaking the weight sharing leaves the weighted sum in place
+        NLR::NetworkLevelReasoner perturbedNlr;
+        MockTableau perturbedTableau;
+        perturbedNlr.setTableau( &perturbedTableau );
+        populateConvolutionNetwork( perturbedNlr, perturbedTableau, convolutionNlr.getLayer( 1 ) );
+        perturbedNlr.setWeight( 0, 12, 1, 13, perturbedNlr.getLayer( 1 )->getWeight( 0, 12, 13 ) + 1 );
+
+        TS_ASSERT_THROWS_NOTHING( perturbedNlr.detectConvolutionLayers() );
+        TS_ASSERT_EQUALS( perturbedNlr.getLayer( 1 )->getLayerType(), NLR::Layer::WEIGHTED_SUM );
+
+        // So does a differing bias within a channel
+        NLR::NetworkLevelReasoner biasedNlr;
+        MockTableau biasedTableau;
+        biasedNlr.setTableau( &biasedTableau );
+        populateConvolutionNetwork( biasedNlr, biasedTableau, convolutionNlr.getLayer( 1 ) );
+        biasedNlr.setBias( 1, 4, 5 );
+
+        TS_ASSERT_THROWS_NOTHING( biasedNlr.detectConvolutionLayers() );
+        TS_ASSERT_EQUALS( biasedNlr.getLayer( 1 )->getLayerType(), NLR::Layer::WEIGHTED_SUM );
+    }
+
+    void test_store_and_generate_input_query_for_convolution()
+    {
+        NLR::NetworkLevelReasoner nlr;
+        MockTableau tableau;
+        nlr.setTableau( &tableau );
+        populateConvolutionNetwork( nlr, tableau, NULL );
+
+        NLR::NetworkLevelReasoner other;
+        TS_ASSERT_THROWS_NOTHING( nlr.storeIntoOther( other ) );
+        TS_ASSERT( *nlr.getLayer( 1 ) == *other.getLayer( 1 ) );
+
+        // Convolutions are lowered to equations over the receptive fields
+        InputQuery ipq = nlr.generateInputQuery();
+        TS_ASSERT( ipq.constructNetworkLevelReasoner() );
+        NLR::NetworkLevelReasoner *reconstructedNlr = ipq.getNetworkLevelReasoner();
+
+        // ... and detected again when the network is reconstructed
+        TS_ASSERT_EQUALS( reconstructedNlr->getLayer( 1 )->getLayerType(),
+                          NLR::Layer::CONVOLUTION );
+        TS_ASSERT( reconstructedNlr->getLayer( 1 )->getConvolutionParameters() ==
+                   nlr.getLayer( 1 )->getConvolutionParameters() );
+
+        double input[50];
+        for ( unsigned i = 0; i < 50; ++i )
+            input[i] = std::cos( 0.7 * i );
+
+        double output[2];
+        double otherOutput[2];
+        double reconstructedOutput[2];
+
+        TS_ASSERT_THROWS_NOTHING( nlr.evaluate( input, output ) );
+        TS_ASSERT_THROWS_NOTHING( other.evaluate( input, otherOutput ) );
+        TS_ASSERT_THROWS_NOTHING( reconstructedNlr->evaluate( input, reconstructedOutput ) );
+
+        for ( unsigned i = 0; i < 2; ++i )
+        {
+            TS_ASSERT( FloatUtils::areEqual( output[i], otherOutput[i] ) );
+            TS_ASSERT( FloatUtils::areEqual( output[i], reconstructedOutput[i] ) );
+        }
+    }
+
     void test_generate_input_query()
     {
         NLR::NetworkLevelReasoner nlr;
@@ -1572,6 +2227,10 @@ public:
         TS_ASSERT( ipq.constructNetworkLevelReasoner() );
         NLR::NetworkLevelReasoner *reconstructedNlr = ipq.getNetworkLevelReasoner();
 
+        // Dense layers are not mistaken for convolutions
+        TS_ASSERT_EQUALS( reconstructedNlr->getLayer( 1 )->getLayerType(),
+                          NLR::Layer::WEIGHTED_SUM );
+
         double input[2];
         double output[2];
 
@@ -1609,8 +2268,8 @@ public:
 
         for ( unsigned i = 0; i < simulationSize; ++i )
         {
-            TS_ASSERT( FloatUtils::areEqual( ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) ).get( 0 ).get( i ), 1 ) );
-            TS_ASSERT( FloatUtils::areEqual( ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) ).get( 1 ).get( i ), 4 ) );
+            TS_ASSERT( FloatUtils::areEqual( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getBatchAssignment( 0, i ), 1 ) );
+            TS_ASSERT( FloatUtils::areEqual( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getBatchAssignment( 1, i ), 4 ) );
         }
 
         // With ReLUs, case 1
@@ -1622,8 +2281,8 @@ public:
 
         for ( unsigned i = 0; i < simulationSize; ++i )
         {
-            TS_ASSERT( FloatUtils::areEqual( ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) ).get( 0 ).get( i ), 1 ) );
-            TS_ASSERT( FloatUtils::areEqual( ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) ).get( 1 ).get( i ), 1 ) );
+            TS_ASSERT( FloatUtils::areEqual( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getBatchAssignment( 0, i ), 1 ) );
+            TS_ASSERT( FloatUtils::areEqual( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getBatchAssignment( 1, i ), 1 ) );
         }
 
         // With ReLUs, case 1 and 2
@@ -1635,8 +2294,8 @@ public:
 
         for ( unsigned i = 0; i < simulationSize; ++i )
         {
-            TS_ASSERT( FloatUtils::areEqual( ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) ).get( 0 ).get( i ), 0 ) );
-            TS_ASSERT( FloatUtils::areEqual( ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) ).get( 1 ).get( i ), 0 ) );
+            TS_ASSERT( FloatUtils::areEqual( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getBatchAssignment( 0, i ), 0 ) );
+            TS_ASSERT( FloatUtils::areEqual( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getBatchAssignment( 1, i ), 0 ) );
         }
     }
     void test_simulate_non_consecutive_layers()
@@ -1693,7 +2352,7 @@ public:
         TS_ASSERT_THROWS_NOTHING( nlr.simulate( &simulations1 ) );
 
         for ( unsigned i = 0; i < simulationSize; ++i )
-            TS_ASSERT( FloatUtils::areEqual( ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) ).get( 0 ).get( i ), 2 ) );
+            TS_ASSERT( FloatUtils::areEqual( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getBatchAssignment( 0, i ), 2 ) );
 
         // Simulate2
         Vector<Vector<double>> simulations2;
@@ -1703,7 +2362,7 @@ public:
         TS_ASSERT_THROWS_NOTHING( nlr.simulate( &simulations2 ) );
 
         for ( unsigned i = 0; i < simulationSize; ++i )
-            TS_ASSERT( FloatUtils::areEqual( ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) ).get( 0 ).get( i ), 0 ) );
+            TS_ASSERT( FloatUtils::areEqual( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getBatchAssignment( 0, i ), 0 ) );
     }
 
     void test_simulate_relus_and_abs()
@@ -1761,8 +2420,8 @@ public:
 
         for ( unsigned i = 0; i < simulationSize; ++i )
         {
-            TS_ASSERT( FloatUtils::areEqual( ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) ).get( 0 ).get( i ), 2 ) );
-            TS_ASSERT( FloatUtils::areEqual( ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) ).get( 1 ).get( i ), 2 ) );
+            TS_ASSERT( FloatUtils::areEqual( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getBatchAssignment( 0, i ), 2 ) );
+            TS_ASSERT( FloatUtils::areEqual( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getBatchAssignment( 1, i ), 2 ) );
         }
 
         // Simulate2
@@ -1774,8 +2433,8 @@ public:
 
         for ( unsigned i = 0; i < simulationSize; ++i )
         {
-            TS_ASSERT( FloatUtils::areEqual( ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) ).get( 0 ).get( i ), 4 ) );
-            TS_ASSERT( FloatUtils::areEqual( ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) ).get( 1 ).get( i ), 4 ) );
+            TS_ASSERT( FloatUtils::areEqual( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getBatchAssignment( 0, i ), 4 ) );
+            TS_ASSERT( FloatUtils::areEqual( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getBatchAssignment( 1, i ), 4 ) );
         }
     }
 };
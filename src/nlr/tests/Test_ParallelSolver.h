@@ -14,8 +14,9 @@
 **/
 
 #include <cxxtest/TestSuite.h>
-#include "GurobiWrapper.h"
+#include "ILPSolver.h"
 #include "IterativePropagator.h"
+#include "LPSolverFactory.h"
 #include "NetworkLevelReasoner.h"
 #include "ParallelSolver.h"
 
@@ -42,10 +43,10 @@ public:
         NLR::IterativePropagator mock = NLR::IterativePropagator( &nlr );
         unsigned numberOfWorkers = 4;
         NLR::ParallelSolver::SolverQueue solvers ( numberOfWorkers );
-        GurobiWrapper *gurobi = new GurobiWrapper();
+        ILPSolver *gurobi = LPSolverFactory::createLPSolver();
         TS_ASSERT_THROWS_NOTHING( mock.enqueueSolver( solvers, gurobi) );
         TS_ASSERT( !solvers.empty() );
-        GurobiWrapper *gurobiPtr = NULL;
+        ILPSolver *gurobiPtr = NULL;
         TS_ASSERT_THROWS_NOTHING( solvers.pop( gurobiPtr ) );
         TS_ASSERT( solvers.empty() );
         delete gurobiPtr;
@@ -59,7 +60,7 @@ public:
         NLR::ParallelSolver::SolverQueue solvers ( numberOfWorkers );
         for ( unsigned i = 0; i < numberOfWorkers; ++i )
         {
-            GurobiWrapper *gurobi = new GurobiWrapper();
+            ILPSolver *gurobi = LPSolverFactory::createLPSolver();
             TS_ASSERT_THROWS_NOTHING( mock.enqueueSolver( solvers, gurobi) );
         }
         TS_ASSERT( !solvers.empty() );
@@ -15,6 +15,7 @@
  **/
 
 #include "AutoFile.h"
+#include "BinaryQueryFormat.h"
 #include "Debug.h"
 #include "Equation.h"
 #include "GlobalConfiguration.h"
@@ -33,6 +34,19 @@ InputQuery QueryLoader::loadQuery( const String &fileName )
         throw MarabouError( MarabouError::FILE_DOES_NOT_EXIST, Stringf( "File %s not found.\n", fileName.ascii() ).ascii() );
     }
 
+    // Binary queries are identified by their magic. Anything that
+    // cannot be mapped is left to the text loader.
+    MemoryMappedFile mappedFile( fileName );
+    if ( mappedFile.tryOpen() &&
+         BinaryQueryFormat::hasMagic( mappedFile.data(), mappedFile.size() ) )
+        return loadBinaryQuery( mappedFile );
+
+    mappedFile.close();
+    return loadTextQuery( fileName );
+}
+
+InputQuery QueryLoader::loadTextQuery( const String &fileName )
+{
     InputQuery inputQuery;
     AutoFile input( fileName );
     input->open( IFile::MODE_READ );
@@ -190,7 +204,6 @@ InputQuery QueryLoader::loadQuery( const String &fileName )
 
         // Skip constraint number
         ++it;
-        String coType = *it;
         String serializeConstraint;
         // include type in serializeConstraint as well
         while ( it != tokens.end() ) {
@@ -199,38 +212,155 @@ InputQuery QueryLoader::loadQuery( const String &fileName )
         }
         serializeConstraint = serializeConstraint.substring( 0, serializeConstraint.length() - 1 );
 
-        PiecewiseLinearConstraint *constraint = NULL;
-        QL_LOG( Stringf( "Constraint: %u, Type: %s \n", i, coType.ascii() ).ascii() );
-        QL_LOG( Stringf( "\tserialized:\t%s \n", serializeConstraint.ascii() ).ascii() );
-        if ( coType == "relu" )
-        {
-            constraint = new ReluConstraint( serializeConstraint );
-        }
-        else if ( coType == "max" )
-        {
-            constraint = new MaxConstraint( serializeConstraint );
-        }
-        else if ( coType == "absoluteValue" )
-        {
-            constraint = new AbsoluteValueConstraint( serializeConstraint );
-        }
-        else if ( coType == "sign" )
-        {
-            constraint = new SignConstraint( serializeConstraint );
-        }
-        else
+        QL_LOG( Stringf( "Constraint: %u\n", i ).ascii() );
+        inputQuery.addPiecewiseLinearConstraint( constructConstraint( serializeConstraint ) );
+    }
+
+    inputQuery.constructNetworkLevelReasoner();
+    return inputQuery;
+}
+
+InputQuery QueryLoader::loadBinaryQuery( const MemoryMappedFile &file )
+{
+    const char *data = file.data();
+
+    if ( file.size() < sizeof(BinaryQueryFormat::Header) )
+        throw MarabouError( MarabouError::INVALID_BINARY_QUERY_FILE, "Truncated header" );
+
+    BinaryQueryFormat::Header header;
+    memcpy( &header, data, sizeof(header) );
+    BinaryQueryFormat::checkHeader( header );
+
+    BinaryQueryFormat::Layout layout;
+    BinaryQueryFormat::computeLayout( header, layout );
+    if ( file.size() < layout._totalSize )
+        throw MarabouError( MarabouError::INVALID_BINARY_QUERY_FILE, "Truncated file" );
+
+    QL_LOG( Stringf( "Binary query, version %u\n", header._version ).ascii() );
+    QL_LOG( Stringf( "Number of variables: %u\n", header._numberOfVariables ).ascii() );
+    QL_LOG( Stringf( "Number of equations: %u\n", header._numEquations ).ascii() );
+    QL_LOG( Stringf( "Number of constraints: %u\n", header._numConstraints ).ascii() );
+
+    InputQuery inputQuery;
+    inputQuery.setNumberOfVariables( header._numberOfVariables );
+
+    auto checkVariable = [&]( uint32_t variable )
+    {
+        if ( variable >= header._numberOfVariables )
+            throw MarabouError( MarabouError::INVALID_BINARY_QUERY_FILE,
+                                Stringf( "Variable out of range: %u", variable ).ascii() );
+    };
+
+    // Input and output variables
+    const BinaryQueryFormat::IndexedVariable *indexedVariables =
+        (const BinaryQueryFormat::IndexedVariable *)( data + layout._inputVariables );
+    for ( unsigned i = 0; i < header._numInputVariables; ++i )
+    {
+        checkVariable( indexedVariables[i]._variable );
+        inputQuery.markInputVariable( indexedVariables[i]._variable, indexedVariables[i]._index );
+    }
+
+    indexedVariables = (const BinaryQueryFormat::IndexedVariable *)( data + layout._outputVariables );
+    for ( unsigned i = 0; i < header._numOutputVariables; ++i )
+    {
+        checkVariable( indexedVariables[i]._variable );
+        inputQuery.markOutputVariable( indexedVariables[i]._variable, indexedVariables[i]._index );
+    }
+
+    // Bounds
+    const uint32_t *boundVariables = (const uint32_t *)( data + layout._lowerBoundVariables );
+    const double *boundValues = (const double *)( data + layout._lowerBoundValues );
+    for ( unsigned i = 0; i < header._numLowerBounds; ++i )
+    {
+        checkVariable( boundVariables[i] );
+        inputQuery.setLowerBound( boundVariables[i], boundValues[i] );
+    }
+
+    boundVariables = (const uint32_t *)( data + layout._upperBoundVariables );
+    boundValues = (const double *)( data + layout._upperBoundValues );
+    for ( unsigned i = 0; i < header._numUpperBounds; ++i )
+    {
+        checkVariable( boundVariables[i] );
+        inputQuery.setUpperBound( boundVariables[i], boundValues[i] );
+    }
+
+    // Equations
+    const BinaryQueryFormat::EquationRecord *equations =
+        (const BinaryQueryFormat::EquationRecord *)( data + layout._equations );
+    const uint32_t *addendVariables = (const uint32_t *)( data + layout._addendVariables );
+    const double *addendCoefficients = (const double *)( data + layout._addendCoefficients );
+    for ( unsigned i = 0; i < header._numEquations; ++i )
+    {
+        const BinaryQueryFormat::EquationRecord &record = equations[i];
+
+        if ( record._type > Equation::LE )
+            throw MarabouError( MarabouError::INVALID_EQUATION_TYPE, Stringf( "Invalid Equation Type\n" ).ascii() );
+
+        if ( !BinaryQueryFormat::rangeInBounds( record._firstAddend, record._numAddends, header._numAddends ) )
+            throw MarabouError( MarabouError::INVALID_BINARY_QUERY_FILE, "Addend range out of bounds" );
+
+        Equation equation( (Equation::EquationType)record._type );
+        equation.setScalar( record._scalar );
+
+        for ( uint64_t j = record._firstAddend; j < record._firstAddend + record._numAddends; ++j )
         {
-            throw MarabouError( MarabouError::UNSUPPORTED_PIECEWISE_LINEAR_CONSTRAINT, Stringf( "Unsupported piecewise constraint: %s\n", coType.ascii() ).ascii() );
+            checkVariable( addendVariables[j] );
+            equation.addAddend( addendCoefficients[j], addendVariables[j] );
         }
 
-        ASSERT( constraint );
-        inputQuery.addPiecewiseLinearConstraint( constraint );
+        inputQuery.addEquation( equation );
+    }
+
+    // Constraints
+    const BinaryQueryFormat::ConstraintRecord *constraints =
+        (const BinaryQueryFormat::ConstraintRecord *)( data + layout._constraints );
+    const char *constraintData = data + layout._constraintData;
+    for ( unsigned i = 0; i < header._numConstraints; ++i )
+    {
+        const BinaryQueryFormat::ConstraintRecord &record = constraints[i];
+
+        if ( !BinaryQueryFormat::rangeInBounds( record._offset, record._length, header._constraintDataSize ) )
+            throw MarabouError( MarabouError::INVALID_BINARY_QUERY_FILE, "Constraint range out of bounds" );
+
+        String serializedConstraint( constraintData + record._offset, record._length );
+        inputQuery.addPiecewiseLinearConstraint( constructConstraint( serializedConstraint ) );
     }
 
     inputQuery.constructNetworkLevelReasoner();
     return inputQuery;
 }
 
+PiecewiseLinearConstraint *QueryLoader::constructConstraint( const String &serializedConstraint )
+{
+    String coType = serializedConstraint.substring( 0, serializedConstraint.find( "," ) );
+
+    PiecewiseLinearConstraint *constraint = NULL;
+    QL_LOG( Stringf( "\tType: %s, serialized:\t%s \n", coType.ascii(), serializedConstraint.ascii() ).ascii() );
+    if ( coType == "relu" )
+    {
+        constraint = new ReluConstraint( serializedConstraint );
+    }
+    else if ( coType == "max" )
+    {
+        constraint = new MaxConstraint( serializedConstraint );
+    }
+    else if ( coType == "absoluteValue" )
+    {
+        constraint = new AbsoluteValueConstraint( serializedConstraint );
+    }
+    else if ( coType == "sign" )
+    {
+        constraint = new SignConstraint( serializedConstraint );
+    }
+    else
+    {
+        throw MarabouError( MarabouError::UNSUPPORTED_PIECEWISE_LINEAR_CONSTRAINT, Stringf( "Unsupported piecewise constraint: %s\n", coType.ascii() ).ascii() );
+    }
+
+    ASSERT( constraint );
+    return constraint;
+}
+
 
 //
 // Local Variables:
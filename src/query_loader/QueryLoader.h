@@ -18,6 +18,7 @@
 #define __QueryLoader_h__
 
 #include "InputQuery.h"
+#include "MemoryMappedFile.h"
 
 #define QL_LOG(x, ...) LOG(GlobalConfiguration::QUERY_LOADER_LOGGING, "QueryLoader: %s\n", x )
 
@@ -29,9 +30,25 @@ public:
     unsigned _numConstraunsigneds;
 
     /*
-      Parse a serialized query and return it in InputQuery form
+      Parse a serialized query and return it in InputQuery form. The
+      format (text or binary) is detected automatically.
     */
     static InputQuery loadQuery( const String &fileName );
+
+private:
+    static InputQuery loadTextQuery( const String &fileName );
+
+    /*
+      Load a query from the contents of a memory-mapped binary query
+      file, reading the arrays in place
+    */
+    static InputQuery loadBinaryQuery( const MemoryMappedFile &file );
+
+    /*
+      Construct a piecewise-linear constraint from its serialized form,
+      which begins with the constraint type
+    */
+    static PiecewiseLinearConstraint *constructConstraint( const String &serializedConstraint );
 };
 
 #endif // __QueryLoader_h__
@@ -15,15 +15,24 @@
 
 #include <cxxtest/TestSuite.h>
 
+#include <cstddef>
+#include <cstdio>
+
 #include "AutoFile.h"
+#include "BinaryQueryFormat.h"
 #include "Equation.h"
 #include "InputQuery.h"
+#include "MarabouError.h"
+#include "MaxConstraint.h"
+#include "MockErrno.h"
 #include "MockFileFactory.h"
 #include "QueryLoader.h"
 #include "ReluConstraint.h"
+#include "T/sys/stat.h"
 #include "T/unistd.h"
 
 const String QUERY_TEST_FILE( "QueryTest.txt" );
+const String BINARY_QUERY_TEST_FILE( "QueryTest.ipqb" );
 
 class MockForQueryLoader
     : public MockFileFactory
@@ -37,6 +46,18 @@ public:
     }
 };
 
+/*
+  Binary queries are written to disk directly and mapped back into
+  memory, so they bypass the mock file factory and use the real file
+  system calls.
+*/
+class RealFileSystemCalls
+    : public T::Real_open
+    , public T::Real_write
+    , public T::Real_close
+{
+};
+
 class QueryLoaderTestSuite : public CxxTest::TestSuite
 {
 public:
@@ -129,6 +150,213 @@ public:
         // Constraints unchanged
         TS_ASSERT( inputQuery.getPiecewiseLinearConstraints() == inputQuery.getPiecewiseLinearConstraints() );
     }
+
+    void test_load_binary_query()
+    {
+        RealFileSystemCalls realFileSystemCalls;
+
+        InputQuery inputQuery;
+        inputQuery.setNumberOfVariables( 7 );
+
+        inputQuery.markInputVariable( 0, 0 );
+        inputQuery.markInputVariable( 1, 1 );
+        inputQuery.setLowerBound( 0, -1.0 );
+        inputQuery.setUpperBound( 0, 1.0 );
+        inputQuery.setLowerBound( 1, -2.5 );
+        inputQuery.setUpperBound( 1, 2.5 );
+        inputQuery.setLowerBound( 4, 0.0 );
+
+        inputQuery.markOutputVariable( 6, 0 );
+        inputQuery.setUpperBound( 6, 3.0 );
+
+        Equation equation0;
+        equation0.addAddend( -1.0, 2 );
+        equation0.addAddend( 0.25, 0 );
+        equation0.addAddend( -3.0, 1 );
+        equation0.setScalar( 0.5 );
+        inputQuery.addEquation( equation0 );
+
+        Equation equation1( Equation::GE );
+        equation1.addAddend( 1.0, 3 );
+        equation1.addAddend( 1.0, 1 );
+        equation1.setScalar( -1.0 );
+        inputQuery.addEquation( equation1 );
+
+        inputQuery.addPiecewiseLinearConstraint( new ReluConstraint( 2, 4 ) );
+        Set<unsigned> elements = { 3, 4, 5 };
+        inputQuery.addPiecewiseLinearConstraint( new MaxConstraint( 6, elements ) );
+
+        inputQuery.saveQuery( BINARY_QUERY_TEST_FILE, QueryFileFormat::BINARY );
+
+        // The format is detected from the file contents
+        InputQuery inputQuery2 = QueryLoader::loadQuery( BINARY_QUERY_TEST_FILE );
+
+        TS_ASSERT_EQUALS( inputQuery.getNumberOfVariables(), inputQuery2.getNumberOfVariables() );
+        TS_ASSERT( inputQuery.getInputVariables() == inputQuery2.getInputVariables() );
+        TS_ASSERT( inputQuery.getOutputVariables() == inputQuery2.getOutputVariables() );
+        TS_ASSERT_EQUALS( inputQuery2.inputVariableByIndex( 1 ), 1U );
+        TS_ASSERT_EQUALS( inputQuery2.outputVariableByIndex( 0 ), 6U );
+        TS_ASSERT( inputQuery.getLowerBounds() == inputQuery2.getLowerBounds() );
+        TS_ASSERT( inputQuery.getUpperBounds() == inputQuery2.getUpperBounds() );
+        TS_ASSERT( inputQuery.getEquations() == inputQuery2.getEquations() );
+
+        const List<PiecewiseLinearConstraint *> &constraints = inputQuery.getPiecewiseLinearConstraints();
+        const List<PiecewiseLinearConstraint *> &constraints2 = inputQuery2.getPiecewiseLinearConstraints();
+        TS_ASSERT_EQUALS( constraints.size(), constraints2.size() );
+
+        auto it = constraints.begin();
+        auto it2 = constraints2.begin();
+        for ( ; it != constraints.end() && it2 != constraints2.end(); ++it, ++it2 )
+            TS_ASSERT_EQUALS( ( *it )->serializeToString(), ( *it2 )->serializeToString() );
+
+        // Binary and text dumps of the same query load identically
+        inputQuery.saveQuery( QUERY_TEST_FILE );
+
+        mock->mockFile.wasCreated = false;
+        mock->mockFile.wasDiscarded = false;
+
+        InputQuery inputQuery3 = QueryLoader::loadQuery( QUERY_TEST_FILE );
+        TS_ASSERT( inputQuery2.getEquations() == inputQuery3.getEquations() );
+        TS_ASSERT( inputQuery2.getLowerBounds() == inputQuery3.getLowerBounds() );
+        TS_ASSERT( inputQuery2.getUpperBounds() == inputQuery3.getUpperBounds() );
+
+        remove( BINARY_QUERY_TEST_FILE.ascii() );
+    }
+
+    void test_load_binary_query_with_unsupported_version()
+    {
+        RealFileSystemCalls realFileSystemCalls;
+        MockErrno mockErrno;
+
+        InputQuery inputQuery;
+        inputQuery.setNumberOfVariables( 2 );
+        Equation equation;
+        equation.addAddend( 1.0, 0 );
+        equation.addAddend( -1.0, 1 );
+        inputQuery.addEquation( equation );
+        inputQuery.saveQuery( BINARY_QUERY_TEST_FILE, QueryFileFormat::BINARY );
+
+        // Overwrite the version field in place
+        FILE *file = fopen( BINARY_QUERY_TEST_FILE.ascii(), "r+b" );
+        TS_ASSERT( file );
+        uint32_t version = BinaryQueryFormat::VERSION + 1;
+        fseek( file, offsetof( BinaryQueryFormat::Header, _version ), SEEK_SET );
+        fwrite( &version, sizeof(version), 1, file );
+        fclose( file );
+
+        TS_ASSERT_THROWS_EQUALS( QueryLoader::loadQuery( BINARY_QUERY_TEST_FILE ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::INVALID_BINARY_QUERY_FILE );
+
+        remove( BINARY_QUERY_TEST_FILE.ascii() );
+    }
+
+    void saveBinaryQueryAndPatch( long offset, const void *value, size_t size )
+    {
+        InputQuery inputQuery;
+        inputQuery.setNumberOfVariables( 2 );
+        inputQuery.setLowerBound( 1, -3.0 );
+        Equation equation;
+        equation.addAddend( 1.0, 0 );
+        equation.addAddend( -1.0, 1 );
+        inputQuery.addEquation( equation );
+        inputQuery.saveQuery( BINARY_QUERY_TEST_FILE, QueryFileFormat::BINARY );
+
+        FILE *file = fopen( BINARY_QUERY_TEST_FILE.ascii(), "r+b" );
+        TS_ASSERT( file );
+        fseek( file, offset, SEEK_SET );
+        fwrite( value, size, 1, file );
+        fclose( file );
+    }
+
+    void test_load_binary_query_with_out_of_range_variable()
+    {
+        RealFileSystemCalls realFileSystemCalls;
+        MockErrno mockErrno;
+
+        BinaryQueryFormat::Header header;
+        BinaryQueryFormat::initializeHeader( header );
+        header._numLowerBounds = 1;
+        header._numEquations = 1;
+        header._numAddends = 2;
+        BinaryQueryFormat::Layout layout;
+        BinaryQueryFormat::computeLayout( header, layout );
+
+        // The bound's variable
+        uint32_t variable = 2;
+        saveBinaryQueryAndPatch( layout._lowerBoundVariables, &variable, sizeof(variable) );
+
+        TS_ASSERT_THROWS_EQUALS( QueryLoader::loadQuery( BINARY_QUERY_TEST_FILE ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::INVALID_BINARY_QUERY_FILE );
+
+        // The second addend's variable
+        saveBinaryQueryAndPatch( layout._addendVariables + sizeof(uint32_t), &variable, sizeof(variable) );
+
+        TS_ASSERT_THROWS_EQUALS( QueryLoader::loadQuery( BINARY_QUERY_TEST_FILE ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::INVALID_BINARY_QUERY_FILE );
+
+        remove( BINARY_QUERY_TEST_FILE.ascii() );
+    }
+
+    void test_load_binary_query_with_wrapping_addend_range()
+    {
+        RealFileSystemCalls realFileSystemCalls;
+        MockErrno mockErrno;
+
+        BinaryQueryFormat::Header header;
+        BinaryQueryFormat::initializeHeader( header );
+        header._numLowerBounds = 1;
+        header._numEquations = 1;
+        header._numAddends = 2;
+        BinaryQueryFormat::Layout layout;
+        BinaryQueryFormat::computeLayout( header, layout );
+
+        // First addend + number of addends wraps around to 0
+        uint64_t firstAddend = UINT64_MAX - 1;
+        saveBinaryQueryAndPatch( layout._equations + offsetof( BinaryQueryFormat::EquationRecord, _firstAddend ),
+                                 &firstAddend,
+                                 sizeof(firstAddend) );
+
+        TS_ASSERT_THROWS_EQUALS( QueryLoader::loadQuery( BINARY_QUERY_TEST_FILE ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::INVALID_BINARY_QUERY_FILE );
+
+        remove( BINARY_QUERY_TEST_FILE.ascii() );
+    }
+
+    void test_binary_layout_overflow()
+    {
+        MockErrno mockErrno;
+
+        BinaryQueryFormat::Header header;
+        BinaryQueryFormat::initializeHeader( header );
+        header._numAddends = UINT64_MAX / 4;
+
+        BinaryQueryFormat::Layout layout;
+        TS_ASSERT_THROWS_EQUALS( BinaryQueryFormat::computeLayout( header, layout ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::INVALID_BINARY_QUERY_FILE );
+
+        header._numAddends = 0;
+        header._constraintDataSize = UINT64_MAX - 8;
+        TS_ASSERT_THROWS_EQUALS( BinaryQueryFormat::computeLayout( header, layout ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::INVALID_BINARY_QUERY_FILE );
+
+        TS_ASSERT( BinaryQueryFormat::rangeInBounds( 0, 5, 5 ) );
+        TS_ASSERT( BinaryQueryFormat::rangeInBounds( 5, 0, 5 ) );
+        TS_ASSERT( !BinaryQueryFormat::rangeInBounds( 4, 2, 5 ) );
+        TS_ASSERT( !BinaryQueryFormat::rangeInBounds( 6, 0, 5 ) );
+        TS_ASSERT( !BinaryQueryFormat::rangeInBounds( UINT64_MAX, 2, 5 ) );
+    }
 };
 
 //
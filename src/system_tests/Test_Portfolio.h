@@ -0,0 +1,143 @@
+/*********************                                                        */
+/*! \file Test_Portfolio.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "AcasParser.h"
+#include "BoundExchange.h"
+#include "Engine.h"
+#include "FloatUtils.h"
+#include "InputQuery.h"
+#include "Options.h"
+#include "PortfolioManager.h"
+
+class PortfolioTestSuite : public CxxTest::TestSuite
+{
+public:
+    AcasParser *acasParser;
+    InputQuery inputQuery;
+    Vector<double> point;
+    Vector<double> outputs;
+
+    void setUp()
+    {
+        acasParser = new AcasParser( RESOURCES_DIR "/nnet/acasxu/ACASXU_experimental_v2a_1_1.nnet" );
+        inputQuery = InputQuery();
+        acasParser->generateQuery( inputQuery );
+
+        // A small box around a point. A single point leaves the engines
+        // with no slack for rounding errors.
+        point = Vector<double>( { 0.1, -0.1, 0.2, -0.2, 0.05 } );
+        for ( unsigned i = 0; i < 5; ++i )
+        {
+            unsigned variable = acasParser->getInputVariable( i );
+            inputQuery.setLowerBound( variable, point[i] - 0.001 );
+            inputQuery.setUpperBound( variable, point[i] + 0.001 );
+        }
+
+        outputs.clear();
+        acasParser->evaluate( point, outputs );
+    }
+
+    void tearDown()
+    {
+        delete acasParser;
+    }
+
+    void test_configurations()
+    {
+        Vector<PortfolioManager::Configuration> configurations;
+        PortfolioManager::getConfigurations( 12, configurations );
+        TS_ASSERT_EQUALS( configurations.size(), 12U );
+
+        Options *options = Options::get();
+        TS_ASSERT_EQUALS( configurations[0],
+                          PortfolioManager::Configuration
+                          ( options->getDivideStrategy(),
+                            options->getSymbolicBoundTighteningType(),
+                            options->getInt( Options::CONSTRAINT_VIOLATION_THRESHOLD ) ) );
+
+        for ( unsigned i = 0; i < configurations.size(); ++i )
+            for ( unsigned j = i + 1; j < configurations.size(); ++j )
+                TS_ASSERT( !( configurations[i] == configurations[j] ) );
+
+        PortfolioManager::getConfigurations( 1, configurations );
+        TS_ASSERT_EQUALS( configurations.size(), 1U );
+    }
+
+    void test_sat()
+    {
+        PortfolioManager portfolio( &inputQuery );
+        portfolio.solve( 3 );
+
+        TS_ASSERT_EQUALS( portfolio.getExitCode(), Engine::SAT );
+        TS_ASSERT_DIFFERS( portfolio.getWinner(), PortfolioManager::NO_WINNER );
+
+        portfolio.extractSolution( inputQuery );
+
+        Vector<double> solutionInputs;
+        for ( unsigned i = 0; i < 5; ++i )
+        {
+            double value = inputQuery.getSolutionValue( acasParser->getInputVariable( i ) );
+            TS_ASSERT( FloatUtils::gte( value, point[i] - 0.001, 0.00001 ) );
+            TS_ASSERT( FloatUtils::lte( value, point[i] + 0.001, 0.00001 ) );
+            solutionInputs.append( value );
+        }
+
+        Vector<double> solutionOutputs;
+        acasParser->evaluate( solutionInputs, solutionOutputs );
+        for ( unsigned i = 0; i < 5; ++i )
+        {
+            double value = inputQuery.getSolutionValue( acasParser->getOutputVariable( i ) );
+            TS_ASSERT( FloatUtils::areEqual( value, solutionOutputs[i], 0.00001 ) );
+        }
+    }
+
+    void test_unsat()
+    {
+        unsigned y0 = acasParser->getOutputVariable( 0 );
+        inputQuery.setLowerBound( y0, outputs[0] + 0.1 );
+
+        PortfolioManager portfolio( &inputQuery );
+        portfolio.solve( 3 );
+
+        TS_ASSERT_EQUALS( portfolio.getExitCode(), Engine::UNSAT );
+    }
+
+    void test_engine_imports_bounds()
+    {
+        Engine engine;
+        engine.setVerbosity( 0 );
+        TS_ASSERT( engine.processInputQuery( inputQuery ) );
+
+        // Another participant claims a bound that contradicts the query
+        double upperBound = engine.getInputQuery()->getUpperBound( 0 );
+        BoundExchange exchange( 2, 10 );
+        TS_ASSERT( exchange.publish( 1, Tightening( 0, upperBound + 1, Tightening::LB ) ) );
+
+        engine.setBoundExchange( &exchange, 0 );
+        TS_ASSERT( !engine.solve() );
+        TS_ASSERT_EQUALS( engine.getExitCode(), Engine::UNSAT );
+        TS_ASSERT_EQUALS( engine.getStatistics()->getNumImportedBounds(), 1U );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
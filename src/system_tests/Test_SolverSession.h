@@ -0,0 +1,219 @@
+/*********************                                                        */
+/*! \file Test_SolverSession.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "AcasParser.h"
+#include "Engine.h"
+#include "FloatUtils.h"
+#include "InputQuery.h"
+#include "ReluConstraint.h"
+#include "SolverSession.h"
+
+class SolverSessionTestSuite : public CxxTest::TestSuite
+{
+public:
+    AcasParser *acasParser;
+    InputQuery baseQuery;
+
+    void setUp()
+    {
+        acasParser = new AcasParser( RESOURCES_DIR "/nnet/acasxu/ACASXU_experimental_v2a_1_1.nnet" );
+        baseQuery = InputQuery();
+        acasParser->generateQuery( baseQuery );
+    }
+
+    void tearDown()
+    {
+        delete acasParser;
+    }
+
+    void boundInputs( PiecewiseLinearCaseSplit &property, const Vector<double> &inputs )
+    {
+        // A small box around the given point. A single point leaves the
+        // engine with no slack for rounding errors.
+        for ( unsigned i = 0; i < 5; ++i )
+        {
+            unsigned variable = acasParser->getInputVariable( i );
+            property.storeBoundTightening( Tightening( variable, inputs.get( i ) - 0.001, Tightening::LB ) );
+            property.storeBoundTightening( Tightening( variable, inputs.get( i ) + 0.001, Tightening::UB ) );
+        }
+    }
+
+    void checkSolution( SolverSession &session, const Vector<double> &inputs )
+    {
+        InputQuery solution = baseQuery;
+        session.extractSolution( solution );
+
+        Vector<double> solutionInputs;
+        for ( unsigned i = 0; i < 5; ++i )
+        {
+            unsigned variable = acasParser->getInputVariable( i );
+            double value = solution.getSolutionValue( variable );
+            TS_ASSERT( FloatUtils::gte( value, inputs.get( i ) - 0.001, 0.00001 ) );
+            TS_ASSERT( FloatUtils::lte( value, inputs.get( i ) + 0.001, 0.00001 ) );
+            solutionInputs.append( value );
+        }
+
+        Vector<double> outputs;
+        acasParser->evaluate( solutionInputs, outputs );
+
+        for ( unsigned i = 0; i < 5; ++i )
+        {
+            unsigned variable = acasParser->getOutputVariable( i );
+            TS_ASSERT( FloatUtils::areEqual( solution.getSolutionValue( variable ), outputs[i], 0.00001 ) );
+        }
+    }
+
+    void test_bounds_and_equations_across_queries()
+    {
+        SolverSession session( baseQuery );
+
+        Vector<double> firstPoint( { 0, 0, 0, 0, 0 } );
+        Vector<double> secondPoint( { 0.1, -0.1, 0.2, -0.2, 0.05 } );
+
+        Vector<double> firstOutputs;
+        acasParser->evaluate( firstPoint, firstOutputs );
+        Vector<double> secondOutputs;
+        acasParser->evaluate( secondPoint, secondOutputs );
+
+        unsigned y0 = acasParser->getOutputVariable( 0 );
+        unsigned y1 = acasParser->getOutputVariable( 1 );
+
+        // Bounded inputs are SAT
+        PiecewiseLinearCaseSplit property1;
+        boundInputs( property1, firstPoint );
+        TS_ASSERT_EQUALS( session.solve( property1 ), IEngine::SAT );
+        checkSolution( session, firstPoint );
+
+        // An output bound far from the outputs over the box is UNSAT
+        PiecewiseLinearCaseSplit property2;
+        boundInputs( property2, firstPoint );
+        property2.storeBoundTightening( Tightening( y0, firstOutputs[0] + 0.1, Tightening::LB ) );
+        TS_ASSERT_EQUALS( session.solve( property2 ), IEngine::UNSAT );
+
+        // The bounds of the previous query are gone
+        PiecewiseLinearCaseSplit property3;
+        boundInputs( property3, secondPoint );
+        property3.storeBoundTightening( Tightening( y0, secondOutputs[0] - 0.1, Tightening::LB ) );
+        TS_ASSERT_EQUALS( session.solve( property3 ), IEngine::SAT );
+        checkSolution( session, secondPoint );
+
+        // Equations over the outputs: y0 - y1 on either side of its value
+        double difference = secondOutputs[0] - secondOutputs[1];
+
+        PiecewiseLinearCaseSplit property4;
+        boundInputs( property4, secondPoint );
+        Equation violated( Equation::GE );
+        violated.addAddend( 1, y0 );
+        violated.addAddend( -1, y1 );
+        violated.setScalar( difference + 0.1 );
+        property4.addEquation( violated );
+        TS_ASSERT_EQUALS( session.solve( property4 ), IEngine::UNSAT );
+
+        PiecewiseLinearCaseSplit property5;
+        boundInputs( property5, secondPoint );
+        Equation satisfied( Equation::LE );
+        satisfied.addAddend( 1, y0 );
+        satisfied.addAddend( -1, y1 );
+        satisfied.setScalar( difference + 0.1 );
+        property5.addEquation( satisfied );
+        TS_ASSERT_EQUALS( session.solve( property5 ), IEngine::SAT );
+        checkSolution( session, secondPoint );
+
+        // The added equation does not linger either
+        TS_ASSERT_EQUALS( session.solve( property1 ), IEngine::SAT );
+        checkSolution( session, firstPoint );
+
+        TS_ASSERT_EQUALS( session.getNumSolvedQueries(), 6U );
+    }
+
+    void test_bounds_and_equations_as_maps()
+    {
+        // The query of the Python bindings test: y = relu( x ), x in [-1, 1]
+        InputQuery query;
+        query.setNumberOfVariables( 3 );
+        query.setLowerBound( 0, -1 );
+        query.setUpperBound( 0, 1 );
+        query.setLowerBound( 1, 0 );
+        query.setUpperBound( 1, 1000 );
+        query.setLowerBound( 2, -1000 );
+        query.setUpperBound( 2, 1000 );
+
+        query.addPiecewiseLinearConstraint( new ReluConstraint( 0, 1 ) );
+
+        Equation output;
+        output.addAddend( 1, 2 );
+        output.addAddend( -1, 1 );
+        output.setScalar( 0 );
+        query.addEquation( output );
+
+        SolverSession session( query );
+        Map<unsigned, double> values;
+
+        // x >= 0.5
+        Map<unsigned, double> lowerBounds;
+        lowerBounds[0] = 0.5;
+        TS_ASSERT_EQUALS( session.solve( lowerBounds, Map<unsigned, double>(), List<Equation>() ),
+                          IEngine::SAT );
+        session.extractSolution( values );
+        TS_ASSERT_EQUALS( values.size(), 3U );
+        TS_ASSERT( FloatUtils::gte( values[0], 0.5 ) );
+        TS_ASSERT( FloatUtils::areEqual( values[2], values[0], 0.00001 ) );
+
+        // x + y <= -2 cannot hold, since x >= -1 and y >= 0
+        Equation property( Equation::LE );
+        property.addAddend( 1, 0 );
+        property.addAddend( 1, 2 );
+        property.setScalar( -2 );
+        List<Equation> equations;
+        equations.append( property );
+        TS_ASSERT_EQUALS( session.solve( Map<unsigned, double>(), Map<unsigned, double>(), equations ),
+                          IEngine::UNSAT );
+
+        // x <= -0.5, without the equation of the previous query
+        Map<unsigned, double> upperBounds;
+        upperBounds[0] = -0.5;
+        TS_ASSERT_EQUALS( session.solve( Map<unsigned, double>(), upperBounds, List<Equation>() ),
+                          IEngine::SAT );
+        session.extractSolution( values );
+        TS_ASSERT( FloatUtils::lte( values[0], -0.5 ) );
+        TS_ASSERT( FloatUtils::areEqual( values[2], 0, 0.00001 ) );
+
+        TS_ASSERT_EQUALS( session.getNumSolvedQueries(), 3U );
+    }
+
+    void test_infeasible_base_query()
+    {
+        // Inputs that lie outside the network's input ranges
+        unsigned variable = acasParser->getInputVariable( 0 );
+        baseQuery.setLowerBound( variable, 5 );
+        baseQuery.setUpperBound( variable, 4 );
+
+        SolverSession session( baseQuery );
+
+        PiecewiseLinearCaseSplit property;
+        TS_ASSERT_EQUALS( session.solve( property ), IEngine::UNSAT );
+        TS_ASSERT_EQUALS( session.solve( property ), IEngine::UNSAT );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//